@@ -65,11 +65,6 @@ add_library(flatzinc
   ortools/flatzinc/model.h
   ortools/flatzinc/parser.cc
   ortools/flatzinc/parser.h
-  ortools/flatzinc/parser.tab.cc
-  ortools/flatzinc/parser.tab.hh
-  ortools/flatzinc/parser.yy.cc
-  #ortools/flatzinc/parser_util.cc # Already #include in parser.tab.cc
-  ortools/flatzinc/parser_util.h
   ortools/flatzinc/presolve.cc
   ortools/flatzinc/presolve.h
   )
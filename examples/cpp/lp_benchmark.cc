@@ -0,0 +1,271 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the LP solvers of OR-Tools on a set of instances, to choose
+// between Glop's primal and dual simplex, PDLP and their number of threads.
+// Integrality constraints are dropped from the input problems.
+//
+// Each (instance, solver, number of threads) run is written as one JSON object
+// per line, so that the reports of two commits or two machines can be joined
+// on the "instance", "solver" and "num_threads" keys. For example:
+//   lp_benchmark --input=afiro.mps,qap15.mps --solvers=glop_dual,pdlp \
+//     --num_threads=1,4 --output=report.jsonl
+//
+// The memory figures are for the whole process: run one instance per process
+// to get the peak of each instance.
+
+#include <sys/resource.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/log/check.h"
+#include "absl/log/flags.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "ortools/base/file.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/path.h"
+#include "ortools/base/sysinfo.h"
+#include "ortools/base/timer.h"
+#include "ortools/glop/lp_solver.h"
+#include "ortools/glop/parameters.pb.h"
+#include "ortools/linear_solver/linear_solver.pb.h"
+#include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_types.h"
+#include "ortools/lp_data/proto_utils.h"
+#include "ortools/pdlp/iteration_stats.h"
+#include "ortools/pdlp/primal_dual_hybrid_gradient.h"
+#include "ortools/pdlp/quadratic_program.h"
+#include "ortools/pdlp/quadratic_program_io.h"
+#include "ortools/pdlp/solve_log.pb.h"
+#include "ortools/pdlp/solvers.pb.h"
+#include "ortools/port/proto_utils.h"
+
+ABSL_FLAG(std::string, input, "",
+          "REQUIRED: Comma-separated list of the instances, in any format "
+          "supported by pdlp::ReadQuadraticProgramOrDie() (.mps, .mps.bz2, "
+          "or MPModelProto in .pb, .textproto or .json).");
+ABSL_FLAG(std::string, solvers, "glop_primal,glop_dual,pdlp",
+          "Comma-separated list of the solvers to run, among glop_primal, "
+          "glop_dual and pdlp.");
+ABSL_FLAG(std::string, num_threads, "1",
+          "Comma-separated list of the numbers of threads to run each solver "
+          "with. They set num_omp_threads for Glop, which only uses them when "
+          "compiled with OpenMP, and num_threads for PDLP.");
+ABSL_FLAG(std::string, glop_params, "", "GlopParameters in text format.");
+ABSL_FLAG(std::string, pdlp_params, "",
+          "PrimalDualHybridGradientParams in text format.");
+ABSL_FLAG(std::string, output, "",
+          "If non-empty, the report is appended to this file instead of being "
+          "printed on the standard output.");
+
+namespace operations_research {
+namespace {
+
+// Returns the peak resident memory of the process, in bytes.
+int64_t PeakMemoryUsage() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  return int64_t{1024} * usage.ru_maxrss;
+#endif
+}
+
+// Returns `value` as a JSON string.
+std::string JsonString(absl::string_view value) {
+  std::string result = "\"";
+  for (const char c : value) {
+    if (c == '"' || c == '\\') result.push_back('\\');
+    result.push_back(c);
+  }
+  result.push_back('"');
+  return result;
+}
+
+// The fields common to all the solvers, in the order they are written.
+std::string CommonFields(absl::string_view instance, absl::string_view solver,
+                         const int num_threads, absl::string_view status,
+                         const double objective, const double load_time_sec,
+                         const double solve_time_sec, const int64_t iterations,
+                         const int64_t memory_before_solve) {
+  return absl::StrFormat(
+      "\"instance\":%s,\"solver\":%s,\"num_threads\":%d,\"status\":%s,"
+      "\"objective\":%.17g,\"load_time_sec\":%.6f,\"solve_time_sec\":%.6f,"
+      "\"iterations\":%d,\"memory_before_solve_bytes\":%d,"
+      "\"memory_after_solve_bytes\":%d,\"peak_memory_bytes\":%d",
+      JsonString(instance), JsonString(solver), num_threads,
+      JsonString(status), objective, load_time_sec, solve_time_sec, iterations,
+      memory_before_solve, GetProcessMemoryUsage(), PeakMemoryUsage());
+}
+
+// Solves `mp_model` with Glop and returns the JSON object of the run.
+std::string RunGlop(absl::string_view instance, const MPModelProto& mp_model,
+                    const bool use_dual_simplex, const int num_threads) {
+  glop::GlopParameters params;
+  CHECK(ProtobufTextFormatMergeFromString(absl::GetFlag(FLAGS_glop_params),
+                                          &params))
+      << "Error parsing --glop_params";
+  params.set_use_dual_simplex(use_dual_simplex);
+  params.set_num_omp_threads(num_threads);
+
+  glop::LinearProgram lp;
+  double load_time_sec = 0.0;
+  {
+    ScopedWallTime timer(&load_time_sec);
+    glop::MPModelProtoToLinearProgram(mp_model, &lp);
+  }
+  const int64_t memory_before_solve = GetProcessMemoryUsage();
+  glop::LPSolver solver;
+  solver.SetParameters(params);
+  glop::ProblemStatus status = glop::ProblemStatus::INIT;
+  double solve_time_sec = 0.0;
+  {
+    ScopedWallTime timer(&solve_time_sec);
+    status = solver.Solve(lp);
+  }
+  return absl::StrCat(
+      "{",
+      CommonFields(instance, use_dual_simplex ? "glop_dual" : "glop_primal",
+                   num_threads, glop::GetProblemStatusString(status),
+                   glop::ToDouble(solver.GetObjectiveValue()), load_time_sec,
+                   solve_time_sec, solver.GetNumberOfSimplexIterations(),
+                   memory_before_solve),
+      absl::StrFormat(",\"deterministic_time\":%.6f}",
+                      solver.DeterministicTime()));
+}
+
+// Solves `qp` with PDLP and returns the JSON object of the run.
+std::string RunPdlp(absl::string_view instance,
+                    const pdlp::QuadraticProgram& qp, const int num_threads) {
+  pdlp::PrimalDualHybridGradientParams params;
+  CHECK(ProtobufTextFormatMergeFromString(absl::GetFlag(FLAGS_pdlp_params),
+                                          &params))
+      << "Error parsing --pdlp_params";
+  params.set_num_threads(num_threads);
+  params.set_record_timing_details(true);
+
+  // PrimalDualHybridGradient() takes the problem by value.
+  double load_time_sec = 0.0;
+  pdlp::QuadraticProgram qp_copy;
+  {
+    ScopedWallTime timer(&load_time_sec);
+    qp_copy = qp;
+  }
+  const int64_t memory_before_solve = GetProcessMemoryUsage();
+  double solve_time_sec = 0.0;
+  pdlp::SolverResult result;
+  {
+    ScopedWallTime timer(&solve_time_sec);
+    result = pdlp::PrimalDualHybridGradient(std::move(qp_copy), params);
+  }
+  const pdlp::SolveLog& log = result.solve_log;
+  const pdlp::IterationStats& stats = log.solution_stats();
+  const pdlp::TimingDetails& timing = log.timing_details();
+  const std::optional<pdlp::ConvergenceInformation> convergence_information =
+      pdlp::GetConvergenceInformation(stats, log.solution_type());
+  const double objective = convergence_information.has_value()
+                               ? convergence_information->primal_objective()
+                               : 0.0;
+  return absl::StrCat(
+      "{",
+      CommonFields(instance, "pdlp", num_threads,
+                   pdlp::TerminationReason_Name(log.termination_reason()),
+                   objective, load_time_sec, solve_time_sec,
+                   log.iteration_count(), memory_before_solve),
+      absl::StrFormat(
+          ",\"preprocessing_time_sec\":%.6f,\"step_time_sec\":%.6f,"
+          "\"restart_time_sec\":%.6f,\"termination_check_time_sec\":%.6f,"
+          "\"kkt_matrix_passes\":%.6f,\"constraint_matrix_bytes\":%d,"
+          "\"estimated_bandwidth_bytes_per_sec\":%.6g}",
+          log.preprocessing_time_sec(), timing.step_time_sec(),
+          timing.restart_time_sec(), timing.termination_check_time_sec(),
+          stats.cumulative_kkt_matrix_passes(),
+          timing.constraint_matrix_bytes(),
+          timing.estimated_bandwidth_bytes_per_sec()));
+}
+
+void Run() {
+  QCHECK(!absl::GetFlag(FLAGS_input).empty()) << "--input is required";
+  std::vector<int> thread_counts;
+  for (const absl::string_view value :
+       absl::StrSplit(absl::GetFlag(FLAGS_num_threads), ',')) {
+    int num_threads;
+    QCHECK(absl::SimpleAtoi(value, &num_threads) && num_threads > 0)
+        << "Invalid --num_threads: " << value;
+    thread_counts.push_back(num_threads);
+  }
+  const std::vector<std::string> solvers =
+      absl::StrSplit(absl::GetFlag(FLAGS_solvers), ',', absl::SkipEmpty());
+  for (const std::string& solver : solvers) {
+    QCHECK(solver == "glop_primal" || solver == "glop_dual" || solver == "pdlp")
+        << "Unknown solver in --solvers: " << solver;
+  }
+
+  File* output = nullptr;
+  if (!absl::GetFlag(FLAGS_output).empty()) {
+    output = file::OpenOrDie(absl::GetFlag(FLAGS_output), "a",
+                             file::Defaults());
+  }
+  for (const absl::string_view input :
+       absl::StrSplit(absl::GetFlag(FLAGS_input), ',', absl::SkipEmpty())) {
+    const std::string instance(file::Basename(input));
+    double read_time_sec = 0.0;
+    pdlp::QuadraticProgram qp;
+    {
+      ScopedWallTime timer(&read_time_sec);
+      qp = pdlp::ReadQuadraticProgramOrDie(std::string(input));
+    }
+    LOG(INFO) << "Read " << instance << " in " << read_time_sec << "s.";
+    absl::StatusOr<MPModelProto> mp_model = pdlp::QpToMpModelProto(qp);
+    for (const std::string& solver : solvers) {
+      for (const int num_threads : thread_counts) {
+        std::string line;
+        if (solver == "pdlp") {
+          line = RunPdlp(instance, qp, num_threads);
+        } else {
+          QCHECK_OK(mp_model.status()) << "for " << instance;
+          line = RunGlop(instance, *mp_model, solver == "glop_dual",
+                         num_threads);
+        }
+        if (output == nullptr) {
+          absl::PrintF("%s\n", line);
+        } else {
+          CHECK(output->WriteLine(line));
+          CHECK(output->Flush());
+        }
+      }
+    }
+  }
+  if (output != nullptr) CHECK_OK(output->Close(file::Defaults()));
+}
+
+}  // namespace
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, /*remove_flags=*/true);
+  operations_research::Run();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,329 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the local search of the routing library on Solomon (CVRPTW) and
+// TSPLIB (TSP, ATSP and CVRP) instances, to catch throughput regressions in
+// the local search operators and filters.
+//
+// Each instance is solved once per metaheuristic, with the same fixed budget
+// and the default (fixed) random seeds. Each run is written as one JSON object
+// per line, with the cost of the solution, the number of neighbors per second,
+// the time per filter call, and the local search statistics of the solver
+// (neighbors per operator, calls, rejects and time per filter). The status is
+// the value of RoutingModel::Status. For example:
+//   routing_benchmark --input=c101.txt,F-n45-k4.vrp \
+//     --metaheuristics=GUIDED_LOCAL_SEARCH,TABU_SEARCH --time_limit=10s
+// Files ending with .vrp, .tsp or .atsp are read with TspLibParser, the other
+// ones with SolomonParser.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/log/check.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "google/protobuf/duration.pb.h"
+#include "google/protobuf/util/json_util.h"
+#include "ortools/base/file.h"
+#include "ortools/base/init_google.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/path.h"
+#include "ortools/base/protoutil.h"
+#include "ortools/base/timer.h"
+#include "ortools/constraint_solver/routing.h"
+#include "ortools/constraint_solver/routing_enums.pb.h"
+#include "ortools/constraint_solver/routing_index_manager.h"
+#include "ortools/constraint_solver/routing_parameters.h"
+#include "ortools/constraint_solver/routing_parameters.pb.h"
+#include "ortools/constraint_solver/search_stats.pb.h"
+#include "ortools/port/proto_utils.h"
+#include "ortools/routing/parsers/solomon_parser.h"
+#include "ortools/routing/parsers/tsplib_parser.h"
+
+ABSL_FLAG(std::string, input, "",
+          "REQUIRED: Comma-separated list of the instances.");
+ABSL_FLAG(std::string, metaheuristics,
+          "GREEDY_DESCENT,GUIDED_LOCAL_SEARCH,SIMULATED_ANNEALING,"
+          "TABU_SEARCH,GENERIC_TABU_SEARCH",
+          "Comma-separated list of the LocalSearchMetaheuristic values to run "
+          "on each instance.");
+ABSL_FLAG(absl::Duration, time_limit, absl::Seconds(10),
+          "Time limit of each run.");
+ABSL_FLAG(int64_t, solution_limit, 0,
+          "If positive, limit on the number of solutions of each run. Unlike "
+          "the time limit, this budget does not depend on the machine, so the "
+          "wall times of two versions can be compared.");
+ABSL_FLAG(int, tsplib_num_vehicles, 0,
+          "Number of vehicles of the TSPLIB CVRP instances, which do not "
+          "specify it. If 0, twice the number of vehicles needed to carry the "
+          "total demand.");
+ABSL_FLAG(std::string, routing_search_parameters, "",
+          "Text proto RoutingSearchParameters (possibly partial) that will "
+          "override the defaults of the benchmark.");
+ABSL_FLAG(std::string, output, "",
+          "If non-empty, the report is appended to this file instead of being "
+          "printed on the standard output.");
+
+namespace operations_research {
+namespace {
+
+// The Solomon distances and times are real numbers; they are scaled by this
+// factor and rounded to be used by the routing library.
+constexpr double kSolomonScalingFactor = 100.0;
+
+// A routing model with its index manager, built from an instance file.
+struct Instance {
+  std::string name;
+  // The distances of TspLibParser refer to the parser, which must outlive the
+  // model.
+  std::unique_ptr<TspLibParser> tsplib_parser;
+  std::unique_ptr<RoutingIndexManager> manager;
+  std::unique_ptr<RoutingModel> model;
+};
+
+RoutingModelParameters ModelParameters() {
+  RoutingModelParameters parameters = DefaultRoutingModelParameters();
+  parameters.mutable_solver_parameters()->set_profile_local_search(true);
+  return parameters;
+}
+
+Instance LoadSolomonInstance(const std::string& file_name) {
+  SolomonParser parser;
+  QCHECK(parser.LoadFile(file_name)) << "Could not read " << file_name;
+  Instance instance;
+  instance.name = std::string(file::Basename(file_name));
+  const int num_nodes = parser.NumberOfNodes();
+  instance.manager = std::make_unique<RoutingIndexManager>(
+      num_nodes, parser.NumberOfVehicles(),
+      RoutingIndexManager::NodeIndex(parser.Depot()));
+  instance.model =
+      std::make_unique<RoutingModel>(*instance.manager, ModelParameters());
+  RoutingIndexManager* const manager = instance.manager.get();
+  RoutingModel* const model = instance.model.get();
+
+  // The callbacks outlive the parser, so they own copies of its data.
+  const auto distance_between =
+      [coordinates = parser.coordinates()](int from, int to) {
+        const double dx = coordinates[from].x - coordinates[to].x;
+        const double dy = coordinates[from].y - coordinates[to].y;
+        return std::sqrt(dx * dx + dy * dy);
+      };
+  const int distance = model->RegisterTransitCallback(
+      [distance_between, manager](int64_t from, int64_t to) {
+        return std::llround(
+            kSolomonScalingFactor *
+            distance_between(manager->IndexToNode(from).value(),
+                             manager->IndexToNode(to).value()));
+      });
+  model->SetArcCostEvaluatorOfAllVehicles(distance);
+
+  const int demand = model->RegisterUnaryTransitCallback(
+      [demands = parser.demands(), manager](int64_t index) {
+        return demands[manager->IndexToNode(index).value()];
+      });
+  model->AddDimension(demand, 0, parser.capacity(),
+                      /*fix_start_cumul_to_zero=*/true, "demand");
+
+  const int64_t horizon = std::llround(
+      kSolomonScalingFactor * parser.time_windows()[parser.Depot()].end);
+  const int time = model->RegisterTransitCallback(
+      [distance_between, service_times = parser.service_times(), manager](
+          int64_t from, int64_t to) {
+        const int from_node = manager->IndexToNode(from).value();
+        return std::llround(
+            kSolomonScalingFactor *
+            (service_times[from_node] +
+             distance_between(from_node, manager->IndexToNode(to).value())));
+      });
+  model->AddDimension(time, horizon, horizon,
+                      /*fix_start_cumul_to_zero=*/false, "time");
+  const RoutingDimension& time_dimension = model->GetDimensionOrDie("time");
+  for (int node = 0; node < num_nodes; ++node) {
+    if (node == parser.Depot()) continue;
+    const SimpleTimeWindow<int64_t>& window = parser.time_windows()[node];
+    const int64_t index =
+        manager->NodeToIndex(RoutingIndexManager::NodeIndex(node));
+    time_dimension.CumulVar(index)->SetRange(
+        std::llround(kSolomonScalingFactor * window.start),
+        std::llround(kSolomonScalingFactor * window.end));
+  }
+  return instance;
+}
+
+Instance LoadTspLibInstance(const std::string& file_name) {
+  Instance instance;
+  instance.tsplib_parser = std::make_unique<TspLibParser>();
+  const TspLibParser& parser = *instance.tsplib_parser;
+  QCHECK(instance.tsplib_parser->LoadFile(file_name))
+      << "Could not read " << file_name;
+  instance.name = std::string(file::Basename(file_name));
+  const int num_nodes = parser.size();
+  int num_vehicles = 1;
+  const bool is_cvrp = parser.type() == TspLibParser::CVRP;
+  if (is_cvrp) {
+    num_vehicles = absl::GetFlag(FLAGS_tsplib_num_vehicles);
+    if (num_vehicles == 0) {
+      int64_t total_demand = 0;
+      for (const int64_t demand : parser.demands()) total_demand += demand;
+      num_vehicles =
+          2 * ((total_demand + parser.capacity() - 1) / parser.capacity());
+    }
+  }
+  instance.manager = std::make_unique<RoutingIndexManager>(
+      num_nodes, num_vehicles, RoutingIndexManager::NodeIndex(parser.depot()));
+  instance.model =
+      std::make_unique<RoutingModel>(*instance.manager, ModelParameters());
+  RoutingIndexManager* const manager = instance.manager.get();
+  RoutingModel* const model = instance.model.get();
+
+  const int distance = model->RegisterTransitCallback(
+      [edge_weights = parser.GetEdgeWeights(), manager](int64_t from,
+                                                        int64_t to) {
+        return edge_weights(manager->IndexToNode(from).value(),
+                            manager->IndexToNode(to).value());
+      });
+  model->SetArcCostEvaluatorOfAllVehicles(distance);
+
+  if (is_cvrp) {
+    const int demand = model->RegisterUnaryTransitCallback(
+        [demands = parser.demands(), manager](int64_t index) {
+          return demands[manager->IndexToNode(index).value()];
+        });
+    model->AddDimension(demand, 0, parser.capacity(),
+                        /*fix_start_cumul_to_zero=*/true, "demand");
+  }
+  return instance;
+}
+
+Instance LoadInstance(const std::string& file_name) {
+  if (absl::EndsWith(file_name, ".vrp") || absl::EndsWith(file_name, ".tsp") ||
+      absl::EndsWith(file_name, ".atsp")) {
+    return LoadTspLibInstance(file_name);
+  }
+  return LoadSolomonInstance(file_name);
+}
+
+// Solves `file_name` with `metaheuristic` and returns the JSON object of the
+// run.
+std::string Run(const std::string& file_name,
+                const LocalSearchMetaheuristic::Value metaheuristic) {
+  double load_time_sec = 0.0;
+  Instance instance;
+  {
+    ScopedWallTime timer(&load_time_sec);
+    instance = LoadInstance(file_name);
+  }
+  RoutingSearchParameters parameters = DefaultRoutingSearchParameters();
+  parameters.set_first_solution_strategy(
+      FirstSolutionStrategy::PATH_CHEAPEST_ARC);
+  parameters.set_local_search_metaheuristic(metaheuristic);
+  CHECK_OK(util_time::EncodeGoogleApiProto(absl::GetFlag(FLAGS_time_limit),
+                                           parameters.mutable_time_limit()));
+  if (absl::GetFlag(FLAGS_solution_limit) > 0) {
+    parameters.set_solution_limit(absl::GetFlag(FLAGS_solution_limit));
+  }
+  QCHECK(ProtobufTextFormatMergeFromString(
+      absl::GetFlag(FLAGS_routing_search_parameters), &parameters))
+      << "Error parsing --routing_search_parameters";
+
+  double solve_time_sec = 0.0;
+  const Assignment* solution = nullptr;
+  {
+    ScopedWallTime timer(&solve_time_sec);
+    solution = instance.model->SolveWithParameters(parameters);
+  }
+
+  const LocalSearchStatistics statistics =
+      instance.model->GetLocalSearchStatistics();
+  int64_t num_filter_calls = 0;
+  double filter_time_sec = 0.0;
+  for (const auto& filter : statistics.local_search_filter_statistics()) {
+    num_filter_calls += filter.num_calls();
+    filter_time_sec += filter.duration_seconds();
+  }
+  std::string statistics_json;
+  google::protobuf::util::JsonPrintOptions print_options;
+  print_options.preserve_proto_field_names = true;
+  CHECK_OK(google::protobuf::util::MessageToJsonString(
+      statistics, &statistics_json, print_options));
+  return absl::StrFormat(
+      "{\"instance\":\"%s\",\"metaheuristic\":\"%s\",\"status\":%d,"
+      "\"objective\":%d,\"load_time_sec\":%.6f,\"solve_time_sec\":%.6f,"
+      "\"num_neighbors\":%d,\"neighbors_per_second\":%.6g,"
+      "\"filter_calls\":%d,\"filter_time_per_call_sec\":%.6g,"
+      "\"num_branches\":%d,\"num_failures\":%d,"
+      "\"local_search_statistics\":%s}",
+      instance.name, LocalSearchMetaheuristic::Value_Name(metaheuristic),
+      static_cast<int>(instance.model->status()),
+      solution == nullptr ? int64_t{-1} : solution->ObjectiveValue(),
+      load_time_sec, solve_time_sec, statistics.total_num_neighbors(),
+      solve_time_sec > 0 ? statistics.total_num_neighbors() / solve_time_sec
+                         : 0.0,
+      num_filter_calls,
+      num_filter_calls > 0 ? filter_time_sec / num_filter_calls : 0.0,
+      instance.model->solver()->branches(),
+      instance.model->solver()->failures(), statistics_json);
+}
+
+void RunAll() {
+  QCHECK(!absl::GetFlag(FLAGS_input).empty()) << "--input is required";
+  std::vector<LocalSearchMetaheuristic::Value> metaheuristics;
+  for (const absl::string_view name : absl::StrSplit(
+           absl::GetFlag(FLAGS_metaheuristics), ',', absl::SkipEmpty())) {
+    LocalSearchMetaheuristic::Value metaheuristic;
+    QCHECK(LocalSearchMetaheuristic::Value_Parse(std::string(name),
+                                                 &metaheuristic))
+        << "Unknown metaheuristic in --metaheuristics: " << name;
+    metaheuristics.push_back(metaheuristic);
+  }
+
+  File* output = nullptr;
+  if (!absl::GetFlag(FLAGS_output).empty()) {
+    output =
+        file::OpenOrDie(absl::GetFlag(FLAGS_output), "a", file::Defaults());
+  }
+  for (const absl::string_view input :
+       absl::StrSplit(absl::GetFlag(FLAGS_input), ',', absl::SkipEmpty())) {
+    for (const LocalSearchMetaheuristic::Value metaheuristic :
+         metaheuristics) {
+      // The model is rebuilt for each run, since a RoutingModel is closed by
+      // its first solve.
+      const std::string line = Run(std::string(input), metaheuristic);
+      if (output == nullptr) {
+        absl::PrintF("%s\n", line);
+      } else {
+        CHECK(output->WriteLine(line));
+        CHECK(output->Flush());
+      }
+    }
+  }
+  if (output != nullptr) CHECK_OK(output->Close(file::Defaults()));
+}
+
+}  // namespace
+}  // namespace operations_research
+
+int main(int argc, char** argv) {
+  InitGoogle(argv[0], &argc, &argv, /*remove_flags=*/true);
+  operations_research::RunAll();
+  return EXIT_SUCCESS;
+}
@@ -15,11 +15,13 @@
 #define OR_TOOLS_ALGORITHMS_ADJUSTABLE_K_ARY_HEAP_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/types/span.h"
 
 // Adjustable k-ary heap for std::pair<Priority, Index> classes containing a
 // priority and an index referring to an array where the relevant data is
@@ -70,11 +72,13 @@ class AdjustableKAryHeap {
     heap_size_ = 0;
   }
 
+  // Replaces the contents of the heap by `elements`, and builds the heap in
+  // O(elements.size()) with Floyd's algorithm, which is faster than inserting
+  // the elements one by one.
   void Load(const std::vector<Aggregate>& elements, HeapIndex universe_size) {
-    data_.resize(elements.size());
+    data_.assign(elements.begin(), elements.end());
     heap_size_ = elements.size();
-    std::copy(elements.begin(), elements.end(), data_.begin());
-    heap_positions_.resize(universe_size, kNonExistent);
+    heap_positions_.assign(universe_size, kNonExistent);
     for (HeapIndex i = 0; i < data_.size(); ++i) {
       heap_positions_[index(i)] = i;
     }
@@ -83,12 +87,15 @@ class AdjustableKAryHeap {
 
   void Load(const std::vector<Index>& indices,
             const std::vector<Priority>& priorities, HeapIndex universe_size) {
-    std::copy(indices.begin(), indices.end(), indices_.begin());
-    std::copy(priorities.begin(), priorities.end(), priorities_.begin());
+    DCHECK_EQ(indices.size(), priorities.size());
+    data_.resize(indices.size());
+    for (HeapIndex i = 0; i < data_.size(); ++i) {
+      data_[i] = {priorities[i], indices[i]};
+    }
     heap_size_ = indices.size();
-    heap_positions_.resize(universe_size, kNonExistent);
+    heap_positions_.assign(universe_size, kNonExistent);
     for (HeapIndex i = 0; i < data_.size(); ++i) {
-      heap_positions_[indices_[i]] = i;
+      heap_positions_[index(i)] = i;
     }
     BuildHeap();
   }
@@ -165,6 +172,24 @@ class AdjustableKAryHeap {
     }
   }
 
+  // Changes the values of several elements, which must all be in the heap.
+  // When the batch is large compared to the heap, all the values are changed
+  // first, and the heap is rebuilt in O(heap_size()), instead of sifting each
+  // element in O(log_k(heap_size())).
+  void Update(absl::Span<const Aggregate> elements) {
+    if (static_cast<int64_t>(elements.size()) * NumLevels() < heap_size()) {
+      for (const Aggregate& element : elements) Update(element);
+      return;
+    }
+    for (const Aggregate& element : elements) {
+      const HeapIndex heap_position = GetHeapPosition(element.second);
+      DCHECK_GE(heap_position, 0);
+      DCHECK_LT(heap_position, heap_size());
+      data_[heap_position] = element;
+    }
+    BuildHeap();
+  }
+
   // Checks if the element with index is in the heap.
   bool Contains(Index index) const {
     return GetHeapPosition(index) != kNonExistent;
@@ -208,6 +233,15 @@ class AdjustableKAryHeap {
     return true;
   }
 
+  // Returns the number of levels of the heap, i.e. about log_k(heap_size()).
+  int NumLevels() const {
+    int num_levels = 0;
+    for (HeapIndex size = heap_size(); size > 0; size = Parent(size)) {
+      ++num_levels;
+    }
+    return num_levels;
+  }
+
   // Maintains heap property by sifting down starting from the end,
   void BuildHeap() {
     for (HeapIndex i = Parent(heap_size()); i >= 0; --i) {
@@ -289,15 +323,8 @@ class AdjustableKAryHeap {
   // The heap is stored as a vector.
   std::vector<Aggregate> data_;
 
-  // The heap is stored as two vectors.
-  // indices_ is such that heap_positions_[indices_[i]] == i
-  // and indices_[heap_positions_[i]] == i, at all times unless
-  // indices_[i] is not in the heap, and therefore
-  // heap_positions_[indices[i]] == -1.
-  std::vector<Index> indices_;
-  std::vector<Priority> priorities_;
-
-  // Maps original index to current heap position.
+  // Maps original index to current heap position, or kNonExistent for the
+  // indices that are not in the heap.
   std::vector<Index> heap_positions_;
 
   // The number of elements currently in the heap. This may be updated
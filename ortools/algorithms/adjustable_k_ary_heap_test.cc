@@ -87,6 +87,63 @@ TEST(AdjustableKAryHeapTest, UpdateStrongCheck) {
   }
 }
 
+TEST(AdjustableKAryHeapTest, BatchUpdateStrongCheck) {
+  const int kSize = 10'000;
+  const double priority_range = kSize / 100;
+  std::mt19937 generator(12345);
+  std::uniform_real_distribution<float> priority_dist(0, priority_range);
+  std::uniform_int_distribution<int> index_dist(0, kSize - 1);
+  std::vector<std::pair<float, int>> subsets_and_values(kSize);
+  for (int i = 0; i < kSize; ++i) {
+    subsets_and_values[i] = {priority_dist(generator), i};
+  }
+  AdjustableKAryHeap<float, int, 4, true> heap(subsets_and_values, kSize);
+  AdjustableKAryHeap<float, int, 4, true> reference_heap(subsets_and_values,
+                                                         kSize);
+  // Small batches are applied one by one, large ones rebuild the heap.
+  for (const int batch_size : {1, 10, 1'000, 5'000, 20'000}) {
+    std::vector<std::pair<float, int>> batch(batch_size);
+    for (auto& element : batch) {
+      element = {priority_dist(generator), index_dist(generator)};
+      reference_heap.Update(element);
+    }
+    heap.Update(batch);
+    EXPECT_TRUE(heap.CheckHeapProperty());
+    EXPECT_EQ(heap.TopIndex(), reference_heap.TopIndex());
+  }
+  while (!heap.IsEmpty()) {
+    ASSERT_EQ(heap.TopIndex(), reference_heap.TopIndex());
+    ASSERT_EQ(heap.TopPriority(), reference_heap.TopPriority());
+    heap.Pop();
+    reference_heap.Pop();
+  }
+}
+
+TEST(AdjustableKAryHeapTest, LoadIndicesAndPriorities) {
+  const int kSize = 10'000;
+  std::mt19937 generator(12345);
+  std::uniform_real_distribution<float> priority_dist(0, kSize);
+  std::vector<int> indices;
+  std::vector<float> priorities;
+  for (int i = 0; i < kSize; i += 2) {
+    indices.push_back(i);
+    priorities.push_back(priority_dist(generator));
+  }
+  AdjustableKAryHeap<float, int, 4, false> heap;
+  heap.Insert({0.0, 1});
+  heap.Load(indices, priorities, kSize);
+  EXPECT_TRUE(heap.CheckHeapProperty());
+  EXPECT_EQ(heap.heap_size(), kSize / 2);
+  EXPECT_FALSE(heap.Contains(1));
+  float last = std::numeric_limits<float>::lowest();
+  while (!heap.IsEmpty()) {
+    EXPECT_EQ(heap.TopIndex() % 2, 0);
+    EXPECT_GE(heap.TopPriority(), last);
+    last = heap.TopPriority();
+    heap.Pop();
+  }
+}
+
 TEST(AdjustableKAryHeapTest, RemoveStrongCheck) {
   const int kSize = 10'000;
   const int kNumRemovals = kSize;
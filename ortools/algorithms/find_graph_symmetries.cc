@@ -14,6 +14,7 @@
 #include "ortools/algorithms/find_graph_symmetries.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -29,6 +30,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
@@ -36,6 +38,7 @@
 #include "ortools/algorithms/dynamic_partition.h"
 #include "ortools/algorithms/dynamic_permutation.h"
 #include "ortools/algorithms/sparse_permutation.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/graph/iterators.h"
 #include "ortools/graph/util.h"
 
@@ -338,6 +341,138 @@ void GraphSymmetryFinder::RecursivelyRefinePartitionByAdjacency(
                                         static_cast<double>(num_operations));
 }
 
+namespace {
+// The nodes adjacent to a part of a DynamicPartition, grouped by their
+// aggregated degree with respect to that part: the nodes with the i-th
+// smallest nonzero degree are nodes[group_starts[i] .. group_starts[i + 1]).
+struct AdjacencyOfPart {
+  std::vector<int> nodes;
+  std::vector<int> group_starts;
+};
+
+// The number of parts processed by each thread between two sequential
+// refinements of the partition. Larger batches mean fewer synchronizations,
+// but more memory for the adjacencies.
+constexpr int kNumPartsPerThreadInBatch = 16;
+}  // namespace
+
+void GraphSymmetryFinder::ParallelRefinePartitionByAdjacency(
+    int num_threads, DynamicPartition* partition) {
+  // Refining the partition by the adjacency to a union of its parts is valid,
+  // since any such union that is invariant by the automorphisms yields an
+  // invariant refinement. So we can compute the aggregated degrees with
+  // respect to all the parts of the input partition in parallel, without
+  // taking into account the splits that the refinements by the parts before
+  // them would have made. And as in RecursivelyRefinePartitionByAdjacency(),
+  // when one of these parts gets split, one of the two halves is a new part,
+  // so refining on all the new parts afterwards yields the full refinement.
+  const int num_initial_parts = partition->NumParts();
+  std::vector<bool> adjacency_directions(1, /*outgoing*/ true);
+  if (!reverse_adj_list_index_.empty()) {
+    adjacency_directions.push_back(false);  // Also look at incoming arcs.
+  }
+  const int num_directions = adjacency_directions.size();
+  const int batch_size = kNumPartsPerThreadInBatch * num_threads;
+  std::vector<AdjacencyOfPart> adjacencies(batch_size * num_directions);
+  std::vector<int64_t> num_operations_of_thread(num_threads, 0);
+  // Each thread has its own degree counters, in their resting state
+  // [0..N-1] = 0 between two parts.
+  std::vector<std::vector<int>> degree_of_thread(num_threads);
+  ThreadPool pool("SymmetryRefine", num_threads - 1);
+  pool.StartWorkers();
+  for (int batch_start = 0; batch_start < num_initial_parts;
+       batch_start += batch_size) {
+    const int batch_end = std::min(num_initial_parts, batch_start + batch_size);
+    // The threads pick the parts of the batch dynamically; since each part is
+    // processed independently, this does not affect the result.
+    std::atomic<int> next_part_index = batch_start;
+    const auto compute_adjacencies = [&](int thread) {
+      std::vector<int>& degree = degree_of_thread[thread];
+      degree.resize(NumNodes(), 0);
+      std::vector<int> nodes_with_nonzero_degree;
+      std::vector<int> num_nodes_with_degree;
+      int64_t& num_operations = num_operations_of_thread[thread];
+      for (int part_index = next_part_index++; part_index < batch_end;
+           part_index = next_part_index++) {
+        for (int d = 0; d < num_directions; ++d) {
+          if (adjacency_directions[d]) {
+            for (const int node : partition->ElementsInPart(part_index)) {
+              IncrementCounterForNonSingletons(
+                  graph_[node], *partition, &degree,
+                  &nodes_with_nonzero_degree, &num_operations);
+            }
+          } else {
+            for (const int node : partition->ElementsInPart(part_index)) {
+              IncrementCounterForNonSingletons(
+                  TailsOfIncomingArcsTo(node), *partition, &degree,
+                  &nodes_with_nonzero_degree, &num_operations);
+            }
+          }
+          // Group the nodes by degree with a counting sort, keeping the order
+          // in which they were seen within each group.
+          int max_degree = 0;
+          for (const int node : nodes_with_nonzero_degree) {
+            max_degree = std::max(max_degree, degree[node]);
+          }
+          num_nodes_with_degree.assign(max_degree + 1, 0);
+          for (const int node : nodes_with_nonzero_degree) {
+            ++num_nodes_with_degree[degree[node]];
+          }
+          AdjacencyOfPart& adjacency =
+              adjacencies[(part_index - batch_start) * num_directions + d];
+          adjacency.group_starts.clear();
+          int start = 0;
+          for (int& num_nodes : num_nodes_with_degree) {
+            const int size = num_nodes;
+            num_nodes = start;  // Now the next position in the group.
+            if (size > 0) adjacency.group_starts.push_back(start);
+            start += size;
+          }
+          adjacency.group_starts.push_back(start);
+          adjacency.nodes.resize(start);
+          for (const int node : nodes_with_nonzero_degree) {
+            adjacency.nodes[num_nodes_with_degree[degree[node]]++] = node;
+            degree[node] = 0;  // To clean up after us.
+          }
+          num_operations += 3 + 2 * nodes_with_nonzero_degree.size();
+          nodes_with_nonzero_degree.clear();
+        }
+      }
+    };
+    absl::BlockingCounter counter(num_threads - 1);
+    for (int thread = 1; thread < num_threads; ++thread) {
+      pool.Schedule([&, thread]() {
+        compute_adjacencies(thread);
+        counter.DecrementCount();
+      });
+    }
+    compute_adjacencies(0);
+    counter.Wait();
+
+    // Refine the partition sequentially, in the order of the parts.
+    int64_t num_operations = 0;
+    for (int i = 0; i < (batch_end - batch_start) * num_directions; ++i) {
+      const AdjacencyOfPart& adjacency = adjacencies[i];
+      const int num_groups = adjacency.group_starts.size() - 1;
+      for (int g = 0; g < num_groups; ++g) {
+        const int start = adjacency.group_starts[g];
+        const absl::Span<const int> group = absl::MakeConstSpan(
+            adjacency.nodes.data() + start,
+            adjacency.group_starts[g + 1] - start);
+        num_operations += 1 + 3 * group.size();
+        partition->Refine(group);
+      }
+    }
+    time_limit_->AdvanceDeterministicTime(1e-8 *
+                                          static_cast<double>(num_operations));
+  }
+  int64_t num_operations = 0;
+  for (const int64_t n : num_operations_of_thread) num_operations += n;
+  time_limit_->AdvanceDeterministicTime(1e-8 *
+                                        static_cast<double>(num_operations));
+  RecursivelyRefinePartitionByAdjacency(num_initial_parts, partition);
+}
+
 void GraphSymmetryFinder::DistinguishNodeInPartition(
     int node, DynamicPartition* partition, std::vector<int>* new_singletons) {
   const int original_num_parts = partition->NumParts();
@@ -463,8 +598,12 @@ absl::Status GraphSymmetryFinder::FindSymmetries(
   // Break all inherent asymmetries in the graph.
   {
     ScopedTimeDistributionUpdater u(&stats_.initialization_refine_time);
-    RecursivelyRefinePartitionByAdjacency(/*first_unrefined_part_index=*/0,
-                                          &base_partition);
+    if (num_threads_ > 1) {
+      ParallelRefinePartitionByAdjacency(num_threads_, &base_partition);
+    } else {
+      RecursivelyRefinePartitionByAdjacency(/*first_unrefined_part_index=*/0,
+                                            &base_partition);
+    }
   }
   if (time_limit_->LimitReached()) {
     return absl::Status(absl::StatusCode::kDeadlineExceeded,
@@ -476,6 +615,7 @@ absl::Status GraphSymmetryFinder::FindSymmetries(
   MergingPartition node_equivalence_classes(NumNodes());
   std::vector<std::vector<int>> permutations_displacing_node(NumNodes());
   std::vector<int> potential_root_image_nodes;
+  std::vector<int> root_base_singletons;
   IF_STATS_ENABLED(stats_.initialization_time.StopTimerAndAddElapsedTime());
 
   // To find all permutations of the Graph that satisfy the current partition,
@@ -578,6 +718,15 @@ absl::Status GraphSymmetryFinder::FindSymmetries(
     DCHECK(!potential_root_image_nodes.empty());
     IF_STATS_ENABLED(stats_.invariant_unroll_time.StopTimerAndAddElapsedTime());
 
+    // Refining the base partition on "root_node" is the same for all its
+    // potential images, so we only do it once, and keep it across all the
+    // calls to FindOneSuitablePermutation() below.
+    {
+      ScopedTimeDistributionUpdater u(&stats_.initial_search_refine_time);
+      DistinguishNodeInPartition(root_node, &base_partition,
+                                 &root_base_singletons);
+    }
+
     // Try to map "root_node" to all of its potential images. For each image,
     // we only care about finding a single compatible permutation, if it exists.
     while (!potential_root_image_nodes.empty()) {
@@ -591,7 +740,8 @@ absl::Status GraphSymmetryFinder::FindSymmetries(
       std::unique_ptr<SparsePermutation> permutation =
           FindOneSuitablePermutation(root_node, root_image_node,
                                      &base_partition, &image_partition,
-                                     *generators, permutations_displacing_node);
+                                     root_base_singletons, *generators,
+                                     permutations_displacing_node);
 
       if (permutation != nullptr) {
         ScopedTimeDistributionUpdater u(&stats_.permutation_output_time);
@@ -623,6 +773,7 @@ absl::Status GraphSymmetryFinder::FindSymmetries(
 
       potential_root_image_nodes.pop_back();
     }
+    base_partition.UndoRefineUntilNumPartsEqual(base_num_parts);
 
     // We keep track of the size of the orbit of 'root_node' under the
     // current subgroup: this is one of the factors of the total group size.
@@ -693,37 +844,38 @@ std::unique_ptr<SparsePermutation>
 GraphSymmetryFinder::FindOneSuitablePermutation(
     int root_node, int root_image_node, DynamicPartition* base_partition,
     DynamicPartition* image_partition,
+    absl::Span<const int> root_base_singletons,
     absl::Span<const std::unique_ptr<SparsePermutation>>
         generators_found_so_far,
     absl::Span<const std::vector<int>> permutations_displacing_node) {
   // DCHECKs() and statistics.
   ScopedTimeDistributionUpdater search_time_updater(&stats_.search_time);
   DCHECK_EQ("", tmp_dynamic_permutation_.DebugString());
-  DCHECK_EQ(
-      base_partition->DebugString(/*sort_parts_lexicographically=*/false),
-      image_partition->DebugString(/*sort_parts_lexicographically=*/false));
+  DCHECK_EQ(base_partition->SizeOfPart(base_partition->PartOf(root_node)), 1);
   DCHECK(search_states_.empty());
 
+  // The base partition was already refined on root_node by the caller: this
+  // is the state that we restore upon return.
+  const int num_root_refined_parts = base_partition->NumParts();
+
   // These will be used during the search. See their usage.
-  std::vector<int> base_singletons;
+  std::vector<int> base_singletons(root_base_singletons.begin(),
+                                   root_base_singletons.end());
   std::vector<int> image_singletons;
   int next_base_node;
   int next_image_node;
   int min_potential_mismatching_part_index;
   std::vector<int> next_potential_image_nodes;
 
-  // Initialize the search: we can already distinguish "root_node" in the base
-  // partition. See the comment below.
+  // Initialize the search: "root_node" is already distinguished in the base
+  // partition, and the image partition is in the state that the base partition
+  // had before that. See the comment below.
   search_states_.emplace_back(
       /*base_node=*/root_node, /*first_image_node=*/-1,
-      /*num_parts_before_trying_to_map_base_node=*/base_partition->NumParts(),
-      /*min_potential_mismatching_part_index=*/base_partition->NumParts());
+      /*num_parts_before_trying_to_map_base_node=*/image_partition->NumParts(),
+      /*min_potential_mismatching_part_index=*/image_partition->NumParts());
   // We inject the image node directly as the "remaining_pruned_image_nodes".
   search_states_.back().remaining_pruned_image_nodes.assign(1, root_image_node);
-  {
-    ScopedTimeDistributionUpdater u(&stats_.initial_search_refine_time);
-    DistinguishNodeInPartition(root_node, base_partition, &base_singletons);
-  }
   while (!search_states_.empty()) {
     if (time_limit_->LimitReached()) return nullptr;
     // When exploring a SearchState "ss", we're supposed to have:
@@ -823,7 +975,7 @@ GraphSymmetryFinder::FindOneSuitablePermutation(
         VLOG(4) << "Automorphism found: " << sparse_permutation->DebugString();
         const int base_num_parts =
             search_states_[0].num_parts_before_trying_to_map_base_node;
-        base_partition->UndoRefineUntilNumPartsEqual(base_num_parts);
+        base_partition->UndoRefineUntilNumPartsEqual(num_root_refined_parts);
         image_partition->UndoRefineUntilNumPartsEqual(base_num_parts);
         tmp_dynamic_permutation_.Reset();
         search_states_.clear();
@@ -919,8 +1071,11 @@ GraphSymmetryFinder::FindOneSuitablePermutation(
         if (!last_ss->remaining_pruned_image_nodes.empty()) break;
 
         VLOG(4) << "Backtracking one level up.";
+        // The refinement of the root node is kept for the next call.
         base_partition->UndoRefineUntilNumPartsEqual(
-            last_ss->num_parts_before_trying_to_map_base_node);
+            search_states_.size() == 1
+                ? num_root_refined_parts
+                : last_ss->num_parts_before_trying_to_map_base_node);
         // If this was the root search state (i.e. we fully backtracked and
         // will exit the search after that), we don't have mappings to undo.
         // We run UndoLastMappings() anyway, because it's a no-op in that case.
@@ -61,6 +61,14 @@ class GraphSymmetryFinder {
   // TODO(user): support multi-arcs.
   GraphSymmetryFinder(const Graph& graph, bool is_undirected);
 
+  // Sets the number of threads used by FindSymmetries() for the initial
+  // refinement of the partition, which dominates the running time on large
+  // graphs. With more than one thread, the parts of the initial partition are
+  // processed in parallel, which may yield different (but equally valid)
+  // generators than with a single thread. The result does not depend on the
+  // number of threads, as long as it is greater than one.
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
   // Whether the given permutation is an automorphism of the graph given at
   // construction. This costs O(sum(degree(x))) (the sum is over all nodes x
   // that are displaced by the permutation).
@@ -125,6 +133,14 @@ class GraphSymmetryFinder {
   void RecursivelyRefinePartitionByAdjacency(int first_unrefined_part_index,
                                              DynamicPartition* partition);
 
+  // Same as RecursivelyRefinePartitionByAdjacency(0, partition), but the
+  // aggregated degrees with respect to the parts of the partition given as
+  // input are computed in parallel, with "num_threads" threads. The partition
+  // is then refined by these degrees in the order of the parts, and the
+  // resulting new parts are refined sequentially.
+  void ParallelRefinePartitionByAdjacency(int num_threads,
+                                          DynamicPartition* partition);
+
   // **** Methods below are public FOR TESTING ONLY. ****
 
   // Special wrapper of the above method: assuming that partition is already
@@ -136,6 +152,7 @@ class GraphSymmetryFinder {
 
  private:
   const Graph& graph_;
+  int num_threads_ = 1;
 
   inline int NumNodes() const { return graph_.num_nodes(); }
 
@@ -170,9 +187,17 @@ class GraphSymmetryFinder {
   // FindGraphSymmetries(), with the permutations found so far; and the latter
   // is an inverted index from each node to all permutations (that we found)
   // that displace it.
+  //
+  // "base_partition" must already be refined on root_node by
+  // DistinguishNodeInPartition(), which created the singletons
+  // "root_base_singletons": this refinement does not depend on the image
+  // node, so it is computed once and shared by all the calls for the same
+  // root_node. Upon return, "base_partition" is back in that state, and
+  // "image_partition" is back in its original state.
   std::unique_ptr<SparsePermutation> FindOneSuitablePermutation(
       int root_node, int root_image_node, DynamicPartition* base_partition,
       DynamicPartition* image_partition,
+      absl::Span<const int> root_base_singletons,
       absl::Span<const std::unique_ptr<SparsePermutation>>
           generators_found_so_far,
       absl::Span<const std::vector<int>> permutations_displacing_node);
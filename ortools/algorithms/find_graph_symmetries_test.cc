@@ -137,6 +137,40 @@ TEST(RecursivelyRefinePartitionByAdjacencyTest, FlowerOfCycles) {
                                                }));
 }
 
+TEST(ParallelRefinePartitionByAdjacencyTest, SameAsSequentialOnRandomGraphs) {
+  std::mt19937 random(12345);
+  for (int iter = 0; iter < 50; ++iter) {
+    const int num_nodes = absl::Uniform(random, 1, 200);
+    const int num_arcs = absl::Uniform(random, 0, 3 * num_nodes);
+    const int num_colors = absl::Uniform(random, 1, 5);
+    std::set<std::pair<int, int>> arcs;
+    for (int i = 0; i < num_arcs; ++i) {
+      arcs.insert({absl::Uniform(random, 0, num_nodes),
+                   absl::Uniform(random, 0, num_nodes)});
+    }
+    Graph graph;
+    graph.AddNode(num_nodes - 1);
+    for (const auto [tail, head] : arcs) graph.AddArc(tail, head);
+    graph.Build();
+    std::vector<int> colors(num_nodes);
+    for (int& color : colors) color = absl::Uniform(random, 0, num_colors);
+
+    GraphSymmetryFinder symmetry_finder(graph, GraphIsSymmetric(graph));
+    DynamicPartition sequential_partition(colors);
+    symmetry_finder.RecursivelyRefinePartitionByAdjacency(
+        0, &sequential_partition);
+    for (const int num_threads : {1, 3}) {
+      DynamicPartition parallel_partition(colors);
+      symmetry_finder.ParallelRefinePartitionByAdjacency(num_threads,
+                                                         &parallel_partition);
+      EXPECT_EQ(sequential_partition.DebugString(
+                    /*sort_parts_lexicographically=*/true),
+                parallel_partition.DebugString(
+                    /*sort_parts_lexicographically=*/true));
+    }
+  }
+}
+
 TEST(GraphSymmetryFinderTest, EmptyGraph) {
   for (bool is_undirected : {true, false}) {
     SCOPED_TRACE(DUMP_VARS(is_undirected));
@@ -324,41 +358,47 @@ class FindSymmetriesTest : public ::testing::Test {
     for (const std::pair<int, int>& arc : arcs)
       graph.AddArc(arc.first, arc.second);
     graph.Build();
-    GraphSymmetryFinder symmetry_finder(graph, GraphIsSymmetric(graph));
-    std::vector<std::unique_ptr<SparsePermutation>> generators;
-    std::vector<int> node_equivalence_classes(graph.num_nodes(), 0);
-    std::vector<int> orbit_sizes;
-    TimeLimit time_limit(kDefaultTimeLimitSeconds);
-    ASSERT_OK(symmetry_finder.FindSymmetries(
-        &node_equivalence_classes, &generators, &orbit_sizes, &time_limit));
-    std::vector<std::string> permutations_str;
-    for (const std::unique_ptr<SparsePermutation>& permutation : generators) {
-      permutations_str.push_back(permutation->DebugString());
-    }
-    SCOPED_TRACE(
-        "Graph: " + absl::StrJoin(arcs, ", ", absl::PairFormatter("->")) +
-        "\nGenerators found:\n  " + absl::StrJoin(permutations_str, "\n  "));
-
-    // Verify the equivalence classes.
-    EXPECT_EQ(expected_node_equivalence_classes,
-              DynamicPartition(node_equivalence_classes)
-                  .DebugString(/*sort_parts_lexicographically=*/true));
-
-    // Verify the automorphism group size.
-    double log_of_permutation_group_size = 0.0;
-    for (const int orbit_size : orbit_sizes) {
-      log_of_permutation_group_size += log(orbit_size);
-    }
-    EXPECT_THAT(log_of_permutation_group_size,
-                DoubleEq(log_of_expected_permutation_group_size))
-        << absl::StrJoin(orbit_sizes, " x ");
-
-    if (log_of_expected_permutation_group_size <= log(1000.0)) {
-      const int expected_permutation_group_size =
-          static_cast<int>(round(exp(log_of_expected_permutation_group_size)));
-      EXPECT_EQ(
-          expected_permutation_group_size,
-          ComputePermutationGroupSizeAndVerifyBasicIrreductibility(generators));
+    // The parallel initial refinement may yield different generators, but the
+    // same group.
+    for (const int num_threads : {1, 4}) {
+      SCOPED_TRACE(absl::StrCat("num_threads: ", num_threads));
+      GraphSymmetryFinder symmetry_finder(graph, GraphIsSymmetric(graph));
+      symmetry_finder.SetNumThreads(num_threads);
+      std::vector<std::unique_ptr<SparsePermutation>> generators;
+      std::vector<int> node_equivalence_classes(graph.num_nodes(), 0);
+      std::vector<int> orbit_sizes;
+      TimeLimit time_limit(kDefaultTimeLimitSeconds);
+      ASSERT_OK(symmetry_finder.FindSymmetries(
+          &node_equivalence_classes, &generators, &orbit_sizes, &time_limit));
+      std::vector<std::string> permutations_str;
+      for (const std::unique_ptr<SparsePermutation>& permutation : generators) {
+        permutations_str.push_back(permutation->DebugString());
+      }
+      SCOPED_TRACE(
+          "Graph: " + absl::StrJoin(arcs, ", ", absl::PairFormatter("->")) +
+          "\nGenerators found:\n  " + absl::StrJoin(permutations_str, "\n  "));
+
+      // Verify the equivalence classes.
+      EXPECT_EQ(expected_node_equivalence_classes,
+                DynamicPartition(node_equivalence_classes)
+                    .DebugString(/*sort_parts_lexicographically=*/true));
+
+      // Verify the automorphism group size.
+      double log_of_permutation_group_size = 0.0;
+      for (const int orbit_size : orbit_sizes) {
+        log_of_permutation_group_size += log(orbit_size);
+      }
+      EXPECT_THAT(log_of_permutation_group_size,
+                  DoubleEq(log_of_expected_permutation_group_size))
+          << absl::StrJoin(orbit_sizes, " x ");
+
+      if (log_of_expected_permutation_group_size <= log(1000.0)) {
+        const int expected_permutation_group_size = static_cast<int>(
+            round(exp(log_of_expected_permutation_group_size)));
+        EXPECT_EQ(expected_permutation_group_size,
+                  ComputePermutationGroupSizeAndVerifyBasicIrreductibility(
+                      generators));
+      }
     }
   }
 };
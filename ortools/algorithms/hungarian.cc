@@ -17,6 +17,7 @@
 #include <cmath>
 #include <cstdio>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -688,4 +689,290 @@ void MaximizeLinearAssignment(
   }
 }
 
+int IncrementalLinearAssignment::AddSlots() {
+  const int slot = costs_.size();
+  for (std::vector<double>& row : costs_) row.push_back(0.0);
+  costs_.emplace_back(slot + 1, 0.0);
+  // The new column has only zero costs, and so does the new row.
+  row_potential_.push_back(0.0);
+  column_potential_.push_back(0.0);
+  UpdateRowPotential(slot);
+  UpdateColumnPotential(slot);
+  row_mate_.push_back(-1);
+  column_mate_.push_back(-1);
+  row_of_slot_.push_back(-1);
+  column_of_slot_.push_back(-1);
+  return slot;
+}
+
+void IncrementalLinearAssignment::RemoveSlots(int row_slot, int column_slot) {
+  DCHECK_EQ(row_mate_[row_slot], -1);
+  DCHECK_EQ(column_mate_[column_slot], -1);
+  const int last = costs_.size() - 1;
+  if (row_slot != last) {
+    costs_[row_slot] = std::move(costs_[last]);
+    row_potential_[row_slot] = row_potential_[last];
+    row_mate_[row_slot] = row_mate_[last];
+    if (row_mate_[row_slot] >= 0) column_mate_[row_mate_[row_slot]] = row_slot;
+    row_of_slot_[row_slot] = row_of_slot_[last];
+    if (row_of_slot_[row_slot] >= 0) {
+      row_slot_[row_of_slot_[row_slot]] = row_slot;
+    }
+  }
+  costs_.pop_back();
+  row_potential_.pop_back();
+  row_mate_.pop_back();
+  row_of_slot_.pop_back();
+  if (column_slot != last) {
+    for (std::vector<double>& row : costs_) row[column_slot] = row[last];
+    column_potential_[column_slot] = column_potential_[last];
+    column_mate_[column_slot] = column_mate_[last];
+    if (column_mate_[column_slot] >= 0) {
+      row_mate_[column_mate_[column_slot]] = column_slot;
+    }
+    column_of_slot_[column_slot] = column_of_slot_[last];
+    if (column_of_slot_[column_slot] >= 0) {
+      column_slot_[column_of_slot_[column_slot]] = column_slot;
+    }
+  }
+  for (std::vector<double>& row : costs_) row.pop_back();
+  column_potential_.pop_back();
+  column_mate_.pop_back();
+  column_of_slot_.pop_back();
+}
+
+int IncrementalLinearAssignment::FindDummyRowSlot() const {
+  for (int slot = 0; slot < row_of_slot_.size(); ++slot) {
+    if (row_of_slot_[slot] < 0) return slot;
+  }
+  return -1;
+}
+
+int IncrementalLinearAssignment::FindDummyColumnSlot() const {
+  for (int slot = 0; slot < column_of_slot_.size(); ++slot) {
+    if (column_of_slot_[slot] < 0) return slot;
+  }
+  return -1;
+}
+
+void IncrementalLinearAssignment::UpdateRowPotential(int row_slot) {
+  const std::vector<double>& row = costs_[row_slot];
+  double potential = std::numeric_limits<double>::infinity();
+  for (int column = 0; column < row.size(); ++column) {
+    potential = std::min(potential, row[column] - column_potential_[column]);
+  }
+  row_potential_[row_slot] = potential;
+}
+
+void IncrementalLinearAssignment::UpdateColumnPotential(int column_slot) {
+  double potential = std::numeric_limits<double>::infinity();
+  for (int row = 0; row < costs_.size(); ++row) {
+    potential =
+        std::min(potential, costs_[row][column_slot] - row_potential_[row]);
+  }
+  column_potential_[column_slot] = potential;
+}
+
+void IncrementalLinearAssignment::Augment(int row_slot) {
+  const int size = costs_.size();
+  // distance[column] is the length of the shortest alternating path from
+  // row_slot to column found so far, with the reduced costs as lengths.
+  std::vector<double> distance(size);
+  std::vector<int> parent_row(size, row_slot);
+  std::vector<bool> scanned(size, false);
+  std::vector<int> scanned_columns;
+  for (int column = 0; column < size; ++column) {
+    distance[column] = costs_[row_slot][column] - row_potential_[row_slot] -
+                       column_potential_[column];
+  }
+  int end_column = -1;
+  while (end_column < 0) {
+    int column = -1;
+    for (int candidate = 0; candidate < size; ++candidate) {
+      if (scanned[candidate]) continue;
+      if (column < 0 || distance[candidate] < distance[column]) {
+        column = candidate;
+      }
+    }
+    DCHECK_GE(column, 0);
+    scanned[column] = true;
+    scanned_columns.push_back(column);
+    const int row = column_mate_[column];
+    if (row < 0) {
+      end_column = column;
+      break;
+    }
+    const std::vector<double>& costs = costs_[row];
+    const double offset = distance[column] - row_potential_[row];
+    for (int next = 0; next < size; ++next) {
+      if (scanned[next]) continue;
+      const double new_distance =
+          offset + costs[next] - column_potential_[next];
+      if (new_distance < distance[next]) {
+        distance[next] = new_distance;
+        parent_row[next] = row;
+      }
+    }
+  }
+
+  // Updates the potentials so that the reduced costs stay non-negative and
+  // become zero along the path.
+  const double length = distance[end_column];
+  row_potential_[row_slot] += length;
+  for (const int column : scanned_columns) {
+    const double delta = length - distance[column];
+    column_potential_[column] -= delta;
+    if (column != end_column) row_potential_[column_mate_[column]] += delta;
+  }
+
+  for (int column = end_column;;) {
+    const int row = parent_row[column];
+    const int next = row_mate_[row];
+    row_mate_[row] = column;
+    column_mate_[column] = row;
+    if (row == row_slot) break;
+    column = next;
+  }
+}
+
+int IncrementalLinearAssignment::AddRow(absl::Span<const double> costs) {
+  CHECK_GE(costs.size(), column_slot_.size());
+  int id;
+  if (free_row_ids_.empty()) {
+    id = row_slot_.size();
+    row_slot_.push_back(-1);
+  } else {
+    id = free_row_ids_.back();
+    free_row_ids_.pop_back();
+  }
+  int slot = FindDummyRowSlot();
+  if (slot < 0) {
+    slot = AddSlots();
+  } else {
+    column_mate_[row_mate_[slot]] = -1;
+    row_mate_[slot] = -1;
+  }
+  row_slot_[id] = slot;
+  row_of_slot_[slot] = id;
+  ++num_rows_;
+  for (int column = 0; column < column_slot_.size(); ++column) {
+    if (column_slot_[column] < 0) continue;
+    DCHECK(!std::isnan(costs[column]));
+    costs_[slot][column_slot_[column]] = costs[column];
+  }
+  UpdateRowPotential(slot);
+  Augment(slot);
+  return id;
+}
+
+int IncrementalLinearAssignment::AddColumn(absl::Span<const double> costs) {
+  CHECK_GE(costs.size(), row_slot_.size());
+  int id;
+  if (free_column_ids_.empty()) {
+    id = column_slot_.size();
+    column_slot_.push_back(-1);
+  } else {
+    id = free_column_ids_.back();
+    free_column_ids_.pop_back();
+  }
+  int slot = FindDummyColumnSlot();
+  int free_row_slot;
+  if (slot < 0) {
+    slot = AddSlots();
+    free_row_slot = slot;
+  } else {
+    free_row_slot = column_mate_[slot];
+    row_mate_[free_row_slot] = -1;
+    column_mate_[slot] = -1;
+  }
+  column_slot_[id] = slot;
+  column_of_slot_[slot] = id;
+  ++num_columns_;
+  for (int row = 0; row < row_slot_.size(); ++row) {
+    if (row_slot_[row] < 0) continue;
+    DCHECK(!std::isnan(costs[row]));
+    costs_[row_slot_[row]][slot] = costs[row];
+  }
+  UpdateColumnPotential(slot);
+  Augment(free_row_slot);
+  return id;
+}
+
+void IncrementalLinearAssignment::RemoveRow(int row) {
+  const int slot = row_slot_[row];
+  DCHECK_GE(slot, 0);
+  row_slot_[row] = -1;
+  row_of_slot_[slot] = -1;
+  free_row_ids_.push_back(row);
+  --num_rows_;
+  const int column_slot = FindDummyColumnSlot();
+  if (column_slot >= 0) {
+    // Removes the row with a dummy column: the column of the row and the row
+    // of the dummy column, if they are different, become unmatched.
+    const int mate = row_mate_[slot];
+    const int dummy_mate = column_mate_[column_slot];
+    row_mate_[slot] = -1;
+    column_mate_[mate] = -1;
+    row_mate_[dummy_mate] = -1;
+    column_mate_[column_slot] = -1;
+    if (mate == column_slot) {
+      RemoveSlots(slot, column_slot);
+      return;
+    }
+    // RemoveSlots() may move dummy_mate.
+    const int last = costs_.size() - 1;
+    RemoveSlots(slot, column_slot);
+    Augment(dummy_mate == last ? slot : dummy_mate);
+    return;
+  }
+  // The row becomes a dummy row.
+  column_mate_[row_mate_[slot]] = -1;
+  row_mate_[slot] = -1;
+  std::fill(costs_[slot].begin(), costs_[slot].end(), 0.0);
+  UpdateRowPotential(slot);
+  Augment(slot);
+}
+
+void IncrementalLinearAssignment::RemoveColumn(int column) {
+  const int slot = column_slot_[column];
+  DCHECK_GE(slot, 0);
+  column_slot_[column] = -1;
+  column_of_slot_[slot] = -1;
+  free_column_ids_.push_back(column);
+  --num_columns_;
+  const int row_slot = FindDummyRowSlot();
+  const int mate = column_mate_[slot];
+  column_mate_[slot] = -1;
+  row_mate_[mate] = -1;
+  if (row_slot >= 0) {
+    // Removes the column with a dummy row: the row of the column and the
+    // column of the dummy row, if they are different, become unmatched.
+    if (mate == row_slot) {
+      RemoveSlots(row_slot, slot);
+      return;
+    }
+    column_mate_[row_mate_[row_slot]] = -1;
+    row_mate_[row_slot] = -1;
+    const int last = costs_.size() - 1;
+    RemoveSlots(row_slot, slot);
+    Augment(mate == last ? row_slot : mate);
+    return;
+  }
+  // The column becomes a dummy column.
+  for (std::vector<double>& row : costs_) row[slot] = 0.0;
+  UpdateColumnPotential(slot);
+  Augment(mate);
+}
+
+double IncrementalLinearAssignment::TotalCost() const {
+  double total_cost = 0.0;
+  for (int slot = 0; slot < costs_.size(); ++slot) {
+    if (row_of_slot_[slot] < 0 || column_of_slot_[row_mate_[slot]] < 0) {
+      continue;
+    }
+    total_cost += costs_[slot][row_mate_[slot]];
+  }
+  return total_cost;
+}
+
 }  // namespace operations_research
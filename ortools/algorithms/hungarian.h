@@ -34,6 +34,10 @@
 // This code is based on (read: translated from) the Java version
 // (read: translated from) the Python version at
 //   http://www.clapper.org/software/python/munkres/.
+//
+// IncrementalLinearAssignment, below, maintains a minimum-cost assignment
+// while agents (rows) and tasks (columns) are added and removed, with O(n^2)
+// work per change instead of the O(n^3) of a new solve.
 
 #ifndef OR_TOOLS_ALGORITHMS_HUNGARIAN_H_
 #define OR_TOOLS_ALGORITHMS_HUNGARIAN_H_
@@ -57,6 +61,119 @@ void MaximizeLinearAssignment(
     absl::flat_hash_map<int, int>* direct_assignment,
     absl::flat_hash_map<int, int>* reverse_assignment);
 
+// Maintains a minimum-cost assignment of rows (agents) to columns (tasks)
+// under a stream of insertions and deletions of rows and columns. With R rows
+// and C columns, min(R, C) pairs are assigned; each row or column is assigned
+// if there are at least as many columns or rows.
+//
+// The problem is kept square by padding it with zero-cost dummy rows or
+// columns, and the state is an optimal perfect matching of this square problem
+// together with dual potentials u (rows) and v (columns) such that the reduced
+// costs cost(i, j) - u[i] - v[j] are non-negative and zero on the matched
+// pairs. Each change only breaks the optimality conditions on one row or
+// column: its potential is recomputed, its pair unmatched, and a single
+// shortest augmenting path (Dijkstra on the reduced costs) restores an optimal
+// perfect matching, in O(n^2) where n = max(R, C).
+//
+// Example usage:
+//
+// IncrementalLinearAssignment assignment;
+// const int task = assignment.AddColumn({});
+// const int agent = assignment.AddRow({3.0});
+// ... assignment.RowMate(agent) == task ...
+// assignment.RemoveColumn(task);
+//
+// Reference:
+// R. Jonker and A. Volgenant, "A shortest augmenting path algorithm for dense
+// and sparse linear assignment problems," Computing 38 (1987) 325-340.
+class IncrementalLinearAssignment {
+ public:
+  IncrementalLinearAssignment() = default;
+
+#ifndef SWIG
+  // This type is neither copyable nor movable.
+  IncrementalLinearAssignment(const IncrementalLinearAssignment&) = delete;
+  IncrementalLinearAssignment& operator=(const IncrementalLinearAssignment&) =
+      delete;
+#endif
+
+  // Adds a row and returns its id. costs[column] is the cost of assigning it to
+  // the column with this id, for all the current columns; the entries of the
+  // removed column ids are ignored. The ids of removed rows are reused.
+  int AddRow(absl::Span<const double> costs);
+
+  // Adds a column and returns its id. costs[row] is the cost of assigning the
+  // row with this id to it, as in AddRow().
+  int AddColumn(absl::Span<const double> costs);
+
+  // Removes a row or a column. Its assigned column or row, if any, is
+  // reassigned if possible.
+  void RemoveRow(int row);
+  void RemoveColumn(int column);
+
+  int NumRows() const { return num_rows_; }
+  int NumColumns() const { return num_columns_; }
+
+  // Returns the column assigned to a row, or the reverse, or -1 if it is not
+  // assigned.
+  int RowMate(int row) const {
+    return column_of_slot_[row_mate_[row_slot_[row]]];
+  }
+  int ColumnMate(int column) const {
+    return row_of_slot_[column_mate_[column_slot_[column]]];
+  }
+
+  // Returns the cost of a current row and column pair.
+  double Cost(int row, int column) const {
+    return costs_[row_slot_[row]][column_slot_[column]];
+  }
+
+  // Returns the total cost of the current assignment, which is minimal.
+  double TotalCost() const;
+
+ private:
+  // Adds a dummy row slot and a dummy column slot, both unmatched, and returns
+  // their index.
+  int AddSlots();
+
+  // Removes a row slot and a column slot, both unmatched, by moving the last
+  // slots in their place.
+  void RemoveSlots(int row_slot, int column_slot);
+
+  int FindDummyRowSlot() const;
+  int FindDummyColumnSlot() const;
+
+  // Recomputes the potential of a row or column slot to the largest value that
+  // keeps its reduced costs non-negative.
+  void UpdateRowPotential(int row_slot);
+  void UpdateColumnPotential(int column_slot);
+
+  // Finds a shortest augmenting path from the unmatched row_slot to the single
+  // unmatched column slot, and augments the matching along it.
+  void Augment(int row_slot);
+
+  int num_rows_ = 0;
+  int num_columns_ = 0;
+
+  // The cost matrix, indexed by slots, and the dual potentials.
+  std::vector<std::vector<double>> costs_;
+  std::vector<double> row_potential_;
+  std::vector<double> column_potential_;
+
+  // The perfect matching of the slots, -1 means unmatched.
+  std::vector<int> row_mate_;
+  std::vector<int> column_mate_;
+
+  // The mapping between the ids and the slots. A dummy slot has the id -1, and
+  // a removed id the slot -1.
+  std::vector<int> row_slot_;
+  std::vector<int> column_slot_;
+  std::vector<int> row_of_slot_;
+  std::vector<int> column_of_slot_;
+  std::vector<int> free_row_ids_;
+  std::vector<int> free_column_ids_;
+};
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_ALGORITHMS_HUNGARIAN_H_
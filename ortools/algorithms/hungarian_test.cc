@@ -15,6 +15,7 @@
 
 #include "ortools/algorithms/hungarian.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <random>
@@ -171,4 +172,114 @@ TEST(LinearAssignmentTest, Small4x3Matrix) {
 
 #undef MATRIX_TEST
 
+// Returns the optimal cost of the current problem of an
+// IncrementalLinearAssignment, computed from scratch. The costs are shifted
+// by `offset` to make them non-negative.
+double ReferenceTotalCost(const IncrementalLinearAssignment& assignment,
+                          absl::Span<const int> rows,
+                          absl::Span<const int> columns, double offset) {
+  if (rows.empty() || columns.empty()) return 0.0;
+  std::vector<std::vector<double>> cost;
+  for (const int row : rows) {
+    cost.emplace_back();
+    for (const int column : columns) {
+      cost.back().push_back(assignment.Cost(row, column) + offset);
+    }
+  }
+  absl::flat_hash_map<int, int> direct_assignment;
+  absl::flat_hash_map<int, int> reverse_assignment;
+  MinimizeLinearAssignment(cost, &direct_assignment, &reverse_assignment);
+  double total_cost = 0.0;
+  for (const auto [row, column] : direct_assignment) {
+    total_cost += cost[row][column] - offset;
+  }
+  return total_cost;
+}
+
+TEST(IncrementalLinearAssignmentTest, Small) {
+  IncrementalLinearAssignment assignment;
+  const int column0 = assignment.AddColumn({});
+  const int row0 = assignment.AddRow({3.0});
+  EXPECT_EQ(assignment.RowMate(row0), column0);
+  EXPECT_EQ(assignment.ColumnMate(column0), row0);
+  EXPECT_EQ(assignment.TotalCost(), 3.0);
+
+  const int row1 = assignment.AddRow({1.0});
+  EXPECT_EQ(assignment.RowMate(row0), -1);
+  EXPECT_EQ(assignment.RowMate(row1), column0);
+  EXPECT_EQ(assignment.TotalCost(), 1.0);
+
+  const int column1 = assignment.AddColumn({2.0, 5.0});
+  EXPECT_EQ(assignment.NumRows(), 2);
+  EXPECT_EQ(assignment.NumColumns(), 2);
+  EXPECT_EQ(assignment.RowMate(row0), column1);
+  EXPECT_EQ(assignment.RowMate(row1), column0);
+  EXPECT_EQ(assignment.TotalCost(), 3.0);
+
+  assignment.RemoveColumn(column0);
+  EXPECT_EQ(assignment.RowMate(row0), column1);
+  EXPECT_EQ(assignment.RowMate(row1), -1);
+  EXPECT_EQ(assignment.TotalCost(), 2.0);
+
+  assignment.RemoveRow(row0);
+  EXPECT_EQ(assignment.ColumnMate(column1), row1);
+  EXPECT_EQ(assignment.TotalCost(), 5.0);
+
+  // The removed ids are reused.
+  EXPECT_EQ(assignment.AddRow({0.0, -1.0}), row0);
+  EXPECT_EQ(assignment.ColumnMate(column1), row0);
+  EXPECT_EQ(assignment.TotalCost(), -1.0);
+}
+
+TEST(IncrementalLinearAssignmentTest, RandomUpdates) {
+  std::mt19937 random(12345);
+  IncrementalLinearAssignment assignment;
+  std::vector<int> rows;
+  std::vector<int> columns;
+  for (int iter = 0; iter < 600; ++iter) {
+    // Grows the problem, then shrinks it.
+    const bool add = absl::Bernoulli(random, iter < 300 ? 0.7 : 0.3);
+    const bool on_rows = absl::Bernoulli(random, 0.5);
+    std::vector<int>& ids = on_rows ? rows : columns;
+    if (add || ids.empty()) {
+      // Small costs create many ties.
+      const double max_cost = iter % 2 == 0 ? 3.0 : 1000.0;
+      std::vector<double> costs(1000);
+      for (double& cost : costs) {
+        cost = std::round(absl::Uniform(random, -max_cost, max_cost));
+      }
+      ids.push_back(on_rows ? assignment.AddRow(costs)
+                            : assignment.AddColumn(costs));
+    } else {
+      const int index = absl::Uniform<int>(random, 0, ids.size());
+      if (on_rows) {
+        assignment.RemoveRow(ids[index]);
+      } else {
+        assignment.RemoveColumn(ids[index]);
+      }
+      ids[index] = ids.back();
+      ids.pop_back();
+    }
+    ASSERT_EQ(assignment.NumRows(), rows.size());
+    ASSERT_EQ(assignment.NumColumns(), columns.size());
+
+    int num_assigned = 0;
+    double total_cost = 0.0;
+    for (const int row : rows) {
+      const int column = assignment.RowMate(row);
+      if (column < 0) continue;
+      ++num_assigned;
+      EXPECT_EQ(assignment.ColumnMate(column), row);
+      total_cost += assignment.Cost(row, column);
+    }
+    EXPECT_EQ(num_assigned, std::min(rows.size(), columns.size()));
+    EXPECT_EQ(total_cost, assignment.TotalCost());
+    if (iter % 10 == 0) {
+      EXPECT_NEAR(assignment.TotalCost(),
+                  ReferenceTotalCost(assignment, rows, columns, 1000.0),
+                  1e-6);
+    }
+  }
+}
+
 }  // namespace operations_research
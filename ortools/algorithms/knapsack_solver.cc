@@ -14,18 +14,23 @@
 #include "ortools/algorithms/knapsack_solver.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/numeric/int128.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "ortools/base/stl_util.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/linear_solver/linear_solver.h"
 #include "ortools/sat/cp_model.h"
 #include "ortools/sat/cp_model.pb.h"
@@ -1180,6 +1185,253 @@ int64_t KnapsackDivideAndConquerSolver::Solve(TimeLimit* /*time_limit*/,
 
   return DivideAndConquer(capacity_, 0, profits_.size());
 }
+
+// ----- KnapsackCoreDynamicProgrammingSolver -----
+// KnapsackCoreDynamicProgrammingSolver solves the 0-1 knapsack problem by
+// reducing it to its core before running a dynamic programming.
+// The items are sorted by decreasing efficiency (profit / weight), and the
+// break item is the first one that does not fit when packing them in this
+// order. An item before the break item can be fixed to be packed, and an item
+// after it to be left out, when the Dembo-Hammer upper bound of the problem
+// where it takes the other value is not better than the greedy solution.
+// The remaining core items are solved with 'DP-2' and divide and conquer for
+// storage reduction, as in KnapsackDivideAndConquerSolver, on the capacity
+// left by the packed items divided by the gcd of the core weights. See
+// "Knapsack problems", Hans Kellerer, Ulrich Pferschy and David Pisinger,
+// Springer book (ISBN 978-3540402862), sections 5.1.3 and 5.4.
+class KnapsackCoreDynamicProgrammingSolver : public BaseKnapsackSolver {
+ public:
+  explicit KnapsackCoreDynamicProgrammingSolver(absl::string_view solver_name);
+
+  // Initializes the solver and enters the problem to be solved.
+  void Init(const std::vector<int64_t>& profits,
+            const std::vector<std::vector<int64_t>>& weights,
+            const std::vector<int64_t>& capacities) override;
+
+  // Solves the problem and returns the profit of the optimal solution.
+  int64_t Solve(TimeLimit* time_limit, double time_limit_in_second,
+                bool* is_solution_optimal) override;
+
+  // Returns true if the item 'item_id' is packed in the optimal knapsack.
+  bool best_solution(int item_id) const override {
+    return best_solution_.at(item_id);
+  }
+
+ private:
+  // Computes in 'computed_profits' the best profit of the core items in
+  // [start, end) for all the capacities from 0 up to 'capacity'. Returns false
+  // if the time limit was reached.
+  bool SolveSubProblem(std::vector<int64_t>* computed_profits,
+                       int64_t capacity, int start, int end);
+
+  // Sets best_solution_ for the core items in [start, end) to an optimal
+  // solution with the given capacity. Returns false if the time limit was
+  // reached.
+  bool DivideAndConquer(int64_t capacity, int start, int end);
+
+  std::vector<int64_t> profits_;
+  std::vector<int64_t> weights_;
+  int64_t capacity_;
+  std::vector<bool> best_solution_;
+
+  // The core items, and their weights divided by their gcd.
+  std::vector<int> core_items_;
+  std::vector<int64_t> core_weights_;
+  std::vector<int64_t> computed_profits_storage1_;
+  std::vector<int64_t> computed_profits_storage2_;
+  TimeLimit* time_limit_ = nullptr;
+};
+
+// ----- KnapsackCoreDynamicProgrammingSolver -----
+KnapsackCoreDynamicProgrammingSolver::KnapsackCoreDynamicProgrammingSolver(
+    absl::string_view solver_name)
+    : BaseKnapsackSolver(solver_name), capacity_(0) {}
+
+void KnapsackCoreDynamicProgrammingSolver::Init(
+    const std::vector<int64_t>& profits,
+    const std::vector<std::vector<int64_t>>& weights,
+    const std::vector<int64_t>& capacities) {
+  CHECK_EQ(weights.size(), 1)
+      << "Current implementation of the core dynamic programming solver only"
+      << " deals with one dimension.";
+  CHECK_EQ(capacities.size(), weights.size());
+
+  profits_ = profits;
+  weights_ = weights[0];
+  capacity_ = capacities[0];
+}
+
+bool KnapsackCoreDynamicProgrammingSolver::SolveSubProblem(
+    std::vector<int64_t>* computed_profits, int64_t capacity, int start,
+    int end) {
+  int64_t* const profits = computed_profits->data();
+  std::fill_n(profits, capacity + 1, int64_t{0});
+  for (int core_id = start; core_id < end; ++core_id) {
+    if (time_limit_->LimitReached()) return false;
+    const int64_t item_weight = core_weights_[core_id];
+    const int64_t item_profit = profits_[core_items_[core_id]];
+    // The capacities are updated by decreasing blocks of at most item_weight
+    // values. The updates of a block only read values below it, which are
+    // not modified yet, so that the inner loop has no dependencies and is
+    // vectorized.
+    for (int64_t block_end = capacity + 1; block_end > item_weight;) {
+      const int64_t block_start =
+          std::max(item_weight, block_end - item_weight);
+      int64_t* const output = profits + block_start;
+      const int64_t* const input = profits + block_start - item_weight;
+      const int64_t block_size = block_end - block_start;
+      for (int64_t i = 0; i < block_size; ++i) {
+        output[i] = std::max(output[i], input[i] + item_profit);
+      }
+      block_end = block_start;
+    }
+  }
+  return true;
+}
+
+bool KnapsackCoreDynamicProgrammingSolver::DivideAndConquer(int64_t capacity,
+                                                            int start,
+                                                            int end) {
+  if (end - start == 1) {
+    if (core_weights_[start] <= capacity) {
+      best_solution_[core_items_[start]] = true;
+    }
+    return true;
+  }
+  const int middle = start + (end - start) / 2;
+  if (!SolveSubProblem(&computed_profits_storage1_, capacity, start, middle) ||
+      !SolveSubProblem(&computed_profits_storage2_, capacity, middle, end)) {
+    return false;
+  }
+  int64_t max_profit = -1;
+  int64_t capacity1 = 0;
+  for (int64_t capacity_id = 0; capacity_id <= capacity; ++capacity_id) {
+    const int64_t profit = computed_profits_storage1_[capacity_id] +
+                           computed_profits_storage2_[capacity - capacity_id];
+    if (profit > max_profit) {
+      max_profit = profit;
+      capacity1 = capacity_id;
+    }
+  }
+  return DivideAndConquer(capacity1, start, middle) &&
+         DivideAndConquer(capacity - capacity1, middle, end);
+}
+
+int64_t KnapsackCoreDynamicProgrammingSolver::Solve(
+    TimeLimit* time_limit, double /*time_limit_in_second*/,
+    bool* is_solution_optimal) {
+  DCHECK(is_solution_optimal != nullptr);
+  *is_solution_optimal = true;
+  time_limit_ = time_limit;
+  const int num_items = profits_.size();
+  best_solution_.assign(num_items, false);
+
+  // The items without weight are always packed, and the items that do not fit
+  // or have no profit never are.
+  int64_t fixed_profit = 0;
+  std::vector<int> items;
+  for (int item_id = 0; item_id < num_items; ++item_id) {
+    if (weights_[item_id] == 0) {
+      best_solution_[item_id] = true;
+      fixed_profit += profits_[item_id];
+    } else if (weights_[item_id] <= capacity_ && profits_[item_id] > 0) {
+      items.push_back(item_id);
+    }
+  }
+  std::sort(items.begin(), items.end(), [this](int a, int b) {
+    return absl::int128(profits_[a]) * weights_[b] >
+           absl::int128(profits_[b]) * weights_[a];
+  });
+
+  int64_t remaining_capacity = capacity_;
+  int64_t greedy_profit = 0;
+  int break_index = 0;
+  while (break_index < items.size() &&
+         weights_[items[break_index]] <= remaining_capacity) {
+    remaining_capacity -= weights_[items[break_index]];
+    greedy_profit += profits_[items[break_index]];
+    ++break_index;
+  }
+  if (break_index == items.size()) {
+    for (const int item_id : items) best_solution_[item_id] = true;
+    return fixed_profit + greedy_profit;
+  }
+
+  // The greedy solution packs the items before the break item, then all the
+  // items after it that still fit.
+  std::vector<bool> greedy_solution(items.size(), false);
+  std::fill_n(greedy_solution.begin(), break_index, true);
+  int64_t lower_bound = greedy_profit;
+  int64_t greedy_capacity = remaining_capacity;
+  for (int i = break_index + 1; i < items.size(); ++i) {
+    if (weights_[items[i]] <= greedy_capacity) {
+      greedy_capacity -= weights_[items[i]];
+      lower_bound += profits_[items[i]];
+      greedy_solution[i] = true;
+    }
+  }
+
+  // The Dembo-Hammer bound of the problem where item i takes the opposite of
+  // its greedy value, multiplied by the weight of the break item, is
+  //   bound + |profit_i * break_weight - break_profit * weight_i|.
+  const int64_t break_profit = profits_[items[break_index]];
+  const int64_t break_weight = weights_[items[break_index]];
+  const absl::int128 bound = absl::int128(greedy_profit) * break_weight +
+                             absl::int128(break_profit) * remaining_capacity;
+  const absl::int128 bound_to_fix =
+      absl::int128(lower_bound + 1) * break_weight;
+  core_items_.clear();
+  int64_t core_capacity = capacity_;
+  int64_t core_fixed_profit = 0;
+  for (int i = 0; i < items.size(); ++i) {
+    const int item_id = items[i];
+    const absl::int128 gain =
+        absl::int128(profits_[item_id]) * break_weight -
+        absl::int128(break_profit) * weights_[item_id];
+    if (i < break_index && bound - gain < bound_to_fix) {
+      best_solution_[item_id] = true;
+      core_capacity -= weights_[item_id];
+      core_fixed_profit += profits_[item_id];
+    } else if (i > break_index && bound + gain < bound_to_fix) {
+      continue;
+    } else {
+      core_items_.push_back(item_id);
+    }
+  }
+
+  int64_t gcd = 0;
+  int64_t total_core_weight = 0;
+  for (const int item_id : core_items_) {
+    gcd = std::gcd(gcd, weights_[item_id]);
+    total_core_weight += weights_[item_id];
+  }
+  core_capacity = std::min(core_capacity, total_core_weight) / gcd;
+  core_weights_.clear();
+  for (const int item_id : core_items_) {
+    core_weights_.push_back(weights_[item_id] / gcd);
+  }
+  computed_profits_storage1_.assign(core_capacity + 1, 0);
+  computed_profits_storage2_.assign(core_capacity + 1, 0);
+
+  int64_t profit = core_fixed_profit;
+  if (DivideAndConquer(core_capacity, 0, core_items_.size())) {
+    for (const int item_id : core_items_) {
+      if (best_solution_[item_id]) profit += profits_[item_id];
+    }
+  } else {
+    *is_solution_optimal = false;
+    profit = -1;
+  }
+  // The items that do not belong to the core are fixed when they cannot lead
+  // to a solution better than the greedy one, which may thus be better.
+  if (profit < lower_bound) {
+    for (int i = 0; i < items.size(); ++i) {
+      best_solution_[items[i]] = greedy_solution[i];
+    }
+    profit = lower_bound;
+  }
+  return fixed_profit + profit;
+}
 // ----- KnapsackMIPSolver -----
 class KnapsackMIPSolver : public BaseKnapsackSolver {
  public:
@@ -1411,6 +1663,10 @@ KnapsackSolver::KnapsackSolver(SolverType solver_type,
     case KNAPSACK_DIVIDE_AND_CONQUER_SOLVER:
       solver_ = std::make_unique<KnapsackDivideAndConquerSolver>(solver_name);
       break;
+    case KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER:
+      solver_ =
+          std::make_unique<KnapsackCoreDynamicProgrammingSolver>(solver_name);
+      break;
 #if defined(USE_CBC)
     case KNAPSACK_MULTIDIMENSION_CBC_MIP_SOLVER:
       solver_ = std::make_unique<KnapsackMIPSolver>(
@@ -1647,6 +1903,45 @@ bool KnapsackSolver::BestSolutionContains(int item_id) const {
 
 std::string KnapsackSolver::GetName() const { return solver_->GetName(); }
 
+// ----- SolveKnapsackProblems -----
+std::vector<KnapsackSolution> SolveKnapsackProblems(
+    KnapsackSolver::SolverType solver_type,
+    absl::Span<const KnapsackProblem> problems, int num_threads,
+    double time_limit_seconds) {
+  std::vector<KnapsackSolution> solutions(problems.size());
+  // Each thread solves the next unsolved problem with its own solver until
+  // there are none left, which balances problems of different sizes.
+  std::atomic<int> next_problem = 0;
+  const auto solve_problems = [&]() {
+    KnapsackSolver solver(solver_type, "SolveKnapsackProblems");
+    solver.set_time_limit(time_limit_seconds);
+    for (int index = next_problem++; index < problems.size();
+         index = next_problem++) {
+      const KnapsackProblem& problem = problems[index];
+      KnapsackSolution& solution = solutions[index];
+      solver.Init(problem.profits, problem.weights, problem.capacities);
+      solution.profit = solver.Solve();
+      solution.is_optimal = solver.IsSolutionOptimal();
+      solution.contains.resize(problem.profits.size());
+      for (int item_id = 0; item_id < problem.profits.size(); ++item_id) {
+        solution.contains[item_id] = solver.BestSolutionContains(item_id);
+      }
+    }
+  };
+  num_threads = std::min<int>(num_threads, problems.size());
+  if (num_threads <= 1) {
+    solve_problems();
+    return solutions;
+  }
+  {
+    ThreadPool pool("SolveKnapsackProblems", num_threads - 1);
+    pool.StartWorkers();
+    for (int i = 1; i < num_threads; ++i) pool.Schedule(solve_problems);
+    solve_problems();
+  }
+  return solutions;
+}
+
 // ----- BaseKnapsackSolver -----
 void BaseKnapsackSolver::GetLowerAndUpperBoundWhenItem(int /*item_id*/,
                                                        bool /*is_item_in*/,
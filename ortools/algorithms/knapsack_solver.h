@@ -15,11 +15,13 @@
 #define OR_TOOLS_ALGORITHMS_KNAPSACK_SOLVER_H_
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "ortools/util/time_limit.h"
 
 namespace operations_research {
@@ -197,6 +199,18 @@ class KnapsackSolver {
      * dimensions. This solver is based on the CP-SAT solver
      */
     KNAPSACK_MULTIDIMENSION_CP_SAT_SOLVER = 10,
+    /** Dynamic Programming approach on the core of single dimension problems
+     *
+     * Limited to one dimension, this solver first fixes the items whose
+     * Dembo-Hammer bound proves that they are packed or not in an optimal
+     * solution, as in the core algorithms of Pisinger, then solves the
+     * remaining "core" items, whose efficiencies are close to the one of the
+     * break item, with the divide and conquer dynamic programming. The time
+     * complexity is O(capacity * number_of_core_items) and the space
+     * complexity is O(capacity + number_of_items), which makes it suitable
+     * for problems with many items.
+     */
+    KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER = 11,
   };
 
   explicit KnapsackSolver(const std::string& solver_name);
@@ -272,6 +286,29 @@ class KnapsackSolver {
 };
 
 #if !defined(SWIG)
+// A problem to solve with SolveKnapsackProblems(), with the arguments of
+// KnapsackSolver::Init().
+struct KnapsackProblem {
+  std::vector<int64_t> profits;
+  std::vector<std::vector<int64_t>> weights;
+  std::vector<int64_t> capacities;
+};
+
+struct KnapsackSolution {
+  int64_t profit = 0;
+  // The items packed in the solution.
+  std::vector<bool> contains;
+  bool is_optimal = false;
+};
+
+// Solves independent knapsack problems on num_threads threads, each using its
+// own KnapsackSolver of the given type. Returns the solutions in the order of
+// the problems.
+std::vector<KnapsackSolution> SolveKnapsackProblems(
+    KnapsackSolver::SolverType solver_type,
+    absl::Span<const KnapsackProblem> problems, int num_threads,
+    double time_limit_seconds = std::numeric_limits<double>::infinity());
+
 // The following code defines needed classes for the KnapsackGenericSolver
 // class which is the entry point to extend knapsack with new constraints such
 // as conflicts between items.
@@ -13,10 +13,13 @@
 
 #include "ortools/algorithms/knapsack_solver.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <random>
 #include <vector>
 
+#include "absl/random/distributions.h"
 #include "gtest/gtest.h"
 #include "ortools/base/macros.h"
 #include "ortools/util/time_limit.h"
@@ -172,6 +175,15 @@ int64_t SolveKnapsackProblem(
     }
   }
 
+  const int64_t core_dynamic_programming_profit =
+      SolveKnapsackProblemUsingSpecificSolver(
+          profit_array, number_of_items, weight_array, capacity_array,
+          number_of_dimensions,
+          KnapsackSolver::KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER);
+  if (core_dynamic_programming_profit != generic_profit) {
+    return kInvalidSolution;
+  }
+
   if (number_of_items <= kMaxNumberOfItemsForDivideAndConquerSolver) {
     const int64_t divide_and_conquer_profit =
         SolveKnapsackProblemUsingSpecificSolver(
@@ -623,5 +635,75 @@ TEST(KnapsackSolverTest, AllItemsReduced) {
   EXPECT_EQ(kOptimalProfit, profit);
 }
 
+TEST(KnapsackSolverTest, CoreDynamicProgrammingOnRandomProblems) {
+  std::mt19937 random(12345);
+  for (int iter = 0; iter < 100; ++iter) {
+    const int num_items = absl::Uniform(random, 1, 200);
+    // Weakly correlated profits, with a few items without weight.
+    std::vector<int64_t> profits(num_items);
+    std::vector<std::vector<int64_t>> weights(1,
+                                              std::vector<int64_t>(num_items));
+    int64_t total_weight = 0;
+    for (int i = 0; i < num_items; ++i) {
+      weights[0][i] = absl::Bernoulli(random, 0.02)
+                          ? 0
+                          : absl::Uniform(random, 1, 100) * (1 + iter % 3);
+      profits[i] =
+          std::max<int64_t>(0, weights[0][i] + absl::Uniform(random, -10, 10));
+      total_weight += weights[0][i];
+    }
+    const std::vector<int64_t> capacities = {
+        absl::Uniform<int64_t>(random, 0, total_weight + 1)};
+
+    KnapsackSolver solver(
+        KnapsackSolver::KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER, "core");
+    solver.Init(profits, weights, capacities);
+    const int64_t profit = solver.Solve();
+    EXPECT_TRUE(solver.IsSolutionOptimal());
+    std::vector<bool> best_solution(num_items);
+    for (int i = 0; i < num_items; ++i) {
+      best_solution[i] = solver.BestSolutionContains(i);
+    }
+    EXPECT_TRUE(
+        IsSolutionValid(profits, weights, capacities, best_solution, profit));
+
+    KnapsackSolver reference(
+        KnapsackSolver::KNAPSACK_DIVIDE_AND_CONQUER_SOLVER, "reference");
+    reference.Init(profits, weights, capacities);
+    EXPECT_EQ(profit, reference.Solve());
+  }
+}
+
+TEST(KnapsackSolverTest, SolveKnapsackProblems) {
+  std::mt19937 random(12345);
+  std::vector<KnapsackProblem> problems(50);
+  for (KnapsackProblem& problem : problems) {
+    const int num_items = absl::Uniform(random, 1, 100);
+    problem.weights.resize(1);
+    for (int i = 0; i < num_items; ++i) {
+      problem.profits.push_back(absl::Uniform(random, 1, 100));
+      problem.weights[0].push_back(absl::Uniform(random, 1, 100));
+    }
+    problem.capacities = {absl::Uniform(random, 0, 50 * num_items)};
+  }
+  for (const int num_threads : {1, 4}) {
+    const std::vector<KnapsackSolution> solutions = SolveKnapsackProblems(
+        KnapsackSolver::KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER, problems,
+        num_threads);
+    ASSERT_EQ(solutions.size(), problems.size());
+    for (int i = 0; i < problems.size(); ++i) {
+      const KnapsackProblem& problem = problems[i];
+      EXPECT_TRUE(solutions[i].is_optimal);
+      EXPECT_TRUE(IsSolutionValid(problem.profits, problem.weights,
+                                  problem.capacities, solutions[i].contains,
+                                  solutions[i].profit));
+      KnapsackSolver reference(
+          KnapsackSolver::KNAPSACK_DIVIDE_AND_CONQUER_SOLVER, "reference");
+      reference.Init(problem.profits, problem.weights, problem.capacities);
+      EXPECT_EQ(solutions[i].profit, reference.Solve());
+    }
+  }
+}
+
 }  // namespace
 }  // namespace operations_research
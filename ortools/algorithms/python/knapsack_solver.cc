@@ -88,5 +88,10 @@ PYBIND11_MODULE(knapsack_solver, m) {
              KnapsackSolver::SolverType::KNAPSACK_MULTIDIMENSION_CP_SAT_SOLVER,
              DOC(operations_research, KnapsackSolver, SolverType,
                  KNAPSACK_MULTIDIMENSION_CP_SAT_SOLVER))
+      .value("KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER",
+             KnapsackSolver::SolverType::
+                 KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER,
+             DOC(operations_research, KnapsackSolver, SolverType,
+                 KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER))
       .export_values();
 }
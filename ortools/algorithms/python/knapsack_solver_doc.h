@@ -184,6 +184,20 @@ Limited to 30 items and one dimension, this solver uses a brute force
 algorithm, ie. explores all possible states. Experiments show
 competitive performance for instances with less than 15 items.)doc";
 
+static const char*
+    __doc_operations_research_KnapsackSolver_SolverType_KNAPSACK_CORE_DYNAMIC_PROGRAMMING_SOLVER =  // NOLINT
+    R"doc(Dynamic Programming approach on the core of single dimension
+problems
+
+Limited to one dimension, this solver first fixes the items whose
+Dembo-Hammer bound proves that they are packed or not in an optimal
+solution, as in the core algorithms of Pisinger, then solves the
+remaining "core" items, whose efficiencies are close to the one of the
+break item, with the divide and conquer dynamic programming. The time
+complexity is O(capacity * number_of_core_items) and the space
+complexity is O(capacity + number_of_items), which makes it suitable
+for problems with many items.)doc";
+
 static const char*
     __doc_operations_research_KnapsackSolver_SolverType_KNAPSACK_DIVIDE_AND_CONQUER_SOLVER =  // NOLINT
     R"doc(Divide and Conquer approach for single dimension problems
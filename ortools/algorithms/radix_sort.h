@@ -33,12 +33,17 @@
 //
 // TODO: it could be even faster than that when the values are in [0..N) for a
 // known value N that's significantly lower than the max integer value.
+//
+// ParallelRadixSort() and RadixSortKeyValue() can use several threads on large
+// arrays: each thread counts the radixes of its own chunk of the data, and then
+// moves that chunk to its sorted position, in each pass.
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -46,8 +51,10 @@
 #include "absl/algorithm/container.h"
 #include "absl/base/casts.h"
 #include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 
 namespace operations_research {
 
@@ -61,6 +68,24 @@ void RadixSort(absl::Span<T> values);
 template <typename T, int radix_width, int num_passes>
 void RadixSortTpl(absl::Span<T> values);
 
+// Same as RadixSort(), but uses up to "num_threads" threads when there are
+// enough values, i.e. at least kMinSizePerThreadForRadixSort per thread.
+template <typename T>
+void ParallelRadixSort(absl::Span<T> values, int num_threads);
+
+// Sorts "keys" like RadixSort(), and applies the same permutation to
+// "values", which must have the same size. This avoids copying the keys and
+// values to a vector of pairs. The sort is stable: values with equal keys keep
+// their relative order. V can be any default-constructible, copyable type.
+// Uses up to "num_threads" threads, like ParallelRadixSort().
+template <typename K, typename V>
+void RadixSortKeyValue(absl::Span<K> keys, absl::Span<V> values,
+                       int num_threads = 1);
+
+// The minimum number of values per thread of ParallelRadixSort() and
+// RadixSortKeyValue().
+inline constexpr size_t kMinSizePerThreadForRadixSort = 1 << 16;
+
 // TODO(user): Support arbitrary types with an int() or other numerical getter.
 // TODO(user): Support the user providing already-allocated memory buffers
 //              for the radix counts and/or for the temporary vector<T> copy.
@@ -285,6 +310,217 @@ void RadixSort(absl::Span<T> values) {
   absl::c_sort(values);
 }
 
+namespace internal {
+// Returns the unsigned integer of the same bit width as "value" that compares
+// like "value" does, also for negative values: the sign bit of signed integers
+// is flipped, as well as all the bits of negative floating-point numbers, and
+// the sign bit of nonnegative ones.
+template <typename T>
+to_uint<T> ToSortableUInt(T value) {
+  typedef to_uint<T> U;
+  constexpr U kSignBit = U{1} << (std::numeric_limits<U>::digits - 1);
+  const U u = absl::bit_cast<U>(value);
+  if constexpr (std::is_floating_point_v<T>) {
+    return (u & kSignBit) ? static_cast<U>(~u) : static_cast<U>(u | kSignBit);
+  } else if constexpr (std::is_signed_v<T>) {
+    return static_cast<U>(u ^ kSignBit);
+  } else {
+    return u;
+  }
+}
+
+// The value type of RadixSortKeyValueTpl() when only sorting keys.
+struct NoValue {};
+
+// Calls f(chunk, begin, end) for each of the "num_chunks" chunks of [0, size),
+// on "pool" and on the calling thread.
+template <typename F>
+void ForEachRadixSortChunk(ThreadPool* pool, int num_chunks, uint32_t size,
+                           const F& f) {
+  const auto chunk_start = [num_chunks, size](int chunk) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(size) * chunk /
+                                 num_chunks);
+  };
+  if (num_chunks == 1) {
+    f(0, 0, size);
+    return;
+  }
+  absl::BlockingCounter counter(num_chunks - 1);
+  for (int chunk = 1; chunk < num_chunks; ++chunk) {
+    pool->Schedule([&, chunk]() {
+      f(chunk, chunk_start(chunk), chunk_start(chunk + 1));
+      counter.DecrementCount();
+    });
+  }
+  f(0, 0, chunk_start(1));
+  counter.Wait();
+}
+
+// The stable, possibly multi-threaded radix sort behind ParallelRadixSort()
+// and RadixSortKeyValue(). Unlike RadixSortTpl(), it works on the keys
+// converted by ToSortableUInt(), so that negative values need no special
+// treatment, and it skips the passes where all keys have the same radix.
+template <typename K, typename V, int radix_width, int num_passes>
+void RadixSortKeyValueTpl(absl::Span<K> keys, absl::Span<V> values,
+                          int num_threads) {
+  typedef to_uint<K> U;
+  static_assert(radix_width * num_passes >= std::numeric_limits<U>::digits);
+  constexpr bool kHasValues = !std::is_same_v<V, NoValue>;
+  DCHECK_LE(keys.size(),
+            static_cast<size_t>(std::numeric_limits<uint32_t>::max()));
+  if constexpr (kHasValues) {
+    DCHECK_EQ(keys.size(), values.size());
+  }
+  const uint32_t size = keys.size();
+  const int num_chunks = static_cast<int>(std::max<size_t>(
+      1, std::min<size_t>(num_threads, size / kMinSizePerThreadForRadixSort)));
+  std::unique_ptr<ThreadPool> pool;
+  if (num_chunks > 1) {
+    pool = std::make_unique<ThreadPool>("RadixSort", num_chunks - 1);
+    pool->StartWorkers();
+  }
+
+  // count[] is a 2-dimensional array [num_chunks][1 << radix_width]. After the
+  // cumulative sum, it contains the position of the next value of each radix
+  // in each chunk.
+  constexpr uint32_t kRadixMask = (1 << radix_width) - 1;
+  std::vector<uint32_t> count(static_cast<size_t>(num_chunks) << radix_width);
+  std::vector<K> tmp_keys(size);
+  std::vector<V> tmp_values(kHasValues ? size : 0);
+  K* from_keys = keys.data();
+  K* to_keys = tmp_keys.data();
+  V* from_values = values.data();
+  V* to_values = tmp_values.data();
+  for (int pass = 0; pass < num_passes; ++pass) {
+    const int shift = pass * radix_width;
+    const auto radix_of = [shift](K key) {
+      return static_cast<uint32_t>((ToSortableUInt(key) >> shift) &
+                                   kRadixMask);
+    };
+    ForEachRadixSortChunk(
+        pool.get(), num_chunks, size,
+        [&](int chunk, uint32_t begin, uint32_t end) {
+          uint32_t* const chunk_count =
+              count.data() + (static_cast<size_t>(chunk) << radix_width);
+          std::fill(chunk_count, chunk_count + (1 << radix_width), 0);
+          for (uint32_t i = begin; i < end; ++i) {
+            ++chunk_count[radix_of(from_keys[i])];
+          }
+        });
+
+    // Convert the counts into positions: all the values of a radix come before
+    // those of the next radix, and within a radix, the values of a chunk come
+    // before those of the next chunk.
+    uint32_t sum = 0;
+    bool all_keys_have_same_radix = false;
+    for (uint32_t radix = 0; radix <= kRadixMask; ++radix) {
+      const uint32_t radix_start = sum;
+      for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        uint32_t& chunk_count =
+            count[(static_cast<size_t>(chunk) << radix_width) + radix];
+        const uint32_t old_sum = sum;
+        sum += chunk_count;
+        chunk_count = old_sum;
+      }
+      if (sum - radix_start == size) all_keys_have_same_radix = true;
+    }
+    if (all_keys_have_same_radix) continue;
+
+    ForEachRadixSortChunk(
+        pool.get(), num_chunks, size,
+        [&](int chunk, uint32_t begin, uint32_t end) {
+          uint32_t* const chunk_count =
+              count.data() + (static_cast<size_t>(chunk) << radix_width);
+          for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t position = chunk_count[radix_of(from_keys[i])]++;
+            to_keys[position] = from_keys[i];
+            if constexpr (kHasValues) to_values[position] = from_values[i];
+          }
+        });
+    std::swap(from_keys, to_keys);
+    if constexpr (kHasValues) std::swap(from_values, to_values);
+  }
+
+  // If we swapped an odd number of times, copy the temporary buffers back.
+  if (from_keys != keys.data()) {
+    std::copy(from_keys, from_keys + size, keys.data());
+    if constexpr (kHasValues) {
+      std::copy(from_values, from_values + size, values.data());
+    }
+  }
+}
+
+// Calls RadixSortKeyValueTpl() with the radix width and number of passes
+// suited to the key type and the number of keys, and returns true; or returns
+// false if the key type isn't supported.
+template <typename K, typename V>
+bool RadixSortKeyValueWithBestWidth(absl::Span<K> keys, absl::Span<V> values,
+                                    int num_threads) {
+  const size_t size = keys.size();
+  if constexpr (sizeof(K) == 1) {
+    RadixSortKeyValueTpl<K, V, /*radix_width=*/8, /*num_passes=*/1>(
+        keys, values, num_threads);
+  } else if constexpr (sizeof(K) == 2) {
+    RadixSortKeyValueTpl<K, V, /*radix_width=*/8, /*num_passes=*/2>(
+        keys, values, num_threads);
+  } else if constexpr (sizeof(K) == 4) {
+    if (size < 1000) {
+      RadixSortKeyValueTpl<K, V, /*radix_width=*/8, /*num_passes=*/4>(
+          keys, values, num_threads);
+    } else if (size < 2'500'000) {
+      RadixSortKeyValueTpl<K, V, /*radix_width=*/11, /*num_passes=*/3>(
+          keys, values, num_threads);
+    } else {
+      RadixSortKeyValueTpl<K, V, /*radix_width=*/16, /*num_passes=*/2>(
+          keys, values, num_threads);
+    }
+  } else if constexpr (sizeof(K) == 8) {
+    if (size < 1'500'000) {
+      RadixSortKeyValueTpl<K, V, /*radix_width=*/11, /*num_passes=*/6>(
+          keys, values, num_threads);
+    } else {
+      RadixSortKeyValueTpl<K, V, /*radix_width=*/16, /*num_passes=*/4>(
+          keys, values, num_threads);
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+}  // namespace internal
+
+template <typename T>
+void ParallelRadixSort(absl::Span<T> values, int num_threads) {
+  if (num_threads <= 1 || values.size() < 2 * kMinSizePerThreadForRadixSort) {
+    RadixSort(values);
+    return;
+  }
+  if (!internal::RadixSortKeyValueWithBestWidth(
+          values, absl::Span<internal::NoValue>(), num_threads)) {
+    RadixSort(values);
+  }
+}
+
+template <typename K, typename V>
+void RadixSortKeyValue(absl::Span<K> keys, absl::Span<V> values,
+                       int num_threads) {
+  CHECK_EQ(keys.size(), values.size());
+  if (internal::RadixSortKeyValueWithBestWidth(keys, values, num_threads)) {
+    return;
+  }
+  LOG(DFATAL) << "RadixSortKeyValue() called with unsupported key type";
+  std::vector<uint32_t> order(keys.size());
+  for (uint32_t i = 0; i < order.size(); ++i) order[i] = i;
+  absl::c_stable_sort(
+      order, [keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+  const std::vector<K> old_keys(keys.begin(), keys.end());
+  const std::vector<V> old_values(values.begin(), values.end());
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    keys[i] = old_keys[order[i]];
+    values[i] = old_values[order[i]];
+  }
+}
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_ALGORITHMS_RADIX_SORT_H_
@@ -222,9 +222,59 @@ TYPED_TEST_P(RadixSortTest, RandomizedCorrectnessTestAgainstStdSortLargeSizes) {
   }
 }
 
+TYPED_TEST_P(RadixSortTest, ParallelRadixSortAgainstStdSort) {
+  constexpr int kNumTests = 10;
+  absl::BitGen rng;
+  for (int test = 0; test < kNumTests; ++test) {
+    const size_t size = absl::LogUniform<size_t>(
+        rng, 0, 8 * kMinSizePerThreadForRadixSort);
+    const int num_threads = absl::Uniform(rng, 1, 5);
+    const bool allow_negative = absl::Bernoulli(rng, 0.5);
+    std::vector<TypeParam> values =
+        RandomValues<TypeParam>(rng, size, allow_negative, /*max_abs_val=*/{});
+    std::vector<TypeParam> expected_values = values;
+    absl::c_sort(expected_values);
+    ParallelRadixSort(absl::MakeSpan(values), num_threads);
+    ASSERT_TRUE(values == expected_values)
+        << DUMP_VARS(test, size, num_threads, allow_negative);
+  }
+}
+
+TYPED_TEST_P(RadixSortTest, RadixSortKeyValueIsStable) {
+  constexpr int kNumTests = 100;
+  absl::BitGen rng;
+  for (int test = 0; test < kNumTests; ++test) {
+    const size_t size = absl::LogUniform<size_t>(
+        rng, 0, 4 * kMinSizePerThreadForRadixSort);
+    const int num_threads = absl::Uniform(rng, 1, 5);
+    const bool allow_negative =
+        std::is_signed_v<TypeParam> && absl::Bernoulli(rng, 0.5);
+    // Few distinct keys, to have many ties.
+    std::optional<TypeParam> max_abs_val;
+    if constexpr (std::is_integral_v<TypeParam>) max_abs_val = 10;
+    std::vector<TypeParam> keys =
+        RandomValues<TypeParam>(rng, size, allow_negative, max_abs_val);
+    std::vector<int> values(size);
+    for (size_t i = 0; i < size; ++i) values[i] = i;
+    std::vector<int> expected_values = values;
+    absl::c_stable_sort(expected_values,
+                        [&keys](int a, int b) { return keys[a] < keys[b]; });
+    std::vector<TypeParam> expected_keys = keys;
+    absl::c_sort(expected_keys);
+    RadixSortKeyValue(absl::MakeSpan(keys), absl::MakeSpan(values),
+                      num_threads);
+    ASSERT_TRUE(keys == expected_keys)
+        << DUMP_VARS(test, size, num_threads, allow_negative);
+    ASSERT_TRUE(values == expected_values)
+        << DUMP_VARS(test, size, num_threads, allow_negative);
+  }
+}
+
 REGISTER_TYPED_TEST_SUITE_P(RadixSortTest, SizeZeroAndOne,
                             RandomizedCorrectnessTestAgainstStdSortSmallSizes,
-                            RandomizedCorrectnessTestAgainstStdSortLargeSizes);
+                            RandomizedCorrectnessTestAgainstStdSortLargeSizes,
+                            ParallelRadixSortAgainstStdSort,
+                            RadixSortKeyValueIsStable);
 using MyTypes = ::testing::Types<int, uint32_t, int64_t, uint64_t, int16_t,
                                  uint16_t, int8_t, uint8_t, double, float>;
 
@@ -0,0 +1,306 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/algorithms/set_cover_compressed_model.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/algorithms/set_cover_model.h"
+#include "ortools/base/file.h"
+#include "ortools/base/options.h"
+
+namespace operations_research {
+
+namespace {
+// "SETCOVR" followed by the version of the format.
+constexpr uint64_t kMagic = 0x0152564f43544553;
+
+struct FileHeader {
+  uint64_t magic;
+  uint64_t num_elements;
+  uint64_t num_subsets;
+  uint64_t num_nonzeros;
+  uint64_t num_encoded_bytes;
+};
+static_assert(sizeof(FileHeader) <= CompressedSetCoverModel::kHeaderSize);
+
+void AppendVarint(uint32_t value, std::vector<uint8_t>* data) {
+  while (value >= 0x80) {
+    data->push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  data->push_back(static_cast<uint8_t>(value));
+}
+
+// Returns a span of size elements of type T at offset in data, which must be
+// suitably aligned.
+template <typename T>
+absl::Span<const T> SpanAt(absl::string_view data, int64_t offset,
+                           int64_t size) {
+  DCHECK_EQ(reinterpret_cast<uintptr_t>(data.data() + offset) % alignof(T), 0);
+  return absl::MakeConstSpan(
+      reinterpret_cast<const T*>(data.data() + offset), size);
+}
+}  // namespace
+
+// The contents of a file, memory-mapped when possible.
+class CompressedSetCoverModel::MappedFile {
+ public:
+  static absl::StatusOr<std::unique_ptr<MappedFile>> Open(
+      absl::string_view filename) {
+    auto mapped_file = std::make_unique<MappedFile>();
+#if defined(__linux__) || defined(__APPLE__)
+    const std::string filename_string(filename);
+    const int fd = open(filename_string.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return absl::NotFoundError(
+          absl::StrCat("Could not open file '", filename, "'"));
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+      close(fd);
+      return absl::InternalError(
+          absl::StrCat("Could not read file '", filename, "'"));
+    }
+    const size_t size = file_stat.st_size;
+    if (size == 0) {
+      close(fd);
+      return mapped_file;
+    }
+    void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      return absl::InternalError(
+          absl::StrCat("Could not map file '", filename, "'"));
+    }
+    mapped_file->data_ =
+        absl::string_view(static_cast<const char*>(data), size);
+    mapped_file->is_mapped_ = true;
+#else
+    absl::StatusOr<std::string> contents =
+        file::GetContents(filename, file::Defaults());
+    if (!contents.ok()) return contents.status();
+    mapped_file->contents_ = *std::move(contents);
+    mapped_file->data_ = mapped_file->contents_;
+#endif
+    return mapped_file;
+  }
+
+  ~MappedFile() {
+#if defined(__linux__) || defined(__APPLE__)
+    if (is_mapped_) {
+      munmap(const_cast<char*>(data_.data()), data_.size());
+    }
+#endif
+  }
+
+  absl::string_view data() const { return data_; }
+
+ private:
+  absl::string_view data_;
+  bool is_mapped_ = false;
+  std::string contents_;
+};
+
+CompressedSetCoverModel::CompressedSetCoverModel()
+    : owned_entry_starts_(1, 0), owned_byte_starts_(1, 0) {
+  UpdateViews();
+}
+
+CompressedSetCoverModel::CompressedSetCoverModel(CompressedSetCoverModel&&) =
+    default;
+CompressedSetCoverModel& CompressedSetCoverModel::operator=(
+    CompressedSetCoverModel&&) = default;
+CompressedSetCoverModel::~CompressedSetCoverModel() = default;
+
+void CompressedSetCoverModel::UpdateViews() {
+  costs_ = owned_costs_;
+  entry_starts_ = owned_entry_starts_;
+  byte_starts_ = owned_byte_starts_;
+  data_ = owned_data_;
+}
+
+CompressedSetCoverModel CompressedSetCoverModel::FromModel(
+    const SetCoverModel& model) {
+  CompressedSetCoverModel compressed;
+  compressed.owned_costs_.reserve(model.num_subsets());
+  compressed.owned_entry_starts_.reserve(model.num_subsets() + 1);
+  compressed.owned_byte_starts_.reserve(model.num_subsets() + 1);
+  for (const SubsetIndex subset : model.SubsetRange()) {
+    const SparseColumn& column = model.columns()[subset];
+    compressed.AddSubset(model.subset_costs()[subset],
+                         absl::MakeConstSpan(column.data(), column.size()));
+  }
+  // The model may have elements covered by no subset.
+  compressed.num_elements_ =
+      std::max(compressed.num_elements_, model.num_elements());
+  return compressed;
+}
+
+void CompressedSetCoverModel::AddSubset(
+    Cost cost, absl::Span<const ElementIndex> elements) {
+  CHECK(mapped_file_ == nullptr) << "A mapped model can't be modified.";
+  std::vector<ElementIndex> sorted_elements(elements.begin(), elements.end());
+  std::sort(sorted_elements.begin(), sorted_elements.end());
+  ElementIndex previous(0);
+  for (const ElementIndex element : sorted_elements) {
+    DCHECK_GE(element, ElementIndex(0));
+    AppendVarint((element - previous).value(), &owned_data_);
+    previous = element;
+  }
+  if (!sorted_elements.empty()) {
+    num_elements_ = std::max(num_elements_, sorted_elements.back().value() + 1);
+  }
+  owned_costs_.push_back(cost);
+  owned_entry_starts_.push_back(owned_entry_starts_.back() +
+                                sorted_elements.size());
+  owned_byte_starts_.push_back(owned_data_.size());
+  UpdateViews();
+}
+
+absl::Status CompressedSetCoverModel::WriteToFile(
+    absl::string_view filename) const {
+  File* file;
+  if (absl::Status status = file::Open(filename, "w", &file, file::Defaults());
+      !status.ok()) {
+    return status;
+  }
+  char header[kHeaderSize] = {};
+  const FileHeader file_header = {
+      .magic = kMagic,
+      .num_elements = static_cast<uint64_t>(num_elements_),
+      .num_subsets = static_cast<uint64_t>(num_subsets()),
+      .num_nonzeros = static_cast<uint64_t>(num_nonzeros()),
+      .num_encoded_bytes = static_cast<uint64_t>(num_encoded_bytes())};
+  std::memcpy(header, &file_header, sizeof(file_header));
+  // The sections are written in order; each has a size multiple of 8 bytes
+  // except the last one, so that they are aligned when mapped.
+  const std::pair<const void*, size_t> sections[] = {
+      {header, kHeaderSize},
+      {costs_.data(), costs_.size() * sizeof(Cost)},
+      {entry_starts_.data(), entry_starts_.size() * sizeof(int64_t)},
+      {byte_starts_.data(), byte_starts_.size() * sizeof(int64_t)},
+      {data_.data(), data_.size()}};
+  for (const auto& [data, size] : sections) {
+    if (size > 0 && file->Write(data, size) != size) {
+      file->Close(file::Defaults()).IgnoreError();
+      return absl::InternalError(
+          absl::StrCat("Could not write to file '", filename, "'"));
+    }
+  }
+  return file->Close(file::Defaults());
+}
+
+absl::StatusOr<CompressedSetCoverModel> CompressedSetCoverModel::MapFile(
+    absl::string_view filename) {
+  absl::StatusOr<std::unique_ptr<MappedFile>> mapped_file =
+      MappedFile::Open(filename);
+  if (!mapped_file.ok()) return mapped_file.status();
+  const absl::string_view data = (*mapped_file)->data();
+  const auto invalid_file = [filename](absl::string_view reason) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Invalid compressed set cover file '", filename, "': ", reason));
+  };
+  if (data.size() < kHeaderSize) return invalid_file("truncated header");
+  FileHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != kMagic) return invalid_file("bad magic number");
+  constexpr uint64_t kMaxBaseInt = std::numeric_limits<BaseInt>::max();
+  if (header.num_elements > kMaxBaseInt || header.num_subsets >= kMaxBaseInt) {
+    return invalid_file("too many elements or subsets");
+  }
+  const int64_t costs_offset = kHeaderSize;
+  const int64_t entry_starts_offset =
+      costs_offset + header.num_subsets * sizeof(Cost);
+  const int64_t byte_starts_offset =
+      entry_starts_offset + (header.num_subsets + 1) * sizeof(int64_t);
+  const int64_t data_offset =
+      byte_starts_offset + (header.num_subsets + 1) * sizeof(int64_t);
+  if (header.num_encoded_bytes > data.size() ||
+      data_offset + header.num_encoded_bytes != data.size()) {
+    return invalid_file("wrong size");
+  }
+
+  CompressedSetCoverModel model;
+  model.num_elements_ = header.num_elements;
+  model.costs_ = SpanAt<Cost>(data, costs_offset, header.num_subsets);
+  model.entry_starts_ =
+      SpanAt<int64_t>(data, entry_starts_offset, header.num_subsets + 1);
+  model.byte_starts_ =
+      SpanAt<int64_t>(data, byte_starts_offset, header.num_subsets + 1);
+  model.data_ = SpanAt<uint8_t>(data, data_offset, header.num_encoded_bytes);
+  // The columns themselves are not checked.
+  if (model.entry_starts_.back() !=
+          static_cast<int64_t>(header.num_nonzeros) ||
+      model.byte_starts_.back() !=
+          static_cast<int64_t>(header.num_encoded_bytes)) {
+    return invalid_file("inconsistent header");
+  }
+  model.mapped_file_ = *std::move(mapped_file);
+  return model;
+}
+
+SparseRowView CompressedSetCoverModel::ComputeRowView() const {
+  ElementToIntVector row_sizes(num_elements_, 0);
+  for (SubsetIndex subset(0); subset < SubsetIndex(num_subsets()); ++subset) {
+    for (const ElementIndex element : column(subset)) {
+      ++row_sizes[element];
+    }
+  }
+  SparseRowView rows(num_elements_);
+  for (ElementIndex element(0); element < ElementIndex(num_elements_);
+       ++element) {
+    rows[element].reserve(RowEntryIndex(row_sizes[element]));
+  }
+  for (SubsetIndex subset(0); subset < SubsetIndex(num_subsets()); ++subset) {
+    for (const ElementIndex element : column(subset)) {
+      rows[element].push_back(subset);
+    }
+  }
+  return rows;
+}
+
+SetCoverModel CompressedSetCoverModel::ToModel() const {
+  SetCoverModel model;
+  for (SubsetIndex subset(0); subset < SubsetIndex(num_subsets()); ++subset) {
+    model.AddEmptySubset(subset_cost(subset));
+    model.ReserveNumElementsInSubset(column_size(subset), subset.value());
+    for (const ElementIndex element : column(subset)) {
+      model.AddElementToLastSubset(element);
+    }
+  }
+  return model;
+}
+
+}  // namespace operations_research
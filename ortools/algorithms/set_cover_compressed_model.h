@@ -0,0 +1,212 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_ALGORITHMS_SET_COVER_COMPRESSED_MODEL_H_
+#define OR_TOOLS_ALGORITHMS_SET_COVER_COMPRESSED_MODEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/algorithms/set_cover_model.h"
+
+// A read-only, compressed column (CSC) representation of a weighted
+// set-covering problem, for instances whose SparseColumnView does not fit in
+// memory.
+//
+// The elements of each column are sorted, and stored as the varint-encoded
+// differences between consecutive elements. For typical instances this takes
+// one to two bytes per nonzero instead of four.
+//
+// The model can be saved to a binary file, which can later be memory-mapped
+// without any parsing or copy. The binary format, in native byte order, is:
+//   - a header of kHeaderSize bytes: a magic number, the number of elements,
+//     the number of subsets, the number of nonzeros and the number of bytes of
+//     the encoded columns, as uint64_t,
+//   - the costs of the subsets, as doubles,
+//   - the index of the first nonzero of each column, plus the number of
+//     nonzeros, as int64_t,
+//   - the offset of the first byte of each column, plus the number of bytes,
+//     as int64_t,
+//   - the encoded columns.
+//
+// The algorithms of set_cover_heuristics.h work on a SetCoverInvariant, which
+// needs a SetCoverModel: ToModel() decompresses the columns, and the row view
+// is only built when the invariant is initialized. ComputeRowView() builds the
+// rows directly from the compressed columns.
+//
+// Example usage:
+//
+// CompressedSetCoverModel compressed;
+// compressed.AddSubset(cost, elements);
+// ...
+// CHECK_OK(compressed.WriteToFile(filename));
+// ...
+// absl::StatusOr<CompressedSetCoverModel> mapped =
+//     CompressedSetCoverModel::MapFile(filename);
+// for (const ElementIndex element : mapped->column(subset)) { ... }
+
+namespace operations_research {
+
+class CompressedSetCoverModel {
+ public:
+  class Column;
+
+  // The size of the file header, in bytes.
+  static constexpr int kHeaderSize = 64;
+
+  // Constructs an empty model, to which subsets can be added.
+  CompressedSetCoverModel();
+
+  CompressedSetCoverModel(CompressedSetCoverModel&&);
+  CompressedSetCoverModel& operator=(CompressedSetCoverModel&&);
+
+  ~CompressedSetCoverModel();
+
+  // Returns the compressed representation of the given model.
+  static CompressedSetCoverModel FromModel(const SetCoverModel& model);
+
+  // Memory-maps a file written by WriteToFile(). The file must not be modified
+  // while the returned model is in use. Subsets can't be added to the returned
+  // model. On platforms without mmap(), the file is read into memory instead.
+  static absl::StatusOr<CompressedSetCoverModel> MapFile(
+      absl::string_view filename);
+
+  // Writes the model in the binary format described above.
+  absl::Status WriteToFile(absl::string_view filename) const;
+
+  // Adds a subset with the given cost and elements, in any order, as the last
+  // column.
+  void AddSubset(Cost cost, absl::Span<const ElementIndex> elements);
+
+  BaseInt num_elements() const { return num_elements_; }
+  BaseInt num_subsets() const { return costs_.size(); }
+  int64_t num_nonzeros() const { return entry_starts_.back(); }
+
+  // Returns the number of bytes taken by the encoded columns.
+  int64_t num_encoded_bytes() const { return data_.size(); }
+
+  Cost subset_cost(SubsetIndex subset) const { return costs_[subset.value()]; }
+
+  // Returns the sorted elements of subset, decoded on the fly.
+  Column column(SubsetIndex subset) const;
+
+  // Returns the number of elements of subset.
+  BaseInt column_size(SubsetIndex subset) const {
+    return entry_starts_[subset.value() + 1] - entry_starts_[subset.value()];
+  }
+
+  // Returns the row view of the problem, with the subsets of each row sorted.
+  SparseRowView ComputeRowView() const;
+
+  // Returns the uncompressed model.
+  SetCoverModel ToModel() const;
+
+ private:
+  class MappedFile;
+
+  // Points the views to the owned vectors.
+  void UpdateViews();
+
+  BaseInt num_elements_ = 0;
+
+  // The data of the model, either in the owned vectors below or in the
+  // mapped file.
+  absl::Span<const Cost> costs_;
+  absl::Span<const int64_t> entry_starts_;
+  absl::Span<const int64_t> byte_starts_;
+  absl::Span<const uint8_t> data_;
+
+  std::vector<Cost> owned_costs_;
+  std::vector<int64_t> owned_entry_starts_;
+  std::vector<int64_t> owned_byte_starts_;
+  std::vector<uint8_t> owned_data_;
+  std::unique_ptr<MappedFile> mapped_file_;
+};
+
+// The elements of a column of a CompressedSetCoverModel.
+class CompressedSetCoverModel::Column {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = ElementIndex;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementIndex*;
+    using reference = ElementIndex;
+
+    Iterator(const uint8_t* data, BaseInt remaining)
+        : data_(data), remaining_(remaining) {
+      if (remaining_ > 0) Decode();
+    }
+
+    ElementIndex operator*() const { return element_; }
+    Iterator& operator++() {
+      if (--remaining_ > 0) Decode();
+      return *this;
+    }
+    bool operator==(const Iterator& other) const {
+      return remaining_ == other.remaining_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return remaining_ != other.remaining_;
+    }
+
+   private:
+    void Decode() {
+      uint32_t delta = 0;
+      int shift = 0;
+      while (*data_ & 0x80) {
+        delta |= static_cast<uint32_t>(*data_ & 0x7f) << shift;
+        shift += 7;
+        ++data_;
+      }
+      delta |= static_cast<uint32_t>(*data_) << shift;
+      ++data_;
+      element_ += ElementIndex(static_cast<BaseInt>(delta));
+    }
+
+    const uint8_t* data_;
+    BaseInt remaining_;
+    ElementIndex element_ = ElementIndex(0);
+  };
+
+  using value_type = ElementIndex;
+  using const_iterator = Iterator;
+
+  Column(const uint8_t* data, BaseInt size) : data_(data), size_(size) {}
+
+  Iterator begin() const { return Iterator(data_, size_); }
+  Iterator end() const { return Iterator(nullptr, 0); }
+  BaseInt size() const { return size_; }
+
+ private:
+  const uint8_t* data_;
+  BaseInt size_;
+};
+
+inline CompressedSetCoverModel::Column CompressedSetCoverModel::column(
+    SubsetIndex subset) const {
+  return Column(data_.data() + byte_starts_[subset.value()],
+                column_size(subset));
+}
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_ALGORITHMS_SET_COVER_COMPRESSED_MODEL_H_
@@ -15,18 +15,23 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
 #include "absl/random/random.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "ortools/algorithms/adjustable_k_ary_heap.h"
 #include "ortools/algorithms/set_cover_invariant.h"
 #include "ortools/algorithms/set_cover_model.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 
 namespace operations_research {
 
@@ -43,6 +48,49 @@ SubsetBoolVector MakeBoolVector(absl::Span<const SubsetIndex> focus,
   }
   return result;
 }
+
+// The maximum number of subsets selected by GreedySolutionGenerator before
+// the priorities are updated, and the number of elements whose best subset is
+// computed at once by ElementDegreeSolutionGenerator. These do not change the
+// solutions.
+constexpr std::size_t kGreedyBatchSize = 64;
+constexpr BaseInt kElementDegreeBatchSize = 1024;
+
+// Returns a started thread pool with num_threads - 1 workers, the calling
+// thread being the last one, or nullptr if num_threads <= 1.
+std::unique_ptr<ThreadPool> MakeThreadPool(absl::string_view name,
+                                           int num_threads) {
+  if (num_threads <= 1) return nullptr;
+  auto pool = std::make_unique<ThreadPool>(name, num_threads - 1);
+  pool->StartWorkers();
+  return pool;
+}
+
+// Calls f(slice, begin, end) on num_threads consecutive slices of [0, size) in
+// parallel, the first one on the calling thread, and waits for all of them.
+// Only slice 0 is used when pool is nullptr.
+template <typename F>
+void ParallelForSlices(ThreadPool* pool, int num_threads, BaseInt size,
+                       const F& f) {
+  const int num_slices =
+      pool == nullptr ? 1 : std::max<BaseInt>(1, std::min(num_threads, size));
+  if (num_slices == 1) {
+    f(0, 0, size);
+    return;
+  }
+  const auto slice_start = [size, num_slices](int slice) {
+    return static_cast<BaseInt>(int64_t{size} * slice / num_slices);
+  };
+  absl::BlockingCounter counter(num_slices - 1);
+  for (int slice = 1; slice < num_slices; ++slice) {
+    pool->Schedule([&, slice]() {
+      f(slice, slice_start(slice), slice_start(slice + 1));
+      counter.DecrementCount();
+    });
+  }
+  f(0, 0, slice_start(1));
+  counter.Wait();
+}
 }  // anonymous namespace
 
 // Preprocessor.
@@ -126,43 +174,106 @@ bool GreedySolutionGenerator::NextSolution(
     const std::vector<SubsetIndex>& focus, const SubsetCostVector& costs) {
   DCHECK(inv_->CheckConsistency());
   inv_->ClearTrace();
+  const BaseInt num_subsets = inv_->model()->num_subsets();
+  const std::unique_ptr<ThreadPool> pool =
+      MakeThreadPool("GreedySolutionGenerator", num_threads_);
   SubsetCostVector elements_per_cost(costs.size(), 0.0);
   for (const SubsetIndex subset : focus) {
     elements_per_cost[subset] = 1.0 / costs[subset];
   }
+  const SubsetToIntVector& num_free_elements = inv_->num_free_elements();
+  const auto priority = [&elements_per_cost,
+                         &num_free_elements](SubsetIndex subset) -> float {
+    // NOMUTANTS -- reason, for C++
+    return elements_per_cost[subset] * num_free_elements[subset];
+  };
+
+  // The priorities of the slices of the focus are computed in parallel, and
+  // concatenated in the order of the focus.
+  std::vector<std::vector<std::pair<float, SubsetIndex::ValueType>>>
+      slice_priorities(std::max(1, num_threads_));
+  ParallelForSlices(
+      pool.get(), num_threads_, focus.size(),
+      [&](int slice, BaseInt begin, BaseInt end) {
+        for (BaseInt i = begin; i < end; ++i) {
+          const SubsetIndex subset = focus[i];
+          if (!inv_->is_selected()[subset] && num_free_elements[subset] != 0) {
+            slice_priorities[slice].push_back(
+                {priority(subset), subset.value()});
+          }
+        }
+      });
   std::vector<std::pair<float, SubsetIndex::ValueType>> subset_priorities;
   DVLOG(1) << "focus.size(): " << focus.size();
   subset_priorities.reserve(focus.size());
-  for (const SubsetIndex subset : focus) {
-    if (!inv_->is_selected()[subset] &&
-        inv_->num_free_elements()[subset] != 0) {
-      // NOMUTANTS -- reason, for C++
-      const float priority =
-          elements_per_cost[subset] * inv_->num_free_elements()[subset];
-      subset_priorities.push_back({priority, subset.value()});
-    }
+  for (const auto& priorities : slice_priorities) {
+    subset_priorities.insert(subset_priorities.end(), priorities.begin(),
+                             priorities.end());
   }
   // The priority queue maintains the maximum number of elements covered by unit
   // of cost. We chose 16 as the arity of the heap after some testing.
   // TODO(user): research more about the best value for Arity.
   AdjustableKAryHeap<float, SubsetIndex::ValueType, 16, true> pq(
-      subset_priorities, inv_->model()->num_subsets());
+      subset_priorities, num_subsets);
+  std::vector<SubsetIndex> batch;
+  std::vector<std::pair<float, SubsetIndex::ValueType>> updated_priorities;
+  std::vector<std::vector<SubsetIndex>> slice_impacted_subsets(
+      std::max(1, num_threads_));
+  SubsetBoolVector is_impacted(num_subsets, false);
+  const SparseColumnView& columns = inv_->model()->columns();
+  const SparseRowView& rows = inv_->model()->rows();
   while (!pq.IsEmpty()) {
-    const SubsetIndex best_subset(pq.TopIndex());
-    pq.Pop();
-    inv_->Select(best_subset);
-    // NOMUTANTS -- reason, for C++
+    // Selects the top subsets as long as their priority is up to date, i.e.
+    // they do not intersect the subsets selected before them in the batch.
+    // This is always the case of the first one. Since the priorities only
+    // decrease, such a subset has the largest priority.
+    batch.clear();
+    while (!pq.IsEmpty() && batch.size() < kGreedyBatchSize) {
+      const SubsetIndex subset(pq.TopIndex());
+      if (pq.TopPriority() != priority(subset)) break;
+      pq.Pop();
+      inv_->Select(subset);
+      batch.push_back(subset);
+      // NOMUTANTS -- reason, for C++
+      if (inv_->num_uncovered_elements() == 0) break;
+    }
     if (inv_->num_uncovered_elements() == 0) break;
-    for (IntersectingSubsetsIterator it(*inv_->model(), best_subset);
-         !it.at_end(); ++it) {
-      const SubsetIndex subset = *it;
-      const BaseInt marginal_impact(inv_->num_free_elements()[subset]);
-      if (marginal_impact > 0) {
-        const float priority = marginal_impact * elements_per_cost[subset];
-        pq.Update({priority, subset.value()});
-      } else {
-        pq.Remove(subset.value());
+
+    // Collects the subsets of the queue intersecting the batch in parallel,
+    // then updates their priorities.
+    ParallelForSlices(pool.get(), num_threads_, batch.size(),
+                      [&](int slice, BaseInt begin, BaseInt end) {
+                        std::vector<SubsetIndex>& impacted_subsets =
+                            slice_impacted_subsets[slice];
+                        impacted_subsets.clear();
+                        for (BaseInt i = begin; i < end; ++i) {
+                          for (const ElementIndex element : columns[batch[i]]) {
+                            for (const SubsetIndex subset : rows[element]) {
+                              if (pq.Contains(subset.value())) {
+                                impacted_subsets.push_back(subset);
+                              }
+                            }
+                          }
+                        }
+                      });
+    updated_priorities.clear();
+    for (std::vector<SubsetIndex>& impacted_subsets : slice_impacted_subsets) {
+      for (const SubsetIndex subset : impacted_subsets) {
+        if (is_impacted[subset]) continue;
+        is_impacted[subset] = true;
+        if (num_free_elements[subset] > 0) {
+          updated_priorities.push_back({priority(subset), subset.value()});
+        } else {
+          pq.Remove(subset.value());
+        }
+      }
+    }
+    pq.Update(updated_priorities);
+    for (std::vector<SubsetIndex>& impacted_subsets : slice_impacted_subsets) {
+      for (const SubsetIndex subset : impacted_subsets) {
+        is_impacted[subset] = false;
       }
+      impacted_subsets.clear();
     }
     DVLOG(1) << "Cost = " << inv_->cost()
              << " num_uncovered_elements = " << inv_->num_uncovered_elements();
@@ -216,29 +327,67 @@ bool ElementDegreeSolutionGenerator::NextSolution(
               if (rows[a].size() == rows[b].size()) return a < b;
               return false;
             });
-  for (const ElementIndex element : degree_sorted_elements) {
-    // No need to cover an element that is already covered.
-    if (inv_->coverage()[element] != 0) continue;
-    Cost min_ratio = std::numeric_limits<Cost>::max();
-    SubsetIndex best_subset(-1);
-    for (const SubsetIndex subset : rows[element]) {
-      if (!in_focus[subset]) continue;
-      const Cost ratio = costs[subset] / inv_->num_free_elements()[subset];
-      if (ratio < min_ratio) {
-        min_ratio = ratio;
-        best_subset = subset;
+  const std::unique_ptr<ThreadPool> pool =
+      MakeThreadPool("ElementDegreeSolutionGenerator", num_threads_);
+  const SubsetToIntVector& num_free_elements = inv_->num_free_elements();
+  std::vector<SubsetIndex> best_subsets;
+  std::vector<BaseInt> best_subset_num_free_elements;
+  for (BaseInt batch_start = 0; batch_start < num_elements;
+       batch_start += kElementDegreeBatchSize) {
+    const BaseInt batch_size =
+        std::min(kElementDegreeBatchSize, num_elements - batch_start);
+    best_subsets.assign(batch_size, kNotFound);
+    best_subset_num_free_elements.assign(batch_size, 0);
+    ParallelForSlices(
+        pool.get(), num_threads_, batch_size,
+        [&](int, BaseInt begin, BaseInt end) {
+          for (BaseInt i = begin; i < end; ++i) {
+            const ElementIndex element =
+                degree_sorted_elements[batch_start + i];
+            if (inv_->coverage()[element] != 0) continue;
+            best_subsets[i] = ComputeBestSubset(element, in_focus, costs);
+            if (best_subsets[i] != kNotFound) {
+              best_subset_num_free_elements[i] =
+                  num_free_elements[best_subsets[i]];
+            }
+          }
+        });
+    for (BaseInt i = 0; i < batch_size; ++i) {
+      const ElementIndex element = degree_sorted_elements[batch_start + i];
+      // No need to cover an element that is already covered.
+      if (inv_->coverage()[element] != 0) continue;
+      SubsetIndex best_subset = best_subsets[i];
+      if (best_subset == kNotFound ||
+          num_free_elements[best_subset] != best_subset_num_free_elements[i]) {
+        best_subset = ComputeBestSubset(element, in_focus, costs);
       }
+      DCHECK_NE(best_subset, kNotFound);
+      inv_->Select(best_subset);
+      DVLOG(1) << "Cost = " << inv_->cost() << " num_uncovered_elements = "
+               << inv_->num_uncovered_elements();
     }
-    DCHECK_NE(best_subset, SubsetIndex(-1));
-    inv_->Select(best_subset);
-    DVLOG(1) << "Cost = " << inv_->cost()
-             << " num_uncovered_elements = " << inv_->num_uncovered_elements();
   }
   inv_->CompressTrace();
   DCHECK(inv_->CheckConsistency());
   return true;
 }
 
+SubsetIndex ElementDegreeSolutionGenerator::ComputeBestSubset(
+    ElementIndex element, const SubsetBoolVector& in_focus,
+    const SubsetCostVector& costs) const {
+  Cost min_ratio = std::numeric_limits<Cost>::max();
+  SubsetIndex best_subset = kNotFound;
+  for (const SubsetIndex subset : inv_->model()->rows()[element]) {
+    if (!in_focus[subset]) continue;
+    const Cost ratio = costs[subset] / inv_->num_free_elements()[subset];
+    if (ratio < min_ratio) {
+      min_ratio = ratio;
+      best_subset = subset;
+    }
+  }
+  return best_subset;
+}
+
 // SteepestSearch.
 
 void SteepestSearch::UpdatePriorities(absl::Span<const SubsetIndex>) {}
@@ -278,12 +427,27 @@ bool SteepestSearch::NextSolution(const SubsetBoolVector& in_focus,
 
   // Create priority queue with cost of using a subset, by decreasing order.
   // Do it only for selected AND removable subsets.
+  // The redundancy of the subsets of the trace is computed in parallel.
+  const std::vector<SetCoverDecision>& trace = inv_->trace();
+  std::vector<char> is_removable(trace.size(), false);
+  {
+    const std::unique_ptr<ThreadPool> pool =
+        MakeThreadPool("SteepestSearch", num_threads_);
+    ParallelForSlices(pool.get(), num_threads_, trace.size(),
+                      [&](int, BaseInt begin, BaseInt end) {
+                        for (BaseInt i = begin; i < end; ++i) {
+                          const SubsetIndex subset = trace[i].subset();
+                          is_removable[i] = in_focus[subset] &&
+                                            inv_->is_selected()[subset] &&
+                                            inv_->ComputeIsRedundant(subset);
+                        }
+                      });
+  }
   std::vector<std::pair<float, SubsetIndex::ValueType>> subset_priorities;
   subset_priorities.reserve(in_focus.size());
-  for (const SetCoverDecision& decision : inv_->trace()) {
-    const SubsetIndex subset = decision.subset();
-    if (in_focus[subset] && inv_->is_selected()[subset] &&
-        inv_->ComputeIsRedundant(subset)) {
+  for (BaseInt i = 0; i < trace.size(); ++i) {
+    if (is_removable[i]) {
+      const SubsetIndex subset = trace[i].subset();
       const float delta_per_element = costs[subset];
       subset_priorities.push_back({delta_per_element, subset.value()});
     }
@@ -543,6 +707,39 @@ bool GuidedLocalSearch::NextSolution(absl::Span<const SubsetIndex> focus,
   return true;
 }
 
+// Parallel Guided Local Search
+
+bool ParallelGuidedLocalSearch::NextSolution(int num_iterations) {
+  return NextSolution(inv_->model()->all_subsets(), num_iterations);
+}
+
+bool ParallelGuidedLocalSearch::NextSolution(
+    absl::Span<const SubsetIndex> focus, int num_iterations) {
+  const int num_searches = std::max(1, num_threads_);
+  std::vector<SetCoverInvariant> invariants(num_searches, *inv_);
+  const std::unique_ptr<ThreadPool> pool =
+      MakeThreadPool("ParallelGuidedLocalSearch", num_searches);
+  ParallelForSlices(pool.get(), num_searches, num_searches,
+                    [&](int, BaseInt begin, BaseInt end) {
+                      for (BaseInt search = begin; search < end; ++search) {
+                        GuidedLocalSearch gls(&invariants[search]);
+                        gls.SetAlpha(Alpha(search));
+                        gls.Initialize();
+                        gls.NextSolution(focus, num_iterations);
+                      }
+                    });
+  int best_search = 0;
+  for (int search = 1; search < num_searches; ++search) {
+    if (invariants[search].cost() < invariants[best_search].cost()) {
+      best_search = search;
+    }
+  }
+  DVLOG(1) << "Best search: " << best_search
+           << ", cost = " << invariants[best_search].cost();
+  inv_->LoadSolution(invariants[best_search].is_selected());
+  return true;
+}
+
 namespace {
 void SampleSubsets(std::vector<SubsetIndex>* list, std::size_t num_subsets) {
   num_subsets = std::min(num_subsets, list->size());
@@ -64,8 +64,13 @@ class SubsetIndexWithPriority {
 // indices. Focus make it possible to run the algorithms on the corresponding
 // subproblems.
 //
-// TODO(user): make the different algorithms concurrent, solving independent
-// subproblems in different threads.
+// GreedySolutionGenerator, ElementDegreeSolutionGenerator and SteepestSearch
+// can compute their priorities on several threads, and
+// ParallelGuidedLocalSearch runs several guided local searches concurrently.
+// Their results do not depend on the number of threads, except for
+// ParallelGuidedLocalSearch where they only depend on it.
+//
+// TODO(user): solve independent subproblems in different threads.
 //
 
 // The preprocessor finds the elements that can only be covered by one subset.
@@ -160,10 +165,16 @@ class RandomSolutionGenerator {
 // Cormode, Graham, Howard Karloff, and Anthony Wirth. 2010. “Set Cover
 // Algorithms for Very Large Datasets.” In CIKM ’10. ACM Press.
 // https://doi.org/10.1145/1871437.1871501.
-
+//
+// The subsets are selected by batches: the top subsets of the priority queue
+// are selected as long as their priority did not change with the previous
+// selections of the batch, which makes the same choices as selecting them one
+// at a time, up to ties. The subsets intersecting the batch are then collected
+// on num_threads threads and their priorities updated.
 class GreedySolutionGenerator {
  public:
-  explicit GreedySolutionGenerator(SetCoverInvariant* inv) : inv_(inv) {}
+  explicit GreedySolutionGenerator(SetCoverInvariant* inv, int num_threads = 1)
+      : inv_(inv), num_threads_(num_threads) {}
 
   // Returns true if a solution was found.
   // TODO(user): Add time-outs and exit with a partial solution.
@@ -180,6 +191,9 @@ class GreedySolutionGenerator {
  private:
   // The data structure that will maintain the invariant for the model.
   SetCoverInvariant* inv_;
+
+  // The number of threads used to collect the subsets to update.
+  int num_threads_;
 };
 
 // Solution generator based on the degree of elements.
@@ -187,9 +201,18 @@ class GreedySolutionGenerator {
 // The generator consists in iteratively choosing a non-covered element with the
 // smallest degree, and selecting a subset that covers it with the least cost.
 // The newly-covered elements degree are also updated.
+//
+// The best subsets of a batch of elements are computed on num_threads threads
+// with the same invariant. Since the ratios of the subsets only increase when
+// subsets are selected, the best subset of an element is still the same when
+// it is selected if its number of free elements did not change in-between;
+// otherwise it is computed again. This yields the same solution as processing
+// the elements one at a time.
 class ElementDegreeSolutionGenerator {
  public:
-  explicit ElementDegreeSolutionGenerator(SetCoverInvariant* inv) : inv_(inv) {}
+  explicit ElementDegreeSolutionGenerator(SetCoverInvariant* inv,
+                                          int num_threads = 1)
+      : inv_(inv), num_threads_(num_threads) {}
 
   // Returns true if a solution was found.
   // TODO(user): Add time-outs and exit with a partial solution.
@@ -209,8 +232,17 @@ class ElementDegreeSolutionGenerator {
   bool NextSolution(const SubsetBoolVector& in_focus,
                     const SubsetCostVector& costs);
 
+  // Returns the subset in focus covering element with the smallest ratio of
+  // cost per free element.
+  SubsetIndex ComputeBestSubset(ElementIndex element,
+                                const SubsetBoolVector& in_focus,
+                                const SubsetCostVector& costs) const;
+
   // The data structure that will maintain the invariant for the model.
   SetCoverInvariant* inv_;
+
+  // The number of threads used to compute the best subsets.
+  int num_threads_;
 };
 
 // Once we have a first solution to the problem, there may be (most often,
@@ -219,9 +251,12 @@ class ElementDegreeSolutionGenerator {
 // the solution or equivalently, to flip some x_j's from 1 to 0. the algorithm
 // gets its name because it goes in the steepest immediate direction, taking
 // the S_j with the largest total cost.
+// The redundant subsets of the initial solution are found on num_threads
+// threads.
 class SteepestSearch {
  public:
-  explicit SteepestSearch(SetCoverInvariant* inv) : inv_(inv) {}
+  explicit SteepestSearch(SetCoverInvariant* inv, int num_threads = 1)
+      : inv_(inv), num_threads_(num_threads) {}
 
   // Returns true if a solution was found within num_iterations.
   // TODO(user): Add time-outs and exit with a partial solution.
@@ -246,6 +281,9 @@ class SteepestSearch {
 
   // The data structure that will maintain the invariant for the model.
   SetCoverInvariant* inv_;
+
+  // The number of threads used to find the redundant subsets.
+  int num_threads_;
 };
 
 // A Tabu list is a fixed-sized set with FIFO replacement. It is expected to
@@ -430,11 +468,8 @@ class GuidedLocalSearch {
 
   bool NextSolution(const SubsetBoolVector& in_focus, int num_iterations);
 
- private:
-  // The data structure that will maintain the invariant for the model.
-  SetCoverInvariant* inv_;
-
   // Setters and getters for the Guided Local Search algorithm parameters.
+  // Initialize() must be called again after SetAlpha().
   void SetEpsilon(double r) { epsilon_ = r; }
 
   double GetEpsilon() const { return epsilon_; }
@@ -443,6 +478,12 @@ class GuidedLocalSearch {
 
   double GetAlpha() const { return alpha_; }
 
+  static constexpr double DefaultAlpha() { return kDefaultAlpha; }
+
+ private:
+  // The data structure that will maintain the invariant for the model.
+  SetCoverInvariant* inv_;
+
   // The epsilon value for the Guided Local Search algorithm.
   // Used to penalize the subsets within epsilon of the maximum utility.
   static constexpr double kDefaultEpsilon = 1e-8;
@@ -471,6 +512,38 @@ class GuidedLocalSearch {
   AdjustableKAryHeap<float, SubsetIndex::ValueType, 2, true> utility_heap_;
 };
 
+// Runs num_threads GuidedLocalSearch concurrently from the current solution,
+// each on its own copy of the invariant and with its own penalization factor
+// alpha, and loads the best solution found. Among the solutions of equal cost,
+// the one of the search with the smallest index is kept: since each search is
+// deterministic, so is the result for a given number of threads.
+class ParallelGuidedLocalSearch {
+ public:
+  ParallelGuidedLocalSearch(SetCoverInvariant* inv, int num_threads)
+      : inv_(inv), num_threads_(num_threads) {}
+
+  // Returns the next solution after running each search for num_iterations
+  // iterations.
+  bool NextSolution(int num_iterations);
+
+  // Computes the next partial solution considering only the subsets whose
+  // indices are in focus.
+  bool NextSolution(absl::Span<const SubsetIndex> focus, int num_iterations);
+
+  // Returns the penalization factor of the search of the given index. The
+  // first search uses the default factor of GuidedLocalSearch.
+  static double Alpha(int search_index) {
+    return GuidedLocalSearch::DefaultAlpha() * (1.0 + 0.5 * search_index);
+  }
+
+ private:
+  // The data structure that will maintain the invariant for the model.
+  SetCoverInvariant* inv_;
+
+  // The number of concurrent searches.
+  int num_threads_;
+};
+
 // Randomly clears a proportion num_subsets variables in the solution.
 // Returns a list of subset indices to be potentially reused as a focus.
 // Randomly clears at least num_subsets variables in the
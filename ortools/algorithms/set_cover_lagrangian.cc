@@ -14,12 +14,15 @@
 #include "ortools/algorithms/set_cover_lagrangian.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 #include <tuple>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "ortools/algorithms/adjustable_k_ary_heap.h"
 #include "ortools/algorithms/set_cover_invariant.h"
 #include "ortools/algorithms/set_cover_model.h"
@@ -36,6 +39,73 @@ namespace operations_research {
 //   (under "queue" in the paper).
 // - the median algorithm is already in the STL (nth_element).
 
+namespace {
+// The shards have at least this number of nonzeros (or elements), so that
+// scheduling them costs little compared to their processing.
+constexpr int64_t kMinShardSize = 1 << 14;
+
+// The maximum number of shards, enough to balance the load between many
+// threads.
+constexpr int64_t kMaxNumShards = 256;
+
+// Returns the shard starts splitting [0, size) into ranges of roughly equal
+// total weight, followed by size.
+template <typename Index, typename WeightFunction>
+std::vector<Index> ComputeShardStarts(BaseInt size, int64_t total_weight,
+                                      const WeightFunction& weight) {
+  const int64_t num_shards =
+      std::clamp<int64_t>(total_weight / kMinShardSize, 1, kMaxNumShards);
+  std::vector<Index> starts = {Index(0)};
+  int64_t weight_so_far = 0;
+  for (BaseInt i = 0; i < size; ++i) {
+    // Shard k ends at the first index where the cumulated weight reaches
+    // k / num_shards of the total.
+    if (weight_so_far * num_shards >= total_weight * starts.size() &&
+        starts.back() != Index(i)) {
+      starts.push_back(Index(i));
+    }
+    weight_so_far += weight(Index(i));
+  }
+  starts.push_back(Index(size));
+  return starts;
+}
+}  // namespace
+
+SetCoverLagrangian::SetCoverLagrangian(SetCoverInvariant* inv, int num_threads)
+    : inv_(inv), model_(*inv->model()), num_threads_(num_threads) {
+  const SparseColumnView& columns = model_.columns();
+  // A subset costs its number of elements, plus one for its own cost.
+  subset_shard_starts_ = ComputeShardStarts<SubsetIndex>(
+      model_.num_subsets(), model_.num_nonzeros() + model_.num_subsets(),
+      [&columns](SubsetIndex subset) { return columns[subset].size() + 1; });
+  const SparseRowView& rows = model_.rows();
+  element_shard_starts_ = ComputeShardStarts<ElementIndex>(
+      model_.num_elements(), model_.num_nonzeros() + model_.num_elements(),
+      [&rows](ElementIndex element) { return rows[element].size() + 1; });
+  if (num_threads_ > 1) {
+    thread_pool_ =
+        std::make_unique<ThreadPool>("SetCoverLagrangian", num_threads_);
+    thread_pool_->StartWorkers();
+  }
+}
+
+template <typename F>
+void SetCoverLagrangian::ParallelForEachShard(int num_shards,
+                                              const F& f) const {
+  if (thread_pool_ == nullptr || num_shards == 1) {
+    for (int shard = 0; shard < num_shards; ++shard) f(shard);
+    return;
+  }
+  absl::BlockingCounter counter(num_shards);
+  for (int shard = 0; shard < num_shards; ++shard) {
+    thread_pool_->Schedule([&f, &counter, shard]() {
+      f(shard);
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+}
+
 // Denoted as u in [1], it is a dual vector: a column vector of nonnegative
 // (zero is included) multipliers for the different constraints.
 // A deterministic way to compute a feasible (non-optimal) u:
@@ -67,17 +137,59 @@ ElementCostVector SetCoverLagrangian::InitializeLagrangeMultipliers() const {
   return multipliers;
 }
 
+ElementCostVector SetCoverLagrangian::ParallelInitializeLagrangeMultipliers()
+    const {
+  ElementCostVector multipliers(model_.num_elements(),
+                                std::numeric_limits<Cost>::infinity());
+  SubsetCostVector marginal_costs(model_.num_subsets());
+  const SparseColumnView& columns = model_.columns();
+  ParallelForEachShard(num_subset_shards(), [&](int shard) {
+    for (SubsetIndex subset = subset_shard_starts_[shard];
+         subset < subset_shard_starts_[shard + 1]; ++subset) {
+      marginal_costs[subset] =
+          model_.subset_costs()[subset] / columns[subset].size();
+    }
+  });
+  const SparseRowView& rows = model_.rows();
+  ParallelForEachShard(num_element_shards(), [&](int shard) {
+    for (ElementIndex element = element_shard_starts_[shard];
+         element < element_shard_starts_[shard + 1]; ++element) {
+      Cost min_marginal_cost = std::numeric_limits<Cost>::infinity();
+      for (const SubsetIndex subset : rows[element]) {
+        min_marginal_cost = std::min(min_marginal_cost, marginal_costs[subset]);
+      }
+      multipliers[element] = min_marginal_cost;
+    }
+  });
+  return multipliers;
+}
+
 namespace {
 // Computes the scalar product between a column and a vector of duals.
-// Profiling has shown that this is where most of the time is spent.
+// Profiling has shown that this is where most of the time is spent: the loads
+// from dual are random, so the loop is bound by their latency. Four
+// independent partial sums let the compiler vectorize the gathers and keep
+// several loads in flight.
 // TODO(user): make this visible to other algorithms.
-// TODO(user): Investigate.
 Cost ScalarProduct(const SparseColumn& column, const ElementCostVector& dual) {
-  Cost result = 0.0;
-  for (ColumnEntryIndex pos(0); pos.value() < column.size(); ++pos) {
-    result += dual[column[pos]];
+  const ElementIndex* const elements = column.data();
+  const Cost* const values = dual.data();
+  const BaseInt size = column.size();
+  Cost sum0 = 0.0;
+  Cost sum1 = 0.0;
+  Cost sum2 = 0.0;
+  Cost sum3 = 0.0;
+  BaseInt pos = 0;
+  for (; pos + 4 <= size; pos += 4) {
+    sum0 += values[elements[pos].value()];
+    sum1 += values[elements[pos + 1].value()];
+    sum2 += values[elements[pos + 2].value()];
+    sum3 += values[elements[pos + 3].value()];
   }
-  return result;
+  for (; pos < size; ++pos) {
+    sum0 += values[elements[pos].value()];
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
 }
 
 // Computes the reduced costs for a subset of subsets.
@@ -98,36 +210,17 @@ void FillReducedCostsSlice(SubsetIndex start, SubsetIndex end,
 }
 }  // namespace
 
-// Computes the reduced costs for all subsets in parallel using ThreadPool.
+// Computes the reduced costs for all subsets in parallel, one shard of subsets
+// per task.
 SubsetCostVector SetCoverLagrangian::ParallelComputeReducedCosts(
     const SubsetCostVector& costs, const ElementCostVector& multipliers) const {
-  const SubsetIndex num_subsets(model_.num_subsets());
-  // TODO(user): compute a close-to-optimal k-subset partitioning.
-  const SubsetIndex block_size =
-      SubsetIndex(1) + num_subsets / num_threads_;  // [***] Arbitrary choice.
   const SparseColumnView& columns = model_.columns();
-  SubsetCostVector reduced_costs(num_subsets);
-  ThreadPool thread_pool("ParallelComputeReducedCosts", num_threads_);
-  thread_pool.StartWorkers();
-  {
-    // TODO(user): check how costly it is to create a new ThreadPool.
-    // TODO(user): use a queue of subsets to process? instead of a fixed range.
-
-    // This parallelization is not very efficient, because all the threads
-    // use the same costs vector. Maybe it should be local to the thread.
-    // It's unclear whether sharing columns and costs is better than having
-    // each thread use its own partial copy.
-    // Finally, it might be better to use a queue of subsets to process, instead
-    // of a fixed range.
-    for (SubsetIndex start(0); start < num_subsets; start += block_size) {
-      thread_pool.Schedule([start, block_size, num_subsets, &costs,
-                            &multipliers, &columns, &reduced_costs]() {
-        const SubsetIndex end = std::min(start + block_size, num_subsets);
-        FillReducedCostsSlice(start, end, costs, multipliers, columns,
-                              &reduced_costs);
-      });
-    }
-  }  // Synchronize all the threads. This is equivalent to a wait.
+  SubsetCostVector reduced_costs(model_.num_subsets());
+  ParallelForEachShard(num_subset_shards(), [&](int shard) {
+    FillReducedCostsSlice(subset_shard_starts_[shard],
+                          subset_shard_starts_[shard + 1], costs, multipliers,
+                          columns, &reduced_costs);
+  });
   return reduced_costs;
 }
 
@@ -178,38 +271,22 @@ ElementCostVector SetCoverLagrangian::ComputeSubgradient(
   return subgradient;
 }
 
+// The shards of elements are independent: the subgradient of an element only
+// depends on the subsets of its row.
 ElementCostVector SetCoverLagrangian::ParallelComputeSubgradient(
     const SubsetCostVector& reduced_costs) const {
-  const SubsetIndex num_subsets(model_.num_subsets());
-  const SubsetIndex block_size =
-      SubsetIndex(1) + num_subsets / num_threads_;  // [***]
-  const SparseColumnView& columns = model_.columns();
-  ElementCostVector subgradient(model_.num_elements(), 1.0);
-  // The subgradient has one component per element, each thread processes
-  // several subsets. Hence, have one vector per thread to avoid data races.
-  // TODO(user): it may be better to split the elements among the threads,
-  // although this might be less well-balanced.
-  std::vector<ElementCostVector> subgradients(
-      num_threads_, ElementCostVector(model_.num_elements()));
-  ThreadPool thread_pool("ParallelComputeSubgradient", num_threads_);
-  thread_pool.StartWorkers();
-  {
-    int thread_index = 0;
-    for (SubsetIndex start(0); start < num_subsets;
-         start += block_size, ++thread_index) {
-      thread_pool.Schedule([start, block_size, num_subsets, &reduced_costs,
-                            &columns, &subgradients, thread_index]() {
-        const SubsetIndex end = std::min(start + block_size, num_subsets);
-        FillSubgradientSlice(start, end, columns, reduced_costs,
-                             &subgradients[thread_index]);
-      });
-    }
-  }  // Synchronize all the threads.
-  for (int thread_index = 0; thread_index < num_threads_; ++thread_index) {
-    for (const ElementIndex element : model_.ElementRange()) {
-      subgradient[element] += subgradients[thread_index][element];
+  const SparseRowView& rows = model_.rows();
+  ElementCostVector subgradient(model_.num_elements());
+  ParallelForEachShard(num_element_shards(), [&](int shard) {
+    for (ElementIndex element = element_shard_starts_[shard];
+         element < element_shard_starts_[shard + 1]; ++element) {
+      BaseInt num_selected = 0;
+      for (const SubsetIndex subset : rows[element]) {
+        num_selected += reduced_costs[subset] < 0.0;
+      }
+      subgradient[element] = 1.0 - num_selected;
     }
-  }
+  });
   return subgradient;
 }
 
@@ -258,33 +335,26 @@ Cost SetCoverLagrangian::ComputeLagrangianValue(
 Cost SetCoverLagrangian::ParallelComputeLagrangianValue(
     const SubsetCostVector& reduced_costs,
     const ElementCostVector& multipliers) const {
-  const SubsetIndex num_subsets(model_.num_subsets());
-  const SubsetIndex block_size =
-      SubsetIndex(1) + num_subsets / num_threads_;  // [***] Arbitrary.
-  Cost lagrangian_value = 0.0;
-  // This is \sum{i \in M} u_i.
-
-  for (const Cost u : multipliers) {
-    lagrangian_value += u;
-  }
-  std::vector<Cost> lagrangian_values(num_threads_, 0.0);
-  ThreadPool thread_pool("ParallelComputeLagrangianValue", num_threads_);
-  thread_pool.StartWorkers();
-  {
-    int thread_index = 0;
-    for (SubsetIndex start(0); start < num_subsets; start += block_size) {
-      thread_pool.Schedule([start, block_size, num_subsets, thread_index,
-                            &reduced_costs, &lagrangian_values]() {
-        const SubsetIndex end = std::min(start + block_size, num_subsets);
-        FillLagrangianValueSlice(start, end, reduced_costs,
-                                 &lagrangian_values[thread_index]);
-      });
-      ++thread_index;
+  // The sums of the multipliers and of the negative reduced costs of each
+  // shard, added in order at the end.
+  std::vector<Cost> multiplier_sums(num_element_shards(), 0.0);
+  std::vector<Cost> reduced_cost_sums(num_subset_shards(), 0.0);
+  ParallelForEachShard(num_element_shards(), [&](int shard) {
+    Cost sum = 0.0;
+    for (ElementIndex element = element_shard_starts_[shard];
+         element < element_shard_starts_[shard + 1]; ++element) {
+      sum += multipliers[element];
     }
-  }  // Synchronize all the threads.
-  for (const Cost l : lagrangian_values) {
-    lagrangian_value += l;
-  }
+    multiplier_sums[shard] = sum;
+  });
+  ParallelForEachShard(num_subset_shards(), [&](int shard) {
+    FillLagrangianValueSlice(subset_shard_starts_[shard],
+                             subset_shard_starts_[shard + 1], reduced_costs,
+                             &reduced_cost_sums[shard]);
+  });
+  Cost lagrangian_value = 0.0;
+  for (const Cost sum : multiplier_sums) lagrangian_value += sum;
+  for (const Cost sum : reduced_cost_sums) lagrangian_value += sum;
   return lagrangian_value;
 }
 
@@ -331,22 +401,35 @@ void SetCoverLagrangian::ParallelUpdateMultipliers(
     ElementCostVector* multipliers) const {
   // step_size is \lambda_k in [1].
   DCHECK_GT(step_size, 0);
-  // Compute the square of the Euclidean norm of the subgradient vector.
+  // Compute the square of the Euclidean norm of the subgradient vector, one
+  // partial sum per shard.
   const ElementCostVector subgradient =
       ParallelComputeSubgradient(reduced_costs);
+  std::vector<Cost> square_norms(num_element_shards(), 0.0);
+  ParallelForEachShard(num_element_shards(), [&](int shard) {
+    Cost square_norm = 0.0;
+    for (ElementIndex element = element_shard_starts_[shard];
+         element < element_shard_starts_[shard + 1]; ++element) {
+      square_norm += subgradient[element] * subgradient[element];
+    }
+    square_norms[shard] = square_norm;
+  });
   Cost subgradient_square_norm = 0.0;
-  for (const Cost x : subgradient) {
-    subgradient_square_norm += x * x;
+  for (const Cost square_norm : square_norms) {
+    subgradient_square_norm += square_norm;
   }
   // First compute lambda_k * (UB - L(u^k)).
   const Cost factor =
       step_size * (upper_bound - lagrangian_value) / subgradient_square_norm;
-  for (const ElementIndex element : model_.ElementRange()) {
-    // Avoid multipliers to go negative and to go through the roof. 1e6 chosen
-    // arbitrarily. [***]
-    (*multipliers)[element] = std::clamp(
-        (*multipliers)[element] + factor * subgradient[element], 0.0, 1e6);
-  }
+  ParallelForEachShard(num_element_shards(), [&](int shard) {
+    for (ElementIndex element = element_shard_starts_[shard];
+         element < element_shard_starts_[shard + 1]; ++element) {
+      // Avoid multipliers to go negative and to go through the roof. 1e6
+      // chosen arbitrarily. [***]
+      (*multipliers)[element] = std::clamp(
+          (*multipliers)[element] + factor * subgradient[element], 0.0, 1e6);
+    }
+  });
 }
 
 Cost SetCoverLagrangian::ComputeGap(
@@ -491,7 +574,7 @@ std::tuple<Cost, SubsetCostVector, ElementCostVector>
 SetCoverLagrangian::ComputeLowerBound(const SubsetCostVector& costs,
                                       Cost upper_bound) {
   Cost lower_bound = 0.0;
-  ElementCostVector multipliers = InitializeLagrangeMultipliers();
+  ElementCostVector multipliers = ParallelInitializeLagrangeMultipliers();
   double step_size = 0.1;               // [***] arbitrary, from [1].
   StepSizer step_sizer(20, step_size);  // [***] arbitrary, from [1].
   Stopper stopper(100);                 // [***] arbitrary, from [1].
@@ -500,12 +583,14 @@ SetCoverLagrangian::ComputeLowerBound(const SubsetCostVector& costs,
   // Running linux perf of the process shows that up to 60% of the cycles are
   // lost as idle cycles in the CPU backend, probably because the algorithm is
   // memory bound.
+  // All the passes over the model are sharded; only the step size is updated
+  // sequentially, as it is a scalar.
   for (int iter = 0; iter < 1000; ++iter) {
     reduced_costs = ParallelComputeReducedCosts(costs, multipliers);
     const Cost lagrangian_value =
-        ComputeLagrangianValue(reduced_costs, multipliers);
-    UpdateMultipliers(step_size, lagrangian_value, upper_bound, reduced_costs,
-                      &multipliers);
+        ParallelComputeLagrangianValue(reduced_costs, multipliers);
+    ParallelUpdateMultipliers(step_size, lagrangian_value, upper_bound,
+                              reduced_costs, &multipliers);
     lower_bound = std::max(lower_bound, lagrangian_value);
     // step_size should be updated like this. For the time besing, we keep the
     // step size, because the implementation of the rest is not adequate yet
@@ -40,11 +40,16 @@ namespace operations_research {
 // [4] Williamson, David P. 2002. “The Primal-Dual Method for Approximation
 // Algorithms.” Mathematical Programming, 91 (3): 447–78.
 // https://link.springer.com/article/10.1007/s101070100262
+//
+// The Parallel*() functions split the subsets and the elements into shards,
+// contiguous ranges balanced by their number of nonzeros, in the spirit of
+// pdlp/sharder.h. The shards only depend on the model, and the partial sums of
+// the shards are added in order, so the results do not depend on the number
+// of threads.
 
 class SetCoverLagrangian {
  public:
-  explicit SetCoverLagrangian(SetCoverInvariant* inv, int num_threads = 1)
-      : inv_(inv), model_(*inv->model()), num_threads_(num_threads) {}
+  explicit SetCoverLagrangian(SetCoverInvariant* inv, int num_threads = 1);
 
   // Returns true if a solution was found.
   // TODO(user): Add time-outs and exit with a partial solution. This seems
@@ -58,6 +63,10 @@ class SetCoverLagrangian {
   // Initializes the multipliers vector (u) based on the cost per subset.
   ElementCostVector InitializeLagrangeMultipliers() const;
 
+  // Same as above, but parallelized, using the number of threads specified in
+  // the constructor.
+  ElementCostVector ParallelInitializeLagrangeMultipliers() const;
+
   // Computes the Lagrangian (row-)cost vector.
   // For a subset j, c_j(u) = c_j - sum_{i \in I_j} u_i.
   // I_j denotes the indices of elements present in subset j.
@@ -78,7 +87,8 @@ class SetCoverLagrangian {
       const SubsetCostVector& reduced_costs) const;
 
   // Same as above, but parallelized, using the number of threads specified in
-  // the constructor.
+  // the constructor. Each shard of elements counts the subsets with a negative
+  // reduced cost in its rows.
   ElementCostVector ParallelComputeSubgradient(
       const SubsetCostVector& reduced_costs) const;
 
@@ -121,7 +131,8 @@ class SetCoverLagrangian {
   // Performs the three-phase algorithm.
   void ThreePhase(Cost upper_bound);
 
-  // Computes a lower bound on the optimal cost.
+  // Computes a lower bound on the optimal cost, with the parallel versions of
+  // the functions above.
   // The returned value is the lower bound, the reduced costs, and the
   // multipliers.
   std::tuple<Cost, SubsetCostVector, ElementCostVector> ComputeLowerBound(
@@ -137,6 +148,21 @@ class SetCoverLagrangian {
   // The number of threads to use for parallelization.
   int num_threads_;
 
+  // The shards of subsets and elements: shard i is [starts[i], starts[i+1]).
+  std::vector<SubsetIndex> subset_shard_starts_;
+  std::vector<ElementIndex> element_shard_starts_;
+
+  // The threads running the shards, or nullptr if num_threads_ <= 1.
+  std::unique_ptr<ThreadPool> thread_pool_;
+
+  int num_subset_shards() const { return subset_shard_starts_.size() - 1; }
+  int num_element_shards() const { return element_shard_starts_.size() - 1; }
+
+  // Calls f(shard) for all shards in [0, num_shards) on thread_pool_, and
+  // waits for all of them.
+  template <typename F>
+  void ParallelForEachShard(int num_shards, const F& f) const;
+
   // Total (scalar) Lagrangian cost.
   Cost lagrangian_;
 
@@ -275,8 +275,8 @@ class SetCoverModel {
   // On classical benchmarks, the fill rate is in the 2 to 5% range.
   // Some synthetic benchmarks have fill rates of 20%, while benchmarks for
   // rail rotations have a fill rate of 0.2 to 0.4%.
-  // TODO(user): try using a compressed representation like Protocol Buffers,
-  // since the data is only iterated upon.
+  // CompressedSetCoverModel in set_cover_compressed_model.h stores the
+  // columns in one to two bytes per nonzero, for read-only uses.
   SparseColumnView columns_;
 
   // Vector of rows. Each row corresponds to an element and contains the
@@ -11,16 +11,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdio>
 #include <limits>
 #include <string>
 
 #include "absl/log/check.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 #include "gtest/gtest.h"
 #include "ortools/algorithms/set_cover.pb.h"
+#include "ortools/algorithms/set_cover_compressed_model.h"
 #include "ortools/algorithms/set_cover_heuristics.h"
 #include "ortools/algorithms/set_cover_invariant.h"
+#include "ortools/algorithms/set_cover_lagrangian.h"
 #include "ortools/algorithms/set_cover_mip.h"
 #include "ortools/algorithms/set_cover_model.h"
 #include "ortools/base/gmock.h"
@@ -96,6 +101,66 @@ TEST(SolutionProtoTest, SaveReloadTwice) {
   EXPECT_TRUE(inv.CheckConsistency());
 }
 
+// Checks that compressed represents the same problem as model.
+void CheckSameModel(const CompressedSetCoverModel& compressed,
+                    SetCoverModel& model) {
+  ASSERT_EQ(compressed.num_subsets(), model.num_subsets());
+  EXPECT_EQ(compressed.num_elements(), model.num_elements());
+  EXPECT_EQ(compressed.num_nonzeros(), model.num_nonzeros());
+  for (const SubsetIndex subset : model.SubsetRange()) {
+    EXPECT_EQ(compressed.subset_cost(subset), model.subset_costs()[subset]);
+    SparseColumn column = model.columns()[subset];
+    std::sort(column.begin(), column.end());
+    EXPECT_EQ(compressed.column_size(subset),
+              static_cast<BaseInt>(column.size()));
+    EXPECT_THAT(compressed.column(subset),
+                ::testing::ElementsAreArray(column.begin(), column.end()));
+  }
+  model.CreateSparseRowView();
+  EXPECT_EQ(compressed.ComputeRowView(), model.rows());
+}
+
+TEST(CompressedSetCoverModelTest, CompressAndMapFile) {
+  SetCoverModel model = CreateKnightsCoverModel(30, 30);
+  const CompressedSetCoverModel compressed =
+      CompressedSetCoverModel::FromModel(model);
+  CheckSameModel(compressed, model);
+  // The knights cover has at most 9 elements per subset, close to each other.
+  EXPECT_LT(compressed.num_encoded_bytes(), 2 * model.num_nonzeros());
+
+  const std::string filename{std::tmpnam(nullptr)};
+  ASSERT_TRUE(compressed.WriteToFile(filename).ok());
+  absl::StatusOr<CompressedSetCoverModel> mapped =
+      CompressedSetCoverModel::MapFile(filename);
+  ASSERT_TRUE(mapped.ok()) << mapped.status();
+  CheckSameModel(*mapped, model);
+
+  // The heuristics work on the decompressed model.
+  SetCoverModel decompressed = mapped->ToModel();
+  SetCoverInvariant inv(&model);
+  SetCoverInvariant decompressed_inv(&decompressed);
+  GreedySolutionGenerator greedy(&inv);
+  CHECK(greedy.NextSolution());
+  GreedySolutionGenerator decompressed_greedy(&decompressed_inv);
+  CHECK(decompressed_greedy.NextSolution());
+  EXPECT_EQ(decompressed_inv.cost(), inv.cost());
+  std::remove(filename.c_str());
+}
+
+TEST(CompressedSetCoverModelTest, InvalidFile) {
+  const std::string filename{std::tmpnam(nullptr)};
+  CompressedSetCoverModel compressed;
+  compressed.AddSubset(1.0, {ElementIndex(3), ElementIndex(0)});
+  ASSERT_TRUE(compressed.WriteToFile(filename).ok());
+  ASSERT_TRUE(CompressedSetCoverModel::MapFile(filename).ok());
+  std::FILE* file = std::fopen(filename.c_str(), "ab");
+  std::fputc(0, file);
+  std::fclose(file);
+  EXPECT_FALSE(CompressedSetCoverModel::MapFile(filename).ok());
+  std::remove(filename.c_str());
+  EXPECT_FALSE(CompressedSetCoverModel::MapFile(filename).ok());
+}
+
 TEST(SetCoverTest, InitialValues) {
   SetCoverModel model;
   model.AddEmptySubset(1);
@@ -230,6 +295,83 @@ TEST(SetCoverTest, KnightsCoverGLS) {
   LOG(INFO) << "GuidedLocalSearch cost: " << inv.cost();
 }
 
+TEST(SetCoverTest, KnightsCoverMultiThreadedGreedyAndSteepest) {
+  SetCoverModel model = CreateKnightsCoverModel(SIZE, SIZE);
+  SetCoverInvariant inv(&model);
+  GreedySolutionGenerator greedy(&inv);
+  CHECK(greedy.NextSolution());
+  SteepestSearch steepest(&inv);
+  CHECK(steepest.NextSolution(100'000));
+  for (const int num_threads : {2, 4}) {
+    SetCoverInvariant parallel_inv(&model);
+    GreedySolutionGenerator parallel_greedy(&parallel_inv, num_threads);
+    CHECK(parallel_greedy.NextSolution());
+    SteepestSearch parallel_steepest(&parallel_inv, num_threads);
+    CHECK(parallel_steepest.NextSolution(100'000));
+    EXPECT_TRUE(parallel_inv.CheckConsistency());
+    EXPECT_EQ(parallel_inv.cost(), inv.cost());
+    EXPECT_EQ(parallel_inv.is_selected(), inv.is_selected());
+  }
+}
+
+TEST(SetCoverTest, KnightsCoverMultiThreadedDegree) {
+  SetCoverModel model = CreateKnightsCoverModel(SIZE, SIZE);
+  SetCoverInvariant inv(&model);
+  ElementDegreeSolutionGenerator degree(&inv);
+  CHECK(degree.NextSolution());
+  for (const int num_threads : {2, 4}) {
+    SetCoverInvariant parallel_inv(&model);
+    ElementDegreeSolutionGenerator parallel_degree(&parallel_inv, num_threads);
+    CHECK(parallel_degree.NextSolution());
+    EXPECT_TRUE(parallel_inv.CheckConsistency());
+    EXPECT_EQ(parallel_inv.cost(), inv.cost());
+    EXPECT_EQ(parallel_inv.is_selected(), inv.is_selected());
+  }
+}
+
+TEST(SetCoverTest, KnightsCoverParallelGLS) {
+  SetCoverModel model = CreateKnightsCoverModel(SIZE, SIZE);
+  SetCoverInvariant inv(&model);
+  GreedySolutionGenerator greedy(&inv);
+  CHECK(greedy.NextSolution());
+  const Cost greedy_cost = inv.cost();
+  SetCoverInvariant other_inv = inv;
+
+  ParallelGuidedLocalSearch gls(&inv, 4);
+  CHECK(gls.NextSolution(1'000));
+  LOG(INFO) << "ParallelGuidedLocalSearch cost: " << inv.cost();
+  EXPECT_TRUE(inv.CheckConsistency());
+  EXPECT_LE(inv.cost(), greedy_cost);
+
+  // The result only depends on the number of threads.
+  ParallelGuidedLocalSearch other_gls(&other_inv, 4);
+  CHECK(other_gls.NextSolution(1'000));
+  EXPECT_EQ(other_inv.is_selected(), inv.is_selected());
+}
+
+TEST(SetCoverTest, KnightsCoverLagrangianLowerBound) {
+  SetCoverModel model = CreateKnightsCoverModel(30, 30);
+  SetCoverInvariant inv(&model);
+  GreedySolutionGenerator greedy(&inv);
+  CHECK(greedy.NextSolution());
+  SetCoverLagrangian lagrangian(&inv);
+  const auto [lower_bound, reduced_costs, multipliers] =
+      lagrangian.ComputeLowerBound(model.subset_costs(), inv.cost());
+  LOG(INFO) << "Lagrangian lower bound: " << lower_bound;
+  EXPECT_GT(lower_bound, 0.0);
+  EXPECT_LE(lower_bound, inv.cost());
+
+  // The results do not depend on the number of threads.
+  SetCoverLagrangian parallel_lagrangian(&inv, /*num_threads=*/4);
+  const auto [parallel_lower_bound, parallel_reduced_costs,
+              parallel_multipliers] =
+      parallel_lagrangian.ComputeLowerBound(model.subset_costs(), inv.cost());
+  EXPECT_EQ(parallel_lower_bound, lower_bound);
+  EXPECT_EQ(parallel_multipliers, multipliers);
+  EXPECT_EQ(lagrangian.ComputeSubgradient(reduced_costs),
+            parallel_lagrangian.ParallelComputeSubgradient(reduced_costs));
+}
+
 TEST(SetCoverTest, KnightsCoverRandom) {
   SetCoverModel model = CreateKnightsCoverModel(SIZE, SIZE);
   EXPECT_TRUE(model.ComputeFeasibility());
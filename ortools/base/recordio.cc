@@ -15,9 +15,14 @@
 
 #include <zlib.h>
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
+#include <utility>
 
+#include "absl/synchronization/mutex.h"
 #include "ortools/base/logging.h"
 
 namespace recordio {
@@ -26,12 +31,102 @@ const int RecordWriter::kMagicNumber = 0x3ed7230a;
 RecordWriter::RecordWriter(File* const file)
     : file_(file), use_compression_(true) {}
 
-bool RecordWriter::Close() { return file_->Close(); }
+RecordWriter::~RecordWriter() { StopBackgroundThread(); }
+
+bool RecordWriter::Close() {
+  StopBackgroundThread();
+  bool write_failed;
+  {
+    absl::MutexLock lock(&mutex_);
+    write_failed = write_failed_;
+  }
+  return file_->Close() && !write_failed;
+}
 
 void RecordWriter::set_use_compression(bool use_compression) {
   use_compression_ = use_compression;
 }
 
+void RecordWriter::set_use_background_thread(bool use_background_thread) {
+  if (use_background_thread == (background_thread_ != nullptr)) return;
+  if (use_background_thread) {
+    background_thread_ =
+        std::make_unique<std::thread>(&RecordWriter::RunBackgroundWriter, this);
+  } else {
+    StopBackgroundThread();
+  }
+}
+
+bool RecordWriter::WriteRecord(std::string uncompressed_buffer) {
+  if (background_thread_ == nullptr) {
+    return WriteRecordToFile(uncompressed_buffer);
+  }
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(this, &RecordWriter::CanQueueRecord));
+  if (write_failed_) return false;
+  pending_records_.push_back(std::move(uncompressed_buffer));
+  return true;
+}
+
+bool RecordWriter::WriteRecordToFile(
+    const std::string& uncompressed_buffer) const {
+  const uint64_t uncompressed_size = uncompressed_buffer.size();
+  const std::string compressed_buffer =
+      use_compression_ ? Compress(uncompressed_buffer) : "";
+  const uint64_t compressed_size = compressed_buffer.size();
+  // The header is written with a single call.
+  char header[sizeof(kMagicNumber) + 2 * sizeof(uint64_t)];
+  std::memcpy(header, &kMagicNumber, sizeof(kMagicNumber));
+  std::memcpy(header + sizeof(kMagicNumber), &uncompressed_size,
+              sizeof(uncompressed_size));
+  std::memcpy(header + sizeof(kMagicNumber) + sizeof(uncompressed_size),
+              &compressed_size, sizeof(compressed_size));
+  if (file_->Write(header, sizeof(header)) != sizeof(header)) {
+    return false;
+  }
+  const std::string& payload =
+      use_compression_ ? compressed_buffer : uncompressed_buffer;
+  return file_->Write(payload.data(), payload.size()) == payload.size();
+}
+
+bool RecordWriter::CanQueueRecord() const {
+  return pending_records_.size() < kMaxPendingRecords || write_failed_;
+}
+
+bool RecordWriter::HasRecordOrIsStopping() const {
+  return !pending_records_.empty() || stopping_;
+}
+
+void RecordWriter::RunBackgroundWriter() {
+  for (;;) {
+    std::string record;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &RecordWriter::HasRecordOrIsStopping));
+      if (pending_records_.empty()) return;
+      record = std::move(pending_records_.front());
+      pending_records_.pop_front();
+    }
+    if (!WriteRecordToFile(record)) {
+      absl::MutexLock lock(&mutex_);
+      write_failed_ = true;
+      pending_records_.clear();
+    }
+  }
+}
+
+void RecordWriter::StopBackgroundThread() {
+  if (background_thread_ == nullptr) return;
+  {
+    absl::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  background_thread_->join();
+  background_thread_.reset();
+  absl::MutexLock lock(&mutex_);
+  stopping_ = false;
+}
+
 std::string RecordWriter::Compress(std::string const& s) const {
   const unsigned long source_size = s.size();  // NOLINT
   const char* source = s.c_str();
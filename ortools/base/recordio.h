@@ -14,9 +14,16 @@
 #ifndef OR_TOOLS_BASE_RECORDIO_H_
 #define OR_TOOLS_BASE_RECORDIO_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
+#include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "ortools/base/file.h"
 
 // This file defines some IO interfaces to compatible with Google
@@ -37,48 +44,51 @@ class RecordWriter {
 
   explicit RecordWriter(File* const file);
 
+  // Writes the pending records, if any. Does not close the file.
+  ~RecordWriter();
+
   template <class P>
   bool WriteProtocolMessage(const P& proto) {
     std::string uncompressed_buffer;
     proto.SerializeToString(&uncompressed_buffer);
-    const uint64_t uncompressed_size = uncompressed_buffer.size();
-    const std::string compressed_buffer =
-        use_compression_ ? Compress(uncompressed_buffer) : "";
-    const uint64_t compressed_size = compressed_buffer.size();
-    if (file_->Write(&kMagicNumber, sizeof(kMagicNumber)) !=
-        sizeof(kMagicNumber)) {
-      return false;
-    }
-    if (file_->Write(&uncompressed_size, sizeof(uncompressed_size)) !=
-        sizeof(uncompressed_size)) {
-      return false;
-    }
-    if (file_->Write(&compressed_size, sizeof(compressed_size)) !=
-        sizeof(compressed_size)) {
-      return false;
-    }
-    if (use_compression_) {
-      if (file_->Write(compressed_buffer.c_str(), compressed_size) !=
-          compressed_size) {
-        return false;
-      }
-    } else {
-      if (file_->Write(uncompressed_buffer.c_str(), uncompressed_size) !=
-          uncompressed_size) {
-        return false;
-      }
-    }
-    return true;
+    return WriteRecord(std::move(uncompressed_buffer));
   }
   // Closes the underlying file.
   bool Close();
 
   void set_use_compression(bool use_compression);
 
+  // When true, the records are compressed and written to the file by a
+  // background thread, and WriteProtocolMessage() only serializes the message
+  // and queues it. A write error is then reported by the next call to
+  // WriteProtocolMessage() or by Close(). WriteProtocolMessage() blocks when
+  // too many records are pending, to bound the memory usage.
+  //
+  // Must be called before the first record is written.
+  void set_use_background_thread(bool use_background_thread);
+
  private:
+  // The maximum number of records queued for the background thread.
+  static constexpr size_t kMaxPendingRecords = 1024;
+
+  bool WriteRecord(std::string uncompressed_buffer);
+  bool WriteRecordToFile(const std::string& uncompressed_buffer) const;
+  void RunBackgroundWriter();
+  // Waits for the background thread, if any, to write all the pending
+  // records and stops it.
+  void StopBackgroundThread();
+  bool CanQueueRecord() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  bool HasRecordOrIsStopping() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   std::string Compress(const std::string& input) const;
   File* const file_;
   bool use_compression_;
+
+  std::unique_ptr<std::thread> background_thread_;
+  absl::Mutex mutex_;
+  std::deque<std::string> pending_records_ ABSL_GUARDED_BY(mutex_);
+  bool stopping_ ABSL_GUARDED_BY(mutex_) = false;
+  bool write_failed_ ABSL_GUARDED_BY(mutex_) = false;
 };
 
 // This class reads a protocol buffer from a file.
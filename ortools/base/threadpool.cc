@@ -13,8 +13,15 @@
 
 #include "ortools/base/threadpool.h"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include <functional>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include "absl/log/check.h"
 #include "absl/strings/string_view.h"
@@ -52,10 +59,27 @@ void ThreadPool::SetQueueCapacity(int capacity) {
   queue_capacity_ = capacity;
 }
 
+void ThreadPool::SetWorkerCpuSets(std::vector<std::vector<int>> cpu_sets) {
+  CHECK(!started_);
+  worker_cpu_sets_ = std::move(cpu_sets);
+}
+
 void ThreadPool::StartWorkers() {
   started_ = true;
   for (int i = 0; i < num_workers_; ++i) {
     all_workers_.push_back(std::thread(&RunWorker, this));
+#if defined(__linux__)
+    if (!worker_cpu_sets_.empty()) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      for (const int cpu : worker_cpu_sets_[i % worker_cpu_sets_.size()]) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &cpu_set);
+      }
+      // This is just a hint for performance, so we ignore any failure.
+      pthread_setaffinity_np(all_workers_.back().native_handle(),
+                             sizeof(cpu_set_t), &cpu_set);
+    }
+#endif  // __linux__
   }
 }
 
@@ -63,7 +87,7 @@ std::function<void()> ThreadPool::GetNextTask() {
   std::unique_lock<std::mutex> lock(mutex_);
   for (;;) {
     if (!tasks_.empty()) {
-      std::function<void()> task = tasks_.front();
+      std::function<void()> task = std::move(tasks_.front());
       tasks_.pop_front();
       if (tasks_.size() < queue_capacity_ && waiting_for_capacity_) {
         waiting_for_capacity_ = false;
@@ -86,10 +110,11 @@ void ThreadPool::Schedule(std::function<void()> closure) {
     waiting_for_capacity_ = true;
     capacity_condition_.wait(lock);
   }
-  tasks_.push_back(closure);
+  tasks_.push_back(std::move(closure));
   if (started_) {
     lock.unlock();
-    condition_.notify_all();
+    // A single task was added, so a single idle worker needs to wake up.
+    condition_.notify_one();
   }
 }
 
@@ -15,8 +15,8 @@
 #define OR_TOOLS_BASE_THREADPOOL_H_
 
 #include <condition_variable>  // NOLINT
+#include <deque>
 #include <functional>
-#include <list>
 #include <mutex>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
@@ -36,9 +36,16 @@ class ThreadPool {
   std::function<void()> GetNextTask();
   void SetQueueCapacity(int capacity);
 
+  // Restricts the worker i to run on the cpus in cpu_sets[i % cpu_sets.size()].
+  // This must be called before StartWorkers(). This is only supported on Linux
+  // and is a no-op on other platforms.
+  void SetWorkerCpuSets(std::vector<std::vector<int>> cpu_sets);
+
  private:
   const int num_workers_;
-  std::list<std::function<void()>> tasks_;
+  // A deque rather than a list, so that scheduling a task does not allocate a
+  // node.
+  std::deque<std::function<void()>> tasks_;
   std::mutex mutex_;
   std::condition_variable condition_;
   std::condition_variable capacity_condition_;
@@ -46,6 +53,7 @@ class ThreadPool {
   bool waiting_for_capacity_ = false;
   bool started_ = false;
   int queue_capacity_ = 2e9;
+  std::vector<std::vector<int>> worker_cpu_sets_;
   std::vector<std::thread> all_workers_;
 };
 }  // namespace operations_research
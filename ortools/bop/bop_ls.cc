@@ -405,6 +405,23 @@ AssignmentAndConstraintFeasibilityMaintainer::PotentialOneFlipRepairs() {
   return tmp_potential_repairs_;
 }
 
+void AssignmentAndConstraintFeasibilityMaintainer::ComputeFlipScore(
+    VariableIndex var, int* num_repaired, int* num_broken) const {
+  *num_repaired = 0;
+  *num_broken = 0;
+  const bool new_value = !assignment_.Value(var);
+  for (const ConstraintEntry& entry : by_variable_matrix_[var]) {
+    const ConstraintIndex ct = entry.constraint;
+    const int64_t new_ct_value =
+        constraint_values_[ct] + (new_value ? entry.weight : -entry.weight);
+    const bool is_feasible = new_ct_value >= constraint_lower_bounds_[ct] &&
+                             new_ct_value <= constraint_upper_bounds_[ct];
+    if (is_feasible != ConstraintIsFeasible(ct)) {
+      ++(is_feasible ? *num_repaired : *num_broken);
+    }
+  }
+}
+
 std::string AssignmentAndConstraintFeasibilityMaintainer::DebugString() const {
   std::string str;
   str += "curr: ";
@@ -720,7 +737,8 @@ LocalSearchAssignmentIterator::LocalSearchAssignmentIterator(
       num_skipped_nodes_(0),
       num_improvements_(0),
       num_improvements_by_one_flip_repairs_(0),
-      num_inspected_one_flip_repairs_(0) {}
+      num_inspected_one_flip_repairs_(0),
+      num_filtered_one_flip_repairs_(0) {}
 
 LocalSearchAssignmentIterator::~LocalSearchAssignmentIterator() {
   VLOG(1) << "LS " << max_num_decisions_
@@ -728,7 +746,9 @@ LocalSearchAssignmentIterator::~LocalSearchAssignmentIterator() {
           << "\n  num improvements with one flip repairs: "
           << num_improvements_by_one_flip_repairs_
           << "\n  num inspected one flip repairs: "
-          << num_inspected_one_flip_repairs_;
+          << num_inspected_one_flip_repairs_
+          << "\n  num filtered one flip repairs: "
+          << num_filtered_one_flip_repairs_;
 }
 
 void LocalSearchAssignmentIterator::Synchronize(
@@ -807,6 +827,18 @@ bool LocalSearchAssignmentIterator::NextAssignment() {
       }
       ++num_inspected_one_flip_repairs_;
 
+      // Only the flips that repair all the infeasible constraints without
+      // breaking any other are worth the cost of a SAT propagation.
+      int num_repaired;
+      int num_broken;
+      maintainer_.ComputeFlipScore(VariableIndex(literal.Variable().value()),
+                                   &num_repaired, &num_broken);
+      if (num_broken > 0 ||
+          num_repaired < maintainer_.NumInfeasibleConstraints()) {
+        ++num_filtered_one_flip_repairs_;
+        continue;
+      }
+
       // Temporarily apply the potential repair and see if it worked!
       ApplyDecision(literal);
       if (maintainer_.IsFeasible()) {
@@ -332,6 +332,14 @@ class AssignmentAndConstraintFeasibilityMaintainer {
   // PotentialOneFlipRepairs() call.
   const std::vector<sat::Literal>& PotentialOneFlipRepairs();
 
+  // Computes the number of infeasible (resp. feasible) constraints, objective
+  // included, that become feasible (resp. infeasible) when only the given
+  // variable is flipped in the current assignment. This only looks at the
+  // maintained constraint values, so it is a lot cheaper than propagating the
+  // flip with the SAT solver and can be used to filter the candidate flips.
+  void ComputeFlipScore(VariableIndex var, int* num_repaired,
+                        int* num_broken) const;
+
   // Returns true if there is no infeasible constraint in the current state.
   bool IsFeasible() const { return infeasible_constraint_set_.size() == 0; }
 
@@ -663,10 +671,13 @@ class LocalSearchAssignmentIterator {
   int64_t num_skipped_nodes_;
 
   // The overall number of better solution found. And the ones found by the
-  // use_potential_one_flip_repairs_ heuristic.
+  // use_potential_one_flip_repairs_ heuristic. The filtered repairs are the
+  // inspected ones that were not propagated because their flip alone does not
+  // repair the problem.
   int64_t num_improvements_;
   int64_t num_improvements_by_one_flip_repairs_;
   int64_t num_inspected_one_flip_repairs_;
+  int64_t num_filtered_one_flip_repairs_;
 };
 
 }  // namespace bop
@@ -13,7 +13,11 @@
 
 #include "ortools/bop/bop_solver.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,6 +25,7 @@
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "google/protobuf/text_format.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/threadpool.h"
@@ -140,8 +145,100 @@ BopSolveStatus BopSolver::InternalMonothreadSolver(TimeLimit* time_limit) {
 
 BopSolveStatus BopSolver::InternalMultithreadSolver(TimeLimit* time_limit) {
   CHECK(time_limit != nullptr);
-  // Not implemented.
-  return BopSolveStatus::INVALID_PROBLEM;
+  const int num_solvers = parameters_.number_of_solvers();
+  const bool synchronize = parameters_.synchronization_type() !=
+                           BopParameters::NO_SYNCHRONIZATION;
+
+  // The problem_state_ is shared by all the solvers: each of them merges in it
+  // what it learned after each optimizer run and, when synchronization is
+  // enabled, imports back what the other solvers learned.
+  absl::Mutex mutex;
+  SharedTimeLimit shared_time_limit(time_limit);
+  std::atomic<bool> stop_search = false;
+
+  const auto run_solver = [&](int solver_index) {
+    BopParameters local_parameters = parameters_;
+    local_parameters.set_random_seed(parameters_.random_seed() + solver_index);
+    ProblemState local_state(problem_);
+    local_state.SetParameters(local_parameters);
+    int64_t last_shared_stamp;
+    {
+      absl::MutexLock mutex_lock(&mutex);
+      local_state.set_assignment_preference(
+          problem_state_.assignment_preference());
+      local_state.MergeLearnedInfo(problem_state_.GetLearnedInfo(),
+                                   BopOptimizerBase::CONTINUE);
+      last_shared_stamp = problem_state_.update_stamp();
+    }
+
+    const int set_index =
+        std::min(solver_index, parameters_.solver_optimizer_sets_size() - 1);
+    PortfolioOptimizer optimizer(
+        local_state, local_parameters,
+        parameters_.solver_optimizer_sets(set_index),
+        absl::StrFormat("Portfolio_%d", solver_index));
+    LearnedInfo learned_info(problem_);
+    TimeLimit local_time_limit;
+    local_time_limit.RegisterSecondaryExternalBooleanAsLimit(&stop_search);
+    while (true) {
+      // Note that this also accounts for the deterministic time spent by the
+      // other solvers.
+      shared_time_limit.UpdateLocalLimit(&local_time_limit);
+      if (local_time_limit.LimitReached()) break;
+
+      learned_info.Clear();
+      const BopOptimizerBase::Status optimization_status =
+          optimizer.Optimize(local_parameters, local_state, &learned_info,
+                             &local_time_limit);
+      shared_time_limit.AdvanceDeterministicTime(
+          local_time_limit.GetElapsedDeterministicTime());
+      local_state.MergeLearnedInfo(learned_info, optimization_status);
+
+      absl::MutexLock mutex_lock(&mutex);
+      const int64_t old_cost = problem_state_.solution().IsFeasible()
+                                   ? problem_state_.solution().GetCost()
+                                   : std::numeric_limits<int64_t>::max();
+      problem_state_.MergeLearnedInfo(learned_info, optimization_status);
+      if (problem_state_.solution().IsFeasible() &&
+          problem_state_.solution().GetCost() < old_cost) {
+        VLOG(1) << problem_state_.solution().GetScaledCost()
+                << "  New solution! (solver " << solver_index << ")";
+      }
+      if (problem_state_.IsOptimal() || problem_state_.IsInfeasible()) {
+        stop_search = true;
+        break;
+      }
+
+      // This solver cannot do anything more, but the others might.
+      if (optimization_status == BopOptimizerBase::ABORT) break;
+
+      // We only import the shared information when something changed since
+      // the last time, as this is not free on large problems.
+      if (synchronize && problem_state_.update_stamp() != last_shared_stamp) {
+        local_state.MergeLearnedInfo(problem_state_.GetLearnedInfo(),
+                                     BopOptimizerBase::CONTINUE);
+      }
+      last_shared_stamp = problem_state_.update_stamp();
+    }
+  };
+
+  {
+    ThreadPool pool("BopSolver", num_solvers);
+    pool.StartWorkers();
+    for (int i = 0; i < num_solvers; ++i) {
+      pool.Schedule([&run_solver, i]() { run_solver(i); });
+    }
+  }
+
+  if (problem_state_.IsOptimal()) {
+    CHECK(problem_state_.solution().IsFeasible());
+    return BopSolveStatus::OPTIMAL_SOLUTION_FOUND;
+  } else if (problem_state_.IsInfeasible()) {
+    return BopSolveStatus::INFEASIBLE_PROBLEM;
+  }
+  return problem_state_.solution().IsFeasible()
+             ? BopSolveStatus::FEASIBLE_SOLUTION_FOUND
+             : BopSolveStatus::NO_SOLUTION_FOUND;
 }
 
 BopSolveStatus BopSolver::Solve(const BopSolution& first_solution) {
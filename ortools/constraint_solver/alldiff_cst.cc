@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -27,6 +28,8 @@
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
+#include "ortools/graph/strongly_connected_components.h"
+#include "ortools/util/saturated_arithmetic.h"
 #include "ortools/util/string_array.h"
 
 namespace operations_research {
@@ -428,6 +431,220 @@ class BoundsAllDifferent : public BaseAllDifferent {
   RangeBipartiteMatching matching_;
 };
 
+//-----------------------------------------------------------------------------
+// DomainAllDifferent
+//
+// Domain-consistent all different, as described in "A filtering algorithm for
+// constraints of difference in CSPs", J-C. Regin, AAAI 1994.
+//
+// A maximum matching between variables and values is kept across propagations
+// and backtracks: domains only grow on backtrack, so the matching stays valid,
+// and after domain reductions only the variables that lost their matched value
+// are re-matched with augmenting paths. Values that belong to no maximum
+// matching are then removed using the strongly connected components of the
+// residual graph. Each propagation costs O(sum of domain sizes).
+//
+// Values are indexed by their offset to the smallest value of all domains,
+// this constraint should only be used when the union of the domains spans a
+// reasonable range.
+constexpr int64_t kDomainAllDifferentMaxValuesPerVariable = 64;
+
+class DomainAllDifferent : public BaseAllDifferent {
+ public:
+  DomainAllDifferent(Solver* const s, const std::vector<IntVar*>& vars,
+                     int64_t min_value, int64_t max_value)
+      : BaseAllDifferent(s, vars),
+        min_value_(min_value),
+        num_values_(max_value - min_value + 1),
+        var_to_value_(vars.size(), -1),
+        value_to_var_(num_values_, -1),
+        successors_(vars.size()),
+        var_visited_from_(vars.size(), -1),
+        value_visit_stamp_(num_values_, 0),
+        visit_stamp_(0),
+        residual_graph_(vars.size() + num_values_ + 1) {
+    iterators_.reserve(vars.size());
+    for (IntVar* const var : vars) {
+      iterators_.push_back(var->MakeDomainIterator(true));
+    }
+  }
+
+  ~DomainAllDifferent() override {}
+
+  void Post() override {
+    Demon* const domain = MakeDelayedConstraintDemon0(
+        solver(), this, &DomainAllDifferent::Propagate, "Propagate");
+    for (int i = 0; i < size(); ++i) {
+      vars_[i]->WhenDomain(domain);
+      Demon* const bound = MakeConstraintDemon1(
+          solver(), this, &DomainAllDifferent::PropagateValue,
+          "PropagateValue", i);
+      vars_[i]->WhenBound(bound);
+    }
+  }
+
+  void InitialPropagate() override {
+    for (int i = 0; i < size(); ++i) {
+      if (vars_[i]->Bound()) {
+        PropagateValue(i);
+      }
+    }
+    Propagate();
+  }
+
+  void Propagate() {
+    // Unmatch variables that lost their value, and re-match them.
+    for (int i = 0; i < size(); ++i) {
+      const int value = var_to_value_[i];
+      if (value != -1 && !vars_[i]->Contains(min_value_ + value)) {
+        value_to_var_[value] = -1;
+        var_to_value_[i] = -1;
+      }
+      successors_[i].clear();
+      for (const int64_t v : InitAndGetValues(iterators_[i])) {
+        successors_[i].push_back(v - min_value_);
+      }
+    }
+    for (int i = 0; i < size(); ++i) {
+      if (var_to_value_[i] == -1 && !MakeAugmentingPath(i)) {
+        solver()->Fail();
+      }
+    }
+    FilterDomains();
+  }
+
+  void PropagateValue(int index) {
+    const int64_t to_remove = vars_[index]->Value();
+    for (int j = 0; j < size(); j++) {
+      if (j != index) vars_[j]->RemoveValue(to_remove);
+    }
+  }
+
+  std::string DebugString() const override {
+    return DebugStringInternal("DomainAllDifferent");
+  }
+
+  void Accept(ModelVisitor* const visitor) const override {
+    visitor->BeginVisitConstraint(ModelVisitor::kAllDifferent, this);
+    visitor->VisitIntegerVariableArrayArgument(ModelVisitor::kVarsArgument,
+                                               vars_);
+    visitor->VisitIntegerArgument(ModelVisitor::kRangeArgument, 1);
+    visitor->EndVisitConstraint(ModelVisitor::kAllDifferent, this);
+  }
+
+ private:
+  // Looks for an augmenting path from the unmatched variable 'start' with a
+  // breadth-first search, and flips it if found.
+  bool MakeAugmentingPath(int start) {
+    ++visit_stamp_;
+    bfs_queue_.clear();
+    bfs_queue_.push_back(start);
+    var_visited_from_[start] = -1;
+    for (int head = 0; head < bfs_queue_.size(); ++head) {
+      const int var = bfs_queue_[head];
+      for (const int value : successors_[var]) {
+        if (value_visit_stamp_[value] == visit_stamp_) continue;
+        value_visit_stamp_[value] = visit_stamp_;
+        const int matched_var = value_to_var_[value];
+        if (matched_var == -1) {
+          int path_var = var;
+          int path_value = value;
+          while (path_var != -1) {
+            const int old_value = var_to_value_[path_var];
+            var_to_value_[path_var] = path_value;
+            value_to_var_[path_value] = path_var;
+            path_var = var_visited_from_[path_var];
+            path_value = old_value;
+          }
+          return true;
+        }
+        var_visited_from_[matched_var] = var;
+        bfs_queue_.push_back(matched_var);
+      }
+    }
+    return false;
+  }
+
+  // Removes the values which do not belong to the strongly connected component
+  // of their variable in the residual graph: variables point to their
+  // unmatched values, values to their matched variable. Free values point to a
+  // dummy node which points to all variables, as they can end alternating
+  // paths.
+  void FilterDomains() {
+    const int num_vars = size();
+    const int dummy_node = num_vars + num_values_;
+    for (int i = 0; i < num_vars; ++i) {
+      residual_graph_[i].clear();
+      for (const int value : successors_[i]) {
+        if (value != var_to_value_[i]) {
+          residual_graph_[i].push_back(num_vars + value);
+        }
+      }
+    }
+    residual_graph_[dummy_node].clear();
+    for (int value = 0; value < num_values_; ++value) {
+      std::vector<int>& value_successors = residual_graph_[num_vars + value];
+      value_successors.clear();
+      if (value_to_var_[value] != -1) {
+        value_successors.push_back(value_to_var_[value]);
+      } else {
+        value_successors.push_back(dummy_node);
+      }
+    }
+    for (int i = 0; i < num_vars; ++i) {
+      residual_graph_[dummy_node].push_back(i);
+    }
+
+    struct SccOutput {
+      explicit SccOutput(std::vector<int>* c) : components(c) {}
+      void emplace_back(int const* b, int const* e) {
+        for (int const* it = b; it < e; ++it) {
+          (*components)[*it] = num_components;
+        }
+        ++num_components;
+      }
+      int num_components = 0;
+      std::vector<int>* components;
+    };
+    component_.resize(residual_graph_.size());
+    SccOutput scc_output(&component_);
+    FindStronglyConnectedComponents(static_cast<int>(residual_graph_.size()),
+                                    residual_graph_, &scc_output);
+
+    for (int i = 0; i < num_vars; ++i) {
+      if (successors_[i].size() == 1) continue;
+      to_remove_.clear();
+      for (const int value : successors_[i]) {
+        if (value != var_to_value_[i] &&
+            component_[i] != component_[num_vars + value]) {
+          to_remove_.push_back(min_value_ + value);
+        }
+      }
+      if (!to_remove_.empty()) vars_[i]->RemoveValues(to_remove_);
+    }
+  }
+
+  const int64_t min_value_;
+  const int num_values_;
+  std::vector<IntVarIterator*> iterators_;
+  // The current matching; -1 means unmatched. Values are offsets to
+  // min_value_. The matching is not reversible, see above.
+  std::vector<int> var_to_value_;
+  std::vector<int> value_to_var_;
+  // Domains of the variables, as value offsets.
+  std::vector<std::vector<int>> successors_;
+  // Breadth-first search state of MakeAugmentingPath().
+  std::vector<int> bfs_queue_;
+  std::vector<int> var_visited_from_;
+  std::vector<int64_t> value_visit_stamp_;
+  int64_t visit_stamp_;
+  // Residual graph of FilterDomains(): variables, then values, then a dummy
+  // node.
+  std::vector<std::vector<int>> residual_graph_;
+  std::vector<int> component_;
+  std::vector<int64_t> to_remove_;
+};
+
 class SortConstraint : public Constraint {
  public:
   SortConstraint(Solver* const solver,
@@ -707,6 +924,21 @@ Constraint* Solver::MakeAllDifferent(const std::vector<IntVar*>& vars,
                            const_cast<IntVar* const>(vars[1]));
   } else {
     if (stronger_propagation) {
+      if (parameters_.use_all_different_domain_consistency()) {
+        int64_t min_value = std::numeric_limits<int64_t>::max();
+        int64_t max_value = std::numeric_limits<int64_t>::min();
+        for (IntVar* const var : vars) {
+          min_value = std::min(min_value, var->Min());
+          max_value = std::max(max_value, var->Max());
+        }
+        // The matching graph has one node per value in the range, which must
+        // not dominate the size of the domains.
+        if (CapSub(max_value, min_value) <
+            kDomainAllDifferentMaxValuesPerVariable * size) {
+          return RevAlloc(
+              new DomainAllDifferent(this, vars, min_value, max_value));
+        }
+      }
       return RevAlloc(new BoundsAllDifferent(this, vars));
     } else {
       return RevAlloc(new ValueAllDifferent(this, vars));
@@ -938,7 +938,7 @@ void Assignment::CopyIntersection(const Assignment* assignment) {
 }
 
 void Assignment::Copy(const Assignment* assignment) {
-  Clear();
+  // The containers clear themselves if needed.
   int_var_container_.Copy(assignment->int_var_container_);
   interval_var_container_.Copy(assignment->interval_var_container_);
   sequence_var_container_.Copy(assignment->sequence_var_container_);
@@ -58,6 +58,9 @@ ABSL_FLAG(bool, cp_disable_solve, false,
           "Force failure at the beginning of a search.");
 ABSL_FLAG(std::string, cp_profile_file, "",
           "Export profiling overview to file.");
+ABSL_FLAG(int, cp_profile_sampling_period, 1,
+          "Only time one demon run out of this number when profiling "
+          "propagation.");
 ABSL_FLAG(bool, cp_print_local_search_profile, false,
           "Print local search profiling data after solving.");
 ABSL_FLAG(bool, cp_name_variables, false, "Force all variables to have names.");
@@ -74,6 +77,10 @@ ABSL_FLAG(bool, cp_use_cumulative_time_table, true,
 ABSL_FLAG(bool, cp_use_cumulative_time_table_sync, false,
           "Use a synchronized O(n^2 log n) cumulative time table propagation "
           "algorithm.");
+ABSL_FLAG(bool, cp_use_cumulative_energetic_reasoning, false,
+          "Use the O(n^2 log n) cumulative energetic reasoning described in "
+          "'Satisfiability tests and time-bound adjustments for cumulative "
+          "scheduling problems' by Baptiste, Le Pape and Nuijten, 1999.");
 ABSL_FLAG(bool, cp_use_sequence_high_demand_tasks, true,
           "Use a sequence constraints for cumulative tasks that have a "
           "demand greater than half of the capacity of the resource.");
@@ -84,6 +91,10 @@ ABSL_FLAG(bool, cp_use_all_possible_disjunctions, true,
 ABSL_FLAG(int, cp_max_edge_finder_size, 50,
           "Do not post the edge finder in the cumulative constraints if "
           "it contains more than this number of tasks");
+ABSL_FLAG(bool, cp_use_all_different_domain_consistency, false,
+          "Use the matching-based domain-consistent propagation of the all "
+          "different constraint described in 'A filtering algorithm for "
+          "constraints of difference in CSPs' by J-C. Regin, AAAI 1994.");
 ABSL_FLAG(bool, cp_diffn_use_cumulative, true,
           "Diffn constraint adds redundant cumulative constraint");
 ABSL_FLAG(bool, cp_use_element_rmq, true,
@@ -137,6 +148,8 @@ ConstraintSolverParameters Solver::DefaultSolverParameters() {
   params.set_trace_search(absl::GetFlag(FLAGS_cp_trace_search));
   params.set_name_all_variables(absl::GetFlag(FLAGS_cp_name_variables));
   params.set_profile_file(absl::GetFlag(FLAGS_cp_profile_file));
+  params.set_profile_propagation_sampling_period(
+      absl::GetFlag(FLAGS_cp_profile_sampling_period));
   params.set_profile_local_search(
       absl::GetFlag(FLAGS_cp_print_local_search_profile));
   params.set_print_local_search_profile(
@@ -154,11 +167,15 @@ ConstraintSolverParameters Solver::DefaultSolverParameters() {
       absl::GetFlag(FLAGS_cp_use_cumulative_time_table));
   params.set_use_cumulative_time_table_sync(
       absl::GetFlag(FLAGS_cp_use_cumulative_time_table_sync));
+  params.set_use_cumulative_energetic_reasoning(
+      absl::GetFlag(FLAGS_cp_use_cumulative_energetic_reasoning));
   params.set_use_sequence_high_demand_tasks(
       absl::GetFlag(FLAGS_cp_use_sequence_high_demand_tasks));
   params.set_use_all_possible_disjunctions(
       absl::GetFlag(FLAGS_cp_use_all_possible_disjunctions));
   params.set_max_edge_finder_size(absl::GetFlag(FLAGS_cp_max_edge_finder_size));
+  params.set_use_all_different_domain_consistency(
+      absl::GetFlag(FLAGS_cp_use_all_different_domain_consistency));
   params.set_diffn_use_cumulative(absl::GetFlag(FLAGS_cp_diffn_use_cumulative));
   params.set_use_element_rmq(absl::GetFlag(FLAGS_cp_use_element_rmq));
   params.set_check_solution_period(
@@ -511,7 +528,10 @@ struct addrval {
  public:
   addrval() : address_(nullptr) {}
   explicit addrval(T* adr) : address_(adr), old_value_(*adr) {}
+  addrval(T* adr, T old_value) : address_(adr), old_value_(old_value) {}
   void restore() const { (*address_) = old_value_; }
+  T* address() const { return address_; }
+  const T& old_value() const { return old_value_; }
 
  private:
   T* address_;
@@ -605,6 +625,101 @@ class ZlibTrailPacker : public TrailPacker<T> {
   std::unique_ptr<char[]> tmp_block_;
 };
 
+// Packs the trail entries of a block one after the other, each address as the
+// varint-encoded difference with the previous address, and each integral value
+// as a varint. Consecutive entries of the trail often have close addresses and
+// small values, so this is much smaller than the raw block while being far
+// cheaper than zlib. Non-integral values (doubles, pointers) are stored as is.
+template <class T>
+class DeltaTrailPacker : public TrailPacker<T> {
+ public:
+  explicit DeltaTrailPacker(int block_size)
+      : TrailPacker<T>(block_size),
+        block_size_(block_size),
+        tmp_block_(new char[block_size * (kMaxVarintSize + kMaxValueSize)]) {}
+
+  // This type is neither copyable nor movable.
+  DeltaTrailPacker(const DeltaTrailPacker&) = delete;
+  DeltaTrailPacker& operator=(const DeltaTrailPacker&) = delete;
+
+  ~DeltaTrailPacker() override {}
+
+  void Pack(const addrval<T>* block, std::string* packed_block) override {
+    DCHECK(block != nullptr);
+    DCHECK(packed_block != nullptr);
+    char* out = tmp_block_.get();
+    uint64_t previous_address = 0;
+    for (int i = 0; i < block_size_; ++i) {
+      const uint64_t address =
+          reinterpret_cast<uintptr_t>(block[i].address());
+      out = WriteVarint(ZigZagEncode(address - previous_address), out);
+      previous_address = address;
+      if constexpr (std::is_integral_v<T>) {
+        out = WriteVarint(ZigZagEncode(block[i].old_value()), out);
+      } else {
+        memcpy(out, &block[i].old_value(), sizeof(T));
+        out += sizeof(T);
+      }
+    }
+    packed_block->assign(tmp_block_.get(), out - tmp_block_.get());
+  }
+
+  void Unpack(const std::string& packed_block, addrval<T>* block) override {
+    DCHECK(block != nullptr);
+    const char* in = packed_block.data();
+    uint64_t address = 0;
+    for (int i = 0; i < block_size_; ++i) {
+      address += ZigZagDecode(ReadVarint(&in));
+      T old_value;
+      if constexpr (std::is_integral_v<T>) {
+        old_value = static_cast<T>(ZigZagDecode(ReadVarint(&in)));
+      } else {
+        memcpy(&old_value, in, sizeof(T));
+        in += sizeof(T);
+      }
+      block[i] = addrval<T>(reinterpret_cast<T*>(address), old_value);
+    }
+    DCHECK_EQ(in, packed_block.data() + packed_block.size());
+  }
+
+ private:
+  static constexpr int kMaxVarintSize = 10;
+  static constexpr int kMaxValueSize =
+      std::max<int>(kMaxVarintSize, sizeof(T));
+
+  // Signed values (and address differences) are mapped to unsigned ones so
+  // that values of small magnitude have short varints.
+  static uint64_t ZigZagEncode(uint64_t value) {
+    return (value << 1) ^
+           static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+  }
+  static uint64_t ZigZagDecode(uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+  }
+  static char* WriteVarint(uint64_t value, char* out) {
+    while (value >= 0x80) {
+      *out++ = static_cast<char>(value | 0x80);
+      value >>= 7;
+    }
+    *out++ = static_cast<char>(value);
+    return out;
+  }
+  static uint64_t ReadVarint(const char** in) {
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      byte = static_cast<uint8_t>(*(*in)++);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+
+  const int block_size_;
+  std::unique_ptr<char[]> tmp_block_;
+};
+
 template <class T>
 class CompressedTrail {
  public:
@@ -628,6 +743,10 @@ class CompressedTrail {
         packer_.reset(new ZlibTrailPacker<T>(block_size));
         break;
       }
+      case ConstraintSolverParameters::COMPRESS_WITH_DELTA_ENCODING: {
+        packer_.reset(new DeltaTrailPacker<T>(block_size));
+        break;
+      }
       default: {
         LOG(ERROR) << "Should not be here";
       }
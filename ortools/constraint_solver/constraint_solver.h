@@ -96,6 +96,7 @@
 #include "ortools/base/map_util.h"
 #include "ortools/base/timer.h"
 #include "ortools/base/types.h"
+#include "ortools/constraint_solver/demon_profiler.pb.h"
 #include "ortools/constraint_solver/search_stats.pb.h"
 #include "ortools/constraint_solver/solver_parameters.pb.h"
 #include "ortools/util/piecewise_linear_function.h"
@@ -2994,6 +2995,14 @@ class Solver {
   /// set to true.
   void ExportProfilingOverview(const std::string& filename);
 
+#if !defined(SWIG)
+  /// Merges the propagation profiling information of the last search into
+  /// 'profile', which can accumulate the statistics of several solves. The
+  /// parameter profile_propagation used to create the solver must be set to
+  /// true.
+  void ExportPropagationProfile(PropagationProfile* profile) const;
+#endif  // !defined(SWIG)
+
   /// Returns local search profiling information in a human readable format.
   // TODO(user): Merge demon and local search profiles.
   std::string LocalSearchProfile() const;
@@ -5250,6 +5259,19 @@ class AssignmentContainer {
   /// Copies all the elements of 'container' to this container, clearing its
   /// previous content.
   void Copy(const AssignmentContainer<V, E>& container) {
+    /// When both containers have the same variables in the same order, which
+    /// is the case of the successive solutions of a search, the elements are
+    /// copied in place; this keeps the elements hash table valid instead of
+    /// rebuilding it on the next lookup.
+    const int size = container.elements_.size();
+    if (size == elements_.size()) {
+      int i = 0;
+      for (; i < size && elements_[i].Var() == container.elements_[i].Var();
+           ++i) {
+        elements_[i].Copy(container.elements_[i]);
+      }
+      if (i == size) return;
+    }
     Clear();
     for (int i = 0; i < container.elements_.size(); ++i) {
       const E& element = container.elements_[i];
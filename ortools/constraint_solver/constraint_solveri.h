@@ -3668,6 +3668,133 @@ class PathState::NodeRange {
   const int* const first_node_;
 };
 
+// Aggregates values of the nodes of the committed paths of a PathState, so that
+// filters can compute the aggregate of any chain in O(1) instead of iterating
+// on its nodes. The aggregation function must be associative, e.g. a sum, a
+// minimum or an interval intersection, but it does not need to be commutative
+// or to have an inverse: the nodes are aggregated in path order.
+//
+// This uses a disjoint sparse table over the nodes of the committed paths,
+// laid out path by path. For h >= 1, the layer h splits the layout into blocks
+// of size 2^h, and stores for each node of the first half of a block the
+// aggregate from the node to the middle of the block, and for each node of the
+// second half the aggregate from the middle of the block to the node. The
+// aggregate of the nodes at indices i < j is then made of the two values of
+// layer h = 1 + MostSignificantBitPosition32(i ^ j).
+// Like DimensionChecker, Commit() only appends the changed paths at the end of
+// the layout, and rebuilds the whole structure when it becomes too large.
+template <typename T>
+class ChainAggregator {
+ public:
+  // node_value(node) must return the value of the node, it is called on
+  // Commit() for all the nodes of the changed paths.
+  ChainAggregator(const PathState* path_state,
+                  std::function<T(int)> node_value,
+                  std::function<T(const T&, const T&)> combine)
+      : path_state_(path_state),
+        node_value_(std::move(node_value)),
+        combine_(std::move(combine)),
+        index_(path_state->NumNodes(), 0),
+        maximum_layer_size_(std::max(16, 4 * path_state->NumNodes())) {
+    FullCommit();
+  }
+
+  // Returns the aggregate of the values of the nodes of chain, which must be
+  // a chain of the committed state, e.g. as returned by
+  // PathState::Chains().
+  T Aggregate(const PathState::Chain& chain) const {
+    const int first_index = index_[chain.First()];
+    const int last_index = index_[chain.Last()];
+    DCHECK_LE(first_index, last_index);
+    if (first_index == last_index) return layers_[0][first_index];
+    const int layer =
+        1 + MostSignificantBitPosition32(first_index ^ last_index);
+    return combine_(layers_[layer][first_index], layers_[layer][last_index]);
+  }
+
+  // Commits to the changes made in PathState, must be called before
+  // PathState::Commit().
+  void Commit() {
+    int change_size = 0;
+    for (const int path : path_state_->ChangedPaths()) {
+      for (const PathState::Chain chain : path_state_->Chains(path)) {
+        change_size += chain.NumNodes();
+      }
+    }
+    if (static_cast<int>(layers_[0].size()) + change_size >
+        maximum_layer_size_) {
+      FullCommit();
+    } else {
+      for (const int path : path_state_->ChangedPaths()) AppendPath(path);
+    }
+  }
+
+ private:
+  void FullCommit() {
+    for (std::vector<T>& layer : layers_) layer.clear();
+    for (int path = 0; path < path_state_->NumPaths(); ++path) {
+      AppendPath(path);
+    }
+  }
+
+  // Appends the nodes of path at the end of the layout, and computes their
+  // values in all layers.
+  void AppendPath(int path) {
+    if (layers_.empty()) layers_.emplace_back();
+    const int begin = layers_[0].size();
+    for (const int node : path_state_->Nodes(path)) {
+      index_[node] = layers_[0].size();
+      layers_[0].push_back(node_value_(node));
+    }
+    const int end = layers_[0].size();
+    if (end - begin <= 1) return;
+    // The queries on this path only use the layers up to this one.
+    const int max_layer = 1 + MostSignificantBitPosition32(begin ^ (end - 1));
+    if (layers_.size() <= max_layer) layers_.resize(max_layer + 1);
+    const std::vector<T>& values = layers_[0];
+    for (int h = 1; h <= max_layer; ++h) {
+      // The values of the previous paths in this layer are kept as is, and the
+      // values of this path only aggregate values of this path. The values of
+      // the nodes after begin which a query on this path can not use are not
+      // meaningful.
+      std::vector<T>& layer = layers_[h];
+      layer.resize(end, values[begin]);
+      const int half_size = 1 << (h - 1);
+      for (int block_start = (begin >> h) << h; block_start < end;
+           block_start += 2 * half_size) {
+        const int middle = block_start + half_size;
+        const int left_begin = std::max(block_start, begin);
+        const int left_end = std::min(middle, end);
+        if (left_begin < left_end) {
+          layer[left_end - 1] = values[left_end - 1];
+          for (int i = left_end - 2; i >= left_begin; --i) {
+            layer[i] = combine_(values[i], layer[i + 1]);
+          }
+        }
+        const int right_begin = std::max(middle, begin);
+        const int right_end = std::min(middle + half_size, end);
+        if (right_begin < right_end) {
+          layer[right_begin] = values[right_begin];
+          for (int i = right_begin + 1; i < right_end; ++i) {
+            layer[i] = combine_(layer[i - 1], values[i]);
+          }
+        }
+      }
+    }
+  }
+
+  const PathState* const path_state_;
+  const std::function<T(int)> node_value_;
+  const std::function<T(const T&, const T&)> combine_;
+  // Maps the nodes of the committed paths to their index in the layout.
+  std::vector<int> index_;
+  // layers_[0] contains the values of the nodes, layers_[h] for h >= 1 the
+  // aggregates of layer h described in the class comment.
+  std::vector<std::vector<T>> layers_;
+  // The size of the layout above which Commit() rebuilds the structure.
+  const int maximum_layer_size_;
+};
+
 // This checker enforces dimension requirements.
 // A dimension requires that there is some valuation of
 // cumul and demand such that for all paths:
@@ -56,6 +56,10 @@ class DemonProfiler : public PropagationMonitor {
       : PropagationMonitor(solver),
         active_constraint_(nullptr),
         active_demon_(nullptr),
+        active_demon_timed_(false),
+        sampling_period_(
+            std::max(1, solver->const_parameters()
+                            .profile_propagation_sampling_period())),
         start_time_ns_(absl::GetCurrentTimeNanos()) {}
 
   ~DemonProfiler() override {
@@ -153,9 +157,19 @@ class DemonProfiler : public PropagationMonitor {
     }
     CHECK(active_demon_ == nullptr);
     active_demon_ = demon;
+    active_demon_timed_ = false;
     DemonRuns* const demon_run = demon_map_[active_demon_];
     if (demon_run != nullptr) {
-      demon_run->add_start_time(CurrentTime());
+      // Only time one run out of sampling_period_: reading the clock twice per
+      // run dominates the cost of profiling.
+      const int64_t runs =
+          demon_run->start_time_size() + demon_run->unsampled_runs();
+      if (runs % sampling_period_ == 0) {
+        active_demon_timed_ = true;
+        demon_run->add_start_time(CurrentTime());
+      } else {
+        demon_run->set_unsampled_runs(demon_run->unsampled_runs() + 1);
+      }
     }
   }
 
@@ -165,9 +179,8 @@ class DemonProfiler : public PropagationMonitor {
       return;
     }
     CHECK_EQ(active_demon_, demon);
-    DemonRuns* const demon_run = demon_map_[active_demon_];
-    if (demon_run != nullptr) {
-      demon_run->add_end_time(CurrentTime());
+    if (active_demon_timed_) {
+      demon_map_[active_demon_]->add_end_time(CurrentTime());
     }
     active_demon_ = nullptr;
   }
@@ -181,7 +194,7 @@ class DemonProfiler : public PropagationMonitor {
     if (active_demon_ != nullptr) {
       DemonRuns* const demon_run = demon_map_[active_demon_];
       if (demon_run != nullptr) {
-        demon_run->add_end_time(CurrentTime());
+        if (active_demon_timed_) demon_run->add_end_time(CurrentTime());
         demon_run->set_failures(demon_run->failures() + 1);
       }
       active_demon_ = nullptr;
@@ -354,16 +367,28 @@ class DemonProfiler : public PropagationMonitor {
       const DemonRuns& demon_runs = ct_run->demons(demon_index);
       *fails += demon_runs.failures();
       CHECK_EQ(demon_runs.start_time_size(), demon_runs.end_time_size());
-      const int runs = demon_runs.start_time_size();
-      *demon_invocations += runs;
-      for (int run_index = 0; run_index < runs; ++run_index) {
-        const int64_t demon_time =
-            demon_runs.end_time(run_index) - demon_runs.start_time(run_index);
-        *total_demon_runtime += demon_time;
-      }
+      *demon_invocations +=
+          demon_runs.start_time_size() + demon_runs.unsampled_runs();
+      *total_demon_runtime += EstimatedRuntime(demon_runs);
     }
   }
 
+  // Returns the total runtime of the demon, extrapolating the runtime of the
+  // runs that were not timed from the timed ones.
+  static int64_t EstimatedRuntime(const DemonRuns& demon_runs) {
+    const int timed_runs = demon_runs.start_time_size();
+    if (timed_runs == 0) return 0;
+    int64_t runtime = 0;
+    for (int run_index = 0; run_index < timed_runs; ++run_index) {
+      runtime +=
+          demon_runs.end_time(run_index) - demon_runs.start_time(run_index);
+    }
+    if (demon_runs.unsampled_runs() == 0) return runtime;
+    return static_cast<int64_t>(static_cast<double>(runtime) *
+                                (timed_runs + demon_runs.unsampled_runs()) /
+                                timed_runs);
+  }
+
   void ExportInformation(const DemonRuns* const demon_runs,
                          int64_t* const demon_invocations, int64_t* const fails,
                          int64_t* const total_demon_runtime,
@@ -374,22 +399,24 @@ class DemonProfiler : public PropagationMonitor {
     CHECK_EQ(demon_runs->start_time_size(), demon_runs->end_time_size());
 
     const int runs = demon_runs->start_time_size();
-    *demon_invocations = runs;
+    *demon_invocations = runs + demon_runs->unsampled_runs();
     *fails = demon_runs->failures();
     *total_demon_runtime = 0;
     *mean_demon_runtime = 0.0;
     *median_demon_runtime = 0.0;
     *stddev_demon_runtime = 0.0;
     std::vector<double> runtimes;
+    int64_t timed_runtime = 0;
     for (int run_index = 0; run_index < runs; ++run_index) {
       const int64_t demon_time =
           demon_runs->end_time(run_index) - demon_runs->start_time(run_index);
-      *total_demon_runtime += demon_time;
+      timed_runtime += demon_time;
       runtimes.push_back(demon_time);
     }
-    // Compute mean.
+    *total_demon_runtime = EstimatedRuntime(*demon_runs);
+    // Compute mean, median and standard deviation on the timed runs.
     if (!runtimes.empty()) {
-      *mean_demon_runtime = (1.0L * *total_demon_runtime) / runtimes.size();
+      *mean_demon_runtime = (1.0L * timed_runtime) / runtimes.size();
 
       // Compute median.
       std::sort(runtimes.begin(), runtimes.end());
@@ -415,6 +442,49 @@ class DemonProfiler : public PropagationMonitor {
     }
   }
 
+  // Merges the collected data into 'profile', matching constraints by their
+  // debug string.
+  void ExportPropagationProfile(PropagationProfile* const profile) {
+    profile->set_model_name(solver()->model_name());
+    profile->set_num_solves(profile->num_solves() + 1);
+    absl::flat_hash_map<std::string, ConstraintProfile*> profile_by_id;
+    for (ConstraintProfile& constraint_profile :
+         *profile->mutable_constraints()) {
+      profile_by_id[constraint_profile.constraint_id()] = &constraint_profile;
+    }
+    for (const auto& [ct, ct_run] : constraint_map_) {
+      ConstraintProfile*& constraint_profile =
+          profile_by_id[ct_run->constraint_id()];
+      if (constraint_profile == nullptr) {
+        constraint_profile = profile->add_constraints();
+        constraint_profile->set_constraint_id(ct_run->constraint_id());
+      }
+      int64_t fails = 0;
+      int64_t demon_invocations = 0;
+      int64_t initial_propagation_runtime = 0;
+      int64_t total_demon_runtime = 0;
+      int demon_count = 0;
+      ExportInformation(ct, &fails, &initial_propagation_runtime,
+                        &demon_invocations, &total_demon_runtime,
+                        &demon_count);
+      int64_t timed_demon_invocations = 0;
+      for (const DemonRuns& demon_runs : ct_run->demons()) {
+        timed_demon_invocations += demon_runs.start_time_size();
+      }
+      constraint_profile->set_failures(constraint_profile->failures() + fails);
+      constraint_profile->set_initial_propagation_runtime(
+          constraint_profile->initial_propagation_runtime() +
+          initial_propagation_runtime);
+      constraint_profile->set_demon_invocations(
+          constraint_profile->demon_invocations() + demon_invocations);
+      constraint_profile->set_timed_demon_invocations(
+          constraint_profile->timed_demon_invocations() +
+          timed_demon_invocations);
+      constraint_profile->set_demon_runtime(
+          constraint_profile->demon_runtime() + total_demon_runtime);
+    }
+  }
+
   // The demon_profiler is added by default on the main propagation
   // monitor.  It just needs to be added to the search monitors at the
   // start of the search.
@@ -425,6 +495,10 @@ class DemonProfiler : public PropagationMonitor {
  private:
   Constraint* active_constraint_;
   Demon* active_demon_;
+  // Whether the run of active_demon_ is being timed.
+  bool active_demon_timed_;
+  // Only one demon run out of sampling_period_ is timed.
+  const int sampling_period_;
   const int64_t start_time_ns_;
   absl::flat_hash_map<const Constraint*, ConstraintRuns*> constraint_map_;
   absl::flat_hash_map<const Demon*, DemonRuns*> demon_map_;
@@ -438,6 +512,12 @@ void Solver::ExportProfilingOverview(const std::string& filename) {
   }
 }
 
+void Solver::ExportPropagationProfile(PropagationProfile* profile) const {
+  if (demon_profiler_ != nullptr) {
+    demon_profiler_->ExportPropagationProfile(profile);
+  }
+}
+
 // ----- Exported Functions -----
 
 void InstallDemonProfiler(DemonProfiler* monitor) { monitor->Install(); }
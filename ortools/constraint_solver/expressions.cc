@@ -253,6 +253,9 @@ class DomainIntVar : public IntVar {
     virtual bool Contains(int64_t val) const = 0;
     virtual bool SetValue(int64_t val) = 0;
     virtual bool RemoveValue(int64_t val) = 0;
+    // Removes all values in [l, u], which must be within the initial bounds
+    // of the bitset. Returns false if no value was removed.
+    virtual bool RemoveInterval(int64_t l, int64_t u) = 0;
     virtual uint64_t Size() const = 0;
     virtual void DelayRemoveValue(int64_t val) = 0;
     virtual void ApplyRemovedValues(DomainIntVar* var) = 0;
@@ -1729,6 +1732,39 @@ class SimpleBitSet : public DomainIntVar::BitSet {
     AddHole(val);
     return true;
   }
+
+  bool RemoveInterval(int64_t l, int64_t u) override {
+    DCHECK_GE(l, omin_);
+    DCHECK_LE(u, omax_);
+    DCHECK_LE(l, u);
+    const int64_t l_offset = l - omin_;
+    const int64_t u_offset = u - omin_;
+    const int first_word = BitOffset64(l_offset);
+    const int last_word = BitOffset64(u_offset);
+    const uint64_t current_stamp = solver_->stamp();
+    int64_t num_removed = 0;
+    for (int word = first_word; word <= last_word; ++word) {
+      const uint64_t mask =
+          OneRange64(word == first_word ? BitPos64(l_offset) : 0,
+                     word == last_word ? BitPos64(u_offset) : 63);
+      const uint64_t removed = bits_[word] & mask;
+      if (removed == 0) continue;
+      if (stamps_[word] < current_stamp) {
+        stamps_[word] = current_stamp;
+        solver_->SaveValue(&bits_[word]);
+      }
+      bits_[word] &= ~removed;
+      if (num_removed == 0) InitHoles();
+      num_removed += BitCount64(removed);
+      for (uint64_t bits = removed; bits != 0; bits &= bits - 1) {
+        AddHole(omin_ + word * 64 + LeastSignificantBitPosition64(bits));
+      }
+    }
+    if (num_removed == 0) return false;
+    size_.Add(solver_, -num_removed);
+    return true;
+  }
+
   uint64_t Size() const override { return size_.Value(); }
 
   std::string DebugString() const override {
@@ -1940,6 +1976,26 @@ class SmallBitSet : public DomainIntVar::BitSet {
     }
   }
 
+  bool RemoveInterval(int64_t l, int64_t u) override {
+    DCHECK_GE(l, omin_);
+    DCHECK_LE(u, omax_);
+    DCHECK_LE(l, u);
+    const uint64_t removed = bits_ & OneRange64(l - omin_, u - omin_);
+    if (removed == 0) return false;
+    const uint64_t current_stamp = solver_->stamp();
+    if (stamp_ < current_stamp) {
+      stamp_ = current_stamp;
+      solver_->SaveValue(&bits_);
+    }
+    bits_ &= ~removed;
+    size_.Add(solver_, -static_cast<int64_t>(BitCount64(removed)));
+    InitHoles();
+    for (uint64_t bits = removed; bits != 0; bits &= bits - 1) {
+      AddHole(omin_ + LeastSignificantBitPosition64(bits));
+    }
+    return true;
+  }
+
   uint64_t Size() const override { return size_.Value(); }
 
   std::string DebugString() const override {
@@ -2391,10 +2447,19 @@ void DomainIntVar::RemoveInterval(int64_t l, int64_t u) {
     SetMin(u + 1);
   } else if (u >= max_.Value()) {
     SetMax(l - 1);
-  } else {
+  } else if (in_process_) {
     for (int64_t v = l; v <= u; ++v) {
       RemoveValue(v);
     }
+  } else if (l <= u) {
+    // Removes the whole interval at once with word operations on the bitset,
+    // and wakes up the variable once instead of once per value.
+    if (bits_ == nullptr) {
+      CreateBits();
+    }
+    if (bits_->RemoveInterval(l, u)) {
+      Push();
+    }
   }
 }
 
@@ -4310,7 +4310,8 @@ class LocalSearchProfiler : public LocalSearchMonitor {
     for (const LocalSearchOperator* const op : operators) {
       const OperatorStats& stats = gtl::FindOrDie(operator_stats_, op);
       callback(op->DebugString(), stats.neighbors, stats.filtered_neighbors,
-               stats.accepted_neighbors, stats.seconds);
+               stats.accepted_neighbors, stats.seconds,
+               stats.make_next_neighbor_seconds);
     }
   }
 
@@ -4350,7 +4351,8 @@ class LocalSearchProfiler : public LocalSearchMonitor {
                                            int64_t num_neighbors,
                                            int64_t num_filtered_neighbors,
                                            int64_t num_accepted_neighbors,
-                                           double duration_seconds) {
+                                           double duration_seconds,
+                                           double make_next_neighbor_seconds) {
       LocalSearchStatistics::LocalSearchOperatorStatistics* const
           local_search_operator_statistics =
               statistics_proto.add_local_search_operator_statistics();
@@ -4361,6 +4363,8 @@ class LocalSearchProfiler : public LocalSearchMonitor {
       local_search_operator_statistics->set_num_accepted_neighbors(
           num_accepted_neighbors);
       local_search_operator_statistics->set_duration_seconds(duration_seconds);
+      local_search_operator_statistics->set_make_next_neighbor_duration_seconds(
+          make_next_neighbor_seconds);
     });
     ParseLocalSearchFilterStatistics([&statistics_proto](
                                          const std::string& context,
@@ -4406,34 +4410,39 @@ class LocalSearchProfiler : public LocalSearchMonitor {
     max_name_size = 0;
     ParseLocalSearchOperatorStatistics([&max_name_size](absl::string_view name,
                                                         int64_t, int64_t,
-                                                        int64_t, double) {
+                                                        int64_t, double,
+                                                        double) {
       max_name_size = std::max(max_name_size, name.length());
     });
     if (max_name_size > 0) {
       absl::StrAppendFormat(
           &overview,
           "Local search operator statistics:\n%*s | Neighbors | Filtered "
-          "| Accepted | Time (s)\n",
+          "| Accepted | Time (s) | Make next neighbor (s)\n",
           max_name_size, "");
       OperatorStats total_stats;
       ParseLocalSearchOperatorStatistics(
           [&overview, &total_stats, max_name_size](
               absl::string_view name, int64_t num_neighbors,
               int64_t num_filtered_neighbors, int64_t num_accepted_neighbors,
-              double duration_seconds) {
+              double duration_seconds, double make_next_neighbor_seconds) {
             absl::StrAppendFormat(
-                &overview, "%*s | %9ld | %8ld | %8ld | %7.2g\n", max_name_size,
-                name, num_neighbors, num_filtered_neighbors,
-                num_accepted_neighbors, duration_seconds);
+                &overview, "%*s | %9ld | %8ld | %8ld | %7.2g  | %7.2g\n",
+                max_name_size, name, num_neighbors, num_filtered_neighbors,
+                num_accepted_neighbors, duration_seconds,
+                make_next_neighbor_seconds);
             total_stats.neighbors += num_neighbors;
             total_stats.filtered_neighbors += num_filtered_neighbors;
             total_stats.accepted_neighbors += num_accepted_neighbors;
             total_stats.seconds += duration_seconds;
+            total_stats.make_next_neighbor_seconds +=
+                make_next_neighbor_seconds;
           });
       absl::StrAppendFormat(
-          &overview, "%*s | %9ld | %8ld | %8ld | %7.2g\n", max_name_size,
-          "Total", total_stats.neighbors, total_stats.filtered_neighbors,
-          total_stats.accepted_neighbors, total_stats.seconds);
+          &overview, "%*s | %9ld | %8ld | %8ld | %7.2g  | %7.2g\n",
+          max_name_size, "Total", total_stats.neighbors,
+          total_stats.filtered_neighbors, total_stats.accepted_neighbors,
+          total_stats.seconds, total_stats.make_next_neighbor_seconds);
     }
     max_name_size = 0;
     ParseLocalSearchFilterStatistics(
@@ -4489,9 +4498,13 @@ class LocalSearchProfiler : public LocalSearchMonitor {
       UpdateTime();
       last_operator_ = op->Self();
     }
+    make_next_neighbor_timer_.Start();
   }
   void EndMakeNextNeighbor(const LocalSearchOperator* op, bool neighbor_found,
                            const Assignment*, const Assignment*) override {
+    make_next_neighbor_timer_.Stop();
+    operator_stats_[op->Self()].make_next_neighbor_seconds +=
+        make_next_neighbor_timer_.Get();
     if (neighbor_found) {
       operator_stats_[op->Self()].neighbors++;
     }
@@ -4544,7 +4557,11 @@ class LocalSearchProfiler : public LocalSearchMonitor {
     int64_t neighbors = 0;
     int64_t filtered_neighbors = 0;
     int64_t accepted_neighbors = 0;
+    // Total time spent on the operator, including filtering and accepting
+    // its neighbors.
     double seconds = 0;
+    // Time spent in the MakeNextNeighbor() calls of the operator.
+    double make_next_neighbor_seconds = 0;
   };
 
   struct FilterStats {
@@ -4555,6 +4572,7 @@ class LocalSearchProfiler : public LocalSearchMonitor {
   };
   WallTimer timer_;
   WallTimer filter_timer_;
+  WallTimer make_next_neighbor_timer_;
   const LocalSearchOperator* last_operator_ = nullptr;
   absl::flat_hash_map<const LocalSearchOperator*, OperatorStats>
       operator_stats_;
@@ -2188,6 +2188,190 @@ class TimeTableSync : public Constraint {
   int64_t prev_gap_;
 };
 
+// Energetic reasoning for the cumulative constraint, as described in
+// "Satisfiability tests and time-bound adjustments for cumulative scheduling
+// problems", P. Baptiste, C. Le Pape and W. Nuijten, Annals of Operations
+// Research 92, 1999.
+//
+// The minimal energy a task must spend in a time window [t1, t2) is
+//   demand * max(0, min(t2 - t1, duration, end_min - t1, t2 - start_max)).
+// If the sum of these energies exceeds capacity * (t2 - t1), the constraint
+// fails. If a task started at its start min would spend more energy in the
+// window than what the other tasks leave available, its start min is pushed.
+//
+// For a fixed t1, the total minimal energy is piecewise linear in t2, with
+// breakpoints at max(t1, start_max) and max(t1, start_max) + min(duration,
+// end_min - t1) for each task. Sweeping these breakpoints in order checks all
+// the windows starting at t1 in O(n log n); windows start at the start mins and
+// start maxes of the tasks, hence O(n^2 log n) per propagation. Start mins are
+// only adjusted on the window of least slack found for each t1, which costs
+// O(n) per t1.
+//
+// This propagator is one-sided and not incremental, like EdgeFinder.
+template <class Task>
+class EnergeticReasoning : public Constraint {
+ public:
+  EnergeticReasoning(Solver* const solver, const std::vector<Task*>& tasks,
+                     IntVar* const capacity)
+      : Constraint(solver), capacity_(capacity), tasks_(tasks) {}
+
+  // This type is neither copyable nor movable.
+  EnergeticReasoning(const EnergeticReasoning&) = delete;
+  EnergeticReasoning& operator=(const EnergeticReasoning&) = delete;
+
+  ~EnergeticReasoning() override { gtl::STLDeleteElements(&tasks_); }
+
+  void Post() override {
+    Demon* const demon = MakeDelayedConstraintDemon0(
+        solver(), this, &EnergeticReasoning::InitialPropagate, "RangeChanged");
+    for (Task* const task : tasks_) {
+      task->WhenAnything(demon);
+    }
+    capacity_->WhenRange(demon);
+  }
+
+  void InitialPropagate() override {
+    const int64_t capacity = capacity_->Max();
+    window_starts_.clear();
+    for (const Task* const task : tasks_) {
+      if (task->DemandMin() == 0) continue;
+      window_starts_.push_back(task->interval->StartMin());
+      if (HasStartMax(*task)) {
+        window_starts_.push_back(task->interval->StartMax());
+      }
+    }
+    gtl::STLSortAndRemoveDuplicates(&window_starts_);
+    start_min_update_.clear();
+    for (const int64_t window_start : window_starts_) {
+      const int64_t window_end = CheckWindowsStartingAt(window_start, capacity);
+      if (window_end > window_start) {
+        AdjustStartMins(window_start, window_end, capacity);
+      }
+    }
+    for (const std::pair<IntervalVar*, int64_t>& update : start_min_update_) {
+      update.first->SetStartMin(update.second);
+    }
+  }
+
+  void Accept(ModelVisitor* const visitor) const override {
+    LOG(FATAL) << "Should Not Be Visited";
+  }
+
+  std::string DebugString() const override { return "EnergeticReasoning"; }
+
+ private:
+  // Optional tasks are wrapped in relaxed-max intervals: they have no start
+  // max, and no mandatory energy.
+  static bool HasStartMax(const Task& task) {
+    return task.interval->StartMax() < IntervalVar::kMaxValidValue;
+  }
+
+  // Minimal energy spent by the task in [window_start, window_end).
+  static int64_t MinimalEnergy(const Task& task, int64_t window_start,
+                               int64_t window_end) {
+    if (!HasStartMax(task)) return 0;
+    const IntervalVar* const interval = task.interval;
+    const int64_t length = std::min(
+        {CapSub(window_end, window_start), interval->DurationMin(),
+         CapSub(interval->EndMin(), window_start),
+         CapSub(window_end, interval->StartMax())});
+    return length > 0 ? CapProd(task.DemandMin(), length) : 0;
+  }
+
+  // Checks all windows starting at window_start for overload, and returns the
+  // end of the window with least slack, or window_start if no task has
+  // mandatory energy after window_start.
+  int64_t CheckWindowsStartingAt(int64_t window_start, int64_t capacity) {
+    // Slope changes of the total minimal energy, as a function of the window
+    // end.
+    slope_deltas_.clear();
+    for (const Task* const task : tasks_) {
+      const int64_t demand = task->DemandMin();
+      if (demand == 0 || !HasStartMax(*task)) continue;
+      const IntervalVar* const interval = task->interval;
+      const int64_t length =
+          std::min(interval->DurationMin(),
+                   CapSub(interval->EndMin(), window_start));
+      if (length <= 0) continue;
+      const int64_t ramp_start = std::max(window_start, interval->StartMax());
+      slope_deltas_.push_back({ramp_start, demand});
+      slope_deltas_.push_back({CapAdd(ramp_start, length), -demand});
+    }
+    std::sort(slope_deltas_.begin(), slope_deltas_.end());
+    int64_t energy = 0;
+    int64_t slope = 0;
+    int64_t time = window_start;
+    int64_t best_window_end = window_start;
+    int64_t best_slack = std::numeric_limits<int64_t>::max();
+    for (int i = 0; i < slope_deltas_.size();) {
+      const int64_t next_time = slope_deltas_[i].first;
+      energy = CapAdd(energy, CapProd(slope, CapSub(next_time, time)));
+      time = next_time;
+      for (; i < slope_deltas_.size() && slope_deltas_[i].first == time; ++i) {
+        slope += slope_deltas_[i].second;
+      }
+      if (time == window_start) continue;
+      const int64_t slack =
+          CapSub(CapProd(capacity, CapSub(time, window_start)), energy);
+      if (slack < 0) solver()->Fail();
+      if (slack < best_slack) {
+        best_slack = slack;
+        best_window_end = time;
+      }
+    }
+    return best_window_end;
+  }
+
+  // Pushes the start min of the tasks that cannot start at their start min
+  // given the energy required by the other tasks in the window.
+  void AdjustStartMins(int64_t window_start, int64_t window_end,
+                       int64_t capacity) {
+    const int64_t window_length = CapSub(window_end, window_start);
+    int64_t energy = 0;
+    for (const Task* const task : tasks_) {
+      energy = CapAdd(energy, MinimalEnergy(*task, window_start, window_end));
+    }
+    const int64_t slack = CapSub(CapProd(capacity, window_length), energy);
+    DCHECK_GE(slack, 0);
+    for (Task* const task : tasks_) {
+      const int64_t demand = task->DemandMin();
+      const IntervalVar* const interval = task->interval;
+      if (demand == 0 || interval->StartMin() >= window_end) continue;
+      // Energy spent in the window when the task starts at its start min.
+      const int64_t left_shift_length =
+          std::min({window_length, interval->DurationMin(),
+                    CapSub(CapAdd(interval->StartMin(),
+                                  interval->DurationMin()),
+                           window_start)});
+      if (left_shift_length <= 0) continue;
+      const int64_t available =
+          CapAdd(slack, MinimalEnergy(*task, window_start, window_end));
+      if (CapProd(demand, left_shift_length) <= available) continue;
+      // The task can use at most available / demand units of the window: it
+      // must overlap the end of the window by at most that much.
+      const int64_t new_start_min = CapSub(window_end, available / demand);
+      if (new_start_min > interval->StartMin()) {
+        start_min_update_.push_back({task->interval, new_start_min});
+      }
+    }
+  }
+
+  // Capacity of the cumulative resource.
+  IntVar* const capacity_;
+
+  // Tasks sharing the resource; owned by this constraint.
+  std::vector<Task*> tasks_;
+
+  // Candidate window starts, sorted and without duplicates.
+  std::vector<int64_t> window_starts_;
+
+  // (time, slope delta) pairs used by CheckWindowsStartingAt.
+  std::vector<std::pair<int64_t, int64_t>> slope_deltas_;
+
+  // Stack of updates to the new start min to do.
+  std::vector<std::pair<IntervalVar*, int64_t>> start_min_update_;
+};
+
 class CumulativeConstraint : public Constraint {
  public:
   CumulativeConstraint(Solver* const s,
@@ -2226,6 +2410,10 @@ class CumulativeConstraint : public Constraint {
       PostOneSidedConstraint(false, true, false);
       PostOneSidedConstraint(true, true, false);
     }
+    if (params.use_cumulative_energetic_reasoning()) {
+      PostOneSidedEnergeticReasoning(false);
+      PostOneSidedEnergeticReasoning(true);
+    }
     if (params.use_sequence_high_demand_tasks()) {
       PostHighDemandSequenceConstraint();
     }
@@ -2371,6 +2559,17 @@ class CumulativeConstraint : public Constraint {
     }
   }
 
+  // Post a straight or mirrored energetic reasoning, if needed
+  void PostOneSidedEnergeticReasoning(bool mirror) {
+    std::vector<CumulativeTask*> useful_tasks;
+    PopulateVectorUsefulTasks(mirror, &useful_tasks);
+    if (!useful_tasks.empty()) {
+      Solver* const s = solver();
+      s->AddConstraint(s->RevAlloc(
+          new EnergeticReasoning<CumulativeTask>(s, useful_tasks, capacity_)));
+    }
+  }
+
   // Capacity of the cumulative resource
   IntVar* const capacity_;
 
@@ -2419,6 +2618,10 @@ class VariableDemandCumulativeConstraint : public Constraint {
       PostOneSidedConstraint(false, true, false);
       PostOneSidedConstraint(true, true, false);
     }
+    if (params.use_cumulative_energetic_reasoning()) {
+      PostOneSidedEnergeticReasoning(false);
+      PostOneSidedEnergeticReasoning(true);
+    }
     if (params.use_sequence_high_demand_tasks()) {
       PostHighDemandSequenceConstraint();
     }
@@ -2563,6 +2766,18 @@ class VariableDemandCumulativeConstraint : public Constraint {
     }
   }
 
+  // Post a straight or mirrored energetic reasoning, if needed
+  void PostOneSidedEnergeticReasoning(bool mirror) {
+    std::vector<VariableCumulativeTask*> useful_tasks;
+    PopulateVectorUsefulTasks(mirror, &useful_tasks);
+    if (!useful_tasks.empty()) {
+      Solver* const s = solver();
+      s->AddConstraint(
+          s->RevAlloc(new EnergeticReasoning<VariableCumulativeTask>(
+              s, useful_tasks, capacity_)));
+    }
+  }
+
   // Capacity of the cumulative resource
   IntVar* const capacity_;
 
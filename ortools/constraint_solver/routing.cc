@@ -56,6 +56,7 @@
 #include "ortools/base/protoutil.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/constraint_solveri.h"
@@ -183,6 +184,8 @@ const Assignment* RoutingModel::PackCumulsOfOptimizerDimensionsFromAssignment(
 
   std::vector<DecisionBuilder*> decision_builders;
   decision_builders.push_back(solver_->MakeRestoreAssignment(preassignment_));
+  decision_builders.push_back(
+      solver_->MakeRestoreAssignment(next_searches_restrictions_));
   decision_builders.push_back(
       solver_->MakeRestoreAssignment(packed_assignment));
   for (auto& [lp_optimizer, mp_optimizer] : local_dimension_optimizers_) {
@@ -466,6 +469,7 @@ void RoutingModel::Initialize() {
   cost_cache_.clear();
   cost_cache_.resize(size + vehicles_, {kUnassigned, CostClassIndex(-1), 0});
   preassignment_ = solver_->MakeAssignment();
+  next_searches_restrictions_ = solver_->MakeAssignment();
 }
 
 RoutingModel::~RoutingModel() {
@@ -537,20 +541,77 @@ int RoutingModel::RegisterTransitMatrix(
       sign);
 }
 
+int RoutingModel::RegisterSparseTransitMatrix(
+    std::vector<std::vector<int64_t> /*needed_for_swig*/> neighbors,
+    std::vector<std::vector<int64_t> /*needed_for_swig*/> values,
+    TransitCallback2 fallback_callback, TransitEvaluatorSign sign) {
+  CHECK_EQ(neighbors.size(), values.size());
+  CHECK_LE(neighbors.size(), manager_.num_nodes());
+  // The arcs are stored by tail node, sorted by head node: the arcs of a node
+  // are in [arc_starts[node], arc_starts[node + 1]).
+  std::vector<int64_t> arc_starts(manager_.num_nodes() + 1, 0);
+  for (int node = 0; node < neighbors.size(); ++node) {
+    CHECK_EQ(neighbors[node].size(), values[node].size());
+    arc_starts[node + 1] = neighbors[node].size();
+  }
+  std::partial_sum(arc_starts.begin(), arc_starts.end(), arc_starts.begin());
+  std::vector<int> arc_heads(arc_starts.back());
+  std::vector<int64_t> arc_values(arc_starts.back());
+  std::vector<std::pair<int, int64_t>> sorted_arcs;
+  for (int node = 0; node < neighbors.size(); ++node) {
+    sorted_arcs.clear();
+    for (int k = 0; k < neighbors[node].size(); ++k) {
+      DCHECK_GE(neighbors[node][k], 0);
+      DCHECK_LT(neighbors[node][k], manager_.num_nodes());
+      sorted_arcs.push_back({neighbors[node][k], values[node][k]});
+    }
+    std::sort(sorted_arcs.begin(), sorted_arcs.end());
+    for (int k = 0; k < sorted_arcs.size(); ++k) {
+      DCHECK(k == 0 || sorted_arcs[k - 1].first < sorted_arcs[k].first)
+          << "Duplicate neighbor " << sorted_arcs[k].first << " of " << node;
+      arc_heads[arc_starts[node] + k] = sorted_arcs[k].first;
+      arc_values[arc_starts[node] + k] = sorted_arcs[k].second;
+    }
+    // Frees the memory as we go, the input can be large.
+    neighbors[node] = {};
+    values[node] = {};
+  }
+  return RegisterTransitCallback(
+      [this, arc_starts = std::move(arc_starts),
+       arc_heads = std::move(arc_heads), arc_values = std::move(arc_values),
+       fallback_callback = std::move(fallback_callback)](int64_t i,
+                                                         int64_t j) {
+        const int tail = manager_.IndexToNode(i).value();
+        const int head = manager_.IndexToNode(j).value();
+        const auto begin = arc_heads.begin() + arc_starts[tail];
+        const auto end = arc_heads.begin() + arc_starts[tail + 1];
+        const auto it = std::lower_bound(begin, end, head);
+        if (it != end && *it == head) {
+          return arc_values[it - arc_heads.begin()];
+        }
+        return fallback_callback(i, j);
+      },
+      sign);
+}
+
 int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
                                           TransitEvaluatorSign sign) {
   if (cache_callbacks_) {
     TransitEvaluatorSign actual_sign = sign;
-    const int size = Size() + vehicles();
+    const int64_t size = Size() + vehicles();
     std::vector<int64_t> cache(size * size, 0);
     bool all_transits_geq_zero = true;
     bool all_transits_leq_zero = true;
+    bool all_transits_fit_in_int32 = true;
     for (int i = 0; i < size; ++i) {
       for (int j = 0; j < size; ++j) {
         const int64_t value = callback(i, j);
         cache[i * size + j] = value;
         all_transits_geq_zero &= value >= 0;
         all_transits_leq_zero &= value <= 0;
+        all_transits_fit_in_int32 &=
+            value >= std::numeric_limits<int32_t>::min() &&
+            value <= std::numeric_limits<int32_t>::max();
       }
     }
     actual_sign =
@@ -558,10 +619,20 @@ int RoutingModel::RegisterTransitCallback(TransitCallback2 callback,
             ? kTransitEvaluatorSignPositiveOrZero
             : (all_transits_leq_zero ? kTransitEvaluatorSignNegativeOrZero
                                      : kTransitEvaluatorSignUnknown);
-    transit_evaluators_.push_back(
-        [cache = std::move(cache), size](int64_t i, int64_t j) {
-          return cache[i * size + j];
-        });
+    if (all_transits_fit_in_int32) {
+      // The filters read the cache at random positions, so halving its size
+      // makes more of it fit in the CPU caches.
+      std::vector<int32_t> int32_cache(cache.begin(), cache.end());
+      transit_evaluators_.push_back(
+          [cache = std::move(int32_cache), size](int64_t i, int64_t j) {
+            return static_cast<int64_t>(cache[i * size + j]);
+          });
+    } else {
+      transit_evaluators_.push_back(
+          [cache = std::move(cache), size](int64_t i, int64_t j) {
+            return cache[i * size + j];
+          });
+    }
     DCHECK(sign == kTransitEvaluatorSignUnknown || actual_sign == sign);
   } else {
     transit_evaluators_.push_back(std::move(callback));
@@ -904,6 +975,35 @@ LocalDimensionCumulOptimizer* RoutingModel::GetMutableLocalCumulMPOptimizer(
              : local_dimension_optimizers_[optimizer_index].mp_optimizer.get();
 }
 
+LocalSearchStatistics RoutingModel::GetLocalSearchStatistics() const {
+  LocalSearchStatistics statistics = solver_->GetLocalSearchStatistics();
+  // The LP and MP optimizers of a dimension are reported together.
+  const auto add_statistics = [&statistics](bool global,
+                                            const auto& lp_optimizer,
+                                            const auto& mp_optimizer) {
+    const int64_t num_solves = lp_optimizer->optimizer_core().num_solves() +
+                               mp_optimizer->optimizer_core().num_solves();
+    if (num_solves == 0) return;
+    LocalSearchStatistics::DimensionCumulOptimizerStatistics* const
+        optimizer_statistics =
+            statistics.add_dimension_cumul_optimizer_statistics();
+    optimizer_statistics->set_dimension(lp_optimizer->dimension()->name());
+    optimizer_statistics->set_global(global);
+    optimizer_statistics->set_num_solves(num_solves);
+    optimizer_statistics->set_duration_seconds(
+        absl::ToDoubleSeconds(lp_optimizer->optimizer_core().solve_duration() +
+                              mp_optimizer->optimizer_core().solve_duration()));
+  };
+  for (const auto& [lp_optimizer, mp_optimizer] :
+       global_dimension_optimizers_) {
+    add_statistics(/*global=*/true, lp_optimizer, mp_optimizer);
+  }
+  for (const auto& [lp_optimizer, mp_optimizer] : local_dimension_optimizers_) {
+    add_statistics(/*global=*/false, lp_optimizer, mp_optimizer);
+  }
+  return statistics;
+}
+
 int RoutingModel::GetLocalCumulOptimizerIndex(
     const RoutingDimension& dimension) const {
   DCHECK(closed_);
@@ -1363,8 +1463,8 @@ struct VehicleClass {
   /// dimension_evaluators[d]->Run(from, to) is the transit value of arc
   /// from->to for a dimension d.
   util_intops::StrongVector<DimensionIndex, int64_t> dimension_evaluator_classes;
-  /// Hash of the visitability of (non-start/end) nodes.
-  uint64_t visitable_nodes_hash;
+  /// Hash of the (non-start/end) nodes the vehicle cannot visit.
+  uint64_t unvisitable_nodes_hash;
   /// Hash of allowed resources for each resource group, or -1 if a given
   /// resource group isn't required by the vehicle.
   std::vector<int64_t> group_allowed_resources_hash;
@@ -1381,7 +1481,7 @@ struct VehicleClass {
            c1.dimension_end_cumuls_max == c2.dimension_end_cumuls_max &&
            c1.dimension_capacities == c2.dimension_capacities &&
            c1.dimension_evaluator_classes == c2.dimension_evaluator_classes &&
-           c1.visitable_nodes_hash == c2.visitable_nodes_hash &&
+           c1.unvisitable_nodes_hash == c2.unvisitable_nodes_hash &&
            c1.group_allowed_resources_hash == c2.group_allowed_resources_hash;
 }
   template <typename H>
@@ -1391,7 +1491,7 @@ struct VehicleClass {
                       c.end_equivalence_class, c.dimension_start_cumuls_min,
                       c.dimension_start_cumuls_max, c.dimension_end_cumuls_min,
                       c.dimension_end_cumuls_max, c.dimension_capacities,
-                      c.dimension_evaluator_classes, c.visitable_nodes_hash,
+                      c.dimension_evaluator_classes, c.unvisitable_nodes_hash,
                       c.group_allowed_resources_hash);
   }
 };
@@ -1401,7 +1501,23 @@ struct VehicleClass {
 void RoutingModel::ComputeVehicleClasses() {
   vehicle_class_index_of_vehicle_.assign(vehicles_, VehicleClassIndex(-1));
   absl::flat_hash_map<VehicleClass, VehicleClassIndex> vehicle_class_map;
-  std::vector<bool> node_is_visitable(Size(), true);
+  // Most nodes can usually be visited by all vehicles, we only look at the
+  // others for each vehicle instead of scanning all nodes.
+  std::vector<int> restricted_nodes;
+  for (int index = 0; index < Size(); ++index) {
+    DCHECK(!IsEnd(index));
+    if (IsStart(index)) continue;
+    const IntVar* const vehicle_var = vehicle_vars_[index];
+    const bool has_all_vehicles =
+        vehicle_var->Min() <= 0 && vehicle_var->Max() >= vehicles_ - 1 &&
+        vehicle_var->Size() ==
+            static_cast<uint64_t>(vehicle_var->Max() - vehicle_var->Min() + 1);
+    if (!has_all_vehicles || !allowed_vehicles_[index].empty()) {
+      restricted_nodes.push_back(index);
+    }
+  }
+  std::vector<int> unvisitable_nodes;
+  const auto int_vec_hash = absl::Hash<std::vector<int>>();
   const auto bool_vec_hash = absl::Hash<std::vector<bool>>();
   for (int vehicle = 0; vehicle < vehicles(); ++vehicle) {
     VehicleClass vehicle_class;
@@ -1426,16 +1542,14 @@ void RoutingModel::ComputeVehicleClasses() {
       vehicle_class.dimension_evaluator_classes.push_back(
           dimension->vehicle_to_class(vehicle));
     }
-    node_is_visitable.assign(Size(), true);
-    for (int index = 0; index < Size(); ++index) {
-      DCHECK(!IsEnd(index));
-      if (IsStart(index)) continue;
+    unvisitable_nodes.clear();
+    for (const int index : restricted_nodes) {
       if (!vehicle_vars_[index]->Contains(vehicle) ||
           !IsVehicleAllowedForIndex(vehicle, index)) {
-        node_is_visitable[index] = false;
+        unvisitable_nodes.push_back(index);
       }
     }
-    vehicle_class.visitable_nodes_hash = bool_vec_hash(node_is_visitable);
+    vehicle_class.unvisitable_nodes_hash = int_vec_hash(unvisitable_nodes);
 
     std::vector<int64_t>& allowed_resources_hash =
         vehicle_class.group_allowed_resources_hash;
@@ -2166,6 +2280,39 @@ absl::Duration GetTimeLimit(const RoutingSearchParameters& parameters) {
   if (!parameters.has_time_limit()) return absl::InfiniteDuration();
   return util_time::DecodeGoogleApiProto(parameters.time_limit()).value();
 }
+
+// Returns the maximal intervals of consecutive values among the given values.
+std::vector<ClosedInterval> GetConsecutiveValueIntervals(
+    std::vector<int64_t> values) {
+  absl::c_sort(values);
+  std::vector<ClosedInterval> intervals;
+  for (const int64_t value : values) {
+    if (!intervals.empty() && intervals.back().end >= value - 1) {
+      intervals.back().end = value;
+    } else {
+      intervals.push_back({value, value});
+    }
+  }
+  return intervals;
+}
+
+// Removes the values of the intervals from the domain of the variable, except
+// for kept_value.
+void RemoveIntervalsExceptValue(absl::Span<const ClosedInterval> intervals,
+                                int64_t kept_value, IntVar* var) {
+  for (const ClosedInterval& interval : intervals) {
+    if (interval.start <= kept_value && kept_value <= interval.end) {
+      if (interval.start < kept_value) {
+        var->RemoveInterval(interval.start, kept_value - 1);
+      }
+      if (kept_value < interval.end) {
+        var->RemoveInterval(kept_value + 1, interval.end);
+      }
+    } else {
+      var->RemoveInterval(interval.start, interval.end);
+    }
+  }
+}
 }  // namespace
 
 void RoutingModel::CloseModelWithParameters(
@@ -2283,11 +2430,17 @@ void RoutingModel::CloseModelWithParameters(
     }
   }
 
-  // Reduce domain of next variables.
+  // Reduce domain of next variables. The starts and ends are removed by
+  // intervals of consecutive indices: with a RoutingIndexManager there are only
+  // a few of them, whereas removing the values one by one is quadratic in the
+  // number of vehicles.
+  const std::vector<ClosedInterval> start_intervals =
+      GetConsecutiveValueIntervals(paths_metadata_.Starts());
   for (int i = 0; i < size; ++i) {
     // No variable can point back to a start.
-    solver_->AddConstraint(MakeDifferentFromValues(solver_.get(), nexts_[i],
-                                                   paths_metadata_.Starts()));
+    for (const ClosedInterval& interval : start_intervals) {
+      nexts_[i]->RemoveInterval(interval.start, interval.end);
+    }
     // Extra constraint to state an active node can't point to itself.
     solver_->AddConstraint(
         solver_->MakeIsDifferentCstCt(nexts_[i], i, active_[i]));
@@ -2306,16 +2459,10 @@ void RoutingModel::CloseModelWithParameters(
   }
 
   // Associate first and "logical" last nodes
+  const std::vector<ClosedInterval> end_intervals =
+      GetConsecutiveValueIntervals(paths_metadata_.Ends());
   for (int i = 0; i < vehicles_; ++i) {
-    std::vector<int64_t> forbidden_ends;
-    forbidden_ends.reserve(vehicles_ - 1);
-    for (int j = 0; j < vehicles_; ++j) {
-      if (i != j) {
-        forbidden_ends.push_back(End(j));
-      }
-    }
-    solver_->AddConstraint(MakeDifferentFromValues(
-        solver_.get(), nexts_[Start(i)], std::move(forbidden_ends)));
+    RemoveIntervalsExceptValue(end_intervals, End(i), nexts_[Start(i)]);
   }
 
   // Constraining is_bound_to_end_ variables.
@@ -3441,6 +3588,44 @@ bool RoutingModel::ApplyLocksToAllVehicles(
   return RoutesToAssignment(locks, true, close_routes, preassignment_);
 }
 
+void RoutingModel::DeactivateIndexInNextSearches(int64_t index) {
+  CHECK_LT(index, Size());
+  CHECK(!IsStart(index)) << "Vehicle starts can't be deactivated";
+  next_searches_restrictions_->Add(ActiveVar(index))->SetValue(0);
+}
+
+void RoutingModel::SetCumulVarRangeInNextSearches(
+    const RoutingDimension& dimension, int64_t index, int64_t min,
+    int64_t max) {
+  CHECK_EQ(dimension.model(), this);
+  CHECK_LE(min, max);
+  next_searches_restrictions_->Add(dimension.CumulVar(index))
+      ->SetRange(min, max);
+}
+
+bool RoutingModel::IsIndexDeactivatedInNextSearches(int64_t index) const {
+  IntVar* const active_var = ActiveVar(index);
+  return next_searches_restrictions_->Contains(active_var) &&
+         next_searches_restrictions_->Max(active_var) == 0;
+}
+
+bool RoutingModel::RemoveIndicesDeactivatedInNextSearches(
+    const Assignment& assignment, Assignment* restricted_assignment) const {
+  CHECK(restricted_assignment != nullptr);
+  std::vector<std::vector<int64_t>> routes;
+  AssignmentToRoutes(assignment, &routes);
+  for (std::vector<int64_t>& route : routes) {
+    route.erase(std::remove_if(route.begin(), route.end(),
+                               [this](int64_t index) {
+                                 return IsIndexDeactivatedInNextSearches(index);
+                               }),
+                route.end());
+  }
+  restricted_assignment->Clear();
+  return RoutesToAssignment(routes, /*ignore_inactive_indices=*/false,
+                            /*close_routes=*/true, restricted_assignment);
+}
+
 int64_t RoutingModel::GetNumberOfDecisionsInFirstSolution(
     const RoutingSearchParameters& parameters) const {
   IntVarFilteredDecisionBuilder* const decision_builder =
@@ -4934,9 +5119,11 @@ void RoutingModel::StoreDimensionCumulOptimizers(
       global_optimizer_index_[dim] = global_dimension_optimizers_.size();
       global_dimension_optimizers_.push_back(
           {std::make_unique<GlobalDimensionCumulOptimizer>(
-               dimension, parameters.continuous_scheduling_solver()),
+               dimension, parameters.continuous_scheduling_solver(),
+               parameters.global_scheduling_num_workers()),
            std::make_unique<GlobalDimensionCumulOptimizer>(
-               dimension, parameters.mixed_integer_scheduling_solver())});
+               dimension, parameters.mixed_integer_scheduling_solver(),
+               parameters.global_scheduling_num_workers())});
       if (!AllTransitsPositive(*dimension)) {
         dimension->SetOffsetForGlobalOptimizer(0);
       } else {
@@ -5606,7 +5793,9 @@ void RoutingModel::SetupDecisionBuilders(
   }
   CHECK(preassignment_ != nullptr);
   DecisionBuilder* restore_preassignment =
-      solver_->MakeRestoreAssignment(preassignment_);
+      solver_->Compose(solver_->MakeRestoreAssignment(preassignment_),
+                       solver_->MakeRestoreAssignment(
+                           next_searches_restrictions_));
   solve_db_ = solver_->Compose(restore_preassignment, solve_db_);
 
   improve_db_ =
@@ -6930,4 +7119,81 @@ void RoutingDimension::SetupSlackAndDependentTransitCosts() const {
   }
 }
 
+namespace {
+// Solves each model with the search parameters of the same index, starting
+// from the assignment of the same index if it is not null, and returns the
+// solutions.
+std::vector<const Assignment*> SolveModelsFromAssignmentsInParallel(
+    absl::Span<RoutingModel* const> models,
+    absl::Span<const RoutingSearchParameters> search_parameters,
+    absl::Span<const Assignment* const> assignments, int num_threads) {
+  std::vector<const Assignment*> solutions(models.size(), nullptr);
+  ThreadPool pool(std::clamp<int>(models.size(), 1, num_threads));
+  pool.StartWorkers();
+  for (int i = 0; i < models.size(); ++i) {
+    pool.Schedule([&, i]() {
+      solutions[i] = models[i]->SolveFromAssignmentWithParameters(
+          assignments[i], search_parameters[i]);
+    });
+  }
+  // The destruction of the pool waits for all the solves to finish.
+  return solutions;
+}
+
+// Returns the index of the solution of smallest cost, or -1 if there is none.
+int BestSolutionIndex(absl::Span<const Assignment* const> solutions) {
+  int best = -1;
+  for (int i = 0; i < solutions.size(); ++i) {
+    if (solutions[i] == nullptr) continue;
+    if (best == -1 ||
+        solutions[i]->ObjectiveValue() < solutions[best]->ObjectiveValue()) {
+      best = i;
+    }
+  }
+  return best;
+}
+}  // namespace
+
+int SolveModelsInParallel(
+    absl::Span<RoutingModel* const> models,
+    absl::Span<const RoutingSearchParameters> search_parameters,
+    int num_threads, std::vector<const Assignment*>* solutions) {
+  return SolveModelsInParallelWithSharedSolution(
+      models, search_parameters, num_threads, /*num_rounds=*/1, solutions);
+}
+
+int SolveModelsInParallelWithSharedSolution(
+    absl::Span<RoutingModel* const> models,
+    absl::Span<const RoutingSearchParameters> search_parameters,
+    int num_threads, int num_rounds,
+    std::vector<const Assignment*>* solutions) {
+  CHECK_EQ(models.size(), search_parameters.size());
+  CHECK_GT(num_threads, 0);
+  CHECK_GT(num_rounds, 0);
+  std::vector<const Assignment*> starts(models.size(), nullptr);
+  std::vector<const Assignment*> model_solutions =
+      SolveModelsFromAssignmentsInParallel(models, search_parameters, starts,
+                                           num_threads);
+  int best_model = BestSolutionIndex(model_solutions);
+  for (int round = 1; round < num_rounds && best_model != -1; ++round) {
+    // The solutions are owned by the solvers and may be modified by the next
+    // solve, so each model starts from its own copy.
+    const int64_t best_cost = model_solutions[best_model]->ObjectiveValue();
+    for (int i = 0; i < models.size(); ++i) {
+      const bool is_lagging = model_solutions[i] == nullptr ||
+                              model_solutions[i]->ObjectiveValue() > best_cost;
+      const int source = is_lagging ? best_model : i;
+      Assignment* const start = models[i]->solver()->MakeAssignment();
+      models[i]->SetAssignmentFromOtherModelAssignment(
+          start, models[source], model_solutions[source]);
+      starts[i] = start;
+    }
+    model_solutions = SolveModelsFromAssignmentsInParallel(
+        models, search_parameters, starts, num_threads);
+    best_model = BestSolutionIndex(model_solutions);
+  }
+  if (solutions != nullptr) *solutions = std::move(model_solutions);
+  return best_model;
+}
+
 }  // namespace operations_research
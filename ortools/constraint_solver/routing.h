@@ -653,6 +653,20 @@ class RoutingModel {
 
   int RegisterTransitMatrix(
       std::vector<std::vector<int64_t> /*needed_for_swig*/> values);
+  /// Registers a sparse transit matrix, for models which are too large for a
+  /// dense one: 'values[node][k]' is the transit from 'node' to
+  /// 'neighbors[node][k]', both being node indices of the index manager (as in
+  /// RegisterTransitMatrix()). This is typically the transits to the nearest
+  /// neighbors of each node. The transits of the other arcs are given by
+  /// 'fallback_callback', which takes variable indices like the callbacks of
+  /// RegisterTransitCallback(). The storage is linear in the number of arcs
+  /// given, and each evaluation does a binary search in the neighbors of the
+  /// tail node.
+  int RegisterSparseTransitMatrix(
+      std::vector<std::vector<int64_t> /*needed_for_swig*/> neighbors,
+      std::vector<std::vector<int64_t> /*needed_for_swig*/> values,
+      TransitCallback2 fallback_callback,
+      TransitEvaluatorSign sign = kTransitEvaluatorSignUnknown);
   int RegisterTransitCallback(
       TransitCallback2 callback,
       TransitEvaluatorSign sign = kTransitEvaluatorSignUnknown);
@@ -822,6 +836,13 @@ class RoutingModel {
       const RoutingDimension& dimension) const;
   LocalDimensionCumulOptimizer* GetMutableLocalCumulMPOptimizer(
       const RoutingDimension& dimension) const;
+#if !defined(SWIG)
+  /// Returns the local search statistics of the solver (see
+  /// Solver::GetLocalSearchStatistics()), completed with the number of solves
+  /// and time spent in each dimension cumul optimizer of the model. The latter
+  /// are always collected, even when local search profiling is disabled.
+  LocalSearchStatistics GetLocalSearchStatistics() const;
+#endif  // !defined(SWIG)
 
   /// Returns true if a dimension exists for a given dimension name.
   bool HasDimension(absl::string_view dimension_name) const;
@@ -1394,6 +1415,31 @@ class RoutingModel {
   /// already been driven in online routing problems.
   const Assignment* PreAssignment() const { return preassignment_; }
   Assignment* MutablePreAssignment() { return preassignment_; }
+  /// Restrictions of the next searches, which are applied at the start of each
+  /// search on top of the model and of the PreAssignment(), and are undone
+  /// when the search ends. They can be used to solve a closed model repeatedly
+  /// with different sets of orders and time windows instead of rebuilding it;
+  /// the model must then contain all the possible orders as optional indices
+  /// and their widest time windows.
+  ///
+  /// Makes 'index' inactive in the next searches. Note that the penalty of the
+  /// disjunctions of 'index' is still part of the cost of the solutions.
+  void DeactivateIndexInNextSearches(int64_t index);
+  /// Restricts the cumul of 'index' in 'dimension' to [min, max] in the next
+  /// searches. This can only tighten the range of the cumul in the model.
+  void SetCumulVarRangeInNextSearches(const RoutingDimension& dimension,
+                                      int64_t index, int64_t min, int64_t max);
+  /// Removes all the restrictions of the next searches.
+  void ClearNextSearchesRestrictions() { next_searches_restrictions_->Clear(); }
+  /// Returns true if 'index' was deactivated in the next searches.
+  bool IsIndexDeactivatedInNextSearches(int64_t index) const;
+  /// Copies the routes of 'assignment' to 'restricted_assignment', skipping the
+  /// indices deactivated in the next searches. Typically used to warm-start
+  /// the next search from the previous solution with
+  /// SolveFromAssignmentWithParameters(). Returns false if the routes could
+  /// not be loaded (see RoutesToAssignment()).
+  bool RemoveIndicesDeactivatedInNextSearches(
+      const Assignment& assignment, Assignment* restricted_assignment) const;
   /// Writes the current solution to a file containing an AssignmentProto.
   /// Returns false if the file cannot be opened or if there is no current
   /// solution.
@@ -2534,6 +2580,7 @@ class RoutingModel {
   DecisionBuilder* restore_tmp_assignment_ = nullptr;
   Assignment* assignment_ = nullptr;
   Assignment* preassignment_ = nullptr;
+  Assignment* next_searches_restrictions_ = nullptr;
   Assignment* tmp_assignment_ = nullptr;
   LocalSearchOperator* primary_ls_operator_ = nullptr;
   LocalSearchOperator* secondary_ls_operator_ = nullptr;
@@ -3607,6 +3654,34 @@ bool SolveModelWithSat(RoutingModel* model,
                        Assignment* solution);
 
 #if !defined(SWIG)
+/// Solves each model with the search parameters of the same index, at most
+/// num_threads of them at the same time, and returns the index of the model
+/// with the solution of smallest cost, or -1 if no solution was found. If
+/// 'solutions' is specified, it will contain the solution of each model, or
+/// nullptr if no solution was found for it; these are owned by the solvers of
+/// the models.
+/// Each model has its own solver, filters and neighborhoods, so the searches
+/// are fully independent; models must not share callbacks or other objects
+/// which are not thread-safe. This can be used to run a portfolio of searches
+/// on the same problem, built once per worker, with different first solution
+/// strategies, operators or metaheuristics.
+int SolveModelsInParallel(
+    absl::Span<RoutingModel* const> models,
+    absl::Span<const RoutingSearchParameters> search_parameters,
+    int num_threads, std::vector<const Assignment*>* solutions = nullptr);
+
+/// Same as above, but the models share their best solution: the searches run
+/// in num_rounds rounds, and after each round, the models with no solution or
+/// with a solution worse than the best one start the next round from the best
+/// solution, while the others continue from their own. The models must
+/// represent the same problem, with the same nodes and vehicles, and the
+/// limits of 'search_parameters' apply to each round.
+int SolveModelsInParallelWithSharedSolution(
+    absl::Span<RoutingModel* const> models,
+    absl::Span<const RoutingSearchParameters> search_parameters,
+    int num_threads, int num_rounds,
+    std::vector<const Assignment*>* solutions = nullptr);
+
 IntVarLocalSearchFilter* MakeVehicleBreaksFilter(
     const RoutingModel& routing_model, const RoutingDimension& dimension);
 #endif
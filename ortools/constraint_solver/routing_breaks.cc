@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <deque>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -21,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/types.h"
@@ -984,6 +986,12 @@ class VehicleBreaksFilter : public BasePathFilter {
  private:
   // Fills path_ with the path of vehicle, start to end.
   void FillPathOfVehicle(int64_t vehicle);
+  // Fills route_cache_key_ with everything the feasibility of the route of
+  // vehicle depends on, besides static data: the nodes of the path with the
+  // current bounds of their cumuls, and the current bounds of the breaks.
+  void FillRouteCacheKey(int vehicle);
+  // Runs the disjunctive propagation on the route of vehicle stored in path_.
+  bool PropagatePath(int vehicle);
   std::vector<int64_t> path_;
   // Handles to model.
   const RoutingModel& model_;
@@ -999,6 +1007,15 @@ class VehicleBreaksFilter : public BasePathFilter {
 
   std::vector<int> start_to_vehicle_;
   TravelBounds travel_bounds_;
+
+  // Local search evaluates the same routes over and over, caching their
+  // feasibility saves the propagation, which dominates the cost of the
+  // filter on long routes with many breaks. The oldest routes are evicted
+  // first.
+  static constexpr int kMaxNumCachedRoutes = 1024;
+  absl::flat_hash_map<std::vector<int64_t>, bool> route_feasibility_cache_;
+  std::deque<std::vector<int64_t>> cached_routes_;
+  std::vector<int64_t> route_cache_key_;
 };
 
 VehicleBreaksFilter::VehicleBreaksFilter(const RoutingModel& routing_model,
@@ -1024,6 +1041,28 @@ void VehicleBreaksFilter::FillPathOfVehicle(int64_t vehicle) {
   path_.push_back(current);
 }
 
+void VehicleBreaksFilter::FillRouteCacheKey(int vehicle) {
+  route_cache_key_.clear();
+  route_cache_key_.push_back(vehicle);
+  route_cache_key_.push_back(path_.size());
+  for (const int64_t node : path_) {
+    const IntVar* cumul = dimension_.CumulVar(node);
+    route_cache_key_.push_back(node);
+    route_cache_key_.push_back(cumul->Min());
+    route_cache_key_.push_back(cumul->Max());
+  }
+  for (const IntervalVar* interval :
+       dimension_.GetBreakIntervalsOfVehicle(vehicle)) {
+    if (!interval->MustBePerformed()) continue;
+    route_cache_key_.push_back(interval->StartMin());
+    route_cache_key_.push_back(interval->StartMax());
+    route_cache_key_.push_back(interval->DurationMin());
+    route_cache_key_.push_back(interval->DurationMax());
+    route_cache_key_.push_back(interval->EndMin());
+    route_cache_key_.push_back(interval->EndMax());
+  }
+}
+
 bool VehicleBreaksFilter::AcceptPath(int64_t path_start, int64_t chain_start,
                                      int64_t chain_end) {
   const int vehicle = start_to_vehicle_[path_start];
@@ -1031,8 +1070,22 @@ bool VehicleBreaksFilter::AcceptPath(int64_t path_start, int64_t chain_start,
       dimension_.GetBreakDistanceDurationOfVehicle(vehicle).empty()) {
     return true;
   }
-  // Fill path and pre/post travel information.
   FillPathOfVehicle(vehicle);
+  FillRouteCacheKey(vehicle);
+  const auto it = route_feasibility_cache_.find(route_cache_key_);
+  if (it != route_feasibility_cache_.end()) return it->second;
+  const bool is_feasible = PropagatePath(vehicle);
+  if (cached_routes_.size() == kMaxNumCachedRoutes) {
+    route_feasibility_cache_.erase(cached_routes_.front());
+    cached_routes_.pop_front();
+  }
+  route_feasibility_cache_[route_cache_key_] = is_feasible;
+  cached_routes_.push_back(route_cache_key_);
+  return is_feasible;
+}
+
+bool VehicleBreaksFilter::PropagatePath(int vehicle) {
+  // Fill pre/post travel information.
   FillTravelBoundsOfVehicle(vehicle, path_, dimension_, &travel_bounds_);
   // Fill tasks from path, forbidden intervals, breaks and break constraints.
   tasks_.Clear();
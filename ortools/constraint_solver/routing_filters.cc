@@ -38,7 +38,6 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/base/map_util.h"
-#include "ortools/base/small_map.h"
 #include "ortools/base/strong_vector.h"
 #include "ortools/base/types.h"
 #include "ortools/constraint_solver/constraint_solver.h"
@@ -132,6 +131,10 @@ class NodeDisjunctionFilter : public IntVarLocalSearchFilter {
         routing_model_(routing_model),
         active_per_disjunction_(routing_model.GetNumberOfDisjunctions(), 0),
         inactive_per_disjunction_(routing_model.GetNumberOfDisjunctions(), 0),
+        active_deltas_(routing_model.GetNumberOfDisjunctions(), 0),
+        inactive_deltas_(routing_model.GetNumberOfDisjunctions(), 0),
+        touched_disjunctions_(RoutingModel::DisjunctionIndex(
+            routing_model.GetNumberOfDisjunctions())),
         synchronized_objective_value_(std::numeric_limits<int64_t>::min()),
         accepted_objective_value_(std::numeric_limits<int64_t>::min()),
         filter_cost_(filter_cost),
@@ -141,10 +144,12 @@ class NodeDisjunctionFilter : public IntVarLocalSearchFilter {
               int64_t /*objective_min*/, int64_t objective_max) override {
     const int64_t kUnassigned = -1;
     const Assignment::IntContainer& container = delta->IntVarContainer();
-    gtl::small_map<absl::flat_hash_map<RoutingModel::DisjunctionIndex, int>>
-        disjunction_active_deltas;
-    gtl::small_map<absl::flat_hash_map<RoutingModel::DisjunctionIndex, int>>
-        disjunction_inactive_deltas;
+    for (const RoutingModel::DisjunctionIndex disjunction_index :
+         touched_disjunctions_.PositionsSetAtLeastOnce()) {
+      active_deltas_[disjunction_index] = 0;
+      inactive_deltas_[disjunction_index] = 0;
+    }
+    touched_disjunctions_.SparseClearAll();
     bool lns_detected = false;
     // Update active/inactive count per disjunction for each element of delta.
     for (const IntVarElement& new_element : container.elements()) {
@@ -160,23 +165,25 @@ class NodeDisjunctionFilter : public IntVarLocalSearchFilter {
              routing_model_.GetDisjunctionIndices(index)) {
           const bool is_var_synced = IsVarSynced(index);
           if (!is_var_synced || (Value(index) == index) != is_inactive) {
-            ++gtl::LookupOrInsert(is_inactive ? &disjunction_inactive_deltas
-                                              : &disjunction_active_deltas,
-                                  disjunction_index, 0);
+            touched_disjunctions_.Set(disjunction_index);
+            ++(is_inactive ? inactive_deltas_
+                           : active_deltas_)[disjunction_index];
             if (is_var_synced) {
-              --gtl::LookupOrInsert(is_inactive ? &disjunction_active_deltas
-                                                : &disjunction_inactive_deltas,
-                                    disjunction_index, 0);
+              --(is_inactive ? active_deltas_
+                             : inactive_deltas_)[disjunction_index];
             }
           }
         }
       }
     }
     // Check if any disjunction has too many active nodes.
-    for (const auto [disjunction_index, active_nodes] :
-         disjunction_active_deltas) {
+    const std::vector<RoutingModel::DisjunctionIndex>& touched_disjunctions =
+        touched_disjunctions_.PositionsSetAtLeastOnce();
+    for (const RoutingModel::DisjunctionIndex disjunction_index :
+         touched_disjunctions) {
       // Too many active nodes.
-      if (active_per_disjunction_[disjunction_index] + active_nodes >
+      if (active_per_disjunction_[disjunction_index] +
+              active_deltas_[disjunction_index] >
           routing_model_.GetDisjunctionMaxCardinality(disjunction_index)) {
         return false;
       }
@@ -187,8 +194,9 @@ class NodeDisjunctionFilter : public IntVarLocalSearchFilter {
     }
     // Update penalty costs for disjunctions.
     accepted_objective_value_ = synchronized_objective_value_;
-    for (const auto [disjunction_index, inactive_nodes] :
-         disjunction_inactive_deltas) {
+    for (const RoutingModel::DisjunctionIndex disjunction_index :
+         touched_disjunctions) {
+      const int inactive_nodes = inactive_deltas_[disjunction_index];
       const int64_t penalty =
           routing_model_.GetDisjunctionPenalty(disjunction_index);
       if (penalty == 0) continue;
@@ -263,6 +271,14 @@ class NodeDisjunctionFilter : public IntVarLocalSearchFilter {
       active_per_disjunction_;
   util_intops::StrongVector<RoutingModel::DisjunctionIndex, int>
       inactive_per_disjunction_;
+  // Changes of the number of active and inactive nodes per disjunction in the
+  // last delta given to Accept(), only non-zero for the touched disjunctions.
+  // They are kept between calls to avoid allocating maps in each Accept().
+  util_intops::StrongVector<RoutingModel::DisjunctionIndex, int>
+      active_deltas_;
+  util_intops::StrongVector<RoutingModel::DisjunctionIndex, int>
+      inactive_deltas_;
+  SparseBitset<RoutingModel::DisjunctionIndex> touched_disjunctions_;
   int64_t synchronized_objective_value_;
   int64_t accepted_objective_value_;
   const bool filter_cost_;
@@ -2065,6 +2081,10 @@ bool DimensionHasCumulCost(const RoutingDimension& dimension) {
   return false;
 }
 
+// Note that the cumul windows of the nodes are not considered here: together
+// with the vehicle capacities, they are checked by the DimensionChecker added
+// by AppendLightWeightDimensionFilters(), in constant time per chain of the
+// modified paths instead of linear time in the size of the modified paths.
 bool DimensionHasPathCumulConstraint(const RoutingDimension& dimension) {
   if (dimension.HasBreakConstraints()) return true;
   if (dimension.HasPickupToDeliveryLimits()) return true;
@@ -2078,14 +2098,7 @@ bool DimensionHasPathCumulConstraint(const RoutingDimension& dimension) {
                      [](IntVar* slack) { return slack->Min() > 0; })) {
     return true;
   }
-  const std::vector<IntVar*>& cumuls = dimension.cumuls();
-  for (int i = 0; i < cumuls.size(); ++i) {
-    IntVar* const cumul_var = cumuls[i];
-    if (cumul_var->Min() > 0 &&
-        cumul_var->Max() < std::numeric_limits<int64_t>::max() &&
-        !dimension.model()->IsEnd(i)) {
-      return true;
-    }
+  for (int i = 0; i < dimension.cumuls().size(); ++i) {
     if (dimension.forbidden_intervals()[i].NumIntervals() > 0) return true;
   }
   return false;
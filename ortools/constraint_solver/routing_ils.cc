@@ -13,6 +13,7 @@
 
 #include "ortools/constraint_solver/routing_ils.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -22,6 +23,7 @@
 
 #include "absl/functional/bind_front.h"
 #include "absl/log/check.h"
+#include "absl/random/distributions.h"
 #include "ortools/base/logging.h"
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/routing.h"
@@ -65,6 +67,13 @@ std::unique_ptr<RuinProcedure> MakeRuinProcedure(
       return std::make_unique<CloseRoutesRemovalRuinProcedure>(
           model, parameters.num_ruined_routes());
       break;
+    case RuinStrategy::RANDOM_WALK_REMOVAL:
+      return std::make_unique<RandomWalkRemovalRuinProcedure>(
+          model, parameters.num_removed_visits());
+    case RuinStrategy::SISR_REMOVAL:
+      return std::make_unique<SISRRuinProcedure>(
+          model, parameters.max_removed_sequence_size(),
+          parameters.avg_num_removed_visits());
     default:
       LOG(ERROR) << "Unsupported ruin procedure.";
       return nullptr;
@@ -125,6 +134,17 @@ std::unique_ptr<RoutingFilteredHeuristic> MakeRecreateProcedure(
   return nullptr;
 }
 
+// Returns whether the assignment has at least one performed node.
+bool HasPerformedNodes(const RoutingModel& model,
+                       const Assignment& assignment) {
+  for (int v = 0; v < model.vehicles(); ++v) {
+    if (model.Next(assignment, model.Start(v)) != model.End(v)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Greedy criterion in which the reference assignment is only replaced by an
 // improving candidate assignment.
 class GreedyDescentAcceptanceCriterion : public NeighborAcceptanceCriterion {
@@ -152,7 +172,7 @@ std::function<int64_t(int64_t)> CloseRoutesRemovalRuinProcedure::Ruin(
     const Assignment* assignment) {
   removed_routes_.SparseClearAll();
 
-  if (num_routes_ > 0 && HasPerformedNodes(assignment)) {
+  if (num_routes_ > 0 && HasPerformedNodes(model_, *assignment)) {
     int64_t seed_node;
     int seed_route = -1;
     do {
@@ -193,14 +213,189 @@ std::function<int64_t(int64_t)> CloseRoutesRemovalRuinProcedure::Ruin(
   };
 }
 
-bool CloseRoutesRemovalRuinProcedure::HasPerformedNodes(
+VisitsRemovalRuinProcedure::VisitsRemovalRuinProcedure(RoutingModel* model)
+    : model_(*model),
+      neighbors_manager_(model->GetOrCreateNodeNeighborsByCostClass(
+          /*TODO(user): use a parameter*/ 100,
+          /*add_vehicle_starts_to_neighbors=*/false)),
+      rnd_(/*fixed seed=*/0),
+      customer_dist_(0, model->Size() - 1),
+      removed_visits_(model->Size() + model->vehicles()) {}
+
+std::function<int64_t(int64_t)> VisitsRemovalRuinProcedure::Ruin(
     const Assignment* assignment) {
-  for (int v = 0; v < model_.vehicles(); ++v) {
-    if (model_.Next(*assignment, model_.Start(v)) != model_.End(v)) {
-      return true;
+  removed_visits_.SparseClearAll();
+  if (HasPerformedNodes(model_, *assignment)) RemoveVisits(*assignment);
+
+  return [this, assignment](int64_t node) {
+    // Skip the removed visits, vehicle ends are never removed.
+    int64_t next = assignment->Value(model_.NextVar(node));
+    while (removed_visits_[next]) {
+      next = assignment->Value(model_.NextVar(next));
+    }
+    return next;
+  };
+}
+
+void VisitsRemovalRuinProcedure::RemoveVisit(const Assignment& assignment,
+                                             int64_t visit) {
+  DCHECK(IsPerformedVisit(assignment, visit));
+  removed_visits_.Set(visit);
+  using PickupDeliveryPositions =
+      std::vector<RoutingModel::PickupDeliveryPosition>;
+  for (const PickupDeliveryPositions* positions :
+       {&model_.GetPickupPositions(visit),
+        &model_.GetDeliveryPositions(visit)}) {
+    for (const RoutingModel::PickupDeliveryPosition& position : *positions) {
+      const PickupDeliveryPair& pair =
+          model_.GetPickupAndDeliveryPairs()[position.pd_pair_index];
+      for (const std::vector<int64_t>* alternatives :
+           {&pair.pickup_alternatives, &pair.delivery_alternatives}) {
+        for (const int64_t node : *alternatives) {
+          if (IsPerformedVisit(assignment, node)) removed_visits_.Set(node);
+        }
+      }
+    }
+  }
+}
+
+bool VisitsRemovalRuinProcedure::IsPerformedVisit(const Assignment& assignment,
+                                                  int64_t node) const {
+  return !model_.IsStart(node) && !model_.IsEnd(node) &&
+         assignment.Value(model_.VehicleVar(node)) >= 0;
+}
+
+int64_t VisitsRemovalRuinProcedure::RandomPerformedVisit(
+    const Assignment& assignment) {
+  int64_t visit;
+  do {
+    visit = customer_dist_(rnd_);
+  } while (!IsPerformedVisit(assignment, visit) || IsRemoved(visit));
+  return visit;
+}
+
+RandomWalkRemovalRuinProcedure::RandomWalkRemovalRuinProcedure(
+    RoutingModel* model, size_t num_removed_visits)
+    : VisitsRemovalRuinProcedure(model),
+      num_removed_visits_(num_removed_visits) {}
+
+void RandomWalkRemovalRuinProcedure::RemoveVisits(
+    const Assignment& assignment) {
+  int num_performed_visits = 0;
+  for (int64_t node = 0; node < model_.Size(); ++node) {
+    if (IsPerformedVisit(assignment, node)) ++num_performed_visits;
+  }
+  const int num_visits_to_remove =
+      std::min<int>(num_removed_visits_, num_performed_visits);
+  if (num_visits_to_remove == 0) return;
+
+  int64_t visit = RandomPerformedVisit(assignment);
+  while (true) {
+    RemoveVisit(assignment, visit);
+    if (NumRemovedVisits() >= num_visits_to_remove) break;
+
+    const int vehicle = assignment.Value(model_.VehicleVar(visit));
+    const RoutingCostClassIndex cost_class_index =
+        model_.GetCostClassIndexOfVehicle(vehicle);
+    candidate_neighbors_.clear();
+    for (const int neighbor :
+         neighbors_manager_->GetNeighborsOfNodeForCostClass(
+             cost_class_index.value(), visit)) {
+      if (IsPerformedVisit(assignment, neighbor) && !IsRemoved(neighbor)) {
+        candidate_neighbors_.push_back(neighbor);
+      }
+    }
+    if (candidate_neighbors_.empty()) {
+      visit = RandomPerformedVisit(assignment);
+    } else {
+      visit = candidate_neighbors_[absl::Uniform<size_t>(
+          rnd_, 0, candidate_neighbors_.size())];
+    }
+  }
+}
+
+SISRRuinProcedure::SISRRuinProcedure(RoutingModel* model,
+                                     size_t max_removed_sequence_size,
+                                     size_t avg_num_removed_visits)
+    : VisitsRemovalRuinProcedure(model),
+      max_removed_sequence_size_(max_removed_sequence_size),
+      avg_num_removed_visits_(avg_num_removed_visits),
+      ruined_routes_(model->vehicles()) {}
+
+void SISRRuinProcedure::RemoveVisits(const Assignment& assignment) {
+  if (max_removed_sequence_size_ == 0 || avg_num_removed_visits_ == 0) return;
+  ruined_routes_.SparseClearAll();
+
+  int num_performed_visits = 0;
+  int num_used_routes = 0;
+  for (int vehicle = 0; vehicle < model_.vehicles(); ++vehicle) {
+    int64_t node = model_.Next(assignment, model_.Start(vehicle));
+    if (model_.IsEnd(node)) continue;
+    ++num_used_routes;
+    while (!model_.IsEnd(node)) {
+      ++num_performed_visits;
+      node = model_.Next(assignment, node);
+    }
+  }
+  // The number of sequences is such that about avg_num_removed_visits_ are
+  // removed, knowing that a sequence has (1 + max_sequence_size) / 2 visits on
+  // average.
+  const double max_sequence_size =
+      std::min<double>(max_removed_sequence_size_,
+                       static_cast<double>(num_performed_visits) /
+                           num_used_routes);
+  const double max_num_sequences = std::max(
+      1.0, 4.0 * avg_num_removed_visits_ / (1 + max_sequence_size) - 1);
+  const int num_sequences =
+      static_cast<int>(absl::Uniform<double>(rnd_, 1, max_num_sequences + 1));
+
+  const int64_t seed_visit = RandomPerformedVisit(assignment);
+  const int seed_vehicle = assignment.Value(model_.VehicleVar(seed_visit));
+  RemoveSequenceContaining(assignment, seed_visit, max_sequence_size);
+  ruined_routes_.Set(seed_vehicle);
+  for (const int neighbor : neighbors_manager_->GetNeighborsOfNodeForCostClass(
+           model_.GetCostClassIndexOfVehicle(seed_vehicle).value(),
+           seed_visit)) {
+    if (ruined_routes_.NumberOfSetCallsWithDifferentArguments() >=
+        num_sequences) {
+      break;
+    }
+    if (!IsPerformedVisit(assignment, neighbor) || IsRemoved(neighbor)) {
+      continue;
+    }
+    const int vehicle = assignment.Value(model_.VehicleVar(neighbor));
+    if (ruined_routes_[vehicle]) continue;
+    RemoveSequenceContaining(assignment, neighbor, max_sequence_size);
+    ruined_routes_.Set(vehicle);
+  }
+}
+
+void SISRRuinProcedure::RemoveSequenceContaining(const Assignment& assignment,
+                                                 int64_t visit,
+                                                 double max_sequence_size) {
+  const int vehicle = assignment.Value(model_.VehicleVar(visit));
+  route_visits_.clear();
+  int visit_position = -1;
+  for (int64_t node = model_.Next(assignment, model_.Start(vehicle));
+       !model_.IsEnd(node); node = model_.Next(assignment, node)) {
+    if (node == visit) visit_position = route_visits_.size();
+    route_visits_.push_back(node);
+  }
+  DCHECK_GE(visit_position, 0);
+  const int route_size = route_visits_.size();
+  const int sequence_size = static_cast<int>(absl::Uniform<double>(
+      rnd_, 1, std::min<double>(route_size, max_sequence_size) + 1));
+  // The first visit of the sequence, chosen such that the sequence contains
+  // the visit and fits in the route.
+  const int first_position = absl::Uniform<int>(
+      absl::IntervalClosed, rnd_,
+      std::max(0, visit_position - sequence_size + 1),
+      std::min(visit_position, route_size - sequence_size));
+  for (int pos = first_position; pos < first_position + sequence_size; ++pos) {
+    if (!IsRemoved(route_visits_[pos])) {
+      RemoveVisit(assignment, route_visits_[pos]);
     }
   }
-  return false;
 }
 
 class RuinAndRecreateDecisionBuilder : public DecisionBuilder {
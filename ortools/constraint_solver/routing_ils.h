@@ -19,6 +19,7 @@
 #include <functional>
 #include <memory>
 #include <random>
+#include <vector>
 
 #include "ortools/constraint_solver/constraint_solver.h"
 #include "ortools/constraint_solver/routing.h"
@@ -46,9 +47,6 @@ class CloseRoutesRemovalRuinProcedure : public RuinProcedure {
   std::function<int64_t(int64_t)> Ruin(const Assignment* assignment) override;
 
  private:
-  // Returns whether the assignment as at least one performed node.
-  bool HasPerformedNodes(const Assignment* assignment);
-
   const RoutingModel& model_;
   const RoutingModel::NodeNeighborsByCostClass* const neighbors_manager_;
   const size_t num_routes_;
@@ -57,6 +55,83 @@ class CloseRoutesRemovalRuinProcedure : public RuinProcedure {
   SparseBitset<int64_t> removed_routes_;
 };
 
+// Base class of the ruin procedures removing individual visits. When a visit
+// of a pickup and delivery pair is removed, all the visits of the pair are.
+class VisitsRemovalRuinProcedure : public RuinProcedure {
+ public:
+  // Returns next accessors skipping the removed visits. Next accessors for
+  // removed visits are still set to their original value and should not be
+  // used.
+  std::function<int64_t(int64_t)> Ruin(const Assignment* assignment) final;
+
+ protected:
+  explicit VisitsRemovalRuinProcedure(RoutingModel* model);
+
+  // Selects the visits to remove with RemoveVisit(). Only called when the
+  // assignment has at least one performed visit.
+  virtual void RemoveVisits(const Assignment& assignment) = 0;
+
+  // Removes a performed visit and the other visits of its pickup and delivery
+  // pairs.
+  void RemoveVisit(const Assignment& assignment, int64_t visit);
+  bool IsRemoved(int64_t visit) const { return removed_visits_[visit]; }
+  int NumRemovedVisits() const {
+    return removed_visits_.NumberOfSetCallsWithDifferentArguments();
+  }
+  // Returns whether the visit is performed in the assignment. Vehicle starts
+  // and ends are not visits.
+  bool IsPerformedVisit(const Assignment& assignment, int64_t node) const;
+  // Returns a random performed visit which is not removed yet. There must be
+  // one.
+  int64_t RandomPerformedVisit(const Assignment& assignment);
+
+  const RoutingModel& model_;
+  const RoutingModel::NodeNeighborsByCostClass* const neighbors_manager_;
+  std::mt19937 rnd_;
+
+ private:
+  std::uniform_int_distribution<int64_t> customer_dist_;
+  SparseBitset<int64_t> removed_visits_;
+};
+
+// Removes visits along a random walk: starting from a random visit, the walk
+// repeatedly moves to a random neighbor which is still performed, or jumps to
+// a random visit if there are none.
+class RandomWalkRemovalRuinProcedure : public VisitsRemovalRuinProcedure {
+ public:
+  RandomWalkRemovalRuinProcedure(RoutingModel* model,
+                                 size_t num_removed_visits);
+
+ private:
+  void RemoveVisits(const Assignment& assignment) override;
+
+  const size_t num_removed_visits_;
+  std::vector<int64_t> candidate_neighbors_;
+};
+
+// Slack induction by string removals: removes sequences of consecutive visits
+// from the routes of a random visit and of its closest neighbors. The number
+// and the sizes of the sequences are drawn such that on average
+// avg_num_removed_visits are removed, with sequences of at most
+// max_removed_sequence_size visits.
+class SISRRuinProcedure : public VisitsRemovalRuinProcedure {
+ public:
+  SISRRuinProcedure(RoutingModel* model, size_t max_removed_sequence_size,
+                    size_t avg_num_removed_visits);
+
+ private:
+  void RemoveVisits(const Assignment& assignment) override;
+  // Removes a random sequence of at most max_sequence_size consecutive visits
+  // containing the given visit from its route.
+  void RemoveSequenceContaining(const Assignment& assignment, int64_t visit,
+                                double max_sequence_size);
+
+  const size_t max_removed_sequence_size_;
+  const size_t avg_num_removed_visits_;
+  SparseBitset<int64_t> ruined_routes_;
+  std::vector<int64_t> route_visits_;
+};
+
 // Returns a DecisionBuilder implementing a perturbation step of an Iterated
 // Local Search approach.
 DecisionBuilder* MakePerturbationDecisionBuilder(
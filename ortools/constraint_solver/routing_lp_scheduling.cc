@@ -177,14 +177,255 @@ void StoreVisitedPickupDeliveryPairsOnRoute(
   }
 }
 
+// A convex piecewise linear function defined on [start, end()] by its value at
+// start and its consecutive segments, of increasing slopes.
+struct ConvexPiecewiseLinearFunction {
+  struct Segment {
+    int64_t end;
+    int64_t slope;
+  };
+
+  int64_t end() const { return segments.empty() ? start : segments.back().end; }
+
+  // Makes sure that x is the end of a segment if start < x < end().
+  void SplitAt(int64_t x) {
+    int64_t segment_start = start;
+    for (int i = 0; i < segments.size(); ++i) {
+      if (x <= segment_start) return;
+      if (x < segments[i].end) {
+        segments.insert(segments.begin() + i, {x, segments[i].slope});
+        return;
+      }
+      segment_start = segments[i].end;
+    }
+  }
+
+  // Restricts the function to [lower_bound, upper_bound]. Returns false if the
+  // resulting domain is empty.
+  bool Restrict(int64_t lower_bound, int64_t upper_bound) {
+    if (lower_bound > upper_bound || lower_bound > end() ||
+        upper_bound < start) {
+      return false;
+    }
+    if (lower_bound > start) {
+      SplitAt(lower_bound);
+      int num_removed_segments = 0;
+      for (const Segment& segment : segments) {
+        if (segment.end > lower_bound) break;
+        value_at_start =
+            CapAdd(value_at_start,
+                   CapProd(segment.slope, CapSub(segment.end, start)));
+        start = segment.end;
+        ++num_removed_segments;
+      }
+      segments.erase(segments.begin(),
+                     segments.begin() + num_removed_segments);
+    }
+    if (upper_bound < end()) {
+      SplitAt(upper_bound);
+      while (!segments.empty() && segments.back().end > upper_bound) {
+        segments.pop_back();
+      }
+    }
+    return true;
+  }
+
+  // Adds coefficient * max(0, x - bound) to the function.
+  void AddCostAbove(int64_t bound, int64_t coefficient) {
+    if (bound < start) {
+      value_at_start =
+          CapAdd(value_at_start, CapProd(coefficient, CapSub(start, bound)));
+    }
+    SplitAt(bound);
+    int64_t segment_start = start;
+    for (Segment& segment : segments) {
+      if (segment_start >= bound) {
+        segment.slope = CapAdd(segment.slope, coefficient);
+      }
+      segment_start = segment.end;
+    }
+  }
+
+  // Adds coefficient * max(0, bound - x) to the function.
+  void AddCostBelow(int64_t bound, int64_t coefficient) {
+    if (bound > start) {
+      value_at_start =
+          CapAdd(value_at_start, CapProd(coefficient, CapSub(bound, start)));
+    }
+    SplitAt(bound);
+    for (Segment& segment : segments) {
+      if (segment.end > bound) break;
+      segment.slope = CapSub(segment.slope, coefficient);
+    }
+  }
+
+  // Replaces the function f by the function g of the cumul of the next node:
+  // g(y) = min over s in [slack_min, slack_max] of
+  //        f(y - transit - s) + slack_cost * s.
+  // Since f is convex, the part of f of slope smaller than slack_cost is
+  // shifted by transit + slack_min, the part of larger slope by
+  // transit + slack_max, and a segment of slope slack_cost fills the gap.
+  void AddTransitAndSlack(int64_t transit, int64_t slack_min,
+                          int64_t slack_max, int64_t slack_cost) {
+    const int64_t min_shift = CapAdd(transit, slack_min);
+    const int64_t max_shift = CapAdd(transit, slack_max);
+    const int64_t new_start = CapAdd(start, min_shift);
+    new_segments_.clear();
+    const auto add_segment = [this, new_start](int64_t end, int64_t slope) {
+      const int64_t segment_start =
+          new_segments_.empty() ? new_start : new_segments_.back().end;
+      if (end <= segment_start) return;
+      if (!new_segments_.empty() && new_segments_.back().slope == slope) {
+        new_segments_.back().end = end;
+      } else {
+        new_segments_.push_back({end, slope});
+      }
+    };
+    int64_t segment_start = start;
+    bool gap_filled = false;
+    for (const Segment& segment : segments) {
+      if (segment.slope < slack_cost) {
+        add_segment(CapAdd(segment.end, min_shift), segment.slope);
+      } else {
+        if (!gap_filled) {
+          add_segment(CapAdd(segment_start, max_shift), slack_cost);
+          gap_filled = true;
+        }
+        add_segment(CapAdd(segment.end, max_shift), segment.slope);
+      }
+      segment_start = segment.end;
+    }
+    if (!gap_filled) add_segment(CapAdd(end(), max_shift), slack_cost);
+    value_at_start = CapAdd(value_at_start, CapProd(slack_cost, slack_min));
+    start = new_start;
+    segments.swap(new_segments_);
+  }
+
+  int64_t Min() const {
+    int64_t value = value_at_start;
+    int64_t segment_start = start;
+    for (const Segment& segment : segments) {
+      if (segment.slope >= 0) break;
+      const int64_t length = CapSub(segment.end, segment_start);
+      value = CapAdd(value, CapProd(segment.slope, length));
+      segment_start = segment.end;
+    }
+    return value;
+  }
+
+  int64_t start = 0;
+  int64_t value_at_start = 0;
+  std::vector<Segment> segments;
+
+ private:
+  std::vector<Segment> new_segments_;
+};
+
+// Computes the optimal scheduling of the route of the vehicle without an LP,
+// when all the constraints of the route are cumul bounds and transits with
+// slacks, and all its costs are cumul soft bounds and span and slack costs.
+// The optimal cost as a function of the cumul of the current node is then
+// convex piecewise linear, and is propagated along the route.
+// Returns false if the route has other constraints or costs. Otherwise, sets
+// the status and, if optimize_costs is true and the route is feasible, its
+// cost without fixed transits.
+bool ComputeConvexRouteCost(
+    const RoutingDimension& dimension, int vehicle,
+    const std::function<int64_t(int64_t)>& next_accessor, bool optimize_costs,
+    DimensionSchedulingStatus* status, int64_t* cost_without_transits) {
+  if (dimension.HasBreakConstraints() ||
+      dimension.HasPickupToDeliveryLimits() ||
+      dimension.GetSpanUpperBoundForVehicle(vehicle) <
+          std::numeric_limits<int64_t>::max()) {
+    return false;
+  }
+  const RoutingModel& model = *dimension.model();
+  if (model.IsEnd(next_accessor(model.Start(vehicle))) &&
+      !model.IsVehicleUsedWhenEmpty(vehicle)) {
+    optimize_costs = false;
+  }
+  if (optimize_costs && dimension.HasSoftSpanUpperBounds()) {
+    const BoundCost bound_cost =
+        dimension.GetSoftSpanUpperBoundForVehicle(vehicle);
+    if (bound_cost.bound < std::numeric_limits<int64_t>::max() &&
+        bound_cost.cost > 0) {
+      return false;
+    }
+  }
+  const int64_t cumul_offset =
+      dimension.GetLocalOptimizerOffsetForVehicle(vehicle);
+  const int64_t slack_cost =
+      optimize_costs
+          ? CapAdd(dimension.GetSpanCostCoefficientForVehicle(vehicle),
+                   dimension.GetSlackCostCoefficientForVehicle(vehicle))
+          : 0;
+  if (slack_cost < 0) return false;
+  const RoutingModel::TransitCallback2& transit_evaluator =
+      dimension.transit_evaluator(vehicle);
+
+  ConvexPiecewiseLinearFunction cost_function;
+  cost_function.segments.push_back({std::numeric_limits<int64_t>::max(), 0});
+  int64_t cost_offset = 0;
+  int64_t node = model.Start(vehicle);
+  while (true) {
+    if (dimension.forbidden_intervals()[node].NumIntervals() > 0) return false;
+    int64_t cumul_min;
+    int64_t cumul_max;
+    if (!GetCumulBoundsWithOffset(dimension, node, cumul_offset, &cumul_min,
+                                  &cumul_max) ||
+        !cost_function.Restrict(cumul_min, cumul_max)) {
+      // The route is infeasible even if the LP would have had other
+      // constraints.
+      *status = DimensionSchedulingStatus::INFEASIBLE;
+      if (cost_without_transits != nullptr) *cost_without_transits = -1;
+      return true;
+    }
+    if (optimize_costs && dimension.HasCumulVarSoftUpperBound(node)) {
+      const int64_t coef = dimension.GetCumulVarSoftUpperBoundCoefficient(node);
+      if (coef < 0) return false;
+      const int64_t bound = dimension.GetCumulVarSoftUpperBound(node);
+      if (bound < cumul_offset) {
+        cost_offset =
+            CapAdd(cost_offset, CapProd(CapSub(cumul_offset, bound), coef));
+      }
+      cost_function.AddCostAbove(
+          std::max<int64_t>(0, CapSub(bound, cumul_offset)), coef);
+    }
+    if (optimize_costs && dimension.HasCumulVarSoftLowerBound(node)) {
+      const int64_t coef = dimension.GetCumulVarSoftLowerBoundCoefficient(node);
+      if (coef < 0) return false;
+      cost_function.AddCostBelow(
+          std::max<int64_t>(
+              0, CapSub(dimension.GetCumulVarSoftLowerBound(node),
+                        cumul_offset)),
+          coef);
+    }
+    if (model.IsEnd(node)) break;
+    const IntVar* slack = dimension.SlackVar(node);
+    const int64_t next = next_accessor(node);
+    cost_function.AddTransitAndSlack(transit_evaluator(node, next),
+                                     slack->Min(), slack->Max(), slack_cost);
+    node = next;
+  }
+  *status = DimensionSchedulingStatus::OPTIMAL;
+  if (cost_without_transits != nullptr) {
+    *cost_without_transits =
+        optimize_costs ? CapAdd(cost_offset, cost_function.Min()) : 0;
+  }
+  return true;
+}
+
 }  // namespace
 
 // LocalDimensionCumulOptimizer
 
 LocalDimensionCumulOptimizer::LocalDimensionCumulOptimizer(
     const RoutingDimension* dimension,
-    RoutingSearchParameters::SchedulingSolver solver_type)
-    : optimizer_core_(dimension, /*use_precedence_propagator=*/false) {
+    RoutingSearchParameters::SchedulingSolver solver_type,
+    int max_num_cached_routes)
+    : optimizer_core_(dimension, /*use_precedence_propagator=*/false),
+      max_num_cached_routes_(max_num_cached_routes) {
+  CHECK_GE(max_num_cached_routes, 0);
   // Using one solver per vehicle in the hope that if routes don't change this
   // will be faster.
   const int vehicles = dimension->model()->vehicles();
@@ -231,17 +472,70 @@ DimensionSchedulingStatus LocalDimensionCumulOptimizer::ComputeRouteCumulCost(
   return status;
 }
 
+bool LocalDimensionCumulOptimizer::FillRouteCacheKey(
+    int vehicle, const std::function<int64_t(int64_t)>& next_accessor,
+    bool optimize_vehicle_costs) {
+  const RoutingDimension* dimension = optimizer_core_.dimension();
+  if (!dimension->GetBreakIntervalsOfVehicle(vehicle).empty()) return false;
+  const RoutingModel& model = *dimension->model();
+  route_cache_key_.clear();
+  route_cache_key_.push_back(vehicle);
+  route_cache_key_.push_back(optimize_vehicle_costs);
+  int64_t node = model.Start(vehicle);
+  while (true) {
+    const IntVar* cumul = dimension->CumulVar(node);
+    route_cache_key_.push_back(node);
+    route_cache_key_.push_back(cumul->Min());
+    route_cache_key_.push_back(cumul->Max());
+    if (model.IsEnd(node)) break;
+    const IntVar* slack = dimension->SlackVar(node);
+    route_cache_key_.push_back(slack->Min());
+    route_cache_key_.push_back(slack->Max());
+    node = next_accessor(node);
+  }
+  return true;
+}
+
 DimensionSchedulingStatus
 LocalDimensionCumulOptimizer::ComputeRouteCumulCostWithoutFixedTransits(
     int vehicle, const std::function<int64_t(int64_t)>& next_accessor,
     int64_t* optimal_cost_without_transits) {
-  return optimizer_core_.OptimizeSingleRouteWithResource(
-      vehicle, next_accessor,
-      /*dimension_travel_info=*/{},
-      /*resource=*/nullptr,
-      /*optimize_vehicle_costs=*/optimal_cost_without_transits != nullptr,
-      solver_[vehicle].get(), /*cumul_values=*/nullptr,
-      /*break_values=*/nullptr, optimal_cost_without_transits, nullptr);
+  const bool optimize_vehicle_costs = optimal_cost_without_transits != nullptr;
+  const bool use_cache =
+      max_num_cached_routes_ > 0 &&
+      FillRouteCacheKey(vehicle, next_accessor, optimize_vehicle_costs);
+  if (use_cache) {
+    const auto it = route_cost_cache_.find(route_cache_key_);
+    if (it != route_cost_cache_.end()) {
+      if (optimize_vehicle_costs) {
+        *optimal_cost_without_transits = it->second.cost;
+      }
+      return it->second.status;
+    }
+  }
+  int64_t cost = 0;
+  DimensionSchedulingStatus status;
+  if (!ComputeConvexRouteCost(*dimension(), vehicle, next_accessor,
+                              optimize_vehicle_costs, &status,
+                              optimize_vehicle_costs ? &cost : nullptr)) {
+    status = optimizer_core_.OptimizeSingleRouteWithResource(
+        vehicle, next_accessor,
+        /*dimension_travel_info=*/{},
+        /*resource=*/nullptr, optimize_vehicle_costs, solver_[vehicle].get(),
+        /*cumul_values=*/nullptr,
+        /*break_values=*/nullptr, optimize_vehicle_costs ? &cost : nullptr,
+        nullptr);
+  }
+  if (optimize_vehicle_costs) *optimal_cost_without_transits = cost;
+  if (use_cache) {
+    if (cached_routes_.size() == max_num_cached_routes_) {
+      route_cost_cache_.erase(cached_routes_.front());
+      cached_routes_.pop_front();
+    }
+    route_cost_cache_[route_cache_key_] = {status, cost};
+    cached_routes_.push_back(route_cache_key_);
+  }
+  return status;
 }
 
 std::vector<DimensionSchedulingStatus> LocalDimensionCumulOptimizer::
@@ -649,7 +943,7 @@ DimensionCumulOptimizerCore::ComputeSingleRouteSolutionCostWithoutFixedTransits(
                               /*upper_bound=*/solution_break_values[i]);
   }
 
-  const DimensionSchedulingStatus status = solver->Solve(solve_duration_value);
+  const DimensionSchedulingStatus status = Solve(solve_duration_value, solver);
   if (status == DimensionSchedulingStatus::INFEASIBLE) {
     solver->Clear();
     return status;
@@ -898,7 +1192,7 @@ DimensionCumulOptimizerCore::OptimizeSingleRouteWithResources(
       continue;
     }
 
-    statuses.push_back(solver->Solve(model->RemainingTime()));
+    statuses.push_back(Solve(model->RemainingTime(), solver));
     if (statuses.back() == DimensionSchedulingStatus::INFEASIBLE) {
       continue;
     }
@@ -997,7 +1291,7 @@ DimensionSchedulingStatus DimensionCumulOptimizerCore::Optimize(
   }
 
   const DimensionSchedulingStatus status =
-      solver->Solve(model->RemainingTime());
+      Solve(model->RemainingTime(), solver);
   if (status == DimensionSchedulingStatus::INFEASIBLE) {
     solver->Clear();
     return status;
@@ -1141,9 +1435,9 @@ DimensionSchedulingStatus DimensionCumulOptimizerCore::PackRoutes(
     // into an infeasible status.
     current_params.set_use_dual_simplex(!current_params.use_dual_simplex());
     solver->SetParameters(current_params.SerializeAsString());
-    return solver->Solve(model->RemainingTime());
+    return Solve(model->RemainingTime(), solver);
   };
-  if (solver->Solve(model->RemainingTime()) ==
+  if (Solve(model->RemainingTime(), solver) ==
       DimensionSchedulingStatus::INFEASIBLE) {
     if (solver->IsCPSATSolver()) {
       return DimensionSchedulingStatus::INFEASIBLE;
@@ -1170,7 +1464,7 @@ DimensionSchedulingStatus DimensionCumulOptimizerCore::PackRoutes(
         index_to_cumul_variable_[model->Start(vehicle)], -1);
   }
 
-  DimensionSchedulingStatus status = solver->Solve(model->RemainingTime());
+  DimensionSchedulingStatus status = Solve(model->RemainingTime(), solver);
   if (!solver->IsCPSATSolver() &&
       status == DimensionSchedulingStatus::INFEASIBLE) {
     status = retry_solving();
@@ -1185,6 +1479,15 @@ DimensionSchedulingStatus DimensionCumulOptimizerCore::PackRoutes(
     }                                              \
   } while (false)
 
+DimensionSchedulingStatus DimensionCumulOptimizerCore::Solve(
+    absl::Duration duration_limit, RoutingLinearSolverWrapper* solver) {
+  const absl::Time start = absl::Now();
+  const DimensionSchedulingStatus status = solver->Solve(duration_limit);
+  solve_duration_ += absl::Now() - start;
+  ++num_solves_;
+  return status;
+}
+
 void DimensionCumulOptimizerCore::InitOptimizer(
     RoutingLinearSolverWrapper* solver) {
   solver->Clear();
@@ -2561,7 +2864,7 @@ void DimensionCumulOptimizerCore::SetResourceIndices(
 
 GlobalDimensionCumulOptimizer::GlobalDimensionCumulOptimizer(
     const RoutingDimension* dimension,
-    RoutingSearchParameters::SchedulingSolver solver_type)
+    RoutingSearchParameters::SchedulingSolver solver_type, int num_workers)
     : optimizer_core_(dimension,
                       /*use_precedence_propagator=*/
                       !dimension->GetNodePrecedences().empty()) {
@@ -2575,7 +2878,7 @@ GlobalDimensionCumulOptimizer::GlobalDimensionCumulOptimizer(
       break;
     }
     case RoutingSearchParameters::SCHEDULING_CP_SAT: {
-      solver_ = std::make_unique<RoutingCPSatWrapper>();
+      solver_ = std::make_unique<RoutingCPSatWrapper>(num_workers);
       break;
     }
     default:
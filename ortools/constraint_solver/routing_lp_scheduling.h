@@ -152,6 +152,9 @@ class CumulBoundsPropagator {
   // Used to store the pickup/delivery pairs encountered on the routes.
   std::vector<std::pair<int64_t, int64_t>>
       visited_pickup_delivery_indices_for_pair_;
+
+  int64_t num_solves_ = 0;
+  absl::Duration solve_duration_;
 };
 
 enum class DimensionSchedulingStatus {
@@ -447,8 +450,8 @@ class RoutingGlopWrapper : public RoutingLinearSolverWrapper {
 
 class RoutingCPSatWrapper : public RoutingLinearSolverWrapper {
  public:
-  RoutingCPSatWrapper() {
-    parameters_.set_num_search_workers(1);
+  explicit RoutingCPSatWrapper(int num_workers = 1) {
+    parameters_.set_num_search_workers(num_workers);
     // Keeping presolve but with 1 iteration; as of 10/2023 it is
     // significantly faster than both full presolve and no presolve.
     parameters_.set_cp_model_presolve(true);
@@ -712,11 +715,20 @@ class DimensionCumulOptimizerCore {
 
   const RoutingDimension* dimension() const { return dimension_; }
 
+  // Number of calls to the linear solver and total time spent in them, over
+  // the lifetime of the optimizer.
+  int64_t num_solves() const { return num_solves_; }
+  absl::Duration solve_duration() const { return solve_duration_; }
+
  private:
   // Initializes the containers and given solver. Must be called prior to
   // setting any constraints and solving.
   void InitOptimizer(RoutingLinearSolverWrapper* solver);
 
+  // Calls solver->Solve() and updates the solve statistics.
+  DimensionSchedulingStatus Solve(absl::Duration duration_limit,
+                                  RoutingLinearSolverWrapper* solver);
+
   // Computes the minimum/maximum of cumuls for nodes on "route", and sets them
   // in current_route_[min|max]_cumuls_ respectively.
   bool ExtractRouteCumulBounds(absl::Span<const int64_t> route,
@@ -824,9 +836,12 @@ class DimensionCumulOptimizerCore {
 // given node on a route.
 class LocalDimensionCumulOptimizer {
  public:
+  // The results of ComputeRouteCumulCostWithoutFixedTransits() are cached for
+  // at most max_num_cached_routes routes, see route_cost_cache_ below.
   LocalDimensionCumulOptimizer(
       const RoutingDimension* dimension,
-      RoutingSearchParameters::SchedulingSolver solver_type);
+      RoutingSearchParameters::SchedulingSolver solver_type,
+      int max_num_cached_routes = 1024);
 
   // If feasible, computes the optimal cost of the route performed by a vehicle,
   // minimizing cumul soft lower and upper bound costs and vehicle span costs,
@@ -838,6 +853,9 @@ class LocalDimensionCumulOptimizer {
 
   // Same as ComputeRouteCumulCost, but the cost computed does not contain
   // the part of the vehicle span cost due to fixed transits.
+  // Routes whose only costs are cumul soft bounds and span and slack costs,
+  // without breaks, span limits, pickup and delivery limits or forbidden
+  // intervals, are scheduled by a dedicated algorithm instead of an LP.
   DimensionSchedulingStatus ComputeRouteCumulCostWithoutFixedTransits(
       int vehicle, const std::function<int64_t(int64_t)>& next_accessor,
       int64_t* optimal_cost_without_transits);
@@ -898,17 +916,44 @@ class LocalDimensionCumulOptimizer {
   const RoutingDimension* dimension() const {
     return optimizer_core_.dimension();
   }
+  const DimensionCumulOptimizerCore& optimizer_core() const {
+    return optimizer_core_;
+  }
 
  private:
+  struct CachedRouteCost {
+    DimensionSchedulingStatus status;
+    int64_t cost;
+  };
+
+  // Fills route_cache_key_ with everything the optimal cost of the route of
+  // the vehicle depends on: the nodes of the route with the current bounds of
+  // their cumul and slack variables. Returns false if the route cannot be
+  // cached, i.e. if the vehicle has breaks.
+  bool FillRouteCacheKey(int vehicle,
+                         const std::function<int64_t(int64_t)>& next_accessor,
+                         bool optimize_vehicle_costs);
+
   std::vector<std::unique_ptr<RoutingLinearSolverWrapper>> solver_;
   DimensionCumulOptimizerCore optimizer_core_;
+
+  // Local search filters evaluate the same routes over and over, the cache
+  // avoids building and solving an LP or MIP for them. The oldest routes are
+  // evicted first.
+  const int max_num_cached_routes_;
+  absl::flat_hash_map<std::vector<int64_t>, CachedRouteCost> route_cost_cache_;
+  std::deque<std::vector<int64_t>> cached_routes_;
+  std::vector<int64_t> route_cache_key_;
 };
 
 class GlobalDimensionCumulOptimizer {
  public:
+  // 'num_workers' is the number of workers used by the CP-SAT solver, it is
+  // ignored by other solver types.
   GlobalDimensionCumulOptimizer(
       const RoutingDimension* dimension,
-      RoutingSearchParameters::SchedulingSolver solver_type);
+      RoutingSearchParameters::SchedulingSolver solver_type,
+      int num_workers = 1);
   // If feasible, computes the optimal cost of the entire model with regards to
   // the optimizer_core_'s dimension costs, minimizing cumul soft lower/upper
   // bound costs and vehicle/global span costs, and stores it in "optimal_cost"
@@ -945,6 +990,9 @@ class GlobalDimensionCumulOptimizer {
   const RoutingDimension* dimension() const {
     return optimizer_core_.dimension();
   }
+  const DimensionCumulOptimizerCore& optimizer_core() const {
+    return optimizer_core_;
+  }
 
  private:
   std::unique_ptr<RoutingLinearSolverWrapper> solver_;
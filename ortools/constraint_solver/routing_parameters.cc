@@ -44,7 +44,7 @@ RoutingModelParameters DefaultRoutingModelParameters() {
       parameters.mutable_solver_parameters();
   *solver_parameters = Solver::DefaultSolverParameters();
   solver_parameters->set_compress_trail(
-      ConstraintSolverParameters::COMPRESS_WITH_ZLIB);
+      ConstraintSolverParameters::COMPRESS_WITH_DELTA_ENCODING);
   solver_parameters->set_skip_locally_optimal_paths(true);
   parameters.set_reduce_vehicle_cost_model(true);
   return parameters;
@@ -58,6 +58,9 @@ IteratedLocalSearchParameters CreateDefaultIteratedLocalSearchParameters() {
   rr->set_ruin_strategy(RuinStrategy::SPATIALLY_CLOSE_ROUTES_REMOVAL);
   rr->set_recreate_strategy(FirstSolutionStrategy::LOCAL_CHEAPEST_INSERTION);
   rr->set_num_ruined_routes(2);
+  rr->set_num_removed_visits(10);
+  rr->set_max_removed_sequence_size(10);
+  rr->set_avg_num_removed_visits(10);
   ils.set_improve_perturbed_solution(true);
   ils.set_acceptance_strategy(AcceptanceStrategy::GREEDY_DESCENT);
   return ils;
@@ -143,6 +146,7 @@ RoutingSearchParameters CreateDefaultRoutingSearchParameters() {
   p.set_continuous_scheduling_solver(RoutingSearchParameters::SCHEDULING_GLOP);
   p.set_mixed_integer_scheduling_solver(
       RoutingSearchParameters::SCHEDULING_CP_SAT);
+  p.set_global_scheduling_num_workers(1);
   p.set_disable_scheduling_beware_this_may_degrade_performance(false);
   p.set_optimization_step(0.0);
   p.set_number_of_solutions_to_collect(1);
@@ -432,6 +436,14 @@ std::vector<std::string> FindErrorsInRoutingSearchParameters(
                    mixed_integer_scheduling_solver)));
   }
 
+  if (const int32_t num_workers =
+          search_parameters.global_scheduling_num_workers();
+      num_workers < 1) {
+    errors.emplace_back(
+        StrCat("Invalid global_scheduling_num_workers: ", num_workers,
+               ". Must be greater or equal to 1."));
+  }
+
   if (search_parameters.has_improvement_limit_parameters()) {
     const double improvement_rate_coefficient =
         search_parameters.improvement_limit_parameters()
@@ -2092,12 +2092,19 @@ bool GlobalCheapestInsertionFilteredHeuristic::AddNodeEntriesAfter(
   // Remove existing entries at 'insert_after', needed either when updating
   // entries or if unperformed node insertions were present.
   queue->ClearInsertions(insert_after);
+  // The cost of the arc removed by the insertions is shared by all entries.
+  std::optional<int64_t> removed_arc_cost;
   for (int node :
        node_index_to_neighbors_by_cost_class_->GetNeighborsOfNodeForCostClass(
            cost_class, insert_after)) {
     if (StopSearch()) return false;
     if (!Contains(node) && nodes[node]) {
-      AddNodeEntry(node, insert_after, vehicle, all_vehicles, queue);
+      if (!removed_arc_cost.has_value()) {
+        removed_arc_cost =
+            evaluator_(insert_after, Value(insert_after), vehicle);
+      }
+      AddNodeEntry(node, insert_after, vehicle, all_vehicles, queue,
+                   removed_arc_cost);
     }
   }
   return true;
@@ -2105,7 +2112,7 @@ bool GlobalCheapestInsertionFilteredHeuristic::AddNodeEntriesAfter(
 
 void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
     int64_t node, int64_t insert_after, int vehicle, bool all_vehicles,
-    NodeEntryQueue* queue) const {
+    NodeEntryQueue* queue, std::optional<int64_t> removed_arc_cost) const {
   const int64_t node_penalty = GetUnperformedValue(node);
   const int64_t penalty_shift =
       absl::GetFlag(FLAGS_routing_shift_insertion_cost_by_penalty)
@@ -2139,8 +2146,14 @@ void GlobalCheapestInsertionFilteredHeuristic::AddNodeEntry(
     return;
   }
 
-  const int64_t insertion_cost = GetInsertionCostForNodeAtPosition(
-      node, insert_after, Value(insert_after), vehicle);
+  const int64_t insert_before = Value(insert_after);
+  const int64_t insertion_cost =
+      removed_arc_cost.has_value()
+          ? CapSub(CapAdd(evaluator_(insert_after, node, vehicle),
+                          evaluator_(node, insert_before, vehicle)),
+                   *removed_arc_cost)
+          : GetInsertionCostForNodeAtPosition(node, insert_after,
+                                              insert_before, vehicle);
   if (!all_vehicles && insertion_cost > node_penalty) {
     // NOTE: When all vehicles aren't considered for insertion, we don't
     // add entries making nodes unperformed, so we don't add insertions
@@ -3614,6 +3627,10 @@ bool SavingsFilteredHeuristic::ComputeSavings() {
   savings_container_->InitializeContainer(size, saving_neighbors);
   if (StopSearch()) return false;
   std::vector<std::vector<int64_t>> adjacency_lists(size);
+  const int64_t costed_after_nodes_capacity = 2 * saving_neighbors;
+  std::vector<std::pair</*cost*/ int64_t, /*node*/ int64_t>>
+      costed_after_nodes;
+  costed_after_nodes.reserve(costed_after_nodes_capacity);
 
   for (int type = 0; type < num_vehicle_types; ++type) {
     const int vehicle =
@@ -3627,17 +3644,23 @@ bool SavingsFilteredHeuristic::ComputeSavings() {
     const int64_t fixed_cost = model()->GetFixedCostOfVehicle(vehicle);
 
     // Compute the neighbors for each non-start/end node not already inserted in
-    // the model.
+    // the model. The closest neighbors are selected in a buffer of at most
+    // 2 * saving_neighbors elements, which is truncated to the saving_neighbors
+    // best ones each time it is full. This keeps the memory independent of the
+    // number of nodes while staying linear in time.
     for (int before_node : uncontained_non_start_end_nodes) {
-      std::vector<std::pair</*cost*/ int64_t, /*node*/ int64_t>>
-          costed_after_nodes;
-      costed_after_nodes.reserve(uncontained_non_start_end_nodes.size());
+      costed_after_nodes.clear();
       if (StopSearch()) return false;
       for (int after_node : uncontained_non_start_end_nodes) {
-        if (after_node != before_node) {
-          costed_after_nodes.push_back(std::make_pair(
-              model()->GetArcCostForClass(before_node, after_node, cost_class),
-              after_node));
+        if (after_node == before_node) continue;
+        costed_after_nodes.push_back(std::make_pair(
+            model()->GetArcCostForClass(before_node, after_node, cost_class),
+            after_node));
+        if (costed_after_nodes.size() == costed_after_nodes_capacity) {
+          std::nth_element(costed_after_nodes.begin(),
+                           costed_after_nodes.begin() + saving_neighbors,
+                           costed_after_nodes.end());
+          costed_after_nodes.resize(saving_neighbors);
         }
       }
       if (saving_neighbors < costed_after_nodes.size()) {
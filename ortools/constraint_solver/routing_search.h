@@ -803,9 +803,13 @@ class GlobalCheapestInsertionFilteredHeuristic
 
   /// Creates a NodeEntry corresponding to the insertion of 'node' after
   /// 'insert_after' on 'vehicle' and adds it to the 'queue' and
-  /// 'node_entries'.
-  void AddNodeEntry(int64_t node, int64_t insert_after, int vehicle,
-                    bool all_vehicles, NodeEntryQueue* queue) const;
+  /// 'node_entries'. If given, 'removed_arc_cost' must be the cost of the arc
+  /// from 'insert_after' to its current next on 'vehicle', which is the same
+  /// for all the entries at 'insert_after'.
+  void AddNodeEntry(
+      int64_t node, int64_t insert_after, int vehicle, bool all_vehicles,
+      NodeEntryQueue* queue,
+      std::optional<int64_t> removed_arc_cost = std::nullopt) const;
 
   void ResetVehicleIndices() override {
     node_index_to_vehicle_.assign(node_index_to_vehicle_.size(), -1);
@@ -3672,6 +3672,8 @@ class GuidedLocalSearchPenaltiesTable {
   };
   explicit GuidedLocalSearchPenaltiesTable(int num_vars);
   bool HasPenalties() const { return has_values_; }
+  // Returns whether a value of the variable has a penalty.
+  bool IsPenalized(int64_t var) const { return !penalties_[var].empty(); }
   void IncrementPenalty(const VarValue& var_value);
   int64_t GetPenalty(const VarValue& var_value) const;
   void Reset();
@@ -3726,6 +3728,8 @@ class GuidedLocalSearchPenaltiesMap {
   };
   explicit GuidedLocalSearchPenaltiesMap(int num_vars);
   bool HasPenalties() const { return (!penalties_.empty()); }
+  // Returns whether a value of the variable has a penalty.
+  bool IsPenalized(int64_t var) const { return penalized_.Get(var); }
   void IncrementPenalty(const VarValue& var_value);
   int64_t GetPenalty(const VarValue& var_value) const;
   void Reset();
@@ -3908,12 +3912,17 @@ void GuidedLocalSearch<P>::ApplyDecision(Decision* const d) {
   }
   assignment_penalized_value_ = 0;
   if (penalties_.HasPenalties()) {
-    // Computing sum of penalties expression.
+    // Computing sum of penalties expression. Variables without any penalized
+    // value have a zero penalty whatever their value, so no expression is
+    // created for them; this keeps the cost of each step proportional to the
+    // number of penalized variables instead of the number of variables.
     // Scope needed to avoid potential leak of elements.
     {
       std::vector<IntVar*> elements;
       for (int i = 0; i < num_vars_; ++i) {
-        elements.push_back(MakeElementPenalty(i)->Var());
+        if (penalties_.IsPenalized(i)) {
+          elements.push_back(MakeElementPenalty(i)->Var());
+        }
         const int64_t penalty = AssignmentElementPenalty(i);
         penalized_values_.Set(i, penalty);
         assignment_penalized_value_ =
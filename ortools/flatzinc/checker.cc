@@ -26,6 +26,9 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "ortools/base/logging.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/flatzinc/model.h"
 #include "ortools/util/logging.h"
 
@@ -1324,14 +1327,53 @@ CallMap CreateCallMap() {
 
 bool CheckSolution(const Model& model,
                    const std::function<int64_t(Variable*)>& evaluator,
-                   SolverLogger* logger) {
-  bool ok = true;
+                   SolverLogger* logger, int num_workers) {
   const CallMap call_map = CreateCallMap();
-  for (Constraint* ct : model.constraints()) {
-    if (!ct->active) continue;
-    const auto& checker = call_map.at(ct->type);
-    if (!checker(*ct, evaluator)) {
-      SOLVER_LOG(logger, "Failing constraint ", ct->DebugString());
+  const std::vector<Constraint*>& constraints = model.constraints();
+  const int num_constraints = constraints.size();
+  const auto check_constraints = [&call_map, &constraints, &evaluator](
+                                     int begin, int end,
+                                     std::vector<int>* failures) {
+    for (int c = begin; c < end; ++c) {
+      const Constraint& ct = *constraints[c];
+      if (!ct.active) continue;
+      const auto& checker = call_map.at(ct.type);
+      if (!checker(ct, evaluator)) failures->push_back(c);
+    }
+  };
+
+  // Each chunk of constraints collects its failures, so that we can log them
+  // in order afterwards.
+  std::vector<std::vector<int>> failures_per_chunk;
+#if !defined(__PORTABLE_PLATFORM__)
+  constexpr int kMinConstraintsPerWorker = 10'000;
+  num_workers =
+      std::min(num_workers, num_constraints / kMinConstraintsPerWorker);
+  if (num_workers > 1) {
+    const int chunk_size = (num_constraints + num_workers - 1) / num_workers;
+    failures_per_chunk.resize(num_workers);
+    ThreadPool pool("SolutionChecker", num_workers);
+    pool.StartWorkers();
+    for (int begin = 0, chunk = 0; begin < num_constraints;
+         begin += chunk_size, ++chunk) {
+      const int end = std::min(begin + chunk_size, num_constraints);
+      std::vector<int>* failures = &failures_per_chunk[chunk];
+      pool.Schedule([&check_constraints, begin, end, failures]() {
+        check_constraints(begin, end, failures);
+      });
+    }
+    // The pool destructor waits for all the tasks to be done.
+  }
+#endif  // __PORTABLE_PLATFORM__
+  if (failures_per_chunk.empty()) {
+    failures_per_chunk.resize(1);
+    check_constraints(0, num_constraints, &failures_per_chunk[0]);
+  }
+
+  bool ok = true;
+  for (const std::vector<int>& failures : failures_per_chunk) {
+    for (const int c : failures) {
+      SOLVER_LOG(logger, "Failing constraint ", constraints[c]->DebugString());
       ok = false;
     }
   }
@@ -26,9 +26,13 @@ namespace fz {
 // Verifies that the solution specified by the given evaluator is a
 // feasible solution of the given model. Returns true iff this is the
 // case.
+//
+// If num_workers > 1, the constraints of large models are checked in parallel
+// and the evaluator must then be thread-safe. The failing constraints are
+// still logged in the model order.
 bool CheckSolution(const Model& model,
                    const std::function<int64_t(Variable*)>& evaluator,
-                   SolverLogger* logger);
+                   SolverLogger* logger, int num_workers = 1);
 
 }  // namespace fz
 }  // namespace operations_research
@@ -31,8 +31,10 @@
 #include "google/protobuf/text_format.h"
 #include "ortools/base/iterator_adaptors.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/timer.h"
 #include "ortools/flatzinc/checker.h"
 #include "ortools/flatzinc/model.h"
+#include "ortools/flatzinc/parser.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_checker.h"
 #include "ortools/sat/cp_model_solver.h"
@@ -118,6 +120,14 @@ struct CpModelProtoWithMapping {
   void FillReifOrImpliedConstraint(const fz::Constraint& fz_ct,
                                    ConstraintProto* ct);
 
+  // Creates one CpModelProto variable per active flatzinc variable added to
+  // the given model since the last call.
+  void TranslateNewVariables(const fz::Model& fz_model);
+
+  // Adds the CpModelProto constraints corresponding to the given flatzinc
+  // constraint.
+  void TranslateConstraint(const fz::Constraint& fz_ct);
+
   // Translates the flatzinc search annotations into the CpModelProto
   // search_order field.
   void TranslateSearchAnnotations(
@@ -134,6 +144,9 @@ struct CpModelProtoWithMapping {
   absl::flat_hash_map<std::tuple<int, int64_t, int, int64_t, int>, int>
       interval_key_to_index;
   absl::flat_hash_map<int, int> var_to_lit_implies_greater_than_zero;
+
+  // The number of flatzinc variables already seen by TranslateNewVariables().
+  int num_fz_variables_seen = 0;
 };
 
 int CpModelProtoWithMapping::LookupConstant(int64_t value) {
@@ -1113,6 +1126,56 @@ void CpModelProtoWithMapping::FillReifOrImpliedConstraint(
   FillConstraint(copy, negated_ct);
 }
 
+void CpModelProtoWithMapping::TranslateNewVariables(
+    const fz::Model& fz_model) {
+  // The translation is easy, we create one variable per flatzinc variable,
+  // plus eventually a bunch of constant variables that will be created
+  // lazily.
+  const std::vector<fz::Variable*>& fz_variables = fz_model.variables();
+  for (; num_fz_variables_seen < fz_variables.size();
+       ++num_fz_variables_seen) {
+    fz::Variable* fz_var = fz_variables[num_fz_variables_seen];
+    if (!fz_var->active) continue;
+    CHECK(!fz_var->domain.is_float)
+        << "CP-SAT does not support float variables";
+
+    fz_var_to_index[fz_var] = proto.variables_size();
+    IntegerVariableProto* var = proto.add_variables();
+    var->set_name(fz_var->name);
+    if (fz_var->domain.is_interval) {
+      if (fz_var->domain.values.empty()) {
+        // The CP-SAT solver checks that constraints cannot overflow during
+        // their propagation. Because of that, we trim undefined variable
+        // domains (i.e. int in minizinc) to something hopefully large enough.
+        LOG_FIRST_N(WARNING, 1)
+            << "Using flag --fz_int_max for unbounded integer variables.";
+        LOG_FIRST_N(WARNING, 1)
+            << "    actual domain is [" << -absl::GetFlag(FLAGS_fz_int_max)
+            << ".." << absl::GetFlag(FLAGS_fz_int_max) << "]";
+        var->add_domain(-absl::GetFlag(FLAGS_fz_int_max));
+        var->add_domain(absl::GetFlag(FLAGS_fz_int_max));
+      } else {
+        var->add_domain(fz_var->domain.values[0]);
+        var->add_domain(fz_var->domain.values[1]);
+      }
+    } else {
+      FillDomainInProto(Domain::FromValues(fz_var->domain.values), var);
+    }
+  }
+}
+
+void CpModelProtoWithMapping::TranslateConstraint(const fz::Constraint& fz_ct) {
+  ConstraintProto* ct = proto.add_constraints();
+  ct->set_name(fz_ct.type);
+  if (absl::EndsWith(fz_ct.type, "_reif") ||
+      absl::EndsWith(fz_ct.type, "_imp") || fz_ct.type == "array_bool_or" ||
+      fz_ct.type == "array_bool_and") {
+    FillReifOrImpliedConstraint(fz_ct, ct);
+  } else {
+    FillConstraint(fz_ct, ct);
+  }
+}
+
 void CpModelProtoWithMapping::TranslateSearchAnnotations(
     absl::Span<const fz::Annotation> search_annotations, SolverLogger* logger) {
   std::vector<fz::Annotation> flat_annotations;
@@ -1275,62 +1338,14 @@ void OutputFlatzincStats(const CpSolverResponse& response,
   SOLVER_LOG(solution_logger, "%%%mzn-stat: solveTime=", response.wall_time());
 }
 
-}  // namespace
-
-void SolveFzWithCpModelProto(const fz::Model& fz_model,
-                             const fz::FlatzincSatParameters& p,
-                             const std::string& sat_params,
-                             SolverLogger* logger,
-                             SolverLogger* solution_logger) {
-  CpModelProtoWithMapping m;
-  m.proto.set_name(fz_model.name());
-
-  // The translation is easy, we create one variable per flatzinc variable,
-  // plus eventually a bunch of constant variables that will be created
-  // lazily.
-  int num_variables = 0;
-  for (fz::Variable* fz_var : fz_model.variables()) {
-    if (!fz_var->active) continue;
-    CHECK(!fz_var->domain.is_float)
-        << "CP-SAT does not support float variables";
-
-    m.fz_var_to_index[fz_var] = num_variables++;
-    IntegerVariableProto* var = m.proto.add_variables();
-    var->set_name(fz_var->name);
-    if (fz_var->domain.is_interval) {
-      if (fz_var->domain.values.empty()) {
-        // The CP-SAT solver checks that constraints cannot overflow during
-        // their propagation. Because of that, we trim undefined variable
-        // domains (i.e. int in minizinc) to something hopefully large enough.
-        LOG_FIRST_N(WARNING, 1)
-            << "Using flag --fz_int_max for unbounded integer variables.";
-        LOG_FIRST_N(WARNING, 1)
-            << "    actual domain is [" << -absl::GetFlag(FLAGS_fz_int_max)
-            << ".." << absl::GetFlag(FLAGS_fz_int_max) << "]";
-        var->add_domain(-absl::GetFlag(FLAGS_fz_int_max));
-        var->add_domain(absl::GetFlag(FLAGS_fz_int_max));
-      } else {
-        var->add_domain(fz_var->domain.values[0]);
-        var->add_domain(fz_var->domain.values[1]);
-      }
-    } else {
-      FillDomainInProto(Domain::FromValues(fz_var->domain.values), var);
-    }
-  }
-
-  // Translate the constraints.
-  for (fz::Constraint* fz_ct : fz_model.constraints()) {
-    if (fz_ct == nullptr || !fz_ct->active) continue;
-    ConstraintProto* ct = m.proto.add_constraints();
-    ct->set_name(fz_ct->type);
-    if (absl::EndsWith(fz_ct->type, "_reif") ||
-        absl::EndsWith(fz_ct->type, "_imp") || fz_ct->type == "array_bool_or" ||
-        fz_ct->type == "array_bool_and") {
-      m.FillReifOrImpliedConstraint(*fz_ct, ct);
-    } else {
-      m.FillConstraint(*fz_ct, ct);
-    }
-  }
+// Translates the objective and the search annotations of the given model and
+// solves it. Its variables and constraints must already be translated in m.
+void SolveTranslatedFzModel(const fz::Model& fz_model,
+                            const fz::FlatzincSatParameters& p,
+                            const std::string& sat_params, SolverLogger* logger,
+                            SolverLogger* solution_logger,
+                            CpModelProtoWithMapping* mapping) {
+  CpModelProtoWithMapping& m = *mapping;
 
   // Fill the objective.
   if (fz_model.objective() != nullptr) {
@@ -1477,7 +1492,7 @@ void SolveFzWithCpModelProto(const fz::Model& fz_model,
         [&response, &m](fz::Variable* v) {
           return response.solution(m.fz_var_to_index.at(v));
         },
-        logger));
+        logger, m.parameters.num_workers()));
   }
 
   // Output the solution in the flatzinc official format.
@@ -1517,5 +1532,54 @@ void SolveFzWithCpModelProto(const fz::Model& fz_model,
   }
 }
 
+}  // namespace
+
+void SolveFzWithCpModelProto(const fz::Model& fz_model,
+                             const fz::FlatzincSatParameters& p,
+                             const std::string& sat_params,
+                             SolverLogger* logger,
+                             SolverLogger* solution_logger) {
+  CpModelProtoWithMapping m;
+  m.proto.set_name(fz_model.name());
+  m.TranslateNewVariables(fz_model);
+  for (fz::Constraint* fz_ct : fz_model.constraints()) {
+    if (fz_ct == nullptr || !fz_ct->active) continue;
+    m.TranslateConstraint(*fz_ct);
+  }
+  SolveTranslatedFzModel(fz_model, p, sat_params, logger, solution_logger, &m);
+}
+
+void ParseAndSolveFzWithCpModelProto(const std::string& input,
+                                     bool input_is_filename,
+                                     const std::string& model_name,
+                                     const fz::FlatzincSatParameters& p,
+                                     const std::string& sat_params,
+                                     SolverLogger* logger,
+                                     SolverLogger* solution_logger) {
+  WallTimer timer;
+  timer.Start();
+  CpModelProtoWithMapping m;
+  m.proto.set_name(model_name);
+  fz::Model fz_model(model_name);
+  fz_model.SetConstraintCallback([&m, &fz_model](const fz::Constraint& fz_ct) {
+    // Some constant variables are created while parsing the constraints.
+    m.TranslateNewVariables(fz_model);
+    m.TranslateConstraint(fz_ct);
+  });
+  if (input_is_filename) {
+    CHECK(fz::ParseFlatzincFile(input, &fz_model));
+  } else {
+    CHECK(fz::ParseFlatzincString(input, &fz_model));
+  }
+  m.TranslateNewVariables(fz_model);
+  SOLVER_LOG(logger, "File ", (input_is_filename ? input : "stdin"),
+             " parsed and translated in ", timer.GetInMs(), " ms");
+  SOLVER_LOG(logger, "");
+
+  // Note that fz_model has no constraints, so the final solution check is
+  // only done by CP-SAT.
+  SolveTranslatedFzModel(fz_model, p, sat_params, logger, solution_logger, &m);
+}
+
 }  // namespace sat
 }  // namespace operations_research
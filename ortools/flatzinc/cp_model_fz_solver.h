@@ -44,6 +44,19 @@ void SolveFzWithCpModelProto(const fz::Model& model,
                              SolverLogger* logger,
                              SolverLogger* solution_logger);
 
+// Same as SolveFzWithCpModelProto() but reads the model from the given file
+// (or string if input_is_filename is false), and translates each flatzinc
+// constraint as soon as it is parsed. The flatzinc constraints are thus never
+// stored, which cuts the peak memory on large models. Note that the flatzinc
+// presolve is not run in this mode as it needs the full model.
+void ParseAndSolveFzWithCpModelProto(const std::string& input,
+                                     bool input_is_filename,
+                                     const std::string& model_name,
+                                     const fz::FlatzincSatParameters& p,
+                                     const std::string& sat_params,
+                                     SolverLogger* logger,
+                                     SolverLogger* solution_logger);
+
 }  // namespace sat
 }  // namespace operations_research
 
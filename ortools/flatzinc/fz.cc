@@ -51,6 +51,10 @@ ABSL_FLAG(bool, free_search, false,
           "If true, other search are allowed.");
 ABSL_FLAG(int, threads, 0, "Number of threads the solver will use.");
 ABSL_FLAG(bool, presolve, true, "Presolve the model to simplify it.");
+ABSL_FLAG(bool, fz_stream_constraints, false,
+          "Translate each constraint to CP-SAT as soon as it is parsed instead "
+          "of storing the full flatzinc model. This uses a lot less memory on "
+          "large models, but disables the flatzinc presolve.");
 ABSL_FLAG(bool, statistics, false, "Print solver statistics after search.");
 ABSL_FLAG(bool, read_from_stdin, false,
           "Read the FlatZinc from stdin, not from a file.");
@@ -128,21 +132,22 @@ std::vector<char*> FixAndParseParameters(int* argc, char*** argv) {
   return residual_flags;
 }
 
-Model ParseFlatzincModel(const std::string& input, bool input_is_filename,
-                         SolverLogger* logger) {
-  WallTimer timer;
-  timer.Start();
-
+std::string GetProblemName(const std::string& input, bool input_is_filename) {
   // Check the extension.
   if (input_is_filename && !absl::EndsWith(input, ".fzn")) {
     LOG(FATAL) << "Unrecognized flatzinc file: `" << input << "'";
   }
+  return input_is_filename ? std::string(file::Stem(input))
+                           : absl::GetFlag(FLAGS_fz_model_name);
+}
+
+Model ParseFlatzincModel(const std::string& input, bool input_is_filename,
+                         SolverLogger* logger) {
+  WallTimer timer;
+  timer.Start();
 
   // Read model.
-  const std::string problem_name = input_is_filename
-                                       ? std::string(file::Stem(input))
-                                       : absl::GetFlag(FLAGS_fz_model_name);
-  Model model(problem_name);
+  Model model(GetProblemName(input, input_is_filename));
   if (input_is_filename) {
     CHECK(ParseFlatzincFile(input, &model));
   } else {
@@ -216,10 +221,6 @@ int main(int argc, char** argv) {
     logger.SetLogToStdOut(true);
   }
 
-  const operations_research::fz::Model model =
-      operations_research::fz::ParseFlatzincModel(
-          input, !absl::GetFlag(FLAGS_read_from_stdin), &logger);
-
   operations_research::fz::FlatzincSatParameters parameters;
   parameters.display_all_solutions = absl::GetFlag(FLAGS_display_all_solutions);
   parameters.search_all_solutions = absl::GetFlag(FLAGS_search_all_solutions);
@@ -236,6 +237,18 @@ int main(int argc, char** argv) {
   solution_logger.SetLogToStdOut(true);
   solution_logger.EnableLogging(parameters.ortools_mode);
 
+  const bool input_is_filename = !absl::GetFlag(FLAGS_read_from_stdin);
+  if (absl::GetFlag(FLAGS_fz_stream_constraints)) {
+    operations_research::sat::ParseAndSolveFzWithCpModelProto(
+        input, input_is_filename,
+        operations_research::fz::GetProblemName(input, input_is_filename),
+        parameters, absl::GetFlag(FLAGS_params), &logger, &solution_logger);
+    return EXIT_SUCCESS;
+  }
+
+  const operations_research::fz::Model model =
+      operations_research::fz::ParseFlatzincModel(input, input_is_filename,
+                                                  &logger);
   operations_research::sat::SolveFzWithCpModelProto(model, parameters,
                                                     absl::GetFlag(FLAGS_params),
                                                     &logger, &solution_logger);
@@ -1017,38 +1017,33 @@ std::string SolutionOutputSpecs::DebugString() const {
 
 // ----- Model -----
 
-Model::~Model() {
-  gtl::STLDeleteElements(&variables_);
-  gtl::STLDeleteElements(&constraints_);
-}
+Model::~Model() = default;
 
 Variable* Model::AddVariable(absl::string_view name, const Domain& domain,
                              bool defined) {
-  Variable* const var = new Variable(name, domain, defined);
+  variable_storage_.push_back(Variable(name, domain, defined));
+  Variable* const var = &variable_storage_.back();
   variables_.push_back(var);
   return var;
 }
 
 // TODO(user): Create only once constant per value.
 Variable* Model::AddConstant(int64_t value) {
-  Variable* const var =
-      new Variable(absl::StrCat(value), Domain::IntegerValue(value), true);
-  variables_.push_back(var);
-  return var;
+  return AddVariable(absl::StrCat(value), Domain::IntegerValue(value), true);
 }
 
 Variable* Model::AddFloatConstant(double value) {
-  Variable* const var =
-      new Variable(absl::StrCat(value), Domain::FloatValue(value), true);
-  variables_.push_back(var);
-  return var;
+  return AddVariable(absl::StrCat(value), Domain::FloatValue(value), true);
 }
 
 void Model::AddConstraint(absl::string_view id, std::vector<Argument> arguments,
                           bool is_domain) {
-  Constraint* const constraint =
-      new Constraint(id, std::move(arguments), is_domain);
-  constraints_.push_back(constraint);
+  if (constraint_callback_ != nullptr) {
+    constraint_callback_(Constraint(id, std::move(arguments), is_domain));
+    return;
+  }
+  constraint_storage_.emplace_back(id, std::move(arguments), is_domain);
+  constraints_.push_back(&constraint_storage_.back());
 }
 
 void Model::AddConstraint(absl::string_view id,
@@ -15,6 +15,8 @@
 #define OR_TOOLS_FLATZINC_MODEL_H_
 
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <map>
 #include <string>
 #include <utility>
@@ -358,6 +360,15 @@ class Model {
   void AddConstraint(absl::string_view id, std::vector<Argument> arguments);
   void AddOutput(SolutionOutputSpecs output);
 
+  // If set, AddConstraint() passes each new constraint to this callback
+  // instead of storing it in the model. This allows to translate a large model
+  // while it is parsed without keeping all its constraints in memory. Note
+  // that the variables used by a constraint are always added before it.
+  void SetConstraintCallback(
+      std::function<void(const Constraint&)> constraint_callback) {
+    constraint_callback_ = std::move(constraint_callback);
+  }
+
   // Set the search annotations and the objective: either simply satisfy the
   // problem, or minimize or maximize the given variable (which must have been
   // added with AddVariable() already).
@@ -411,12 +422,14 @@ class Model {
 
  private:
   const std::string name_;
-  // owned.
-  // TODO(user): use unique_ptr
+  // The variables and constraints are allocated by chunks in these arenas,
+  // which is a lot faster than allocating them one by one on large models.
+  // Note that the pointers stay valid as we only ever append to them.
+  std::deque<Variable> variable_storage_;
+  std::deque<Constraint> constraint_storage_;
   std::vector<Variable*> variables_;
-  // owned.
-  // TODO(user): use unique_ptr
   std::vector<Constraint*> constraints_;
+  std::function<void(const Constraint&)> constraint_callback_;
   // The objective variable (it belongs to variables_).
   Variable* objective_;
   bool maximize_;
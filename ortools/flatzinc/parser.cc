@@ -13,78 +13,1254 @@
 
 #include "ortools/flatzinc/parser.h"
 
-#include <cstdio>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "ortools/base/logging.h"
 #include "ortools/flatzinc/model.h"
-#include "ortools/flatzinc/parser.tab.hh"
-#include "ortools/flatzinc/parser_util.h"
-
-// Declare external functions in the flatzinc.tab.cc generated file.
-extern int orfz_parse(operations_research::fz::ParserContext* parser,
-                      operations_research::fz::Model* model, bool* ok,
-                      void* scanner);
-extern int orfz_lex_init(void** scanner);
-extern int orfz_lex_destroy(void* scanner);
-extern void orfz_set_in(FILE* in_str, void* yyscanner);
-// Declare external functions and structures in the flatzinc.yy.cc
-// generated file.
-struct yy_buffer_state;
-extern yy_buffer_state* orfz__scan_bytes(const char* input, int size,
-                                         void* scanner);
-extern void orfz__delete_buffer(yy_buffer_state* b, void* scanner);
 
 namespace operations_research {
 namespace fz {
+namespace {
+
+// ----- Lexer -----
+
+enum TokenType {
+  TOKEN_END,
+  TOKEN_CHAR,  // Any other single character, like ';' or '['.
+  TOKEN_IDENTIFIER,
+  TOKEN_STRING,
+  TOKEN_INT_VALUE,
+  TOKEN_FLOAT_VALUE,
+  TOKEN_DOTDOT,
+  TOKEN_COLONCOLON,
+  // Keywords.
+  TOKEN_ARRAY,
+  TOKEN_BOOL,
+  TOKEN_CONSTRAINT,
+  TOKEN_FLOAT,
+  TOKEN_INT,
+  TOKEN_MAXIMIZE,
+  TOKEN_MINIMIZE,
+  TOKEN_OF,
+  TOKEN_PREDICATE,
+  TOKEN_SATISFY,
+  TOKEN_SET,
+  TOKEN_SOLVE,
+  TOKEN_VAR,
+};
+
+struct Token {
+  TokenType type = TOKEN_END;
+  // This points inside the parsed input, so no token is ever allocated.
+  absl::string_view text;
+  int64_t integer_value = 0;
+  double float_value = 0.0;
+};
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+bool IsAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+bool IsIdentifierChar(char c) { return IsAlpha(c) || IsDigit(c) || c == '_'; }
+
+// Returns the value of the given digit in the given base, or -1.
+int DigitValue(char c, int base) {
+  int value = -1;
+  if (IsDigit(c)) {
+    value = c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    value = c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    value = c - 'A' + 10;
+  }
+  return value < base ? value : -1;
+}
+
+// A single-pass lexer that recognizes the same tokens as the flex lexer we
+// used before.
+class Lexer {
+ public:
+  explicit Lexer(absl::string_view input) : input_(input) {}
+
+  Token Next();
+
+  // The line of the last returned token (1-based).
+  int line() const { return line_; }
+
+ private:
+  char Peek(size_t offset) const {
+    return pos_ + offset < input_.size() ? input_[pos_ + offset] : '\0';
+  }
+
+  void SkipSpacesAndComments();
+  Token ReadNumber();
+  Token ReadIdentifierOrKeyword(size_t end);
+
+  const absl::string_view input_;
+  size_t pos_ = 0;
+  int line_ = 1;
+};
+
+void Lexer::SkipSpacesAndComments() {
+  while (pos_ < input_.size()) {
+    const char c = input_[pos_];
+    if (c == '\n') {
+      ++line_;
+      ++pos_;
+    } else if (c == ' ' || c == '\t' || c == '\r') {
+      ++pos_;
+    } else if (c == '%') {
+      while (pos_ < input_.size() && input_[pos_] != '\n') ++pos_;
+    } else {
+      break;
+    }
+  }
+}
+
+Token Lexer::Next() {
+  SkipSpacesAndComments();
+  Token token;
+  if (pos_ >= input_.size()) return token;
+
+  const char c = input_[pos_];
+  if (IsDigit(c) || (c == '-' && IsDigit(Peek(1)))) return ReadNumber();
+
+  // Identifiers are [A-Za-z][A-Za-z0-9_]* or _+[A-Za-z][A-Za-z0-9_]*.
+  if (IsAlpha(c) || c == '_') {
+    size_t end = pos_;
+    while (end < input_.size() && input_[end] == '_') ++end;
+    if (end < input_.size() && IsAlpha(input_[end])) {
+      return ReadIdentifierOrKeyword(end);
+    }
+  }
+
+  // Strings cannot span multiple lines. Note that like before, the token text
+  // includes the quotes.
+  if (c == '"') {
+    size_t end = pos_ + 1;
+    while (end < input_.size() && input_[end] != '"' && input_[end] != '\n') {
+      ++end;
+    }
+    if (end < input_.size() && input_[end] == '"') {
+      token.type = TOKEN_STRING;
+      token.text = input_.substr(pos_, end + 1 - pos_);
+      pos_ = end + 1;
+      return token;
+    }
+  }
+
+  if ((c == '.' && Peek(1) == '.') || (c == ':' && Peek(1) == ':')) {
+    token.type = c == '.' ? TOKEN_DOTDOT : TOKEN_COLONCOLON;
+    token.text = input_.substr(pos_, 2);
+    pos_ += 2;
+    return token;
+  }
+
+  token.type = TOKEN_CHAR;
+  token.text = input_.substr(pos_, 1);
+  ++pos_;
+  return token;
+}
+
+Token Lexer::ReadIdentifierOrKeyword(size_t end) {
+  while (end < input_.size() && IsIdentifierChar(input_[end])) ++end;
+  Token token;
+  token.type = TOKEN_IDENTIFIER;
+  token.text = input_.substr(pos_, end - pos_);
+  pos_ = end;
+
+  // All keywords are short, so most identifiers skip this.
+  if (token.text.size() > 10) return token;
+  static constexpr std::pair<absl::string_view, TokenType> kKeywords[] = {
+      {"array", TOKEN_ARRAY},         {"bool", TOKEN_BOOL},
+      {"constraint", TOKEN_CONSTRAINT}, {"float", TOKEN_FLOAT},
+      {"int", TOKEN_INT},             {"maximize", TOKEN_MAXIMIZE},
+      {"minimize", TOKEN_MINIMIZE},   {"of", TOKEN_OF},
+      {"predicate", TOKEN_PREDICATE}, {"satisfy", TOKEN_SATISFY},
+      {"set", TOKEN_SET},             {"solve", TOKEN_SOLVE},
+      {"var", TOKEN_VAR}};
+  for (const auto& [keyword, type] : kKeywords) {
+    if (token.text == keyword) {
+      token.type = type;
+      return token;
+    }
+  }
+  if (token.text == "true" || token.text == "false") {
+    token.type = TOKEN_INT_VALUE;
+    token.integer_value = token.text == "true" ? 1 : 0;
+  }
+  return token;
+}
+
+Token Lexer::ReadNumber() {
+  Token token;
+  const bool negative = input_[pos_] == '-';
+  size_t end = negative ? pos_ + 1 : pos_;
+
+  // Hexadecimal (0x) and octal (0o) integers.
+  if (input_[end] == '0' && end + 2 < input_.size() &&
+      (input_[end + 1] == 'x' || input_[end + 1] == 'o')) {
+    const int base = input_[end + 1] == 'x' ? 16 : 8;
+    if (DigitValue(input_[end + 2], base) >= 0) {
+      end += 2;
+      int64_t value = 0;
+      for (; end < input_.size(); ++end) {
+        const int digit = DigitValue(input_[end], base);
+        if (digit < 0) break;
+        CHECK_LE(value, (std::numeric_limits<int64_t>::max() - digit) / base)
+            << "Integer overflow in line no. " << line_;
+        value = value * base + digit;
+      }
+      token.type = TOKEN_INT_VALUE;
+      token.integer_value = negative ? -value : value;
+      token.text = input_.substr(pos_, end - pos_);
+      pos_ = end;
+      return token;
+    }
+  }
+
+  while (end < input_.size() && IsDigit(input_[end])) ++end;
+  bool is_float = false;
+  if (end + 1 < input_.size() && input_[end] == '.' &&
+      IsDigit(input_[end + 1])) {
+    is_float = true;
+    ++end;
+    while (end < input_.size() && IsDigit(input_[end])) ++end;
+  }
+  if (end < input_.size() && (input_[end] == 'e' || input_[end] == 'E')) {
+    size_t exponent = end + 1;
+    if (exponent < input_.size() &&
+        (input_[exponent] == '+' || input_[exponent] == '-')) {
+      ++exponent;
+    }
+    if (exponent < input_.size() && IsDigit(input_[exponent])) {
+      is_float = true;
+      end = exponent;
+      while (end < input_.size() && IsDigit(input_[end])) ++end;
+    }
+  }
+
+  token.text = input_.substr(pos_, end - pos_);
+  pos_ = end;
+  if (is_float) {
+    token.type = TOKEN_FLOAT_VALUE;
+    CHECK(absl::SimpleAtod(token.text, &token.float_value));
+  } else {
+    token.type = TOKEN_INT_VALUE;
+    CHECK(absl::SimpleAtoi(token.text, &token.integer_value));
+  }
+  return token;
+}
+
+// ----- Parser -----
+
+// An optional reference to a variable, or an integer value, used in
+// assignments during the declaration of a variable, or a variable
+// array.
+struct VarRefOrValue {
+  static VarRefOrValue Undefined() { return VarRefOrValue(); }
+  static VarRefOrValue VarRef(Variable* var) {
+    VarRefOrValue result;
+    result.variable = var;
+    result.defined = true;
+    return result;
+  }
+  static VarRefOrValue Value(int64_t value) {
+    VarRefOrValue result;
+    result.value = value;
+    result.defined = true;
+    return result;
+  }
+  static VarRefOrValue FloatValue(double value) {
+    VarRefOrValue result;
+    result.float_value = value;
+    result.defined = true;
+    result.is_float = true;
+    return result;
+  }
+
+  Variable* variable = nullptr;
+  int64_t value = 0;
+  double float_value = 0.0;
+  bool defined = false;
+  bool is_float = false;
+};
+
+// Whether the given list of annotations contains the given identifier
+// (or function call).
+bool ContainsId(const std::vector<Annotation>& annotations,
+                absl::string_view id) {
+  for (const Annotation& ann : annotations) {
+    if ((ann.type == Annotation::IDENTIFIER ||
+         ann.type == Annotation::FUNCTION_CALL) &&
+        ann.id == id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AllDomainsHaveOneValue(const std::vector<Domain>& domains) {
+  for (const Domain& domain : domains) {
+    if (!domain.HasOneValue()) return false;
+  }
+  return true;
+}
+
+// Array in flatzinc are 1 based. We use this trivial wrapper for all flatzinc
+// arrays.
+template <class T>
+const T& Lookup(const std::vector<T>& v, int64_t index) {
+  CHECK_GE(index, 1);
+  CHECK_LE(index, v.size());
+  return v[index - 1];
+}
+
+// Returns nullptr if the key is not in the map. Note that this never
+// allocates a std::string for the key.
+template <class Map>
+const typename Map::mapped_type* FindOrNull(const Map& map,
+                                            absl::string_view key) {
+  const auto it = map.find(key);
+  return it == map.end() ? nullptr : &it->second;
+}
+
+template <class Map>
+const typename Map::mapped_type& FindOrDie(const Map& map,
+                                           absl::string_view key) {
+  const auto it = map.find(key);
+  CHECK(it != map.end()) << "Unknown identifier: " << key;
+  return it->second;
+}
+
+// A recursive descent parser for the flatzinc language. It accepts the same
+// grammar and builds exactly the same Model as the bison parser we used
+// before, but it makes a single pass on the input without allocating anything
+// per token.
+//
+// All the Parse*() functions return false on a syntax error, after having
+// logged it. Like before, some semantic errors (for instance an out of bound
+// array access) are fatal.
+class Parser {
+ public:
+  Parser(absl::string_view input, Model* model)
+      : lexer_(input), model_(model) {
+    // Add known constants.
+    integer_map_["true"] = 1;
+    integer_map_["false"] = 0;
+  }
+
+  // Returns true iff the whole input is a valid model.
+  bool Parse();
+
+ private:
+  // The kinds of domain, which defines how the value of a constant array is
+  // parsed.
+  enum DomainKind { INT_DOMAIN, SET_DOMAIN, FLOAT_DOMAIN };
+
+  void Advance() { token_ = lexer_.Next(); }
+  bool Is(TokenType type) const { return token_.type == type; }
+  bool IsChar(char c) const {
+    return token_.type == TOKEN_CHAR && token_.text[0] == c;
+  }
+  bool ConsumeChar(char c) {
+    if (!IsChar(c)) return false;
+    Advance();
+    return true;
+  }
+
+  bool SyntaxError(absl::string_view expected);
+  bool Expect(TokenType type, absl::string_view name);
+  bool ExpectChar(char c);
+  bool ExpectIdentifier(absl::string_view* id);
+  bool ExpectInteger(int64_t* value);
+  bool ExpectFloat(double* value);
+
+  bool SkipPredicate();
+  bool ParseDeclaration();
+  bool ParseConstantDeclaration();
+  bool ParseArrayDeclaration();
+  bool ParseVariableDeclaration();
+  bool ParseVariableArrayDeclaration(int64_t first_index, int64_t num_vars);
+  bool ParseConstraint();
+  bool ParseSolve();
+
+  bool ParseDomain(Domain* domain, DomainKind* kind);
+  bool ParseInteger(int64_t* value);
+  bool ParseIntegers(std::vector<int64_t>* values);
+  bool ParseFloat(double* value);
+  bool ParseFloats(std::vector<double>* values);
+  bool ParseConstLiteral(Domain* domain);
+  bool ParseConstLiterals(std::vector<Domain>* domains);
+  bool ParseVarOrValue(VarRefOrValue* result);
+  bool ParseVarOrValues(std::vector<VarRefOrValue>* results);
+  bool ParseArgument(Argument* argument);
+  bool ParseAnnotation(Annotation* annotation);
+  bool ParseAnnotations(std::vector<Annotation>* annotations);
+  bool ParseAnnotationArguments(std::vector<Annotation>* annotations);
+
+  Lexer lexer_;
+  Token token_;
+  Model* const model_;
+
+  // Whether a non-fatal semantic error occurred.
+  bool ok_ = true;
+
+  // The named objects. Note that the constants are not stored in the model.
+  absl::flat_hash_map<std::string, int64_t> integer_map_;
+  absl::flat_hash_map<std::string, std::vector<int64_t>> integer_array_map_;
+  absl::flat_hash_map<std::string, double> float_map_;
+  absl::flat_hash_map<std::string, std::vector<double>> float_array_map_;
+  absl::flat_hash_map<std::string, Variable*> variable_map_;
+  absl::flat_hash_map<std::string, std::vector<Variable*>> variable_array_map_;
+  absl::flat_hash_map<std::string, Domain> domain_map_;
+  absl::flat_hash_map<std::string, std::vector<Domain>> domain_array_map_;
+};
+
+bool Parser::SyntaxError(absl::string_view expected) {
+  const std::string unexpected =
+      Is(TOKEN_END) ? "end of file" : absl::StrCat("'", token_.text, "'");
+  LOG(ERROR) << "Error: syntax error, unexpected " << unexpected
+             << ", expecting " << expected << " in line no. "
+             << lexer_.line();
+  ok_ = false;
+  return false;
+}
+
+bool Parser::Expect(TokenType type, absl::string_view name) {
+  if (!Is(type)) return SyntaxError(name);
+  Advance();
+  return true;
+}
+
+bool Parser::ExpectChar(char c) {
+  if (ConsumeChar(c)) return true;
+  return SyntaxError(absl::StrCat("'", absl::string_view(&c, 1), "'"));
+}
+
+bool Parser::ExpectIdentifier(absl::string_view* id) {
+  if (!Is(TOKEN_IDENTIFIER)) return SyntaxError("identifier");
+  *id = token_.text;
+  Advance();
+  return true;
+}
+
+bool Parser::ExpectInteger(int64_t* value) {
+  if (!Is(TOKEN_INT_VALUE)) return SyntaxError("integer");
+  *value = token_.integer_value;
+  Advance();
+  return true;
+}
+
+bool Parser::ExpectFloat(double* value) {
+  if (!Is(TOKEN_FLOAT_VALUE)) return SyntaxError("float");
+  *value = token_.float_value;
+  Advance();
+  return true;
+}
+
+bool Parser::Parse() {
+  Advance();
+  while (Is(TOKEN_PREDICATE)) {
+    if (!SkipPredicate() || !ExpectChar(';')) return false;
+  }
+  while (!Is(TOKEN_CONSTRAINT) && !Is(TOKEN_SOLVE)) {
+    if (!ParseDeclaration() || !ExpectChar(';')) return false;
+  }
+  while (Is(TOKEN_CONSTRAINT)) {
+    if (!ParseConstraint() || !ExpectChar(';')) return false;
+  }
+  if (!ParseSolve() || !ExpectChar(';')) return false;
+  if (!Is(TOKEN_END)) return SyntaxError("end of file");
+  return ok_;
+}
+
+// We just ignore the predicates, so we only check that their parentheses
+// are balanced.
+bool Parser::SkipPredicate() {
+  Advance();
+  absl::string_view id;
+  if (!ExpectIdentifier(&id) || !ExpectChar('(')) return false;
+  int depth = 1;
+  while (depth > 0) {
+    if (Is(TOKEN_END)) return SyntaxError("')'");
+    if (IsChar('(')) ++depth;
+    if (IsChar(')')) --depth;
+    Advance();
+  }
+  return true;
+}
+
+bool Parser::ParseDeclaration() {
+  if (Is(TOKEN_ARRAY)) return ParseArrayDeclaration();
+  if (Is(TOKEN_VAR)) return ParseVariableDeclaration();
+  return ParseConstantDeclaration();
+}
+
+bool Parser::ParseConstantDeclaration() {
+  // Declaration of a (named) constant: we simply register it in the
+  // parser's context, and don't store it in the model.
+  Domain domain;
+  DomainKind kind;
+  absl::string_view id;
+  std::vector<Annotation> annotations;
+  Domain assignment;
+  if (!ParseDomain(&domain, &kind) || !ExpectChar(':') ||
+      !ExpectIdentifier(&id) || !ParseAnnotations(&annotations) ||
+      !ExpectChar('=') || !ParseConstLiteral(&assignment)) {
+    return false;
+  }
+  if (!assignment.HasOneValue()) {
+    // TODO(user): Check that the assignment is included in the domain.
+    domain_map_[std::string(id)] = std::move(assignment);
+  } else {
+    const int64_t value = assignment.values.front();
+    CHECK(domain.Contains(value));
+    integer_map_[std::string(id)] = value;
+  }
+  return true;
+}
+
+bool Parser::ParseArrayDeclaration() {
+  Advance();
+  int64_t first_index;
+  int64_t num_constants;
+  if (!ExpectChar('[') || !ExpectInteger(&first_index) ||
+      !Expect(TOKEN_DOTDOT, "'..'") || !ExpectInteger(&num_constants) ||
+      !ExpectChar(']') || !Expect(TOKEN_OF, "'of'")) {
+    return false;
+  }
+  if (Is(TOKEN_VAR)) {
+    Advance();
+    return ParseVariableArrayDeclaration(first_index, num_constants);
+  }
+
+  // Declaration of a (named) constant array.
+  Domain domain;
+  DomainKind kind;
+  absl::string_view id;
+  std::vector<Annotation> annotations;
+  if (!ParseDomain(&domain, &kind) || !ExpectChar(':') ||
+      !ExpectIdentifier(&id) || !ParseAnnotations(&annotations) ||
+      !ExpectChar('=') || !ExpectChar('[')) {
+    return false;
+  }
+  CHECK_EQ(first_index, 1) << "Only [1..n] array are supported here.";
+  if (ConsumeChar(']')) {
+    CHECK_EQ(num_constants, 0) << "Empty arrays should have a size of 0";
+    if (kind == FLOAT_DOMAIN) {
+      float_array_map_[std::string(id)] = std::vector<double>();
+    } else {
+      integer_array_map_[std::string(id)] = std::vector<int64_t>();
+    }
+    return true;
+  }
+
+  switch (kind) {
+    case INT_DOMAIN: {
+      std::vector<int64_t> values;
+      if (!ParseIntegers(&values) || !ExpectChar(']')) return false;
+      CHECK_EQ(num_constants, values.size());
+      // TODO(user): CHECK all values within domain.
+      integer_array_map_[std::string(id)] = std::move(values);
+      return true;
+    }
+    case FLOAT_DOMAIN: {
+      std::vector<double> values;
+      if (!ParseFloats(&values) || !ExpectChar(']')) return false;
+      CHECK_EQ(num_constants, values.size());
+      // TODO(user): CHECK all values within domain.
+      float_array_map_[std::string(id)] = std::move(values);
+      return true;
+    }
+    case SET_DOMAIN: {
+      std::vector<Domain> assignments;
+      if (!ParseConstLiterals(&assignments) || !ExpectChar(']')) return false;
+      CHECK_EQ(num_constants, assignments.size());
+      if (!AllDomainsHaveOneValue(assignments)) {
+        // TODO(user): check that all assignments are included in the domain.
+        domain_array_map_[std::string(id)] = std::move(assignments);
+      } else {
+        std::vector<int64_t> values(num_constants);
+        for (int i = 0; i < num_constants; ++i) {
+          values[i] = assignments[i].values.front();
+          CHECK(domain.Contains(values[i]));
+        }
+        integer_array_map_[std::string(id)] = std::move(values);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Parser::ParseVariableDeclaration() {
+  // Declaration of a variable. If it's unassigned or assigned to a
+  // constant, we'll create a new var stored in the model. If it's
+  // assigned to another variable x then we simply adjust that
+  // existing variable x according to the current (re-)declaration.
+  Advance();
+  Domain domain;
+  DomainKind kind;
+  absl::string_view id;
+  std::vector<Annotation> annotations;
+  VarRefOrValue assignment;
+  if (!ParseDomain(&domain, &kind) || !ExpectChar(':') ||
+      !ExpectIdentifier(&id) || !ParseAnnotations(&annotations)) {
+    return false;
+  }
+  if (ConsumeChar('=') && !ParseVarOrValue(&assignment)) return false;
+
+  const bool introduced = ContainsId(annotations, "var_is_introduced") ||
+                          absl::StartsWith(id, "X_INTRODUCED");
+  Variable* var = nullptr;
+  if (!assignment.defined) {
+    var = model_->AddVariable(id, domain, introduced);
+  } else if (assignment.variable == nullptr) {  // just an integer constant.
+    CHECK(domain.Contains(assignment.value));
+    var = model_->AddVariable(id, Domain::IntegerValue(assignment.value),
+                              introduced);
+  } else {  // a variable.
+    var = assignment.variable;
+    var->Merge(id, domain, introduced);
+  }
+
+  // We also register the variable in the parser's context, and add some
+  // output to the model if needed.
+  variable_map_[std::string(id)] = var;
+  if (ContainsId(annotations, "output_var")) {
+    model_->AddOutput(SolutionOutputSpecs::SingleVariable(
+        id, var, domain.display_as_boolean));
+  }
+  return true;
+}
+
+bool Parser::ParseVariableArrayDeclaration(int64_t first_index,
+                                           int64_t num_vars) {
+  // Declaration of a "variable array": these is exactly like N simple
+  // variable declarations, where the identifier for declaration #i is
+  // IDENTIFIER[i] (1-based index).
+  Domain domain;
+  DomainKind kind;
+  absl::string_view id;
+  std::vector<Annotation> annotations;
+  if (!ParseDomain(&domain, &kind) || !ExpectChar(':') ||
+      !ExpectIdentifier(&id) || !ParseAnnotations(&annotations)) {
+    return false;
+  }
+  // Note that an empty assignment is the same as no assignment.
+  std::vector<VarRefOrValue> assignments;
+  if (ConsumeChar('=')) {
+    if (!ExpectChar('[')) return false;
+    if (!ConsumeChar(']')) {
+      if (!ParseVarOrValues(&assignments) || !ExpectChar(']')) return false;
+    }
+  }
+  CHECK_EQ(first_index, 1);
+  CHECK(assignments.empty() || assignments.size() == num_vars);
+  const bool introduced = ContainsId(annotations, "var_is_introduced") ||
+                          absl::StartsWith(id, "X_INTRODUCED");
+
+  std::vector<Variable*> vars(num_vars, nullptr);
+  for (int i = 0; i < num_vars; ++i) {
+    const std::string var_name = absl::StrCat(id, "[", i + 1, "]");
+    if (assignments.empty()) {
+      vars[i] = model_->AddVariable(var_name, domain, introduced);
+    } else if (assignments[i].variable == nullptr) {
+      if (assignments[i].is_float) {
+        // Assigned to an float constant.
+        const double value = assignments[i].float_value;
+        vars[i] = model_->AddVariable(var_name, Domain::FloatValue(value),
+                                      introduced);
+      } else {
+        // Assigned to an integer constant.
+        const int64_t value = assignments[i].value;
+        CHECK(domain.Contains(value));
+        vars[i] = model_->AddVariable(var_name, Domain::IntegerValue(value),
+                                      introduced);
+      }
+    } else {
+      vars[i] = assignments[i].variable;
+      vars[i]->Merge(var_name, domain, introduced);
+    }
+  }
+
+  // We parse the annotations to build an output object if
+  // needed. It's a bit more convoluted than the simple variable
+  // output.
+  for (const Annotation& ann : annotations) {
+    if (!ann.IsFunctionCallWithIdentifier("output_array")) continue;
+    CHECK_EQ(1, ann.annotations.size());
+    CHECK_EQ(Annotation::ANNOTATION_LIST, ann.annotations.back().type);
+    const Annotation& list = ann.annotations.back();
+    // Let's build the vector of bounds.
+    std::vector<SolutionOutputSpecs::Bounds> bounds;
+    for (const Annotation& bound : list.annotations) {
+      CHECK_EQ(Annotation::INTERVAL, bound.type);
+      bounds.emplace_back(bound.interval_min, bound.interval_max);
+    }
+    model_->AddOutput(SolutionOutputSpecs::MultiDimensionalArray(
+        id, bounds, vars, domain.display_as_boolean));
+  }
+
+  // Register the variable array on the context.
+  variable_array_map_[std::string(id)] = std::move(vars);
+  return true;
+}
+
+bool Parser::ParseConstraint() {
+  Advance();
+  absl::string_view id;
+  if (!ExpectIdentifier(&id) || !ExpectChar('(')) return false;
+  std::vector<Argument> arguments;
+  do {
+    arguments.emplace_back();
+    if (!ParseArgument(&arguments.back())) return false;
+  } while (ConsumeChar(','));
+  std::vector<Annotation> annotations;
+  if (!ExpectChar(')') || !ParseAnnotations(&annotations)) return false;
+  model_->AddConstraint(id, std::move(arguments),
+                        ContainsId(annotations, "domain"));
+  return true;
+}
+
+bool Parser::ParseSolve() {
+  std::vector<Annotation> annotations;
+  if (!Expect(TOKEN_SOLVE, "'solve'") || !ParseAnnotations(&annotations)) {
+    return false;
+  }
+  if (Is(TOKEN_SATISFY)) {
+    Advance();
+    model_->Satisfy(std::move(annotations));
+    return true;
+  }
+  if (!Is(TOKEN_MINIMIZE) && !Is(TOKEN_MAXIMIZE)) {
+    return SyntaxError("'satisfy', 'minimize' or 'maximize'");
+  }
+  const bool maximize = Is(TOKEN_MAXIMIZE);
+  Advance();
+  Argument argument;
+  if (!ParseArgument(&argument)) return false;
+  Variable* obj_var = argument.type == Argument::VAR_REF
+                          ? argument.Var()
+                          : model_->AddConstant(argument.Value());
+  if (maximize) {
+    model_->Maximize(obj_var, std::move(annotations));
+  } else {
+    model_->Minimize(obj_var, std::move(annotations));
+  }
+  return true;
+}
+
+bool Parser::ParseDomain(Domain* domain, DomainKind* kind) {
+  *kind = INT_DOMAIN;
+  switch (token_.type) {
+    case TOKEN_BOOL:
+      Advance();
+      *domain = Domain::Boolean();
+      return true;
+    case TOKEN_INT:
+      Advance();
+      *domain = Domain::AllInt64();
+      return true;
+    case TOKEN_INT_VALUE: {
+      const int64_t min_value = token_.integer_value;
+      int64_t max_value;
+      Advance();
+      if (!Expect(TOKEN_DOTDOT, "'..'") || !ExpectInteger(&max_value)) {
+        return false;
+      }
+      *domain = Domain::Interval(min_value, max_value);
+      return true;
+    }
+    case TOKEN_FLOAT:
+      Advance();
+      *kind = FLOAT_DOMAIN;
+      *domain = Domain::AllFloats();
+      return true;
+    case TOKEN_FLOAT_VALUE: {
+      const double lb = token_.float_value;
+      double ub;
+      Advance();
+      if (!Expect(TOKEN_DOTDOT, "'..'") || !ExpectFloat(&ub)) return false;
+      *kind = FLOAT_DOMAIN;
+      *domain = Domain::FloatInterval(lb, ub);
+      return true;
+    }
+    case TOKEN_SET: {
+      Advance();
+      if (!Expect(TOKEN_OF, "'of'")) return false;
+      *kind = SET_DOMAIN;
+      if (Is(TOKEN_BOOL)) {
+        Advance();
+        *domain = Domain::SetOfBoolean();
+      } else if (Is(TOKEN_INT)) {
+        Advance();
+        *domain = Domain::SetOfAllInt64();
+      } else if (Is(TOKEN_INT_VALUE)) {
+        const int64_t min_value = token_.integer_value;
+        int64_t max_value;
+        Advance();
+        if (!Expect(TOKEN_DOTDOT, "'..'") || !ExpectInteger(&max_value)) {
+          return false;
+        }
+        *domain = Domain::SetOfInterval(min_value, max_value);
+      } else {
+        std::vector<int64_t> values;
+        if (!ExpectChar('{') || !ParseIntegers(&values) || !ExpectChar('}')) {
+          return false;
+        }
+        *domain = Domain::SetOfIntegerList(std::move(values));
+      }
+      return true;
+    }
+    default: {
+      if (!IsChar('{')) return SyntaxError("domain");
+      Advance();
+      std::vector<int64_t> values;
+      if (!ParseIntegers(&values) || !ExpectChar('}')) return false;
+      *domain = Domain::IntegerList(std::move(values));
+      return true;
+    }
+  }
+}
+
+bool Parser::ParseInteger(int64_t* value) {
+  if (Is(TOKEN_INT_VALUE)) {
+    *value = token_.integer_value;
+    Advance();
+    return true;
+  }
+  absl::string_view id;
+  if (!ExpectIdentifier(&id)) return false;
+  if (ConsumeChar('[')) {
+    int64_t index;
+    if (!ExpectInteger(&index) || !ExpectChar(']')) return false;
+    *value = Lookup(FindOrDie(integer_array_map_, id), index);
+  } else {
+    *value = FindOrDie(integer_map_, id);
+  }
+  return true;
+}
+
+bool Parser::ParseIntegers(std::vector<int64_t>* values) {
+  do {
+    int64_t value;
+    if (!ParseInteger(&value)) return false;
+    values->push_back(value);
+  } while (ConsumeChar(','));
+  return true;
+}
+
+bool Parser::ParseFloat(double* value) {
+  if (Is(TOKEN_FLOAT_VALUE)) {
+    *value = token_.float_value;
+    Advance();
+    return true;
+  }
+  absl::string_view id;
+  if (!ExpectIdentifier(&id)) return false;
+  if (ConsumeChar('[')) {
+    int64_t index;
+    if (!ExpectInteger(&index) || !ExpectChar(']')) return false;
+    *value = Lookup(FindOrDie(float_array_map_, id), index);
+  } else {
+    *value = FindOrDie(float_map_, id);
+  }
+  return true;
+}
+
+bool Parser::ParseFloats(std::vector<double>* values) {
+  do {
+    double value;
+    if (!ParseFloat(&value)) return false;
+    values->push_back(value);
+  } while (ConsumeChar(','));
+  return true;
+}
+
+bool Parser::ParseConstLiteral(Domain* domain) {
+  if (Is(TOKEN_INT_VALUE)) {
+    const int64_t value = token_.integer_value;
+    Advance();
+    if (Is(TOKEN_DOTDOT)) {
+      Advance();
+      int64_t max_value;
+      if (!ExpectInteger(&max_value)) return false;
+      *domain = Domain::Interval(value, max_value);
+    } else {
+      *domain = Domain::IntegerValue(value);
+    }
+    return true;
+  }
+  if (Is(TOKEN_FLOAT_VALUE)) {
+    *domain = Domain::FloatValue(token_.float_value);
+    Advance();
+    return true;
+  }
+  if (ConsumeChar('{')) {
+    if (ConsumeChar('}')) {
+      *domain = Domain::EmptyDomain();
+      return true;
+    }
+    std::vector<int64_t> values;
+    if (!ParseIntegers(&values) || !ExpectChar('}')) return false;
+    *domain = Domain::IntegerList(std::move(values));
+    return true;
+  }
+  if (!Is(TOKEN_IDENTIFIER)) return SyntaxError("constant");
+  int64_t value;
+  if (!ParseInteger(&value)) return false;
+  *domain = Domain::IntegerValue(value);
+  return true;
+}
+
+bool Parser::ParseConstLiterals(std::vector<Domain>* domains) {
+  do {
+    domains->emplace_back();
+    if (!ParseConstLiteral(&domains->back())) return false;
+  } while (ConsumeChar(','));
+  return true;
+}
+
+bool Parser::ParseVarOrValue(VarRefOrValue* result) {
+  if (Is(TOKEN_INT_VALUE)) {
+    *result = VarRefOrValue::Value(token_.integer_value);
+    Advance();
+    return true;
+  }
+  if (Is(TOKEN_FLOAT_VALUE)) {
+    *result = VarRefOrValue::FloatValue(token_.float_value);
+    Advance();
+    return true;
+  }
+  absl::string_view id;
+  if (!ExpectIdentifier(&id)) return false;
+  if (ConsumeChar('[')) {
+    // A given element of an existing constant array or variable array.
+    int64_t index;
+    if (!ExpectInteger(&index) || !ExpectChar(']')) return false;
+    if (const auto* values = FindOrNull(integer_array_map_, id)) {
+      *result = VarRefOrValue::Value(Lookup(*values, index));
+    } else if (const auto* values = FindOrNull(float_array_map_, id)) {
+      *result = VarRefOrValue::FloatValue(Lookup(*values, index));
+    } else if (const auto* vars = FindOrNull(variable_array_map_, id)) {
+      *result = VarRefOrValue::VarRef(Lookup(*vars, index));
+    } else {
+      LOG(ERROR) << "Unknown symbol " << id;
+      *result = VarRefOrValue::Undefined();
+      ok_ = false;
+    }
+    return true;
+  }
+
+  // A reference to an existing integer constant or variable.
+  if (const int64_t* value = FindOrNull(integer_map_, id)) {
+    *result = VarRefOrValue::Value(*value);
+  } else if (const double* value = FindOrNull(float_map_, id)) {
+    *result = VarRefOrValue::FloatValue(*value);
+  } else if (Variable* const* var = FindOrNull(variable_map_, id)) {
+    *result = VarRefOrValue::VarRef(*var);
+  } else {
+    LOG(ERROR) << "Unknown symbol " << id;
+    *result = VarRefOrValue::Undefined();
+    ok_ = false;
+  }
+  return true;
+}
+
+bool Parser::ParseVarOrValues(std::vector<VarRefOrValue>* results) {
+  do {
+    results->emplace_back();
+    if (!ParseVarOrValue(&results->back())) return false;
+  } while (ConsumeChar(','));
+  return true;
+}
+
+bool Parser::ParseArgument(Argument* argument) {
+  switch (token_.type) {
+    case TOKEN_INT_VALUE: {
+      const int64_t value = token_.integer_value;
+      Advance();
+      if (Is(TOKEN_DOTDOT)) {
+        Advance();
+        int64_t max_value;
+        if (!ExpectInteger(&max_value)) return false;
+        *argument = Argument::Interval(value, max_value);
+      } else {
+        *argument = Argument::IntegerValue(value);
+      }
+      return true;
+    }
+    case TOKEN_FLOAT_VALUE:
+      *argument = Argument::FloatValue(token_.float_value);
+      Advance();
+      return true;
+    case TOKEN_STRING:
+      *argument = Argument::VoidArgument();
+      Advance();
+      return true;
+    case TOKEN_IDENTIFIER:
+      break;
+    default: {
+      if (ConsumeChar('{')) {
+        std::vector<int64_t> values;
+        if (!ParseIntegers(&values) || !ExpectChar('}')) return false;
+        *argument = Argument::IntegerList(std::move(values));
+        return true;
+      }
+      if (!ExpectChar('[')) return false;
+      if (ConsumeChar(']')) {
+        *argument = Argument::VoidArgument();
+        return true;
+      }
+      std::vector<VarRefOrValue> values;
+      if (!ParseVarOrValues(&values) || !ExpectChar(']')) return false;
+      bool has_variables = false;
+      bool has_floats = false;
+      for (const VarRefOrValue& data : values) {
+        if (data.variable != nullptr) has_variables = true;
+        if (data.is_float) has_floats = true;
+      }
+      if (has_variables) {
+        std::vector<Variable*> vars;
+        vars.reserve(values.size());
+        for (const VarRefOrValue& data : values) {
+          if (data.variable != nullptr) {
+            vars.push_back(data.variable);
+          } else if (!data.is_float) {
+            vars.push_back(model_->AddConstant(data.value));
+          } else {
+            vars.push_back(model_->AddFloatConstant(data.float_value));
+          }
+        }
+        *argument = Argument::VarRefArray(std::move(vars));
+      } else if (has_floats) {
+        std::vector<double> floats;
+        floats.reserve(values.size());
+        for (const VarRefOrValue& data : values) {
+          floats.push_back(data.is_float ? data.float_value : data.value);
+        }
+        *argument = Argument::FloatList(std::move(floats));
+      } else {
+        std::vector<int64_t> integers;
+        integers.reserve(values.size());
+        for (const VarRefOrValue& data : values) {
+          integers.push_back(data.value);
+        }
+        *argument = Argument::IntegerList(std::move(integers));
+      }
+      return true;
+    }
+  }
+
+  const absl::string_view id = token_.text;
+  Advance();
+  if (ConsumeChar('[')) {
+    int64_t index;
+    if (!ExpectInteger(&index) || !ExpectChar(']')) return false;
+    if (const auto* values = FindOrNull(integer_array_map_, id)) {
+      *argument = Argument::IntegerValue(Lookup(*values, index));
+    } else if (const auto* vars = FindOrNull(variable_array_map_, id)) {
+      *argument = Argument::VarRef(Lookup(*vars, index));
+    } else {
+      *argument = Argument::FromDomain(
+          Lookup(FindOrDie(domain_array_map_, id), index));
+    }
+    return true;
+  }
+  if (const int64_t* value = FindOrNull(integer_map_, id)) {
+    *argument = Argument::IntegerValue(*value);
+  } else if (const auto* values = FindOrNull(integer_array_map_, id)) {
+    *argument = Argument::IntegerList(*values);
+  } else if (const double* value = FindOrNull(float_map_, id)) {
+    *argument = Argument::FloatValue(*value);
+  } else if (const auto* values = FindOrNull(float_array_map_, id)) {
+    *argument = Argument::FloatList(*values);
+  } else if (Variable* const* var = FindOrNull(variable_map_, id)) {
+    *argument = Argument::VarRef(*var);
+  } else if (const auto* vars = FindOrNull(variable_array_map_, id)) {
+    *argument = Argument::VarRefArray(*vars);
+  } else if (const Domain* domain = FindOrNull(domain_map_, id)) {
+    *argument = Argument::FromDomain(*domain);
+  } else {
+    *argument = Argument::DomainList(FindOrDie(domain_array_map_, id));
+  }
+  return true;
+}
+
+bool Parser::ParseAnnotations(std::vector<Annotation>* annotations) {
+  while (Is(TOKEN_COLONCOLON)) {
+    Advance();
+    annotations->emplace_back();
+    if (!ParseAnnotation(&annotations->back())) return false;
+  }
+  return true;
+}
+
+bool Parser::ParseAnnotationArguments(std::vector<Annotation>* annotations) {
+  do {
+    annotations->emplace_back();
+    if (!ParseAnnotation(&annotations->back())) return false;
+  } while (ConsumeChar(','));
+  return true;
+}
+
+bool Parser::ParseAnnotation(Annotation* annotation) {
+  if (Is(TOKEN_INT_VALUE)) {
+    const int64_t value = token_.integer_value;
+    Advance();
+    if (Is(TOKEN_DOTDOT)) {
+      Advance();
+      int64_t max_value;
+      if (!ExpectInteger(&max_value)) return false;
+      *annotation = Annotation::Interval(value, max_value);
+    } else {
+      *annotation = Annotation::IntegerValue(value);
+    }
+    return true;
+  }
+  if (Is(TOKEN_STRING)) {
+    *annotation = Annotation::String(token_.text);
+    Advance();
+    return true;
+  }
+  if (ConsumeChar('[')) {
+    if (ConsumeChar(']')) {
+      *annotation = Annotation::Empty();
+      return true;
+    }
+    std::vector<Annotation> annotations;
+    if (!ParseAnnotationArguments(&annotations) || !ExpectChar(']')) {
+      return false;
+    }
+    bool all_integers = true;
+    bool all_vars = true;
+    for (const Annotation& ann : annotations) {
+      if (ann.type != Annotation::INT_VALUE) all_integers = false;
+      if (ann.type != Annotation::VAR_REF) all_vars = false;
+    }
+    if (all_integers) {
+      std::vector<int64_t> values;
+      for (const Annotation& ann : annotations) {
+        values.push_back(ann.interval_min);
+      }
+      *annotation = Annotation::IntegerList(values);
+    } else if (all_vars) {
+      std::vector<Variable*> vars;
+      for (const Annotation& ann : annotations) {
+        vars.push_back(ann.variables[0]);
+      }
+      *annotation = Annotation::VarRefArray(std::move(vars));
+    } else {
+      *annotation = Annotation::AnnotationList(std::move(annotations));
+    }
+    return true;
+  }
+
+  absl::string_view id;
+  if (!ExpectIdentifier(&id)) return false;
+  if (ConsumeChar('(')) {
+    std::vector<Annotation> arguments;
+    if (!ParseAnnotationArguments(&arguments) || !ExpectChar(')')) {
+      return false;
+    }
+    *annotation =
+        Annotation::FunctionCallWithArguments(id, std::move(arguments));
+    return true;
+  }
+  if (ConsumeChar('[')) {
+    int64_t index;
+    if (!ExpectInteger(&index) || !ExpectChar(']')) return false;
+    *annotation =
+        Annotation::VarRef(Lookup(FindOrDie(variable_array_map_, id), index));
+    return true;
+  }
+  if (Variable* const* var = FindOrNull(variable_map_, id)) {
+    *annotation = Annotation::VarRef(*var);
+  } else if (const auto* vars = FindOrNull(variable_array_map_, id)) {
+    *annotation = Annotation::VarRefArray(*vars);
+  } else if (const int64_t* value = FindOrNull(integer_map_, id)) {
+    *annotation = Annotation::IntegerValue(*value);
+  } else if (const auto* values = FindOrNull(integer_array_map_, id)) {
+    *annotation = Annotation::IntegerList(*values);
+  } else {
+    *annotation = Annotation::Identifier(id);
+  }
+  return true;
+}
+
+}  // namespace
+
 // ----- public parsing API -----
 
 bool ParseFlatzincFile(const std::string& filename, Model* model) {
-  // Init.
-  FILE* const input = fopen(filename.c_str(), "r");
-  if (input == nullptr) {
+#if defined(__linux__) || defined(__APPLE__)
+  // We map the file in memory, so that large models are read in one pass
+  // without any copy.
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
     LOG(INFO) << "Could not open file '" << filename << "'";
     return false;
   }
-  ParserContext context;
-  // Add known constants.
-  context.integer_map["true"] = 1;
-  context.integer_map["false"] = 0;
-  bool ok = true;
-  void* scanner = nullptr;
-  orfz_lex_init(&scanner);
-  orfz_set_in(input, scanner);
-  // Parse.
-  orfz_parse(&context, model, &ok, scanner);
-  // Clean up.
-  if (scanner != nullptr) {
-    orfz_lex_destroy(scanner);
-  }
-  fclose(input);
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    LOG(INFO) << "Could not read file '" << filename << "'";
+    close(fd);
+    return false;
+  }
+  const size_t size = file_stat.st_size;
+  if (size == 0) {
+    close(fd);
+    return Parser(absl::string_view(), model).Parse();
+  }
+  void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG(INFO) << "Could not map file '" << filename << "'";
+    return false;
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+  const bool ok =
+      Parser(absl::string_view(static_cast<const char*>(data), size), model)
+          .Parse();
+  munmap(data, size);
   return ok;
+#else
+  std::ifstream input(filename, std::ios::binary);
+  if (!input) {
+    LOG(INFO) << "Could not open file '" << filename << "'";
+    return false;
+  }
+  std::ostringstream content;
+  content << input.rdbuf();
+  return ParseFlatzincString(content.str(), model);
+#endif
 }
 
 bool ParseFlatzincString(const std::string& input, Model* model) {
-  // Init.
-  ParserContext context;
-  // Add known constants.
-  context.integer_map["true"] = 1;
-  context.integer_map["false"] = 0;
-  bool ok = true;
-  void* scanner = nullptr;
-  orfz_lex_init(&scanner);
-  yy_buffer_state* const string_buffer =
-      orfz__scan_bytes(input.data(), input.size(), scanner);
-  // Parse.
-  orfz_parse(&context, model, &ok, scanner);
-  // Clean up.
-  if (string_buffer != nullptr) {
-    orfz__delete_buffer(string_buffer, scanner);
-  }
-  if (scanner != nullptr) {
-    orfz_lex_destroy(scanner);
-  }
-  return ok;
+  return Parser(input, model).Parse();
 }
 }  // namespace fz
 }  // namespace operations_research
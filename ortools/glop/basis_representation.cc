@@ -201,6 +201,7 @@ void BasisFactorization::Clear() {
   eta_factorization_.Clear();
   lu_factorization_.Clear();
   rank_one_factorization_.Clear();
+  forrest_tomlin_.Clear();
   storage_.Reset(compact_matrix_.num_rows());
   right_storage_.Reset(compact_matrix_.num_rows());
   left_pool_mapping_.clear();
@@ -257,14 +258,10 @@ Status BasisFactorization::ComputeFactorization() {
 //    right_update_vector - U.column(leaving_column), left_update_vector)
 Status BasisFactorization::MiddleProductFormUpdate(
     ColIndex entering_col, RowIndex leaving_variable_row) {
-  const ColIndex right_index = entering_col < right_pool_mapping_.size()
-                                   ? right_pool_mapping_[entering_col]
-                                   : kInvalidCol;
-  const ColIndex left_index =
-      RowToColIndex(leaving_variable_row) < left_pool_mapping_.size()
-          ? left_pool_mapping_[RowToColIndex(leaving_variable_row)]
-          : kInvalidCol;
-  if (right_index == kInvalidCol || left_index == kInvalidCol) {
+  ColIndex left_index;
+  ColIndex right_index;
+  if (!GetUpdateVectors(entering_col, leaving_variable_row, &left_index,
+                        &right_index)) {
     LOG(INFO) << "One update vector is missing!!!";
     return ForceRefactorization();
   }
@@ -301,6 +298,45 @@ Status BasisFactorization::MiddleProductFormUpdate(
   return Status::OK();
 }
 
+bool BasisFactorization::GetUpdateVectors(ColIndex entering_col,
+                                          RowIndex leaving_variable_row,
+                                          ColIndex* left_index,
+                                          ColIndex* right_index) const {
+  *right_index = entering_col < right_pool_mapping_.size()
+                     ? right_pool_mapping_[entering_col]
+                     : kInvalidCol;
+  *left_index = RowToColIndex(leaving_variable_row) < left_pool_mapping_.size()
+                    ? left_pool_mapping_[RowToColIndex(leaving_variable_row)]
+                    : kInvalidCol;
+  return *right_index != kInvalidCol && *left_index != kInvalidCol;
+}
+
+// The left and right update vectors are exactly what the Forrest-Tomlin update
+// needs: e_r.U^{-1} and the entering column after L and the row etas.
+Status BasisFactorization::ForrestTomlinUpdate(ColIndex entering_col,
+                                               RowIndex leaving_variable_row) {
+  ColIndex left_index;
+  ColIndex right_index;
+  if (!GetUpdateVectors(entering_col, leaving_variable_row, &left_index,
+                        &right_index)) {
+    LOG(INFO) << "One update vector is missing!!!";
+    return ForceRefactorization();
+  }
+  if (!forrest_tomlin_.IsInitialized()) {
+    forrest_tomlin_.Initialize(lu_factorization_, compact_matrix_.num_rows());
+  }
+  GLOP_RETURN_IF_ERROR(
+      forrest_tomlin_.Update(leaving_variable_row,
+                             right_storage_.column(right_index),
+                             storage_.column(left_index)));
+
+  // The stored vectors depend on the factorization, so they cannot be reused
+  // after an update.
+  left_pool_mapping_.clear();
+  right_pool_mapping_.clear();
+  return Status::OK();
+}
+
 Status BasisFactorization::Update(ColIndex entering_col,
                                   RowIndex leaving_variable_row,
                                   const ScatteredColumn& direction) {
@@ -318,8 +354,11 @@ Status BasisFactorization::Update(ColIndex entering_col,
     // Note(user): The deterministic time is not really super precise for now.
     // We tend to undercount the factorization, but this tends to favorize more
     // refactorization which is good for numerical stability.
-    if (last_factorization_deterministic_time_ <
-        rank_one_factorization_.DeterministicTimeSinceLastReset()) {
+    const double update_deterministic_time =
+        use_forrest_tomlin_update_
+            ? forrest_tomlin_.DeterministicTimeSinceLastReset()
+            : rank_one_factorization_.DeterministicTimeSinceLastReset();
+    if (last_factorization_deterministic_time_ < update_deterministic_time) {
       return ForceRefactorization();
     }
   }
@@ -329,7 +368,10 @@ Status BasisFactorization::Update(ColIndex entering_col,
   // increment num_updates_ first as this counter is used by IsRefactorized().
   SCOPED_TIME_STAT(&stats_);
   ++num_updates_;
-  if (use_middle_product_form_update_) {
+  if (use_forrest_tomlin_update_) {
+    GLOP_RETURN_IF_ERROR(
+        ForrestTomlinUpdate(entering_col, leaving_variable_row));
+  } else if (use_middle_product_form_update_) {
     GLOP_RETURN_IF_ERROR(
         MiddleProductFormUpdate(entering_col, leaving_variable_row));
   } else {
@@ -343,8 +385,8 @@ void BasisFactorization::LeftSolve(ScatteredRow* y) const {
   SCOPED_TIME_STAT(&stats_);
   RETURN_IF_NULL(y);
   if (use_middle_product_form_update_) {
-    lu_factorization_.LeftSolveUWithNonZeros(y);
-    rank_one_factorization_.LeftSolveWithNonZeros(y);
+    LeftSolveU(y);
+    LeftSolveWithUpdates(y);
     lu_factorization_.LeftSolveLWithNonZeros(y);
     y->SortNonZerosIfNeeded();
   } else {
@@ -360,8 +402,8 @@ void BasisFactorization::RightSolve(ScatteredColumn* d) const {
   RETURN_IF_NULL(d);
   if (use_middle_product_form_update_) {
     lu_factorization_.RightSolveLWithNonZeros(d);
-    rank_one_factorization_.RightSolveWithNonZeros(d);
-    lu_factorization_.RightSolveUWithNonZeros(d);
+    RightSolveWithUpdates(d);
+    RightSolveU(d);
     d->SortNonZerosIfNeeded();
   } else {
     d->non_zeros.clear();
@@ -384,8 +426,8 @@ const DenseColumn& BasisFactorization::RightSolveForTau(
       ClearAndResizeVectorWithNonZeros(compact_matrix_.num_rows(), &tau_);
       lu_factorization_.RightSolveLForScatteredColumn(a, &tau_);
     }
-    rank_one_factorization_.RightSolveWithNonZeros(&tau_);
-    lu_factorization_.RightSolveUWithNonZeros(&tau_);
+    RightSolveWithUpdates(&tau_);
+    RightSolveU(&tau_);
   } else {
     tau_.non_zeros.clear();
     tau_.values = a.values;
@@ -420,7 +462,12 @@ void BasisFactorization::LeftSolveForUnitRow(ColIndex j,
     left_pool_mapping_.resize(j + 1, kInvalidCol);
   }
   if (left_pool_mapping_[j] == kInvalidCol) {
-    const ColIndex start = lu_factorization_.LeftSolveUForUnitRow(j, y);
+    ColIndex start(0);
+    if (forrest_tomlin_.IsInitialized()) {
+      forrest_tomlin_.LeftSolveUForUnitRow(j, y);
+    } else {
+      start = lu_factorization_.LeftSolveUForUnitRow(j, y);
+    }
     if (y->non_zeros.empty()) {
       left_pool_mapping_[j] = storage_.AddDenseColumnPrefix(
           Transpose(y->values).const_view(), ColToRowIndex(start));
@@ -436,7 +483,7 @@ void BasisFactorization::LeftSolveForUnitRow(ColIndex j,
                                                         x, nz);
   }
 
-  rank_one_factorization_.LeftSolveWithNonZeros(y);
+  LeftSolveWithUpdates(y);
 
   // We only keep the intermediate result needed for the optimized tau_
   // computation if it was computed after the last time this was called.
@@ -482,7 +529,7 @@ void BasisFactorization::RightSolveForProblemColumn(ColIndex col,
   // TODO(user): if right_pool_mapping_[col] != kInvalidCol, we can reuse it and
   // just apply the last rank one update since it was computed.
   lu_factorization_.RightSolveLForColumnView(compact_matrix_.column(col), d);
-  rank_one_factorization_.RightSolveWithNonZeros(d);
+  RightSolveWithUpdates(d);
   if (col >= right_pool_mapping_.size()) {
     right_pool_mapping_.resize(col + 1, kInvalidCol);
   }
@@ -495,11 +542,43 @@ void BasisFactorization::RightSolveForProblemColumn(ColIndex col,
     right_pool_mapping_[col] =
         right_storage_.AddDenseColumnWithNonZeros(d->values, d->non_zeros);
   }
-  lu_factorization_.RightSolveUWithNonZeros(d);
+  RightSolveU(d);
   d->SortNonZerosIfNeeded();
   BumpDeterministicTimeForSolve(d->NumNonZerosEstimate());
 }
 
+void BasisFactorization::RightSolveWithUpdates(ScatteredColumn* d) const {
+  if (use_forrest_tomlin_update_) {
+    forrest_tomlin_.RightSolveWithRowEtas(d);
+  } else {
+    rank_one_factorization_.RightSolveWithNonZeros(d);
+  }
+}
+
+void BasisFactorization::RightSolveU(ScatteredColumn* d) const {
+  if (forrest_tomlin_.IsInitialized()) {
+    forrest_tomlin_.RightSolveU(d);
+  } else {
+    lu_factorization_.RightSolveUWithNonZeros(d);
+  }
+}
+
+void BasisFactorization::LeftSolveWithUpdates(ScatteredRow* y) const {
+  if (use_forrest_tomlin_update_) {
+    forrest_tomlin_.LeftSolveWithRowEtas(y);
+  } else {
+    rank_one_factorization_.LeftSolveWithNonZeros(y);
+  }
+}
+
+void BasisFactorization::LeftSolveU(ScatteredRow* y) const {
+  if (forrest_tomlin_.IsInitialized()) {
+    forrest_tomlin_.LeftSolveU(y);
+  } else {
+    lu_factorization_.LeftSolveUWithNonZeros(y);
+  }
+}
+
 Fractional BasisFactorization::RightSolveSquaredNorm(
     const ColumnView& a) const {
   SCOPED_TIME_STAT(&stats_);
@@ -515,6 +594,34 @@ Fractional BasisFactorization::DualEdgeSquaredNorm(RowIndex row) const {
   return lu_factorization_.DualEdgeSquaredNorm(row);
 }
 
+void BasisFactorization::ComputeDualEdgeSquaredNorms(
+    const ParallelColumnLoop& parallel_loop, DenseColumn* norms) const {
+  SCOPED_TIME_STAT(&stats_);
+  DCHECK(IsRefactorized());
+  const RowIndex num_rows = GetNumberOfRows();
+  norms->resize(num_rows, 0.0);
+  const int num_blocks = parallel_loop.NumBlocks(num_rows.value());
+  if (num_blocks == 1) {
+    // The sequential version also benefits from the density predictions of
+    // the triangular factors.
+    for (RowIndex row(0); row < num_rows; ++row) {
+      (*norms)[row] = DualEdgeSquaredNorm(row);
+    }
+    return;
+  }
+
+  std::vector<LuFactorization::SolveScratchpad> scratchpads(num_blocks);
+  parallel_loop.Run(num_rows.value(), [&](int block, int begin, int end) {
+    LuFactorization::SolveScratchpad* scratchpad = &scratchpads[block];
+    for (RowIndex row(begin); row < RowIndex(end); ++row) {
+      (*norms)[row] = lu_factorization_.DualEdgeSquaredNorm(row, scratchpad);
+    }
+  });
+  for (RowIndex row(0); row < num_rows; ++row) {
+    BumpDeterministicTimeForSolve(1);
+  }
+}
+
 bool BasisFactorization::IsIdentityBasis() const {
   const RowIndex num_rows = compact_matrix_.num_rows();
   for (RowIndex row(0); row < num_rows; ++row) {
@@ -620,7 +727,9 @@ void BasisFactorization::BumpDeterministicTimeForSolve(int num_entries) const {
       density * DeterministicTimeForFpOperations(
                     lu_factorization_.NumberOfEntries().value()) +
       DeterministicTimeForFpOperations(
-          rank_one_factorization_.num_entries().value());
+          (rank_one_factorization_.num_entries() +
+           forrest_tomlin_.num_update_entries())
+              .value());
 }
 
 }  // namespace glop
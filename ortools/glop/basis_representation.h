@@ -18,7 +18,9 @@
 #include <vector>
 
 #include "ortools/base/logging.h"
+#include "ortools/glop/forrest_tomlin.h"
 #include "ortools/glop/lu_factorization.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/rank_one_update.h"
 #include "ortools/glop/status.h"
@@ -171,8 +173,13 @@ class BasisFactorization {
   // Sets the parameters for this component.
   void SetParameters(const GlopParameters& parameters) {
     max_num_updates_ = parameters.basis_refactorization_period();
+    use_forrest_tomlin_update_ = parameters.use_forrest_tomlin_update();
+
+    // The Forrest-Tomlin update uses the same code path and update vectors as
+    // the middle product form, only the factors applied after L differ.
     use_middle_product_form_update_ =
-        parameters.use_middle_product_form_update();
+        parameters.use_middle_product_form_update() ||
+        use_forrest_tomlin_update_;
     parameters_ = parameters;
     lu_factorization_.SetParameters(parameters);
   }
@@ -270,6 +277,13 @@ class BasisFactorization {
   // It can be called only when IsRefactorized() is true.
   Fractional DualEdgeSquaredNorm(RowIndex row) const;
 
+  // Fills norms with the DualEdgeSquaredNorm() of all the rows. The solves are
+  // split between the threads of the given loop, but the result and the
+  // deterministic time do not depend on their number.
+  // It can be called only when IsRefactorized() is true.
+  void ComputeDualEdgeSquaredNorms(const ParallelColumnLoop& parallel_loop,
+                                   DenseColumn* norms) const;
+
   // Computes the condition number of B.
   // For a given norm, this is the matrix norm times the norm of its inverse.
   // A condition number greater than 1E7 will lead to precision problems.
@@ -324,6 +338,26 @@ class BasisFactorization {
   ABSL_MUST_USE_RESULT Status
   MiddleProductFormUpdate(ColIndex entering_col, RowIndex leaving_variable_row);
 
+  // Updates the factorization using the Forrest-Tomlin update. It uses the
+  // same update vectors as MiddleProductFormUpdate().
+  ABSL_MUST_USE_RESULT Status
+  ForrestTomlinUpdate(ColIndex entering_col, RowIndex leaving_variable_row);
+
+  // Returns false if the update vectors computed by the last
+  // LeftSolveForUnitRow() and RightSolveForProblemColumn() do not correspond to
+  // the given update. Otherwise, fills their index in storage_ and
+  // right_storage_.
+  bool GetUpdateVectors(ColIndex entering_col, RowIndex leaving_variable_row,
+                        ColIndex* left_index, ColIndex* right_index) const;
+
+  // In the middle product form mode, these apply the part of the solves after
+  // the L factor: the rank one updates or the Forrest-Tomlin row etas, and the
+  // U factor.
+  void RightSolveWithUpdates(ScatteredColumn* d) const;
+  void RightSolveU(ScatteredColumn* d) const;
+  void LeftSolveWithUpdates(ScatteredRow* y) const;
+  void LeftSolveU(ScatteredRow* y) const;
+
   // Increases the deterministic time for a solve operation with a vector having
   // this number of non-zero entries (it can be an approximation).
   void BumpDeterministicTimeForSolve(int num_entries) const;
@@ -385,11 +419,16 @@ class BasisFactorization {
   mutable ColMapping right_pool_mapping_;
 
   bool use_middle_product_form_update_;
+  bool use_forrest_tomlin_update_;
   int max_num_updates_;
   int num_updates_;
   EtaFactorization eta_factorization_;
   LuFactorization lu_factorization_;
 
+  // Only initialized at the first Forrest-Tomlin update after a factorization,
+  // the solves use lu_factorization_ directly before that.
+  ForrestTomlinFactorization forrest_tomlin_;
+
   // mutable because the Solve() functions are const but need to update this.
   double last_factorization_deterministic_time_ = 0.0;
   mutable double deterministic_time_;
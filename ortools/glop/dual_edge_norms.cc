@@ -20,8 +20,10 @@
 namespace operations_research {
 namespace glop {
 
-DualEdgeNorms::DualEdgeNorms(const BasisFactorization& basis_factorization)
+DualEdgeNorms::DualEdgeNorms(const BasisFactorization& basis_factorization,
+                             const ParallelColumnLoop& parallel_loop)
     : basis_factorization_(basis_factorization),
+      parallel_loop_(parallel_loop),
       recompute_edge_squared_norms_(true) {}
 
 bool DualEdgeNorms::NeedsBasisRefactorization() const {
@@ -39,6 +41,12 @@ DenseColumn::ConstView DualEdgeNorms::GetEdgeSquaredNorms() {
   return edge_squared_norms_.const_view();
 }
 
+void DualEdgeNorms::SetEdgeSquaredNorms(const DenseColumn& norms) {
+  DCHECK_EQ(norms.size(), basis_factorization_.GetNumberOfRows());
+  edge_squared_norms_ = norms;
+  recompute_edge_squared_norms_ = false;
+}
+
 void DualEdgeNorms::UpdateDataOnBasisPermutation(
     const ColumnPermutation& col_perm) {
   if (recompute_edge_squared_norms_) return;
@@ -123,11 +131,8 @@ void DualEdgeNorms::ComputeEdgeSquaredNorms() {
   // Since we will do a lot of inversions, it is better to be as efficient and
   // precise as possible by having a refactorized basis.
   DCHECK(basis_factorization_.IsRefactorized());
-  const RowIndex num_rows = basis_factorization_.GetNumberOfRows();
-  edge_squared_norms_.resize(num_rows, 0.0);
-  for (RowIndex row(0); row < num_rows; ++row) {
-    edge_squared_norms_[row] = basis_factorization_.DualEdgeSquaredNorm(row);
-  }
+  basis_factorization_.ComputeDualEdgeSquaredNorms(parallel_loop_,
+                                                   &edge_squared_norms_);
   recompute_edge_squared_norms_ = false;
 }
 
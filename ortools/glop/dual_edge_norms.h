@@ -17,6 +17,7 @@
 #include <string>
 
 #include "ortools/glop/basis_representation.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/lp_data/lp_data.h"
 #include "ortools/lp_data/lp_types.h"
@@ -49,7 +50,8 @@ namespace glop {
 class DualEdgeNorms {
  public:
   // Takes references to the linear program data we need.
-  explicit DualEdgeNorms(const BasisFactorization& basis_factorization);
+  DualEdgeNorms(const BasisFactorization& basis_factorization,
+                const ParallelColumnLoop& parallel_loop);
 
   // This type is neither copyable nor movable.
   DualEdgeNorms(const DualEdgeNorms&) = delete;
@@ -77,6 +79,17 @@ class DualEdgeNorms {
   // called Clear().
   DenseColumn::ConstView GetEdgeSquaredNorms();
 
+  // Returns the current norms without recomputing them. They are only
+  // meaningful if NeedsBasisRefactorization() is false.
+  const DenseColumn& GetCurrentEdgeSquaredNorms() const {
+    return edge_squared_norms_;
+  }
+
+  // Uses the given norms, indexed by the rows of the current basis, instead of
+  // recomputing them on the next GetEdgeSquaredNorms(). This is used to warm
+  // start from the norms of a previous solve with the same basis.
+  void SetEdgeSquaredNorms(const DenseColumn& norms);
+
   // Updates the norms if the columns of the basis where permuted.
   void UpdateDataOnBasisPermutation(const ColumnPermutation& col_perm);
 
@@ -109,6 +122,8 @@ class DualEdgeNorms {
   // Recomputes the dual edge squared norms from scratch with maximum precision.
   // The matrix must have been refactorized before because we will do a lot of
   // inversions. See NeedsBasisRefactorization(). This is checked in debug mode.
+  // The inversions are independent, so they are split between the threads of
+  // parallel_loop_.
   void ComputeEdgeSquaredNorms();
 
   // Computes the vector tau needed to update the norms using a right solve:
@@ -133,6 +148,7 @@ class DualEdgeNorms {
 
   // Problem data that should be updated from outside.
   const BasisFactorization& basis_factorization_;
+  const ParallelColumnLoop& parallel_loop_;
 
   // The dual edge norms.
   DenseColumn edge_squared_norms_;
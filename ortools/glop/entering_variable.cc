@@ -67,6 +67,9 @@ Status EnteringVariable::DualChooseEnteringColumn(
 
   Fractional variation_magnitude = std::abs(cost_variation) - threshold;
 
+  // Without bound flipping, boxed variables are processed like the others.
+  const bool use_bound_flipping = parameters_.use_dual_bound_flipping();
+
   // Harris ratio test. See below for more explanation. Here this is used to
   // prune the first pass by not enqueueing ColWithRatio for columns that have
   // a ratio greater than the current harris_ratio.
@@ -108,7 +111,7 @@ Status EnteringVariable::DualChooseEnteringColumn(
         std::max(minimum_delta / entry.coeff_magnitude,
                  entry.ratio + harris_tolerance / entry.coeff_magnitude);
     if (hr < harris_ratio) {
-      if (is_boxed[col]) {
+      if (use_bound_flipping && is_boxed[col]) {
         const Fractional delta =
             variables_info_.GetBoundDifference(col) * entry.coeff_magnitude;
         if (delta >= variation_magnitude) {
@@ -160,7 +163,7 @@ Status EnteringVariable::DualChooseEnteringColumn(
     //
     // Note that the actual flipping will be done afterwards by
     // MakeBoxedVariableDualFeasible() in revised_simplex.cc.
-    if (variation_magnitude > 0.0) {
+    if (use_bound_flipping && variation_magnitude > 0.0) {
       if (is_boxed[top.col]) {
         variation_magnitude -=
             variables_info_.GetBoundDifference(top.col) * top.coeff_magnitude;
@@ -220,6 +223,7 @@ Status EnteringVariable::DualChooseEnteringColumn(
         stats_.num_perfect_ties.Add(equivalent_entering_choices_.size()));
   }
 
+  IF_STATS_ENABLED(stats_.num_bound_flips.Add(bound_flip_candidates->size()));
   if (*entering_col == kInvalidCol) return Status::OK();
 
   // If best_coeff is small and they are potential bound flips, we can take a
@@ -98,8 +98,10 @@ class EnteringVariable {
   struct Stats : public StatsGroup {
     Stats()
         : StatsGroup("EnteringVariable"),
-          num_perfect_ties("num_perfect_ties", this) {}
+          num_perfect_ties("num_perfect_ties", this),
+          num_bound_flips("num_bound_flips", this) {}
     IntegerDistribution num_perfect_ties;
+    IntegerDistribution num_bound_flips;
   };
   Stats stats_;
 
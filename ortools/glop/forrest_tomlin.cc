@@ -0,0 +1,264 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/glop/forrest_tomlin.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "ortools/base/logging.h"
+#include "ortools/lp_data/lp_utils.h"
+
+namespace operations_research {
+namespace glop {
+
+void ForrestTomlinFactorization::Clear() {
+  is_initialized_ = false;
+  diagonal_.clear();
+  pivot_row_.clear();
+  position_of_id_.clear();
+  id_of_position_.clear();
+  order_.clear();
+  rank_.clear();
+  eta_pivot_row_.clear();
+  upper_.Reset(RowIndex(0));
+  row_etas_.Reset(RowIndex(0));
+  initial_num_entries_ = EntryIndex(0);
+  dtime_ = 0.0;
+}
+
+void ForrestTomlinFactorization::Initialize(
+    const LuFactorization& lu_factorization, RowIndex num_rows) {
+  Clear();
+  num_rows_ = num_rows;
+  upper_.Reset(num_rows);
+  row_etas_.Reset(num_rows);
+  scratchpad_.AssignToZero(num_rows);
+  scratchpad_non_zeros_.clear();
+  for (RowIndex row(0); row < num_rows; ++row) {
+    const ColIndex col = RowToColIndex(row);
+    Fractional diagonal = 0.0;
+    for (const SparseColumn::Entry e : lu_factorization.GetColumnOfU(col)) {
+      if (e.row() == row) {
+        diagonal = e.coefficient();
+        continue;
+      }
+      DCHECK_LT(e.row(), row);
+      scratchpad_[e.row()] = e.coefficient();
+      scratchpad_non_zeros_.push_back(e.row());
+    }
+    DCHECK_NE(diagonal, 0.0);
+    upper_.AddAndClearColumnWithNonZeros(&scratchpad_, &scratchpad_non_zeros_);
+    diagonal_.push_back(diagonal);
+    pivot_row_.push_back(row);
+    position_of_id_.push_back(row);
+    id_of_position_.push_back(col);
+    order_.push_back(col);
+    rank_.push_back(col.value());
+  }
+  initial_num_entries_ = upper_.num_entries();
+  is_initialized_ = true;
+}
+
+// With the notation of the class comment, let W be U_k with the column at the
+// given position replaced by the spike s. W is upper triangular in our order
+// except for the pivot row t of the replaced column, whose entries after the
+// new column (which we put last) must be eliminated. The row eta
+// R = I - e_t.mu^T does it with mu_i = -u_tt.y_i for i != t, where
+// y = e_position.U_k^{-1} is the given left vector. Indeed, y.U_k = e_position
+// gives y_t.u_tt = 1 and row_t(U_k) = -sum_{i != t} (y_i / y_t).row_i(U_k) on
+// all the other columns after the replaced one. The new diagonal is then the
+// row t of R.s.
+Status ForrestTomlinFactorization::Update(RowIndex position, ColumnView spike,
+                                          ColumnView left) {
+  DCHECK(is_initialized_);
+  const ColIndex old_id = id_of_position_[position];
+  const RowIndex pivot_row = pivot_row_[old_id];
+  const Fractional old_diagonal = diagonal_[old_id];
+
+  DCHECK(IsAllZero(scratchpad_));
+  for (const SparseColumn::Entry e : left) {
+    if (e.row() == pivot_row) continue;
+    scratchpad_[e.row()] = -old_diagonal * e.coefficient();
+    scratchpad_non_zeros_.push_back(e.row());
+  }
+  Fractional new_diagonal = 0.0;
+  for (const SparseColumn::Entry e : spike) {
+    if (e.row() == pivot_row) {
+      new_diagonal += e.coefficient();
+    } else {
+      new_diagonal -= scratchpad_[e.row()] * e.coefficient();
+    }
+  }
+  if (new_diagonal == 0.0) {
+    for (const RowIndex row : scratchpad_non_zeros_) scratchpad_[row] = 0.0;
+    scratchpad_non_zeros_.clear();
+    GLOP_RETURN_AND_LOG_ERROR(Status::ERROR_LU,
+                              "Singular Forrest-Tomlin update.");
+  }
+  if (!scratchpad_non_zeros_.empty()) {
+    row_etas_.AddAndClearColumnWithNonZeros(&scratchpad_,
+                                            &scratchpad_non_zeros_);
+    eta_pivot_row_.push_back(pivot_row);
+  }
+
+  // Adds the new column, its entry on the pivot row is the diagonal.
+  for (const SparseColumn::Entry e : spike) {
+    if (e.row() == pivot_row) continue;
+    scratchpad_[e.row()] = e.coefficient();
+    scratchpad_non_zeros_.push_back(e.row());
+  }
+  const ColIndex new_id = upper_.AddAndClearColumnWithNonZeros(
+      &scratchpad_, &scratchpad_non_zeros_);
+  diagonal_.push_back(new_diagonal);
+  pivot_row_.push_back(pivot_row);
+  position_of_id_.push_back(position);
+  rank_.push_back(0);
+  id_of_position_[position] = new_id;
+
+  // The new column is last in the triangular order.
+  const int old_rank = rank_[old_id];
+  order_.erase(order_.begin() + old_rank);
+  order_.push_back(new_id);
+  for (int i = old_rank; i < order_.size(); ++i) {
+    rank_[order_[i]] = i;
+  }
+  return Status::OK();
+}
+
+// Note that the columns must be processed in reverse triangular order. The
+// entries that are no longer part of U are on a row whose current pivot is
+// after their column in this order, so they are only added to the input after
+// this row was used.
+void ForrestTomlinFactorization::RightSolveU(ScatteredColumn* x) const {
+  RETURN_IF_NULL(x);
+  DCHECK(is_initialized_);
+  column_result_.AssignToZero(num_rows_);
+  x->non_zeros.clear();
+  for (int i = order_.size() - 1; i >= 0; --i) {
+    const ColIndex id = order_[i];
+    const Fractional value = x->values[pivot_row_[id]];
+    if (value == 0.0) continue;
+    const Fractional solution = value / diagonal_[id];
+    upper_.ColumnAddMultipleToDenseColumn(id, -solution, &x->values);
+    const RowIndex position = position_of_id_[id];
+    column_result_[position] = solution;
+    x->non_zeros.push_back(position);
+  }
+  std::swap(x->values, column_result_);
+  x->non_zeros_are_sorted = false;
+  x->ClearNonZerosIfTooDense();
+  dtime_ += DeterministicTimeForFpOperations(
+      (upper_.num_entries() - initial_num_entries_).value());
+}
+
+void ForrestTomlinFactorization::LeftSolveU(ScatteredRow* y) const {
+  RETURN_IF_NULL(y);
+  DCHECK(is_initialized_);
+  int start = y->non_zeros.empty() ? 0 : static_cast<int>(order_.size());
+  for (const ColIndex position : y->non_zeros) {
+    start = std::min(start, rank_[id_of_position_[ColToRowIndex(position)]]);
+  }
+  LeftSolveUFromRank(start, y);
+}
+
+void ForrestTomlinFactorization::LeftSolveUForUnitRow(ColIndex position,
+                                                      ScatteredRow* y) const {
+  RETURN_IF_NULL(y);
+  DCHECK(is_initialized_);
+  DCHECK(IsAllZero(y->values));
+  (*y)[position] = 1.0;
+  LeftSolveUFromRank(rank_[id_of_position_[ColToRowIndex(position)]], y);
+}
+
+// Here, the entries no longer part of U are on a row whose current pivot is
+// after their column in the order, so the result on this row is still zero
+// when they are used.
+void ForrestTomlinFactorization::LeftSolveUFromRank(int start,
+                                                    ScatteredRow* y) const {
+  row_result_.AssignToZero(RowToColIndex(num_rows_));
+  y->non_zeros.clear();
+  const auto view = upper_.view();
+  const int end = order_.size();
+  for (int i = start; i < end; ++i) {
+    const ColIndex id = order_[i];
+    const Fractional value =
+        y->values[RowToColIndex(position_of_id_[id])] -
+        view.ColumnScalarProduct(id, row_result_.const_view());
+    if (value == 0.0) continue;
+    const ColIndex row = RowToColIndex(pivot_row_[id]);
+    row_result_[row] = value / diagonal_[id];
+    y->non_zeros.push_back(row);
+  }
+  std::swap(y->values, row_result_);
+  y->non_zeros_are_sorted = false;
+  y->ClearNonZerosIfTooDense();
+  dtime_ += DeterministicTimeForFpOperations(
+      (upper_.num_entries() - initial_num_entries_).value());
+}
+
+void ForrestTomlinFactorization::RightSolveWithRowEtas(
+    ScatteredColumn* x) const {
+  RETURN_IF_NULL(x);
+  const ColIndex num_etas = row_etas_.num_cols();
+  if (num_etas == 0) return;
+
+  // x->is_non_zero is always all false before and after this code.
+  const bool is_sparse = !x->non_zeros.empty();
+  if (is_sparse) x->RepopulateSparseMask();
+  for (ColIndex i(0); i < num_etas; ++i) {
+    const Fractional scalar_product =
+        row_etas_.ColumnScalarProduct(i, Transpose(x->values));
+    if (scalar_product == 0.0) continue;
+    if (is_sparse) {
+      x->Add(eta_pivot_row_[i], -scalar_product);
+    } else {
+      (*x)[eta_pivot_row_[i]] -= scalar_product;
+    }
+  }
+  if (is_sparse) {
+    x->ClearSparseMask();
+    x->ClearNonZerosIfTooDense();
+  }
+  dtime_ += DeterministicTimeForFpOperations(row_etas_.num_entries().value());
+}
+
+void ForrestTomlinFactorization::LeftSolveWithRowEtas(ScatteredRow* y) const {
+  RETURN_IF_NULL(y);
+  const ColIndex num_etas = row_etas_.num_cols();
+  if (num_etas == 0) return;
+
+  // y->is_non_zero is always all false before and after this code.
+  const bool is_sparse = !y->non_zeros.empty();
+  if (is_sparse) y->RepopulateSparseMask();
+  for (ColIndex i = num_etas - 1; i >= 0; --i) {
+    const Fractional multiplier = y->values[RowToColIndex(eta_pivot_row_[i])];
+    if (multiplier == 0.0) continue;
+    if (is_sparse) {
+      row_etas_.ColumnAddMultipleToSparseScatteredColumn(
+          i, -multiplier, reinterpret_cast<ScatteredColumn*>(y));
+    } else {
+      row_etas_.ColumnAddMultipleToDenseColumn(
+          i, -multiplier, reinterpret_cast<DenseColumn*>(&y->values));
+    }
+  }
+  if (is_sparse) {
+    y->ClearSparseMask();
+    y->ClearNonZerosIfTooDense();
+  }
+  dtime_ += DeterministicTimeForFpOperations(row_etas_.num_entries().value());
+}
+
+}  // namespace glop
+}  // namespace operations_research
@@ -0,0 +1,154 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_GLOP_FORREST_TOMLIN_H_
+#define OR_TOOLS_GLOP_FORREST_TOMLIN_H_
+
+#include <vector>
+
+#include "ortools/glop/lu_factorization.h"
+#include "ortools/glop/status.h"
+#include "ortools/lp_data/lp_types.h"
+#include "ortools/lp_data/scattered_vector.h"
+#include "ortools/lp_data/sparse.h"
+#include "ortools/lp_data/sparse_column.h"
+
+namespace operations_research {
+namespace glop {
+
+// Maintains the upper factor of an LU factorization B = L.U through a
+// sequence of basis column replacements with the Forrest-Tomlin update:
+//
+//   B_k = L.R_1^{-1}...R_k^{-1}.U_k
+//
+// where each R_i is a row eta matrix (identity except for one row) and U_k is
+// a permuted upper triangular matrix. Contrary to the product form or the
+// middle product form updates, the upper factor is modified in place, so its
+// size does not grow with the number of updates. Only the new column and one
+// row eta are added per update.
+//
+// The U factor is stored by columns, one per basis position. Each column has
+// a pivot row holding its diagonal coefficient, and the columns are ordered so
+// that the matrix is upper triangular in this order. When a column is
+// replaced, its old version is removed from the order and the new one is
+// appended at the end. The entries of the other columns on the pivot row of
+// the replaced column are eliminated by the new row eta, we do not remove them
+// from the storage since the solves never read them.
+//
+// Reference: J. J. Forrest, J. A. Tomlin, "Updated triangular factors of the
+// basis to maintain sparsity in the product form simplex method",
+// Mathematical Programming 2, 1972.
+class ForrestTomlinFactorization {
+ public:
+  ForrestTomlinFactorization() = default;
+
+  // This type is neither copyable nor movable.
+  ForrestTomlinFactorization(const ForrestTomlinFactorization&) = delete;
+  ForrestTomlinFactorization& operator=(const ForrestTomlinFactorization&) =
+      delete;
+
+  // Forgets the current factorization. IsInitialized() will return false until
+  // the next Initialize().
+  void Clear();
+
+  // Copies the U factor of the given factorization. Its column permutation
+  // must be the identity, so that the column of U at a given position has its
+  // diagonal coefficient on the row of the same index.
+  void Initialize(const LuFactorization& lu_factorization, RowIndex num_rows);
+  bool IsInitialized() const { return is_initialized_; }
+
+  // Replaces the column of U at the given position. The spike is the entering
+  // column with the L factor and all the row etas already applied, that is
+  // R_k...R_1.L^{-1}.a. The left vector must be the result of
+  // LeftSolveUForUnitRow() for the same position and the current U.
+  ABSL_MUST_USE_RESULT Status Update(RowIndex position, ColumnView spike,
+                                     ColumnView left);
+
+  // Solves U.x = b for x, with b initially in x. The input is indexed by the
+  // rows of U and the result by the basis positions. The non-zeros of x are
+  // updated, but they are not sorted.
+  void RightSolveU(ScatteredColumn* x) const;
+
+  // Solves y.U = c for y, with c initially in y. The input is indexed by the
+  // basis positions and the result by the rows of U.
+  void LeftSolveU(ScatteredRow* y) const;
+
+  // Same as LeftSolveU() with a unit vector on the given position as input.
+  // y must be all zero.
+  void LeftSolveUForUnitRow(ColIndex position, ScatteredRow* y) const;
+
+  // Computes R_k...R_1.x or y.R_k...R_1 in place, this is the part of the
+  // solves between L and U. Both are indexed by the rows of U. The non-zeros,
+  // if not empty, are updated.
+  void RightSolveWithRowEtas(ScatteredColumn* x) const;
+  void LeftSolveWithRowEtas(ScatteredRow* y) const;
+
+  // Returns the number of entries added by the updates, in U and in the row
+  // etas.
+  EntryIndex num_update_entries() const {
+    return upper_.num_entries() - initial_num_entries_ +
+           row_etas_.num_entries();
+  }
+
+  // Deterministic time spent since the last Clear() in the solves with the
+  // row etas and with the columns added by the updates. This is the extra work
+  // compared to the solves with a fresh factorization.
+  double DeterministicTimeSinceLastReset() const { return dtime_; }
+
+ private:
+  // Same as LeftSolveU() but starts at the given rank in order_. All the
+  // columns before it must have a zero right hand side.
+  void LeftSolveUFromRank(int start, ScatteredRow* y) const;
+
+  bool is_initialized_ = false;
+  RowIndex num_rows_;
+
+  // The off-diagonal entries of U in upper_, indexed by a column id. The ids
+  // [0, num_rows_) are the columns copied at initialization, and one new id is
+  // created by each Update(). The following vectors are indexed by these ids.
+  CompactSparseMatrix upper_;
+  StrictITIVector<ColIndex, Fractional> diagonal_;
+  StrictITIVector<ColIndex, RowIndex> pivot_row_;
+  StrictITIVector<ColIndex, RowIndex> position_of_id_;
+
+  // The id of the column of U currently at each basis position.
+  StrictITIVector<RowIndex, ColIndex> id_of_position_;
+
+  // The ids of the current columns of U in triangular order, and the rank of
+  // each id in this order (only meaningful for the current columns).
+  std::vector<ColIndex> order_;
+  StrictITIVector<ColIndex, int> rank_;
+
+  // The row etas. The column i of row_etas_ holds the multipliers of the row
+  // combination that is subtracted from the row eta_pivot_row_[i].
+  CompactSparseMatrix row_etas_;
+  StrictITIVector<ColIndex, RowIndex> eta_pivot_row_;
+
+  // The number of entries of U at initialization. The entries added since then
+  // are counted in the deterministic time of the solves.
+  EntryIndex initial_num_entries_;
+
+  // Temporary storage. The solves are out of place, so they compute their
+  // result in these vectors and swap them with their input.
+  mutable DenseColumn column_result_;
+  mutable DenseRow row_result_;
+  DenseColumn scratchpad_;
+  std::vector<RowIndex> scratchpad_non_zeros_;
+
+  mutable double dtime_ = 0.0;
+};
+
+}  // namespace glop
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GLOP_FORREST_TOMLIN_H_
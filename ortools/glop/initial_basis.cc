@@ -30,7 +30,8 @@ InitialBasis::InitialBasis(const CompactSparseMatrix& compact_matrix,
                            const DenseRow& objective,
                            const DenseRow& lower_bound,
                            const DenseRow& upper_bound,
-                           const VariableTypeRow& variable_type)
+                           const VariableTypeRow& variable_type,
+                           const ParallelColumnLoop& parallel_loop)
     : max_scaled_abs_cost_(0.0),
       bixby_column_comparator_(*this),
       triangular_column_comparator_(*this),
@@ -38,7 +39,8 @@ InitialBasis::InitialBasis(const CompactSparseMatrix& compact_matrix,
       objective_(objective),
       lower_bound_(lower_bound),
       upper_bound_(upper_bound),
-      variable_type_(variable_type) {}
+      variable_type_(variable_type),
+      parallel_loop_(parallel_loop) {}
 
 void InitialBasis::CompleteBixbyBasis(ColIndex num_cols,
                                       RowToColMapping* basis) {
@@ -162,6 +164,7 @@ void InitialBasis::CompleteTriangularBasis(ColIndex num_cols,
   const Fractional kBixbyWeight = 1000.0;
   max_scaled_abs_cost_ =
       (max_scaled_abs_cost_ == 0.0) ? 1.0 : kBixbyWeight * max_scaled_abs_cost_;
+  ComputeColumnPenalties(num_cols);
   std::priority_queue<ColIndex, std::vector<ColIndex>,
                       InitialBasis::TriangularColumnComparator>
       queue(residual_singleton_column.begin(), residual_singleton_column.end(),
@@ -370,6 +373,7 @@ void InitialBasis::ComputeCandidates(ColIndex num_cols,
   const Fractional kBixbyWeight = 1000.0;
   max_scaled_abs_cost_ =
       (max_scaled_abs_cost_ == 0.0) ? 1.0 : kBixbyWeight * max_scaled_abs_cost_;
+  ComputeColumnPenalties(num_cols);
   std::sort(candidates->begin(), candidates->end(), bixby_column_comparator_);
 }
 
@@ -405,6 +409,15 @@ Fractional InitialBasis::GetColumnPenalty(ColIndex col) const {
   return penalty + std::abs(objective_[col]) / max_scaled_abs_cost_;
 }
 
+void InitialBasis::ComputeColumnPenalties(ColIndex num_cols) {
+  column_penalty_.resize(num_cols, 0.0);
+  parallel_loop_.Run(num_cols.value(), [this](int block, int begin, int end) {
+    for (ColIndex col(begin); col < ColIndex(end); ++col) {
+      column_penalty_[col] = GetColumnPenalty(col);
+    }
+  });
+}
+
 bool InitialBasis::BixbyColumnComparator::operator()(ColIndex col_a,
                                                      ColIndex col_b) const {
   if (col_a == col_b) return false;
@@ -413,8 +426,8 @@ bool InitialBasis::BixbyColumnComparator::operator()(ColIndex col_a,
   if (category_a != category_b) {
     return category_a < category_b;
   } else {
-    return initial_basis_.GetColumnPenalty(col_a) <
-           initial_basis_.GetColumnPenalty(col_b);
+    return initial_basis_.column_penalty_[col_a] <
+           initial_basis_.column_penalty_[col_b];
   }
 }
 
@@ -438,8 +451,8 @@ bool InitialBasis::TriangularColumnComparator::operator()(
     return initial_basis_.compact_matrix_.column(col_a).num_entries() >
            initial_basis_.compact_matrix_.column(col_b).num_entries();
   }
-  return initial_basis_.GetColumnPenalty(col_a) >
-         initial_basis_.GetColumnPenalty(col_b);
+  return initial_basis_.column_penalty_[col_a] >
+         initial_basis_.column_penalty_[col_b];
 }
 
 }  // namespace glop
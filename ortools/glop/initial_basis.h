@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/lp_data/lp_data.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/sparse.h"
@@ -45,11 +46,13 @@ namespace glop {
 // heuristic similar to the one used by Bixby.
 class InitialBasis {
  public:
-  // Takes references to the linear program data we need.
+  // Takes references to the linear program data we need. The parallel loop is
+  // used to compute the column penalties.
   InitialBasis(const CompactSparseMatrix& compact_matrix,
                const DenseRow& objective, const DenseRow& lower_bound,
                const DenseRow& upper_bound,
-               const VariableTypeRow& variable_type);
+               const VariableTypeRow& variable_type,
+               const ParallelColumnLoop& parallel_loop);
 
   // This type is neither copyable nor movable.
   InitialBasis(const InitialBasis&) = delete;
@@ -80,7 +83,8 @@ class InitialBasis {
 
   // Visible for testing. Computes a list of candidate column indices out of the
   // fist num_candidate_columns of A and sorts them using the
-  // bixby_column_comparator_. This also fills max_scaled_abs_cost_.
+  // bixby_column_comparator_. This also fills max_scaled_abs_cost_ and
+  // column_penalty_.
   void ComputeCandidates(ColIndex num_cols, std::vector<ColIndex>* candidates);
 
  private:
@@ -104,10 +108,18 @@ class InitialBasis {
   // column 'j' in the paper.
   Fractional GetColumnPenalty(ColIndex col) const;
 
+  // Fills column_penalty_ with the GetColumnPenalty() of the first num_cols
+  // columns. It must be called after max_scaled_abs_cost_ is computed.
+  void ComputeColumnPenalties(ColIndex num_cols);
+
   // Maximum scaled absolute value of the objective for the columns which are
   // entering candidates. This is used by GetColumnPenalty().
   Fractional max_scaled_abs_cost_;
 
+  // The penalties used by the comparators below, computed once per column
+  // rather than at each comparison.
+  DenseRow column_penalty_;
+
   // Comparator used to sort column indices according to their penalty.
   // Lower is better.
   struct BixbyColumnComparator {
@@ -131,6 +143,7 @@ class InitialBasis {
   const DenseRow& lower_bound_;
   const DenseRow& upper_bound_;
   const VariableTypeRow& variable_type_;
+  const ParallelColumnLoop& parallel_loop_;
 };
 
 }  // namespace glop
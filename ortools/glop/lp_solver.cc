@@ -14,15 +14,20 @@
 #include "ortools/glop/lp_solver.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "google/protobuf/text_format.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/version.h"
@@ -33,15 +38,18 @@
 #include "ortools/glop/variables_info.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
 #include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_decomposer.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/lp_utils.h"
 #include "ortools/lp_data/proto_utils.h"
 #include "ortools/port/proto_utils.h"
 #include "ortools/util/fp_utils.h"
 #include "ortools/util/logging.h"
+#include "ortools/util/time_limit.h"
 
 #ifndef __PORTABLE_PLATFORM__
 // TODO(user): abstract this in some way to the port directory.
+#include "ortools/base/threadpool.h"
 #include "ortools/util/file_util.h"
 #endif
 
@@ -220,6 +228,9 @@ ProblemStatus LPSolver::SolveWithTimeLimit(const LinearProgram& lp,
   preprocessor.SetTimeLimit(time_limit);
 
   const bool postsolve_is_needed = preprocessor.Run(&current_linear_program_);
+  if (!crossover_primal_values_.empty()) {
+    LoadCrossoverStartingPoint(lp, preprocessor);
+  }
 
   if (logger_.LoggingIsEnabled()) {
     SOLVER_LOG(&logger_, "");
@@ -273,12 +284,17 @@ ProblemStatus LPSolver::SolveWithTimeLimit(const LinearProgram& lp,
 void LPSolver::Clear() {
   ResizeSolution(RowIndex(0), ColIndex(0));
   revised_simplex_.reset(nullptr);
+  blocks_deterministic_time_ = 0.0;
+  crossover_primal_values_.clear();
+  crossover_dual_values_.clear();
 }
 
-void LPSolver::SetInitialBasis(
+namespace {
+
+// Returns the basis state corresponding to the given statuses.
+BasisState ComputeBasisState(
     const VariableStatusRow& variable_statuses,
     const ConstraintStatusColumn& constraint_statuses) {
-  // Create the associated basis state.
   BasisState state;
   state.statuses = variable_statuses;
   for (const ConstraintStatus status : constraint_statuses) {
@@ -302,11 +318,20 @@ void LPSolver::SetInitialBasis(
         break;
     }
   }
+  return state;
+}
+
+}  // namespace
+
+void LPSolver::SetInitialBasis(
+    const VariableStatusRow& variable_statuses,
+    const ConstraintStatusColumn& constraint_statuses) {
   if (revised_simplex_ == nullptr) {
     revised_simplex_ = std::make_unique<RevisedSimplex>();
     revised_simplex_->SetLogger(&logger_);
   }
-  revised_simplex_->LoadStateForNextSolve(state);
+  revised_simplex_->LoadStateForNextSolve(
+      ComputeBasisState(variable_statuses, constraint_statuses));
   if (parameters_.use_preprocessing()) {
     LOG(WARNING) << "In GLOP, SetInitialBasis() was called but the parameter "
                     "use_preprocessing is true, this will likely not result in "
@@ -314,6 +339,30 @@ void LPSolver::SetInitialBasis(
   }
 }
 
+std::string LPSolver::SerializeStateForNextSolve() const {
+  if (revised_simplex_ == nullptr) return "";
+  return revised_simplex_->SerializeStateForNextSolve();
+}
+
+Status LPSolver::LoadSerializedStateForNextSolve(absl::string_view blob) {
+  if (revised_simplex_ == nullptr) {
+    revised_simplex_ = std::make_unique<RevisedSimplex>();
+    revised_simplex_->SetLogger(&logger_);
+  }
+  return revised_simplex_->LoadSerializedStateForNextSolve(blob);
+}
+
+void LPSolver::SetCrossoverStartingPoint(const DenseRow& primal_values,
+                                         const DenseColumn& dual_values) {
+  crossover_primal_values_ = primal_values;
+  crossover_dual_values_ = dual_values;
+  if (parameters_.use_preprocessing()) {
+    LOG(WARNING) << "In GLOP, SetCrossoverStartingPoint() was called but the "
+                    "parameter use_preprocessing is true, the point will be "
+                    "ignored if the presolve changes the problem.";
+  }
+}
+
 namespace {
 // Computes the "real" problem objective from the one without offset nor
 // scaling.
@@ -543,8 +592,9 @@ int LPSolver::GetNumberOfSimplexIterations() const {
 }
 
 double LPSolver::DeterministicTime() const {
-  return revised_simplex_ == nullptr ? 0.0
-                                     : revised_simplex_->DeterministicTime();
+  return blocks_deterministic_time_ +
+         (revised_simplex_ == nullptr ? 0.0
+                                      : revised_simplex_->DeterministicTime());
 }
 
 void LPSolver::MovePrimalValuesWithinBounds(const LinearProgram& lp) {
@@ -598,6 +648,99 @@ void LPSolver::ResizeSolution(RowIndex num_rows, ColIndex num_cols) {
   constraint_statuses_.resize(num_rows, ConstraintStatus::FREE);
 }
 
+namespace {
+
+// Returns the status of a value with respect to the given bounds for the
+// crossover starting basis. This is BASIC if the value is not close to one of
+// the bounds. StatusType is VariableStatus or ConstraintStatus.
+template <typename StatusType>
+StatusType CrossoverStatus(Fractional value, Fractional lower_bound,
+                           Fractional upper_bound, Fractional tolerance) {
+  const bool at_lb =
+      std::isfinite(lower_bound) &&
+      value - lower_bound <= AllowedError(tolerance, lower_bound);
+  const bool at_ub =
+      std::isfinite(upper_bound) &&
+      upper_bound - value <= AllowedError(tolerance, upper_bound);
+  if (at_lb && at_ub && lower_bound == upper_bound) {
+    return StatusType::FIXED_VALUE;
+  }
+  if (at_lb) return StatusType::AT_LOWER_BOUND;
+  if (at_ub) return StatusType::AT_UPPER_BOUND;
+  return StatusType::BASIC;
+}
+
+}  // namespace
+
+void LPSolver::LoadCrossoverStartingPoint(
+    const LinearProgram& lp, const MainLpPreprocessor& preprocessor) {
+  const DenseRow primal_values = std::move(crossover_primal_values_);
+  const DenseColumn dual_values = std::move(crossover_dual_values_);
+  crossover_primal_values_.clear();
+  crossover_dual_values_.clear();
+  const ColIndex num_cols = lp.num_variables();
+  const RowIndex num_rows = lp.num_constraints();
+  if (primal_values.size() != num_cols || dual_values.size() != num_rows) {
+    LOG(WARNING) << "The crossover starting point does not have the dimension "
+                    "of the problem, it is ignored.";
+    return;
+  }
+  DenseRow starting_values = primal_values;
+  if (!preprocessor.TransformPrimalValues(&starting_values)) {
+    SOLVER_LOG(&logger_,
+               "The crossover starting point is ignored because the presolve "
+               "changed the problem.");
+    return;
+  }
+
+  // The statuses do not depend on the scaling, so we compute them on the
+  // original problem.
+  const Fractional tolerance = parameters_.primal_feasibility_tolerance();
+  VariableStatusRow variable_statuses(num_cols);
+  for (ColIndex col(0); col < num_cols; ++col) {
+    variable_statuses[col] = CrossoverStatus<VariableStatus>(
+        primal_values[col], lp.variable_lower_bounds()[col],
+        lp.variable_upper_bounds()[col], tolerance);
+  }
+  DenseColumn activities(num_rows, 0.0);
+  for (ColIndex col(0); col < num_cols; ++col) {
+    const Fractional value = primal_values[col];
+    if (value == 0.0) continue;
+    for (const SparseColumn::Entry e : lp.GetSparseMatrix().column(col)) {
+      activities[e.row()] += e.coefficient() * value;
+    }
+  }
+
+  // By complementary slackness, a constraint with a zero dual value can have
+  // its slack in the basis even if it is tight.
+  ConstraintStatusColumn constraint_statuses(num_rows);
+  int num_candidates = 0;
+  for (RowIndex row(0); row < num_rows; ++row) {
+    if (std::abs(dual_values[row]) <=
+        parameters_.dual_feasibility_tolerance()) {
+      constraint_statuses[row] = ConstraintStatus::BASIC;
+    } else {
+      constraint_statuses[row] = CrossoverStatus<ConstraintStatus>(
+          activities[row], lp.constraint_lower_bounds()[row],
+          lp.constraint_upper_bounds()[row], tolerance);
+    }
+    if (constraint_statuses[row] == ConstraintStatus::BASIC) ++num_candidates;
+  }
+  for (const VariableStatus status : variable_statuses) {
+    if (status == VariableStatus::BASIC) ++num_candidates;
+  }
+  SOLVER_LOG(&logger_, "Crossover starting point with ", num_candidates,
+             " candidates for the basis (num_rows = ", num_rows.value(), ").");
+
+  if (revised_simplex_ == nullptr) {
+    revised_simplex_ = std::make_unique<RevisedSimplex>();
+    revised_simplex_->SetLogger(&logger_);
+  }
+  revised_simplex_->LoadStateForNextSolve(
+      ComputeBasisState(variable_statuses, constraint_statuses));
+  revised_simplex_->SetStartingVariableValuesForNextSolve(starting_values);
+}
+
 void LPSolver::RunRevisedSimplexIfNeeded(ProblemSolution* solution,
                                          TimeLimit* time_limit) {
   // Note that the transpose matrix is no longer needed at this point.
@@ -609,6 +752,10 @@ void LPSolver::RunRevisedSimplexIfNeeded(ProblemSolution* solution,
   // right away.
   current_linear_program_.ClearTransposeMatrix();
   if (solution->status != ProblemStatus::INIT) return;
+  if (parameters_.solve_independent_blocks() &&
+      SolveIndependentBlocks(solution, time_limit)) {
+    return;
+  }
   if (revised_simplex_ == nullptr) {
     revised_simplex_ = std::make_unique<RevisedSimplex>();
     revised_simplex_->SetLogger(&logger_);
@@ -667,6 +814,134 @@ void LPSolver::RunRevisedSimplexIfNeeded(ProblemSolution* solution,
   }
 }
 
+bool LPSolver::SolveIndependentBlocks(ProblemSolution* solution,
+                                      TimeLimit* time_limit) {
+  // The objective limits apply to the full problem, not to each block.
+  if (std::isfinite(parameters_.objective_lower_limit()) ||
+      std::isfinite(parameters_.objective_upper_limit())) {
+    return false;
+  }
+
+  LPDecomposer decomposer;
+  decomposer.Decompose(&current_linear_program_);
+  const int num_blocks = decomposer.GetNumberOfProblems();
+  if (num_blocks <= 1) {
+    current_linear_program_.ClearTransposeMatrix();
+    return false;
+  }
+
+  // The presolve removes the empty rows and columns, so we do not bother
+  // handling the blocks without constraints or the constraints without any
+  // block.
+  std::vector<std::vector<ColIndex>> block_cols(num_blocks);
+  std::vector<std::vector<RowIndex>> block_rows(num_blocks);
+  RowIndex num_block_rows(0);
+  for (int block = 0; block < num_blocks; ++block) {
+    block_cols[block] = decomposer.GetProblemVariables(block);
+    block_rows[block] = decomposer.GetProblemConstraints(block);
+    if (block_rows[block].empty()) {
+      current_linear_program_.ClearTransposeMatrix();
+      return false;
+    }
+    num_block_rows += RowIndex(block_rows[block].size());
+  }
+  if (num_block_rows != current_linear_program_.num_constraints()) {
+    current_linear_program_.ClearTransposeMatrix();
+    return false;
+  }
+  SOLVER_LOG(&logger_, "Solving ", num_blocks, " independent blocks.");
+
+  // The largest blocks are started first so that the threads finish at about
+  // the same time.
+  std::vector<int> order(num_blocks);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return block_cols[a].size() > block_cols[b].size();
+  });
+
+  // The threads are used across the blocks, not inside them.
+  GlopParameters block_parameters = parameters_;
+  block_parameters.set_log_search_progress(false);
+  block_parameters.set_num_omp_threads(1);
+
+  // Each block writes its part of the solution. The blocks are disjoint, so
+  // the result does not depend on the thread scheduling. We do not start new
+  // blocks once one of them failed since the full problem will be solved.
+  SharedTimeLimit shared_time_limit(time_limit);
+  std::atomic<bool> one_block_failed = false;
+  std::vector<int> block_iterations(num_blocks, 0);
+  std::vector<double> block_deterministic_times(num_blocks, 0.0);
+  const auto solve_block = [&](int block) {
+    if (one_block_failed || shared_time_limit.LimitReached()) {
+      one_block_failed = true;
+      return;
+    }
+    LinearProgram lp;
+    decomposer.ExtractLocalProblem(block, &lp);
+    TimeLimit local_time_limit;
+    shared_time_limit.UpdateLocalLimit(&local_time_limit);
+    RevisedSimplex simplex;
+    simplex.SetParameters(block_parameters);
+    const bool ok = simplex.Solve(lp, &local_time_limit).ok() &&
+                    simplex.GetProblemStatus() == ProblemStatus::OPTIMAL;
+    shared_time_limit.AdvanceDeterministicTime(
+        local_time_limit.GetElapsedDeterministicTime());
+    block_iterations[block] = simplex.GetNumberOfIterations();
+    block_deterministic_times[block] = simplex.DeterministicTime();
+    if (!ok) {
+      one_block_failed = true;
+      return;
+    }
+    const std::vector<ColIndex>& cols = block_cols[block];
+    for (int i = 0; i < cols.size(); ++i) {
+      solution->primal_values[cols[i]] =
+          simplex.GetVariableValue(ColIndex(i));
+      solution->variable_statuses[cols[i]] =
+          simplex.GetVariableStatus(ColIndex(i));
+    }
+    const std::vector<RowIndex>& rows = block_rows[block];
+    for (int i = 0; i < rows.size(); ++i) {
+      solution->dual_values[rows[i]] = simplex.GetDualValue(RowIndex(i));
+      solution->constraint_statuses[rows[i]] =
+          simplex.GetConstraintStatus(RowIndex(i));
+    }
+  };
+
+  const int num_threads =
+      std::min(num_blocks, std::max(1, parameters_.num_omp_threads()));
+#if !defined(__PORTABLE_PLATFORM__)
+  if (num_threads > 1) {
+    ThreadPool pool("GlopBlocks", num_threads);
+    pool.StartWorkers();
+    absl::BlockingCounter counter(num_blocks);
+    for (const int block : order) {
+      pool.Schedule([&, block]() {
+        solve_block(block);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  } else {
+    for (const int block : order) solve_block(block);
+  }
+#else
+  for (const int block : order) solve_block(block);
+#endif  // __PORTABLE_PLATFORM__
+  current_linear_program_.ClearTransposeMatrix();
+
+  for (int block = 0; block < num_blocks; ++block) {
+    num_revised_simplex_iterations_ += block_iterations[block];
+    blocks_deterministic_time_ += block_deterministic_times[block];
+  }
+  if (one_block_failed) {
+    SOLVER_LOG(&logger_, "One block was not solved to optimality, solving ",
+               "the full problem.");
+    return false;
+  }
+  solution->status = ProblemStatus::OPTIMAL;
+  return true;
+}
+
 namespace {
 
 void LogVariableStatusError(ColIndex col, Fractional value,
@@ -17,8 +17,10 @@
 #include <memory>
 #include <string>
 
+#include "absl/strings/string_view.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/revised_simplex.h"
+#include "ortools/glop/status.h"
 #include "ortools/lp_data/lp_data.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/util/logging.h"
@@ -27,6 +29,8 @@
 namespace operations_research {
 namespace glop {
 
+class MainLpPreprocessor;
+
 // A full-fledged linear programming solver.
 class LPSolver {
  public:
@@ -59,6 +63,13 @@ class LPSolver {
   // it will just solve the problem from scratch. On the other hand, if the lp
   // is the same, calling Solve() again should basically resume the solve from
   // the last position. To disable this behavior, simply call Clear() before.
+  //
+  // The supported modifications are changing the bounds or the objective,
+  // adding new rows (with the dual simplex) and adding new columns with a zero
+  // bound (with the primal simplex, as in a column generation loop). Only the
+  // new columns are copied in the internal matrix in this last case. Since the
+  // presolve can change the problem seen by the simplex from one solve to the
+  // next, use_preprocessing should be false to benefit from this.
   ABSL_MUST_USE_RESULT ProblemStatus Solve(const LinearProgram& lp);
 
   // Same as Solve() but use the given time limit rather than constructing a new
@@ -90,6 +101,37 @@ class LPSolver {
   void SetInitialBasis(const VariableStatusRow& variable_statuses,
                        const ConstraintStatusColumn& constraint_statuses);
 
+  // Advanced usage. Returns the final state of the simplex in the last Solve()
+  // as a compact binary blob, or an empty string if the simplex was not used.
+  // See RevisedSimplex::SerializeStateForNextSolve() for the content.
+  std::string SerializeStateForNextSolve() const;
+
+  // Advanced usage. Warm starts the next Solve() from a blob returned by
+  // SerializeStateForNextSolve(), typically in another process solving the
+  // same family of problems. Returns an error if the blob is malformed. The
+  // blob is ignored if the constraint matrix seen by the simplex differs, so
+  // as for SetInitialBasis(), it is only useful if the presolve transforms the
+  // problem in the same way each time, e.g. when use_preprocessing is false.
+  ABSL_MUST_USE_RESULT Status
+  LoadSerializedStateForNextSolve(absl::string_view blob);
+
+  // Advanced usage. Configures the next Solve() only to start from the given
+  // primal and dual values, typically a near-optimal solution computed by an
+  // interior point or a first order method like PDLP, and to find an optimal
+  // basis from there. This is usually called crossover.
+  //
+  // A starting basis is derived from the given point: the variables strictly
+  // within their bounds and the constraints with a zero dual value are the
+  // candidates for the basis, which is completed with slack variables. The
+  // candidates that are not kept start as super-basic variables at their given
+  // value and are later pushed to one of their bounds (see push_to_vertex).
+  //
+  // As for SetInitialBasis(), this cannot be transformed in sync with the
+  // presolve, so the point is ignored if the presolve changed the problem. The
+  // scaling is fine however.
+  void SetCrossoverStartingPoint(const DenseRow& primal_values,
+                                 const DenseColumn& dual_values);
+
   // This loads a given solution and computes related quantities so that the
   // getters below will refer to it.
   //
@@ -190,11 +232,24 @@ class LPSolver {
   void MovePrimalValuesWithinBounds(const LinearProgram& lp);
   void MoveDualValuesWithinBounds(const LinearProgram& lp);
 
+  // Loads the point given to SetCrossoverStartingPoint() in revised_simplex_
+  // and forgets it. The given lp is the one passed to Solve().
+  void LoadCrossoverStartingPoint(const LinearProgram& lp,
+                                  const MainLpPreprocessor& preprocessor);
+
   // Runs the revised simplex algorithm if needed (i.e. if the program was not
   // already solved by the preprocessors).
   void RunRevisedSimplexIfNeeded(ProblemSolution* solution,
                                  TimeLimit* time_limit);
 
+  // Used by RunRevisedSimplexIfNeeded() when solve_independent_blocks is true.
+  // If current_linear_program_ is made of several independent blocks, solves
+  // each of them with its own RevisedSimplex and fills the solution. Returns
+  // false if the problem was not decomposed or if one of the blocks was not
+  // solved to optimality, in which case the solution status is still INIT and
+  // the full problem must be solved.
+  bool SolveIndependentBlocks(ProblemSolution* solution, TimeLimit* time_limit);
+
   // Checks that the returned solution values and statuses are consistent.
   // Returns true if this is the case. See the code for the exact check
   // performed.
@@ -275,9 +330,17 @@ class LPSolver {
   // The revised simplex solver.
   std::unique_ptr<RevisedSimplex> revised_simplex_;
 
+  // The point given to SetCrossoverStartingPoint(), if any.
+  DenseRow crossover_primal_values_;
+  DenseColumn crossover_dual_values_;
+
   // The number of revised simplex iterations used by the last Solve().
   int num_revised_simplex_iterations_;
 
+  // The deterministic time spent in SolveIndependentBlocks() since the last
+  // Clear(). It is not accounted by revised_simplex_.
+  double blocks_deterministic_time_ = 0.0;
+
   // The current ProblemSolution.
   // TODO(user): use a ProblemSolution directly? Note, that primal_ray_,
   // constraints_dual_ray_ and variable_bounds_dual_ray_ are not currently in
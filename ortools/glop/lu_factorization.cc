@@ -183,33 +183,54 @@ Fractional LuFactorization::RightSolveSquaredNorm(const ColumnView& a) const {
 Fractional LuFactorization::DualEdgeSquaredNorm(RowIndex row) const {
   if (is_identity_factorization_) return 1.0;
   SCOPED_TIME_STAT(&stats_);
+  return DualEdgeSquaredNormInternal(row, &dense_zero_scratchpad_,
+                                     &non_zero_rows_, nullptr);
+}
+
+Fractional LuFactorization::DualEdgeSquaredNorm(
+    RowIndex row, SolveScratchpad* scratchpad) const {
+  if (is_identity_factorization_) return 1.0;
+  return DualEdgeSquaredNormInternal(row, &scratchpad->dense_column,
+                                     &scratchpad->non_zero_rows,
+                                     &scratchpad->stored);
+}
+
+Fractional LuFactorization::DualEdgeSquaredNormInternal(
+    RowIndex row, DenseColumn* dense, RowIndexVector* non_zero_rows,
+    Bitset64<RowIndex>* stored) const {
   const RowIndex permuted_row =
       col_perm_.empty() ? row : ColToRowIndex(col_perm_[RowToColIndex(row)]);
+  const auto compute_rows_to_consider = [non_zero_rows, stored](
+                                            const TriangularMatrix& matrix) {
+    if (stored == nullptr) {
+      matrix.ComputeRowsToConsiderInSortedOrder(non_zero_rows);
+    } else {
+      matrix.ComputeRowsToConsiderInSortedOrder(non_zero_rows, stored);
+    }
+  };
 
-  non_zero_rows_.clear();
+  non_zero_rows->clear();
   const RowIndex num_rows = lower_.num_rows();
-  dense_zero_scratchpad_.resize(num_rows, 0.0);
-  DCHECK(IsAllZero(dense_zero_scratchpad_));
-  dense_zero_scratchpad_[permuted_row] = 1.0;
-  non_zero_rows_.push_back(permuted_row);
-
-  transpose_upper_.ComputeRowsToConsiderInSortedOrder(&non_zero_rows_);
-  if (non_zero_rows_.empty()) {
-    transpose_upper_.LowerSolveStartingAt(RowToColIndex(permuted_row),
-                                          &dense_zero_scratchpad_);
+  dense->resize(num_rows, 0.0);
+  DCHECK(IsAllZero(*dense));
+  (*dense)[permuted_row] = 1.0;
+  non_zero_rows->push_back(permuted_row);
+
+  compute_rows_to_consider(transpose_upper_);
+  if (non_zero_rows->empty()) {
+    transpose_upper_.LowerSolveStartingAt(RowToColIndex(permuted_row), dense);
   } else {
-    transpose_upper_.HyperSparseSolve(&dense_zero_scratchpad_, &non_zero_rows_);
-    transpose_lower_.ComputeRowsToConsiderInSortedOrder(&non_zero_rows_);
+    transpose_upper_.HyperSparseSolve(dense, non_zero_rows);
+    compute_rows_to_consider(transpose_lower_);
   }
-  if (non_zero_rows_.empty()) {
-    transpose_lower_.UpperSolve(&dense_zero_scratchpad_);
+  if (non_zero_rows->empty()) {
+    transpose_lower_.UpperSolve(dense);
   } else {
-    transpose_lower_.HyperSparseSolveWithReversedNonZeros(
-        &dense_zero_scratchpad_, &non_zero_rows_);
+    transpose_lower_.HyperSparseSolveWithReversedNonZeros(dense,
+                                                          non_zero_rows);
   }
   return ComputeSquaredNormAndResetToZero(
-      non_zero_rows_,
-      absl::MakeSpan(dense_zero_scratchpad_.data(), num_rows.value()));
+      *non_zero_rows, absl::MakeSpan(dense->data(), num_rows.value()));
 }
 
 namespace {
@@ -231,6 +252,7 @@ void LuFactorization::RightSolveLWithPermutedInput(const DenseColumn& a,
   if (!is_identity_factorization_) {
     DCHECK(AreEqualWithPermutation(a, x->values, row_perm_));
     lower_.ComputeRowsToConsiderInSortedOrder(&x->non_zeros);
+    x->non_zeros_are_sorted = true;
     if (x->non_zeros.empty()) {
       lower_.LowerSolve(&x->values);
     } else {
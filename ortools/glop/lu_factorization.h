@@ -25,6 +25,7 @@
 #include "ortools/lp_data/scattered_vector.h"
 #include "ortools/lp_data/sparse.h"
 #include "ortools/lp_data/sparse_column.h"
+#include "ortools/util/bitset.h"
 #include "ortools/util/stats.h"
 
 namespace operations_research {
@@ -149,6 +150,20 @@ class LuFactorization {
   // Returns the norm of (B^T)^{-1}.e_row where e is an unit vector.
   Fractional DualEdgeSquaredNorm(RowIndex row) const;
 
+  // Temporary storage for the thread-safe DualEdgeSquaredNorm() below. Each
+  // thread must use its own.
+  struct SolveScratchpad {
+    DenseColumn dense_column;
+    RowIndexVector non_zero_rows;
+    Bitset64<RowIndex> stored;
+  };
+
+  // Same as DualEdgeSquaredNorm() but only modifies the given scratchpad, so
+  // it can be called concurrently on the same factorization. This neither
+  // updates the stats nor the density predictions of the triangular factors.
+  Fractional DualEdgeSquaredNorm(RowIndex row,
+                                 SolveScratchpad* scratchpad) const;
+
   // The fill-in of the LU-factorization is defined as the sum of the number
   // of entries of both the lower- and upper-triangular matrices L and U minus
   // the number of entries in the initial matrix B.
@@ -253,6 +268,13 @@ class LuFactorization {
   // transpose_lower_ is only needed when we compute dual norms.
   void ComputeTransposeLower() const;
 
+  // Implementation of the DualEdgeSquaredNorm() functions. If stored is
+  // nullptr, the symbolic phases use the internal data of the triangular
+  // factors and are not thread-safe.
+  Fractional DualEdgeSquaredNormInternal(RowIndex row, DenseColumn* dense,
+                                         RowIndexVector* non_zero_rows,
+                                         Bitset64<RowIndex>* stored) const;
+
   // Computes R = P.B.Q^{-1} - L.U and returns false if the largest magnitude of
   // the coefficients of P.B.Q^{-1} - L.U is greater than tolerance.
   bool CheckFactorization(const CompactSparseMatrixView& matrix,
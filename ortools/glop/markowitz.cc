@@ -18,6 +18,7 @@
 #include <cstdlib>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -68,6 +69,8 @@ Status Markowitz::ComputeRowAndColumnPermutation(
   const int end_index = std::min(num_rows.value(), num_cols.value());
   const Fractional singularity_threshold =
       parameters_.markowitz_singularity_threshold();
+  const Fractional dense_tail_threshold =
+      parameters_.markowitz_dense_tail_threshold();
   while (index < end_index) {
     Fractional pivot_coefficient = 0.0;
     RowIndex pivot_row = kInvalidRow;
@@ -136,6 +139,23 @@ Status Markowitz::ComputeRowAndColumnPermutation(
     (*col_perm)[pivot_col] = ColIndex(index);
     (*row_perm)[pivot_row] = RowIndex(index);
     ++index;
+
+    // Since FindPivot() looks at the columns by increasing degree, a pivot
+    // with a large row and column degree indicates that the residual matrix
+    // is dense. Note that we need a limit on its size since the dense version
+    // uses a quadratic amount of memory.
+    const int kMinDenseTailSize = 16;
+    const int kMaxDenseTailSize = 2048;
+    const int residual_size = end_index - index;
+    if (min_markowitz > 0 && residual_size >= kMinDenseTailSize &&
+        residual_size <= kMaxDenseTailSize &&
+        pivot_col_degree > dense_tail_threshold * (residual_size + 1) &&
+        pivot_row_degree > dense_tail_threshold * (residual_size + 1)) {
+      stats_.dense_tail_ratio.Add(static_cast<double>(residual_size) /
+                                  num_rows.value());
+      GLOP_RETURN_IF_ERROR(
+          FactorizeDenseResidualMatrix(row_perm, col_perm, &index));
+    }
   }
 
   // To get a better deterministic time, we add a factor that depend on the
@@ -554,6 +574,136 @@ void Markowitz::UpdateResidualMatrix(RowIndex pivot_row, ColIndex pivot_col) {
   RemoveColumnFromResidualMatrix(pivot_row, pivot_col);
 }
 
+Status Markowitz::FactorizeDenseResidualMatrix(RowPermutation* row_perm,
+                                               ColumnPermutation* col_perm,
+                                               int* index) {
+  SCOPED_TIME_STAT(&stats_);
+  dense_rows_.clear();
+  dense_cols_.clear();
+  StrictITIVector<RowIndex, int> dense_row_index(row_perm->size(), -1);
+  for (RowIndex row(0); row < row_perm->size(); ++row) {
+    if ((*row_perm)[row] != kInvalidRow) continue;
+    dense_row_index[row] = dense_rows_.size();
+    dense_rows_.push_back(row);
+  }
+  for (ColIndex col(0); col < col_perm->size(); ++col) {
+    if ((*col_perm)[col] == kInvalidCol) dense_cols_.push_back(col);
+  }
+
+  // Fill the dense residual matrix. ComputeColumn() also moves the entries of
+  // the column on the already pivoted rows to permuted_upper_.
+  const int num_rows = dense_rows_.size();
+  const int num_cols = dense_cols_.size();
+  dense_matrix_.assign(static_cast<size_t>(num_rows) * num_cols, 0.0);
+  for (int j = 0; j < num_cols; ++j) {
+    Fractional* const column =
+        &dense_matrix_[static_cast<size_t>(j) * num_rows];
+    const SparseColumn& residual_column =
+        ComputeColumn(*row_perm, dense_cols_[j]);
+    for (const SparseColumn::Entry e : residual_column) {
+      DCHECK_NE(dense_row_index[e.row()], -1);
+      column[dense_row_index[e.row()]] = e.coefficient();
+    }
+  }
+
+  // Right-looking Gaussian elimination. The rows and columns are swapped so
+  // that the residual matrix at step p is formed by the rows and columns with
+  // an index greater or equal to p.
+  const Fractional singularity_threshold =
+      parameters_.markowitz_singularity_threshold();
+  const int end = std::min(num_rows, num_cols);
+  for (int p = 0; p < end; ++p) {
+    // We use partial pivoting on the first column that has an entry above the
+    // singularity threshold.
+    int pivot_i = -1;
+    int pivot_j = p;
+    Fractional largest_magnitude = 0.0;
+    for (; pivot_j < num_cols; ++pivot_j) {
+      const Fractional* const column =
+          &dense_matrix_[static_cast<size_t>(pivot_j) * num_rows];
+      Fractional max_magnitude = 0.0;
+      for (int i = p; i < num_rows; ++i) {
+        if (std::abs(column[i]) > max_magnitude) {
+          max_magnitude = std::abs(column[i]);
+          pivot_i = i;
+        }
+      }
+      if (max_magnitude > singularity_threshold) break;
+      largest_magnitude = std::max(largest_magnitude, max_magnitude);
+    }
+    if (pivot_j == num_cols) {
+      const std::string error_message = absl::StrFormat(
+          "The matrix is singular! pivot = %E", largest_magnitude);
+      VLOG(1) << "ERROR_LU: " << error_message;
+      return Status(Status::ERROR_LU, error_message);
+    }
+    if (pivot_j != p) {
+      std::swap_ranges(
+          dense_matrix_.begin() + static_cast<size_t>(p) * num_rows,
+          dense_matrix_.begin() + static_cast<size_t>(p + 1) * num_rows,
+          dense_matrix_.begin() + static_cast<size_t>(pivot_j) * num_rows);
+      std::swap(dense_cols_[p], dense_cols_[pivot_j]);
+    }
+    if (pivot_i != p) {
+      for (int j = p; j < num_cols; ++j) {
+        Fractional* const column =
+            &dense_matrix_[static_cast<size_t>(j) * num_rows];
+        std::swap(column[p], column[pivot_i]);
+      }
+      std::swap(dense_rows_[p], dense_rows_[pivot_i]);
+    }
+
+    // Add the pivot column to lower_ and upper_. The entries of this column on
+    // the rows pivoted before the dense factorization are in permuted_upper_.
+    const ColIndex pivot_col = dense_cols_[p];
+    const RowIndex pivot_row = dense_rows_[p];
+    Fractional* const pivot_column =
+        &dense_matrix_[static_cast<size_t>(p) * num_rows];
+    const Fractional pivot_coefficient = pivot_column[p];
+    dense_column_.Clear();
+    for (int i = p; i < num_rows; ++i) {
+      if (pivot_column[i] == 0.0) continue;
+      dense_column_.SetCoefficient(dense_rows_[i], pivot_column[i]);
+    }
+    lower_.AddAndNormalizeTriangularColumn(dense_column_, pivot_row,
+                                           pivot_coefficient);
+    permuted_lower_.ClearAndReleaseColumn(pivot_col);
+    dense_column_.Clear();
+    for (const SparseColumn::Entry e : permuted_upper_.column(pivot_col)) {
+      dense_column_.SetCoefficient(e.row(), e.coefficient());
+    }
+    for (int i = 0; i < p; ++i) {
+      if (pivot_column[i] == 0.0) continue;
+      dense_column_.SetCoefficient(dense_rows_[i], pivot_column[i]);
+    }
+    upper_.AddTriangularColumnWithGivenDiagonalEntry(dense_column_, pivot_row,
+                                                     pivot_coefficient);
+    permuted_upper_.ClearAndReleaseColumn(pivot_col);
+
+    // Update the residual matrix. This inner loop is on contiguous memory and
+    // is easy to vectorize for the compiler.
+    for (int i = p + 1; i < num_rows; ++i) {
+      pivot_column[i] /= pivot_coefficient;
+    }
+    for (int j = p + 1; j < num_cols; ++j) {
+      Fractional* const column =
+          &dense_matrix_[static_cast<size_t>(j) * num_rows];
+      const Fractional multiplier = column[p];
+      if (multiplier == 0.0) continue;
+      for (int i = p + 1; i < num_rows; ++i) {
+        column[i] -= multiplier * pivot_column[i];
+      }
+    }
+    num_fp_operations_ +=
+        static_cast<int64_t>(num_rows - p) * static_cast<int64_t>(num_cols - p);
+
+    (*col_perm)[pivot_col] = ColIndex(*index);
+    (*row_perm)[pivot_row] = RowIndex(*index);
+    ++(*index);
+  }
+  return Status::OK();
+}
+
 double Markowitz::DeterministicTimeOfLastFactorization() const {
   return DeterministicTimeForFpOperations(num_fp_operations_);
 }
@@ -340,11 +340,13 @@ class Markowitz {
           basis_residual_singleton_column_ratio(
               "basis_residual_singleton_column_ratio", this),
           pivots_without_fill_in_ratio("pivots_without_fill_in_ratio", this),
-          degree_two_pivot_columns("degree_two_pivot_columns", this) {}
+          degree_two_pivot_columns("degree_two_pivot_columns", this),
+          dense_tail_ratio("dense_tail_ratio", this) {}
     RatioDistribution basis_singleton_column_ratio;
     RatioDistribution basis_residual_singleton_column_ratio;
     RatioDistribution pivots_without_fill_in_ratio;
     RatioDistribution degree_two_pivot_columns;
+    RatioDistribution dense_tail_ratio;
   };
   Stats stats_;
 
@@ -413,6 +415,14 @@ class Markowitz {
   // Remove...() functions above.
   void UpdateResidualMatrix(RowIndex pivot_row, ColIndex pivot_col);
 
+  // Finishes the factorization of the current residual matrix with a dense LU
+  // with partial pivoting. This is used once the residual matrix is dense: the
+  // sparse data structures only add overhead, while the dense elimination
+  // works on contiguous columns. Returns an error if the matrix is singular,
+  // in which case the permutations are filled as in the sparse algorithm.
+  ABSL_MUST_USE_RESULT Status FactorizeDenseResidualMatrix(
+      RowPermutation* row_perm, ColumnPermutation* col_perm, int* index);
+
   // Pointer to the matrix to factorize.
   CompactSparseMatrixView const* basis_matrix_;
 
@@ -461,6 +471,13 @@ class Markowitz {
   // Proto holding all the parameters of this algorithm.
   GlopParameters parameters_;
 
+  // The residual matrix used by FactorizeDenseResidualMatrix(), stored by
+  // columns, and the initial indices of its rows and columns.
+  std::vector<Fractional> dense_matrix_;
+  std::vector<RowIndex> dense_rows_;
+  std::vector<ColIndex> dense_cols_;
+  SparseColumn dense_column_;
+
   // Number of floating point operations of the last factorization.
   int64_t num_fp_operations_;
 };
@@ -0,0 +1,81 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/glop/parallel_column_loop.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/blocking_counter.h"
+
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
+
+namespace operations_research {
+namespace glop {
+
+void ParallelColumnLoop::SetNumThreads(int num_threads) {
+#if defined(__PORTABLE_PLATFORM__)
+  num_threads = 1;
+#endif  // __PORTABLE_PLATFORM__
+  num_threads = std::max(num_threads, 1);
+  if (num_threads == num_threads_) return;
+  num_threads_ = num_threads;
+#if !defined(__PORTABLE_PLATFORM__)
+  // The calling thread runs one of the blocks, so we need one less worker.
+  pool_.reset();
+  if (num_threads_ > 1) {
+    pool_ = std::make_unique<ThreadPool>("GlopLoop", num_threads_ - 1);
+    pool_->StartWorkers();
+  }
+#endif  // __PORTABLE_PLATFORM__
+}
+
+int ParallelColumnLoop::BlockSize(int size) const {
+  const int num_blocks = std::min(num_threads_, size / kMinBlockSize);
+  if (num_blocks <= 1) return size;
+  const int block_size = (size + num_blocks - 1) / num_blocks;
+  return (block_size + 63) & ~63;
+}
+
+int ParallelColumnLoop::NumBlocks(int size) const {
+  if (size == 0) return 1;
+  const int block_size = BlockSize(size);
+  return (size + block_size - 1) / block_size;
+}
+
+void ParallelColumnLoop::Run(
+    int size, absl::FunctionRef<void(int block, int begin, int end)> f) const {
+  const int num_blocks = NumBlocks(size);
+  if (num_blocks == 1) {
+    f(0, 0, size);
+    return;
+  }
+#if !defined(__PORTABLE_PLATFORM__)
+  const int block_size = BlockSize(size);
+  absl::BlockingCounter counter(num_blocks - 1);
+  for (int block = 1; block < num_blocks; ++block) {
+    pool_->Schedule([&, block]() {
+      f(block, block * block_size, std::min(size, (block + 1) * block_size));
+      counter.DecrementCount();
+    });
+  }
+  f(0, 0, block_size);
+  counter.Wait();
+#endif  // __PORTABLE_PLATFORM__
+}
+
+}  // namespace glop
+}  // namespace operations_research
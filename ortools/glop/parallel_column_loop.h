@@ -0,0 +1,75 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_GLOP_PARALLEL_COLUMN_LOOP_H_
+#define OR_TOOLS_GLOP_PARALLEL_COLUMN_LOOP_H_
+
+#include <memory>
+
+#include "absl/functional/function_ref.h"
+
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
+
+namespace operations_research {
+namespace glop {
+
+// Runs a loop over [0, size) by contiguous blocks on a thread pool. One
+// instance is owned by the RevisedSimplex and shared by all its components so
+// that we only create the threads once per solver.
+//
+// The blocks only depend on the size and on the number of threads, and all
+// their boundaries except the last one are multiples of 64 so that they can
+// be used to split a Bitset64 by words. As long as each block writes to its
+// own part of the output and the per-block results are merged in block order,
+// the result does not depend on the threads scheduling.
+class ParallelColumnLoop {
+ public:
+  ParallelColumnLoop() = default;
+
+  // This type is neither copyable nor movable.
+  ParallelColumnLoop(const ParallelColumnLoop&) = delete;
+  ParallelColumnLoop& operator=(const ParallelColumnLoop&) = delete;
+
+  // Sets the number of threads, a value <= 1 means that every loop will be
+  // run in the calling thread. This is a no-op if the number didn't change.
+  void SetNumThreads(int num_threads);
+
+  // Returns the number of blocks a loop of the given size will be split into.
+  // This is always 1 when the loop is too small to be worth splitting.
+  int NumBlocks(int size) const;
+
+  // Calls f(block, begin, end) for each of the NumBlocks(size) blocks and
+  // returns once all the calls are done. The first block is run in the calling
+  // thread.
+  void Run(int size,
+           absl::FunctionRef<void(int block, int begin, int end)> f) const;
+
+ private:
+  // Minimum number of items per block. Under this, the cost of waking up a
+  // thread is larger than the work we would give it.
+  static constexpr int kMinBlockSize = 4096;
+
+  int BlockSize(int size) const;
+
+  int num_threads_ = 1;
+#if !defined(__PORTABLE_PLATFORM__)
+  std::unique_ptr<ThreadPool> pool_;
+#endif  // __PORTABLE_PLATFORM__
+};
+
+}  // namespace glop
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GLOP_PARALLEL_COLUMN_LOOP_H_
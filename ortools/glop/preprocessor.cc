@@ -85,6 +85,8 @@ bool MainLpPreprocessor::Run(LinearProgram* lp) {
   initial_num_rows_ = lp->num_constraints();
   initial_num_cols_ = lp->num_variables();
   initial_num_entries_ = lp->num_entries();
+  preprocessor_times_.clear();
+  scaling_preprocessor_ = nullptr;
   if (parameters_.use_preprocessing()) {
     RUN_PREPROCESSOR(ShiftVariableBoundsPreprocessor);
 
@@ -139,8 +141,21 @@ bool MainLpPreprocessor::Run(LinearProgram* lp) {
   }
 
   // The scaling is controlled by use_scaling, not use_preprocessing.
+  const int num_preprocessors_before_scaling = preprocessors_.size();
   RUN_PREPROCESSOR(ScalingPreprocessor);
+  if (preprocessors_.size() > num_preprocessors_before_scaling) {
+    scaling_preprocessor_ =
+        static_cast<const ScalingPreprocessor*>(preprocessors_.back().get());
+  }
 
+  if (logger_->LoggingIsEnabled() && !preprocessor_times_.empty()) {
+    SOLVER_LOG(logger_, "");
+    SOLVER_LOG(logger_, "Presolve time per preprocessor:");
+    for (const PreprocessorTime& p : preprocessor_times_) {
+      SOLVER_LOG(logger_, absl::StrFormat("%-45s: %d runs (%fs)", p.name,
+                                          p.num_runs, p.total_time));
+    }
+  }
   return !preprocessors_.empty();
 }
 
@@ -163,9 +178,11 @@ void MainLpPreprocessor::RunAndPushIfRelevant(
     return;
   }
 
-  if (preprocessor->Run(lp)) {
+  const bool need_postsolve = preprocessor->Run(lp);
+  const double preprocess_time = time_limit->GetElapsedTime() - start_time;
+  AddPreprocessorTime(name, preprocess_time);
+  if (need_postsolve) {
     const EntryIndex new_num_entries = lp->num_entries();
-    const double preprocess_time = time_limit->GetElapsedTime() - start_time;
     SOLVER_LOG(logger_,
                absl::StrFormat(
                    "%-45s: %d(%d) rows, %d(%d) columns, %d(%d) entries. (%fs)",
@@ -193,6 +210,18 @@ void MainLpPreprocessor::RunAndPushIfRelevant(
   }
 }
 
+void MainLpPreprocessor::AddPreprocessorTime(absl::string_view name,
+                                             double time) {
+  for (PreprocessorTime& p : preprocessor_times_) {
+    if (p.name == name) {
+      ++p.num_runs;
+      p.total_time += time;
+      return;
+    }
+  }
+  preprocessor_times_.push_back({std::string(name), 1, time});
+}
+
 void MainLpPreprocessor::RecoverSolution(ProblemSolution* solution) const {
   SCOPED_INSTRUCTION_COUNT(time_limit_);
   for (const auto& p : gtl::reversed_view(preprocessors_)) {
@@ -202,12 +231,23 @@ void MainLpPreprocessor::RecoverSolution(ProblemSolution* solution) const {
 
 void MainLpPreprocessor::DestructiveRecoverSolution(ProblemSolution* solution) {
   SCOPED_INSTRUCTION_COUNT(time_limit_);
+  scaling_preprocessor_ = nullptr;
   while (!preprocessors_.empty()) {
     preprocessors_.back()->RecoverSolution(solution);
     preprocessors_.pop_back();
   }
 }
 
+bool MainLpPreprocessor::TransformPrimalValues(DenseRow* values) const {
+  RETURN_VALUE_IF_NULL(values, false);
+  if (preprocessors_.empty()) return true;
+  if (preprocessors_.size() > 1 || scaling_preprocessor_ == nullptr) {
+    return false;
+  }
+  scaling_preprocessor_->ScalePrimalValues(values);
+  return true;
+}
+
 // --------------------------------------------------------
 // ColumnDeletionHelper
 // --------------------------------------------------------
@@ -498,7 +538,8 @@ bool ProportionalColumnPreprocessor::Run(LinearProgram* lp) {
   SCOPED_INSTRUCTION_COUNT(time_limit_);
   RETURN_VALUE_IF_NULL(lp, false);
   ColMapping mapping = FindProportionalColumns(
-      lp->GetSparseMatrix(), parameters_.preprocessor_zero_tolerance());
+      lp->GetSparseMatrix(), parameters_.preprocessor_zero_tolerance(),
+      parameters_.num_omp_threads());
 
   // Compute some statistics and make each class representative point to itself
   // in the mapping. Also store the columns that are proportional to at least
@@ -870,7 +911,8 @@ bool ProportionalRowPreprocessor::Run(LinearProgram* lp) {
   // itself for the loop below. TODO(user): Already return such a mapping from
   // FindProportionalColumns()?
   ColMapping mapping = FindProportionalColumns(
-      transpose, parameters_.preprocessor_zero_tolerance());
+      transpose, parameters_.preprocessor_zero_tolerance(),
+      parameters_.num_omp_threads());
   DenseBooleanColumn is_a_representative(num_rows, false);
   int num_proportional_rows = 0;
   for (RowIndex row(0); row < num_rows; ++row) {
@@ -3788,6 +3830,14 @@ bool ScalingPreprocessor::Run(LinearProgram* lp) {
   return true;
 }
 
+void ScalingPreprocessor::ScalePrimalValues(DenseRow* values) const {
+  RETURN_IF_NULL(values);
+  for (ColIndex col(0); col < values->size(); ++col) {
+    (*values)[col] /= bound_scaling_factor_;
+  }
+  scaler_.ScaleRowVector(true, values);
+}
+
 void ScalingPreprocessor::RecoverSolution(ProblemSolution* solution) const {
   SCOPED_INSTRUCTION_COUNT(time_limit_);
   RETURN_IF_NULL(solution);
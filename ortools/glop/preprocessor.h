@@ -99,6 +99,8 @@ class Preprocessor {
   TimeLimit* time_limit_;
 };
 
+class ScalingPreprocessor;
+
 // --------------------------------------------------------
 // MainLpPreprocessor
 // --------------------------------------------------------
@@ -120,6 +122,11 @@ class MainLpPreprocessor : public Preprocessor {
   // used.
   void DestructiveRecoverSolution(ProblemSolution* solution);
 
+  // Transforms primal values of the problem given to Run() into primal values
+  // of the preprocessed problem. This is only possible if the scaling was the
+  // only preprocessor that changed the problem, returns false otherwise.
+  bool TransformPrimalValues(DenseRow* values) const;
+
   void SetLogger(SolverLogger* logger) { logger_ = logger; }
 
  private:
@@ -129,9 +136,22 @@ class MainLpPreprocessor : public Preprocessor {
                             absl::string_view name, TimeLimit* time_limit,
                             LinearProgram* lp);
 
+  // Accumulates the time spent in each preprocessor, in order of first run.
+  // This is displayed at the end of Run() when logging is enabled.
+  struct PreprocessorTime {
+    std::string name;
+    int num_runs;
+    double total_time;
+  };
+  void AddPreprocessorTime(absl::string_view name, double time);
+  std::vector<PreprocessorTime> preprocessor_times_;
+
   // Stack of preprocessors currently applied to the lp that needs postsolve.
   std::vector<std::unique_ptr<Preprocessor>> preprocessors_;
 
+  // The ScalingPreprocessor in preprocessors_ if it was applied.
+  const ScalingPreprocessor* scaling_preprocessor_ = nullptr;
+
   // Helpers for logging during presolve.
   SolverLogger default_logger_;
   SolverLogger* logger_ = &default_logger_;
@@ -1003,6 +1023,10 @@ class ScalingPreprocessor final : public Preprocessor {
   void RecoverSolution(ProblemSolution* solution) const final;
   void UseInMipContext() final { LOG(FATAL) << "Not implemented."; }
 
+  // Transforms primal values of the unscaled problem into primal values of the
+  // scaled one. This is the inverse of what RecoverSolution() does.
+  void ScalePrimalValues(DenseRow* values) const;
+
  private:
   DenseRow variable_lower_bounds_;
   DenseRow variable_upper_bounds_;
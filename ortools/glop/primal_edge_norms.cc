@@ -14,11 +14,14 @@
 #include "ortools/glop/primal_edge_norms.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 
 #include "absl/log/check.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/glop/basis_representation.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/update_row.h"
 #include "ortools/glop/variables_info.h"
@@ -33,10 +36,12 @@ namespace glop {
 
 PrimalEdgeNorms::PrimalEdgeNorms(const CompactSparseMatrix& compact_matrix,
                                  const VariablesInfo& variables_info,
-                                 const BasisFactorization& basis_factorization)
+                                 const BasisFactorization& basis_factorization,
+                                 const ParallelColumnLoop& parallel_loop)
     : compact_matrix_(compact_matrix),
       variables_info_(variables_info),
       basis_factorization_(basis_factorization),
+      parallel_loop_(parallel_loop),
       stats_(),
       recompute_edge_squared_norms_(true),
       reset_devex_weights_(true),
@@ -233,36 +238,56 @@ void PrimalEdgeNorms::UpdateEdgeSquaredNorms(ColIndex entering_col,
   const Fractional leaving_squared_norm =
       std::max(1.0, entering_squared_norm / Square(pivot));
 
-  int stat_lower_bounded_norms = 0;
   const Fractional factor = 2.0 / pivot;
   const auto view = compact_matrix_.view();
   auto output = edge_squared_norms_.view();
   const auto direction_left_inverse =
       direction_left_inverse_.values.const_view();
-  for (const ColIndex col : update_row.GetNonZeroPositions()) {
-    const Fractional coeff = update_row.GetCoefficient(col);
-    const Fractional scalar_product =
-        view.ColumnScalarProduct(col, direction_left_inverse);
-    num_operations_ += view.ColumnNumEntries(col).value();
-
-    // Update the edge squared norm of this column. Note that the update
-    // formula used is important to maximize the precision. See an explanation
-    // in the dual context in Koberstein's PhD thesis, section 8.2.2.1.
-    output[col] +=
-        coeff * (coeff * leaving_squared_norm + factor * scalar_product);
-
-    // Make sure it doesn't go under a known lower bound (TODO(user): ref?).
-    // This way norms are always >= 1.0 .
-    // TODO(user): precompute 1 / Square(pivot) or 1 / pivot? it will be
-    // slightly faster, but may introduce numerical issues. More generally,
-    // this test is only needed in a few cases, so is it worth it?
-    const Fractional lower_bound = 1.0 + Square(coeff / pivot);
-    if (output[col] < lower_bound) {
-      output[col] = lower_bound;
-      ++stat_lower_bounded_norms;
+
+  // Each column is updated independently, so we can split the non-zeros of
+  // the update row in blocks and process them in parallel.
+  const absl::Span<const ColIndex> non_zeros = update_row.GetNonZeroPositions();
+  const int num_blocks = parallel_loop_.NumBlocks(non_zeros.size());
+  tmp_block_num_operations_.assign(num_blocks, 0);
+  tmp_block_num_lower_bounded_norms_.assign(num_blocks, 0);
+  parallel_loop_.Run(non_zeros.size(), [&](int block, int begin, int end) {
+    int64_t num_operations = 0;
+    int stat_lower_bounded_norms = 0;
+    for (int i = begin; i < end; ++i) {
+      const ColIndex col = non_zeros[i];
+      const Fractional coeff = update_row.GetCoefficient(col);
+      const Fractional scalar_product =
+          view.ColumnScalarProduct(col, direction_left_inverse);
+      num_operations += view.ColumnNumEntries(col).value();
+
+      // Update the edge squared norm of this column. Note that the update
+      // formula used is important to maximize the precision. See an
+      // explanation in the dual context in Koberstein's PhD thesis, section
+      // 8.2.2.1.
+      output[col] +=
+          coeff * (coeff * leaving_squared_norm + factor * scalar_product);
+
+      // Make sure it doesn't go under a known lower bound (TODO(user): ref?).
+      // This way norms are always >= 1.0 .
+      // TODO(user): precompute 1 / Square(pivot) or 1 / pivot? it will be
+      // slightly faster, but may introduce numerical issues. More generally,
+      // this test is only needed in a few cases, so is it worth it?
+      const Fractional lower_bound = 1.0 + Square(coeff / pivot);
+      if (output[col] < lower_bound) {
+        output[col] = lower_bound;
+        ++stat_lower_bounded_norms;
+      }
     }
-  }
+    tmp_block_num_operations_[block] = num_operations;
+    tmp_block_num_lower_bounded_norms_[block] = stat_lower_bounded_norms;
+  });
   output[leaving_col] = leaving_squared_norm;
+
+  int stat_lower_bounded_norms = 0;
+  for (int block = 0; block < num_blocks; ++block) {
+    num_operations_ += tmp_block_num_operations_[block];
+    stat_lower_bounded_norms += tmp_block_num_lower_bounded_norms_[block];
+  }
   stats_.lower_bounded_norms.Add(stat_lower_bounded_norms);
 }
 
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "ortools/glop/basis_representation.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/update_row.h"
 #include "ortools/glop/variables_info.h"
@@ -63,7 +64,8 @@ class PrimalEdgeNorms {
   // supposed to reflect the correct state.
   PrimalEdgeNorms(const CompactSparseMatrix& compact_matrix,
                   const VariablesInfo& variables_info,
-                  const BasisFactorization& basis_factorization);
+                  const BasisFactorization& basis_factorization,
+                  const ParallelColumnLoop& parallel_loop);
 
   // This type is neither copyable nor movable.
   PrimalEdgeNorms(const PrimalEdgeNorms&) = delete;
@@ -192,6 +194,7 @@ class PrimalEdgeNorms {
   const CompactSparseMatrix& compact_matrix_;
   const VariablesInfo& variables_info_;
   const BasisFactorization& basis_factorization_;
+  const ParallelColumnLoop& parallel_loop_;
 
   // Internal data.
   GlopParameters parameters_;
@@ -227,6 +230,10 @@ class PrimalEdgeNorms {
   // Used by DeterministicTime().
   int64_t num_operations_;
 
+  // Per-block counters of UpdateEdgeSquaredNorms(), merged after each update.
+  std::vector<int64_t> tmp_block_num_operations_;
+  std::vector<int> tmp_block_num_lower_bounded_norms_;
+
   // Boolean(s) to set to false when the norms are changed outside of the
   // UpdateBeforeBasisPivot() function.
   std::vector<bool*> watchers_;
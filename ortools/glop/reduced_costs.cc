@@ -16,11 +16,13 @@
 #include <algorithm>
 #include <cstdlib>
 #include <random>
+#include <vector>
 
 #include "absl/log/check.h"
 #include "absl/random/bit_gen_ref.h"
 #include "ortools/base/logging.h"
 #include "ortools/glop/basis_representation.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/primal_edge_norms.h"
 #include "ortools/glop/update_row.h"
@@ -31,10 +33,6 @@
 #include "ortools/util/bitset.h"
 #include "ortools/util/stats.h"
 
-#ifdef OMP
-#include <omp.h>
-#endif
-
 #include "ortools/lp_data/lp_utils.h"
 
 namespace operations_research {
@@ -45,12 +43,14 @@ ReducedCosts::ReducedCosts(const CompactSparseMatrix& matrix,
                            const RowToColMapping& basis,
                            const VariablesInfo& variables_info,
                            const BasisFactorization& basis_factorization,
+                           const ParallelColumnLoop& parallel_loop,
                            absl::BitGenRef random)
     : matrix_(matrix),
       objective_(objective),
       basis_(basis),
       variables_info_(variables_info),
       basis_factorization_(basis_factorization),
+      parallel_loop_(parallel_loop),
       random_(random),
       parameters_(),
       stats_(),
@@ -373,49 +373,29 @@ void ReducedCosts::ComputeReducedCosts() {
 
   reduced_costs_.resize(num_cols, 0.0);
   const DenseBitRow& is_basic = variables_info_.GetIsBasicBitRow();
-#ifdef OMP
-  const int num_omp_threads = parameters_.num_omp_threads();
-#else
-  const int num_omp_threads = 1;
-#endif
-  if (num_omp_threads == 1) {
-    for (ColIndex col(0); col < num_cols; ++col) {
+
+  // Each block of columns computes its own part of the reduced costs and its
+  // own dual residual error. Since we only take their maximum, the result does
+  // not depend on the number of blocks.
+  const auto view = matrix_.view();
+  const auto dual_values = basic_objective_left_inverse_.values.const_view();
+  std::vector<Fractional> block_dual_residual_error(
+      parallel_loop_.NumBlocks(num_cols.value()), 0.0);
+  parallel_loop_.Run(num_cols.value(), [&](int block, int begin, int end) {
+    Fractional error = 0.0;
+    for (ColIndex col(begin); col < ColIndex(end); ++col) {
       reduced_costs_[col] = objective_[col] + cost_perturbations_[col] -
-                            matrix_.ColumnScalarProduct(
-                                col, basic_objective_left_inverse_.values);
+                            view.ColumnScalarProduct(col, dual_values);
 
       // We also compute the dual residual error y.B - c_B.
       if (is_basic.IsSet(col)) {
-        dual_residual_error =
-            std::max(dual_residual_error, std::abs(reduced_costs_[col]));
-      }
-    }
-  } else {
-#ifdef OMP
-    // In the multi-threaded case, perform the same computation as in the
-    // single-threaded case above.
-    std::vector<Fractional> thread_local_dual_residual_error(num_omp_threads,
-                                                             0.0);
-    const int parallel_loop_size = num_cols.value();
-#pragma omp parallel for num_threads(num_omp_threads)
-    for (int i = 0; i < parallel_loop_size; i++) {
-      const ColIndex col(i);
-      reduced_costs_[col] = objective_[col] + objective_perturbation_[col] -
-                            matrix_.ColumnScalarProduct(
-                                col, basic_objective_left_inverse_.values);
-
-      if (is_basic.IsSet(col)) {
-        thread_local_dual_residual_error[omp_get_thread_num()] =
-            std::max(thread_local_dual_residual_error[omp_get_thread_num()],
-                     std::abs(reduced_costs_[col]));
+        error = std::max(error, std::abs(reduced_costs_[col]));
       }
     }
-    // end of omp parallel for
-    for (int i = 0; i < num_omp_threads; i++) {
-      dual_residual_error =
-          std::max(dual_residual_error, thread_local_dual_residual_error[i]);
-    }
-#endif  // OMP
+    block_dual_residual_error[block] = error;
+  });
+  for (const Fractional error : block_dual_residual_error) {
+    dual_residual_error = std::max(dual_residual_error, error);
   }
 
   deterministic_time_ +=
@@ -19,6 +19,7 @@
 
 #include "absl/random/bit_gen_ref.h"
 #include "ortools/glop/basis_representation.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/pricing.h"
 #include "ortools/glop/primal_edge_norms.h"
@@ -57,6 +58,7 @@ class ReducedCosts {
                const RowToColMapping& basis,
                const VariablesInfo& variables_info,
                const BasisFactorization& basis_factorization,
+               const ParallelColumnLoop& parallel_loop,
                absl::BitGenRef random);
 
   // This type is neither copyable nor movable.
@@ -241,6 +243,7 @@ class ReducedCosts {
   const RowToColMapping& basis_;
   const VariablesInfo& variables_info_;
   const BasisFactorization& basis_factorization_;
+  const ParallelColumnLoop& parallel_loop_;
   absl::BitGenRef random_;
 
   // Internal data.
@@ -23,6 +23,8 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/casts.h"
+#include "absl/base/internal/endian.h"
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
 #include "absl/random/bit_gen_ref.h"
@@ -32,6 +34,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "ortools/base/hash.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
 #include "ortools/glop/basis_representation.h"
@@ -77,6 +80,42 @@ class Cleanup {
  private:
   std::function<void()> closure_;
 };
+
+// Identifies the format of SerializeStateForNextSolve(). All the values are
+// stored in little-endian order:
+// - The magic number and the matrix fingerprint.
+// - The number of columns, then one byte per variable status.
+// - The number of rows with a dual edge norm (either 0 or the number of rows
+//   of the matrix), then for each row the basic column and its squared norm.
+constexpr uint32_t kSerializedStateMagic = 0x31534c47;  // "GLS1"
+
+void AppendUint32(uint32_t value, std::string* blob) {
+  char buffer[sizeof(value)];
+  absl::little_endian::Store32(buffer, value);
+  blob->append(buffer, sizeof(buffer));
+}
+
+void AppendUint64(uint64_t value, std::string* blob) {
+  char buffer[sizeof(value)];
+  absl::little_endian::Store64(buffer, value);
+  blob->append(buffer, sizeof(buffer));
+}
+
+// Reads a value at the start of the blob and removes it. Returns false if the
+// blob is too short.
+bool ConsumeUint32(absl::string_view* blob, uint32_t* value) {
+  if (blob->size() < sizeof(*value)) return false;
+  *value = absl::little_endian::Load32(blob->data());
+  blob->remove_prefix(sizeof(*value));
+  return true;
+}
+
+bool ConsumeUint64(absl::string_view* blob, uint64_t* value) {
+  if (blob->size() < sizeof(*value)) return false;
+  *value = absl::little_endian::Load64(blob->data());
+  blob->remove_prefix(sizeof(*value));
+  return true;
+}
 }  // namespace
 
 #define DCHECK_COL_BOUNDS(col) \
@@ -112,15 +151,15 @@ RevisedSimplex::RevisedSimplex()
       basis_factorization_(&compact_matrix_, &basis_),
       variables_info_(compact_matrix_),
       primal_edge_norms_(compact_matrix_, variables_info_,
-                         basis_factorization_),
-      dual_edge_norms_(basis_factorization_),
+                         basis_factorization_, parallel_loop_),
+      dual_edge_norms_(basis_factorization_, parallel_loop_),
       dual_prices_(random_),
       variable_values_(parameters_, compact_matrix_, basis_, variables_info_,
                        basis_factorization_, &dual_edge_norms_, &dual_prices_),
       update_row_(compact_matrix_, transposed_matrix_, variables_info_, basis_,
-                  basis_factorization_),
+                  basis_factorization_, parallel_loop_),
       reduced_costs_(compact_matrix_, objective_, basis_, variables_info_,
-                     basis_factorization_, random_),
+                     basis_factorization_, parallel_loop_, random_),
       entering_variable_(variables_info_, random_, &reduced_costs_),
       primal_prices_(random_, variables_info_, &primal_edge_norms_,
                      &reduced_costs_),
@@ -149,6 +188,86 @@ void RevisedSimplex::LoadStateForNextSolve(const BasisState& state) {
   solution_state_has_been_set_externally_ = true;
 }
 
+std::string RevisedSimplex::SerializeStateForNextSolve() const {
+  std::string blob;
+  AppendUint32(kSerializedStateMagic, &blob);
+  AppendUint64(ComputeMatrixFingerprint(), &blob);
+  AppendUint32(solution_state_.statuses.size().value(), &blob);
+  for (const VariableStatus status : solution_state_.statuses) {
+    blob.push_back(static_cast<char>(status));
+  }
+
+  // The norms are only valid for the basis of solution_state_ if they were
+  // kept up to date until the end of the solve.
+  const bool has_norms = !solution_state_.IsEmpty() &&
+                         !dual_edge_norms_.NeedsBasisRefactorization() &&
+                         basis_.size() == num_rows_;
+  AppendUint32(has_norms ? num_rows_.value() : 0, &blob);
+  if (has_norms) {
+    const DenseColumn& norms = dual_edge_norms_.GetCurrentEdgeSquaredNorms();
+    for (RowIndex row(0); row < num_rows_; ++row) {
+      AppendUint32(basis_[row].value(), &blob);
+      AppendUint64(absl::bit_cast<uint64_t>(norms[row]), &blob);
+    }
+  }
+  return blob;
+}
+
+Status RevisedSimplex::LoadSerializedStateForNextSolve(
+    absl::string_view blob) {
+  const auto error = [](absl::string_view message) {
+    return Status(Status::ERROR_INVALID_PROBLEM,
+                  absl::StrCat("Invalid serialized state: ", message));
+  };
+  uint32_t magic = 0;
+  uint64_t fingerprint = 0;
+  uint32_t num_cols = 0;
+  if (!ConsumeUint32(&blob, &magic) || magic != kSerializedStateMagic) {
+    return error("unknown format.");
+  }
+  if (!ConsumeUint64(&blob, &fingerprint) ||
+      !ConsumeUint32(&blob, &num_cols) || blob.size() < num_cols) {
+    return error("truncated header or statuses.");
+  }
+  BasisState state;
+  state.statuses.resize(ColIndex(num_cols));
+  for (ColIndex col(0); col < ColIndex(num_cols); ++col) {
+    const int8_t status = static_cast<int8_t>(blob[col.value()]);
+    if (status < static_cast<int8_t>(VariableStatus::BASIC) ||
+        status > static_cast<int8_t>(VariableStatus::FREE)) {
+      return error(absl::StrCat("bad status for column ", col.value(), "."));
+    }
+    state.statuses[col] = static_cast<VariableStatus>(status);
+  }
+  blob.remove_prefix(num_cols);
+
+  uint32_t num_norms = 0;
+  if (!ConsumeUint32(&blob, &num_norms)) return error("truncated norms.");
+  DenseRow norms;
+  if (num_norms > 0) norms.resize(ColIndex(num_cols), 0.0);
+  for (uint32_t i = 0; i < num_norms; ++i) {
+    uint32_t col = 0;
+    uint64_t norm_bits = 0;
+    if (!ConsumeUint32(&blob, &col) || !ConsumeUint64(&blob, &norm_bits)) {
+      return error("truncated norms.");
+    }
+    const Fractional norm = absl::bit_cast<Fractional>(norm_bits);
+    if (col >= num_cols ||
+        state.statuses[ColIndex(col)] != VariableStatus::BASIC ||
+        !(norm > 0.0) || !std::isfinite(norm)) {
+      return error(absl::StrCat("bad norm for column ", col, "."));
+    }
+    norms[ColIndex(col)] = norm;
+  }
+  if (!blob.empty()) return error("unexpected trailing data.");
+
+  LoadStateForNextSolve(state);
+  has_serialized_state_ = true;
+  serialized_matrix_fingerprint_ = fingerprint;
+  serialized_dual_edge_norms_ = std::move(norms);
+  return Status::OK();
+}
+
 void RevisedSimplex::SetStartingVariableValuesForNextSolve(
     const DenseRow& values) {
   variable_starting_values_ = values;
@@ -1005,14 +1124,21 @@ bool RevisedSimplex::InitializeMatrixAndTestIfUnchanged(
                                            : ColIndex(0);
 
   // Initialize first_slack_.
+  const ColIndex old_first_slack_col = first_slack_col_;
   first_slack_col_ = lp_first_slack;
 
   // Initialize the new dimensions.
   num_rows_ = lp.num_constraints();
   num_cols_ = lp_first_slack + RowToColIndex(lp.num_constraints());
 
-  // Populate compact_matrix_ and transposed_matrix_ if needed.
-  if (lp_is_in_equation_form) {
+  // Populate compact_matrix_ and transposed_matrix_ if needed. When only new
+  // columns were added, as in a column generation loop, we keep the old
+  // columns and only copy the new ones and the slacks.
+  if (*only_change_is_new_cols) {
+    compact_matrix_.PopulateNewColumnsFromSparseMatrix(
+        lp.GetSparseMatrix(), old_first_slack_col,
+        /*add_slacks=*/!lp_is_in_equation_form);
+  } else if (lp_is_in_equation_form) {
     // TODO(user): This can be sped up by removing the MatrixView, but then
     // this path will likely go away.
     compact_matrix_.PopulateFromMatrixView(MatrixView(lp.GetSparseMatrix()));
@@ -1225,7 +1351,8 @@ Status RevisedSimplex::CreateInitialBasis() {
   }
   if (parameters_.initial_basis() == GlopParameters::MAROS) {
     InitialBasis initial_basis(compact_matrix_, objective_, lower_bounds,
-                               upper_bounds, variables_info_.GetTypeRow());
+                               upper_bounds, variables_info_.GetTypeRow(),
+                               parallel_loop_);
     if (parameters_.use_dual_simplex()) {
       // This dual version only uses zero-cost columns to complete the
       // basis.
@@ -1261,7 +1388,8 @@ Status RevisedSimplex::CreateInitialBasis() {
       SOLVER_LOG(logger_, "Trying to remove ", num_fixed_variables,
                  " fixed variables from the initial basis.");
       InitialBasis initial_basis(compact_matrix_, objective_, lower_bounds,
-                                 upper_bounds, variables_info_.GetTypeRow());
+                                 upper_bounds, variables_info_.GetTypeRow(),
+                                 parallel_loop_);
 
       if (parameters_.initial_basis() == GlopParameters::BIXBY) {
         if (parameters_.use_scaling()) {
@@ -1393,6 +1521,18 @@ Status RevisedSimplex::Initialize(const LinearProgram& lp) {
   }
   notify_that_matrix_is_unchanged_ = false;
 
+  // A serialized state can only be checked once the matrix is known.
+  if (has_serialized_state_) {
+    has_serialized_state_ = false;
+    if (serialized_matrix_fingerprint_ != ComputeMatrixFingerprint()) {
+      SOLVER_LOG(logger_,
+                 "Ignoring the serialized state: it was computed for another "
+                 "constraint matrix.");
+      solution_state_.statuses.clear();
+      serialized_dual_edge_norms_.clear();
+    }
+  }
+
   // TODO(user): move objective with ReducedCosts class.
   const bool objective_is_unchanged = InitializeObjectiveAndTestIfUnchanged(lp);
 
@@ -1573,7 +1713,9 @@ Status RevisedSimplex::Initialize(const LinearProgram& lp) {
                    "basis because it is not factorizable.");
       }
     }
+    if (!solve_from_scratch) UseSerializedDualEdgeNorms();
   }
+  serialized_dual_edge_norms_.clear();
 
   if (solve_from_scratch) {
     SOLVER_LOG(logger_, "Starting basis: create from scratch.");
@@ -1640,6 +1782,34 @@ void RevisedSimplex::DisplayBasicVariableStatistics() {
              ComputeNumberOfSuperBasicVariables());
 }
 
+uint64_t RevisedSimplex::ComputeMatrixFingerprint() const {
+  uint64_t fingerprint = util_hash::Hash(compact_matrix_.num_rows().value(),
+                                         compact_matrix_.num_cols().value());
+  for (ColIndex col(0); col < compact_matrix_.num_cols(); ++col) {
+    for (const SparseColumn::Entry e : compact_matrix_.column(col)) {
+      fingerprint = util_hash::Hash(
+          e.row().value(), absl::bit_cast<uint64_t>(e.coefficient()),
+          fingerprint);
+    }
+    fingerprint = util_hash::Hash(col.value(), fingerprint);
+  }
+  return fingerprint;
+}
+
+void RevisedSimplex::UseSerializedDualEdgeNorms() {
+  if (serialized_dual_edge_norms_.empty()) return;
+  DCHECK_EQ(serialized_dual_edge_norms_.size(), num_cols_);
+  DenseColumn norms(num_rows_, 0.0);
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    // A zero means that the basis was changed to be factorizable, in which
+    // case the norms are recomputed as usual.
+    norms[row] = serialized_dual_edge_norms_[basis_[row]];
+    if (norms[row] == 0.0) return;
+  }
+  SOLVER_LOG(logger_, "Using the dual edge norms of the serialized state.");
+  dual_edge_norms_.SetEdgeSquaredNorms(norms);
+}
+
 void RevisedSimplex::SaveState() {
   DCHECK_EQ(num_cols_, variables_info_.GetStatusRow().size());
   solution_state_.statuses = variables_info_.GetStatusRow();
@@ -3637,6 +3807,7 @@ void RevisedSimplex::SetParameters(const GlopParameters& parameters) {
 
 void RevisedSimplex::PropagateParameters() {
   SCOPED_TIME_STAT(&function_stats_);
+  parallel_loop_.SetNumThreads(parameters_.num_omp_threads());
   basis_factorization_.SetParameters(parameters_);
   entering_variable_.SetParameters(parameters_);
   reduced_costs_.SetParameters(parameters_);
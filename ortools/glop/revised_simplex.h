@@ -99,11 +99,13 @@
 #include "absl/log/die_if_null.h"
 #include "absl/random/bit_gen_ref.h"
 #include "absl/random/random.h"
+#include "absl/strings/string_view.h"
 #include "ortools/base/types.h"
 #include "ortools/glop/basis_representation.h"
 #include "ortools/glop/dual_edge_norms.h"
 #include "ortools/glop/entering_variable.h"
 #include "ortools/glop/lu_factorization.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/pricing.h"
 #include "ortools/glop/primal_edge_norms.h"
@@ -165,6 +167,25 @@ class RevisedSimplex {
   // Uses the given state as a warm-start for the next Solve() call.
   void LoadStateForNextSolve(const BasisState& state);
 
+  // Serializes the state of the last Solve() into a compact binary blob that
+  // can be loaded by LoadSerializedStateForNextSolve(), possibly by another
+  // process solving a problem with the same constraint matrix. The blob
+  // contains the variable statuses, a fingerprint of the constraint matrix
+  // and, if they are up to date, the dual edge norms of the final basis.
+  //
+  // The LU factorization is not part of the blob: it is recomputed from the
+  // basis, which is a single factorization, whereas recomputing the dual edge
+  // norms needs one solve per row.
+  std::string SerializeStateForNextSolve() const;
+
+  // Uses a blob from SerializeStateForNextSolve() as a warm-start for the next
+  // Solve() call. Returns an error if the blob is malformed. The blob is
+  // ignored by the next Solve() if its constraint matrix (slack columns
+  // included) does not have the same fingerprint, and its dual edge norms are
+  // only used if the basis could be factorized as is.
+  ABSL_MUST_USE_RESULT Status
+  LoadSerializedStateForNextSolve(absl::string_view blob);
+
   // Advanced usage. While constructing the initial basis, if this is called
   // then we will use these values as the initial starting value for the FREE
   // variables.
@@ -424,6 +445,14 @@ class RevisedSimplex {
   // Entry point for the solver initialization.
   ABSL_MUST_USE_RESULT Status Initialize(const LinearProgram& lp);
 
+  // Returns a hash of the dimensions and entries of compact_matrix_ that is
+  // stable across processes.
+  uint64_t ComputeMatrixFingerprint() const;
+
+  // Sets the dual edge norms from the ones of the serialized state if the
+  // current basis is the one of this state.
+  void UseSerializedDualEdgeNorms();
+
   // Saves the current variable statuses in solution_state_.
   void SaveState();
 
@@ -708,6 +737,13 @@ class RevisedSimplex {
   BasisState solution_state_;
   bool solution_state_has_been_set_externally_;
 
+  // The part of the state loaded by LoadSerializedStateForNextSolve() that is
+  // only used by the next Solve(). The dual edge norms are indexed by basic
+  // column, and empty if the blob had none.
+  bool has_serialized_state_ = false;
+  uint64_t serialized_matrix_fingerprint_ = 0;
+  DenseRow serialized_dual_edge_norms_;
+
   // If this is cleared, we assume they are none.
   DenseRow variable_starting_values_;
 
@@ -741,6 +777,10 @@ class RevisedSimplex {
   // Representation of matrix B using eta matrices and LU decomposition.
   BasisFactorization basis_factorization_;
 
+  // Thread pool shared by the classes below to split their loops over the
+  // columns. It must outlive them, hence its position.
+  ParallelColumnLoop parallel_loop_;
+
   // Classes responsible for maintaining the data of the corresponding names.
   VariablesInfo variables_info_;
   PrimalEdgeNorms primal_edge_norms_;
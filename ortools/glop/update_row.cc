@@ -13,19 +13,23 @@
 
 #include "ortools/glop/update_row.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/glop/basis_representation.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/variables_info.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/lp_utils.h"
 #include "ortools/lp_data/scattered_vector.h"
 #include "ortools/lp_data/sparse.h"
+#include "ortools/util/bitset.h"
 #include "ortools/util/stats.h"
 
 namespace operations_research {
@@ -35,12 +39,14 @@ UpdateRow::UpdateRow(const CompactSparseMatrix& matrix,
                      const CompactSparseMatrix& transposed_matrix,
                      const VariablesInfo& variables_info,
                      const RowToColMapping& basis,
-                     const BasisFactorization& basis_factorization)
+                     const BasisFactorization& basis_factorization,
+                     const ParallelColumnLoop& parallel_loop)
     : matrix_(matrix),
       transposed_matrix_(transposed_matrix),
       variables_info_(variables_info),
       basis_(basis),
       basis_factorization_(basis_factorization),
+      parallel_loop_(parallel_loop),
       unit_row_left_inverse_(),
       non_zero_position_list_(),
       non_zero_position_set_(),
@@ -298,6 +304,10 @@ void UpdateRow::ComputeUpdatesForSingleRow(ColIndex row_as_col) {
 
 void UpdateRow::ComputeUpdatesColumnWise() {
   SCOPED_TIME_STAT(&stats_);
+  if (parallel_loop_.NumBlocks(matrix_.num_cols().value()) > 1) {
+    ComputeUpdatesColumnWiseInParallel();
+    return;
+  }
 
   coefficient_.resize(matrix_.num_cols(), 0.0);
   non_zero_position_list_.resize(matrix_.num_cols().value());
@@ -324,6 +334,49 @@ void UpdateRow::ComputeUpdatesColumnWise() {
   num_non_zeros_ = non_zeros - non_zero_position_list_.data();
 }
 
+// Same as ComputeUpdatesColumnWise(), but each block of columns is processed by
+// a different thread. Each block only writes the coefficients of its columns
+// and we concatenate the non-zeros of the blocks in order, so the result is
+// exactly the same as the one of the sequential version.
+void UpdateRow::ComputeUpdatesColumnWiseInParallel() {
+  const int num_cols = matrix_.num_cols().value();
+  coefficient_.resize(matrix_.num_cols(), 0.0);
+  block_non_zeros_.resize(parallel_loop_.NumBlocks(num_cols));
+
+  const Fractional drop_tolerance = parameters_.drop_tolerance();
+  const auto output_coeffs = coefficient_.view();
+  const auto view = matrix_.view();
+  const auto unit_row_left_inverse = unit_row_left_inverse_.values.const_view();
+  const uint64_t* is_relevant =
+      variables_info_.GetIsRelevantBitRow().const_view().data();
+  parallel_loop_.Run(num_cols, [&](int block, int begin, int end) {
+    std::vector<ColIndex>& non_zeros = block_non_zeros_[block];
+    non_zeros.clear();
+
+    // The block boundaries are multiples of 64 except for the last one.
+    const int end_word = BitLength64(end);
+    for (int word = BitOffset64(begin); word < end_word; ++word) {
+      for (uint64_t bits = is_relevant[word]; bits != 0; bits &= bits - 1) {
+        const ColIndex col(BitShift64(word) |
+                           LeastSignificantBitPosition64(bits));
+        const Fractional coeff =
+            view.ColumnScalarProduct(col, unit_row_left_inverse);
+        if (std::abs(coeff) > drop_tolerance) {
+          non_zeros.push_back(col);
+          output_coeffs[col] = coeff;
+        }
+      }
+    }
+  });
+
+  non_zero_position_list_.clear();
+  for (const std::vector<ColIndex>& non_zeros : block_non_zeros_) {
+    non_zero_position_list_.insert(non_zero_position_list_.end(),
+                                   non_zeros.begin(), non_zeros.end());
+  }
+  num_non_zeros_ = non_zero_position_list_.size();
+}
+
 // Note that we use the same algo as ComputeUpdatesColumnWise() here. The
 // others version might be faster, but this is called at most once per solve, so
 // it shouldn't be too bad.
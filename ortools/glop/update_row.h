@@ -20,6 +20,7 @@
 
 #include "absl/types/span.h"
 #include "ortools/glop/basis_representation.h"
+#include "ortools/glop/parallel_column_loop.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/variables_info.h"
 #include "ortools/lp_data/lp_types.h"
@@ -47,7 +48,8 @@ class UpdateRow {
   UpdateRow(const CompactSparseMatrix& matrix,
             const CompactSparseMatrix& transposed_matrix,
             const VariablesInfo& variables_info, const RowToColMapping& basis,
-            const BasisFactorization& basis_factorization);
+            const BasisFactorization& basis_factorization,
+            const ParallelColumnLoop& parallel_loop);
 
   // This type is neither copyable nor movable.
   UpdateRow(const UpdateRow&) = delete;
@@ -121,6 +123,7 @@ class UpdateRow {
   void ComputeUpdatesRowWise();
   void ComputeUpdatesRowWiseHypersparse();
   void ComputeUpdatesColumnWise();
+  void ComputeUpdatesColumnWiseInParallel();
   void ComputeUpdatesForSingleRow(ColIndex row_as_col);
 
   // Problem data that should be updated from outside.
@@ -129,6 +132,7 @@ class UpdateRow {
   const VariablesInfo& variables_info_;
   const RowToColMapping& basis_;
   const BasisFactorization& basis_factorization_;
+  const ParallelColumnLoop& parallel_loop_;
 
   // Left inverse by B of a unit row. Its scalar product with a column 'a' of A
   // gives the value of the right inverse of 'a' on the 'leaving_row'.
@@ -144,6 +148,9 @@ class UpdateRow {
   DenseBitRow non_zero_position_set_;
   DenseRow coefficient_;
 
+  // Non-zero positions of each block of ComputeUpdatesColumnWiseInParallel().
+  std::vector<std::vector<ColIndex>> block_non_zeros_;
+
   // Boolean used to avoid recomputing many times the same thing.
   bool compute_update_row_;
   RowIndex left_inverse_computed_for_ = kInvalidRow;
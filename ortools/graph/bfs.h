@@ -14,13 +14,18 @@
 #ifndef UTIL_GRAPH_BFS_H_
 #define UTIL_GRAPH_BFS_H_
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
+#include "absl/numeric/bits.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "ortools/base/threadpool.h"
 
 // These 3 functions give the full functionality of a BFS (Breadth-First-Search)
 // on any type of Graph on dense integers that implements the [] operator to
@@ -36,7 +41,8 @@
 // are reasonably optimized. You may still get performance gains if you
 // implement your own BFS for your application. In particular, this API is
 // optimized for repeated calls to GetBFSShortestPath(); if you only care about
-// GetBFSDistances() there exists more optimized implementations.
+// GetBFSDistances() there exists more optimized implementations, like
+// GetParallelBFSDistances() below for large graphs.
 //
 // ERRORS:
 // This library does perform many checks at runtime, and returns an error Status
@@ -94,6 +100,25 @@ template <class NodeIndex>
 absl::StatusOr<std::vector<NodeIndex>> GetBFSShortestPath(
     const std::vector<NodeIndex>& bfs_tree, NodeIndex target);
 
+// Returns the distances of all nodes from the closest of the `sources`, or -1
+// for the nodes that can't be reached, like GetBFSDistances() but without
+// building the BFS tree. This is meant for large graphs: the BFS is run level
+// by level on `num_threads` threads, and it is direction-optimizing, i.e. the
+// levels with a large frontier are explored "bottom-up", by scanning the
+// predecessors of the unvisited nodes until one is found in the frontier,
+// instead of scanning all the successors of the frontier. See S. Beamer,
+// K. Asanovic, D. Patterson, "Direction-Optimizing Breadth-First Search",
+// SC 2012.
+//
+// `reverse_graph` must list the predecessors of each node, i.e.
+// reverse_graph[i] contains j iff graph[j] contains i. For an undirected graph
+// both can be the same object. For a util::StaticGraph<> this is the
+// StaticGraph<> with the reversed arcs.
+template <class Graph, class ReverseGraph, class NodeIndex = int>
+absl::StatusOr<std::vector<NodeIndex>> GetParallelBFSDistances(
+    const Graph& graph, const ReverseGraph& reverse_graph, NodeIndex num_nodes,
+    const std::vector<NodeIndex>& sources, int num_threads);
+
 // _____________________________________________________________________________
 // Implementation of the templates.
 
@@ -225,6 +250,192 @@ absl::StatusOr<std::vector<NodeIndex>> GetBFSShortestPath(
   return path;
 }
 
+namespace internal {
+
+// Calls f(begin, end) on consecutive chunks of [0, size), whose bounds are
+// multiples of `alignment`, in parallel on `num_threads` threads. Small ranges
+// are processed sequentially, since a level of the BFS can be tiny.
+template <class F>
+void ParallelForChunks(int num_threads, size_t size, size_t alignment,
+                       const F& f) {
+  constexpr size_t kMinChunkSize = 1 << 14;
+  const size_t num_chunks =
+      std::min<size_t>(4 * num_threads, size / kMinChunkSize);
+  if (num_threads <= 1 || num_chunks <= 1) {
+    f(size_t{0}, size);
+    return;
+  }
+  size_t chunk_size = (size + num_chunks - 1) / num_chunks;
+  chunk_size = (chunk_size + alignment - 1) / alignment * alignment;
+  operations_research::ThreadPool pool("BFS", num_threads);
+  pool.StartWorkers();
+  for (size_t begin = 0; begin < size; begin += chunk_size) {
+    const size_t end = std::min(size, begin + chunk_size);
+    pool.Schedule([&f, begin, end]() { f(begin, end); });
+  }
+}
+
+}  // namespace internal
+
+template <class Graph, class ReverseGraph, class NodeIndex>
+absl::StatusOr<std::vector<NodeIndex>> GetParallelBFSDistances(
+    const Graph& graph, const ReverseGraph& reverse_graph, NodeIndex num_nodes,
+    const std::vector<NodeIndex>& sources, int num_threads) {
+  if (num_nodes < 0) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Invalid num_nodes=%d", num_nodes));
+  }
+  constexpr NodeIndex kNone = -1;  // NOLINT
+  // Each thread only writes to the whole words of the bitsets covering the
+  // nodes of its chunks.
+  constexpr size_t kWordSize = 64;
+  const size_t num_words = (static_cast<size_t>(num_nodes) + kWordSize - 1) /
+                           kWordSize;
+  std::vector<NodeIndex> distance(num_nodes, kNone);
+  std::vector<std::atomic<uint64_t>> visited(num_words);
+  const auto is_visited = [&visited](NodeIndex node) {
+    return (visited[node / kWordSize].load(std::memory_order_relaxed) >>
+            (node % kWordSize)) &
+           1;
+  };
+  std::vector<NodeIndex> frontier;
+  for (const NodeIndex source : sources) {
+    if (source < 0 || source >= num_nodes) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Invalid source=%d, not in [0, num_nodes=%d)", source, num_nodes));
+    }
+    if (distance[source] == 0) continue;
+    distance[source] = 0;
+    visited[source / kWordSize].fetch_or(uint64_t{1} << (source % kWordSize),
+                                         std::memory_order_relaxed);
+    frontier.push_back(source);
+  }
+
+  // The thresholds of the direction switching heuristic, from the paper: go
+  // bottom-up when the successors of the frontier have more than 1/kAlpha of
+  // the arcs entering the unvisited nodes, and back to top-down when the
+  // frontier has less than 1/kBeta of the nodes.
+  constexpr int64_t kAlpha = 14;
+  constexpr int64_t kBeta = 24;
+  std::atomic<int64_t> num_unexplored_arcs = 0;
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    if (distance[node] == kNone) {
+      num_unexplored_arcs += reverse_graph[node].size();
+    }
+  }
+  std::atomic<bool> has_invalid_node = false;
+  const auto is_valid = [num_nodes, &has_invalid_node](NodeIndex node) {
+    if (node >= 0 && node < num_nodes) return true;
+    has_invalid_node.store(true, std::memory_order_relaxed);
+    return false;
+  };
+
+  std::vector<uint64_t> frontier_bitset;
+  std::vector<uint64_t> next_frontier_bitset;
+  bool bottom_up = false;
+  int64_t frontier_size = frontier.size();
+  for (NodeIndex level = 0; frontier_size > 0; ++level) {
+    if (!bottom_up) {
+      int64_t num_frontier_arcs = 0;
+      for (const NodeIndex node : frontier) {
+        num_frontier_arcs += graph[node].size();
+      }
+      if (num_frontier_arcs > num_unexplored_arcs / kAlpha) {
+        bottom_up = true;
+        frontier_bitset.assign(num_words, 0);
+        for (const NodeIndex node : frontier) {
+          frontier_bitset[node / kWordSize] |= uint64_t{1}
+                                               << (node % kWordSize);
+        }
+      }
+    } else if (frontier_size < num_nodes / kBeta) {
+      bottom_up = false;
+      frontier.clear();
+      for (size_t word = 0; word < num_words; ++word) {
+        for (uint64_t bits = frontier_bitset[word]; bits != 0;
+             bits &= bits - 1) {
+          frontier.push_back(word * kWordSize + absl::countr_zero(bits));
+        }
+      }
+    }
+
+    if (bottom_up) {
+      // Each unvisited node looks for a predecessor in the frontier.
+      next_frontier_bitset.assign(num_words, 0);
+      std::atomic<int64_t> next_frontier_size = 0;
+      internal::ParallelForChunks(
+          num_threads, num_nodes, kWordSize, [&](size_t begin, size_t end) {
+            int64_t num_new_nodes = 0;
+            int64_t num_new_arcs = 0;
+            for (NodeIndex node = static_cast<NodeIndex>(begin);
+                 node < static_cast<NodeIndex>(end); ++node) {
+              if (is_visited(node)) continue;
+              const auto& predecessors = reverse_graph[node];
+              for (const NodeIndex predecessor : predecessors) {
+                if (!is_valid(predecessor)) break;
+                if (!((frontier_bitset[predecessor / kWordSize] >>
+                       (predecessor % kWordSize)) &
+                      1)) {
+                  continue;
+                }
+                distance[node] = level + 1;
+                const uint64_t bit = uint64_t{1} << (node % kWordSize);
+                next_frontier_bitset[node / kWordSize] |= bit;
+                visited[node / kWordSize].fetch_or(bit,
+                                                   std::memory_order_relaxed);
+                ++num_new_nodes;
+                num_new_arcs += predecessors.size();
+                break;
+              }
+            }
+            next_frontier_size += num_new_nodes;
+            num_unexplored_arcs -= num_new_arcs;
+          });
+      frontier_bitset.swap(next_frontier_bitset);
+      frontier_size = next_frontier_size;
+    } else {
+      // The frontier nodes claim their unvisited successors, each thread
+      // collects the ones it claimed.
+      const int num_chunks = std::max(1, 4 * num_threads);
+      std::vector<std::vector<NodeIndex>> next_frontiers(num_chunks);
+      std::atomic<int> next_chunk = 0;
+      internal::ParallelForChunks(
+          num_threads, frontier.size(), 1, [&](size_t begin, size_t end) {
+            std::vector<NodeIndex>& next_frontier =
+                next_frontiers[next_chunk++];
+            int64_t num_new_arcs = 0;
+            for (size_t i = begin; i < end; ++i) {
+              for (const NodeIndex child : graph[frontier[i]]) {
+                if (!is_valid(child) || is_visited(child)) continue;
+                const uint64_t bit = uint64_t{1} << (child % kWordSize);
+                if (visited[child / kWordSize].fetch_or(
+                        bit, std::memory_order_relaxed) &
+                    bit) {
+                  continue;
+                }
+                distance[child] = level + 1;
+                next_frontier.push_back(child);
+                num_new_arcs += reverse_graph[child].size();
+              }
+            }
+            num_unexplored_arcs -= num_new_arcs;
+          });
+      frontier.clear();
+      for (const std::vector<NodeIndex>& next_frontier : next_frontiers) {
+        frontier.insert(frontier.end(), next_frontier.begin(),
+                        next_frontier.end());
+      }
+      frontier_size = frontier.size();
+    }
+    if (has_invalid_node) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Invalid graph: it contains a node index not in [0, num_nodes=%d)",
+          num_nodes));
+    }
+  }
+  return distance;
+}
+
 }  // namespace graph
 }  // namespace util
 
@@ -533,19 +533,18 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
 
     // Visit the neighbors.
     const DistanceType limit = distance_limit - top.distance;
-    for (const int arc : graph_->OutgoingArcs(top.node)) {
+    const auto visit_arc = [&](int arc, int head) {
       // Overflow-safe check of top.distance + arc_length >= distance_limit.
       // This works since we know top.distance < distance_limit, as long as we
       // don't have negative top.distance (which might happen with negative
       // source offset). Note that for floating point, it is not exactly the
       // same as (top_distance + arc_length < distance_limit) though.
       const DistanceType arc_length = GetArcLength(arc);
-      if (arc_length >= limit) continue;
+      if (arc_length >= limit) return;
       const DistanceType candidate_distance = top.distance + arc_length;
 
-      const int head = graph_->Head(arc);
       if (is_reached_[head]) {
-        if (candidate_distance >= distances_[head]) continue;
+        if (candidate_distance >= distances_[head]) return;
       } else {
         is_reached_[head] = true;
         reached_nodes_.push_back(head);
@@ -556,6 +555,17 @@ BoundedDijkstraWrapper<GraphType, DistanceType, ArcLengthFunctor>::
       queue_.push_back({head, candidate_distance});
       std::push_heap(queue_.begin(), queue_.end(),
                      std::greater<NodeDistance>());
+    };
+    // Graphs without O(1) Head(), like util::CompressedStaticGraph, give the
+    // heads while iterating over the arcs.
+    if constexpr (requires { graph_->OutgoingArcsWithHeads(top.node); }) {
+      for (const auto [arc, head] : graph_->OutgoingArcsWithHeads(top.node)) {
+        visit_arc(arc, head);
+      }
+    } else {
+      for (const int arc : graph_->OutgoingArcs(top.node)) {
+        visit_arc(arc, graph_->Head(arc));
+      }
     }
   }
 
@@ -14,12 +14,22 @@
 #include "ortools/graph/cliques.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/numeric/bits.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/util/time_limit.h"
 
 namespace operations_research {
 namespace {
@@ -262,4 +272,460 @@ void CoverArcsByCliques(std::function<bool(int, int)> graph, int node_count,
          initial_candidates.get(), 0, node_count, &actual, &stop);
 }
 
+namespace {
+// The number of calls to CliqueSubproblemSolver::Expand() between two checks
+// of the time limit.
+constexpr int kNumExpansionsBetweenTimeLimitChecks = 1024;
+
+// The deterministic time of an operation on a 64-bit word of a bitset.
+constexpr double kDeterministicTimePerWordOperation = 1e-9;
+
+// Returns the nodes in a degeneracy order: each node has a minimum degree in
+// the subgraph induced by itself and the nodes after it. This is the bucket
+// algorithm of Batagelj and Zaversnik, in O(num_nodes + num_arcs).
+std::vector<int> DegeneracyOrder(
+    absl::Span<const std::vector<int>> adjacency_lists) {
+  const int num_nodes = adjacency_lists.size();
+  std::vector<int> degree(num_nodes);
+  int max_degree = 0;
+  for (int node = 0; node < num_nodes; ++node) {
+    degree[node] = adjacency_lists[node].size();
+    max_degree = std::max(max_degree, degree[node]);
+  }
+  // The nodes of (remaining) degree d are at positions [bucket_starts[d],
+  // bucket_starts[d + 1]) of order, except for the ones already removed.
+  std::vector<int> bucket_starts(max_degree + 2, 0);
+  for (const int d : degree) ++bucket_starts[d + 1];
+  std::partial_sum(bucket_starts.begin(), bucket_starts.end(),
+                   bucket_starts.begin());
+  std::vector<int> order(num_nodes);
+  std::vector<int> position(num_nodes);
+  {
+    std::vector<int> next_positions = bucket_starts;
+    for (int node = 0; node < num_nodes; ++node) {
+      position[node] = next_positions[degree[node]]++;
+      order[position[node]] = node;
+    }
+  }
+  for (int i = 0; i < num_nodes; ++i) {
+    const int node = order[i];
+    for (const int neighbor : adjacency_lists[node]) {
+      const int d = degree[neighbor];
+      if (d <= degree[node]) continue;
+      // Moves neighbor to the start of its bucket, and the start of the bucket
+      // by one, which moves neighbor to the end of the bucket d - 1.
+      const int first = bucket_starts[d];
+      const int first_node = order[first];
+      order[position[neighbor]] = first_node;
+      position[first_node] = position[neighbor];
+      order[first] = neighbor;
+      position[neighbor] = first;
+      ++bucket_starts[d];
+      --degree[neighbor];
+    }
+  }
+  return order;
+}
+
+// The state shared by the threads of FindMaximalCliquesInParallel() and
+// FindLargestClique(). The search enumerates the maximal cliques when callback
+// is set, and looks for a largest clique otherwise.
+struct SharedCliqueSearch {
+  absl::Span<const std::vector<int>> adjacency_lists;
+  std::vector<int> order;
+  // rank[node] is the position of node in order.
+  std::vector<int> rank;
+  std::function<CliqueResponse(const std::vector<int>&)> callback;
+  int max_clique_size = 0;
+  std::unique_ptr<SharedTimeLimit> time_limit;
+
+  // The number of subproblems already taken by a thread.
+  std::atomic<int> num_started_subproblems = 0;
+  std::atomic<bool> stop = false;
+  // The size of best_clique, readable without locking the mutex.
+  std::atomic<int> best_clique_size = 0;
+
+  absl::Mutex mutex;
+  std::vector<int> best_clique ABSL_GUARDED_BY(mutex);
+};
+
+// Solves the subproblems of a SharedCliqueSearch, one at a time. The
+// subproblem of a node v looks for the cliques made of v and of its neighbors
+// after it in the degeneracy order (the candidates). To only report maximal
+// cliques, it also keeps the neighbors of v before it in the order which are
+// connected to at least one candidate (the excluded nodes): the cliques that
+// they extend are found in their own subproblem.
+//
+// The candidates are indexed from 0 to the number of candidates of v, which is
+// at most the degeneracy of the graph, and the sets of candidates and their
+// neighborhoods are stored as bitsets over these indices, so that most of the
+// work is done on 64 nodes at a time.
+class CliqueSubproblemSolver {
+ public:
+  explicit CliqueSubproblemSolver(SharedCliqueSearch* shared)
+      : shared_(*shared),
+        enumerate_(shared->callback != nullptr),
+        local_index_(shared->adjacency_lists.size(), -1) {}
+
+  // Solves subproblems until there are none left or the search is stopped.
+  // The subproblems are taken in reverse degeneracy order: the last nodes are
+  // in the densest part of the graph, where the largest cliques usually are,
+  // and finding them first prunes more of the other subproblems in
+  // FindLargestClique().
+  void Run() {
+    const int num_nodes = shared_.order.size();
+    while (!shared_.stop.load(std::memory_order_relaxed)) {
+      const int subproblem = shared_.num_started_subproblems.fetch_add(
+          1, std::memory_order_relaxed);
+      if (subproblem >= num_nodes) break;
+      Solve(shared_.order[num_nodes - 1 - subproblem]);
+    }
+    AdvanceDeterministicTime();
+  }
+
+ private:
+  // The sets of one level of the recursion, as bitsets over the candidates of
+  // the subproblem, plus the list of the excluded nodes of the subproblem
+  // which are connected to all the nodes of the current clique.
+  struct Level {
+    std::vector<uint64_t> candidates;
+    std::vector<uint64_t> excluded_candidates;
+    std::vector<int> excluded_nodes;
+    std::vector<int> branches;
+  };
+
+  static bool HasBit(const uint64_t* bitset, int i) {
+    return (bitset[i >> 6] >> (i & 63)) & 1;
+  }
+  static void SetBit(uint64_t* bitset, int i) {
+    bitset[i >> 6] |= uint64_t{1} << (i & 63);
+  }
+  static void ClearBit(uint64_t* bitset, int i) {
+    bitset[i >> 6] &= ~(uint64_t{1} << (i & 63));
+  }
+
+  // Returns the bitset of the candidates connected to the i-th candidate, or to
+  // the i-th excluded node.
+  const uint64_t* CandidateNeighbors(int i) const {
+    return candidate_neighbors_.data() + static_cast<int64_t>(i) * num_words_;
+  }
+  const uint64_t* ExcludedNodeNeighbors(int i) const {
+    return excluded_node_neighbors_.data() +
+           static_cast<int64_t>(i) * num_words_;
+  }
+
+  void AdvanceDeterministicTime() {
+    if (shared_.time_limit == nullptr) return;
+    shared_.time_limit->AdvanceDeterministicTime(
+        num_word_operations_ * kDeterministicTimePerWordOperation);
+    num_word_operations_ = 0;
+  }
+
+  // Returns true if the search for a largest clique can skip the cliques made
+  // of clique_ and some of the given number of candidates.
+  bool CannotImproveBestClique(int num_candidates) const {
+    return !enumerate_ &&
+           static_cast<int>(clique_.size()) + num_candidates <=
+               shared_.best_clique_size.load(std::memory_order_relaxed);
+  }
+
+  // Returns the number of colors of a greedy coloring of the subgraph induced
+  // by the given candidates, which is an upper bound on the size of its
+  // cliques, much tighter than the number of candidates on dense subgraphs.
+  int NumColors(const uint64_t* candidates) {
+    uncolored_.assign(candidates, candidates + num_words_);
+    color_class_.resize(num_words_);
+    int num_colors = 0;
+    for (int first_word = 0; first_word < num_words_;) {
+      if (uncolored_[first_word] == 0) {
+        ++first_word;
+        continue;
+      }
+      // Builds a maximal independent set of the uncolored candidates.
+      ++num_colors;
+      std::copy(uncolored_.begin(), uncolored_.end(), color_class_.begin());
+      for (int w = first_word; w < num_words_; ++w) {
+        while (color_class_[w] != 0) {
+          const int candidate = w * 64 + absl::countr_zero(color_class_[w]);
+          const uint64_t* const neighbors = CandidateNeighbors(candidate);
+          ClearBit(uncolored_.data(), candidate);
+          ClearBit(color_class_.data(), candidate);
+          for (int v = w; v < num_words_; ++v) color_class_[v] &= ~neighbors[v];
+          num_word_operations_ += num_words_ - w;
+        }
+      }
+    }
+    return num_colors;
+  }
+
+  int Count(const uint64_t* bitset) const {
+    int count = 0;
+    for (int w = 0; w < num_words_; ++w) count += absl::popcount(bitset[w]);
+    return count;
+  }
+  int CountIntersection(const uint64_t* a, const uint64_t* b) const {
+    int count = 0;
+    for (int w = 0; w < num_words_; ++w) count += absl::popcount(a[w] & b[w]);
+    return count;
+  }
+
+  void Solve(int node) {
+    const int rank = shared_.rank[node];
+    candidate_nodes_.clear();
+    earlier_neighbors_.clear();
+    for (const int neighbor : shared_.adjacency_lists[node]) {
+      if (shared_.rank[neighbor] > rank) {
+        candidate_nodes_.push_back(neighbor);
+      } else {
+        earlier_neighbors_.push_back(neighbor);
+      }
+    }
+    const int num_candidates = candidate_nodes_.size();
+    clique_.assign(1, node);
+    if (CannotImproveBestClique(num_candidates)) return;
+    if (num_candidates == 0) {
+      if (!enumerate_ || earlier_neighbors_.empty()) ReportClique();
+      return;
+    }
+
+    num_words_ = (num_candidates + 63) / 64;
+    for (int i = 0; i < num_candidates; ++i) {
+      local_index_[candidate_nodes_[i]] = i;
+    }
+    candidate_neighbors_.assign(static_cast<int64_t>(num_candidates) *
+                                    num_words_,
+                                0);
+    for (int i = 0; i < num_candidates; ++i) {
+      uint64_t* const row =
+          candidate_neighbors_.data() + static_cast<int64_t>(i) * num_words_;
+      for (const int neighbor : shared_.adjacency_lists[candidate_nodes_[i]]) {
+        const int j = local_index_[neighbor];
+        if (j >= 0) SetBit(row, j);
+      }
+    }
+    // The excluded nodes only matter for the maximality of the cliques.
+    excluded_node_neighbors_.clear();
+    int num_excluded_nodes = 0;
+    if (enumerate_) {
+      for (const int neighbor : earlier_neighbors_) {
+        const int64_t row_start = excluded_node_neighbors_.size();
+        excluded_node_neighbors_.resize(row_start + num_words_, 0);
+        bool has_candidate_neighbor = false;
+        for (const int n : shared_.adjacency_lists[neighbor]) {
+          const int j = local_index_[n];
+          if (j < 0) continue;
+          SetBit(excluded_node_neighbors_.data() + row_start, j);
+          has_candidate_neighbor = true;
+        }
+        if (has_candidate_neighbor) {
+          ++num_excluded_nodes;
+        } else {
+          excluded_node_neighbors_.resize(row_start);
+        }
+      }
+    }
+    for (const int candidate : candidate_nodes_) local_index_[candidate] = -1;
+
+    // The depth of the recursion is at most the number of candidates.
+    if (static_cast<int>(levels_.size()) <= num_candidates) {
+      levels_.resize(num_candidates + 1);
+    }
+    for (int depth = 0; depth <= num_candidates; ++depth) {
+      levels_[depth].candidates.resize(num_words_);
+      levels_[depth].excluded_candidates.resize(num_words_);
+    }
+    Level& root = levels_[0];
+    std::fill(root.candidates.begin(), root.candidates.end(), ~uint64_t{0});
+    if (num_candidates % 64 != 0) {
+      root.candidates.back() = (uint64_t{1} << (num_candidates % 64)) - 1;
+    }
+    std::fill(root.excluded_candidates.begin(), root.excluded_candidates.end(),
+              0);
+    root.excluded_nodes.resize(num_excluded_nodes);
+    std::iota(root.excluded_nodes.begin(), root.excluded_nodes.end(), 0);
+    Expand(0);
+  }
+
+  // Implements the recursive step of the Bron-Kerbosch algorithm with the
+  // pivot rule of Tomita et al.: the pivot is the node of the candidates or of
+  // the excluded nodes connected to the largest number of candidates, and
+  // only the candidates not connected to it are branched on.
+  void Expand(int depth) {
+    if (shared_.stop.load(std::memory_order_relaxed)) return;
+    if (shared_.time_limit != nullptr &&
+        ++num_expansions_ % kNumExpansionsBetweenTimeLimitChecks == 0) {
+      AdvanceDeterministicTime();
+      if (shared_.time_limit->LimitReached()) {
+        shared_.stop = true;
+        return;
+      }
+    }
+    Level& level = levels_[depth];
+    const int num_candidates = Count(level.candidates.data());
+    if (num_candidates == 0) {
+      if (!enumerate_ ||
+          (level.excluded_nodes.empty() &&
+           Count(level.excluded_candidates.data()) == 0)) {
+        ReportClique();
+      }
+      return;
+    }
+    if (!enumerate_ &&
+        (CannotImproveBestClique(num_candidates) ||
+         CannotImproveBestClique(NumColors(level.candidates.data())))) {
+      return;
+    }
+
+    const uint64_t* pivot_neighbors = nullptr;
+    int max_num_pivot_neighbors = -1;
+    const auto consider_pivot = [&](const uint64_t* neighbors) {
+      num_word_operations_ += num_words_;
+      const int num_neighbors =
+          CountIntersection(level.candidates.data(), neighbors);
+      if (num_neighbors > max_num_pivot_neighbors) {
+        max_num_pivot_neighbors = num_neighbors;
+        pivot_neighbors = neighbors;
+      }
+    };
+    for (int w = 0; w < num_words_; ++w) {
+      uint64_t word = level.candidates[w] | level.excluded_candidates[w];
+      while (word != 0) {
+        consider_pivot(CandidateNeighbors(w * 64 + absl::countr_zero(word)));
+        word &= word - 1;
+      }
+    }
+    for (const int excluded_node : level.excluded_nodes) {
+      consider_pivot(ExcludedNodeNeighbors(excluded_node));
+    }
+
+    level.branches.clear();
+    for (int w = 0; w < num_words_; ++w) {
+      uint64_t word = level.candidates[w] & ~pivot_neighbors[w];
+      while (word != 0) {
+        level.branches.push_back(w * 64 + absl::countr_zero(word));
+        word &= word - 1;
+      }
+    }
+    Level& next = levels_[depth + 1];
+    for (const int branch : level.branches) {
+      if (shared_.stop.load(std::memory_order_relaxed)) return;
+      if (CannotImproveBestClique(Count(level.candidates.data()))) return;
+      const uint64_t* const neighbors = CandidateNeighbors(branch);
+      num_word_operations_ += num_words_;
+      for (int w = 0; w < num_words_; ++w) {
+        next.candidates[w] = level.candidates[w] & neighbors[w];
+        next.excluded_candidates[w] =
+            level.excluded_candidates[w] & neighbors[w];
+      }
+      next.excluded_nodes.clear();
+      for (const int excluded_node : level.excluded_nodes) {
+        if (HasBit(ExcludedNodeNeighbors(excluded_node), branch)) {
+          next.excluded_nodes.push_back(excluded_node);
+        }
+      }
+      clique_.push_back(candidate_nodes_[branch]);
+      Expand(depth + 1);
+      clique_.pop_back();
+      ClearBit(level.candidates.data(), branch);
+      SetBit(level.excluded_candidates.data(), branch);
+    }
+  }
+
+  void ReportClique() {
+    if (enumerate_) {
+      absl::MutexLock lock(&shared_.mutex);
+      if (shared_.stop.load(std::memory_order_relaxed)) return;
+      if (shared_.callback(clique_) == CliqueResponse::STOP) {
+        shared_.stop = true;
+      }
+      return;
+    }
+    const int size = clique_.size();
+    if (size <= shared_.best_clique_size.load(std::memory_order_relaxed)) {
+      return;
+    }
+    absl::MutexLock lock(&shared_.mutex);
+    if (size <= static_cast<int>(shared_.best_clique.size())) return;
+    shared_.best_clique = clique_;
+    shared_.best_clique_size = size;
+    if (size >= shared_.max_clique_size) shared_.stop = true;
+  }
+
+  SharedCliqueSearch& shared_;
+  const bool enumerate_;
+  int64_t num_expansions_ = 0;
+  int64_t num_word_operations_ = 0;
+
+  // The original nodes of the candidates of the current subproblem, and the
+  // index of each candidate in this vector (-1 for the other nodes).
+  std::vector<int> candidate_nodes_;
+  std::vector<int> local_index_;
+  std::vector<int> earlier_neighbors_;
+  // The number of 64-bit words of the bitsets of the current subproblem.
+  int num_words_ = 0;
+  // The neighbors of each candidate and excluded node among the candidates, in
+  // rows of num_words_ words.
+  std::vector<uint64_t> candidate_neighbors_;
+  std::vector<uint64_t> excluded_node_neighbors_;
+  std::vector<Level> levels_;
+  // Scratch bitsets of NumColors().
+  std::vector<uint64_t> uncolored_;
+  std::vector<uint64_t> color_class_;
+  std::vector<int> clique_;
+};
+
+void RunCliqueSearch(absl::Span<const std::vector<int>> adjacency_lists,
+                     int num_threads, TimeLimit* time_limit,
+                     SharedCliqueSearch* shared) {
+  const int num_nodes = adjacency_lists.size();
+  shared->adjacency_lists = adjacency_lists;
+  shared->order = DegeneracyOrder(adjacency_lists);
+  shared->rank.resize(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) shared->rank[shared->order[i]] = i;
+  if (time_limit != nullptr) {
+    shared->time_limit = std::make_unique<SharedTimeLimit>(time_limit);
+  }
+
+  const int num_workers = std::max(1, std::min(num_threads, num_nodes));
+  if (num_workers == 1) {
+    CliqueSubproblemSolver(shared).Run();
+    return;
+  }
+  ThreadPool pool("CliqueSearch", num_workers - 1);
+  pool.StartWorkers();
+  absl::BlockingCounter counter(num_workers - 1);
+  for (int worker = 1; worker < num_workers; ++worker) {
+    pool.Schedule([shared, &counter]() {
+      CliqueSubproblemSolver(shared).Run();
+      counter.DecrementCount();
+    });
+  }
+  CliqueSubproblemSolver(shared).Run();
+  counter.Wait();
+}
+}  // namespace
+
+BronKerboschAlgorithmStatus FindMaximalCliquesInParallel(
+    absl::Span<const std::vector<int>> adjacency_lists, int num_threads,
+    std::function<CliqueResponse(const std::vector<int>&)> callback,
+    TimeLimit* time_limit) {
+  CHECK(callback != nullptr);
+  SharedCliqueSearch shared;
+  shared.callback = std::move(callback);
+  RunCliqueSearch(adjacency_lists, num_threads, time_limit, &shared);
+  return shared.stop ? BronKerboschAlgorithmStatus::INTERRUPTED
+                     : BronKerboschAlgorithmStatus::COMPLETED;
+}
+
+std::vector<int> FindLargestClique(
+    absl::Span<const std::vector<int>> adjacency_lists, int max_clique_size,
+    int num_threads, TimeLimit* time_limit) {
+  CHECK_GE(max_clique_size, 1);
+  SharedCliqueSearch shared;
+  shared.max_clique_size = max_clique_size;
+  RunCliqueSearch(adjacency_lists, num_threads, time_limit, &shared);
+  absl::MutexLock lock(&shared.mutex);
+  return shared.best_clique;
+}
+
 }  // namespace operations_research
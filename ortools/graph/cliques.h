@@ -33,6 +33,7 @@
 #include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "ortools/base/int_type.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
@@ -78,6 +79,39 @@ enum class BronKerboschAlgorithmStatus {
   INTERRUPTED
 };
 
+// Finds all maximal cliques, even of size 1, of the undirected graph given by
+// its adjacency lists, on up to 'num_threads' threads. The adjacency lists
+// must be symmetric, without self-loops or duplicates.
+//
+// Unlike BronKerboschAlgorithm, which queries the graph callback for each pair
+// of nodes, the graph is explored in degeneracy order: the maximal cliques
+// whose first node in that order is v only contain v and its later
+// neighbors, so each node defines an independent subproblem of size at most
+// the degeneracy of the graph plus one. This is much faster on large sparse
+// graphs such as conflict graphs. The subproblems are solved in parallel,
+// each with bitset-based neighborhoods and Tomita pivoting.
+//
+// 'callback' is called once per maximal clique, in no particular order, but
+// never concurrently. The search stops as soon as possible when it returns
+// CliqueResponse::STOP or when 'time_limit' (which can be null) is reached;
+// the function then returns BronKerboschAlgorithmStatus::INTERRUPTED.
+BronKerboschAlgorithmStatus FindMaximalCliquesInParallel(
+    absl::Span<const std::vector<int>> adjacency_lists, int num_threads,
+    std::function<CliqueResponse(const std::vector<int>&)> callback,
+    TimeLimit* time_limit = nullptr);
+
+// Returns a clique of maximum size of the undirected graph given by its
+// adjacency lists (see FindMaximalCliquesInParallel()), or the first clique
+// found with 'max_clique_size' nodes: use std::numeric_limits<int>::max() to
+// find a maximum clique. The search prunes the branches that can't improve on
+// the best clique found so far, using a greedy coloring bound. When
+// 'time_limit' (which can be null) is reached, returns the best clique found so
+// far. With several threads, which clique of the best size is returned is not
+// deterministic.
+std::vector<int> FindLargestClique(
+    absl::Span<const std::vector<int>> adjacency_lists, int max_clique_size,
+    int num_threads, TimeLimit* time_limit = nullptr);
+
 // Implements the Bron-Kerbosch algorithm for finding maximal cliques.
 // The graph is represented as a callback that gets two nodes as its arguments
 // and it returns true if and only if there is an arc between the two nodes. The
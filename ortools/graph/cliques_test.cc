@@ -528,6 +528,133 @@ TEST(BronKerboschAlgorithmTest, DeterministicTimeLimit) {
   EXPECT_TRUE(time_limit->LimitReached());
 }
 
+// Returns the adjacency lists of the graph given by a callback.
+std::vector<std::vector<int>> MakeAdjacencyLists(
+    int num_nodes, const std::function<bool(int, int)>& graph) {
+  std::vector<std::vector<int>> adjacency_lists(num_nodes);
+  for (int node1 = 0; node1 < num_nodes; ++node1) {
+    for (int node2 = node1 + 1; node2 < num_nodes; ++node2) {
+      if (graph(node1, node2)) {
+        adjacency_lists[node1].push_back(node2);
+        adjacency_lists[node2].push_back(node1);
+      }
+    }
+  }
+  return adjacency_lists;
+}
+
+// Returns the maximal cliques of the graph found by BronKerboschAlgorithm, with
+// sorted nodes, in lexicographic order.
+std::vector<std::vector<int>> SortedMaximalCliques(
+    int num_nodes, const std::function<bool(int, int)>& graph) {
+  CliqueReporter<int> reporter;
+  BronKerboschAlgorithm<int> bron_kerbosch(graph, num_nodes,
+                                           reporter.MakeCliqueCallback());
+  bron_kerbosch.Run();
+  std::vector<std::vector<int>> cliques = reporter.all_cliques();
+  for (std::vector<int>& clique : cliques) {
+    std::sort(clique.begin(), clique.end());
+  }
+  std::sort(cliques.begin(), cliques.end());
+  return cliques;
+}
+
+TEST(FindMaximalCliquesInParallelTest, SameAsBronKerboschAlgorithm) {
+  std::mt19937 random(12345);
+  for (int iter = 0; iter < 30; ++iter) {
+    const int num_nodes = absl::Uniform(random, 0, 150);
+    const double arc_probability = absl::Uniform(random, 0.0, 0.5);
+    const int num_threads = 1 + iter % 4;
+    SCOPED_TRACE(absl::StrCat("num_nodes = ", num_nodes,
+                              ", arc_probability = ", arc_probability,
+                              ", num_threads = ", num_threads));
+    const absl::flat_hash_set<std::pair<int, int>> adjacency_matrix =
+        MakeRandomGraphAdjacencyMatrix(num_nodes, arc_probability, iter);
+    const auto graph = [&adjacency_matrix](int index1, int index2) {
+      return BitmapGraph(adjacency_matrix, index1, index2);
+    };
+    const std::vector<std::vector<int>> expected_cliques =
+        SortedMaximalCliques(num_nodes, graph);
+
+    CliqueReporter<int> reporter;
+    EXPECT_EQ(BronKerboschAlgorithmStatus::COMPLETED,
+              FindMaximalCliquesInParallel(MakeAdjacencyLists(num_nodes, graph),
+                                           num_threads,
+                                           reporter.MakeCliqueCallback()));
+    std::vector<std::vector<int>> cliques = reporter.all_cliques();
+    for (std::vector<int>& clique : cliques) {
+      std::sort(clique.begin(), clique.end());
+    }
+    std::sort(cliques.begin(), cliques.end());
+    EXPECT_EQ(cliques, expected_cliques);
+
+    int max_clique_size = 0;
+    for (const std::vector<int>& clique : expected_cliques) {
+      max_clique_size = std::max<int>(max_clique_size, clique.size());
+    }
+    const std::vector<int> largest_clique =
+        FindLargestClique(MakeAdjacencyLists(num_nodes, graph),
+                          std::numeric_limits<int>::max(), num_threads);
+    ASSERT_EQ(largest_clique.size(), max_clique_size);
+    for (int i = 0; i < max_clique_size; ++i) {
+      for (int j = i + 1; j < max_clique_size; ++j) {
+        EXPECT_TRUE(graph(largest_clique[i], largest_clique[j]));
+      }
+    }
+  }
+}
+
+TEST(FindMaximalCliquesInParallelTest, StopAfterFirstClique) {
+  const int kNumNodes = 100;
+  const std::vector<std::vector<int>> adjacency_lists =
+      MakeAdjacencyLists(kNumNodes, MatchingGraph);
+  for (const int num_threads : {1, 4}) {
+    CliqueReporter<int> reporter(1);
+    EXPECT_EQ(BronKerboschAlgorithmStatus::INTERRUPTED,
+              FindMaximalCliquesInParallel(adjacency_lists, num_threads,
+                                           reporter.MakeCliqueCallback()));
+    EXPECT_EQ(1, reporter.all_cliques().size());
+  }
+}
+
+TEST(FindMaximalCliquesInParallelTest, DeterministicTimeLimit) {
+  const int kNumPartitions = 15;
+  const int kNumNodes = kNumPartitions * kNumPartitions;
+  const std::vector<std::vector<int>> adjacency_lists =
+      MakeAdjacencyLists(kNumNodes, [](int index1, int index2) {
+        return FullKPartiteGraph(kNumPartitions, index1, index2);
+      });
+  std::unique_ptr<TimeLimit> time_limit = TimeLimit::FromDeterministicTime(0.1);
+  CliqueSizeVerifier verifier(kNumPartitions, kNumPartitions);
+  EXPECT_EQ(BronKerboschAlgorithmStatus::INTERRUPTED,
+            FindMaximalCliquesInParallel(adjacency_lists, /*num_threads=*/4,
+                                         verifier.MakeCliqueCallback(),
+                                         time_limit.get()));
+  EXPECT_TRUE(time_limit->LimitReached());
+}
+
+TEST(FindLargestCliqueTest, StopsAtMaxCliqueSize) {
+  const int kNumPartitions = 15;
+  const int kNumNodes = kNumPartitions * kNumPartitions;
+  const std::vector<std::vector<int>> adjacency_lists =
+      MakeAdjacencyLists(kNumNodes, [](int index1, int index2) {
+        return FullKPartiteGraph(kNumPartitions, index1, index2);
+      });
+  for (const int num_threads : {1, 4}) {
+    EXPECT_EQ(kNumPartitions,
+              FindLargestClique(adjacency_lists,
+                                std::numeric_limits<int>::max(), num_threads)
+                  .size());
+    EXPECT_EQ(5, FindLargestClique(adjacency_lists, 5, num_threads).size());
+  }
+}
+
+TEST(FindLargestCliqueTest, EmptyGraph) {
+  EXPECT_TRUE(FindLargestClique({}, 10, 4).empty());
+  const std::vector<std::vector<int>> adjacency_lists(3);
+  EXPECT_EQ(1, FindLargestClique(adjacency_lists, 10, 4).size());
+}
+
 // A benchmark that finds all maximal cliques in a modulo graph of the given
 // size.
 void BM_FindCliquesInModuloGraph(benchmark::State& state) {
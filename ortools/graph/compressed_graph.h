@@ -0,0 +1,434 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A read-only graph with compressed adjacency lists, for large graphs with a
+// good locality of the node indices, like road networks or web and social
+// graphs whose nodes were renumbered by a locality-preserving order.
+//
+// The outgoing arcs of each node are sorted by head, and their heads are
+// stored as a sequence of varints: the first one is the zigzag-encoded
+// difference with the tail, and the others are the differences with the
+// previous head. When most neighbors have close indices, this takes one or two
+// bytes per arc instead of the 2 * sizeof(NodeIndexType) bytes per arc of
+// StaticGraph<>, and traversals read less memory.
+//
+// The graph follows the interface of StaticGraph<> described in graph.h, so
+// it can be used with the graph algorithms templated on the graph type, with
+// one difference: Head() and Tail() are not O(1) anymore, since they need to
+// find the tail of the arc with a binary search and then decode the adjacency
+// list of this tail. So the heads should be read while iterating:
+// - operator[](node) yields the heads of the outgoing arcs of node, which is
+//   what bfs.h and connected_components.h use.
+// - OutgoingArcsWithHeads(node) yields the (arc, head) pairs, which is used by
+//   BoundedDijkstraWrapper when available.
+//
+// Example:
+//   CompressedStaticGraph<> graph;
+//   for (...) graph.AddArc(tail, head);
+//   std::vector<int> permutation;
+//   graph.Build(&permutation);  // Build() permutes the arc indices.
+//   Permute(permutation, &arc_lengths);
+//   BoundedDijkstraWrapper<CompressedStaticGraph<>, int64_t> dijkstra(
+//       &graph, &arc_lengths);
+
+#ifndef OR_TOOLS_GRAPH_COMPRESSED_GRAPH_H_
+#define OR_TOOLS_GRAPH_COMPRESSED_GRAPH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "ortools/graph/graph.h"
+#include "ortools/graph/iterators.h"
+
+namespace util {
+
+// The memory used once built is about
+//   (sizeof(ArcIndexType) + 4) * num_nodes() + bytes per arc * num_arcs(),
+// instead of sizeof(ArcIndexType) * num_nodes()
+//   + 2 * sizeof(NodeIndexType) * num_arcs() for StaticGraph<>. Like in
+// StaticGraph<>, the arcs are first added with AddArc(), which stores them
+// uncompressed until Build() is called.
+template <typename NodeIndexType = int32_t, typename ArcIndexType = int32_t>
+class CompressedStaticGraph
+    : public BaseGraph<NodeIndexType, ArcIndexType, false> {
+  typedef BaseGraph<NodeIndexType, ArcIndexType, false> Base;
+  using Base::arc_capacity_;
+  using Base::const_capacities_;
+  using Base::node_capacity_;
+  using Base::num_arcs_;
+  using Base::num_nodes_;
+
+ public:
+  using Base::IsArcValid;
+  CompressedStaticGraph() : is_built_(false) {}
+  CompressedStaticGraph(NodeIndexType num_nodes, ArcIndexType arc_capacity)
+      : is_built_(false) {
+    this->Reserve(num_nodes, arc_capacity);
+    this->FreezeCapacities();
+    this->AddNode(num_nodes - 1);
+  }
+
+  class OutgoingArcWithHeadIterator;
+  class OutgoingHeadIterator;
+
+  // Both work in O(log(num_nodes()) + OutDegree(Tail(arc))).
+  NodeIndexType Head(ArcIndexType arc) const;
+  NodeIndexType Tail(ArcIndexType arc) const;
+
+  ArcIndexType OutDegree(NodeIndexType node) const;  // Work in O(1).
+  IntegerRange<ArcIndexType> OutgoingArcs(NodeIndexType node) const;
+  BeginEndWrapper<OutgoingArcWithHeadIterator> OutgoingArcsWithHeads(
+      NodeIndexType node) const;
+
+  // This loops over the heads of the OutgoingArcs(node), in increasing order.
+  // Unlike the heads of StaticGraph<>, they are decoded on the fly.
+  class HeadRange;
+  HeadRange operator[](NodeIndexType node) const;
+
+  void ReserveNodes(NodeIndexType bound) override;
+  void ReserveArcs(ArcIndexType bound) override;
+  void AddNode(NodeIndexType node);
+  ArcIndexType AddArc(NodeIndexType tail, NodeIndexType head);
+
+  // Sorts the arcs by tail and then by head, and compresses them. As for
+  // StaticGraph<>, permutation[i] is the new index of the i-th added arc.
+  void Build() { Build(nullptr); }
+  void Build(std::vector<ArcIndexType>* permutation);
+
+  // Returns the number of bytes used to store the heads.
+  int64_t num_head_bytes() const { return data_.size(); }
+
+ private:
+  // The per-node byte offsets are relative to the start of their block of
+  // nodes, so that they fit in 32 bits.
+  static constexpr int kLogNodesPerBlock = 6;
+
+  ArcIndexType DirectArcLimit(NodeIndexType node) const {
+    DCHECK(is_built_);
+    DCHECK(Base::IsNodeValid(node));
+    return node + 1 < num_nodes_ ? start_[node + 1] : num_arcs_;
+  }
+  const uint8_t* NodeData(NodeIndexType node) const {
+    return data_.data() + block_data_start_[node >> kLogNodesPerBlock] +
+           node_data_offset_[node];
+  }
+
+  static void AppendVarint(uint64_t value, std::vector<uint8_t>* data) {
+    while (value >= 0x80) {
+      data->push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    data->push_back(static_cast<uint8_t>(value));
+  }
+  static const uint8_t* ReadVarint(const uint8_t* data, uint64_t* value) {
+    uint64_t result = 0;
+    int shift = 0;
+    while (*data & 0x80) {
+      result |= static_cast<uint64_t>(*data & 0x7f) << shift;
+      shift += 7;
+      ++data;
+    }
+    *value = result | (static_cast<uint64_t>(*data) << shift);
+    return data + 1;
+  }
+
+  bool is_built_;
+
+  // Only used before Build().
+  std::vector<NodeIndexType> added_tails_;
+  std::vector<NodeIndexType> added_heads_;
+
+  // start_[node] is the first outgoing arc of node.
+  std::vector<ArcIndexType> start_;
+
+  // The encoded heads. Those of node start at NodeData(node).
+  std::vector<uint8_t> data_;
+  std::vector<int64_t> block_data_start_;
+  std::vector<uint32_t> node_data_offset_;
+};
+
+// Implementation ------------------------------------------------------------
+
+// Decodes the heads of the outgoing arcs of a node.
+template <typename NodeIndexType, typename ArcIndexType>
+class CompressedStaticGraph<NodeIndexType, ArcIndexType>::
+    OutgoingArcWithHeadIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = std::pair<ArcIndexType, NodeIndexType>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type*;
+  using reference = value_type;
+
+  OutgoingArcWithHeadIterator(const CompressedStaticGraph& graph,
+                              NodeIndexType node)
+      : arc_(graph.start_[node]),
+        limit_(graph.DirectArcLimit(node)),
+        data_(graph.NodeData(node)) {
+    if (arc_ < limit_) {
+      uint64_t zigzag_delta;
+      data_ = ReadVarint(data_, &zigzag_delta);
+      head_ = static_cast<NodeIndexType>(
+          static_cast<int64_t>(node) +
+          static_cast<int64_t>((zigzag_delta >> 1) ^ -(zigzag_delta & 1)));
+    }
+  }
+  // End iterator.
+  OutgoingArcWithHeadIterator(const CompressedStaticGraph& graph,
+                              NodeIndexType node, ArcIndexType limit)
+      : arc_(limit), limit_(limit), data_(nullptr) {}
+
+  value_type operator*() const { return {arc_, head_}; }
+  NodeIndexType head() const { return head_; }
+  void operator++() {
+    ++arc_;
+    if (arc_ < limit_) {
+      uint64_t delta;
+      data_ = ReadVarint(data_, &delta);
+      head_ += static_cast<NodeIndexType>(delta);
+    }
+  }
+  bool operator!=(const OutgoingArcWithHeadIterator& other) const {
+    return arc_ != other.arc_;
+  }
+  bool operator==(const OutgoingArcWithHeadIterator& other) const {
+    return arc_ == other.arc_;
+  }
+
+ private:
+  ArcIndexType arc_;
+  ArcIndexType limit_;
+  NodeIndexType head_ = 0;
+  const uint8_t* data_;
+};
+
+template <typename NodeIndexType, typename ArcIndexType>
+class CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutgoingHeadIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = NodeIndexType;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const NodeIndexType*;
+  using reference = NodeIndexType;
+
+  explicit OutgoingHeadIterator(OutgoingArcWithHeadIterator it) : it_(it) {}
+
+  NodeIndexType operator*() const { return it_.head(); }
+  OutgoingHeadIterator& operator++() {
+    ++it_;
+    return *this;
+  }
+  bool operator!=(const OutgoingHeadIterator& other) const {
+    return it_ != other.it_;
+  }
+  bool operator==(const OutgoingHeadIterator& other) const {
+    return it_ == other.it_;
+  }
+
+ private:
+  OutgoingArcWithHeadIterator it_;
+};
+
+// Unlike BeginEndWrapper, its size() does not need random access iterators.
+template <typename NodeIndexType, typename ArcIndexType>
+class CompressedStaticGraph<NodeIndexType, ArcIndexType>::HeadRange {
+ public:
+  using const_iterator = OutgoingHeadIterator;
+  using value_type = NodeIndexType;
+
+  HeadRange(const CompressedStaticGraph& graph, NodeIndexType node)
+      : begin_(OutgoingArcWithHeadIterator(graph, node)),
+        end_(OutgoingArcWithHeadIterator(graph, node,
+                                         graph.DirectArcLimit(node))),
+        size_(graph.OutDegree(node)) {}
+
+  OutgoingHeadIterator begin() const { return begin_; }
+  OutgoingHeadIterator end() const { return end_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  const OutgoingHeadIterator begin_;
+  const OutgoingHeadIterator end_;
+  const size_t size_;
+};
+
+template <typename NodeIndexType, typename ArcIndexType>
+ArcIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutDegree(
+    NodeIndexType node) const {
+  return DirectArcLimit(node) - start_[node];
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+IntegerRange<ArcIndexType>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcs(
+    NodeIndexType node) const {
+  return IntegerRange<ArcIndexType>(start_[node], DirectArcLimit(node));
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+BeginEndWrapper<typename CompressedStaticGraph<
+    NodeIndexType, ArcIndexType>::OutgoingArcWithHeadIterator>
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcsWithHeads(
+    NodeIndexType node) const {
+  return {OutgoingArcWithHeadIterator(*this, node),
+          OutgoingArcWithHeadIterator(*this, node, DirectArcLimit(node))};
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+typename CompressedStaticGraph<NodeIndexType, ArcIndexType>::HeadRange
+CompressedStaticGraph<NodeIndexType, ArcIndexType>::operator[](
+    NodeIndexType node) const {
+  return HeadRange(*this, node);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+NodeIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::Tail(
+    ArcIndexType arc) const {
+  DCHECK(is_built_);
+  DCHECK(IsArcValid(arc));
+  // The tail is the last node whose first arc is not after arc.
+  return static_cast<NodeIndexType>(
+      std::upper_bound(start_.begin(), start_.end(), arc) - start_.begin() -
+      1);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+NodeIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::Head(
+    ArcIndexType arc) const {
+  const NodeIndexType tail = Tail(arc);
+  OutgoingArcWithHeadIterator it(*this, tail);
+  for (ArcIndexType i = start_[tail]; i < arc; ++i) ++it;
+  return it.head();
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::ReserveNodes(
+    NodeIndexType bound) {
+  Base::ReserveNodes(bound);
+  if (bound <= num_nodes_) return;
+  start_.reserve(bound);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::ReserveArcs(
+    ArcIndexType bound) {
+  Base::ReserveArcs(bound);
+  if (bound <= num_arcs_) return;
+  added_tails_.reserve(bound);
+  added_heads_.reserve(bound);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::AddNode(
+    NodeIndexType node) {
+  if (node < num_nodes_) return;
+  DCHECK(!is_built_);
+  DCHECK(!const_capacities_ || node < node_capacity_) << node;
+  num_nodes_ = node + 1;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+ArcIndexType CompressedStaticGraph<NodeIndexType, ArcIndexType>::AddArc(
+    NodeIndexType tail, NodeIndexType head) {
+  DCHECK_GE(tail, 0);
+  DCHECK_GE(head, 0);
+  DCHECK(!is_built_);
+  AddNode(tail > head ? tail : head);
+  added_tails_.push_back(tail);
+  added_heads_.push_back(head);
+  DCHECK(!const_capacities_ || num_arcs_ < arc_capacity_);
+  return num_arcs_++;
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void CompressedStaticGraph<NodeIndexType, ArcIndexType>::Build(
+    std::vector<ArcIndexType>* permutation) {
+  DCHECK(!is_built_);
+  if (is_built_) return;
+  is_built_ = true;
+  node_capacity_ = num_nodes_;
+  arc_capacity_ = num_arcs_;
+  this->FreezeCapacities();
+
+  // Sorts the arcs by tail with a counting sort, and then by head.
+  start_.assign(num_nodes_, 0);
+  for (const NodeIndexType tail : added_tails_) ++start_[tail];
+  ArcIndexType sum = 0;
+  for (ArcIndexType& start : start_) {
+    const ArcIndexType degree = start;
+    start = sum;
+    sum += degree;
+  }
+  std::vector<ArcIndexType> sorted_arcs(num_arcs_);
+  for (ArcIndexType arc = 0; arc < num_arcs_; ++arc) {
+    sorted_arcs[start_[added_tails_[arc]]++] = arc;
+  }
+  for (NodeIndexType node = num_nodes_ - 1; node > 0; --node) {
+    start_[node] = start_[node - 1];
+  }
+  if (num_nodes_ > 0) start_[0] = 0;
+
+  // Encodes the heads of each node.
+  block_data_start_.assign(((num_nodes_ - 1) >> kLogNodesPerBlock) + 1, 0);
+  node_data_offset_.assign(num_nodes_, 0);
+  for (NodeIndexType node = 0; node < num_nodes_; ++node) {
+    const int64_t block = node >> kLogNodesPerBlock;
+    if ((node & ((1 << kLogNodesPerBlock) - 1)) == 0) {
+      block_data_start_[block] = data_.size();
+    }
+    const int64_t offset = data_.size() - block_data_start_[block];
+    CHECK_LE(offset, std::numeric_limits<uint32_t>::max());
+    node_data_offset_[node] = static_cast<uint32_t>(offset);
+
+    const auto first = sorted_arcs.begin() + start_[node];
+    const auto last = sorted_arcs.begin() + DirectArcLimit(node);
+    std::stable_sort(first, last, [this](ArcIndexType a, ArcIndexType b) {
+      return added_heads_[a] < added_heads_[b];
+    });
+    int64_t previous = node;
+    for (auto it = first; it != last; ++it) {
+      const int64_t head = added_heads_[*it];
+      if (it == first) {
+        const int64_t delta = head - previous;
+        AppendVarint((static_cast<uint64_t>(delta) << 1) ^
+                         static_cast<uint64_t>(delta >> 63),
+                     &data_);
+      } else {
+        AppendVarint(head - previous, &data_);
+      }
+      previous = head;
+    }
+  }
+  data_.shrink_to_fit();
+
+  std::vector<NodeIndexType>().swap(added_tails_);
+  std::vector<NodeIndexType>().swap(added_heads_);
+  if (permutation != nullptr) {
+    permutation->resize(num_arcs_);
+    for (ArcIndexType i = 0; i < num_arcs_; ++i) {
+      (*permutation)[sorted_arcs[i]] = i;
+    }
+  }
+}
+
+}  // namespace util
+
+#endif  // OR_TOOLS_GRAPH_COMPRESSED_GRAPH_H_
@@ -0,0 +1,175 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/compressed_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/bfs.h"
+#include "ortools/graph/bounded_dijkstra.h"
+#include "ortools/graph/connected_components.h"
+#include "ortools/graph/graph.h"
+
+namespace util {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+
+TEST(CompressedStaticGraphTest, EmptyGraph) {
+  CompressedStaticGraph<> graph;
+  graph.Build();
+  EXPECT_EQ(graph.num_nodes(), 0);
+  EXPECT_EQ(graph.num_arcs(), 0);
+}
+
+TEST(CompressedStaticGraphTest, SmallGraph) {
+  CompressedStaticGraph<> graph;
+  graph.AddNode(3);
+  graph.AddArc(2, 0);
+  graph.AddArc(0, 3);
+  graph.AddArc(2, 1000);
+  graph.AddArc(2, 1);
+  graph.AddArc(0, 3);
+  std::vector<int> permutation;
+  graph.Build(&permutation);
+
+  EXPECT_EQ(graph.num_nodes(), 1001);
+  EXPECT_EQ(graph.num_arcs(), 5);
+  EXPECT_THAT(permutation, ElementsAre(2, 0, 4, 3, 1));
+  EXPECT_THAT(graph[0], ElementsAre(3, 3));
+  EXPECT_THAT(graph[1], IsEmpty());
+  EXPECT_EQ(graph[2].size(), 3);
+  EXPECT_THAT(graph[2], ElementsAre(0, 1, 1000));
+  EXPECT_THAT(graph.OutgoingArcs(2), ElementsAre(2, 3, 4));
+  EXPECT_THAT(graph.OutgoingArcsWithHeads(2),
+              ElementsAre(Pair(2, 0), Pair(3, 1), Pair(4, 1000)));
+  EXPECT_EQ(graph.OutDegree(1000), 0);
+  EXPECT_EQ(graph.Tail(4), 2);
+  EXPECT_EQ(graph.Head(4), 1000);
+  EXPECT_EQ(graph.Tail(1), 0);
+  EXPECT_EQ(graph.Head(1), 3);
+}
+
+TEST(CompressedStaticGraphTest, SameArcsAsStaticGraph) {
+  std::mt19937 random(12345);
+  for (int iter = 0; iter < 50; ++iter) {
+    const int num_nodes = absl::Uniform(random, 1, 1000);
+    const int num_arcs = absl::Uniform(random, 0, 5 * num_nodes);
+    StaticGraph<> expected;
+    CompressedStaticGraph<> graph;
+    expected.AddNode(num_nodes - 1);
+    graph.AddNode(num_nodes - 1);
+    std::vector<std::pair<int, int>> arcs;
+    for (int i = 0; i < num_arcs; ++i) {
+      const int tail = absl::Uniform(random, 0, num_nodes);
+      // Mostly close heads, as in the graphs this is designed for.
+      const int head =
+          iter % 2 == 0
+              ? absl::Uniform(random, 0, num_nodes)
+              : std::clamp(tail + absl::Uniform(random, -5, 6), 0,
+                           num_nodes - 1);
+      arcs.push_back({tail, head});
+      expected.AddArc(tail, head);
+      graph.AddArc(tail, head);
+    }
+    expected.Build();
+    std::vector<int> permutation;
+    graph.Build(&permutation);
+
+    ASSERT_EQ(graph.num_arcs(), num_arcs);
+    for (int arc = 0; arc < num_arcs; ++arc) {
+      EXPECT_EQ(graph.Tail(permutation[arc]), arcs[arc].first);
+      EXPECT_EQ(graph.Head(permutation[arc]), arcs[arc].second);
+    }
+    for (int node = 0; node < num_nodes; ++node) {
+      std::vector<int> heads(expected[node].begin(), expected[node].end());
+      std::sort(heads.begin(), heads.end());
+      EXPECT_THAT(graph[node], ElementsAreArray(heads));
+      for (const auto [arc, head] : graph.OutgoingArcsWithHeads(node)) {
+        EXPECT_EQ(graph.Tail(arc), node);
+        EXPECT_EQ(graph.Head(arc), head);
+      }
+    }
+  }
+}
+
+TEST(CompressedStaticGraphTest, WorksWithGraphAlgorithms) {
+  std::mt19937 random(12345);
+  const int num_nodes = 500;
+  StaticGraph<> expected;
+  CompressedStaticGraph<> graph;
+  expected.AddNode(num_nodes - 1);
+  graph.AddNode(num_nodes - 1);
+  std::vector<int64_t> lengths;
+  for (int i = 0; i < 800; ++i) {
+    const int tail = absl::Uniform(random, 0, num_nodes);
+    const int head = absl::Uniform(random, 0, num_nodes);
+    // Undirected, for the connected components.
+    for (const auto [from, to] :
+         {std::pair(tail, head), std::pair(head, tail)}) {
+      expected.AddArc(from, to);
+      graph.AddArc(from, to);
+      lengths.push_back(absl::Uniform(random, 0, 100));
+    }
+  }
+  std::vector<int> permutation;
+  expected.Build(&permutation);
+  std::vector<int64_t> expected_lengths = lengths;
+  Permute(permutation, &expected_lengths);
+  graph.Build(&permutation);
+  Permute(permutation, &lengths);
+
+  EXPECT_EQ(GetConnectedComponents(num_nodes, graph),
+            GetConnectedComponents(num_nodes, expected));
+
+  const std::vector<int> bfs_tree =
+      graph::GetBFSRootedTree(graph, num_nodes, 0).value();
+  const std::vector<int> expected_bfs_tree =
+      graph::GetBFSRootedTree(expected, num_nodes, 0).value();
+  EXPECT_EQ(graph::GetBFSDistances(bfs_tree).value(),
+            graph::GetBFSDistances(expected_bfs_tree).value());
+
+  operations_research::BoundedDijkstraWrapper<CompressedStaticGraph<>, int64_t>
+      dijkstra(&graph, &lengths);
+  operations_research::BoundedDijkstraWrapper<StaticGraph<>, int64_t>
+      expected_dijkstra(&expected, &expected_lengths);
+  for (int source = 0; source < num_nodes; source += 50) {
+    dijkstra.RunBoundedDijkstra(source, 1000);
+    expected_dijkstra.RunBoundedDijkstra(source, 1000);
+    for (int node = 0; node < num_nodes; ++node) {
+      ASSERT_EQ(dijkstra.IsReachable(node),
+                expected_dijkstra.IsReachable(node));
+      if (!dijkstra.IsReachable(node)) continue;
+      EXPECT_EQ(dijkstra.distances()[node],
+                expected_dijkstra.distances()[node]);
+      int64_t path_length = 0;
+      for (const int arc : dijkstra.ArcPathTo(node)) {
+        path_length += lengths[arc];
+      }
+      EXPECT_EQ(path_length, dijkstra.distances()[node]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace util
@@ -30,10 +30,14 @@
 #include "ortools/graph/connected_components.h"
 
 #include <algorithm>
+#include <atomic>
 #include <numeric>
+#include <utility>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "ortools/base/stl_util.h"
+#include "ortools/base/threadpool.h"
 
 void DenseConnectedComponentsFinder::SetNumberOfNodes(int num_nodes) {
   const int old_num_nodes = GetNumberOfNodes();
@@ -162,3 +166,92 @@ std::vector<int> DenseConnectedComponentsFinder::GetComponentIds() {
   }
   return component_ids;
 }
+
+ConcurrentDenseConnectedComponentsFinder::
+    ConcurrentDenseConnectedComponentsFinder(int num_nodes)
+    : parent_(num_nodes), num_components_(num_nodes) {
+  for (int node = 0; node < num_nodes; ++node) {
+    parent_[node].store(node, std::memory_order_relaxed);
+  }
+}
+
+int ConcurrentDenseConnectedComponentsFinder::FindRoot(int node) {
+  DCHECK_GE(node, 0);
+  DCHECK_LT(node, GetNumberOfNodes());
+  // Path splitting: each node on the path gets its grandparent as parent. A
+  // failed compare-and-swap means that another thread changed the parent, to
+  // another ancestor, so it can be ignored.
+  while (true) {
+    int parent = parent_[node].load(std::memory_order_relaxed);
+    const int grandparent = parent_[parent].load(std::memory_order_relaxed);
+    if (parent == grandparent) return parent;
+    parent_[node].compare_exchange_weak(parent, grandparent,
+                                        std::memory_order_relaxed);
+    node = parent;
+  }
+}
+
+bool ConcurrentDenseConnectedComponentsFinder::AddEdge(int node1, int node2) {
+  while (true) {
+    int root1 = FindRoot(node1);
+    int root2 = FindRoot(node2);
+    if (root1 == root2) return false;
+    if (Priority(root1) > Priority(root2)) std::swap(root1, root2);
+    // Attach root1 to root2, unless root1 stopped being a root in the meantime.
+    int expected = root1;
+    if (parent_[root1].compare_exchange_strong(expected, root2)) {
+      --num_components_;
+      return true;
+    }
+  }
+}
+
+bool ConcurrentDenseConnectedComponentsFinder::Connected(int node1,
+                                                         int node2) {
+  if (node1 < 0 || node1 >= GetNumberOfNodes() || node2 < 0 ||
+      node2 >= GetNumberOfNodes()) {
+    return false;
+  }
+  while (true) {
+    const int root1 = FindRoot(node1);
+    const int root2 = FindRoot(node2);
+    if (root1 == root2) return true;
+    // If root1 is still a root, the two nodes were in different components
+    // when root2 was found.
+    if (parent_[root1].load() == root1) return false;
+  }
+}
+
+void ConcurrentDenseConnectedComponentsFinder::AddEdges(
+    absl::Span<const std::pair<int, int>> edges, int num_threads) {
+  constexpr int kMinEdgesPerThread = 1 << 16;
+  num_threads = std::max(
+      1, std::min<int>(num_threads, edges.size() / kMinEdgesPerThread));
+  if (num_threads == 1) {
+    for (const auto& [node1, node2] : edges) AddEdge(node1, node2);
+    return;
+  }
+  operations_research::ThreadPool pool("UnionFind", num_threads);
+  pool.StartWorkers();
+  const size_t chunk_size = (edges.size() + num_threads - 1) / num_threads;
+  for (size_t begin = 0; begin < edges.size(); begin += chunk_size) {
+    pool.Schedule([this, chunk = edges.subspan(begin, chunk_size)]() {
+      for (const auto& [node1, node2] : chunk) AddEdge(node1, node2);
+    });
+  }
+}
+
+std::vector<int> ConcurrentDenseConnectedComponentsFinder::GetComponentIds() {
+  std::vector<int> component_ids(GetNumberOfNodes(), -1);
+  int current_component = 0;
+  for (int node = 0; node < GetNumberOfNodes(); ++node) {
+    int& root_component = component_ids[FindRoot(node)];
+    if (root_component < 0) {
+      // This is the first node in a yet unseen component.
+      root_component = current_component;
+      ++current_component;
+    }
+    component_ids[node] = root_component;
+  }
+  return component_ids;
+}
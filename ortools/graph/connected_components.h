@@ -38,17 +38,21 @@
 #ifndef UTIL_GRAPH_CONNECTED_COMPONENTS_H_
 #define UTIL_GRAPH_CONNECTED_COMPONENTS_H_
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash.h"
 #include "absl/meta/type_traits.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/map_util.h"
 
@@ -142,6 +146,55 @@ class DenseConnectedComponentsFinder {
   int num_nodes_at_last_get_roots_call_ = 0;
 };
 
+// A thread-safe version of DenseConnectedComponentsFinder, for a fixed number
+// of nodes: AddEdge(), FindRoot() and Connected() can be called concurrently
+// from several threads. This is a lock-free union-find that links the roots
+// by a fixed pseudo-random priority, with a compare-and-swap, and does path
+// splitting during the root searches. See S. V. Jayanti, R. E. Tarjan,
+// "A Randomized Concurrent Algorithm for Disjoint Set Union", PODC 2016.
+//
+// Since the memory only depends on the number of nodes, this is also suitable
+// for graphs that are too large to be stored: stream the edges by batches to
+// AddEdges(), which ingests each batch on several threads.
+class ConcurrentDenseConnectedComponentsFinder {
+ public:
+  explicit ConcurrentDenseConnectedComponentsFinder(int num_nodes);
+
+  // This type is neither copyable nor movable.
+  ConcurrentDenseConnectedComponentsFinder(
+      const ConcurrentDenseConnectedComponentsFinder&) = delete;
+  ConcurrentDenseConnectedComponentsFinder& operator=(
+      const ConcurrentDenseConnectedComponentsFinder&) = delete;
+
+  // Same as in DenseConnectedComponentsFinder, except that the nodes must be
+  // in [0, GetNumberOfNodes()). All of them are thread-safe.
+  bool AddEdge(int node1, int node2);
+  bool Connected(int node1, int node2);
+  int FindRoot(int node);
+  int GetNumberOfComponents() const { return num_components_; }
+  int GetNumberOfNodes() const { return parent_.size(); }
+
+  // Adds all the given edges, using up to "num_threads" threads.
+  void AddEdges(absl::Span<const std::pair<int, int>> edges, int num_threads);
+
+  // Returns the same as GetConnectedComponents(). This must not be called
+  // concurrently with AddEdge().
+  std::vector<int> GetComponentIds();
+
+ private:
+  // The roots are linked by decreasing priority, which is a bijection of the
+  // node index: this breaks the long chains an adversarial order of edges
+  // could create when linking by index.
+  static uint64_t Priority(int node) {
+    return static_cast<uint64_t>(node) * 0x9E3779B97F4A7C15ULL;
+  }
+
+  // parent_[i] is the id of an ancestor for node i. A node is a root iff
+  // parent_[i] == i.
+  std::vector<std::atomic<int>> parent_;
+  std::atomic<int> num_components_;
+};
+
 namespace internal {
 // A helper to deduce the type of map to use depending on whether CompareOrHashT
 // is a comparator or a hasher (prefer the latter).
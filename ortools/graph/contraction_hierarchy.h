@@ -0,0 +1,635 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Contraction hierarchies, a preprocessing of a fixed graph that makes
+// repeated point-to-point shortest path queries much faster than a Dijkstra
+// search from scratch, typically by several orders of magnitude on road
+// networks.
+//
+// The nodes are "contracted" one by one, in an order given by a heuristic
+// importance measure. Contracting a node removes it from the graph, and adds a
+// "shortcut" arc u -> w for each pair of arcs u -> v -> w whose concatenation
+// is the only shortest path from u to w among the remaining nodes. Each node
+// gets its rank in the contraction order, and a shortest path query only has
+// to run a bidirectional Dijkstra search that goes up in rank from both ends,
+// on the original arcs augmented with the shortcuts.
+//
+// The many-to-many routine computes a full distance matrix with one upward
+// search per source and per destination, using buckets at the nodes reached by
+// the destination searches.
+//
+// Reference: R. Geisberger, P. Sanders, D. Schultes, D. Delling, "Contraction
+// Hierarchies: Faster and Simpler Hierarchical Routing in Road Networks",
+// WEA 2008. S. Knopp, P. Sanders, D. Schultes, F. Schulz, D. Wagner,
+// "Computing Many-to-Many Shortest Paths Using Highway Hierarchies",
+// ALENEX 2007.
+
+#ifndef OR_TOOLS_GRAPH_CONTRACTION_HIERARCHY_H_
+#define OR_TOOLS_GRAPH_CONTRACTION_HIERARCHY_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/types/span.h"
+
+namespace operations_research {
+
+// The arc lengths cannot be negative, and the length of any path must fit in
+// a DistanceType. This works on any graph of graph.h, for instance
+// util::StaticGraph<>; the graph and the arc lengths are only used by the
+// constructor, which does all the preprocessing.
+//
+// The queries are not thread-safe, since they reuse some internal buffers, but
+// the preprocessing result can be copied to run queries in parallel.
+template <typename GraphType, typename DistanceType>
+class ContractionHierarchy {
+ public:
+  typedef typename GraphType::NodeIndex NodeIndex;
+  typedef typename GraphType::ArcIndex ArcIndex;
+
+  // The witness searches, which check whether a shortcut is needed, are
+  // limited to this number of settled nodes. A lower value speeds up the
+  // preprocessing, but may add useless shortcuts.
+  static constexpr int kDefaultWitnessSearchLimit = 500;
+
+  ContractionHierarchy(const GraphType* graph,
+                       const std::vector<DistanceType>* arc_lengths,
+                       int witness_search_limit = kDefaultWitnessSearchLimit);
+
+  // The distance of unreachable nodes.
+  static DistanceType infinity() {
+    return std::numeric_limits<DistanceType>::max();
+  }
+
+  // Returns the length of a shortest path from "from" to "to", or infinity()
+  // if there is none.
+  DistanceType OneToOneDistance(NodeIndex from, NodeIndex to);
+
+  // Returns the nodes of a shortest path from "from" to "to", both included,
+  // or an empty vector if there is none.
+  std::vector<NodeIndex> OneToOneNodePath(NodeIndex from, NodeIndex to);
+
+  // Returns the matrix of the shortest path lengths from each source to each
+  // destination: result[i][j] is the distance from sources[i] to
+  // destinations[j], or infinity() if there is no such path.
+  std::vector<std::vector<DistanceType>> ManyToManyDistances(
+      absl::Span<const NodeIndex> sources,
+      absl::Span<const NodeIndex> destinations);
+
+  NodeIndex num_nodes() const { return num_nodes_; }
+
+  // The number of shortcuts that were added to the original arcs, once the
+  // parallel arcs have been merged.
+  int64_t num_shortcuts() const { return num_shortcuts_; }
+
+  // The position of the node in the contraction order.
+  NodeIndex Rank(NodeIndex node) const { return rank_[node]; }
+
+ private:
+  enum Direction {
+    FORWARD = 0,
+    BACKWARD = 1,
+  };
+
+  // An arc of the graph being contracted. For the arcs leaving a node, "node"
+  // is the head, and for the arcs entering it, "node" is the tail. "middle" is
+  // the contracted node of a shortcut, or -1 for an original arc.
+  struct Arc {
+    NodeIndex node;
+    DistanceType length;
+    NodeIndex middle;
+  };
+
+  struct NodeDistance {
+    NodeIndex node;
+    DistanceType distance;
+    // Inverted so that the closest node comes first in a priority queue.
+    bool operator<(const NodeDistance& other) const {
+      return distance > other.distance;
+    }
+  };
+
+  // Sets the length of the arc tail -> head to "length" if this is shorter
+  // than the existing one, or adds it. Returns true if the arc was added.
+  bool AddOrImproveArc(NodeIndex tail, NodeIndex head, DistanceType length,
+                       NodeIndex middle);
+
+  // Appends to "shortcuts" the arcs (tail, head, length) needed to contract
+  // "node", in the current graph.
+  void ComputeShortcuts(
+      NodeIndex node,
+      std::vector<std::pair<std::pair<NodeIndex, NodeIndex>, DistanceType>>*
+          shortcuts);
+
+  // Runs a Dijkstra search from "source" that ignores "excluded_node", stops
+  // once all the nodes farther than "limit" or witness_search_limit_ nodes
+  // are settled, and leaves the distances in witness_distance_.
+  void WitnessSearch(NodeIndex source, NodeIndex excluded_node,
+                     DistanceType limit);
+
+  // The importance of a node, the nodes with the lowest one are contracted
+  // first: twice the number of shortcuts its contraction would add minus the
+  // number of arcs it would remove, plus the number of its contracted
+  // neighbors to spread the contraction uniformly over the graph.
+  int64_t Priority(NodeIndex node);
+
+  void Contract(NodeIndex node);
+
+  // Converts the arcs recorded during the contraction into the upward graphs
+  // used by the queries.
+  void BuildSearchGraphs();
+
+  // Runs the bidirectional upward query, and returns the node where the two
+  // searches meet, or -1 if "to" is not reachable from "from".
+  NodeIndex RunQuery(NodeIndex from, NodeIndex to);
+
+  // Settles the closest node of the queue of the given direction and returns
+  // it, or returns -1 if this queue entry was outdated or the node is stalled.
+  template <Direction dir>
+  NodeIndex SettleNextNode();
+
+  // Runs a full upward search, and returns the settled nodes.
+  template <Direction dir>
+  const std::vector<NodeIndex>& RunUpwardSearch(NodeIndex source);
+
+  void ResetSearch(Direction dir);
+
+  // Returns the index of the arc to "node" in the upward graph of "from" in
+  // the given direction.
+  template <Direction dir>
+  int64_t FindUpwardArc(NodeIndex from, NodeIndex node) const;
+
+  // Appends to "path" the nodes of the original path of the arc tail -> head,
+  // head included but not tail, whose contracted middle node is "middle".
+  void UnpackArc(NodeIndex tail, NodeIndex head, NodeIndex middle,
+                 std::vector<NodeIndex>* path) const;
+
+  NodeIndex num_nodes_;
+  int witness_search_limit_;
+  int64_t num_shortcuts_ = 0;
+  std::vector<NodeIndex> rank_;
+
+  // The graph being contracted, only used during the preprocessing.
+  std::vector<std::vector<Arc>> outgoing_arcs_;
+  std::vector<std::vector<Arc>> incoming_arcs_;
+  std::vector<int> num_contracted_neighbors_;
+  std::vector<DistanceType> witness_distance_;
+  std::vector<NodeIndex> witness_reached_nodes_;
+
+  // The arcs that go up in rank, in a compact format indexed by direction: for
+  // FORWARD, the arcs leaving each node towards a node of higher rank, and for
+  // BACKWARD, the arcs entering each node from a node of higher rank, stored
+  // as arcs towards their tail. The arcs of node n are in
+  // [upward_start_[dir][n], upward_start_[dir][n + 1]).
+  std::vector<int64_t> upward_start_[2];
+  std::vector<NodeIndex> upward_node_[2];
+  std::vector<DistanceType> upward_length_[2];
+  std::vector<NodeIndex> upward_middle_[2];
+
+  // The state of the searches of each direction. parent_arc_ is the index of
+  // the upward arc used to reach a node, from parent_.
+  std::vector<DistanceType> distance_[2];
+  std::vector<NodeIndex> parent_[2];
+  std::vector<int64_t> parent_arc_[2];
+  std::vector<NodeIndex> reached_nodes_[2];
+  std::vector<NodeIndex> settled_nodes_[2];
+  std::priority_queue<NodeDistance> queue_[2];
+
+  // For ManyToManyDistances(), the (destination index, distance) pairs of the
+  // destination searches that reached each node.
+  std::vector<std::vector<std::pair<int, DistanceType>>> buckets_;
+};
+
+// -----------------------------------------------------------------------------
+// Implementation.
+// -----------------------------------------------------------------------------
+
+template <typename GraphType, typename DistanceType>
+ContractionHierarchy<GraphType, DistanceType>::ContractionHierarchy(
+    const GraphType* graph, const std::vector<DistanceType>* arc_lengths,
+    int witness_search_limit)
+    : num_nodes_(graph->num_nodes()),
+      witness_search_limit_(witness_search_limit) {
+  CHECK_EQ(arc_lengths->size(), graph->num_arcs());
+  for (const DistanceType length : *arc_lengths) {
+    CHECK_GE(length, 0);
+  }
+  CHECK_GT(witness_search_limit, 0);
+  outgoing_arcs_.resize(num_nodes_);
+  incoming_arcs_.resize(num_nodes_);
+  for (ArcIndex arc = 0; arc < graph->num_arcs(); ++arc) {
+    const NodeIndex tail = graph->Tail(arc);
+    const NodeIndex head = graph->Head(arc);
+    if (tail == head) continue;
+    AddOrImproveArc(tail, head, (*arc_lengths)[arc], -1);
+  }
+  num_contracted_neighbors_.assign(num_nodes_, 0);
+  witness_distance_.assign(num_nodes_, infinity());
+
+  // Contract the nodes by increasing priority. The priorities change as the
+  // graph gets contracted, so they are updated lazily: a node is only
+  // contracted if its updated priority is still the smallest.
+  typedef std::pair<int64_t, NodeIndex> PriorityNode;
+  std::priority_queue<PriorityNode, std::vector<PriorityNode>,
+                      std::greater<PriorityNode>>
+      queue;
+  for (NodeIndex node = 0; node < num_nodes_; ++node) {
+    queue.push({Priority(node), node});
+  }
+  rank_.assign(num_nodes_, 0);
+  NodeIndex num_contracted = 0;
+  while (!queue.empty()) {
+    const NodeIndex node = queue.top().second;
+    queue.pop();
+    const int64_t priority = Priority(node);
+    if (!queue.empty() && priority > queue.top().first) {
+      queue.push({priority, node});
+      continue;
+    }
+    rank_[node] = num_contracted++;
+    Contract(node);
+  }
+  BuildSearchGraphs();
+
+  // Release the memory of the preprocessing.
+  outgoing_arcs_ = {};
+  incoming_arcs_ = {};
+  num_contracted_neighbors_ = {};
+  witness_distance_ = {};
+  witness_reached_nodes_ = {};
+}
+
+template <typename GraphType, typename DistanceType>
+bool ContractionHierarchy<GraphType, DistanceType>::AddOrImproveArc(
+    NodeIndex tail, NodeIndex head, DistanceType length, NodeIndex middle) {
+  for (Arc& arc : outgoing_arcs_[tail]) {
+    if (arc.node != head) continue;
+    if (length < arc.length) {
+      arc.length = length;
+      arc.middle = middle;
+      for (Arc& reverse_arc : incoming_arcs_[head]) {
+        if (reverse_arc.node == tail) {
+          reverse_arc.length = length;
+          reverse_arc.middle = middle;
+          break;
+        }
+      }
+    }
+    return false;
+  }
+  outgoing_arcs_[tail].push_back({head, length, middle});
+  incoming_arcs_[head].push_back({tail, length, middle});
+  return true;
+}
+
+template <typename GraphType, typename DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::WitnessSearch(
+    NodeIndex source, NodeIndex excluded_node, DistanceType limit) {
+  for (const NodeIndex node : witness_reached_nodes_) {
+    witness_distance_[node] = infinity();
+  }
+  witness_reached_nodes_.clear();
+  std::priority_queue<NodeDistance> queue;
+  witness_distance_[source] = 0;
+  witness_reached_nodes_.push_back(source);
+  queue.push({source, 0});
+  int num_settled = 0;
+  while (!queue.empty() && num_settled < witness_search_limit_) {
+    const NodeDistance top = queue.top();
+    queue.pop();
+    if (top.distance > witness_distance_[top.node]) continue;
+    if (top.distance > limit) break;
+    ++num_settled;
+    for (const Arc& arc : outgoing_arcs_[top.node]) {
+      if (arc.node == excluded_node) continue;
+      const DistanceType distance = top.distance + arc.length;
+      if (distance >= witness_distance_[arc.node]) continue;
+      if (witness_distance_[arc.node] == infinity()) {
+        witness_reached_nodes_.push_back(arc.node);
+      }
+      witness_distance_[arc.node] = distance;
+      queue.push({arc.node, distance});
+    }
+  }
+}
+
+template <typename GraphType, typename DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::ComputeShortcuts(
+    NodeIndex node,
+    std::vector<std::pair<std::pair<NodeIndex, NodeIndex>, DistanceType>>*
+        shortcuts) {
+  const std::vector<Arc>& outgoing_arcs = outgoing_arcs_[node];
+  if (outgoing_arcs.empty()) return;
+  DistanceType max_outgoing_length = 0;
+  for (const Arc& arc : outgoing_arcs) {
+    max_outgoing_length = std::max(max_outgoing_length, arc.length);
+  }
+  for (const Arc& incoming_arc : incoming_arcs_[node]) {
+    const NodeIndex tail = incoming_arc.node;
+    WitnessSearch(tail, node, incoming_arc.length + max_outgoing_length);
+    for (const Arc& outgoing_arc : outgoing_arcs) {
+      const NodeIndex head = outgoing_arc.node;
+      if (head == tail) continue;
+      const DistanceType length = incoming_arc.length + outgoing_arc.length;
+      if (witness_distance_[head] <= length) continue;
+      shortcuts->push_back({{tail, head}, length});
+    }
+  }
+}
+
+template <typename GraphType, typename DistanceType>
+int64_t ContractionHierarchy<GraphType, DistanceType>::Priority(
+    NodeIndex node) {
+  std::vector<std::pair<std::pair<NodeIndex, NodeIndex>, DistanceType>>
+      shortcuts;
+  ComputeShortcuts(node, &shortcuts);
+  const int64_t num_removed_arcs =
+      outgoing_arcs_[node].size() + incoming_arcs_[node].size();
+  return 2 * static_cast<int64_t>(shortcuts.size()) - num_removed_arcs +
+         num_contracted_neighbors_[node];
+}
+
+template <typename GraphType, typename DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::Contract(NodeIndex node) {
+  std::vector<std::pair<std::pair<NodeIndex, NodeIndex>, DistanceType>>
+      shortcuts;
+  ComputeShortcuts(node, &shortcuts);
+  for (const auto& [tail_head, length] : shortcuts) {
+    if (AddOrImproveArc(tail_head.first, tail_head.second, length, node)) {
+      ++num_shortcuts_;
+    }
+  }
+  // Remove the node from the graph. Its own arcs are kept, they all go to
+  // nodes that will get a higher rank.
+  for (const Arc& arc : outgoing_arcs_[node]) {
+    ++num_contracted_neighbors_[arc.node];
+    std::vector<Arc>& arcs = incoming_arcs_[arc.node];
+    arcs.erase(std::find_if(arcs.begin(), arcs.end(),
+                            [node](const Arc& a) { return a.node == node; }));
+  }
+  for (const Arc& arc : incoming_arcs_[node]) {
+    ++num_contracted_neighbors_[arc.node];
+    std::vector<Arc>& arcs = outgoing_arcs_[arc.node];
+    arcs.erase(std::find_if(arcs.begin(), arcs.end(),
+                            [node](const Arc& a) { return a.node == node; }));
+  }
+}
+
+template <typename GraphType, typename DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::BuildSearchGraphs() {
+  for (const Direction dir : {FORWARD, BACKWARD}) {
+    const std::vector<std::vector<Arc>>& arcs =
+        dir == FORWARD ? outgoing_arcs_ : incoming_arcs_;
+    upward_start_[dir].assign(num_nodes_ + 1, 0);
+    for (NodeIndex node = 0; node < num_nodes_; ++node) {
+      upward_start_[dir][node + 1] = upward_start_[dir][node] + arcs[node].size();
+    }
+    const int64_t num_arcs = upward_start_[dir][num_nodes_];
+    upward_node_[dir].resize(num_arcs);
+    upward_length_[dir].resize(num_arcs);
+    upward_middle_[dir].resize(num_arcs);
+    for (NodeIndex node = 0; node < num_nodes_; ++node) {
+      int64_t index = upward_start_[dir][node];
+      for (const Arc& arc : arcs[node]) {
+        DCHECK_GT(rank_[arc.node], rank_[node]);
+        upward_node_[dir][index] = arc.node;
+        upward_length_[dir][index] = arc.length;
+        upward_middle_[dir][index] = arc.middle;
+        ++index;
+      }
+    }
+    distance_[dir].assign(num_nodes_, infinity());
+    parent_[dir].assign(num_nodes_, -1);
+    parent_arc_[dir].assign(num_nodes_, -1);
+  }
+}
+
+template <typename GraphType, typename DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::ResetSearch(
+    Direction dir) {
+  for (const NodeIndex node : reached_nodes_[dir]) {
+    distance_[dir][node] = infinity();
+  }
+  reached_nodes_[dir].clear();
+  settled_nodes_[dir].clear();
+  queue_[dir] = {};
+}
+
+template <typename GraphType, typename DistanceType>
+template <typename ContractionHierarchy<GraphType, DistanceType>::Direction dir>
+typename GraphType::NodeIndex
+ContractionHierarchy<GraphType, DistanceType>::SettleNextNode() {
+  const NodeDistance top = queue_[dir].top();
+  queue_[dir].pop();
+  if (top.distance > distance_[dir][top.node]) return -1;
+
+  // Stall-on-demand: if a node of higher rank already reached gives a shorter
+  // path to this node, then its shortest path does not go up in rank and it
+  // cannot be on a shortest path found by the query, so it is not expanded.
+  constexpr Direction kOtherDir = dir == FORWARD ? BACKWARD : FORWARD;
+  for (int64_t arc = upward_start_[kOtherDir][top.node];
+       arc < upward_start_[kOtherDir][top.node + 1]; ++arc) {
+    const DistanceType length = upward_length_[kOtherDir][arc];
+    if (length < top.distance &&
+        distance_[dir][upward_node_[kOtherDir][arc]] < top.distance - length) {
+      return -1;
+    }
+  }
+  settled_nodes_[dir].push_back(top.node);
+  for (int64_t arc = upward_start_[dir][top.node];
+       arc < upward_start_[dir][top.node + 1]; ++arc) {
+    const NodeIndex node = upward_node_[dir][arc];
+    const DistanceType distance = top.distance + upward_length_[dir][arc];
+    if (distance >= distance_[dir][node]) continue;
+    if (distance_[dir][node] == infinity()) reached_nodes_[dir].push_back(node);
+    distance_[dir][node] = distance;
+    parent_[dir][node] = top.node;
+    parent_arc_[dir][node] = arc;
+    queue_[dir].push({node, distance});
+  }
+  return top.node;
+}
+
+template <typename GraphType, typename DistanceType>
+typename GraphType::NodeIndex
+ContractionHierarchy<GraphType, DistanceType>::RunQuery(NodeIndex from,
+                                                         NodeIndex to) {
+  DCHECK_GE(from, 0);
+  DCHECK_LT(from, num_nodes_);
+  DCHECK_GE(to, 0);
+  DCHECK_LT(to, num_nodes_);
+  ResetSearch(FORWARD);
+  ResetSearch(BACKWARD);
+  distance_[FORWARD][from] = 0;
+  reached_nodes_[FORWARD].push_back(from);
+  queue_[FORWARD].push({from, 0});
+  distance_[BACKWARD][to] = 0;
+  reached_nodes_[BACKWARD].push_back(to);
+  queue_[BACKWARD].push({to, 0});
+
+  // Alternate between the two searches, each one stops once its closest node
+  // is farther than the best path found so far.
+  DistanceType best_distance = infinity();
+  NodeIndex meeting_point = -1;
+  bool forward_turn = true;
+  while (true) {
+    const bool forward_done = queue_[FORWARD].empty() ||
+                              queue_[FORWARD].top().distance >= best_distance;
+    const bool backward_done = queue_[BACKWARD].empty() ||
+                               queue_[BACKWARD].top().distance >= best_distance;
+    if (forward_done && backward_done) break;
+    const Direction dir =
+        (forward_turn && !forward_done) || backward_done ? FORWARD : BACKWARD;
+    forward_turn = !forward_turn;
+    const NodeIndex node =
+        dir == FORWARD ? SettleNextNode<FORWARD>() : SettleNextNode<BACKWARD>();
+    if (node == -1) continue;
+    const DistanceType other_distance = distance_[1 - dir][node];
+    if (other_distance == infinity()) continue;
+    const DistanceType distance = distance_[dir][node] + other_distance;
+    if (distance < best_distance) {
+      best_distance = distance;
+      meeting_point = node;
+    }
+  }
+  return meeting_point;
+}
+
+template <typename GraphType, typename DistanceType>
+DistanceType ContractionHierarchy<GraphType, DistanceType>::OneToOneDistance(
+    NodeIndex from, NodeIndex to) {
+  const NodeIndex meeting_point = RunQuery(from, to);
+  if (meeting_point == -1) return infinity();
+  return distance_[FORWARD][meeting_point] + distance_[BACKWARD][meeting_point];
+}
+
+template <typename GraphType, typename DistanceType>
+template <typename ContractionHierarchy<GraphType, DistanceType>::Direction dir>
+int64_t ContractionHierarchy<GraphType, DistanceType>::FindUpwardArc(
+    NodeIndex from, NodeIndex node) const {
+  for (int64_t arc = upward_start_[dir][from];
+       arc < upward_start_[dir][from + 1]; ++arc) {
+    if (upward_node_[dir][arc] == node) return arc;
+  }
+  LOG(DFATAL) << "Missing arc between " << from << " and " << node;
+  return -1;
+}
+
+template <typename GraphType, typename DistanceType>
+void ContractionHierarchy<GraphType, DistanceType>::UnpackArc(
+    NodeIndex tail, NodeIndex head, NodeIndex middle,
+    std::vector<NodeIndex>* path) const {
+  // The two halves tail -> middle and middle -> head of a shortcut are arcs of
+  // the upward graphs of "middle", since it was contracted before both tail
+  // and head.
+  struct PackedArc {
+    NodeIndex tail;
+    NodeIndex head;
+    NodeIndex middle;
+  };
+  std::vector<PackedArc> stack = {{tail, head, middle}};
+  while (!stack.empty()) {
+    const PackedArc packed = stack.back();
+    stack.pop_back();
+    if (packed.middle == -1) {
+      path->push_back(packed.head);
+      continue;
+    }
+    const NodeIndex m = packed.middle;
+    const int64_t second_half = FindUpwardArc<FORWARD>(m, packed.head);
+    const int64_t first_half = FindUpwardArc<BACKWARD>(m, packed.tail);
+    stack.push_back({m, packed.head, upward_middle_[FORWARD][second_half]});
+    stack.push_back({packed.tail, m, upward_middle_[BACKWARD][first_half]});
+  }
+}
+
+template <typename GraphType, typename DistanceType>
+std::vector<typename GraphType::NodeIndex>
+ContractionHierarchy<GraphType, DistanceType>::OneToOneNodePath(NodeIndex from,
+                                                                NodeIndex to) {
+  const NodeIndex meeting_point = RunQuery(from, to);
+  if (meeting_point == -1) return {};
+  std::vector<NodeIndex> upward_path = {meeting_point};
+  while (upward_path.back() != from) {
+    upward_path.push_back(parent_[FORWARD][upward_path.back()]);
+  }
+  std::reverse(upward_path.begin(), upward_path.end());
+  std::vector<NodeIndex> path = {from};
+  for (int i = 0; i + 1 < upward_path.size(); ++i) {
+    const NodeIndex head = upward_path[i + 1];
+    UnpackArc(upward_path[i], head,
+              upward_middle_[FORWARD][parent_arc_[FORWARD][head]], &path);
+  }
+  for (NodeIndex node = meeting_point; node != to;) {
+    const NodeIndex next = parent_[BACKWARD][node];
+    UnpackArc(node, next, upward_middle_[BACKWARD][parent_arc_[BACKWARD][node]],
+              &path);
+    node = next;
+  }
+  return path;
+}
+
+template <typename GraphType, typename DistanceType>
+template <typename ContractionHierarchy<GraphType, DistanceType>::Direction dir>
+const std::vector<typename GraphType::NodeIndex>&
+ContractionHierarchy<GraphType, DistanceType>::RunUpwardSearch(
+    NodeIndex source) {
+  DCHECK_GE(source, 0);
+  DCHECK_LT(source, num_nodes_);
+  ResetSearch(dir);
+  distance_[dir][source] = 0;
+  reached_nodes_[dir].push_back(source);
+  queue_[dir].push({source, 0});
+  while (!queue_[dir].empty()) SettleNextNode<dir>();
+  return settled_nodes_[dir];
+}
+
+template <typename GraphType, typename DistanceType>
+std::vector<std::vector<DistanceType>>
+ContractionHierarchy<GraphType, DistanceType>::ManyToManyDistances(
+    absl::Span<const NodeIndex> sources,
+    absl::Span<const NodeIndex> destinations) {
+  std::vector<std::vector<DistanceType>> distances(
+      sources.size(), std::vector<DistanceType>(destinations.size(), infinity()));
+  if (sources.empty() || destinations.empty()) return distances;
+  buckets_.resize(num_nodes_);
+  std::vector<NodeIndex> bucket_nodes;
+  for (int i = 0; i < destinations.size(); ++i) {
+    for (const NodeIndex node : RunUpwardSearch<BACKWARD>(destinations[i])) {
+      if (buckets_[node].empty()) bucket_nodes.push_back(node);
+      buckets_[node].push_back({i, distance_[BACKWARD][node]});
+    }
+  }
+  for (int i = 0; i < sources.size(); ++i) {
+    std::vector<DistanceType>& row = distances[i];
+    for (const NodeIndex node : RunUpwardSearch<FORWARD>(sources[i])) {
+      const DistanceType distance = distance_[FORWARD][node];
+      for (const auto& [j, bucket_distance] : buckets_[node]) {
+        row[j] = std::min(row[j], distance + bucket_distance);
+      }
+    }
+  }
+  for (const NodeIndex node : bucket_nodes) buckets_[node].clear();
+  return distances;
+}
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GRAPH_CONTRACTION_HIERARCHY_H_
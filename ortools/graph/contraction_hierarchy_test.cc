@@ -0,0 +1,149 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/contraction_hierarchy.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "gtest/gtest.h"
+#include "ortools/base/gmock.h"
+#include "ortools/graph/bounded_dijkstra.h"
+#include "ortools/graph/graph.h"
+
+namespace operations_research {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::util::StaticGraph;
+
+TEST(ContractionHierarchyTest, EmptyGraph) {
+  StaticGraph<> graph;
+  graph.Build();
+  std::vector<int64_t> lengths;
+  ContractionHierarchy<StaticGraph<>, int64_t> hierarchy(&graph, &lengths);
+  EXPECT_EQ(hierarchy.num_nodes(), 0);
+  EXPECT_THAT(hierarchy.ManyToManyDistances({}, {}), IsEmpty());
+}
+
+TEST(ContractionHierarchyTest, SmallTest) {
+  // 0 --(2)--> 1 --(2)--> 2 --(2)--> 3, with a longer direct arc 0 --(7)--> 3
+  // and an unreachable node 4.
+  StaticGraph<> graph;
+  graph.AddNode(4);
+  graph.AddArc(0, 1);
+  graph.AddArc(0, 3);
+  graph.AddArc(1, 2);
+  graph.AddArc(2, 3);
+  graph.Build();
+  std::vector<int64_t> lengths = {2, 7, 2, 2};
+  ContractionHierarchy<StaticGraph<>, int64_t> hierarchy(&graph, &lengths);
+
+  EXPECT_EQ(hierarchy.OneToOneDistance(0, 3), 6);
+  EXPECT_THAT(hierarchy.OneToOneNodePath(0, 3), ElementsAre(0, 1, 2, 3));
+  EXPECT_EQ(hierarchy.OneToOneDistance(2, 2), 0);
+  EXPECT_THAT(hierarchy.OneToOneNodePath(2, 2), ElementsAre(2));
+  EXPECT_EQ(hierarchy.OneToOneDistance(3, 0), hierarchy.infinity());
+  EXPECT_THAT(hierarchy.OneToOneNodePath(3, 0), IsEmpty());
+  EXPECT_EQ(hierarchy.OneToOneDistance(0, 4), hierarchy.infinity());
+
+  const int64_t kInf = hierarchy.infinity();
+  EXPECT_THAT(hierarchy.ManyToManyDistances({0, 1, 4}, {2, 3}),
+              ElementsAre(ElementsAre(4, 6), ElementsAre(2, 4),
+                          ElementsAre(kInf, kInf)));
+}
+
+TEST(ContractionHierarchyTest, RandomizedCorrectnessTest) {
+  std::mt19937 random(12345);
+  const int kNumGraphs = DEBUG_MODE ? 50 : 200;
+  const int kNumQueriesPerGraph = 20;
+  for (int graph_iter = 0; graph_iter < kNumGraphs; ++graph_iter) {
+    const int num_nodes = absl::Uniform(random, 1, 200);
+    const int num_arcs = absl::Uniform(random, 0, 4 * num_nodes);
+    // Small lengths create many ties between paths.
+    const int64_t max_length = graph_iter % 2 == 0 ? 3 : 100;
+    StaticGraph<> graph;
+    graph.AddNode(num_nodes - 1);
+    std::vector<int64_t> lengths;
+    for (int i = 0; i < num_arcs; ++i) {
+      graph.AddArc(absl::Uniform(random, 0, num_nodes),
+                   absl::Uniform(random, 0, num_nodes));
+      lengths.push_back(absl::Uniform<int64_t>(random, 0, max_length));
+    }
+    std::vector<int> permutation;
+    graph.Build(&permutation);
+    util::Permute(permutation, &lengths);
+    std::vector<int> tails;
+    std::vector<int> heads;
+    for (int arc = 0; arc < graph.num_arcs(); ++arc) {
+      tails.push_back(graph.Tail(arc));
+      heads.push_back(graph.Head(arc));
+    }
+
+    // A tiny witness search limit adds useless shortcuts, which must not
+    // change the results.
+    const int witness_search_limit = graph_iter % 3 == 0 ? 2 : 500;
+    ContractionHierarchy<StaticGraph<>, int64_t> hierarchy(
+        &graph, &lengths, witness_search_limit);
+
+    std::vector<int> sources;
+    std::vector<int> destinations;
+    for (int q = 0; q < kNumQueriesPerGraph; ++q) {
+      const int from = absl::Uniform(random, 0, num_nodes);
+      const int to = absl::Uniform(random, 0, num_nodes);
+      sources.push_back(from);
+      destinations.push_back(to);
+      const auto [expected_distance, expected_path] =
+          SimpleOneToOneShortestPath<int64_t>(from, to, tails, heads, lengths);
+      ASSERT_EQ(hierarchy.OneToOneDistance(from, to), expected_distance)
+          << from << " -> " << to;
+
+      // The path may differ from the reference one, check its length.
+      const std::vector<int> path = hierarchy.OneToOneNodePath(from, to);
+      ASSERT_EQ(path.empty(), expected_path.empty());
+      if (path.empty()) continue;
+      EXPECT_EQ(path.front(), from);
+      EXPECT_EQ(path.back(), to);
+      int64_t path_length = 0;
+      for (int i = 0; i + 1 < path.size(); ++i) {
+        int64_t arc_length = -1;
+        for (const int arc : graph.OutgoingArcs(path[i])) {
+          if (graph.Head(arc) != path[i + 1]) continue;
+          if (arc_length == -1 || lengths[arc] < arc_length) {
+            arc_length = lengths[arc];
+          }
+        }
+        ASSERT_NE(arc_length, -1) << path[i] << " -> " << path[i + 1];
+        path_length += arc_length;
+      }
+      EXPECT_EQ(path_length, expected_distance);
+    }
+
+    const std::vector<std::vector<int64_t>> distances =
+        hierarchy.ManyToManyDistances(sources, destinations);
+    for (int i = 0; i < sources.size(); ++i) {
+      for (int j = 0; j < destinations.size(); ++j) {
+        EXPECT_EQ(distances[i][j],
+                  SimpleOneToOneShortestPath<int64_t>(
+                      sources[i], destinations[j], tails, heads, lengths)
+                      .first);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
@@ -14,6 +14,7 @@
 #ifndef OR_TOOLS_GRAPH_DAG_CONSTRAINED_SHORTEST_PATH_H_
 #define OR_TOOLS_GRAPH_DAG_CONSTRAINED_SHORTEST_PATH_H_
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <vector>
@@ -130,11 +131,20 @@ class ConstrainedShortestPathsOnDagWrapper {
   // `destinations`.
   PathWithLength RunConstrainedShortestPathOnDag();
 
+  // Returns the result of `RunConstrainedShortestPathOnDag()` for each vector
+  // of `arc_lengths`, which must be of size `graph.num_arcs()` and indexed the
+  // same way as in `graph`. This is typically used to price many sets of dual
+  // values in a column generation. The runs are independent and are split
+  // between `num_threads` threads, each with its own labels, so the results do
+  // not depend on `num_threads`. `label_count()` is not updated.
+  std::vector<PathWithLength> RunConstrainedShortestPathsOnDag(
+      absl::Span<const std::vector<double>> arc_lengths, int num_threads);
+
   // For benchmarking and informational purposes, returns the number of labels
   // generated in the call of `RunConstrainedShortestPathOnDag()`.
   int label_count() const {
-    return lengths_from_sources_[FORWARD].size() +
-           lengths_from_sources_[BACKWARD].size();
+    return labels_.lengths_from_sources[FORWARD].size() +
+           labels_.lengths_from_sources[BACKWARD].size();
   }
 
  private:
@@ -155,6 +165,32 @@ class ConstrainedShortestPathsOnDagWrapper {
     int label_index[2];
   };
 
+  // The labels of one run. A path is only added to the following vectors if
+  // and only if it is feasible with respect to all resources.
+  // A Label includes the cumulative length, resources and the previous arc used
+  // in the path to get to this node.
+  // Instead of having a single vector of `Label` objects (cl/590819865), we
+  // split them into 3 vectors of more fundamental types as this improves
+  // push_back operations and memory release.
+  struct Labels {
+    std::vector<double> lengths_from_sources[2];
+    std::vector<std::vector<double>> resources_from_sources[2];
+    std::vector<ArcIndex> incoming_arc_indices_from_sources[2];
+    std::vector<int> incoming_label_indices_from_sources[2];
+    std::vector<int> node_first_label[2];
+    std::vector<int> node_num_labels[2];
+  };
+
+  // Allocates the memory of `labels` for the sub-graphs.
+  void InitializeLabels(Labels& labels) const;
+
+  // Runs the bidirectional search with the given arc lengths, indexed as in
+  // `graph_`, and `labels` which are cleared before returning. The two half
+  // runs are done on two threads if `run_halves_in_parallel` is true.
+  PathWithLength RunWithLabels(absl::Span<const double> arc_lengths,
+                               bool run_halves_in_parallel,
+                               Labels& labels) const;
+
   void RunHalfConstrainedShortestPathOnDag(
       const GraphType& reverse_graph, absl::Span<const double> arc_lengths,
       absl::Span<const std::vector<double>> arc_resources,
@@ -164,7 +200,7 @@ class ConstrainedShortestPathsOnDagWrapper {
       std::vector<std::vector<double>>& resources_from_sources,
       std::vector<ArcIndex>& incoming_arc_indices_from_sources,
       std::vector<int>& incoming_label_indices_from_sources,
-      std::vector<int>& first_label, std::vector<int>& num_labels);
+      std::vector<int>& first_label, std::vector<int>& num_labels) const;
 
   // Returns the arc index linking two nodes from each pass forming the best
   // path. Returns -1 if no better path than the one found from
@@ -177,7 +213,8 @@ class ConstrainedShortestPathsOnDagWrapper {
       const std::vector<double> lengths_from_sources[2],
       const std::vector<std::vector<double>> resources_from_sources[2],
       const std::vector<int> first_label[2],
-      const std::vector<int> num_labels[2], LabelPair& best_label_pair);
+      const std::vector<int> num_labels[2],
+      LabelPair& best_label_pair) const;
 
   // Returns the path as list of arc indices that starts from a node in
   // `sources` (if `direction` iS FORWARD) or `destinations` (if `direction` is
@@ -242,20 +279,9 @@ class ConstrainedShortestPathsOnDagWrapper {
   // Maximum number of labels created for each sub-graph.
   int max_num_created_labels_[2];
 
-  // Data about the last call of the RunConstrainedShortestPathOnDag()
-  // function. A path is only added to the following vectors if and only if
-  // it is feasible with respect to all resources.
-  // A Label includes the cumulative length, resources and the previous arc used
-  // in the path to get to this node.
-  // Instead of having a single vector of `Label` objects (cl/590819865), we
-  // split them into 3 vectors of more fundamental types as this improves
-  // push_back operations and memory release.
-  std::vector<double> lengths_from_sources_[2];
-  std::vector<std::vector<double>> resources_from_sources_[2];
-  std::vector<ArcIndex> incoming_arc_indices_from_sources_[2];
-  std::vector<int> incoming_label_indices_from_sources_[2];
-  std::vector<int> node_first_label_[2];
-  std::vector<int> node_num_labels_[2];
+  // Labels of the last call of the RunConstrainedShortestPathOnDag()
+  // function.
+  Labels labels_;
 };
 
 std::vector<int> GetInversePermutation(absl::Span<const int> permutation);
@@ -513,10 +539,19 @@ ConstrainedShortestPathsOnDagWrapper<GraphType>::
   // Memory allocation is done here and only once in order to avoid
   // reallocation at each call of `RunConstrainedShortestPathOnDag()` for
   // better performance.
+  InitializeLabels(labels_);
+}
+
+template <class GraphType>
+#if __cplusplus >= 202002L
+  requires DagGraphType<GraphType>
+#endif
+void ConstrainedShortestPathsOnDagWrapper<GraphType>::InitializeLabels(
+    Labels& labels) const {
   for (const Direction dir : {FORWARD, BACKWARD}) {
-    resources_from_sources_[dir].resize(num_resources_);
-    node_first_label_[dir].resize(sub_reverse_graph_[dir].size());
-    node_num_labels_[dir].resize(sub_reverse_graph_[dir].size());
+    labels.resources_from_sources[dir].resize(num_resources_);
+    labels.node_first_label[dir].resize(sub_reverse_graph_[dir].size());
+    labels.node_num_labels[dir].resize(sub_reverse_graph_[dir].size());
   }
 }
 
@@ -526,6 +561,57 @@ template <class GraphType>
 #endif
 PathWithLength ConstrainedShortestPathsOnDagWrapper<
     GraphType>::RunConstrainedShortestPathOnDag() {
+  return RunWithLabels(*arc_lengths_, /*run_halves_in_parallel=*/true,
+                       labels_);
+}
+
+template <class GraphType>
+#if __cplusplus >= 202002L
+  requires DagGraphType<GraphType>
+#endif
+std::vector<PathWithLength> ConstrainedShortestPathsOnDagWrapper<GraphType>::
+    RunConstrainedShortestPathsOnDag(
+        absl::Span<const std::vector<double>> arc_lengths,
+        const int num_threads) {
+  const int num_runs = arc_lengths.size();
+  for (const std::vector<double>& run_arc_lengths : arc_lengths) {
+    CHECK_EQ(run_arc_lengths.size(), graph_->num_arcs());
+  }
+  std::vector<PathWithLength> paths(num_runs);
+  const int num_workers = std::min(num_threads, num_runs);
+  if (num_workers <= 1) {
+    for (int run = 0; run < num_runs; ++run) {
+      paths[run] = RunWithLabels(arc_lengths[run],
+                                 /*run_halves_in_parallel=*/true, labels_);
+    }
+    return paths;
+  }
+
+  // Each worker runs its half runs sequentially since all the threads are
+  // already busy with other runs.
+  ThreadPool workers(num_workers);
+  workers.StartWorkers();
+  for (int worker = 0; worker < num_workers; ++worker) {
+    workers.Schedule([this, worker, num_workers, num_runs, arc_lengths,
+                      &paths]() {
+      Labels labels;
+      InitializeLabels(labels);
+      for (int run = worker; run < num_runs; run += num_workers) {
+        paths[run] = RunWithLabels(arc_lengths[run],
+                                   /*run_halves_in_parallel=*/false, labels);
+      }
+    });
+  }
+  return paths;
+}
+
+template <class GraphType>
+#if __cplusplus >= 202002L
+  requires DagGraphType<GraphType>
+#endif
+PathWithLength ConstrainedShortestPathsOnDagWrapper<GraphType>::RunWithLabels(
+    absl::Span<const double> arc_lengths, const bool run_halves_in_parallel,
+    Labels& labels) const {
   // Assign lengths on sub-relevant graphs.
   std::vector<double> sub_arc_lengths[2];
   for (const Direction dir : {FORWARD, BACKWARD}) {
@@ -537,31 +623,36 @@ PathWithLength ConstrainedShortestPathsOnDagWrapper<
         sub_arc_lengths[dir].push_back(0.0);
         continue;
       }
-      sub_arc_lengths[dir].push_back((*arc_lengths_)[arc_index]);
+      sub_arc_lengths[dir].push_back(arc_lengths[arc_index]);
     }
   }
 
-  {
+  const auto run_half = [this, &sub_arc_lengths, &labels](Direction dir) {
+    RunHalfConstrainedShortestPathOnDag(
+        /*reverse_graph=*/sub_reverse_graph_[dir],
+        /*arc_lengths=*/sub_arc_lengths[dir],
+        /*arc_resources=*/sub_arc_resources_[dir],
+        /*min_arc_resources=*/sub_min_arc_resources_[dir],
+        /*max_resources=*/*max_resources_,
+        /*max_num_created_labels=*/max_num_created_labels_[dir],
+        /*lengths_from_sources=*/labels.lengths_from_sources[dir],
+        /*resources_from_sources=*/labels.resources_from_sources[dir],
+        /*incoming_arc_indices_from_sources=*/
+        labels.incoming_arc_indices_from_sources[dir],
+        /*incoming_label_indices_from_sources=*/
+        labels.incoming_label_indices_from_sources[dir],
+        /*first_label=*/labels.node_first_label[dir],
+        /*num_labels=*/labels.node_num_labels[dir]);
+  };
+  if (run_halves_in_parallel) {
     ThreadPool search_threads(2);
     search_threads.StartWorkers();
     for (const Direction dir : {FORWARD, BACKWARD}) {
-      search_threads.Schedule([this, dir, &sub_arc_lengths]() {
-        RunHalfConstrainedShortestPathOnDag(
-            /*reverse_graph=*/sub_reverse_graph_[dir],
-            /*arc_lengths=*/sub_arc_lengths[dir],
-            /*arc_resources=*/sub_arc_resources_[dir],
-            /*min_arc_resources=*/sub_min_arc_resources_[dir],
-            /*max_resources=*/*max_resources_,
-            /*max_num_created_labels=*/max_num_created_labels_[dir],
-            /*lengths_from_sources=*/lengths_from_sources_[dir],
-            /*resources_from_sources=*/resources_from_sources_[dir],
-            /*incoming_arc_indices_from_sources=*/
-            incoming_arc_indices_from_sources_[dir],
-            /*incoming_label_indices_from_sources=*/
-            incoming_label_indices_from_sources_[dir],
-            /*first_label=*/node_first_label_[dir],
-            /*num_labels=*/node_num_labels_[dir]);
-      });
+      search_threads.Schedule([&run_half, dir]() { run_half(dir); });
+    }
+  } else {
+    for (const Direction dir : {FORWARD, BACKWARD}) {
+      run_half(dir);
     }
   }
 
@@ -577,14 +668,15 @@ PathWithLength ConstrainedShortestPathsOnDagWrapper<
       if (sub_dst == -1) {
         continue;
       }
-      const int num_labels_dst = node_num_labels_[dir][sub_dst];
+      const int num_labels_dst = labels.node_num_labels[dir][sub_dst];
       if (num_labels_dst == 0) {
         continue;
       }
-      const int first_label_dst = node_first_label_[dir][sub_dst];
+      const int first_label_dst = labels.node_first_label[dir][sub_dst];
       for (int label_index = first_label_dst;
            label_index < first_label_dst + num_labels_dst; ++label_index) {
-        const double length_dst = lengths_from_sources_[dir][label_index];
+        const double length_dst =
+            labels.lengths_from_sources[dir][label_index];
         if (length_dst < best_label_pair.length) {
           best_label_pair.length = length_dst;
           best_label_pair.label_index[dir] = label_index;
@@ -594,23 +686,24 @@ PathWithLength ConstrainedShortestPathsOnDagWrapper<
   }
 
   const ArcIndex merging_arc_index = MergeHalfRuns(
-      /*graph=*/*graph_, /*arc_lengths=*/*arc_lengths_,
+      /*graph=*/*graph_, /*arc_lengths=*/arc_lengths,
       /*arc_resources=*/*arc_resources_,
       /*max_resources=*/*max_resources_,
       /*sub_node_indices=*/sub_node_indices_,
-      /*lengths_from_sources=*/lengths_from_sources_,
-      /*resources_from_sources=*/resources_from_sources_,
-      /*first_label=*/node_first_label_,
-      /*num_labels=*/node_num_labels_, /*best_label_pair=*/best_label_pair);
+      /*lengths_from_sources=*/labels.lengths_from_sources,
+      /*resources_from_sources=*/labels.resources_from_sources,
+      /*first_label=*/labels.node_first_label,
+      /*num_labels=*/labels.node_num_labels,
+      /*best_label_pair=*/best_label_pair);
 
   std::vector<ArcIndex> arc_path;
   for (const Direction dir : {FORWARD, BACKWARD}) {
     for (const ArcIndex sub_arc_index : ArcPathTo(
              /*best_label_index=*/best_label_pair.label_index[dir],
              /*incoming_arc_indices_from_sources=*/
-             incoming_arc_indices_from_sources_[dir],
+             labels.incoming_arc_indices_from_sources[dir],
              /*incoming_label_indices_from_sources=*/
-             incoming_label_indices_from_sources_[dir])) {
+             labels.incoming_label_indices_from_sources[dir])) {
       const ArcIndex arc_index = sub_full_arc_indices_[dir][sub_arc_index];
       if (arc_index == -1) {
         break;
@@ -625,12 +718,12 @@ PathWithLength ConstrainedShortestPathsOnDagWrapper<
 
   // Clear all labels from the next run.
   for (const Direction dir : {FORWARD, BACKWARD}) {
-    lengths_from_sources_[dir].clear();
+    labels.lengths_from_sources[dir].clear();
     for (int r = 0; r < num_resources_; ++r) {
-      resources_from_sources_[dir][r].clear();
+      labels.resources_from_sources[dir][r].clear();
     }
-    incoming_arc_indices_from_sources_[dir].clear();
-    incoming_label_indices_from_sources_[dir].clear();
+    labels.incoming_arc_indices_from_sources[dir].clear();
+    labels.incoming_label_indices_from_sources[dir].clear();
   }
   return {.length = best_label_pair.length,
           .arc_path = arc_path,
@@ -652,7 +745,7 @@ void ConstrainedShortestPathsOnDagWrapper<GraphType>::
         std::vector<std::vector<double>>& resources_from_sources,
         std::vector<ArcIndex>& incoming_arc_indices_from_sources,
         std::vector<int>& incoming_label_indices_from_sources,
-        std::vector<int>& first_label, std::vector<int>& num_labels) {
+        std::vector<int>& first_label, std::vector<int>& num_labels) const {
   // Initialize source node.
   const NodeIndex source_node = reverse_graph.num_nodes() - 1;
   first_label[source_node] = 0;
@@ -778,7 +871,7 @@ ConstrainedShortestPathsOnDagWrapper<GraphType>::MergeHalfRuns(
     const std::vector<double> lengths_from_sources[2],
     const std::vector<std::vector<double>> resources_from_sources[2],
     const std::vector<int> first_label[2], const std::vector<int> num_labels[2],
-    LabelPair& best_label_pair) {
+    LabelPair& best_label_pair) const {
   const std::vector<NodeIndex>& forward_sub_node_indices =
       sub_node_indices[FORWARD];
   absl::Span<const double> forward_lengths = lengths_from_sources[FORWARD];
@@ -400,6 +400,55 @@ TEST(ConstrainedShortestPathsOnDagWrapperTest, UpdateArcsLength) {
                 /*node_path=*/ElementsAre(source, b, destination)));
 }
 
+TEST(ConstrainedShortestPathsOnDagWrapperTest, RunManyArcLengths) {
+  const int source = 0;
+  const int destination = 1;
+  const int a = 2;
+  const int b = 3;
+  const int num_nodes = 4;
+  util::ListGraph<> graph(num_nodes, /*arc_capacity=*/4);
+  std::vector<std::vector<double>> arc_resources(2);
+  graph.AddArc(source, a);
+  arc_resources[0].push_back(1.0);
+  arc_resources[1].push_back(3.0);
+  graph.AddArc(source, b);
+  arc_resources[0].push_back(4.0);
+  arc_resources[1].push_back(10.0);
+  graph.AddArc(a, destination);
+  arc_resources[0].push_back(5.0);
+  arc_resources[1].push_back(9.0);
+  graph.AddArc(b, destination);
+  arc_resources[0].push_back(2.0);
+  arc_resources[1].push_back(2.0);
+  std::vector<double> arc_lengths = {5.0, 2.0, 3.0, 20.0};
+  const std::vector<int> topological_order = {source, a, b, destination};
+  const std::vector<int> sources = {source};
+  const std::vector<int> destinations = {destination};
+  const std::vector<double> max_resources = {6.0, 12.0};
+  ConstrainedShortestPathsOnDagWrapper<util::ListGraph<>>
+      constrained_shortest_path_on_dag(&graph, &arc_lengths, &arc_resources,
+                                       topological_order, sources, destinations,
+                                       &max_resources);
+  const std::vector<std::vector<double>> all_arc_lengths = {
+      {5.0, 2.0, 3.0, 20.0},
+      {5.0, 2.0, 3.0, -1.0},
+      {5.0, 2.0, kInf, 20.0}};
+
+  for (const int num_threads : {1, 2, 4}) {
+    EXPECT_THAT(
+        constrained_shortest_path_on_dag.RunConstrainedShortestPathsOnDag(
+            all_arc_lengths, num_threads),
+        ElementsAre(
+            FieldsAre(/*length=*/8.0, /*arc_path=*/ElementsAre(0, 2),
+                      /*node_path=*/ElementsAre(source, a, destination)),
+            FieldsAre(/*length=*/1.0, /*arc_path=*/ElementsAre(1, 3),
+                      /*node_path=*/ElementsAre(source, b, destination)),
+            FieldsAre(/*length=*/22.0, /*arc_path=*/ElementsAre(1, 3),
+                      /*node_path=*/ElementsAre(source, b, destination))))
+        << "num_threads: " << num_threads;
+  }
+}
+
 TEST(ConstrainedShortestPathsOnDagWrapperTest, LimitMaximumNumberOfLabels) {
   const int source = 0;
   const int destination = 1;
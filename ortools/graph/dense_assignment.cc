@@ -0,0 +1,298 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/dense_assignment.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
+
+namespace operations_research {
+
+namespace {
+// The factor by which epsilon is divided at each scaling phase.
+constexpr DenseLinearSumAssignment::CostValue kEpsilonDivisor = 5;
+
+// The number of bids computed by each thread between two price updates. More
+// bids per block means less synchronization but more bids on the same right
+// node, only one of which can win.
+constexpr int kBidsPerThread = 4;
+
+// Above this number of changed rows and columns, a Solve() starts from
+// scratch.
+constexpr int kMaxChangedFractionForWarmStart = 4;
+}  // namespace
+
+DenseLinearSumAssignment::DenseLinearSumAssignment(int num_nodes)
+    : num_nodes_(num_nodes),
+      cost_scaling_factor_(num_nodes + 1),
+      costs_(static_cast<int64_t>(num_nodes) * num_nodes, 0),
+      right_mate_(num_nodes, -1),
+      left_mate_(num_nodes, -1),
+      prices_(num_nodes, 0),
+      row_changed_(num_nodes, false),
+      column_changed_(num_nodes, false) {
+  CHECK_GE(num_nodes, 0);
+}
+
+void DenseLinearSumAssignment::MarkRowChanged(int left_node) {
+  if (row_changed_[left_node]) return;
+  row_changed_[left_node] = true;
+  changed_rows_.push_back(left_node);
+}
+
+void DenseLinearSumAssignment::SetCost(int left_node, int right_node,
+                                       CostValue cost) {
+  DCHECK_GE(left_node, 0);
+  DCHECK_LT(left_node, num_nodes_);
+  DCHECK_GE(right_node, 0);
+  DCHECK_LT(right_node, num_nodes_);
+  costs_[static_cast<int64_t>(left_node) * num_nodes_ + right_node] = cost;
+  max_abs_cost_ = std::max(max_abs_cost_, std::abs(cost));
+  MarkRowChanged(left_node);
+}
+
+void DenseLinearSumAssignment::SetRowCosts(int left_node,
+                                           absl::Span<const CostValue> costs) {
+  CHECK_EQ(costs.size(), num_nodes_);
+  for (int right_node = 0; right_node < num_nodes_; ++right_node) {
+    costs_[static_cast<int64_t>(left_node) * num_nodes_ + right_node] =
+        costs[right_node];
+    max_abs_cost_ = std::max(max_abs_cost_, std::abs(costs[right_node]));
+  }
+  MarkRowChanged(left_node);
+}
+
+void DenseLinearSumAssignment::SetColumnCosts(
+    int right_node, absl::Span<const CostValue> costs) {
+  CHECK_EQ(costs.size(), num_nodes_);
+  for (int left_node = 0; left_node < num_nodes_; ++left_node) {
+    costs_[static_cast<int64_t>(left_node) * num_nodes_ + right_node] =
+        costs[left_node];
+    max_abs_cost_ = std::max(max_abs_cost_, std::abs(costs[left_node]));
+  }
+  if (column_changed_[right_node]) return;
+  column_changed_[right_node] = true;
+  changed_columns_.push_back(right_node);
+}
+
+void DenseLinearSumAssignment::Unassign(int left_node) {
+  const int right_node = right_mate_[left_node];
+  if (right_node < 0) return;
+  left_mate_[right_node] = -1;
+  right_mate_[left_node] = -1;
+  unassigned_.push_back(left_node);
+}
+
+void DenseLinearSumAssignment::RepriceColumn(int right_node,
+                                             CostValue epsilon) {
+  const int left_mate = left_mate_[right_node];
+  if (left_mate >= 0) Unassign(left_mate);
+  // Epsilon-complementary slackness for an assigned left node is
+  //   Value(left, mate) - prices_[mate]
+  //       >= Value(left, right_node) - prices_[right_node] - epsilon.
+  CostValue price = prices_[right_node];
+  for (int left_node = 0; left_node < num_nodes_; ++left_node) {
+    const int mate = right_mate_[left_node];
+    if (mate < 0) continue;
+    const CostValue mate_profit = Value(left_node, mate) - prices_[mate];
+    price =
+        std::max(price, Value(left_node, right_node) - mate_profit - epsilon);
+  }
+  prices_[right_node] = price;
+}
+
+template <typename F>
+void DenseLinearSumAssignment::ParallelFor(int size, ThreadPool* pool,
+                                           const F& f) const {
+  const int num_chunks = pool == nullptr ? 1 : std::min(num_threads_, size);
+  if (num_chunks <= 1) {
+    f(0, size);
+    return;
+  }
+  absl::BlockingCounter counter(num_chunks - 1);
+  for (int chunk = 1; chunk < num_chunks; ++chunk) {
+    pool->Schedule([&, chunk]() {
+      f(size * chunk / num_chunks, size * (chunk + 1) / num_chunks);
+      counter.DecrementCount();
+    });
+  }
+  f(0, size / num_chunks);
+  counter.Wait();
+}
+
+void DenseLinearSumAssignment::UnassignViolatingLeftNodes(CostValue epsilon,
+                                                          ThreadPool* pool) {
+  std::vector<char> violates(num_nodes_, false);
+  ParallelFor(num_nodes_, pool, [&](int begin, int end) {
+    for (int left_node = begin; left_node < end; ++left_node) {
+      const int mate = right_mate_[left_node];
+      if (mate < 0) continue;
+      int best_right_node;
+      CostValue unused_price;
+      ComputeBid(left_node, epsilon, &best_right_node, &unused_price);
+      const CostValue best_profit =
+          Value(left_node, best_right_node) - prices_[best_right_node];
+      if (Value(left_node, mate) - prices_[mate] < best_profit - epsilon) {
+        violates[left_node] = true;
+      }
+    }
+  });
+  for (int left_node = 0; left_node < num_nodes_; ++left_node) {
+    if (violates[left_node]) Unassign(left_node);
+  }
+}
+
+void DenseLinearSumAssignment::ComputeBid(int left_node, CostValue epsilon,
+                                          int* right_node,
+                                          CostValue* price) const {
+  const CostValue* const row =
+      costs_.data() + static_cast<int64_t>(left_node) * num_nodes_;
+  CostValue best_profit = std::numeric_limits<CostValue>::min();
+  CostValue second_best_profit = std::numeric_limits<CostValue>::min();
+  int best_right_node = 0;
+  for (int right = 0; right < num_nodes_; ++right) {
+    const CostValue profit = -row[right] * cost_scaling_factor_ - prices_[right];
+    if (profit > best_profit) {
+      second_best_profit = best_profit;
+      best_profit = profit;
+      best_right_node = right;
+    } else if (profit > second_best_profit) {
+      second_best_profit = profit;
+    }
+  }
+  // With a single right node, any price increase is fine.
+  if (num_nodes_ == 1) second_best_profit = best_profit;
+  *right_node = best_right_node;
+  *price = prices_[best_right_node] + (best_profit - second_best_profit) +
+           epsilon;
+}
+
+void DenseLinearSumAssignment::RunAuction(CostValue epsilon,
+                                          ThreadPool* pool) {
+  const int max_block_size =
+      pool == nullptr ? 1 : kBidsPerThread * num_threads_;
+  std::vector<int> bidders;
+  std::vector<int> bid_right_node(max_block_size);
+  std::vector<CostValue> bid_price(max_block_size);
+  while (!unassigned_.empty()) {
+    const int block_size =
+        std::min<int>(max_block_size, unassigned_.size());
+    bidders.assign(unassigned_.end() - block_size, unassigned_.end());
+    unassigned_.resize(unassigned_.size() - block_size);
+    num_bids_ += block_size;
+
+    // The bids only read the prices, so they can be computed in parallel.
+    ParallelFor(block_size, pool, [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        ComputeBid(bidders[i], epsilon, &bid_right_node[i], &bid_price[i]);
+      }
+    });
+
+    // A bid loses if an earlier bid of the same block raised the price of its
+    // right node above it. Otherwise it is still at least epsilon above the
+    // profit of the second best right node, since prices only increase.
+    for (int i = 0; i < block_size; ++i) {
+      const int left_node = bidders[i];
+      const int right_node = bid_right_node[i];
+      if (bid_price[i] <= prices_[right_node]) {
+        unassigned_.push_back(left_node);
+        continue;
+      }
+      prices_[right_node] = bid_price[i];
+      const int previous_mate = left_mate_[right_node];
+      if (previous_mate >= 0) {
+        right_mate_[previous_mate] = -1;
+        unassigned_.push_back(previous_mate);
+      }
+      left_mate_[right_node] = left_node;
+      right_mate_[left_node] = right_node;
+    }
+  }
+}
+
+void DenseLinearSumAssignment::RunScalingPhases(CostValue epsilon,
+                                                ThreadPool* pool) {
+  while (true) {
+    UnassignViolatingLeftNodes(epsilon, pool);
+    RunAuction(epsilon, pool);
+    if (epsilon == 1) break;
+    epsilon = std::max<CostValue>(1, epsilon / kEpsilonDivisor);
+  }
+}
+
+DenseLinearSumAssignment::Status DenseLinearSumAssignment::Solve() {
+  optimal_cost_ = 0;
+  num_bids_ = 0;
+  // The prices stay within a few times num_nodes_ times the range of the
+  // scaled costs.
+  if (max_abs_cost_ > std::numeric_limits<CostValue>::max() / 4 /
+                          cost_scaling_factor_ / cost_scaling_factor_) {
+    has_solution_ = false;
+    return POSSIBLE_OVERFLOW;
+  }
+
+  std::unique_ptr<ThreadPool> pool;
+  if (num_threads_ > 1) {
+    pool = std::make_unique<ThreadPool>("DenseAssignment", num_threads_ - 1);
+    pool->StartWorkers();
+  }
+
+  const int64_t num_changes = changed_rows_.size() + changed_columns_.size();
+  if (has_solution_ &&
+      num_changes * kMaxChangedFractionForWarmStart <= num_nodes_) {
+    // The previous solution satisfies epsilon-complementary slackness for
+    // epsilon = 1, except for the changed rows and columns. Restarting the
+    // scaling from an epsilon of one unit of the original costs avoids long
+    // price wars between the re-assigned left nodes.
+    unassigned_.clear();
+    for (const int left_node : changed_rows_) Unassign(left_node);
+    for (const int right_node : changed_columns_) {
+      RepriceColumn(right_node, /*epsilon=*/1);
+    }
+    RunScalingPhases(/*epsilon=*/cost_scaling_factor_, pool.get());
+  } else {
+    prices_.assign(num_nodes_, 0);
+    right_mate_.assign(num_nodes_, -1);
+    left_mate_.assign(num_nodes_, -1);
+    unassigned_.resize(num_nodes_);
+    std::iota(unassigned_.rbegin(), unassigned_.rend(), 0);
+    RunScalingPhases(std::max<CostValue>(1, 2 * max_abs_cost_ *
+                                                cost_scaling_factor_ /
+                                                kEpsilonDivisor),
+                     pool.get());
+  }
+
+  for (const int left_node : changed_rows_) row_changed_[left_node] = false;
+  for (const int right_node : changed_columns_) {
+    column_changed_[right_node] = false;
+  }
+  changed_rows_.clear();
+  changed_columns_.clear();
+  has_solution_ = true;
+  for (int left_node = 0; left_node < num_nodes_; ++left_node) {
+    optimal_cost_ += AssignmentCost(left_node);
+  }
+  return OPTIMAL;
+}
+
+}  // namespace operations_research
@@ -0,0 +1,182 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Solves the linear sum assignment problem (see assignment.h) when every left
+// node can be assigned to every right node, with the costs given as a dense
+// n x n matrix. Unlike SimpleLinearSumAssignment, no graph is built, which
+// halves the memory for large dense problems and avoids the construction
+// time of a graph with n^2 arcs.
+//
+// This uses the auction algorithm with epsilon scaling: the unassigned left
+// nodes bid for their best right node, raising its price by the difference
+// between their best and second best values plus epsilon. The bids of a block
+// of left nodes are computed in parallel with the same prices (Jacobi), and
+// the blocks are processed one after the other (Gauss-Seidel); with one thread
+// each block has a single bid.
+//
+// After a Solve(), changing a few rows or columns of the cost matrix and
+// calling Solve() again only re-assigns the affected left nodes, starting from
+// the previous prices.
+//
+// Example usage:
+//
+// #include "ortools/graph/dense_assignment.h"
+//
+// DenseLinearSumAssignment assignment(num_nodes);
+// for (int left = 0; left < num_nodes; ++left) {
+//   for (int right = 0; right < num_nodes; ++right) {
+//     assignment.SetCost(left, right, cost[left][right]);
+//   }
+// }
+// assignment.SetNumThreads(8);
+// if (assignment.Solve() == DenseLinearSumAssignment::OPTIMAL) {
+//   ... use assignment.RightMate(left) ...
+// }
+//
+// Reference:
+// D. P. Bertsekas, "The auction algorithm: A distributed relaxation method for
+// the assignment problem," Annals of Operations Research 14 (1988) 105-123.
+
+#ifndef OR_TOOLS_GRAPH_DENSE_ASSIGNMENT_H_
+#define OR_TOOLS_GRAPH_DENSE_ASSIGNMENT_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
+
+namespace operations_research {
+
+class DenseLinearSumAssignment {
+ public:
+  typedef int64_t CostValue;
+
+  // All the costs are initially zero.
+  explicit DenseLinearSumAssignment(int num_nodes);
+
+#ifndef SWIG
+  // This type is neither copyable nor movable.
+  DenseLinearSumAssignment(const DenseLinearSumAssignment&) = delete;
+  DenseLinearSumAssignment& operator=(const DenseLinearSumAssignment&) =
+      delete;
+#endif
+
+  int NumNodes() const { return num_nodes_; }
+
+  // Sets the cost of assigning left_node to right_node. To change many costs
+  // of the same right node after a Solve(), SetColumnCosts() makes the next
+  // Solve() faster.
+  void SetCost(int left_node, int right_node, CostValue cost);
+  CostValue Cost(int left_node, int right_node) const {
+    return costs_[static_cast<int64_t>(left_node) * num_nodes_ + right_node];
+  }
+
+  // Sets the costs of a left node, indexed by right node, or of a right node,
+  // indexed by left node.
+  void SetRowCosts(int left_node, absl::Span<const CostValue> costs);
+  void SetColumnCosts(int right_node, absl::Span<const CostValue> costs);
+
+  // Sets the number of threads used to compute the bids. The default is 1.
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  enum Status {
+    OPTIMAL,            // The algorithm found a minimum-cost perfect matching.
+    POSSIBLE_OVERFLOW,  // Some cost magnitude is too large.
+  };
+  // Finds a perfect matching of minimum cost. If some costs changed since the
+  // last successful Solve(), this starts from its solution when few rows and
+  // columns changed.
+  Status Solve();
+
+  // Returns the cost of an assignment with minimal cost.
+  // This is 0 if the last Solve() didn't return OPTIMAL.
+  CostValue OptimalCost() const { return optimal_cost_; }
+
+  // Returns the right node assigned to the given left node, and the reverse.
+  // This works only if Solve() returned OPTIMAL.
+  int RightMate(int left_node) const { return right_mate_[left_node]; }
+  int LeftMate(int right_node) const { return left_mate_[right_node]; }
+
+  // Returns the cost of the arc used for "left_node"'s assignment.
+  // This works only if Solve() returned OPTIMAL.
+  CostValue AssignmentCost(int left_node) const {
+    return Cost(left_node, right_mate_[left_node]);
+  }
+
+  // Returns the number of bids of the last Solve().
+  int64_t num_bids() const { return num_bids_; }
+
+ private:
+  // The auction maximizes the sum of the values -cost * (num_nodes_ + 1): with
+  // this scaling, an assignment satisfying epsilon-complementary slackness
+  // for epsilon = 1 is optimal.
+  CostValue Value(int left_node, int right_node) const {
+    return -Cost(left_node, right_node) * cost_scaling_factor_;
+  }
+
+  void MarkRowChanged(int left_node);
+  void Unassign(int left_node);
+
+  // Raises the price of right_node so that epsilon-complementary slackness
+  // holds again for all the assigned left nodes after its column changed, and
+  // unassigns its left node.
+  void RepriceColumn(int right_node, CostValue epsilon);
+
+  // Unassigns the left nodes for which epsilon-complementary slackness does
+  // not hold.
+  void UnassignViolatingLeftNodes(CostValue epsilon, ThreadPool* pool);
+
+  // Assigns all the unassigned left nodes, keeping epsilon-complementary
+  // slackness.
+  void RunAuction(CostValue epsilon, ThreadPool* pool);
+
+  // Runs the scaling phases from the given epsilon down to 1. Each phase only
+  // unassigns the left nodes that violate its epsilon-complementary slackness.
+  void RunScalingPhases(CostValue epsilon, ThreadPool* pool);
+
+  // Calls f(begin, end) on num_threads_ ranges splitting [0, size).
+  template <typename F>
+  void ParallelFor(int size, ThreadPool* pool, const F& f) const;
+
+  // Computes the bid of left_node for the current prices.
+  void ComputeBid(int left_node, CostValue epsilon, int* right_node,
+                  CostValue* price) const;
+
+  const int num_nodes_;
+  const CostValue cost_scaling_factor_;
+  std::vector<CostValue> costs_;
+  CostValue max_abs_cost_ = 0;
+  int num_threads_ = 1;
+
+  // The current solution and the prices of the right nodes, -1 means
+  // unassigned.
+  std::vector<int> right_mate_;
+  std::vector<int> left_mate_;
+  std::vector<CostValue> prices_;
+  std::vector<int> unassigned_;
+  bool has_solution_ = false;
+
+  // The rows and columns changed since the last Solve().
+  std::vector<bool> row_changed_;
+  std::vector<bool> column_changed_;
+  std::vector<int> changed_rows_;
+  std::vector<int> changed_columns_;
+
+  CostValue optimal_cost_ = 0;
+  int64_t num_bids_ = 0;
+};
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GRAPH_DENSE_ASSIGNMENT_H_
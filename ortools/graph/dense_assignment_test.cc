@@ -0,0 +1,140 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/dense_assignment.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/random/distributions.h"
+#include "gtest/gtest.h"
+#include "ortools/graph/assignment.h"
+
+namespace operations_research {
+namespace {
+
+using CostValue = DenseLinearSumAssignment::CostValue;
+
+// Returns the optimal cost found by SimpleLinearSumAssignment.
+CostValue ReferenceOptimalCost(const DenseLinearSumAssignment& assignment) {
+  SimpleLinearSumAssignment reference;
+  for (int left = 0; left < assignment.NumNodes(); ++left) {
+    for (int right = 0; right < assignment.NumNodes(); ++right) {
+      reference.AddArcWithCost(left, right, assignment.Cost(left, right));
+    }
+  }
+  CHECK_EQ(reference.Solve(), SimpleLinearSumAssignment::OPTIMAL);
+  return reference.OptimalCost();
+}
+
+// Checks that the solution is a perfect matching of the given cost.
+void CheckSolution(const DenseLinearSumAssignment& assignment) {
+  std::vector<bool> is_assigned(assignment.NumNodes(), false);
+  CostValue cost = 0;
+  for (int left = 0; left < assignment.NumNodes(); ++left) {
+    const int right = assignment.RightMate(left);
+    ASSERT_GE(right, 0);
+    ASSERT_FALSE(is_assigned[right]);
+    is_assigned[right] = true;
+    EXPECT_EQ(assignment.LeftMate(right), left);
+    cost += assignment.AssignmentCost(left);
+  }
+  EXPECT_EQ(cost, assignment.OptimalCost());
+}
+
+TEST(DenseLinearSumAssignmentTest, Empty) {
+  DenseLinearSumAssignment assignment(0);
+  EXPECT_EQ(DenseLinearSumAssignment::OPTIMAL, assignment.Solve());
+  EXPECT_EQ(0, assignment.OptimalCost());
+}
+
+TEST(DenseLinearSumAssignmentTest, OptimumMatchingWithNegativeCost) {
+  DenseLinearSumAssignment assignment(2);
+  assignment.SetCost(0, 0, 2);
+  assignment.SetCost(0, 1, -10);
+  assignment.SetCost(1, 0, 3);
+  assignment.SetCost(1, 1, -20);
+  EXPECT_EQ(DenseLinearSumAssignment::OPTIMAL, assignment.Solve());
+  EXPECT_EQ(-18, assignment.OptimalCost());
+  EXPECT_EQ(0, assignment.RightMate(0));
+  EXPECT_EQ(2, assignment.AssignmentCost(0));
+  EXPECT_EQ(1, assignment.RightMate(1));
+  EXPECT_EQ(-20, assignment.AssignmentCost(1));
+}
+
+TEST(DenseLinearSumAssignmentTest, Overflow) {
+  DenseLinearSumAssignment assignment(2);
+  assignment.SetCost(0, 0, std::numeric_limits<CostValue>::max());
+  EXPECT_EQ(DenseLinearSumAssignment::POSSIBLE_OVERFLOW, assignment.Solve());
+  EXPECT_EQ(0, assignment.OptimalCost());
+}
+
+TEST(DenseLinearSumAssignmentTest, RandomProblems) {
+  std::mt19937 random(12345);
+  for (int iter = 0; iter < 40; ++iter) {
+    const int num_nodes = absl::Uniform(random, 1, 60);
+    // Small costs create many ties.
+    const CostValue max_cost = iter % 2 == 0 ? 3 : 1000000;
+    DenseLinearSumAssignment assignment(num_nodes);
+    assignment.SetNumThreads(1 + iter % 3);
+    for (int left = 0; left < num_nodes; ++left) {
+      for (int right = 0; right < num_nodes; ++right) {
+        assignment.SetCost(left, right,
+                           absl::Uniform<CostValue>(random, -max_cost, max_cost));
+      }
+    }
+    ASSERT_EQ(DenseLinearSumAssignment::OPTIMAL, assignment.Solve());
+    CheckSolution(assignment);
+    EXPECT_EQ(assignment.OptimalCost(), ReferenceOptimalCost(assignment));
+  }
+}
+
+TEST(DenseLinearSumAssignmentTest, IncrementalChanges) {
+  std::mt19937 random(12345);
+  const int num_nodes = 100;
+  DenseLinearSumAssignment assignment(num_nodes);
+  for (int left = 0; left < num_nodes; ++left) {
+    for (int right = 0; right < num_nodes; ++right) {
+      assignment.SetCost(left, right, absl::Uniform(random, 0, 1000));
+    }
+  }
+  ASSERT_EQ(DenseLinearSumAssignment::OPTIMAL, assignment.Solve());
+  const int64_t num_bids_from_scratch = assignment.num_bids();
+
+  for (int iter = 0; iter < 20; ++iter) {
+    std::vector<CostValue> costs(num_nodes);
+    for (CostValue& cost : costs) cost = absl::Uniform(random, 0, 1000);
+    switch (iter % 3) {
+      case 0:
+        assignment.SetRowCosts(absl::Uniform(random, 0, num_nodes), costs);
+        break;
+      case 1:
+        assignment.SetColumnCosts(absl::Uniform(random, 0, num_nodes), costs);
+        break;
+      default:
+        assignment.SetCost(absl::Uniform(random, 0, num_nodes),
+                           absl::Uniform(random, 0, num_nodes), 0);
+        break;
+    }
+    ASSERT_EQ(DenseLinearSumAssignment::OPTIMAL, assignment.Solve());
+    CheckSolution(assignment);
+    EXPECT_EQ(assignment.OptimalCost(), ReferenceOptimalCost(assignment));
+    EXPECT_LT(assignment.num_bids(), num_bids_from_scratch);
+  }
+}
+
+}  // namespace
+}  // namespace operations_research
@@ -162,6 +162,8 @@
 #include <iterator>
 #include <limits>
 #include <new>
+#include <numeric>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -283,6 +285,10 @@ class BaseGraph {
   void BuildStartAndForwardHead(SVector<NodeIndexType>* head,
                                 std::vector<ArcIndexType>* start,
                                 std::vector<ArcIndexType>* permutation);
+  void BuildStartAndForwardHead(SVector<NodeIndexType>* head,
+                                std::vector<ArcIndexType>* start,
+                                std::vector<ArcIndexType>* permutation,
+                                int num_threads);
 
   NodeIndexType num_nodes_;
   NodeIndexType node_capacity_;
@@ -428,6 +434,16 @@ class StaticGraph : public BaseGraph<NodeIndexType, ArcIndexType, false> {
   static StaticGraph FromArcs(NodeIndexType num_nodes,
                               const ArcContainer& arcs);
 
+  // Creates a finalized graph directly from the tails and heads of its arcs,
+  // for instance memory-mapped from files: unlike with AddArc() and Build(),
+  // the arcs are never copied before being sorted by tail, with up to
+  // num_threads threads. If permutation is not null, it is filled like in
+  // Build(), even if it is the identity.
+  static StaticGraph FromTailsAndHeads(
+      NodeIndexType num_nodes, absl::Span<const NodeIndexType> tails,
+      absl::Span<const NodeIndexType> heads, int num_threads = 1,
+      std::vector<ArcIndexType>* permutation = nullptr);
+
   // Do not use directly. See instead the arc iteration functions below.
   class OutgoingArcIterator;
 
@@ -450,6 +466,10 @@ class StaticGraph : public BaseGraph<NodeIndexType, ArcIndexType, false> {
 
   void Build() { Build(nullptr); }
   void Build(std::vector<ArcIndexType>* permutation);
+  // Same as Build(), but uses up to num_threads threads, which is worth it for
+  // graphs with hundreds of millions of arcs. The graph is the same, but the
+  // permutation is filled even if it is the identity.
+  void Build(std::vector<ArcIndexType>* permutation, int num_threads);
 
  private:
   ArcIndexType DirectArcLimit(NodeIndexType node) const {
@@ -458,6 +478,12 @@ class StaticGraph : public BaseGraph<NodeIndexType, ArcIndexType, false> {
     return node + 1 < num_nodes_ ? start_[node + 1] : num_arcs_;
   }
 
+  // Fills start_, head_ and tail_ by sorting the given arcs by tail, with a
+  // parallel counting sort.
+  void SortArcsByTail(absl::Span<const NodeIndexType> tails,
+                      absl::Span<const NodeIndexType> heads, int num_threads,
+                      std::vector<ArcIndexType>* permutation);
+
   bool is_built_;
   bool arc_in_order_;
   NodeIndexType last_tail_seen_;
@@ -626,6 +652,9 @@ class ReverseArcStaticGraph
 
   void Build() { Build(nullptr); }
   void Build(std::vector<ArcIndexType>* permutation);
+  // Same as Build(), but uses up to num_threads threads. The graph is the
+  // same, but the permutation is filled even if it is the identity.
+  void Build(std::vector<ArcIndexType>* permutation, int num_threads);
 
  private:
   ArcIndexType DirectArcLimit(NodeIndexType node) const {
@@ -775,6 +804,152 @@ void Permute(const IntVector& permutation,
   PermuteWithExplicitElementType(permutation, array_to_permute, unused);
 }
 
+namespace internal {
+
+// Splits [0, size) in num_chunks contiguous ranges and calls
+// work(chunk, begin, end) on each of them, with one thread per chunk. The
+// ranges only depend on size and num_chunks.
+template <typename Work>
+void RunOnChunks(int64_t size, int num_chunks, const Work& work) {
+  const auto chunk_begin = [size, num_chunks](int chunk) {
+    return size * chunk / num_chunks;
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_chunks - 1);
+  for (int chunk = 1; chunk < num_chunks; ++chunk) {
+    threads.emplace_back([&work, chunk, &chunk_begin]() {
+      work(chunk, chunk_begin(chunk), chunk_begin(chunk + 1));
+    });
+  }
+  work(0, chunk_begin(0), chunk_begin(1));
+  for (std::thread& thread : threads) thread.join();
+}
+
+// Returns the number of threads to use on "size" elements, so that each thread
+// has enough work.
+inline int NumChunks(int64_t size, int num_threads) {
+  constexpr int64_t kMinChunkSize = 1 << 16;
+  return static_cast<int>(
+      std::max<int64_t>(1, std::min<int64_t>(num_threads, size / kMinChunkSize)));
+}
+
+// Stable counting sort of the indices [0, keys.size()) by their key in
+// [0, num_keys), using up to num_threads threads. Fills (*start)[key] with the
+// position of the first index with this key in the sorted order, and calls
+// place(index, position) once for each index, concurrently.
+//
+// Each thread counts the keys of a contiguous range of indices, so this uses
+// a temporary num_threads * num_keys counters, which is capped to about
+// keys.size() counters by using fewer threads.
+template <typename KeyType, typename IndexType, typename Place>
+void ParallelCountingSort(KeyType num_keys, absl::Span<const KeyType> keys,
+                          int num_threads, std::vector<IndexType>* start,
+                          const Place& place) {
+  const int64_t size = keys.size();
+  const int num_chunks = static_cast<int>(std::min<int64_t>(
+      NumChunks(size, num_threads), 1 + size / std::max<int64_t>(1, num_keys)));
+  start->resize(num_keys);
+
+  // counts[chunk][key] is the number of indices with this key in the chunk,
+  // and then the position of the next one in the sorted order.
+  std::vector<std::vector<IndexType>> counts(num_chunks);
+  RunOnChunks(size, num_chunks, [&](int chunk, int64_t begin, int64_t end) {
+    std::vector<IndexType>& count = counts[chunk];
+    count.assign(num_keys, 0);
+    for (int64_t i = begin; i < end; ++i) {
+      DCHECK_GE(keys[i], 0);
+      DCHECK_LT(keys[i], num_keys);
+      ++count[keys[i]];
+    }
+  });
+
+  // Parallel prefix sums: each thread sums the counts of a range of keys, and
+  // then computes the positions of its range from its offset.
+  std::vector<IndexType> range_offset(num_chunks + 1, 0);
+  RunOnChunks(num_keys, num_chunks, [&](int range, int64_t begin, int64_t end) {
+    IndexType sum = 0;
+    for (int64_t key = begin; key < end; ++key) {
+      for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        sum += counts[chunk][key];
+      }
+    }
+    range_offset[range + 1] = sum;
+  });
+  for (int range = 0; range < num_chunks; ++range) {
+    range_offset[range + 1] += range_offset[range];
+  }
+  DCHECK_EQ(range_offset[num_chunks], size);
+  RunOnChunks(num_keys, num_chunks, [&](int range, int64_t begin, int64_t end) {
+    IndexType position = range_offset[range];
+    for (int64_t key = begin; key < end; ++key) {
+      (*start)[key] = position;
+      for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        const IndexType count = counts[chunk][key];
+        counts[chunk][key] = position;
+        position += count;
+      }
+    }
+  });
+
+  RunOnChunks(size, num_chunks, [&](int chunk, int64_t begin, int64_t end) {
+    std::vector<IndexType>& next_position = counts[chunk];
+    for (int64_t i = begin; i < end; ++i) {
+      place(static_cast<IndexType>(i), next_position[keys[i]]++);
+    }
+  });
+}
+
+// Calls f(tail, arc) for all the arcs [0, num_arcs) of a graph whose arcs are
+// sorted by tail, where start[node] is the first arc of node. Uses up to
+// num_threads threads, each of them on a contiguous range of arcs.
+template <typename ArcIndexType, typename F>
+void ParallelForEachTailAndArc(const std::vector<ArcIndexType>& start,
+                               ArcIndexType num_arcs, int num_threads,
+                               const F& f) {
+  if (num_arcs == 0) return;
+  RunOnChunks(num_arcs, NumChunks(num_arcs, num_threads),
+              [&](int, int64_t begin, int64_t end) {
+                if (begin == end) return;
+                // The tail of arc "begin" is the last node whose first arc is
+                // not after it.
+                int64_t tail =
+                    std::upper_bound(start.begin(), start.end(), begin) -
+                    start.begin() - 1;
+                for (int64_t arc = begin; arc < end; ++arc) {
+                  while (tail + 1 < static_cast<int64_t>(start.size()) &&
+                         start[tail + 1] <= arc) {
+                    ++tail;
+                  }
+                  f(tail, static_cast<ArcIndexType>(arc));
+                }
+              });
+}
+
+}  // namespace internal
+
+// Same as Permute(), but uses up to num_threads threads. Array can't be a
+// std::vector<bool>.
+template <class IntVector, class Array>
+void Permute(const IntVector& permutation, Array* array_to_permute,
+             int num_threads) {
+  using ElementType = std::decay_t<decltype((*array_to_permute)[0])>;
+  const int64_t size = permutation.size();
+  std::vector<ElementType> temp(size);
+  const int num_chunks = internal::NumChunks(size, num_threads);
+  internal::RunOnChunks(size, num_chunks,
+                        [&](int, int64_t begin, int64_t end) {
+                          for (int64_t i = begin; i < end; ++i) {
+                            temp[i] = (*array_to_permute)[i];
+                          }
+                        });
+  internal::RunOnChunks(size, num_chunks,
+                        [&](int, int64_t begin, int64_t end) {
+                          for (int64_t i = begin; i < end; ++i) {
+                            (*array_to_permute)[permutation[i]] = temp[i];
+                          }
+                        });
+}
+
 // A vector-like class where valid indices are in [- size_, size_) and reserved
 // indices for future growth are in [- capacity_, capacity_). It is used to hold
 // arc related information for graphs with reverse arcs.
@@ -1086,6 +1261,30 @@ void BaseGraph<NodeIndexType, ArcIndexType, HasReverseArcs>::
   }
 }
 
+// Same as above, with a parallel counting sort of the arcs by tail. Unlike
+// above, "permutation" is filled even if it is the identity.
+template <typename NodeIndexType, typename ArcIndexType, bool HasReverseArcs>
+void BaseGraph<NodeIndexType, ArcIndexType, HasReverseArcs>::
+    BuildStartAndForwardHead(SVector<NodeIndexType>* head,
+                             std::vector<ArcIndexType>* start,
+                             std::vector<ArcIndexType>* permutation,
+                             int num_threads) {
+  if (permutation != nullptr) permutation->resize(num_arcs_);
+  std::vector<NodeIndexType> sorted_heads(num_arcs_);
+  internal::ParallelCountingSort(
+      num_nodes_, absl::MakeConstSpan(head->data(), num_arcs_), num_threads,
+      start, [&](ArcIndexType arc, ArcIndexType position) {
+        sorted_heads[position] = (*head)[~arc];
+        if (permutation != nullptr) (*permutation)[arc] = position;
+      });
+  internal::RunOnChunks(num_arcs_, internal::NumChunks(num_arcs_, num_threads),
+                        [&](int, int64_t begin, int64_t end) {
+                          for (int64_t i = begin; i < end; ++i) {
+                            (*head)[i] = sorted_heads[i];
+                          }
+                        });
+}
+
 // ---------------------------------------------------------------------------
 // Macros to wrap old style iteration into the new range-based for loop style.
 // ---------------------------------------------------------------------------
@@ -1287,6 +1486,24 @@ StaticGraph<NodeIndexType, ArcIndexType>::FromArcs(NodeIndexType num_nodes,
   return g;
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>
+StaticGraph<NodeIndexType, ArcIndexType>::FromTailsAndHeads(
+    NodeIndexType num_nodes, absl::Span<const NodeIndexType> tails,
+    absl::Span<const NodeIndexType> heads, int num_threads,
+    std::vector<ArcIndexType>* permutation) {
+  CHECK_EQ(tails.size(), heads.size());
+  StaticGraph g;
+  g.AddNode(num_nodes - 1);
+  g.num_arcs_ = tails.size();
+  g.is_built_ = true;
+  g.node_capacity_ = g.num_nodes_;
+  g.arc_capacity_ = g.num_arcs_;
+  g.FreezeCapacities();
+  g.SortArcsByTail(tails, heads, num_threads, permutation);
+  return g;
+}
+
 DEFINE_RANGE_BASED_ARC_ITERATION(StaticGraph, Outgoing, DirectArcLimit(node));
 
 template <typename NodeIndexType, typename ArcIndexType>
@@ -1432,6 +1649,49 @@ void StaticGraph<NodeIndexType, ArcIndexType>::Build(
   }
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+void StaticGraph<NodeIndexType, ArcIndexType>::Build(
+    std::vector<ArcIndexType>* permutation, int num_threads) {
+  if (num_threads <= 1 || arc_in_order_) {
+    Build(permutation);
+    if (permutation != nullptr && permutation->empty()) {
+      permutation->resize(num_arcs_);
+      std::iota(permutation->begin(), permutation->end(), 0);
+    }
+    return;
+  }
+  DCHECK(!is_built_);
+  if (is_built_) return;
+  is_built_ = true;
+  node_capacity_ = num_nodes_;
+  arc_capacity_ = num_arcs_;
+  this->FreezeCapacities();
+  // SortArcsByTail() replaces head_ and tail_, so the input arcs are moved
+  // out of them first.
+  const std::vector<NodeIndexType> tails = std::move(tail_);
+  const std::vector<NodeIndexType> heads = std::move(head_);
+  SortArcsByTail(tails, heads, num_threads, permutation);
+}
+
+template <typename NodeIndexType, typename ArcIndexType>
+void StaticGraph<NodeIndexType, ArcIndexType>::SortArcsByTail(
+    absl::Span<const NodeIndexType> tails,
+    absl::Span<const NodeIndexType> heads, int num_threads,
+    std::vector<ArcIndexType>* permutation) {
+  if (permutation != nullptr) permutation->resize(num_arcs_);
+  head_.resize(num_arcs_);
+  internal::ParallelCountingSort(
+      num_nodes_, tails, num_threads, &start_,
+      [&](ArcIndexType arc, ArcIndexType position) {
+        head_[position] = heads[arc];
+        if (permutation != nullptr) (*permutation)[arc] = position;
+      });
+  tail_.resize(num_arcs_);
+  internal::ParallelForEachTailAndArc(
+      start_, num_arcs_, num_threads,
+      [this](NodeIndexType tail, ArcIndexType arc) { tail_[arc] = tail; });
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 class StaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcIterator {
  public:
@@ -1847,6 +2107,51 @@ void ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::Build(
   }
 }
 
+template <typename NodeIndexType, typename ArcIndexType>
+void ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::Build(
+    std::vector<ArcIndexType>* permutation, int num_threads) {
+  if (num_threads <= 1) {
+    Build(permutation);
+    if (permutation != nullptr && permutation->empty()) {
+      permutation->resize(num_arcs_);
+      std::iota(permutation->begin(), permutation->end(), 0);
+    }
+    return;
+  }
+  DCHECK(!is_built_);
+  if (is_built_) return;
+  is_built_ = true;
+  node_capacity_ = num_nodes_;
+  arc_capacity_ = num_arcs_;
+  this->FreezeCapacities();
+  this->BuildStartAndForwardHead(&head_, &start_, permutation, num_threads);
+
+  // The reverse arcs are sorted by head with the same stable counting sort,
+  // which gives the same order as Build().
+  opposite_.resize(num_arcs_);
+  internal::ParallelCountingSort(
+      num_nodes_, absl::MakeConstSpan(head_.data(), num_arcs_), num_threads,
+      &reverse_start_, [this](ArcIndexType arc, ArcIndexType position) {
+        opposite_[arc] = position - num_arcs_;
+      });
+  for (ArcIndexType& reverse_start : reverse_start_) {
+    reverse_start -= num_arcs_;
+  }
+
+  // Fill reverse arc information.
+  internal::RunOnChunks(num_arcs_, internal::NumChunks(num_arcs_, num_threads),
+                        [this](int, int64_t begin, int64_t end) {
+                          for (int64_t i = begin; i < end; ++i) {
+                            opposite_[opposite_[i]] = i;
+                          }
+                        });
+  internal::ParallelForEachTailAndArc(
+      start_, num_arcs_, num_threads,
+      [this](NodeIndexType tail, ArcIndexType arc) {
+        head_[opposite_[arc]] = tail;
+      });
+}
+
 template <typename NodeIndexType, typename ArcIndexType>
 class ReverseArcStaticGraph<NodeIndexType, ArcIndexType>::OutgoingArcIterator {
  public:
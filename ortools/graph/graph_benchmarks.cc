@@ -0,0 +1,295 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks of the main graph algorithms on random graphs with an average
+// out-degree of 10, from 1k to 100M arcs. Each benchmark reports the number of
+// arcs processed per second and the resident memory of the process once the
+// problem is set up ("memory_bytes"). The largest sizes need several GB; use
+// --benchmark_filter to select the sizes, e.g. --benchmark_filter=/1000000$.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "absl/random/distributions.h"
+#include "absl/random/random.h"
+#include "benchmark/benchmark.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/sysinfo.h"
+#include "ortools/graph/bounded_dijkstra.h"
+#include "ortools/graph/connected_components.h"
+#include "ortools/graph/graph.h"
+#include "ortools/graph/linear_assignment.h"
+#include "ortools/graph/max_flow.h"
+#include "ortools/graph/min_cost_flow.h"
+#include "ortools/graph/random_graph.h"
+
+namespace operations_research {
+namespace {
+
+constexpr int kAverageDegree = 10;
+constexpr int kRandomSeed = 0;
+constexpr int64_t kMinNumArcs = 1'000;
+constexpr int64_t kMaxNumArcs = 100'000'000;
+
+using Graph = ::util::StaticGraph<>;
+using ReverseArcGraph = ::util::ReverseArcStaticGraph<>;
+
+int NumNodes(const benchmark::State& state) {
+  return std::max<int>(2, state.range(0) / kAverageDegree);
+}
+
+void ReportMemoryUsage(benchmark::State& state) {
+  state.counters["memory_bytes"] = GetProcessMemoryUsage();
+}
+
+void ReportArcsProcessed(benchmark::State& state, const int64_t num_arcs) {
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * num_arcs);
+}
+
+// Returns a random graph with the arcs of a random multigraph, plus a cycle
+// through all the nodes so that they are all reachable from each other.
+template <typename GraphType>
+std::unique_ptr<GraphType> RandomConnectedGraph(const int num_nodes,
+                                                const int num_arcs,
+                                                std::mt19937& random) {
+  auto graph = std::make_unique<GraphType>(num_nodes, num_arcs);
+  for (int node = 0; node < num_nodes; ++node) {
+    graph->AddArc(node, node + 1 < num_nodes ? node + 1 : 0);
+  }
+  for (int arc = num_nodes; arc < num_arcs; ++arc) {
+    graph->AddArc(absl::Uniform(random, 0, num_nodes),
+                  absl::Uniform(random, 0, num_nodes));
+  }
+  return graph;
+}
+
+void BM_StaticGraphBuild(benchmark::State& state) {
+  const int num_arcs = state.range(0);
+  absl::BitGen gen;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::unique_ptr<Graph> graph = util::GenerateRandomMultiGraph(
+        NumNodes(state), num_arcs, /*finalized=*/false, gen);
+    std::vector<Graph::ArcIndex> permutation;
+    state.ResumeTiming();
+    graph->Build(&permutation);
+    benchmark::DoNotOptimize(permutation);
+    state.PauseTiming();
+    ReportMemoryUsage(state);
+    graph.reset();
+    state.ResumeTiming();
+  }
+  ReportArcsProcessed(state, num_arcs);
+}
+BENCHMARK(BM_StaticGraphBuild)
+    ->RangeMultiplier(10)
+    ->Range(kMinNumArcs, kMaxNumArcs)
+    ->Unit(benchmark::kMillisecond);
+
+// The graph is made undirected by adding the reverse of each of its
+// num_arcs / 2 random arcs.
+void BM_ConnectedComponents(benchmark::State& state) {
+  const int num_nodes = NumNodes(state);
+  const int num_edges = state.range(0) / 2;
+  std::mt19937 random(kRandomSeed);
+  Graph graph(num_nodes, 2 * num_edges);
+  for (int edge = 0; edge < num_edges; ++edge) {
+    const int a = absl::Uniform(random, 0, num_nodes);
+    const int b = absl::Uniform(random, 0, num_nodes);
+    graph.AddArc(a, b);
+    graph.AddArc(b, a);
+  }
+  graph.Build();
+  ReportMemoryUsage(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(util::GetConnectedComponents(num_nodes, graph));
+  }
+  ReportArcsProcessed(state, graph.num_arcs());
+}
+BENCHMARK(BM_ConnectedComponents)
+    ->RangeMultiplier(10)
+    ->Range(kMinNumArcs, kMaxNumArcs)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_DenseConnectedComponentsFinder(benchmark::State& state) {
+  const int num_nodes = NumNodes(state);
+  const int num_edges = state.range(0);
+  std::mt19937 random(kRandomSeed);
+  std::vector<std::pair<int, int>> edges(num_edges);
+  for (auto& [a, b] : edges) {
+    a = absl::Uniform(random, 0, num_nodes);
+    b = absl::Uniform(random, 0, num_nodes);
+  }
+  ReportMemoryUsage(state);
+  for (auto _ : state) {
+    DenseConnectedComponentsFinder finder;
+    finder.SetNumberOfNodes(num_nodes);
+    for (const auto& [a, b] : edges) finder.AddEdge(a, b);
+    benchmark::DoNotOptimize(finder.GetNumberOfComponents());
+  }
+  ReportArcsProcessed(state, num_edges);
+}
+BENCHMARK(BM_DenseConnectedComponentsFinder)
+    ->RangeMultiplier(10)
+    ->Range(kMinNumArcs, kMaxNumArcs)
+    ->Unit(benchmark::kMillisecond);
+
+// A full Dijkstra from node 0, without distance limit.
+void BM_BoundedDijkstra(benchmark::State& state) {
+  const int num_arcs = state.range(0);
+  std::mt19937 random(kRandomSeed);
+  std::unique_ptr<Graph> graph =
+      RandomConnectedGraph<Graph>(NumNodes(state), num_arcs, random);
+  std::vector<Graph::ArcIndex> permutation;
+  graph->Build(&permutation);
+  std::vector<int64_t> arc_lengths(num_arcs);
+  for (int64_t& length : arc_lengths) {
+    length = absl::Uniform(random, 0, 1000);
+  }
+  util::Permute(permutation, &arc_lengths);
+  BoundedDijkstraWrapper<Graph, int64_t> dijkstra(graph.get(), &arc_lengths);
+  ReportMemoryUsage(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dijkstra.RunBoundedDijkstra(
+        /*source_node=*/0, std::numeric_limits<int64_t>::max()));
+  }
+  ReportArcsProcessed(state, num_arcs);
+}
+BENCHMARK(BM_BoundedDijkstra)
+    ->RangeMultiplier(10)
+    ->Range(kMinNumArcs, kMaxNumArcs)
+    ->Unit(benchmark::kMillisecond);
+
+// The max flow from node 0 to the last node. The max flow is built at each
+// iteration, since it can only be solved once from scratch.
+void BM_MaxFlow(benchmark::State& state) {
+  const int num_nodes = NumNodes(state);
+  const int num_arcs = state.range(0);
+  std::mt19937 random(kRandomSeed);
+  std::unique_ptr<ReverseArcGraph> graph =
+      RandomConnectedGraph<ReverseArcGraph>(num_nodes, num_arcs, random);
+  std::vector<ReverseArcGraph::ArcIndex> permutation;
+  graph->Build(&permutation);
+  std::vector<FlowQuantity> capacities(num_arcs);
+  for (FlowQuantity& capacity : capacities) {
+    capacity = absl::Uniform(random, 1, 10000);
+  }
+  util::Permute(permutation, &capacities);
+  for (auto _ : state) {
+    GenericMaxFlow<ReverseArcGraph> max_flow(graph.get(), /*source=*/0,
+                                             /*sink=*/num_nodes - 1);
+    for (int arc = 0; arc < num_arcs; ++arc) {
+      max_flow.SetArcCapacity(arc, capacities[arc]);
+    }
+    CHECK(max_flow.Solve());
+    benchmark::DoNotOptimize(max_flow.GetOptimalFlow());
+    state.PauseTiming();
+    ReportMemoryUsage(state);
+    state.ResumeTiming();
+  }
+  ReportArcsProcessed(state, num_arcs);
+}
+BENCHMARK(BM_MaxFlow)
+    ->RangeMultiplier(10)
+    ->Range(kMinNumArcs, kMaxNumArcs)
+    ->Unit(benchmark::kMillisecond);
+
+// A transportation problem: a tenth of the nodes have a supply and another
+// tenth have a demand. The capacities are large enough for it to be feasible,
+// thanks to the cycle through all the nodes.
+void BM_MinCostFlow(benchmark::State& state) {
+  const int num_nodes = NumNodes(state);
+  const int num_arcs = state.range(0);
+  std::mt19937 random(kRandomSeed);
+  std::unique_ptr<ReverseArcGraph> graph =
+      RandomConnectedGraph<ReverseArcGraph>(num_nodes, num_arcs, random);
+  std::vector<ReverseArcGraph::ArcIndex> permutation;
+  graph->Build(&permutation);
+  std::vector<CostValue> costs(num_arcs);
+  for (CostValue& cost : costs) cost = absl::Uniform(random, 0, 1000);
+  util::Permute(permutation, &costs);
+  const int num_terminals = std::max(1, num_nodes / 10);
+  const FlowQuantity kSupply = 100;
+  for (auto _ : state) {
+    GenericMinCostFlow<ReverseArcGraph> min_cost_flow(graph.get());
+    for (int arc = 0; arc < num_arcs; ++arc) {
+      min_cost_flow.SetArcUnitCost(arc, costs[arc]);
+      min_cost_flow.SetArcCapacity(arc, num_terminals * kSupply);
+    }
+    for (int i = 0; i < num_terminals; ++i) {
+      min_cost_flow.SetNodeSupply(2 * i, kSupply);
+      min_cost_flow.SetNodeSupply(2 * i + 1, -kSupply);
+    }
+    CHECK(min_cost_flow.Solve());
+    benchmark::DoNotOptimize(min_cost_flow.GetOptimalCost());
+    state.PauseTiming();
+    ReportMemoryUsage(state);
+    state.ResumeTiming();
+  }
+  ReportArcsProcessed(state, num_arcs);
+}
+BENCHMARK(BM_MinCostFlow)
+    ->RangeMultiplier(10)
+    ->Range(kMinNumArcs, kMaxNumArcs)
+    ->Unit(benchmark::kMillisecond);
+
+// A random bipartite graph with num_arcs / 10 nodes on each side, which
+// contains a perfect matching so that the assignment is feasible.
+void BM_LinearSumAssignment(benchmark::State& state) {
+  const int num_left_nodes = NumNodes(state);
+  const int num_arcs = state.range(0);
+  std::mt19937 random(kRandomSeed);
+  Graph graph(2 * num_left_nodes, num_arcs);
+  std::vector<int> matching(num_left_nodes);
+  std::iota(matching.begin(), matching.end(), num_left_nodes);
+  std::shuffle(matching.begin(), matching.end(), random);
+  for (int left = 0; left < num_left_nodes; ++left) {
+    graph.AddArc(left, matching[left]);
+  }
+  for (int arc = num_left_nodes; arc < num_arcs; ++arc) {
+    graph.AddArc(absl::Uniform(random, 0, num_left_nodes),
+                 num_left_nodes + absl::Uniform(random, 0, num_left_nodes));
+  }
+  std::vector<Graph::ArcIndex> permutation;
+  graph.Build(&permutation);
+  std::vector<CostValue> costs(num_arcs);
+  for (CostValue& cost : costs) cost = absl::Uniform(random, 0, 1000000);
+  util::Permute(permutation, &costs);
+  for (auto _ : state) {
+    LinearSumAssignment<Graph> assignment(graph, num_left_nodes);
+    for (int arc = 0; arc < num_arcs; ++arc) {
+      assignment.SetArcCost(arc, costs[arc]);
+    }
+    CHECK(assignment.ComputeAssignment());
+    benchmark::DoNotOptimize(assignment.GetCost());
+    state.PauseTiming();
+    ReportMemoryUsage(state);
+    state.ResumeTiming();
+  }
+  ReportArcsProcessed(state, num_arcs);
+}
+BENCHMARK(BM_LinearSumAssignment)
+    ->RangeMultiplier(10)
+    ->Range(kMinNumArcs, kMaxNumArcs)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace operations_research
+
+BENCHMARK_MAIN();
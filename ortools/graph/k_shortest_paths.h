@@ -55,8 +55,11 @@
 #define OR_TOOLS_GRAPH_K_SHORTEST_PATHS_H_
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <utility>
@@ -67,8 +70,10 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/graph/bounded_dijkstra.h"
 #include "ortools/graph/ebert_graph.h"
 #include "ortools/graph/shortest_paths.h"
@@ -112,11 +117,15 @@ struct KShortestPaths {
 // Yen, Jin Y. "Finding the k Shortest Loopless Paths in a Network". Management
 // Science. 17 (11): 712–716, 1971.
 // https://doi.org/10.1287%2Fmnsc.17.11.712
+//
+// The spur paths of each iteration are computed on `num_threads` threads, each
+// with its own copy of the arc lengths. The result does not depend on
+// `num_threads`.
 template <class GraphType>
 KShortestPaths YenKShortestPaths(const GraphType& graph,
                                  const std::vector<PathDistance>& arc_lengths,
                                  NodeIndex source, NodeIndex destination,
-                                 unsigned k);
+                                 unsigned k, int num_threads = 1);
 
 // End of the interface. Below is the implementation.
 
@@ -148,33 +157,57 @@ ArcIndex FindArcIndex(const GraphType& graph, const NodeIndex source,
   return (arc != outgoing_arcs_iter.end()) ? *arc : GraphType::kNilArc;
 }
 
-// Determines the shortest path from the given source and destination, returns a
-// tuple with the path (as a vector of node indices) and its cost.
+// The memory needed to compute the spur paths of Yen's algorithm: a copy of the
+// arc lengths in which some arcs are forbidden, and a Dijkstra on top of it.
+// Each thread owns one, so that nothing is allocated per spur path.
 template <class GraphType>
-std::tuple<std::vector<NodeIndex>, PathDistance> ComputeShortestPath(
-    const GraphType& graph, const std::vector<PathDistance>& arc_lengths,
-    const NodeIndex source, const NodeIndex destination) {
-  BoundedDijkstraWrapper<GraphType, PathDistance> dijkstra(&graph,
-                                                           &arc_lengths);
-  dijkstra.RunBoundedDijkstra(source, kMaxDistance);
-  const PathDistance path_length = dijkstra.distances()[destination];
-
-  if (path_length >= kMaxDistance) {
-    // There are shortest paths in this graph, just not from the source to this
-    // destination.
-    // This case only happens when some arcs have an infinite length (i.e.
-    // larger than `kMaxDistance`): `BoundedDijkstraWrapper::NodePathTo` fails
-    // to return a path, even empty.
-    return {{}, kDisconnectedDistance};
+class SpurPathWorkspace {
+ public:
+  SpurPathWorkspace(const GraphType& graph,
+                    const std::vector<PathDistance>& arc_lengths)
+      : arc_lengths_(arc_lengths),
+        arc_lengths_for_detour_(arc_lengths),
+        dijkstra_(&graph, &arc_lengths_for_detour_) {}
+
+  // Forbids the arc until the next call to RestoreArcLengths().
+  void ForbidArc(ArcIndex arc) {
+    arc_lengths_for_detour_[arc] = kDisconnectedDistance;
+    forbidden_arcs_.push_back(arc);
+  }
+
+  // Restores the lengths of all the forbidden arcs.
+  void RestoreArcLengths() {
+    for (const ArcIndex arc : forbidden_arcs_) {
+      arc_lengths_for_detour_[arc] = arc_lengths_[arc];
+    }
+    forbidden_arcs_.clear();
   }
 
-  if (std::vector<NodeIndex> path = std::move(dijkstra.NodePathTo(destination));
-      !path.empty()) {
-    return {std::move(path), path_length};
-  } else {
-    return {{}, kDisconnectedDistance};
+  const std::vector<PathDistance>& arc_lengths_for_detour() const {
+    return arc_lengths_for_detour_;
   }
-}
+
+  // Determines the shortest path from the given source and destination without
+  // using the forbidden arcs, returns a tuple with the path (as a vector of
+  // node indices) and its cost. The path is empty if its cost is not below
+  // `distance_limit`, which must be at most `kMaxDistance`: this also happens
+  // when some arcs have an infinite length (i.e. larger than `kMaxDistance`).
+  std::tuple<std::vector<NodeIndex>, PathDistance> ComputeShortestPath(
+      NodeIndex source, NodeIndex destination, PathDistance distance_limit) {
+    DCHECK_LE(distance_limit, kMaxDistance);
+    if (!dijkstra_.OneToOneShortestPath(source, destination, distance_limit)) {
+      return {std::vector<NodeIndex>(), kDisconnectedDistance};
+    }
+    return {dijkstra_.NodePathTo(destination),
+            dijkstra_.distances()[destination]};
+  }
+
+ private:
+  const std::vector<PathDistance>& arc_lengths_;
+  std::vector<PathDistance> arc_lengths_for_detour_;
+  std::vector<ArcIndex> forbidden_arcs_;
+  BoundedDijkstraWrapper<GraphType, PathDistance> dijkstra_;
+};
 
 // Computes the total length of a path.
 template <class GraphType>
@@ -199,6 +232,9 @@ class PathWithPriority {
   bool operator<(const PathWithPriority& other) const {
     return priority_ < other.priority_;
   }
+  bool operator>(const PathWithPriority& other) const {
+    return priority_ > other.priority_;
+  }
 
   [[nodiscard]] const std::vector<NodeIndex>& path() const { return path_; }
   [[nodiscard]] PathDistance priority() const { return priority_; }
@@ -268,7 +304,7 @@ template <class GraphType>
 KShortestPaths YenKShortestPaths(const GraphType& graph,
                                  const std::vector<PathDistance>& arc_lengths,
                                  NodeIndex source, NodeIndex destination,
-                                 unsigned k) {
+                                 unsigned k, int num_threads) {
   CHECK_GT(internal::kDisconnectedDistance, internal::kMaxDistance);
 
   CHECK_GE(k, 0) << "k must be nonnegative. Input value: " << k;
@@ -291,10 +327,20 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
 
   KShortestPaths paths;
 
+  // A path has at most `graph.num_nodes() - 1` spur nodes: more threads would
+  // have nothing to do.
+  const int num_workers =
+      std::max(1, std::min(num_threads, graph.num_nodes() - 1));
+  std::vector<std::unique_ptr<internal::SpurPathWorkspace<GraphType>>>
+      workspaces;
+  workspaces.push_back(std::make_unique<internal::SpurPathWorkspace<GraphType>>(
+      graph, arc_lengths));
+
   // First step: compute the shortest path.
   {
     std::tuple<std::vector<NodeIndex>, PathDistance> first_path =
-        internal::ComputeShortestPath(graph, arc_lengths, source, destination);
+        workspaces[0]->ComputeShortestPath(source, destination,
+                                           internal::kMaxDistance);
     if (std::get<0>(first_path).empty()) return paths;
     paths.paths.push_back(std::move(std::get<0>(first_path)));
     paths.distances.push_back(std::get<1>(first_path));
@@ -304,11 +350,30 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
     return paths;
   }
 
-  // Generate variant paths.
+  std::unique_ptr<ThreadPool> pool;
+  if (num_workers > 1) {
+    pool = std::make_unique<ThreadPool>("YenKShortestPaths", num_workers - 1);
+    pool->StartWorkers();
+    for (int worker = 1; worker < num_workers; ++worker) {
+      workspaces.push_back(
+          std::make_unique<internal::SpurPathWorkspace<GraphType>>(
+              graph, arc_lengths));
+    }
+  }
+
+  // Generate variant paths, the shortest one being on top.
   internal::UnderlyingContainerAdapter<
-      std::priority_queue<internal::PathWithPriority>>
+      std::priority_queue<internal::PathWithPriority,
+                          std::vector<internal::PathWithPriority>,
+                          std::greater<internal::PathWithPriority>>>
       variant_path_queue;
 
+  // The spur paths of the current iteration, indexed by the position of their
+  // spur node in the last shortest path, with their length.
+  std::vector<std::tuple<std::vector<NodeIndex>, PathDistance>> spur_paths;
+  std::vector<PathDistance> root_path_lengths;
+  std::vector<PathDistance> queued_path_lengths;
+
   // One path has already been generated (the shortest one). Only k-1 more
   // paths need to be generated.
   for (; k > 1; --k) {
@@ -317,41 +382,63 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
     // Generate variant paths from the last shortest path.
     const absl::Span<NodeIndex> last_shortest_path =
         absl::MakeSpan(paths.paths.back());
-
-    // TODO(user): think about adding parallelism for this loop to improve
-    // running times. This is not a priority as long as the algorithm is
-    // faster than the one in `shortest_paths.h`.
-    for (int spur_node_position = 0;
-         spur_node_position < last_shortest_path.size() - 1;
-         ++spur_node_position) {
-      VLOG(4) << "  spur_node_position: " << spur_node_position;
-      VLOG(4) << "  last_shortest_path: "
-              << absl::StrJoin(last_shortest_path, " - ") << " ("
-              << last_shortest_path.size() << ")";
-      if (spur_node_position > 0) {
-        DCHECK_NE(last_shortest_path[spur_node_position], source);
+    const int num_spur_nodes = last_shortest_path.size() - 1;
+
+    // Only k-1 more paths are needed. If the queue already holds that many
+    // paths, no path longer than the (k-1)-th shortest of them can be output:
+    // the spur paths that would make a longer path are not computed.
+    PathDistance max_path_length = internal::kMaxDistance;
+    if (variant_path_queue.size() >= k - 1) {
+      queued_path_lengths.clear();
+      for (const internal::PathWithPriority& element :
+           variant_path_queue.container()) {
+        queued_path_lengths.push_back(element.priority());
       }
-      DCHECK_NE(last_shortest_path[spur_node_position], destination);
+      std::nth_element(queued_path_lengths.begin(),
+                       queued_path_lengths.begin() + (k - 2),
+                       queued_path_lengths.end());
+      max_path_length = std::min(max_path_length, queued_path_lengths[k - 2]);
+    }
+    root_path_lengths.assign(num_spur_nodes, 0);
+    for (int i = 1; i < num_spur_nodes; ++i) {
+      const ArcIndex arc = internal::FindArcIndex(
+          graph, last_shortest_path[i - 1], last_shortest_path[i]);
+      DCHECK_NE(arc, GraphType::kNilArc);
+      root_path_lengths[i] = root_path_lengths[i - 1] + arc_lengths[arc];
+    }
 
+    // Computes the spur path at the given position of the last shortest path
+    // with `workspace`. The spur paths only depend on `paths`, so that they
+    // can be computed in any order, on any thread.
+    const auto compute_spur_path =
+        [&graph, &paths, &root_path_lengths, last_shortest_path, source,
+         destination, max_path_length](
+            internal::SpurPathWorkspace<GraphType>& workspace,
+            const int spur_node_position)
+        -> std::tuple<std::vector<NodeIndex>, PathDistance> {
       const NodeIndex spur_node = last_shortest_path[spur_node_position];
+      const PathDistance root_path_length =
+          root_path_lengths[spur_node_position];
+      if (root_path_length > max_path_length) {
+        return {std::vector<NodeIndex>(), internal::kDisconnectedDistance};
+      }
       // Consider the part of the last shortest path up to and excluding the
       // spur node. If spur_node_position == 0, this span only contains the
       // source node.
-      const absl::Span<NodeIndex> root_path =
+      const absl::Span<const NodeIndex> root_path =
           last_shortest_path.subspan(0, spur_node_position + 1);
       DCHECK_GE(root_path.length(), 1);
       DCHECK_NE(root_path.back(), destination);
 
       // Simplify the graph to have different paths using infinite lengths:
-      // copy the weights, set some of them to infinity. There is no need to
-      // restore the graph to its previous state in this case.
+      // set some of the weights of the workspace to infinity, and restore them
+      // once the spur path is computed.
       //
       // This trick is used in the original article (it's old-fashioned), but
       // not in Wikipedia's pseudocode (it prefers mutating the graph, which is
       // harder to do without copying the whole graph structure).
       // Copying the whole graph might be quite expensive, especially as it is
       // not useful for long (computing one shortest path).
-      std::vector<PathDistance> arc_lengths_for_detour = arc_lengths;
       for (absl::Span<const NodeIndex> previous_path : paths.paths) {
         // Check among the previous paths: if part of the path coincides with
         // the first few nodes up to the spur node (included), forbid this part
@@ -370,8 +457,7 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
         VLOG(4) << "  after_spur_node_arc: " << graph.Tail(after_spur_node_arc)
                 << " - " << graph.Head(after_spur_node_arc) << " (" << source
                 << " - " << destination << ")";
-        arc_lengths_for_detour[after_spur_node_arc] =
-            internal::kDisconnectedDistance;
+        workspace.ForbidArc(after_spur_node_arc);
       }
       // Ensure that the path computed from the new weights is loopless by
       // "removing" the nodes of the root path from the graph (by tweaking the
@@ -381,21 +467,74 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
       for (int node_position = 0; node_position < spur_node_position;
            ++node_position) {
         for (const int arc : graph.OutgoingArcs(root_path[node_position])) {
-          arc_lengths_for_detour[arc] = internal::kDisconnectedDistance;
+          workspace.ForbidArc(arc);
         }
       }
       VLOG(3) << "  arc_lengths_for_detour: "
-              << absl::StrJoin(arc_lengths_for_detour, " - ");
+              << absl::StrJoin(workspace.arc_lengths_for_detour(), " - ");
 
       // Generate a new candidate path from the spur node to the destination
-      // without using the forbidden arcs.
+      // without using the forbidden arcs, short enough to be output.
+      const PathDistance max_spur_path_length =
+          max_path_length - root_path_length;
+      std::tuple<std::vector<NodeIndex>, PathDistance> spur_path =
+          workspace.ComputeShortestPath(
+              spur_node, destination,
+              max_spur_path_length < internal::kMaxDistance
+                  ? max_spur_path_length + 1
+                  : internal::kMaxDistance);
+      workspace.RestoreArcLengths();
+      return spur_path;
+    };
+
+    spur_paths.resize(num_spur_nodes);
+    std::atomic<int> next_spur_node_position = 0;
+    const auto run_worker =
+        [&spur_paths, &next_spur_node_position, &compute_spur_path,
+         num_spur_nodes](internal::SpurPathWorkspace<GraphType>& workspace) {
+          for (int position = next_spur_node_position.fetch_add(1);
+               position < num_spur_nodes;
+               position = next_spur_node_position.fetch_add(1)) {
+            spur_paths[position] = compute_spur_path(workspace, position);
+          }
+        };
+    if (pool == nullptr || num_spur_nodes == 1) {
+      run_worker(*workspaces[0]);
+    } else {
+      const int num_tasks = std::min(num_workers, num_spur_nodes);
+      absl::BlockingCounter counter(num_tasks - 1);
+      for (int worker = 1; worker < num_tasks; ++worker) {
+        pool->Schedule([&run_worker, &workspaces, &counter, worker]() {
+          run_worker(*workspaces[worker]);
+          counter.DecrementCount();
+        });
+      }
+      run_worker(*workspaces[0]);
+      counter.Wait();
+    }
+
+    // Add the new candidate paths in the order of their spur nodes, so that
+    // the result does not depend on the number of threads.
+    for (int spur_node_position = 0; spur_node_position < num_spur_nodes;
+         ++spur_node_position) {
+      VLOG(4) << "  spur_node_position: " << spur_node_position;
+      VLOG(4) << "  last_shortest_path: "
+              << absl::StrJoin(last_shortest_path, " - ") << " ("
+              << last_shortest_path.size() << ")";
+      if (spur_node_position > 0) {
+        DCHECK_NE(last_shortest_path[spur_node_position], source);
+      }
+      DCHECK_NE(last_shortest_path[spur_node_position], destination);
+
+      const absl::Span<NodeIndex> root_path =
+          last_shortest_path.subspan(0, spur_node_position + 1);
       {
-        std::tuple<std::vector<NodeIndex>, PathDistance> detour_path =
-            internal::ComputeShortestPath(graph, arc_lengths_for_detour,
-                                          spur_node, destination);
+        std::tuple<std::vector<NodeIndex>, PathDistance>& detour_path =
+            spur_paths[spur_node_position];
 
         if (std::get<0>(detour_path).empty()) {
-          // Node unreachable after some arcs are forbidden.
+          // Node unreachable after some arcs are forbidden, or only through
+          // paths too long to be output.
           continue;
         }
         VLOG(2) << "  detour_path: "
@@ -407,7 +546,6 @@ KShortestPaths YenKShortestPaths(const GraphType& graph,
 
 #ifndef NDEBUG
         CHECK_EQ(root_path.back(), spur_path.front());
-        CHECK_EQ(spur_node, spur_path.front());
 
         if (spur_path.size() == 1) {
           CHECK_EQ(spur_path.front(), destination);
@@ -392,6 +392,39 @@ TEST(KShortestPathsYenTest, RandomTest) {
   }
 }
 
+TEST(KShortestPathsYenTest, MultithreadedGivesTheSameResult) {
+  std::mt19937 random(12345);
+  constexpr int kNumGraphs = 10;
+  constexpr int kNumQueriesPerGraph = 10;
+  constexpr int kNumNodes = 50;
+  constexpr int kNumArcs = 5 * kNumNodes;
+  constexpr int kMinLength = 0;
+  constexpr int kMaxLength = 1'000;
+
+  for (int graph_iter = 0; graph_iter < kNumGraphs; ++graph_iter) {
+    StaticGraph<> graph =
+        GenerateUniformDirectedGraph(random, kNumNodes, kNumArcs);
+    std::vector<PathDistance> lengths;
+    for (int i = 0; i < graph.num_arcs(); ++i) {
+      lengths.push_back(absl::Uniform(random, kMinLength, kMaxLength));
+    }
+
+    for (int q = 0; q < kNumQueriesPerGraph; ++q) {
+      const int src = absl::Uniform(random, 0, kNumNodes);
+      const int dst = absl::Uniform(random, 0, kNumNodes);
+      if (src == dst) continue;
+
+      const KShortestPaths sequential_paths =
+          YenKShortestPaths(graph, lengths, src, dst, /*k=*/20);
+      const KShortestPaths parallel_paths = YenKShortestPaths(
+          graph, lengths, src, dst, /*k=*/20, /*num_threads=*/4);
+      EXPECT_EQ(parallel_paths.paths, sequential_paths.paths);
+      EXPECT_EQ(parallel_paths.distances, sequential_paths.distances);
+      EXPECT_TRUE(absl::c_is_sorted(parallel_paths.distances));
+    }
+  }
+}
+
 void BM_Yen(benchmark::State& state) {
   const int num_nodes = state.range(0);
   // Use half the maximum number of arcs, so that the graph is a bit sparse.
@@ -37,6 +37,8 @@ ArcIndex SimpleMaxFlow::AddArcWithCapacity(NodeIndex tail, NodeIndex head,
   arc_tail_.push_back(tail);
   arc_head_.push_back(head);
   arc_capacity_.push_back(capacity);
+  underlying_max_flow_.reset();
+  underlying_graph_.reset();
   return num_arcs;
 }
 
@@ -54,33 +56,55 @@ FlowQuantity SimpleMaxFlow::Capacity(ArcIndex arc) const {
 
 void SimpleMaxFlow::SetArcCapacity(ArcIndex arc, FlowQuantity capacity) {
   arc_capacity_[arc] = capacity;
+  if (underlying_max_flow_ == nullptr) return;
+  if (capacity < 0) {
+    // Let the next Solve() rebuild everything and report the bad input.
+    underlying_max_flow_.reset();
+    underlying_graph_.reset();
+    return;
+  }
+  const ArcIndex permuted_arc =
+      arc < arc_permutation_.size() ? arc_permutation_[arc] : arc;
+  underlying_max_flow_->SetArcCapacity(permuted_arc, capacity);
 }
 
 SimpleMaxFlow::Status SimpleMaxFlow::Solve(NodeIndex source, NodeIndex sink) {
   const ArcIndex num_arcs = arc_capacity_.size();
   arc_flow_.assign(num_arcs, 0);
-  underlying_max_flow_.reset();
-  underlying_graph_.reset();
   optimal_flow_ = 0;
   if (source == sink || source < 0 || sink < 0) {
+    underlying_max_flow_.reset();
+    underlying_graph_.reset();
     return BAD_INPUT;
   }
   if (source >= num_nodes_ || sink >= num_nodes_) {
+    underlying_max_flow_.reset();
+    underlying_graph_.reset();
     return OPTIMAL;
   }
-  underlying_graph_ = std::make_unique<Graph>(num_nodes_, num_arcs);
-  underlying_graph_->AddNode(source);
-  underlying_graph_->AddNode(sink);
-  for (int arc = 0; arc < num_arcs; ++arc) {
-    underlying_graph_->AddArc(arc_tail_[arc], arc_head_[arc]);
-  }
-  underlying_graph_->Build(&arc_permutation_);
-  underlying_max_flow_ = std::make_unique<GenericMaxFlow<Graph>>(
-      underlying_graph_.get(), source, sink);
-  for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
-    ArcIndex permuted_arc =
-        arc < arc_permutation_.size() ? arc_permutation_[arc] : arc;
-    underlying_max_flow_->SetArcCapacity(permuted_arc, arc_capacity_[arc]);
+  // The max-flow instance of the previous Solve() is kept as long as only arc
+  // capacities are modified, it then restarts from its current flow. The graph
+  // is kept as long as no arc is added, so that solving for many pairs of
+  // terminals, like in a Gomory-Hu tree computation, only builds it once.
+  if (underlying_max_flow_ == nullptr ||
+      underlying_max_flow_->GetSourceNodeIndex() != source ||
+      underlying_max_flow_->GetSinkNodeIndex() != sink) {
+    underlying_max_flow_.reset();
+    if (underlying_graph_ == nullptr) {
+      underlying_graph_ = std::make_unique<Graph>(num_nodes_, num_arcs);
+      underlying_graph_->AddNode(num_nodes_ - 1);
+      for (int arc = 0; arc < num_arcs; ++arc) {
+        underlying_graph_->AddArc(arc_tail_[arc], arc_head_[arc]);
+      }
+      underlying_graph_->Build(&arc_permutation_);
+    }
+    underlying_max_flow_ = std::make_unique<GenericMaxFlow<Graph>>(
+        underlying_graph_.get(), source, sink);
+    for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
+      ArcIndex permuted_arc =
+          arc < arc_permutation_.size() ? arc_permutation_[arc] : arc;
+      underlying_max_flow_->SetArcCapacity(permuted_arc, arc_capacity_[arc]);
+    }
   }
   if (underlying_max_flow_->Solve()) {
     optimal_flow_ = underlying_max_flow_->GetOptimalFlow();
@@ -156,6 +180,7 @@ GenericMaxFlow<Graph>::GenericMaxFlow(const Graph* graph, NodeIndex source,
       process_node_by_height_(true),
       check_input_(true),
       check_result_(true),
+      has_valid_flow_(false),
       stats_("MaxFlow") {
   SCOPED_TIME_STAT(&stats_);
   DCHECK(graph->IsNodeValid(source));
@@ -212,18 +237,99 @@ void GenericMaxFlow<Graph>::SetArcCapacity(ArcIndex arc,
            (capacity_delta < 0 && free_capacity + capacity_delta >= 0));
     residual_arc_capacity_.Set(arc, free_capacity + capacity_delta);
     DCHECK_LE(0, residual_arc_capacity_[arc]);
+  } else if (has_valid_flow_) {
+    // The flow on arc exceeds its new capacity. The tail of arc now has some
+    // flow it cannot send anymore, and the head of arc misses the same amount
+    // of incoming flow: we cancel both imbalances so that the next Solve() can
+    // restart from a valid flow.
+    const FlowQuantity flow_reduction = -(free_capacity + capacity_delta);
+    residual_arc_capacity_.Set(arc, 0);
+    residual_arc_capacity_.Set(Opposite(arc), new_capacity);
+    node_excess_[Tail(arc)] += flow_reduction;
+    node_excess_[Head(arc)] -= flow_reduction;
+    has_valid_flow_ =
+        CancelFlowImbalance(Head(arc)) && CancelFlowImbalance(Tail(arc));
   } else {
-    // Note that this breaks the preflow invariants but it is currently not an
-    // issue since we restart from scratch on each Solve() and we set the status
-    // to NOT_SOLVED.
-    //
-    // TODO(user): The easiest is probably to allow negative node excess in
-    // other places than the source, but the current implementation does not
-    // deal with this.
+    // Note that this breaks the preflow invariants but it is not an issue since
+    // we restart from scratch on the next Solve() and we set the status to
+    // NOT_SOLVED.
     SetCapacityAndClearFlow(arc, new_capacity);
   }
 }
 
+template <typename Graph>
+bool GenericMaxFlow<Graph>::CancelFlowImbalance(NodeIndex node) {
+  if (node == source_ || node == sink_) return true;
+  if (node_excess_[node] < 0) {
+    return CancelFlowImbalanceAlongFlowPaths</*downstream=*/true>(node);
+  }
+  if (node_excess_[node] > 0) {
+    return CancelFlowImbalanceAlongFlowPaths</*downstream=*/false>(node);
+  }
+  return true;
+}
+
+template <typename Graph>
+template <bool downstream>
+bool GenericMaxFlow<Graph>::CancelFlowImbalanceAlongFlowPaths(
+    NodeIndex start) {
+  SCOPED_TIME_STAT(&stats_);
+  const NodeIndex num_nodes = graph_->num_nodes();
+  bfs_parent_arc_.resize(num_nodes);
+
+  // In both directions, the flow is cancelled by pushing it along an arc whose
+  // residual capacity is the flow on its opposite arc. Going downstream, this
+  // arc goes from a node to its parent in the search, otherwise it goes from
+  // the parent to the node.
+  const auto parent = [this](ArcIndex push_arc) {
+    return downstream ? Head(push_arc) : Head(Opposite(push_arc));
+  };
+  while (downstream ? node_excess_[start] < 0 : node_excess_[start] > 0) {
+    bfs_queue_.clear();
+    node_in_bfs_queue_.assign(num_nodes, false);
+    node_in_bfs_queue_[start] = true;
+    bfs_queue_.push_back(start);
+    NodeIndex target = start;
+    for (int queue_index = 0;
+         target == start && queue_index < bfs_queue_.size(); ++queue_index) {
+      const NodeIndex node = bfs_queue_[queue_index];
+      for (OutgoingOrOppositeIncomingArcIterator it(*graph_, node); it.Ok();
+           it.Next()) {
+        const ArcIndex arc = it.Index();
+        if (IsArcDirect(arc) != downstream) continue;
+        const ArcIndex push_arc = downstream ? Opposite(arc) : arc;
+        if (residual_arc_capacity_[push_arc] == 0) continue;
+        const NodeIndex head = Head(arc);
+        if (node_in_bfs_queue_[head]) continue;
+        node_in_bfs_queue_[head] = true;
+        bfs_parent_arc_[head] = push_arc;
+        if (head == source_ || head == sink_ ||
+            (downstream ? node_excess_[head] > 0 : node_excess_[head] < 0)) {
+          target = head;
+          break;
+        }
+        bfs_queue_.push_back(head);
+      }
+    }
+    if (target == start) return false;
+
+    FlowQuantity flow = downstream ? -node_excess_[start] : node_excess_[start];
+    if (target != source_ && target != sink_) {
+      flow = std::min(flow, downstream ? node_excess_[target]
+                                       : -node_excess_[target]);
+    }
+    for (NodeIndex node = target; node != start;
+         node = parent(bfs_parent_arc_[node])) {
+      flow = std::min(flow, residual_arc_capacity_[bfs_parent_arc_[node]]);
+    }
+    for (NodeIndex node = target; node != start;
+         node = parent(bfs_parent_arc_[node])) {
+      PushFlow(flow, bfs_parent_arc_[node]);
+    }
+  }
+  return true;
+}
+
 template <typename Graph>
 void GenericMaxFlow<Graph>::SetArcFlow(ArcIndex arc, FlowQuantity new_flow) {
   SCOPED_TIME_STAT(&stats_);
@@ -233,11 +339,12 @@ void GenericMaxFlow<Graph>::SetArcFlow(ArcIndex arc, FlowQuantity new_flow) {
   DCHECK_GE(capacity, new_flow);
 
   // Note that this breaks the preflow invariants but it is currently not an
-  // issue since we restart from scratch on each Solve() and we set the status
-  // to NOT_SOLVED.
+  // issue since we restart from scratch on the next Solve() and we set the
+  // status to NOT_SOLVED.
   residual_arc_capacity_.Set(Opposite(arc), -new_flow);
   residual_arc_capacity_.Set(arc, capacity - new_flow);
   status_ = NOT_SOLVED;
+  has_valid_flow_ = false;
 }
 
 template <typename Graph>
@@ -352,11 +459,19 @@ std::string GenericMaxFlow<Graph>::DebugString(absl::string_view context,
 template <typename Graph>
 bool GenericMaxFlow<Graph>::Solve() {
   status_ = NOT_SOLVED;
+  const bool warm_start = has_valid_flow_;
+  has_valid_flow_ = false;
   if (check_input_ && !CheckInputConsistency()) {
     status_ = BAD_INPUT;
     return false;
   }
-  InitializePreflow();
+  if (warm_start) {
+    // The flow of the previous Solve() is still valid, only the node
+    // potentials need to be recomputed from it.
+    ResetNodePotentials();
+  } else {
+    InitializePreflow();
+  }
 
   // Deal with the case when source_ or sink_ is not inside graph_.
   // Since they are both specified independently of the graph, we do need to
@@ -364,7 +479,8 @@ bool GenericMaxFlow<Graph>::Solve() {
   const NodeIndex num_nodes = graph_->num_nodes();
   if (sink_ >= num_nodes || source_ >= num_nodes) {
     // Behave like a normal graph where source_ and sink_ are disconnected.
-    // Note that the arc flow is set to 0 by InitializePreflow().
+    // Note that the arc flow is set to 0 by InitializePreflow(), and that no
+    // arc can carry any flow in the warm start case.
     status_ = OPTIMAL;
     return true;
   }
@@ -390,6 +506,7 @@ bool GenericMaxFlow<Graph>::Solve() {
     // In this case, we are sure that the flow is > kMaxFlowQuantity.
     status_ = INT_OVERFLOW;
   }
+  has_valid_flow_ = status_ == OPTIMAL;
   IF_STATS_ENABLED(VLOG(1) << stats_.StatString());
   return true;
 }
@@ -398,15 +515,19 @@ template <typename Graph>
 void GenericMaxFlow<Graph>::InitializePreflow() {
   SCOPED_TIME_STAT(&stats_);
   // InitializePreflow() clears the whole flow that could have been computed
-  // by a previous Solve(). This is not optimal in terms of complexity.
-  // TODO(user): find a way to make the re-solving incremental (not an obvious
-  // task, and there has not been a lot of literature on the subject.)
+  // by a previous Solve(). This is only needed when this flow is not valid
+  // anymore, otherwise Solve() only calls ResetNodePotentials().
   node_excess_.SetAll(0);
   const ArcIndex num_arcs = graph_->num_arcs();
   for (ArcIndex arc = 0; arc < num_arcs; ++arc) {
     SetCapacityAndClearFlow(arc, Capacity(arc));
   }
+  ResetNodePotentials();
+}
 
+template <typename Graph>
+void GenericMaxFlow<Graph>::ResetNodePotentials() {
+  SCOPED_TIME_STAT(&stats_);
   // All the initial heights are zero except for the source whose height is
   // equal to the number of nodes and will never change during the algorithm.
   node_potential_.SetAll(0);
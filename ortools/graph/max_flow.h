@@ -147,7 +147,9 @@ class GenericMaxFlow;
 // more memory in order to hide the somewhat involved construction of the
 // static graph.
 //
-// TODO(user): If the need arises, extend this interface to support warm start.
+// Calling Solve() again with the same source and sink after only changing some
+// arc capacities with SetArcCapacity() restarts from the previous flow instead
+// of from scratch. Adding an arc always triggers a full solve.
 class SimpleMaxFlow {
  public:
   // The constructor takes no size.
@@ -223,11 +225,10 @@ class SimpleMaxFlow {
   // This works only if Solve() returned OPTIMAL.
   void GetSinkSideMinCut(std::vector<NodeIndex>* result);
 
-  // Change the capacity of an arc.
-  //
-  // WARNING: This looks like it enables incremental solves, but as of 2018-02,
-  // the next Solve() will restart from scratch anyway.
-  // TODO(user): Support incrementality in the max flow implementation.
+  // Change the capacity of an arc. After a successful Solve(), the next Solve()
+  // with the same source and sink starts from the previous flow, which is only
+  // repaired around the arcs whose capacity was reduced below their flow. A
+  // Solve() with other terminals starts from scratch, but on the same graph.
   void SetArcCapacity(ArcIndex arc, FlowQuantity capacity);
 
   // Creates the protocol buffer representation of the current problem.
@@ -364,10 +365,13 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   // Returns the index of the node corresponding to the sink of the network.
   NodeIndex GetSinkNodeIndex() const { return sink_; }
 
-  // Sets the capacity for arc to new_capacity.
+  // Sets the capacity for arc to new_capacity. If the last Solve() was
+  // successful and the new capacity is smaller than the flow on arc, the
+  // difference is cancelled along the flow paths that went through arc, so
+  // that the next Solve() can restart from the current flow.
   void SetArcCapacity(ArcIndex arc, FlowQuantity new_capacity);
 
-  // Sets the flow for arc.
+  // Sets the flow for arc. The next Solve() will restart from scratch.
   void SetArcFlow(ArcIndex arc, FlowQuantity new_flow);
 
   // Returns true if a maximum flow was solved.
@@ -509,6 +513,24 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   // Initializes the preflow to a state that enables to run Refine.
   void InitializePreflow();
 
+  // Resets the node potentials and the first admissible arcs so that Refine
+  // can be run from the current flow, see InitializePreflow().
+  void ResetNodePotentials();
+
+  // Cancels the flow excess (or deficit) of node, which must not be the source
+  // or the sink, along paths of arcs carrying some flow. Returns false if this
+  // was not possible, which can only happen if the current flow is not valid.
+  bool CancelFlowImbalance(NodeIndex node);
+
+  // Does the work of CancelFlowImbalance() for a node with a deficit (when
+  // downstream is true), or with an excess. Each iteration looks for a path
+  // from start to a node that can absorb the imbalance (the source, the sink
+  // or a node with an opposite imbalance) with a breadth-first search that
+  // follows the arcs carrying some flow (downstream) or goes against them, and
+  // cancels as much flow as possible along it.
+  template <bool downstream>
+  bool CancelFlowImbalanceAlongFlowPaths(NodeIndex start);
+
   // Clears the flow excess at each node by pushing the flow back to the source:
   // - Do a depth-first search from the source in the direct graph to cancel
   //   flow cycles.
@@ -626,6 +648,10 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   std::vector<bool> node_in_bfs_queue_;
   std::vector<NodeIndex> bfs_queue_;
 
+  // For each node reached by CancelFlowImbalanceAlongFlowPaths(), the arc along
+  // which the flow is cancelled to reach it.
+  std::vector<ArcIndex> bfs_parent_arc_;
+
   // Whether or not to use GlobalUpdate().
   bool use_global_update_;
 
@@ -653,6 +679,11 @@ class GenericMaxFlow : public MaxFlowStatusClass {
   // TODO(user): Make the check more exhaustive by checking the optimality?
   bool check_result_;
 
+  // Whether residual_arc_capacity_ and node_excess_ hold a valid flow, i.e. one
+  // from the last successful Solve() only modified by SetArcCapacity(). In
+  // this case the next Solve() restarts from this flow.
+  bool has_valid_flow_;
+
   // Statistics about this class.
   mutable StatsGroup stats_;
 };
@@ -131,6 +131,53 @@ TEST(SimpleMaxFlowTest, SetArcCapacity) {
   EXPECT_EQ(25, max_flow.OptimalFlow());
 }
 
+TEST(SimpleMaxFlowTest, IncrementalSolveAfterCapacityReductions) {
+  SimpleMaxFlow max_flow;
+  // Same graph as above.
+  max_flow.AddArcWithCapacity(0, 1, 10);
+  const int arc02 = max_flow.AddArcWithCapacity(0, 2, 15);
+  max_flow.AddArcWithCapacity(2, 1, 3);
+  max_flow.AddArcWithCapacity(2, 3, 10);
+  const int arc13 = max_flow.AddArcWithCapacity(1, 3, 15);
+  EXPECT_EQ(SimpleMaxFlow::OPTIMAL, max_flow.Solve(0, 3));
+  EXPECT_EQ(23, max_flow.OptimalFlow());
+
+  // Reduce the capacities of arcs carrying some flow, then restore them.
+  const auto check_flow = [&max_flow]() {
+    std::vector<FlowQuantity> node_excess(max_flow.NumNodes(), 0);
+    for (int arc = 0; arc < max_flow.NumArcs(); ++arc) {
+      EXPECT_LE(0, max_flow.Flow(arc));
+      EXPECT_LE(max_flow.Flow(arc), max_flow.Capacity(arc));
+      node_excess[max_flow.Tail(arc)] -= max_flow.Flow(arc);
+      node_excess[max_flow.Head(arc)] += max_flow.Flow(arc);
+    }
+    EXPECT_EQ(-max_flow.OptimalFlow(), node_excess[0]);
+    EXPECT_EQ(0, node_excess[1]);
+    EXPECT_EQ(0, node_excess[2]);
+    EXPECT_EQ(max_flow.OptimalFlow(), node_excess[3]);
+  };
+  max_flow.SetArcCapacity(arc13, 5);
+  EXPECT_EQ(SimpleMaxFlow::OPTIMAL, max_flow.Solve(0, 3));
+  EXPECT_EQ(15, max_flow.OptimalFlow());
+  check_flow();
+  max_flow.SetArcCapacity(arc02, 4);
+  EXPECT_EQ(SimpleMaxFlow::OPTIMAL, max_flow.Solve(0, 3));
+  EXPECT_EQ(9, max_flow.OptimalFlow());
+  check_flow();
+  max_flow.SetArcCapacity(arc13, 15);
+  max_flow.SetArcCapacity(arc02, 15);
+  EXPECT_EQ(SimpleMaxFlow::OPTIMAL, max_flow.Solve(0, 3));
+  EXPECT_EQ(23, max_flow.OptimalFlow());
+  check_flow();
+
+  // Changing the source or the sink restarts from scratch.
+  EXPECT_EQ(SimpleMaxFlow::OPTIMAL, max_flow.Solve(0, 1));
+  EXPECT_EQ(13, max_flow.OptimalFlow());
+  EXPECT_EQ(SimpleMaxFlow::OPTIMAL, max_flow.Solve(0, 3));
+  EXPECT_EQ(23, max_flow.OptimalFlow());
+  check_flow();
+}
+
 SimpleMaxFlow::Status LoadAndSolveFlowModel(const FlowModelProto& model,
                                             SimpleMaxFlow* solver) {
   for (int a = 0; a < model.arcs_size(); ++a) {
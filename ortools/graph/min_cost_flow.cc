@@ -29,6 +29,7 @@
 #include "ortools/graph/graph.h"
 #include "ortools/graph/graphs.h"
 #include "ortools/graph/max_flow.h"
+#include "ortools/graph/network_simplex.h"
 #include "ortools/util/saturated_arithmetic.h"
 
 // TODO(user): Remove these flags and expose the parameters in the API.
@@ -74,7 +75,7 @@ template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetNodeSupply(
     NodeIndex node, FlowQuantity supply) {
   DCHECK(graph_->IsNodeValid(node));
-  node_excess_[node] = supply;
+  node_excess_[node] += supply - initial_node_excess_[node];
   initial_node_excess_[node] = supply;
   status_ = NOT_SOLVED;
   feasibility_checked_ = false;
@@ -133,6 +134,9 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::SetArcFlow(
   DCHECK(IsArcValid(arc));
   const FlowQuantity capacity = Capacity(arc);
   DCHECK_GE(capacity, new_flow);
+  const FlowQuantity flow_delta = new_flow - Flow(arc);
+  node_excess_[Tail(arc)] -= flow_delta;
+  node_excess_[Head(arc)] += flow_delta;
   residual_arc_capacity_.Set(Opposite(arc), new_flow);
   residual_arc_capacity_.Set(arc, capacity - new_flow);
   status_ = NOT_SOLVED;
@@ -342,7 +346,7 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::MakeFeasible() {
   }
   for (NodeIndex node = 0; node < graph_->num_nodes(); ++node) {
     const FlowQuantity excess = feasible_node_excess_[node];
-    node_excess_[node] = excess;
+    node_excess_[node] += excess - initial_node_excess_[node];
     initial_node_excess_[node] = excess;
   }
   return true;
@@ -462,9 +466,15 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
   }
 
   status_ = NOT_SOLVED;
-  node_potential_.assign(node_potential_.size(), 0);
+  const CostValue previous_scaling_factor = potential_scaling_factor_;
+  potential_scaling_factor_ = 0;
   ResetFirstAdmissibleArcs();
   if (!ScaleCosts()) return false;
+  if (warm_start_ && previous_scaling_factor == cost_scaling_factor_) {
+    InitializeWarmStart();
+  } else {
+    node_potential_.assign(node_potential_.size(), 0);
+  }
   if (!Optimize()) return false;
   DCHECK_EQ(status_, NOT_SOLVED);
   status_ = OPTIMAL;
@@ -474,6 +484,7 @@ bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Solve() {
     UnscaleCosts();
     return false;
   }
+  potential_scaling_factor_ = cost_scaling_factor_;
   UnscaleCosts();
 
   IF_STATS_ENABLED(VLOG(1) << stats_.StatString());
@@ -555,6 +566,39 @@ void GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::UnscaleCosts() {
   cost_scaling_factor_ = 1;
 }
 
+template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
+void GenericMinCostFlow<Graph, ArcFlowType,
+                        ArcScaledCostType>::InitializeWarmStart() {
+  SCOPED_TIME_STAT(&stats_);
+  // The potentials only decrease during the algorithm. Shifting them so that
+  // the largest one is zero does not change any reduced cost, but keeps them
+  // far from overflow_threshold_ over many successive solves.
+  const NodeIndex num_nodes = graph_->num_nodes();
+  CostValue max_potential = std::numeric_limits<CostValue>::min();
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    max_potential = std::max(max_potential, node_potential_[node]);
+  }
+  for (NodeIndex node = 0; node < num_nodes; ++node) {
+    node_potential_[node] -= max_potential;
+  }
+
+  // The current flow is epsilon-optimal for the largest negative reduced cost
+  // of an arc with some residual capacity. This is usually 1 (the precision of
+  // the previous Solve()), unless some capacities or costs changed.
+  CostValue max_violation = 1;
+  for (ArcIndex arc = 0; arc < graph_->num_arcs(); ++arc) {
+    for (const ArcIndex a : {arc, Opposite(arc)}) {
+      if (residual_arc_capacity_[a] > 0) {
+        max_violation = std::max(max_violation, -ReducedCost(a));
+      }
+    }
+  }
+
+  // Optimize() divides epsilon_ by alpha_ before the first Refine().
+  epsilon_ = std::min(epsilon_, CapProd(max_violation, alpha_));
+  VLOG(3) << "Warm start epsilon = " << epsilon_;
+}
+
 template <typename Graph, typename ArcFlowType, typename ArcScaledCostType>
 bool GenericMinCostFlow<Graph, ArcFlowType, ArcScaledCostType>::Optimize() {
   const CostValue kEpsilonMin = 1LL;
@@ -1143,34 +1187,43 @@ SimpleMinCostFlow::Status SimpleMinCostFlow::SolveWithPossibleAdjustment(
     return INFEASIBLE;
   }
 
-  GenericMinCostFlow<Graph> min_cost_flow(&graph);
-  ArcIndex arc;
-  for (arc = 0; arc < num_arcs; ++arc) {
-    ArcIndex permuted_arc = PermutedArc(arc);
-    min_cost_flow.SetArcUnitCost(permuted_arc, arc_cost_[arc]);
-    min_cost_flow.SetArcCapacity(permuted_arc, arc_capacity_[arc]);
-  }
-  for (NodeIndex node = 0; node < num_nodes; ++node) {
-    if (node_supply_[node] != 0) {
+  // Both algorithms share the same interface to load and solve the problem.
+  const auto solve = [&](auto& min_cost_flow) {
+    ArcIndex arc;
+    for (arc = 0; arc < num_arcs; ++arc) {
       ArcIndex permuted_arc = PermutedArc(arc);
-      min_cost_flow.SetArcCapacity(permuted_arc, std::abs(node_supply_[node]));
-      min_cost_flow.SetArcUnitCost(permuted_arc, 0);
-      ++arc;
+      min_cost_flow.SetArcUnitCost(permuted_arc, arc_cost_[arc]);
+      min_cost_flow.SetArcCapacity(permuted_arc, arc_capacity_[arc]);
     }
+    for (NodeIndex node = 0; node < num_nodes; ++node) {
+      if (node_supply_[node] != 0) {
+        ArcIndex permuted_arc = PermutedArc(arc);
+        min_cost_flow.SetArcCapacity(permuted_arc,
+                                     std::abs(node_supply_[node]));
+        min_cost_flow.SetArcUnitCost(permuted_arc, 0);
+        ++arc;
+      }
+    }
+    min_cost_flow.SetNodeSupply(source, maximum_flow_);
+    min_cost_flow.SetNodeSupply(sink, -maximum_flow_);
+
+    arc_flow_.resize(num_arcs);
+    if (min_cost_flow.Solve()) {
+      optimal_cost_ = min_cost_flow.GetOptimalCost();
+      for (arc = 0; arc < num_arcs; ++arc) {
+        arc_flow_[arc] = min_cost_flow.Flow(PermutedArc(arc));
+      }
+    }
+    return min_cost_flow.status();
+  };
+  if (algorithm_ == NETWORK_SIMPLEX) {
+    GenericNetworkSimplex<Graph> network_simplex(&graph);
+    return solve(network_simplex);
   }
-  min_cost_flow.SetNodeSupply(source, maximum_flow_);
-  min_cost_flow.SetNodeSupply(sink, -maximum_flow_);
+  GenericMinCostFlow<Graph> min_cost_flow(&graph);
   min_cost_flow.SetCheckFeasibility(false);
   min_cost_flow.SetPriceScaling(scale_prices_);
-
-  arc_flow_.resize(num_arcs);
-  if (min_cost_flow.Solve()) {
-    optimal_cost_ = min_cost_flow.GetOptimalCost();
-    for (arc = 0; arc < num_arcs; ++arc) {
-      arc_flow_[arc] = min_cost_flow.Flow(PermutedArc(arc));
-    }
-  }
-  return min_cost_flow.status();
+  return solve(min_cost_flow);
 }
 
 CostValue SimpleMinCostFlow::OptimalCost() const { return optimal_cost_; }
@@ -331,6 +331,19 @@ class SimpleMinCostFlow : public MinCostFlowBase {
   // unit cost of some arc as been changed by at most 1 / scaling_factor.
   void SetPriceScaling(bool value) { scale_prices_ = value; }
 
+  // The algorithm used to compute the min-cost flow once the feasibility of
+  // the problem has been checked with a max-flow.
+  enum Algorithm {
+    // The cost-scaling push-relabel algorithm of GenericMinCostFlow. This is
+    // the default.
+    COST_SCALING,
+    // The network simplex algorithm of GenericNetworkSimplex, which is often
+    // faster on sparse graphs with a small cost range. It always returns an
+    // optimal solution, SetPriceScaling() has no effect with it.
+    NETWORK_SIMPLEX,
+  };
+  void SetAlgorithm(Algorithm algorithm) { algorithm_ = algorithm; }
+
  private:
   typedef ::util::ReverseArcStaticGraph<NodeIndex, ArcIndex> Graph;
   enum SupplyAdjustment { ADJUST, DONT_ADJUST };
@@ -353,6 +366,7 @@ class SimpleMinCostFlow : public MinCostFlowBase {
   FlowQuantity maximum_flow_;
 
   bool scale_prices_ = true;
+  Algorithm algorithm_ = COST_SCALING;
 };
 
 // Generic MinCostFlow that works with StarGraph and all the graphs handling
@@ -404,7 +418,8 @@ class GenericMinCostFlow : public MinCostFlowBase {
   Status status() const { return status_; }
 
   // Sets the supply corresponding to node. A demand is modeled as a negative
-  // supply.
+  // supply. The excess of node changes by the difference with its previous
+  // supply, so that the flow of a previous Solve() stays consistent.
   void SetNodeSupply(NodeIndex node, FlowQuantity supply);
 
   // Sets the unit cost for the given arc.
@@ -413,8 +428,9 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Sets the capacity for the given arc.
   void SetArcCapacity(ArcIndex arc, ArcFlowType new_capacity);
 
-  // Sets the flow for the given arc. Note that new_flow must be smaller than
-  // the capacity of the arc.
+  // Sets the flow for the given arc and updates the excesses of its ends
+  // accordingly. Note that new_flow must be smaller than the capacity of the
+  // arc.
   void SetArcFlow(ArcIndex arc, ArcFlowType new_flow);
 
   // Solves the problem, returning true if a min-cost flow could be found.
@@ -480,6 +496,15 @@ class GenericMinCostFlow : public MinCostFlowBase {
   void SetUseUpdatePrices(bool value) { use_price_update_ = value; }
   void SetPriceScaling(bool value) { scale_prices_ = value; }
 
+  // Whether Solve() restarts from the node potentials of the previous
+  // successful Solve() rather than from zero potentials. The flow of the
+  // previous Solve() is always kept, so after small changes of the supplies,
+  // capacities or costs, only a few refine steps are needed, starting from an
+  // epsilon equal to the largest violation of the optimality conditions. Note
+  // that the cost scaling complexity bound does not hold anymore when the
+  // problem changed a lot since the previous Solve().
+  void SetWarmStart(bool value) { warm_start_ = value; }
+
  private:
   // Returns true if the given arc is admissible i.e. if its residual capacity
   // is strictly positive, and its reduced cost strictly negative, i.e., pushing
@@ -528,6 +553,11 @@ class GenericMinCostFlow : public MinCostFlowBase {
   // Unscales the costs, by dividing them by (graph_->num_nodes() + 1).
   void UnscaleCosts();
 
+  // Prepares the node potentials of the previous Solve() for a new one, and
+  // lowers epsilon_ to the largest violation of the optimality conditions by
+  // the current flow. Must be called after ScaleCosts().
+  void InitializeWarmStart();
+
   // Optimizes the cost by dividing epsilon_ by alpha_ and calling Refine().
   // Returns false on integer overflow.
   bool Optimize();
@@ -666,6 +696,13 @@ class GenericMinCostFlow : public MinCostFlowBase {
 
   // Whether to scale prices, see SimpleMinCostFlow::SetPriceScaling().
   bool scale_prices_ = true;
+
+  // Whether to restart from the previous node potentials, see SetWarmStart().
+  bool warm_start_ = false;
+
+  // The cost scaling factor of the node potentials found by the last
+  // successful Solve(), or 0 if they cannot be reused.
+  CostValue potential_scaling_factor_ = 0;
 };
 
 #if !SWIG
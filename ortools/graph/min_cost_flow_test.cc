@@ -28,6 +28,7 @@
 #include "ortools/algorithms/binary_search.h"
 #include "ortools/graph/graph.h"
 #include "ortools/graph/graphs.h"
+#include "ortools/graph/network_simplex.h"
 #include "ortools/linear_solver/linear_solver.h"
 
 namespace operations_research {
@@ -284,6 +285,55 @@ TYPED_TEST(GenericMinCostFlowTest, TotalFlowCostOverflow) {
       kExpectedFlowCost, kExpectedFlow, GenericMinCostFlow<TypeParam>::OPTIMAL);
 }
 
+TYPED_TEST(GenericMinCostFlowTest, WarmStartAfterSupplyChanges) {
+  const int kNumNodes = 7;
+  const int kNumArcs = 12;
+  const NodeIndex kTail[kNumArcs] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2};
+  const NodeIndex kHead[kNumArcs] = {3, 4, 5, 6, 3, 4, 5, 6, 3, 4, 5, 6};
+  const CostValue kCost[kNumArcs] = {1, 6, 3, 5, 7, 3, 1, 6, 9, 4, 5, 3};
+  const FlowQuantity kNodeSupply[][kNumNodes] = {
+      {20, 10, 25, -11, -13, -17, -14},
+      {15, 20, 20, -16, -13, -12, -14},
+      {30, 5, 20, -5, -20, -10, -20}};
+  TypeParam graph(kNumNodes, kNumArcs);
+  for (int arc = 0; arc < kNumArcs; ++arc) {
+    graph.AddArc(kTail[arc], kHead[arc]);
+  }
+  std::vector<ArcIndex> permutation;
+  Graphs<TypeParam>::Build(&graph, &permutation);
+  EXPECT_TRUE(permutation.empty());
+
+  const auto set_arcs = [&](GenericMinCostFlow<TypeParam>* min_cost_flow) {
+    for (int arc = 0; arc < kNumArcs; ++arc) {
+      min_cost_flow->SetArcUnitCost(arc, kCost[arc]);
+      min_cost_flow->SetArcCapacity(arc, 20);
+    }
+  };
+  GenericMinCostFlow<TypeParam> warm_min_cost_flow(&graph);
+  warm_min_cost_flow.SetWarmStart(true);
+  set_arcs(&warm_min_cost_flow);
+  for (const auto& supply : kNodeSupply) {
+    GenericMinCostFlow<TypeParam> min_cost_flow(&graph);
+    set_arcs(&min_cost_flow);
+    for (NodeIndex node = 0; node < kNumNodes; ++node) {
+      min_cost_flow.SetNodeSupply(node, supply[node]);
+      warm_min_cost_flow.SetNodeSupply(node, supply[node]);
+    }
+    EXPECT_TRUE(min_cost_flow.Solve());
+    EXPECT_TRUE(warm_min_cost_flow.Solve());
+    EXPECT_EQ(min_cost_flow.GetOptimalCost(),
+              warm_min_cost_flow.GetOptimalCost());
+    std::vector<FlowQuantity> net_outflow(kNumNodes, 0);
+    for (int arc = 0; arc < kNumArcs; ++arc) {
+      net_outflow[kTail[arc]] += warm_min_cost_flow.Flow(arc);
+      net_outflow[kHead[arc]] -= warm_min_cost_flow.Flow(arc);
+    }
+    for (NodeIndex node = 0; node < kNumNodes; ++node) {
+      EXPECT_EQ(supply[node], net_outflow[node]) << "at node " << node;
+    }
+  }
+}
+
 TEST(GenericMinCostFlowTest, OverflowPrevention1) {
   util::ReverseArcListGraph<> graph;
   const int arc = graph.AddArc(0, 1);
@@ -452,6 +502,81 @@ TEST(SimpleMinCostFlowTest, InfeasibleProblem) {
   }
 }
 
+TEST(SimpleMinCostFlowTest, NetworkSimplexMatchesCostScaling) {
+  std::mt19937 random(12345);
+  const int kNumNodes = 30;
+  const int kNumArcs = 150;
+  for (int trial = 0; trial < 50; ++trial) {
+    SimpleMinCostFlow cost_scaling;
+    SimpleMinCostFlow network_simplex;
+    network_simplex.SetAlgorithm(SimpleMinCostFlow::NETWORK_SIMPLEX);
+    for (int arc = 0; arc < kNumArcs; ++arc) {
+      const NodeIndex tail = absl::Uniform(random, 0, kNumNodes);
+      const NodeIndex head = absl::Uniform(random, 0, kNumNodes);
+      const FlowQuantity capacity = absl::Uniform(random, 0, 20);
+      const CostValue cost = absl::Uniform(random, -10, 50);
+      cost_scaling.AddArcWithCapacityAndUnitCost(tail, head, capacity, cost);
+      network_simplex.AddArcWithCapacityAndUnitCost(tail, head, capacity, cost);
+    }
+    FlowQuantity total_supply = 0;
+    for (NodeIndex node = 0; node + 1 < kNumNodes; ++node) {
+      const FlowQuantity supply = absl::Uniform(random, -10, 11);
+      total_supply += supply;
+      cost_scaling.SetNodeSupply(node, supply);
+      network_simplex.SetNodeSupply(node, supply);
+    }
+    cost_scaling.SetNodeSupply(kNumNodes - 1, -total_supply);
+    network_simplex.SetNodeSupply(kNumNodes - 1, -total_supply);
+
+    const SimpleMinCostFlow::Status status = cost_scaling.Solve();
+    ASSERT_EQ(status, network_simplex.Solve());
+    if (status == SimpleMinCostFlow::OPTIMAL) {
+      EXPECT_EQ(cost_scaling.OptimalCost(), network_simplex.OptimalCost());
+    }
+    ASSERT_EQ(SimpleMinCostFlow::OPTIMAL,
+              cost_scaling.SolveMaxFlowWithMinCost());
+    ASSERT_EQ(SimpleMinCostFlow::OPTIMAL,
+              network_simplex.SolveMaxFlowWithMinCost());
+    EXPECT_EQ(cost_scaling.MaximumFlow(), network_simplex.MaximumFlow());
+    EXPECT_EQ(cost_scaling.OptimalCost(), network_simplex.OptimalCost());
+  }
+}
+
+TEST(SimpleMinCostFlowTest, NetworkSimplexUnbalanced) {
+  SimpleMinCostFlow min_cost_flow;
+  min_cost_flow.SetAlgorithm(SimpleMinCostFlow::NETWORK_SIMPLEX);
+  min_cost_flow.AddArcWithCapacityAndUnitCost(0, 1, 10, 1);
+  min_cost_flow.SetNodeSupply(0, 5);
+  min_cost_flow.SetNodeSupply(1, -4);
+  EXPECT_EQ(SimpleMinCostFlow::UNBALANCED, min_cost_flow.Solve());
+}
+
+TEST(GenericNetworkSimplexTest, WarmStartAfterCostChanges) {
+  // Two parallel paths from 0 to 3, the cheapest one changes.
+  util::ReverseArcListGraph<> graph(4, 4);
+  graph.AddArc(0, 1);
+  graph.AddArc(1, 3);
+  graph.AddArc(0, 2);
+  graph.AddArc(2, 3);
+  GenericNetworkSimplex<util::ReverseArcListGraph<>> network_simplex(&graph);
+  for (int arc = 0; arc < 4; ++arc) {
+    network_simplex.SetArcCapacity(arc, 10);
+    network_simplex.SetArcUnitCost(arc, arc < 2 ? 1 : 2);
+  }
+  network_simplex.SetNodeSupply(0, 15);
+  network_simplex.SetNodeSupply(3, -15);
+  ASSERT_TRUE(network_simplex.Solve());
+  EXPECT_EQ(10 * 2 + 5 * 4, network_simplex.GetOptimalCost());
+  EXPECT_EQ(10, network_simplex.Flow(0));
+
+  network_simplex.SetArcUnitCost(0, 5);
+  ASSERT_TRUE(network_simplex.Solve());
+  EXPECT_EQ(MinCostFlowBase::OPTIMAL, network_simplex.status());
+  EXPECT_EQ(5 * 6 + 10 * 4, network_simplex.GetOptimalCost());
+  EXPECT_EQ(5, network_simplex.Flow(0));
+  EXPECT_EQ(10, network_simplex.Flow(2));
+}
+
 // Create a single path graph with large arc unit cost.
 // Note that the capacity does not directly influence the max usable cost.
 TEST(SimpleMinCostFlowTest, OverflowCostBound) {
@@ -0,0 +1,419 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/graph/network_simplex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ortools/base/logging.h"
+#include "ortools/graph/graph.h"
+#include "ortools/util/saturated_arithmetic.h"
+#include "ortools/util/stats.h"
+
+namespace operations_research {
+
+namespace {
+// Marks the end of a children list of the tree.
+constexpr int kNoNode = -1;
+
+// The minimum number of arcs scanned by each block of the pivot rule.
+constexpr int kMinBlockSize = 10;
+}  // namespace
+
+template <typename Graph>
+GenericNetworkSimplex<Graph>::GenericNetworkSimplex(const Graph* graph)
+    : graph_(graph), stats_("NetworkSimplex") {
+  node_supply_.assign(graph_->num_nodes(), 0);
+  arc_capacity_.assign(graph_->num_arcs(), 0);
+  arc_unit_cost_.assign(graph_->num_arcs(), 0);
+  arc_flow_.assign(graph_->num_arcs(), 0);
+}
+
+template <typename Graph>
+void GenericNetworkSimplex<Graph>::SetNodeSupply(NodeIndex node,
+                                                 FlowQuantity supply) {
+  DCHECK(graph_->IsNodeValid(node));
+  node_supply_[node] = supply;
+  has_feasible_tree_ = false;
+  status_ = NOT_SOLVED;
+}
+
+template <typename Graph>
+void GenericNetworkSimplex<Graph>::SetArcUnitCost(ArcIndex arc,
+                                                  CostValue unit_cost) {
+  DCHECK(graph_->IsArcValid(arc));
+  arc_unit_cost_[arc] = unit_cost;
+  status_ = NOT_SOLVED;
+}
+
+template <typename Graph>
+void GenericNetworkSimplex<Graph>::SetArcCapacity(ArcIndex arc,
+                                                  FlowQuantity capacity) {
+  DCHECK(graph_->IsArcValid(arc));
+  DCHECK_LE(0, capacity);
+  arc_capacity_[arc] = capacity;
+  has_feasible_tree_ = false;
+  status_ = NOT_SOLVED;
+}
+
+template <typename Graph>
+bool GenericNetworkSimplex<Graph>::Solve() {
+  SCOPED_TIME_STAT(&stats_);
+  status_ = NOT_SOLVED;
+  num_pivots_ = 0;
+  FlowQuantity total_supply = 0;
+  for (const FlowQuantity supply : node_supply_) {
+    total_supply = CapAdd(total_supply, supply);
+  }
+  const bool warm_start = has_feasible_tree_;
+  has_feasible_tree_ = false;
+  if (total_supply != 0) {
+    status_ = UNBALANCED;
+    return false;
+  }
+  if (!(warm_start ? UpdateTreePotentials() : InitializeTree())) {
+    status_ = BAD_COST_RANGE;
+    return false;
+  }
+  while (FindEnteringArc()) {
+    Pivot();
+    ++num_pivots_;
+  }
+  VLOG(1) << "Network simplex: " << num_pivots_ << " pivots.";
+
+  // With a feasible problem, the artificial arcs end up without any flow
+  // because their cost is larger than the cost of any path.
+  for (NodeIndex node = 0; node < num_nodes_; ++node) {
+    if (arc_flow_[num_arcs_ + node] != 0) {
+      status_ = INFEASIBLE;
+      return false;
+    }
+  }
+  status_ = OPTIMAL;
+  has_feasible_tree_ = true;
+  IF_STATS_ENABLED(VLOG(1) << stats_.StatString());
+  return true;
+}
+
+template <typename Graph>
+CostValue GenericNetworkSimplex<Graph>::GetOptimalCost() const {
+  if (status_ != OPTIMAL) return 0;
+  const CostValue kMaxCost = std::numeric_limits<CostValue>::max();
+  const CostValue kMinCost = std::numeric_limits<CostValue>::min();
+  CostValue total_flow_cost = 0;
+  for (ArcIndex arc = 0; arc < num_arcs_; ++arc) {
+    const CostValue flow_cost = CapProd(arc_unit_cost_[arc], arc_flow_[arc]);
+    if (flow_cost == kMaxCost || flow_cost == kMinCost) return kMaxCost;
+    total_flow_cost = CapAdd(flow_cost, total_flow_cost);
+    if (total_flow_cost == kMaxCost || total_flow_cost == kMinCost) {
+      return kMaxCost;
+    }
+  }
+  return total_flow_cost;
+}
+
+template <typename Graph>
+bool GenericNetworkSimplex<Graph>::InitializeTree() {
+  SCOPED_TIME_STAT(&stats_);
+  num_nodes_ = graph_->num_nodes();
+  num_arcs_ = graph_->num_arcs();
+  root_ = num_nodes_;
+  const ArcIndex num_all_arcs = num_arcs_ + num_nodes_;
+  tail_.resize(num_all_arcs);
+  head_.resize(num_all_arcs);
+  cap_.resize(num_all_arcs);
+  arc_cost_.resize(num_all_arcs);
+  arc_flow_.assign(num_all_arcs, 0);
+  arc_state_.resize(num_all_arcs);
+  for (ArcIndex arc = 0; arc < num_arcs_; ++arc) {
+    tail_[arc] = graph_->Tail(arc);
+    head_[arc] = graph_->Head(arc);
+    cap_[arc] = arc_capacity_[arc];
+    arc_cost_[arc] = arc_unit_cost_[arc];
+    arc_state_[arc] = STATE_LOWER;
+  }
+  if (!ComputeArtificialCost()) return false;
+
+  // Each node starts as a child of the root. Its artificial arc goes towards
+  // the root for a supply, and away from it for a demand, so that flow can
+  // always be sent from any node to the root along the tree: the initial tree
+  // is strongly feasible.
+  const NodeIndex num_tree_nodes = num_nodes_ + 1;
+  parent_.assign(num_tree_nodes, kNoNode);
+  parent_arc_.assign(num_tree_nodes, 0);
+  first_child_.assign(num_tree_nodes, kNoNode);
+  next_sibling_.assign(num_tree_nodes, kNoNode);
+  previous_sibling_.assign(num_tree_nodes, kNoNode);
+  node_potential_.assign(num_tree_nodes, 0);
+  node_mark_.assign(num_tree_nodes, 0);
+  current_mark_ = 0;
+  for (NodeIndex node = 0; node < num_nodes_; ++node) {
+    const ArcIndex arc = num_arcs_ + node;
+    const FlowQuantity supply = node_supply_[node];
+    cap_[arc] = std::numeric_limits<FlowQuantity>::max();
+    arc_state_[arc] = STATE_TREE;
+    if (supply >= 0) {
+      tail_[arc] = node;
+      head_[arc] = root_;
+      arc_flow_[arc] = supply;
+      node_potential_[node] = -artificial_cost_;
+    } else {
+      tail_[arc] = root_;
+      head_[arc] = node;
+      arc_flow_[arc] = -supply;
+      node_potential_[node] = artificial_cost_;
+    }
+    parent_[node] = root_;
+    parent_arc_[node] = arc;
+    AddChild(root_, node);
+  }
+  block_size_ = std::max<ArcIndex>(
+      kMinBlockSize, static_cast<ArcIndex>(std::sqrt(num_arcs_)));
+  next_arc_ = 0;
+  return true;
+}
+
+template <typename Graph>
+bool GenericNetworkSimplex<Graph>::UpdateTreePotentials() {
+  SCOPED_TIME_STAT(&stats_);
+  for (ArcIndex arc = 0; arc < num_arcs_; ++arc) {
+    arc_cost_[arc] = arc_unit_cost_[arc];
+  }
+  if (!ComputeArtificialCost()) return false;
+
+  // The reduced cost of each tree arc must be zero.
+  node_potential_[root_] = 0;
+  dfs_stack_.assign(1, root_);
+  while (!dfs_stack_.empty()) {
+    const NodeIndex node = dfs_stack_.back();
+    dfs_stack_.pop_back();
+    for (NodeIndex child = first_child_[node]; child != kNoNode;
+         child = next_sibling_[child]) {
+      const ArcIndex arc = parent_arc_[child];
+      node_potential_[child] = tail_[arc] == child
+                                   ? node_potential_[node] - arc_cost_[arc]
+                                   : node_potential_[node] + arc_cost_[arc];
+      dfs_stack_.push_back(child);
+    }
+  }
+  return true;
+}
+
+template <typename Graph>
+bool GenericNetworkSimplex<Graph>::ComputeArtificialCost() {
+  // A potential is the cost of an artificial arc plus the cost of at most
+  // num_nodes_ - 1 arcs, so reduced costs stay below 4 * artificial_cost_ with
+  // this threshold.
+  const CostValue threshold =
+      std::numeric_limits<CostValue>::max() / (8 * (num_nodes_ + 2));
+  CostValue max_cost = 0;
+  for (ArcIndex arc = 0; arc < num_arcs_; ++arc) {
+    const CostValue cost = arc_cost_[arc];
+    if (cost > threshold || cost < -threshold) return false;
+    max_cost = std::max(max_cost, std::abs(cost));
+  }
+  artificial_cost_ = (max_cost + 1) * (num_nodes_ + 1);
+  for (NodeIndex node = 0; node < num_nodes_; ++node) {
+    arc_cost_[num_arcs_ + node] = artificial_cost_;
+  }
+  return true;
+}
+
+template <typename Graph>
+bool GenericNetworkSimplex<Graph>::FindEnteringArc() {
+  SCOPED_TIME_STAT(&stats_);
+  CostValue min_reduced_cost = 0;
+  ArcIndex num_left_in_block = block_size_;
+  ArcIndex arc = next_arc_;
+  for (ArcIndex i = 0; i < num_arcs_; ++i) {
+    const CostValue reduced_cost = arc_state_[arc] * ReducedCost(arc);
+    if (reduced_cost < min_reduced_cost) {
+      min_reduced_cost = reduced_cost;
+      entering_arc_ = arc;
+    }
+    if (++arc == num_arcs_) arc = 0;
+    if (--num_left_in_block == 0) {
+      if (min_reduced_cost < 0) break;
+      num_left_in_block = block_size_;
+    }
+  }
+  next_arc_ = arc;
+  return min_reduced_cost < 0;
+}
+
+template <typename Graph>
+typename Graph::NodeIndex GenericNetworkSimplex<Graph>::FindJoinNode(
+    NodeIndex first, NodeIndex second) {
+  // Walk up from both nodes alternately. The first node reached that was
+  // already visited from the other side is their closest common ancestor.
+  ++current_mark_;
+  node_mark_[first] = current_mark_;
+  if (node_mark_[second] == current_mark_) return second;
+  node_mark_[second] = current_mark_;
+  while (true) {
+    if (first != root_) {
+      first = parent_[first];
+      if (node_mark_[first] == current_mark_) return first;
+      node_mark_[first] = current_mark_;
+    }
+    if (second != root_) {
+      second = parent_[second];
+      if (node_mark_[second] == current_mark_) return second;
+      node_mark_[second] = current_mark_;
+    }
+  }
+}
+
+template <typename Graph>
+void GenericNetworkSimplex<Graph>::Pivot() {
+  SCOPED_TIME_STAT(&stats_);
+  // The flow goes around the cycle from the join node down to first, then
+  // along the entering arc to second, and then up to the join node.
+  const ArcIndex entering_arc = entering_arc_;
+  NodeIndex first = tail_[entering_arc];
+  NodeIndex second = head_[entering_arc];
+  if (arc_state_[entering_arc] == STATE_UPPER) std::swap(first, second);
+  const NodeIndex join = FindJoinNode(first, second);
+
+  // To keep the tree strongly feasible, the leaving arc is the last blocking
+  // arc of the cycle in the direction of the flow, starting from the join
+  // node. Hence the strict and non-strict comparisons below.
+  FlowQuantity delta = cap_[entering_arc];
+  NodeIndex leaving_node = kNoNode;
+  bool leaving_on_first_side = false;
+  for (NodeIndex node = first; node != join; node = parent_[node]) {
+    const ArcIndex arc = parent_arc_[node];
+    const FlowQuantity residual =
+        head_[arc] == node ? cap_[arc] - arc_flow_[arc] : arc_flow_[arc];
+    if (residual < delta) {
+      delta = residual;
+      leaving_node = node;
+      leaving_on_first_side = true;
+    }
+  }
+  for (NodeIndex node = second; node != join; node = parent_[node]) {
+    const ArcIndex arc = parent_arc_[node];
+    const FlowQuantity residual =
+        tail_[arc] == node ? cap_[arc] - arc_flow_[arc] : arc_flow_[arc];
+    if (residual <= delta) {
+      delta = residual;
+      leaving_node = node;
+      leaving_on_first_side = false;
+    }
+  }
+
+  if (delta > 0) {
+    arc_flow_[entering_arc] += arc_state_[entering_arc] * delta;
+    for (NodeIndex node = first; node != join; node = parent_[node]) {
+      const ArcIndex arc = parent_arc_[node];
+      arc_flow_[arc] += head_[arc] == node ? delta : -delta;
+    }
+    for (NodeIndex node = second; node != join; node = parent_[node]) {
+      const ArcIndex arc = parent_arc_[node];
+      arc_flow_[arc] += tail_[arc] == node ? delta : -delta;
+    }
+  }
+
+  // The entering arc is itself blocking: it just goes to its other bound.
+  if (leaving_node == kNoNode) {
+    arc_state_[entering_arc] = arc_state_[entering_arc] == STATE_LOWER
+                                   ? STATE_UPPER
+                                   : STATE_LOWER;
+    return;
+  }
+
+  // The subtree below the leaving arc contains in_node, and gets reattached to
+  // the tree through the entering arc.
+  const NodeIndex in_node = leaving_on_first_side ? first : second;
+  const NodeIndex out_node = leaving_on_first_side ? second : first;
+  const ArcIndex leaving_arc = parent_arc_[leaving_node];
+  arc_state_[leaving_arc] =
+      arc_flow_[leaving_arc] == 0 ? STATE_LOWER : STATE_UPPER;
+  const CostValue reduced_cost = ReducedCost(entering_arc);
+  arc_state_[entering_arc] = STATE_TREE;
+
+  // Reverse the tree path from in_node up to leaving_node.
+  NodeIndex node = in_node;
+  NodeIndex new_parent = out_node;
+  ArcIndex new_parent_arc = entering_arc;
+  while (true) {
+    const NodeIndex old_parent = parent_[node];
+    const ArcIndex old_parent_arc = parent_arc_[node];
+    RemoveChild(old_parent, node);
+    parent_[node] = new_parent;
+    parent_arc_[node] = new_parent_arc;
+    AddChild(new_parent, node);
+    if (node == leaving_node) break;
+    new_parent = node;
+    new_parent_arc = old_parent_arc;
+    node = old_parent;
+  }
+
+  // Make the reduced cost of the entering arc zero.
+  if (reduced_cost != 0) {
+    ShiftSubtreePotentials(in_node, in_node == head_[entering_arc]
+                                        ? reduced_cost
+                                        : -reduced_cost);
+  }
+}
+
+template <typename Graph>
+void GenericNetworkSimplex<Graph>::AddChild(NodeIndex parent,
+                                            NodeIndex child) {
+  const NodeIndex first_child = first_child_[parent];
+  next_sibling_[child] = first_child;
+  previous_sibling_[child] = kNoNode;
+  if (first_child != kNoNode) previous_sibling_[first_child] = child;
+  first_child_[parent] = child;
+}
+
+template <typename Graph>
+void GenericNetworkSimplex<Graph>::RemoveChild(NodeIndex parent,
+                                               NodeIndex child) {
+  const NodeIndex previous = previous_sibling_[child];
+  const NodeIndex next = next_sibling_[child];
+  if (previous != kNoNode) {
+    next_sibling_[previous] = next;
+  } else {
+    first_child_[parent] = next;
+  }
+  if (next != kNoNode) previous_sibling_[next] = previous;
+}
+
+template <typename Graph>
+void GenericNetworkSimplex<Graph>::ShiftSubtreePotentials(NodeIndex node,
+                                                          CostValue delta) {
+  dfs_stack_.assign(1, node);
+  while (!dfs_stack_.empty()) {
+    const NodeIndex current = dfs_stack_.back();
+    dfs_stack_.pop_back();
+    node_potential_[current] += delta;
+    for (NodeIndex child = first_child_[current]; child != kNoNode;
+         child = next_sibling_[child]) {
+      dfs_stack_.push_back(child);
+    }
+  }
+}
+
+// Explicit instantiations that can be used by a client.
+template class GenericNetworkSimplex<::util::StaticGraph<>>;
+template class GenericNetworkSimplex<::util::ReverseArcStaticGraph<>>;
+template class GenericNetworkSimplex<::util::ReverseArcListGraph<>>;
+
+}  // namespace operations_research
@@ -0,0 +1,217 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// An implementation of the primal network simplex algorithm for the min-cost
+// flow problem, see min_cost_flow.h for the definition of the problem.
+//
+// The algorithm maintains a spanning tree of the graph augmented with an
+// artificial root node, connected to every node by an artificial arc with a
+// large cost. Each arc not in the tree is either at its lower bound (no flow)
+// or at its upper bound (saturated), and the flow on the tree arcs is the
+// unique one that satisfies the supplies. Node potentials are such that the
+// reduced cost of every tree arc is zero. At each iteration, a non-tree arc
+// whose reduced cost shows that the total cost would decrease by changing its
+// flow enters the tree, as much flow as possible is sent around the cycle it
+// closes, and one of the blocking arcs of this cycle leaves the tree.
+//
+// The entering arc is chosen with the block search pivot rule: the arcs are
+// scanned in blocks of about sqrt(num_arcs) arcs, starting where the previous
+// search stopped, and the arc with the most negative reduced cost of the first
+// block containing one is selected. The leaving arc is chosen so that the tree
+// stays strongly feasible, which prevents cycling on degenerate pivots.
+//
+// On sparse graphs with a small cost range, this is often several times faster
+// than the cost-scaling algorithm of GenericMinCostFlow. Moreover, after a
+// successful Solve(), changing only arc unit costs keeps the current tree,
+// which is still primal feasible, so the next Solve() starts from it.
+//
+// References:
+// R. K. Ahuja, T. L. Magnanti, J. B. Orlin, "Network Flows: Theory, Algorithms,
+// and Applications," Prentice Hall, 1993, chapter 11.
+// Z. Kiraly, P. Kovacs, "Efficient implementations of minimum-cost flow
+// algorithms," Acta Universitatis Sapientiae, Informatica 4 (2012) 67-118.
+
+#ifndef OR_TOOLS_GRAPH_NETWORK_SIMPLEX_H_
+#define OR_TOOLS_GRAPH_NETWORK_SIMPLEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "ortools/graph/ebert_graph.h"
+#include "ortools/graph/graph.h"
+#include "ortools/graph/min_cost_flow.h"
+#include "ortools/util/stats.h"
+
+namespace operations_research {
+
+// Network simplex algorithm working on any graph with the Tail() and Head()
+// of its arcs, for instance util::StaticGraph. The graph must be fully built
+// before the construction of this class.
+template <typename Graph>
+class GenericNetworkSimplex : public MinCostFlowBase {
+ public:
+  typedef typename Graph::NodeIndex NodeIndex;
+  typedef typename Graph::ArcIndex ArcIndex;
+
+  explicit GenericNetworkSimplex(const Graph* graph);
+
+#ifndef SWIG
+  // This type is neither copyable nor movable.
+  GenericNetworkSimplex(const GenericNetworkSimplex&) = delete;
+  GenericNetworkSimplex& operator=(const GenericNetworkSimplex&) = delete;
+#endif
+
+  // Returns the graph associated to the current object.
+  const Graph* graph() const { return graph_; }
+
+  // Returns the status of last call to Solve(). NOT_SOLVED is returned if
+  // Solve() has never been called or if the problem has been modified since.
+  Status status() const { return status_; }
+
+  // Sets the supply corresponding to node. A demand is modeled as a negative
+  // supply.
+  void SetNodeSupply(NodeIndex node, FlowQuantity supply);
+
+  // Sets the unit cost for the given arc. This keeps the current tree, so the
+  // next Solve() restarts from the previous solution.
+  void SetArcUnitCost(ArcIndex arc, CostValue unit_cost);
+
+  // Sets the capacity for the given arc. It must be non-negative.
+  void SetArcCapacity(ArcIndex arc, FlowQuantity capacity);
+
+  // Solves the problem, returning true if a min-cost flow could be found. If
+  // the supplies are not balanced the status is UNBALANCED, if they cannot be
+  // routed within the capacities it is INFEASIBLE, and it is BAD_COST_RANGE if
+  // the arc unit costs are too large for the artificial arcs not to overflow.
+  bool Solve();
+
+  // Returns the cost of the minimum-cost flow found by the algorithm, or 0 if
+  // the last Solve() was not successful. As in GenericMinCostFlow, the result
+  // is capped at std::numeric_limits<CostValue>::max() on overflow.
+  CostValue GetOptimalCost() const;
+
+  // Returns the flow on the given arc. This only makes sense after a
+  // successful Solve().
+  FlowQuantity Flow(ArcIndex arc) const { return arc_flow_[arc]; }
+
+  // Accessors for the problem data.
+  FlowQuantity Capacity(ArcIndex arc) const { return arc_capacity_[arc]; }
+  CostValue UnitCost(ArcIndex arc) const { return arc_unit_cost_[arc]; }
+  FlowQuantity Supply(NodeIndex node) const { return node_supply_[node]; }
+
+  // Returns the number of pivots of the last Solve().
+  int64_t num_pivots() const { return num_pivots_; }
+
+ private:
+  // The state of an arc. For a non-tree arc, the reduced cost multiplied by
+  // its state is negative iff the arc can enter the tree.
+  enum ArcState : int8_t { STATE_UPPER = -1, STATE_TREE = 0, STATE_LOWER = 1 };
+
+  // Builds the initial tree made of the artificial arcs. Returns false if the
+  // cost of the artificial arcs overflows.
+  bool InitializeTree();
+
+  // Recomputes the cost of the artificial arcs and the node potentials from
+  // the current tree, after some arc unit costs changed. Returns false if the
+  // cost of the artificial arcs overflows.
+  bool UpdateTreePotentials();
+
+  // Computes the cost of the artificial arcs, returns false on overflow.
+  bool ComputeArtificialCost();
+
+  // Block search pivot rule. Returns false if no arc can enter the tree, i.e.
+  // if the current solution is optimal.
+  bool FindEnteringArc();
+
+  // Returns the closest common ancestor of the two given nodes in the tree.
+  NodeIndex FindJoinNode(NodeIndex first, NodeIndex second);
+
+  // Sends as much flow as possible around the cycle closed by entering_arc_ and
+  // updates the tree, its structure and the node potentials accordingly.
+  void Pivot();
+
+  // Helpers to maintain the children lists of the tree.
+  void AddChild(NodeIndex parent, NodeIndex child);
+  void RemoveChild(NodeIndex parent, NodeIndex child);
+
+  // Adds delta to the potentials of all the nodes of the subtree rooted at
+  // node.
+  void ShiftSubtreePotentials(NodeIndex node, CostValue delta);
+
+  CostValue ReducedCost(ArcIndex arc) const {
+    return arc_cost_[arc] + node_potential_[tail_[arc]] -
+           node_potential_[head_[arc]];
+  }
+
+  // Pointer to the graph passed as argument.
+  const Graph* graph_;
+
+  // The problem data, as given by the user.
+  std::vector<FlowQuantity> node_supply_;
+  std::vector<FlowQuantity> arc_capacity_;
+  std::vector<CostValue> arc_unit_cost_;
+
+  // The real arcs first, then one artificial arc per node.
+  NodeIndex num_nodes_ = 0;
+  ArcIndex num_arcs_ = 0;
+  NodeIndex root_ = 0;
+  std::vector<NodeIndex> tail_;
+  std::vector<NodeIndex> head_;
+  std::vector<FlowQuantity> cap_;
+  std::vector<CostValue> arc_cost_;
+  std::vector<FlowQuantity> arc_flow_;
+  std::vector<ArcState> arc_state_;
+
+  // The tree, with its root_. For each node, the arc to its parent is
+  // parent_arc_[node], and its children are kept in a doubly linked list.
+  std::vector<NodeIndex> parent_;
+  std::vector<ArcIndex> parent_arc_;
+  std::vector<NodeIndex> first_child_;
+  std::vector<NodeIndex> next_sibling_;
+  std::vector<NodeIndex> previous_sibling_;
+  std::vector<CostValue> node_potential_;
+
+  // The cost of the artificial arcs, larger than the cost of any path.
+  CostValue artificial_cost_ = 0;
+
+  // State of the block search pivot rule.
+  ArcIndex block_size_ = 0;
+  ArcIndex next_arc_ = 0;
+  ArcIndex entering_arc_ = 0;
+
+  // Used by FindJoinNode() to mark the visited nodes, and by
+  // ShiftSubtreePotentials() for its depth-first search.
+  std::vector<int64_t> node_mark_;
+  int64_t current_mark_ = 0;
+  std::vector<NodeIndex> dfs_stack_;
+
+  // Whether the tree of the last successful Solve() is still primal feasible.
+  bool has_feasible_tree_ = false;
+
+  Status status_ = NOT_SOLVED;
+  int64_t num_pivots_ = 0;
+
+  // Statistics about this class.
+  mutable StatsGroup stats_;
+};
+
+#if !SWIG
+
+extern template class GenericNetworkSimplex<::util::StaticGraph<>>;
+extern template class GenericNetworkSimplex<::util::ReverseArcStaticGraph<>>;
+extern template class GenericNetworkSimplex<::util::ReverseArcListGraph<>>;
+
+#endif  // SWIG
+
+}  // namespace operations_research
+#endif  // OR_TOOLS_GRAPH_NETWORK_SIMPLEX_H_
@@ -447,6 +447,76 @@ void ComputeOneToManyInternalOnGraph(
   }
   paths->StoreSingleSourcePaths(source, predecessor, distances);
 }
+
+// Number of consecutive sources handled by each task of
+// ComputeManyToManyDistanceMatrixWithMultipleThreads(), which share the same
+// buffers.
+constexpr int kNumSourcesPerDistanceTask = 16;
+
+// Computes the distances from each node of 'row_sources' to 'destinations',
+// into the rows of the distance matrix starting at 'first_row'. This is the
+// same Dijkstra search as ComputeOneToManyInternalOnGraph(), without the
+// predecessors, and with buffers reused from one source to the next.
+template <class GraphType>
+void ComputeDistanceMatrixRows(
+    const GraphType* const graph,
+    const std::vector<PathDistance>* const arc_lengths,
+    absl::Span<const typename GraphType::NodeIndex> row_sources,
+    const std::vector<typename GraphType::NodeIndex>* const destinations,
+    PathDistance* const first_row) {
+  const int num_nodes = graph->num_nodes();
+  AdjustablePriorityQueue<NodeEntry> priority_queue;
+  std::vector<NodeEntry> entries(num_nodes);
+  for (const typename GraphType::NodeIndex node : graph->AllNodes()) {
+    entries[node].set_node(node);
+  }
+  int num_unique_destinations = 0;
+  for (const typename GraphType::NodeIndex destination : *destinations) {
+    if (entries[destination].is_destination()) continue;
+    entries[destination].set_is_destination(true);
+    ++num_unique_destinations;
+  }
+  std::vector<typename GraphType::NodeIndex> settled_nodes;
+  const int num_destinations = destinations->size();
+  PathDistance* row = first_row;
+  for (const typename GraphType::NodeIndex source : row_sources) {
+    // As in ComputeOneToManyInternalOnGraph(), the distance of the source to
+    // itself is the length of the shortest cycle through it.
+    for (const typename GraphType::ArcIndex arc :
+         graph->OutgoingArcs(source)) {
+      InsertOrUpdateEntry((*arc_lengths)[arc], &entries[graph->Head(arc)],
+                          &priority_queue);
+    }
+    int destinations_remaining = num_unique_destinations;
+    while (!priority_queue.IsEmpty()) {
+      NodeEntry* current = priority_queue.Top();
+      priority_queue.Pop();
+      current->set_settled(true);
+      settled_nodes.push_back(current->node());
+      if (current->is_destination() && --destinations_remaining == 0) break;
+      const PathDistance current_distance = current->distance();
+      for (const typename GraphType::ArcIndex arc :
+           graph->OutgoingArcs(current->node())) {
+        NodeEntry* const entry = &entries[graph->Head(arc)];
+        if (entry->settled()) continue;
+        const PathDistance arc_length = (*arc_lengths)[arc];
+        DCHECK_LE(current_distance, kDisconnectedPathDistance - arc_length);
+        InsertOrUpdateEntry(current_distance + arc_length, entry,
+                            &priority_queue);
+      }
+    }
+    for (int j = 0; j < num_destinations; ++j) {
+      const NodeEntry& entry = entries[(*destinations)[j]];
+      row[j] = entry.settled() ? entry.distance() : kDisconnectedPathDistance;
+    }
+    row += num_destinations;
+    for (const typename GraphType::NodeIndex node : settled_nodes) {
+      entries[node].set_settled(false);
+    }
+    settled_nodes.clear();
+    priority_queue.Clear();
+  }
+}
 }  // namespace
 
 PathContainer::PathContainer() {}
@@ -576,4 +646,64 @@ void ComputeManyToManyShortestPathsWithMultipleThreads(
       graph, arc_lengths, sources, destinations, num_threads, path_container);
 }
 
+template <class GraphType>
+void ComputeManyToManyDistanceMatrixWithMultipleThreads(
+    const GraphType& graph, const std::vector<PathDistance>& arc_lengths,
+    const std::vector<typename GraphType::NodeIndex>& sources,
+    const std::vector<typename GraphType::NodeIndex>& destinations,
+    int num_threads, std::vector<PathDistance>* const distances) {
+  CHECK(distances != nullptr);
+  CHECK_EQ(graph.num_arcs(), arc_lengths.size())
+      << "Number of arcs in graph must match arc length vector size";
+  distances->assign(sources.size() * destinations.size(),
+                    kDisconnectedPathDistance);
+  if (sources.empty() || destinations.empty()) return;
+  WallTimer timer;
+  timer.Start();
+  {
+    // Each task writes to its own rows of the matrix.
+    std::unique_ptr<ThreadPool> pool(
+        new ThreadPool("OR_DistanceMatrix", num_threads));
+    pool->StartWorkers();
+    const absl::Span<const typename GraphType::NodeIndex> all_sources(sources);
+    for (int i = 0; i < sources.size(); i += kNumSourcesPerDistanceTask) {
+      pool->Schedule(absl::bind_front(
+          &ComputeDistanceMatrixRows<GraphType>, &graph, &arc_lengths,
+          all_sources.subspan(i, kNumSourcesPerDistanceTask), &destinations,
+          distances->data() + static_cast<size_t>(i) * destinations.size()));
+    }
+  }
+  VLOG(2) << "Elapsed time to compute the distance matrix: " << timer.Get()
+          << "s";
+}
+
+template void ComputeManyToManyDistanceMatrixWithMultipleThreads(
+    const ListGraph<>& graph, const std::vector<PathDistance>& arc_lengths,
+    const std::vector<ListGraph<>::NodeIndex>& sources,
+    const std::vector<ListGraph<>::NodeIndex>& destinations, int num_threads,
+    std::vector<PathDistance>* distances);
+template void ComputeManyToManyDistanceMatrixWithMultipleThreads(
+    const StaticGraph<>& graph, const std::vector<PathDistance>& arc_lengths,
+    const std::vector<StaticGraph<>::NodeIndex>& sources,
+    const std::vector<StaticGraph<>::NodeIndex>& destinations, int num_threads,
+    std::vector<PathDistance>* distances);
+template void ComputeManyToManyDistanceMatrixWithMultipleThreads(
+    const ReverseArcListGraph<>& graph,
+    const std::vector<PathDistance>& arc_lengths,
+    const std::vector<ReverseArcListGraph<>::NodeIndex>& sources,
+    const std::vector<ReverseArcListGraph<>::NodeIndex>& destinations,
+    int num_threads, std::vector<PathDistance>* distances);
+template void ComputeManyToManyDistanceMatrixWithMultipleThreads(
+    const ReverseArcStaticGraph<>& graph,
+    const std::vector<PathDistance>& arc_lengths,
+    const std::vector<ReverseArcStaticGraph<>::NodeIndex>& sources,
+    const std::vector<ReverseArcStaticGraph<>::NodeIndex>& destinations,
+    int num_threads, std::vector<PathDistance>* distances);
+template void ComputeManyToManyDistanceMatrixWithMultipleThreads(
+    const ReverseArcMixedGraph<>& graph,
+    const std::vector<PathDistance>& arc_lengths,
+    const std::vector<ReverseArcMixedGraph<>::NodeIndex>& sources,
+    const std::vector<ReverseArcMixedGraph<>::NodeIndex>& destinations,
+    int num_threads, std::vector<PathDistance>* distances);
+
 }  // namespace operations_research
@@ -309,6 +309,22 @@ void ComputeManyToManyShortestPathsWithMultipleThreads(
     const std::vector<ReverseArcMixedGraph<>::NodeIndex>& destinations,
     int num_threads, PathContainer* path_container);
 
+// Computes the distances from the nodes in 'sources' to the nodes in
+// 'destinations', without storing the paths, into the dense row-major matrix
+// 'distances': (*distances)[i * destinations.size() + j] is the distance from
+// sources[i] to destinations[j], with the same semantics as
+// PathContainer::GetDistance(). Duplicate sources or destinations are allowed.
+// Contrary to a PathContainer, which uses O(num_sources * num_nodes) memory,
+// the only memory used on top of the matrix is O(num_threads * num_nodes).
+// Supported graph types are the same as for
+// ComputeManyToManyShortestPathsWithMultipleThreads().
+template <class GraphType>
+void ComputeManyToManyDistanceMatrixWithMultipleThreads(
+    const GraphType& graph, const std::vector<PathDistance>& arc_lengths,
+    const std::vector<typename GraphType::NodeIndex>& sources,
+    const std::vector<typename GraphType::NodeIndex>& destinations,
+    int num_threads, std::vector<PathDistance>* distances);
+
 // Computes shortest paths between all nodes of the graph.
 template <class GraphType>
 void ComputeAllToAllShortestPathsWithMultipleThreads(
@@ -210,6 +210,23 @@ void TestShortestPathsFromGraph(const GraphType& graph,
       }
     }
   }
+  // Many-to-many distance matrix, with duplicate sources.
+  {
+    std::vector<typename GraphType::NodeIndex> sources = some_nodes;
+    sources.push_back(source);
+    sources.push_back(source);
+    std::vector<PathDistance> distances;
+    ComputeManyToManyDistanceMatrixWithMultipleThreads(
+        graph, lengths, sources, some_nodes, kThreads, &distances);
+    ASSERT_EQ(distances.size(), sources.size() * some_nodes.size());
+    for (int i = 0; i < sources.size(); ++i) {
+      index = sources[i] * graph.num_nodes();
+      for (int j = 0; j < some_nodes.size(); ++j) {
+        EXPECT_EQ(expected_distances[index + some_nodes[j]],
+                  distances[i * some_nodes.size() + j]);
+      }
+    }
+  }
 }
 
 #undef BUILD_CONTAINERS
@@ -42,11 +42,15 @@
 #include "ortools/graph/graph.h"
 #include "ortools/graph/max_flow.h"
 #include "ortools/graph/min_cost_flow.h"
+#include "ortools/graph/network_simplex.h"
 #include "ortools/util/filelineiter.h"
 #include "ortools/util/stats.h"
 
 ABSL_FLAG(std::string, input, "", "Input file of the problem.");
 ABSL_FLAG(std::string, output_dimacs, "", "Output problem as a dimacs file.");
+ABSL_FLAG(bool, use_network_simplex, false,
+          "Solve the min cost flow problems with the network simplex algorithm "
+          "instead of the cost-scaling one.");
 
 namespace operations_research {
 
@@ -194,28 +198,37 @@ void SolveMinCostFlow(const FlowModelProto& flow_model, double* loading_time,
   std::vector<Graph::ArcIndex> permutation;
   graph.Build(&permutation);
 
-  GenericMinCostFlow<Graph> min_cost_flow(&graph);
-  for (int i = 0; i < flow_model.arcs_size(); ++i) {
-    const Graph::ArcIndex image = i < permutation.size() ? permutation[i] : i;
-    min_cost_flow.SetArcUnitCost(image, flow_model.arcs(i).unit_cost());
-    min_cost_flow.SetArcCapacity(image, flow_model.arcs(i).capacity());
-  }
-  for (int i = 0; i < flow_model.nodes_size(); ++i) {
-    min_cost_flow.SetNodeSupply(flow_model.nodes(i).id(),
-                                flow_model.nodes(i).supply());
-  }
+  // GenericMinCostFlow and GenericNetworkSimplex share the same interface.
+  const auto load_and_solve = [&](auto& min_cost_flow) {
+    for (int i = 0; i < flow_model.arcs_size(); ++i) {
+      const Graph::ArcIndex image = i < permutation.size() ? permutation[i] : i;
+      min_cost_flow.SetArcUnitCost(image, flow_model.arcs(i).unit_cost());
+      min_cost_flow.SetArcCapacity(image, flow_model.arcs(i).capacity());
+    }
+    for (int i = 0; i < flow_model.nodes_size(); ++i) {
+      min_cost_flow.SetNodeSupply(flow_model.nodes(i).id(),
+                                  flow_model.nodes(i).supply());
+    }
 
-  *loading_time = timer.Get();
-  absl::PrintF("%f,", *loading_time);
-  fflush(stdout);
+    *loading_time = timer.Get();
+    absl::PrintF("%f,", *loading_time);
+    fflush(stdout);
 
-  timer.Start();
-  CHECK(min_cost_flow.Solve());
-  CHECK_EQ(GenericMinCostFlow<Graph>::OPTIMAL, min_cost_flow.status());
-  *solving_time = timer.Get();
-  absl::PrintF("%f,", *solving_time);
-  absl::PrintF("%d", min_cost_flow.GetOptimalCost());
-  fflush(stdout);
+    timer.Start();
+    CHECK(min_cost_flow.Solve());
+    CHECK_EQ(MinCostFlowBase::OPTIMAL, min_cost_flow.status());
+    *solving_time = timer.Get();
+    absl::PrintF("%f,", *solving_time);
+    absl::PrintF("%d", min_cost_flow.GetOptimalCost());
+    fflush(stdout);
+  };
+  if (absl::GetFlag(FLAGS_use_network_simplex)) {
+    GenericNetworkSimplex<Graph> network_simplex(&graph);
+    load_and_solve(network_simplex);
+  } else {
+    GenericMinCostFlow<Graph> min_cost_flow(&graph);
+    load_and_solve(min_cost_flow);
+  }
 }
 
 // Loads a FlowModelProto proto into the MaxFlow class and solves it.
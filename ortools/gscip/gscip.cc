@@ -495,6 +495,14 @@ absl::StatusOr<SCIP_CONS*> GScip::AddLinearConstraint(
   return constraint;
 }
 
+void GScip::ReserveVariables(const int num_new_variables) {
+  variables_.reserve(variables_.size() + num_new_variables);
+}
+
+void GScip::ReserveConstraints(const int num_new_constraints) {
+  constraints_.reserve(constraints_.size() + num_new_constraints);
+}
+
 absl::StatusOr<SCIP_CONS*> GScip::AddQuadraticConstraint(
     const GScipQuadraticRange& range, const std::string& name,
     const GScipConstraintOptions& options) {
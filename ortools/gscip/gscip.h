@@ -227,6 +227,12 @@ class GScip {
       const GScipLinearRange& range, const std::string& name = "",
       const GScipConstraintOptions& options = DefaultGScipConstraintOptions());
 
+  // Reserves memory for the given number of new kept alive variables or
+  // constraints, to avoid growing variables() or constraints() many times when
+  // adding a large model one variable or constraint at a time.
+  void ReserveVariables(int num_new_variables);
+  void ReserveConstraints(int num_new_constraints);
+
   // ///////////////////////////////////////////////////////////////////////////
   // Model Queries
   // ///////////////////////////////////////////////////////////////////////////
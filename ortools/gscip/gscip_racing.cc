@@ -0,0 +1,299 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/gscip/gscip_racing.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/gscip/gscip.h"
+#include "ortools/gscip/gscip.pb.h"
+#include "ortools/gscip/gscip_event_handler.h"
+#include "scip/scip.h"
+#include "scip/type_event.h"
+#include "scip/type_sol.h"
+#include "scip/type_var.h"
+
+namespace operations_research {
+
+// The best solution found by the workers of a GScipRacer, with the values of
+// the original variables in their creation order.
+class GScipSharedIncumbent {
+ public:
+  // Forgets the incumbent, before a new solve.
+  void Reset(const bool is_maximize) {
+    const absl::MutexLock lock(&mutex_);
+    is_maximize_ = is_maximize;
+    version_ = 0;
+    source_ = -1;
+    values_.clear();
+  }
+
+  // Replaces the incumbent if `objective` is better.
+  void Publish(const int worker, const double objective,
+               absl::Span<const double> values) {
+    const absl::MutexLock lock(&mutex_);
+    if (version_ > 0 && !IsBetter(objective, objective_)) return;
+    ++version_;
+    source_ = worker;
+    objective_ = objective;
+    values_.assign(values.begin(), values.end());
+  }
+
+  // If the incumbent changed since `*version`, was found by another worker
+  // and is better than `primal_bound`, copies it to `values` and returns true.
+  // Updates `*version` in all cases.
+  bool GetIfBetter(const int worker, const double primal_bound,
+                   int64_t* const version, std::vector<double>* const values) {
+    const absl::MutexLock lock(&mutex_);
+    if (version_ == *version) return false;
+    *version = version_;
+    if (source_ == worker || !IsBetter(objective_, primal_bound)) return false;
+    values->assign(values_.begin(), values_.end());
+    return true;
+  }
+
+ private:
+  bool IsBetter(const double a, const double b) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return is_maximize_ ? a > b : a < b;
+  }
+
+  absl::Mutex mutex_;
+  bool is_maximize_ ABSL_GUARDED_BY(mutex_) = false;
+  // Incremented each time the incumbent changes; 0 when there is none.
+  int64_t version_ ABSL_GUARDED_BY(mutex_) = 0;
+  int source_ ABSL_GUARDED_BY(mutex_) = -1;
+  double objective_ ABSL_GUARDED_BY(mutex_) = 0.0;
+  std::vector<double> values_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Publishes the new best solutions of a worker to the shared incumbent, and
+// tries the ones of the other workers at each node. All the SCIP calls are made
+// from the Execute() of the event handler, on the thread of the worker, since
+// SCIP is not thread-safe.
+class GScipRacingEventHandler : public GScipEventHandler {
+ public:
+  GScipRacingEventHandler(const int worker,
+                          GScipSharedIncumbent* const shared_incumbent)
+      : GScipEventHandler(
+            {.name = "racing event handler",
+             .description = "Shares the solutions between the workers of a "
+                            "GScipRacer."}),
+        worker_(worker),
+        shared_incumbent_(shared_incumbent) {}
+
+  // Sets the interrupters of the next solve: `race_interrupter` is triggered
+  // when `user_interrupter` is. Both can be nullptr.
+  void set_interrupters(GScip::Interrupter* const race_interrupter,
+                        const GScip::Interrupter* const user_interrupter) {
+    race_interrupter_ = race_interrupter;
+    user_interrupter_ = user_interrupter;
+  }
+
+  SCIP_RETCODE Init(GScip* const gscip) override {
+    last_version_ = 0;
+    SCIP_CALL(CatchEvent(SCIP_EVENTTYPE_BESTSOLFOUND));
+    SCIP_CALL(CatchEvent(SCIP_EVENTTYPE_NODESOLVED));
+    SCIP_CALL(CatchEvent(SCIP_EVENTTYPE_PRESOLVEROUND));
+    return SCIP_OKAY;
+  }
+
+  SCIP_RETCODE Execute(const GScipEventHandlerContext context) override {
+    if (race_interrupter_ != nullptr && user_interrupter_ != nullptr &&
+        user_interrupter_->is_interrupted()) {
+      race_interrupter_->Interrupt();
+    }
+    SCIP* const scip = context.gscip()->scip();
+    if (context.event_type() == SCIP_EVENTTYPE_BESTSOLFOUND) {
+      return PublishBestSolution(scip);
+    }
+    if ((context.event_type() & SCIP_EVENTTYPE_NODESOLVED) != 0) {
+      return TrySharedIncumbent(scip);
+    }
+    return SCIP_OKAY;
+  }
+
+ private:
+  SCIP_RETCODE PublishBestSolution(SCIP* const scip) {
+    SCIP_SOL* const solution = SCIPgetBestSol(scip);
+    if (solution == nullptr) return SCIP_OKAY;
+    const int num_vars = SCIPgetNOrigVars(scip);
+    values_.resize(num_vars);
+    SCIP_CALL(SCIPgetSolVals(scip, solution, num_vars, SCIPgetOrigVars(scip),
+                             values_.data()));
+    shared_incumbent_->Publish(worker_, SCIPgetSolOrigObj(scip, solution),
+                               values_);
+    return SCIP_OKAY;
+  }
+
+  SCIP_RETCODE TrySharedIncumbent(SCIP* const scip) {
+    if (!shared_incumbent_->GetIfBetter(worker_, SCIPgetPrimalbound(scip),
+                                        &last_version_, &values_)) {
+      return SCIP_OKAY;
+    }
+    const int num_vars = SCIPgetNOrigVars(scip);
+    CHECK_EQ(static_cast<int>(values_.size()), num_vars);
+    SCIP_SOL* solution = nullptr;
+    SCIP_CALL(SCIPcreateOrigSol(scip, &solution, /*heur=*/nullptr));
+    SCIP_CALL(SCIPsetSolVals(scip, solution, num_vars, SCIPgetOrigVars(scip),
+                             values_.data()));
+    SCIP_Bool is_stored;
+    SCIP_CALL(SCIPtrySolFree(
+        scip, &solution, /*printreason=*/false, /*completely=*/false,
+        /*checkbounds=*/true, /*checkintegrality=*/true, /*checklprows=*/true,
+        &is_stored));
+    return SCIP_OKAY;
+  }
+
+  const int worker_;
+  GScipSharedIncumbent* const shared_incumbent_;
+  GScip::Interrupter* race_interrupter_ = nullptr;
+  const GScip::Interrupter* user_interrupter_ = nullptr;
+  // The version of the shared incumbent when it was last read.
+  int64_t last_version_ = 0;
+  // Buffer for the values of the original variables.
+  std::vector<double> values_;
+};
+
+absl::StatusOr<std::unique_ptr<GScipRacer>> GScipRacer::Create(
+    const int num_workers, const std::string& problem_name,
+    const std::function<absl::Status(GScip& gscip)>& build_model) {
+  if (num_workers < 1) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("num_workers must be positive, got ", num_workers));
+  }
+  auto racer = absl::WrapUnique(new GScipRacer());
+  racer->shared_incumbent_ = std::make_unique<GScipSharedIncumbent>();
+  for (int worker = 0; worker < num_workers; ++worker) {
+    ASSIGN_OR_RETURN(std::unique_ptr<GScip> gscip,
+                     GScip::Create(problem_name));
+    RETURN_IF_ERROR(build_model(*gscip))
+        << "while building the model of worker " << worker;
+    if (worker > 0) {
+      const int num_vars = SCIPgetNOrigVars(gscip->scip());
+      const int expected_num_vars = SCIPgetNOrigVars(racer->gscip(0).scip());
+      if (num_vars != expected_num_vars) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("the model of worker ", worker, " has ", num_vars,
+                         " variables instead of ", expected_num_vars));
+      }
+    }
+    auto event_handler = std::make_unique<GScipRacingEventHandler>(
+        worker, racer->shared_incumbent_.get());
+    RETURN_IF_ERROR(event_handler->Register(gscip.get()));
+    racer->event_handlers_.push_back(std::move(event_handler));
+    racer->gscips_.push_back(std::move(gscip));
+  }
+  return racer;
+}
+
+GScipRacer::~GScipRacer() = default;
+
+absl::StatusOr<GScipResult> GScipRacer::Solve(
+    absl::Span<const GScipParameters> worker_params,
+    const GScip::Interrupter* const interrupter) {
+  if (worker_params.size() != num_workers()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("expected ", num_workers(), " worker parameters, got ",
+                     worker_params.size()));
+  }
+  const bool is_maximize = gscips_[0]->ObjectiveIsMaximize();
+  shared_incumbent_->Reset(is_maximize);
+
+  // Triggered by the first worker to finish, to stop the other ones.
+  GScip::Interrupter race_interrupter;
+  std::vector<absl::StatusOr<GScipResult>> results(
+      num_workers(), absl::UnknownError("worker did not run"));
+  absl::Mutex mutex;
+  std::vector<int> finish_order;
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(num_workers());
+    for (int worker = 0; worker < num_workers(); ++worker) {
+      event_handlers_[worker]->set_interrupters(&race_interrupter,
+                                                interrupter);
+      threads.emplace_back([&, worker]() {
+        results[worker] = gscips_[worker]->Solve(
+            worker_params[worker], /*legacy_params=*/"",
+            /*message_handler=*/nullptr, &race_interrupter);
+        race_interrupter.Interrupt();
+        const absl::MutexLock lock(&mutex);
+        finish_order.push_back(worker);
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  for (const auto& event_handler : event_handlers_) {
+    event_handler->set_interrupters(nullptr, nullptr);
+  }
+
+  int winner = -1;
+  for (const int worker : finish_order) {
+    RETURN_IF_ERROR(results[worker].status()) << "in worker " << worker;
+    if (winner == -1) {
+      winner = worker;
+      continue;
+    }
+    const double objective =
+        results[worker]->gscip_output.stats().best_objective();
+    const double best_objective =
+        results[winner]->gscip_output.stats().best_objective();
+    if (is_maximize ? objective > best_objective : objective < best_objective) {
+      winner = worker;
+    }
+  }
+  last_winner_ = winner;
+  return TranslateToFirstWorker(winner, *std::move(results[winner]));
+}
+
+GScipResult GScipRacer::TranslateToFirstWorker(const int worker,
+                                               GScipResult result) {
+  if (worker == 0) return result;
+  SCIP_VAR** const first_worker_vars = SCIPgetOrigVars(gscips_[0]->scip());
+  // In the PROBLEM stage, SCIPvarGetProbindex() is the index of the variable in
+  // the array of the original variables.
+  const auto translate =
+      [first_worker_vars](const absl::flat_hash_map<SCIP_VAR*, double>& in) {
+        absl::flat_hash_map<SCIP_VAR*, double> out;
+        out.reserve(in.size());
+        for (const auto& [var, value] : in) {
+          out[first_worker_vars[SCIPvarGetProbindex(var)]] = value;
+        }
+        return out;
+      };
+  for (GScipSolution& solution : result.solutions) {
+    solution = translate(solution);
+  }
+  result.primal_ray = translate(result.primal_ray);
+  return result;
+}
+
+}  // namespace operations_research
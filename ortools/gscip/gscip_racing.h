@@ -0,0 +1,105 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Races several SCIP solves of the same model, with different parameters, on
+// separate threads, sharing the solutions they find.
+#ifndef OR_TOOLS_GSCIP_GSCIP_RACING_H_
+#define OR_TOOLS_GSCIP_GSCIP_RACING_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "ortools/gscip/gscip.h"
+#include "ortools/gscip/gscip.pb.h"
+
+namespace operations_research {
+
+class GScipRacingEventHandler;
+class GScipSharedIncumbent;
+
+// Owns one GScip per worker, all holding the same model, and solves them
+// concurrently. Each worker publishes its new best solutions to the others,
+// which try them at their next node; a shared incumbent is also a shared
+// cutoff bound, since SCIP prunes the nodes whose dual bound is worse than its
+// best solution. The race stops as soon as one of the workers finishes.
+//
+// The variables of the workers are matched by their creation order, so the
+// model builder must create the same variables in the same order for all
+// workers.
+//
+// Usage:
+//   ASSIGN_OR_RETURN(std::unique_ptr<GScipRacer> racer,
+//                    GScipRacer::Create(/*num_workers=*/4, "my_problem",
+//                                       [&](GScip& gscip) -> absl::Status {
+//                                         ...
+//                                       }));
+//   std::vector<GScipParameters> params(4);
+//   for (int i = 0; i < 4; ++i) GScipSetRandomSeed(&params[i], i);
+//   ASSIGN_OR_RETURN(const GScipResult result, racer->Solve(params));
+class GScipRacer {
+ public:
+  // Creates `num_workers` GScip, each one with the model built by
+  // `build_model`, which is called once per worker.
+  static absl::StatusOr<std::unique_ptr<GScipRacer>> Create(
+      int num_workers, const std::string& problem_name,
+      const std::function<absl::Status(GScip& gscip)>& build_model);
+
+  GScipRacer(const GScipRacer&) = delete;
+  GScipRacer& operator=(const GScipRacer&) = delete;
+  ~GScipRacer();
+
+  int num_workers() const { return gscips_.size(); }
+
+  // The model of the worker. The result of Solve() is expressed with the
+  // variables of gscip(0).
+  GScip& gscip(int worker) { return *gscips_[worker]; }
+
+  // Solves the model with worker i using `worker_params[i]`, which must have
+  // num_workers() elements that should differ, at least by their random seed.
+  //
+  // Returns the result of the worker with the best primal bound, the ties being
+  // broken in favor of the first worker to finish; in particular, when a worker
+  // proves optimality or infeasibility, its result is returned. The solutions
+  // and the primal ray use the variables of gscip(0).
+  //
+  // The interrupter, if any, is polled by each worker at each presolve round
+  // and each node.
+  absl::StatusOr<GScipResult> Solve(
+      absl::Span<const GScipParameters> worker_params,
+      const GScip::Interrupter* interrupter = nullptr);
+
+  // Returns the index of the worker whose result was returned by the last call
+  // to Solve(), or -1 if Solve() was not called.
+  int last_winner() const { return last_winner_; }
+
+ private:
+  GScipRacer() = default;
+
+  // Returns `result`, from `worker`, with the variables of gscip(0).
+  GScipResult TranslateToFirstWorker(int worker, GScipResult result);
+
+  // The event handlers are destroyed after the GScip they are registered in.
+  std::unique_ptr<GScipSharedIncumbent> shared_incumbent_;
+  std::vector<std::unique_ptr<GScipRacingEventHandler>> event_handlers_;
+  std::vector<std::unique_ptr<GScip>> gscips_;
+  int last_winner_ = -1;
+};
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_GSCIP_GSCIP_RACING_H_
@@ -988,15 +988,40 @@ void GurobiInterface::ExtractNewVariables() {
 void GurobiInterface::ExtractNewConstraints() {
   int total_num_rows = solver_->constraints_.size();
   if (last_constraint_index_ < total_num_rows) {
+    // Runs of consecutive linear constraints that are not ranges are added
+    // with a single GRBaddconstrs() call, in CSR format, as a call per
+    // constraint dominates the extraction time of large models. A run is also
+    // broken when the constraints switch between named and unnamed, so that
+    // unnamed constraints keep the default Gurobi names.
+    std::vector<int> batch_begins;
+    std::vector<int> batch_vars;
+    std::vector<double> batch_coefs;
+    std::vector<char> batch_senses;
+    std::vector<double> batch_rhs;
+    std::vector<char*> batch_names;
+    bool batch_is_named = false;
+    const auto add_batch = [&]() {
+      if (batch_senses.empty()) return;
+      CheckedGurobiCall(GRBaddconstrs(
+          model_, batch_senses.size(), batch_vars.size(), batch_begins.data(),
+          batch_vars.data(), batch_coefs.data(), batch_senses.data(),
+          batch_rhs.data(), batch_is_named ? batch_names.data() : nullptr));
+      batch_begins.clear();
+      batch_vars.clear();
+      batch_coefs.clear();
+      batch_senses.clear();
+      batch_rhs.clear();
+      batch_names.clear();
+    };
+    std::vector<int> grb_vars;
+    std::vector<double> coefs;
     // Add each new constraint.
     for (int row = last_constraint_index_; row < total_num_rows; ++row) {
       MPConstraint* const ct = solver_->constraints_[row];
       set_constraint_as_extracted(row, true);
       const int size = ct->coefficients_.size();
-      std::vector<int> grb_vars;
-      std::vector<double> coefs;
-      grb_vars.reserve(size);
-      coefs.reserve(size);
+      grb_vars.clear();
+      coefs.clear();
       for (const auto& entry : ct->coefficients_) {
         const int var_index = entry.first->index();
         CHECK(variable_is_extracted(var_index));
@@ -1006,6 +1031,7 @@ void GurobiInterface::ExtractNewConstraints() {
       char* const name =
           ct->name().empty() ? nullptr : const_cast<char*>(ct->name().c_str());
       if (ct->indicator_variable() != nullptr) {
+        add_batch();
         const int grb_ind_var =
             mp_var_to_gurobi_var_.at(ct->indicator_variable()->index());
         if (ct->lb() > -std::numeric_limits<double>::infinity()) {
@@ -1024,29 +1050,42 @@ void GurobiInterface::ExtractNewConstraints() {
       } else {
         // Using GRBaddrangeconstr for constraints that don't require it adds
         // a slack which is not always removed by presolve.
+        char sense;
+        double rhs;
         if (ct->lb() == ct->ub()) {
-          CheckedGurobiCall(GRBaddconstr(model_, size, grb_vars.data(),
-                                         coefs.data(), GRB_EQUAL, ct->lb(),
-                                         name));
+          sense = GRB_EQUAL;
+          rhs = ct->lb();
         } else if (ct->lb() == -std::numeric_limits<double>::infinity()) {
-          CheckedGurobiCall(GRBaddconstr(model_, size, grb_vars.data(),
-                                         coefs.data(), GRB_LESS_EQUAL, ct->ub(),
-                                         name));
+          sense = GRB_LESS_EQUAL;
+          rhs = ct->ub();
         } else if (ct->ub() == std::numeric_limits<double>::infinity()) {
-          CheckedGurobiCall(GRBaddconstr(model_, size, grb_vars.data(),
-                                         coefs.data(), GRB_GREATER_EQUAL,
-                                         ct->lb(), name));
+          sense = GRB_GREATER_EQUAL;
+          rhs = ct->lb();
         } else {
+          add_batch();
           CheckedGurobiCall(GRBaddrangeconstr(model_, size, grb_vars.data(),
                                               coefs.data(), ct->lb(), ct->ub(),
                                               name));
           // NOTE(user): range constraints implicitly add an extra variable
           // to the model.
           num_gurobi_vars_++;
+          mp_cons_to_gurobi_linear_cons_.push_back(num_gurobi_linear_cons_++);
+          continue;
         }
+        if (batch_is_named != (name != nullptr)) {
+          add_batch();
+          batch_is_named = name != nullptr;
+        }
+        batch_begins.push_back(batch_vars.size());
+        batch_vars.insert(batch_vars.end(), grb_vars.begin(), grb_vars.end());
+        batch_coefs.insert(batch_coefs.end(), coefs.begin(), coefs.end());
+        batch_senses.push_back(sense);
+        batch_rhs.push_back(rhs);
+        batch_names.push_back(name);
         mp_cons_to_gurobi_linear_cons_.push_back(num_gurobi_linear_cons_++);
       }
     }
+    add_batch();
   }
   CheckedGurobiCall(GRBupdatemodel(model_));
   DCHECK_EQ(GetIntAttr(GRB_INT_ATTR_NUMCONSTRS), num_gurobi_linear_cons_);
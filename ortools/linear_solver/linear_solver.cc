@@ -1202,6 +1202,7 @@ void MPSolver::ExportModelToProto(MPModelProto* output_model) const {
   // Name
   output_model->set_name(Name());
   // Variables
+  output_model->mutable_variable()->Reserve(variables_.size());
   for (const MPVariable* var : variables_) {
     MPVariableProto* const variable_proto = output_model->add_variable();
     // TODO(user): Add option to avoid filling the var name to avoid overly
@@ -1210,27 +1211,24 @@ void MPSolver::ExportModelToProto(MPModelProto* output_model) const {
     variable_proto->set_lower_bound(var->lb());
     variable_proto->set_upper_bound(var->ub());
     variable_proto->set_is_integer(var->integer());
-    if (objective_->GetCoefficient(var) != 0.0) {
-      variable_proto->set_objective_coefficient(
-          objective_->GetCoefficient(var));
-    }
     if (var->branching_priority() != 0) {
       variable_proto->set_branching_priority(var->branching_priority());
     }
   }
-
-  // Map the variables to their indices. This is needed to output the
-  // variables in the order they were created, which in turn is needed to have
-  // repeatable results with ExportModelAsLpFormat and ExportModelAsMpsFormat.
-  // This step is needed as long as the variable indices are given by the
-  // underlying solver at the time of model extraction.
-  // TODO(user): remove this step.
-  absl::flat_hash_map<const MPVariable*, int> var_to_index;
-  for (int j = 0; j < static_cast<int>(variables_.size()); ++j) {
-    var_to_index[variables_[j]] = j;
+  for (const auto& [var, coeff] : objective_->coefficients_) {
+    if (coeff != 0.0) {
+      output_model->mutable_variable(var->index())
+          ->set_objective_coefficient(coeff);
+    }
   }
 
   // Constraints
+  // The terms of each constraint are output sorted by variable index, to have
+  // repeatable results with ExportModelAsLpFormat and ExportModelAsMpsFormat.
+  // The buffer is shared by all the constraints to avoid an allocation per
+  // constraint.
+  std::vector<std::pair<int, double>> linear_term;
+  output_model->mutable_constraint()->Reserve(constraints_.size());
   for (MPConstraint* const constraint : constraints_) {
     MPConstraintProto* constraint_proto;
     if (constraint->indicator_variable() != nullptr) {
@@ -1250,23 +1248,19 @@ void MPSolver::ExportModelToProto(MPModelProto* output_model) const {
     constraint_proto->set_lower_bound(constraint->lb());
     constraint_proto->set_upper_bound(constraint->ub());
     constraint_proto->set_is_lazy(constraint->is_lazy());
-    // Vector linear_term will contain pairs (variable index, coeff), that will
-    // be sorted by variable index.
-    std::vector<std::pair<int, double>> linear_term;
-    for (const auto& entry : constraint->coefficients_) {
-      const MPVariable* const var = entry.first;
-      const int var_index = gtl::FindWithDefault(var_to_index, var, -1);
-      DCHECK_NE(-1, var_index);
-      const double coeff = entry.second;
-      linear_term.push_back(std::pair<int, double>(var_index, coeff));
+    linear_term.clear();
+    for (const auto& [var, coeff] : constraint->coefficients_) {
+      DCHECK_EQ(variables_[var->index()], var);
+      linear_term.push_back({var->index(), coeff});
     }
     // The cost of sort is expected to be low as constraints usually have very
     // few terms.
     std::sort(linear_term.begin(), linear_term.end());
-    // Now use linear term.
-    for (const std::pair<int, double>& var_and_coeff : linear_term) {
-      constraint_proto->add_var_index(var_and_coeff.first);
-      constraint_proto->add_coefficient(var_and_coeff.second);
+    constraint_proto->mutable_var_index()->Reserve(linear_term.size());
+    constraint_proto->mutable_coefficient()->Reserve(linear_term.size());
+    for (const auto& [var_index, coeff] : linear_term) {
+      constraint_proto->add_var_index(var_index);
+      constraint_proto->add_coefficient(coeff);
     }
   }
 
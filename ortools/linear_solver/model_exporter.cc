@@ -14,7 +14,9 @@
 #include "ortools/linear_solver/model_exporter.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <string>
@@ -34,7 +36,9 @@
 #include "ortools/base/logging.h"
 #include "ortools/base/options.h"
 #include "ortools/base/status_macros.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
+#include "ortools/util/fp_roundtrip_conv.h"
 
 ABSL_RETIRED_FLAG(bool, lp_log_invalid_name, false, "DEPRECATED.");
 
@@ -140,13 +144,27 @@ class MPModelProtoExporter {
   // hand side (_rhs).
   bool AppendConstraint(const MPConstraintProto& ct_proto,
                         const std::string& name, LineBreaker& line_breaker,
-                        std::vector<bool>& show_variable, std::string* output);
+                        std::string* output) const;
+
+  // Appends the linear constraints to the output text, formatting them on
+  // options.num_threads threads for large models.
+  bool AppendLinearConstraints(const MPModelExportOptions& options,
+                               std::string* output) const;
+
+  // Appends the linear constraints with index in [begin, end) to the output
+  // text.
+  bool AppendLinearConstraintRange(int begin, int end, int max_line_length,
+                                   std::string* output) const;
 
   // Clears "output" and writes a term to it, in "LP" format. Returns false on
   // error (for example, var_index is out of range).
   bool WriteLpTerm(int var_index, double coefficient,
                    std::string* output) const;
 
+  // Formats a number of the model, exactly if exact_doubles_ is true.
+  std::string DoubleToString(double d) const;
+  std::string DoubleToStringWithForcedSign(double d) const;
+
   // Appends a pair name, value to "output", formatted to comply with the MPS
   // standard.
   void AppendMpsPair(const std::string& name, double value,
@@ -190,6 +208,9 @@ class MPModelProtoExporter {
 
   const MPModelProto& proto_;
 
+  // Whether the numbers are formatted so that they can be parsed back exactly.
+  bool exact_doubles_ = false;
+
   // Vector of variable names as they will be exported.
   std::vector<std::string> exported_variable_names_;
 
@@ -380,21 +401,20 @@ void MPModelProtoExporter::AppendComments(const std::string& separator,
                         num_continuous_variables_);
 }
 
-namespace {
-
-std::string DoubleToStringWithForcedSign(double d) {
-  return absl::StrCat((d < 0 ? "" : "+"), (d));
+std::string MPModelProtoExporter::DoubleToString(double d) const {
+  if (exact_doubles_) return RoundTripDoubleFormat::ToString(d);
+  return absl::StrCat((d));
 }
 
-std::string DoubleToString(double d) { return absl::StrCat((d)); }
-
-}  // namespace
+std::string MPModelProtoExporter::DoubleToStringWithForcedSign(
+    double d) const {
+  return absl::StrCat((d < 0 ? "" : "+"), DoubleToString(d));
+}
 
 bool MPModelProtoExporter::AppendConstraint(const MPConstraintProto& ct_proto,
                                             const std::string& name,
                                             LineBreaker& line_breaker,
-                                            std::vector<bool>& show_variable,
-                                            std::string* output) {
+                                            std::string* output) const {
   for (int i = 0; i < ct_proto.var_index_size(); ++i) {
     const int var_index = ct_proto.var_index(i);
     const double coeff = ct_proto.coefficient(i);
@@ -403,7 +423,6 @@ bool MPModelProtoExporter::AppendConstraint(const MPConstraintProto& ct_proto,
       return false;
     }
     line_breaker.Append(term);
-    show_variable[var_index] = coeff != 0.0 || show_variable[var_index];
   }
 
   const double lb = ct_proto.lower_bound();
@@ -441,6 +460,62 @@ bool MPModelProtoExporter::AppendConstraint(const MPConstraintProto& ct_proto,
   return true;
 }
 
+bool MPModelProtoExporter::AppendLinearConstraintRange(
+    int begin, int end, int max_line_length, std::string* output) const {
+  for (int cst_index = begin; cst_index < end; ++cst_index) {
+    const MPConstraintProto& ct_proto = proto_.constraint(cst_index);
+    const std::string& name = exported_constraint_names_[cst_index];
+    LineBreaker line_breaker(max_line_length);
+    const int kNumFormattingChars = 10;  // Overevaluated.
+    // Account for the size of the constraint name + possibly "_rhs" +
+    // the formatting characters here.
+    line_breaker.Consume(kNumFormattingChars + name.size());
+    if (!AppendConstraint(ct_proto, name, line_breaker, output)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MPModelProtoExporter::AppendLinearConstraints(
+    const MPModelExportOptions& options, std::string* output) const {
+  // Smaller chunks are not worth the cost of a thread.
+  const int kMinConstraintsPerChunk = 1000;
+  const int num_constraints = proto_.constraint_size();
+  const int num_chunks = std::min(options.num_threads,
+                                  num_constraints / kMinConstraintsPerChunk);
+  if (num_chunks <= 1) {
+    return AppendLinearConstraintRange(0, num_constraints,
+                                       options.max_line_length, output);
+  }
+  // Each chunk of consecutive constraints is formatted in its own string, and
+  // the strings are concatenated in order so that the output does not depend
+  // on the number of threads.
+  std::vector<std::string> chunk_outputs(num_chunks);
+  std::atomic<bool> ok = true;
+  {
+    ThreadPool pool("LpExporter", num_chunks);
+    pool.StartWorkers();
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+      pool.Schedule([&, chunk]() {
+        const int begin =
+            static_cast<int64_t>(num_constraints) * chunk / num_chunks;
+        const int end =
+            static_cast<int64_t>(num_constraints) * (chunk + 1) / num_chunks;
+        if (!AppendLinearConstraintRange(begin, end, options.max_line_length,
+                                         &chunk_outputs[chunk])) {
+          ok = false;
+        }
+      });
+    }
+  }
+  if (!ok) return false;
+  for (const std::string& chunk_output : chunk_outputs) {
+    absl::StrAppend(output, chunk_output);
+  }
+  return true;
+}
+
 bool MPModelProtoExporter::WriteLpTerm(int var_index, double coefficient,
                                        std::string* output) const {
   output->clear();
@@ -465,10 +540,6 @@ void UpdateMaxSize(const std::string& new_string, int* size) {
   const int new_size = new_string.size();
   if (new_size > *size) *size = new_size;
 }
-
-void UpdateMaxSize(double new_number, int* size) {
-  UpdateMaxSize(DoubleToString(new_number), size);
-}
 }  // namespace
 
 void MPModelProtoExporter::Setup() {
@@ -495,17 +566,18 @@ void MPModelProtoExporter::ComputeMpsSmartColumnWidths(bool obfuscated) {
 
   for (const MPVariableProto& var : proto_.variable()) {
     UpdateMaxSize(var.name(), &string_field_size);
-    UpdateMaxSize(var.objective_coefficient(), &number_field_size);
-    UpdateMaxSize(var.lower_bound(), &number_field_size);
-    UpdateMaxSize(var.upper_bound(), &number_field_size);
+    UpdateMaxSize(DoubleToString(var.objective_coefficient()),
+                  &number_field_size);
+    UpdateMaxSize(DoubleToString(var.lower_bound()), &number_field_size);
+    UpdateMaxSize(DoubleToString(var.upper_bound()), &number_field_size);
   }
 
   for (const MPConstraintProto& cst : proto_.constraint()) {
     UpdateMaxSize(cst.name(), &string_field_size);
-    UpdateMaxSize(cst.lower_bound(), &number_field_size);
-    UpdateMaxSize(cst.upper_bound(), &number_field_size);
+    UpdateMaxSize(DoubleToString(cst.lower_bound()), &number_field_size);
+    UpdateMaxSize(DoubleToString(cst.upper_bound()), &number_field_size);
     for (const double coeff : cst.coefficient()) {
-      UpdateMaxSize(coeff, &number_field_size);
+      UpdateMaxSize(DoubleToString(coeff), &number_field_size);
     }
   }
 
@@ -533,6 +605,7 @@ void MPModelProtoExporter::ComputeMpsSmartColumnWidths(bool obfuscated) {
 bool MPModelProtoExporter::ExportModelAsLpFormat(
     const MPModelExportOptions& options, std::string* output) {
   output->clear();
+  exact_doubles_ = options.exact_doubles;
   Setup();
   const std::string kForbiddenFirstChars = "$.0123456789";
   const std::string kForbiddenChars = " +-*/<>=:\\";
@@ -573,19 +646,17 @@ bool MPModelProtoExporter::ExportModelAsLpFormat(
   }
   // Linear Constraints
   absl::StrAppend(output, obj_line_breaker.GetOutput(), "\nSubject to\n");
-  for (int cst_index = 0; cst_index < proto_.constraint_size(); ++cst_index) {
-    const MPConstraintProto& ct_proto = proto_.constraint(cst_index);
-    const std::string& name = exported_constraint_names_[cst_index];
-    LineBreaker line_breaker(options.max_line_length);
-    const int kNumFormattingChars = 10;  // Overevaluated.
-    // Account for the size of the constraint name + possibly "_rhs" +
-    // the formatting characters here.
-    line_breaker.Consume(kNumFormattingChars + name.size());
-    if (!AppendConstraint(ct_proto, name, line_breaker, show_variable,
-                          output)) {
-      return false;
+  for (const MPConstraintProto& ct_proto : proto_.constraint()) {
+    for (int i = 0; i < ct_proto.var_index_size(); ++i) {
+      const int var_index = ct_proto.var_index(i);
+      // Out-of-bounds indices are reported by AppendLinearConstraints().
+      if (var_index < 0 || var_index >= proto_.variable_size()) continue;
+      if (ct_proto.coefficient(i) != 0.0) show_variable[var_index] = true;
     }
   }
+  if (!AppendLinearConstraints(options, output)) {
+    return false;
+  }
 
   // General Constraints
   for (int cst_index = 0; cst_index < proto_.general_constraint_size();
@@ -611,9 +682,15 @@ bool MPModelProtoExporter::ExportModelAsLpFormat(
         "%s = %d -> ", exported_variable_names_[binary_var_index],
         binary_var_value));
     if (!AppendConstraint(indicator_ct.constraint(), name, line_breaker,
-                          show_variable, output)) {
+                          output)) {
       return false;
     }
+    const MPConstraintProto& constraint = indicator_ct.constraint();
+    for (int i = 0; i < constraint.var_index_size(); ++i) {
+      if (constraint.coefficient(i) != 0.0) {
+        show_variable[constraint.var_index(i)] = true;
+      }
+    }
   }
 
   // Bounds
@@ -748,6 +825,7 @@ void MPModelProtoExporter::AppendMpsColumns(
 bool MPModelProtoExporter::ExportModelAsMpsFormat(
     const MPModelExportOptions& options, std::string* output) {
   output->clear();
+  exact_doubles_ = options.exact_doubles;
   Setup();
   ComputeMpsSmartColumnWidths(options.obfuscate);
   const std::string kForbiddenFirstChars = "";
@@ -41,6 +41,19 @@ struct MPModelExportOptions {
    * was chosen so that SCIP can read the files.
    */
   int max_line_length = 10000;
+
+  /**
+   * Whether doubles are written with the shortest representation that parses
+   * back to the same value. When false, they are written with 6 significant
+   * digits, which may change the model when it is read back.
+   */
+  bool exact_doubles = false;
+
+  /**
+   * For .lp files only. Number of threads used to format the constraints of
+   * large models. The output does not depend on the number of threads.
+   */
+  int num_threads = 1;
 };
 
 /**
@@ -100,6 +100,7 @@ void BuildModelFromSparseData(
                      " in constraint_matrix. Expected: ", num_constraints));
   }
 
+  model_proto->mutable_variable()->Reserve(num_variables);
   for (int i = 0; i < num_variables; ++i) {
     MPVariableProto* variable = model_proto->add_variable();
     variable->set_lower_bound(variable_lower_bounds[i]);
@@ -107,10 +108,15 @@ void BuildModelFromSparseData(
     variable->set_objective_coefficient(objective_coefficients[i]);
   }
 
+  model_proto->mutable_constraint()->Reserve(num_constraints);
   for (int row = 0; row < num_constraints; ++row) {
     MPConstraintProto* constraint = model_proto->add_constraint();
     constraint->set_lower_bound(constraint_lower_bounds[row]);
     constraint->set_upper_bound(constraint_upper_bounds[row]);
+    const int row_size = constraint_matrix.outerIndexPtr()[row + 1] -
+                         constraint_matrix.outerIndexPtr()[row];
+    constraint->mutable_coefficient()->Reserve(row_size);
+    constraint->mutable_var_index()->Reserve(row_size);
     for (SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(
              constraint_matrix, row);
          it; ++it) {
@@ -569,8 +569,13 @@ void ModelSolverHelper::Solve(const ModelBuilderHelper& model) {
     return;
   }
 
+  // The request borrows the model instead of copying it, as it can be very
+  // large. This is safe because the solvers only see the request through a
+  // LazyMutableCopy of a const reference: a solver that needs to modify it
+  // works on its own copy.
   MPModelRequest request;
-  *request.mutable_model() = model.model();
+  request.unsafe_arena_set_allocated_model(
+      const_cast<MPModelProto*>(&model.model()));
   request.set_solver_type(solver_type_.value());
   request.set_enable_internal_solver_output(solver_output_);
   if (time_limit_in_second_.has_value()) {
@@ -581,20 +586,19 @@ void ModelSolverHelper::Solve(const ModelBuilderHelper& model) {
   }
   switch (solver_type_.value()) {
     case MPModelRequest::GLOP_LINEAR_PROGRAMMING: {
-      response_ =
-          GlopSolveProto(std::move(request), &interrupt_solve_, log_callback_);
+      response_ = GlopSolveProto(request, &interrupt_solve_, log_callback_);
       break;
     }
     case MPModelRequest::SAT_INTEGER_PROGRAMMING: {
-      response_ = SatSolveProto(std::move(request), &interrupt_solve_,
-                                log_callback_, nullptr);
+      response_ = SatSolveProto(request, &interrupt_solve_, log_callback_,
+                                nullptr);
       break;
     }
 #if defined(USE_SCIP)
     case MPModelRequest::SCIP_MIXED_INTEGER_PROGRAMMING: {
       // TODO(user): Enable log_callback support.
       // TODO(user): Enable interrupt_solve.
-      const auto temp = ScipSolveProto(std::move(request));
+      const auto temp = ScipSolveProto(request);
       if (temp.ok()) {
         response_ = std::move(temp.value());
       }
@@ -603,7 +607,7 @@ void ModelSolverHelper::Solve(const ModelBuilderHelper& model) {
 #endif  // defined(USE_SCIP)
 #if defined(USE_PDLP)
     case MPModelRequest::PDLP_LINEAR_PROGRAMMING: {
-      const auto temp = PdlpSolveProto(std::move(request));
+      const auto temp = PdlpSolveProto(request);
       if (temp.ok()) {
         response_ = std::move(temp.value());
       }
@@ -613,7 +617,7 @@ void ModelSolverHelper::Solve(const ModelBuilderHelper& model) {
     case MPModelRequest::
         GUROBI_LINEAR_PROGRAMMING:  // ABSL_FALLTHROUGH_INTENDED
     case MPModelRequest::GUROBI_MIXED_INTEGER_PROGRAMMING: {
-      const auto temp = GurobiSolveProto(std::move(request));
+      const auto temp = GurobiSolveProto(request);
       if (temp.ok()) {
         response_ = std::move(temp.value());
       }
@@ -624,7 +628,7 @@ void ModelSolverHelper::Solve(const ModelBuilderHelper& model) {
     case MPModelRequest::HIGHS_MIXED_INTEGER_PROGRAMMING: {
       // TODO(user): Enable log_callback support.
       // TODO(user): Enable interrupt_solve.
-      const auto temp = HighsSolveProto(std::move(request));
+      const auto temp = HighsSolveProto(request);
       if (temp.ok()) {
         response_ = std::move(temp.value());
       }
@@ -642,6 +646,8 @@ void ModelSolverHelper::Solve(const ModelBuilderHelper& model) {
           MPSolverResponseStatus::MPSOLVER_SOLVER_TYPE_UNAVAILABLE);
     }
   }
+  // Gives the model back before the request is destroyed.
+  request.unsafe_arena_release_model();
   if (response_->status() == MPSOLVER_OPTIMAL ||
       response_->status() == MPSOLVER_FEASIBLE) {
     model_of_last_solve_ = &model.model();
@@ -24,7 +24,6 @@
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/sparse.h"
 #include "ortools/lp_data/sparse_column.h"
-#include "ortools/util/bitset.h"
 
 namespace operations_research {
 namespace glop {
@@ -33,12 +32,16 @@ namespace glop {
 // LPDecomposer
 //------------------------------------------------------------------------------
 LPDecomposer::LPDecomposer()
-    : original_problem_(nullptr), clusters_(), mutex_() {}
+    : original_problem_(nullptr),
+      clusters_(),
+      constraint_clusters_(),
+      mutex_() {}
 
 void LPDecomposer::Decompose(const LinearProgram* linear_problem) {
   absl::MutexLock mutex_lock(&mutex_);
   original_problem_ = linear_problem;
   clusters_.clear();
+  constraint_clusters_.clear();
 
   const SparseMatrix& transposed_matrix =
       original_problem_->GetTransposeSparseMatrix();
@@ -66,6 +69,16 @@ void LPDecomposer::Decompose(const LinearProgram* linear_problem) {
   for (int i = 0; i < num_classes; ++i) {
     std::sort(clusters_[i].begin(), clusters_[i].end());
   }
+
+  // All the variables of a constraint are in the same class, so we use the
+  // first one. The constraints are added in increasing order.
+  constraint_clusters_.resize(num_classes);
+  for (ColIndex ct(0); ct < num_ct; ++ct) {
+    const SparseColumn& sparse_constraint = transposed_matrix.column(ct);
+    if (sparse_constraint.IsEmpty()) continue;
+    const int cluster = classes[sparse_constraint.GetFirstRow().value()];
+    constraint_clusters_[cluster].push_back(ColToRowIndex(ct));
+  }
 }
 
 int LPDecomposer::GetNumberOfProblems() const {
@@ -89,12 +102,9 @@ void LPDecomposer::ExtractLocalProblem(int problem_index, LinearProgram* lp) {
   const std::vector<ColIndex>& cluster = clusters_[problem_index];
   StrictITIVector<ColIndex, ColIndex> global_to_local(
       original_problem_->num_variables(), kInvalidCol);
-  SparseBitset<RowIndex> constraints_to_use(
-      original_problem_->num_constraints());
   lp->SetMaximizationProblem(original_problem_->IsMaximizationProblem());
 
   // Create variables and get all constraints of the cluster.
-  const SparseMatrix& original_matrix = original_problem_->GetSparseMatrix();
   const SparseMatrix& transposed_matrix =
       original_problem_->GetTransposeSparseMatrix();
   for (int i = 0; i < cluster.size(); ++i) {
@@ -115,14 +125,9 @@ void LPDecomposer::ExtractLocalProblem(int problem_index, LinearProgram* lp) {
         original_problem_->variable_upper_bounds()[global_col]);
     lp->SetObjectiveCoefficient(
         local_col, original_problem_->objective_coefficients()[global_col]);
-
-    for (const SparseColumn::Entry e : original_matrix.column(global_col)) {
-      constraints_to_use.Set(e.row());
-    }
   }
   // Create the constraints.
-  for (const RowIndex global_row :
-       constraints_to_use.PositionsSetAtLeastOnce()) {
+  for (const RowIndex global_row : constraint_clusters_[problem_index]) {
     const RowIndex local_row = lp->CreateNewConstraint();
     lp->SetConstraintName(local_row,
                           original_problem_->GetConstraintName(global_row));
@@ -173,5 +178,23 @@ DenseRow LPDecomposer::ExtractLocalAssignment(int problem_index,
   return local_assignment;
 }
 
+std::vector<ColIndex> LPDecomposer::GetProblemVariables(
+    int problem_index) const {
+  CHECK_GE(problem_index, 0);
+  CHECK_LT(problem_index, clusters_.size());
+
+  absl::MutexLock mutex_lock(&mutex_);
+  return clusters_[problem_index];
+}
+
+std::vector<RowIndex> LPDecomposer::GetProblemConstraints(
+    int problem_index) const {
+  CHECK_GE(problem_index, 0);
+  CHECK_LT(problem_index, constraint_clusters_.size());
+
+  absl::MutexLock mutex_lock(&mutex_);
+  return constraint_clusters_[problem_index];
+}
+
 }  // namespace glop
 }  // namespace operations_research
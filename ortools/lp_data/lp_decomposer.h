@@ -85,9 +85,19 @@ class LPDecomposer {
   DenseRow ExtractLocalAssignment(int problem_index, const DenseRow& assignment)
       ABSL_LOCKS_EXCLUDED(mutex_);
 
+  // Returns the variables (resp. constraints) of the original problem that
+  // form the given subproblem. The i-th one corresponds to the i-th variable
+  // (resp. constraint) of the problem filled by ExtractLocalProblem(). Note
+  // that the constraints without any entries are not part of any subproblem.
+  std::vector<ColIndex> GetProblemVariables(int problem_index) const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+  std::vector<RowIndex> GetProblemConstraints(int problem_index) const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
  private:
   const LinearProgram* original_problem_;
   std::vector<std::vector<ColIndex>> clusters_;
+  std::vector<std::vector<RowIndex>> constraint_clusters_;
 
   mutable absl::Mutex mutex_;
 };
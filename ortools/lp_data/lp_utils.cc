@@ -20,6 +20,7 @@
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/scattered_vector.h"
 #include "ortools/lp_data/sparse_column.h"
+#include "ortools/util/vector_sum.h"
 
 namespace operations_research {
 namespace glop {
@@ -141,11 +142,8 @@ Fractional SquaredNorm(const DenseColumn& column) {
 }
 
 Fractional PreciseSquaredNorm(const DenseColumn& column) {
-  KahanSum sum;
-  for (RowIndex row(0); row < column.size(); ++row) {
-    sum.Add(Square(column[row]));
-  }
-  return sum.Value();
+  return AccurateSquaredNorm(
+      absl::MakeConstSpan(column.data(), column.size().value()));
 }
 
 Fractional InfinityNorm(const DenseColumn& v) {
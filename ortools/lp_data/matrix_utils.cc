@@ -19,12 +19,18 @@
 #include <limits>
 #include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
 #include "ortools/base/hash.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/lp_data/sparse.h"
 #include "ortools/lp_data/sparse_column.h"
 
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
+
 namespace operations_research {
 namespace glop {
 
@@ -118,44 +124,113 @@ ColumnFingerprint ComputeFingerprint(ColIndex col, const SparseColumn& column) {
                            inverse_dynamic_range + scaled_average);
 }
 
+// Calls f(begin, end) on consecutive ranges covering [0, shard_ends.back())
+// in parallel, the ranges being [0, shard_ends[0]), [shard_ends[0],
+// shard_ends[1]) and so on.
+void RunShardsInParallel(const std::vector<int>& shard_ends,
+                         absl::FunctionRef<void(int, int)> f) {
+  const int num_shards = shard_ends.size();
+  if (num_shards == 1) {
+    f(0, shard_ends[0]);
+    return;
+  }
+#if !defined(__PORTABLE_PLATFORM__)
+  ThreadPool pool("ProportionalColumns", num_shards - 1);
+  pool.StartWorkers();
+  absl::BlockingCounter counter(num_shards - 1);
+  for (int shard = 1; shard < num_shards; ++shard) {
+    pool.Schedule([&, shard]() {
+      f(shard_ends[shard - 1], shard_ends[shard]);
+      counter.DecrementCount();
+    });
+  }
+  f(0, shard_ends[0]);
+  counter.Wait();
+#endif  // __PORTABLE_PLATFORM__
+}
+
+// Returns num_shards ends of ranges of about equal size covering [0, size).
+std::vector<int> UniformShardEnds(int size, int num_shards) {
+  std::vector<int> shard_ends;
+  for (int shard = 1; shard <= num_shards; ++shard) {
+    shard_ends.push_back(static_cast<int64_t>(size) * shard / num_shards);
+  }
+  return shard_ends;
+}
+
 }  // namespace
 
 ColMapping FindProportionalColumns(const SparseMatrix& matrix,
-                                   Fractional tolerance) {
+                                   Fractional tolerance, int num_threads) {
   const ColIndex num_cols = matrix.num_cols();
   ColMapping mapping(num_cols, kInvalidCol);
 
+  // There is not enough work to use threads on small matrices.
+  const int kMinColumnsPerThread = 10000;
+#if defined(__PORTABLE_PLATFORM__)
+  num_threads = 1;
+#endif  // __PORTABLE_PLATFORM__
+  num_threads = std::max(
+      1, std::min(num_threads, num_cols.value() / kMinColumnsPerThread));
+
   // Compute the fingerprint of each columns and sort them.
-  std::vector<ColumnFingerprint> fingerprints;
+  std::vector<ColIndex> non_empty_cols;
   for (ColIndex col(0); col < num_cols; ++col) {
-    if (!matrix.column(col).IsEmpty()) {
-      fingerprints.push_back(ComputeFingerprint(col, matrix.column(col)));
-    }
+    if (!matrix.column(col).IsEmpty()) non_empty_cols.push_back(col);
   }
+  const int num_fingerprints = non_empty_cols.size();
+  std::vector<ColumnFingerprint> fingerprints(
+      num_fingerprints, ColumnFingerprint(kInvalidCol, 0, 0.0));
+  RunShardsInParallel(UniformShardEnds(num_fingerprints, num_threads),
+                      [&](int begin, int end) {
+                        for (int i = begin; i < end; ++i) {
+                          const ColIndex col = non_empty_cols[i];
+                          fingerprints[i] =
+                              ComputeFingerprint(col, matrix.column(col));
+                        }
+                      });
   std::sort(fingerprints.begin(), fingerprints.end());
 
+  // Only the columns with the same hash are compared, so we can process the
+  // ranges of equal hash independently. We move the uniform shard ends to the
+  // end of their range of equal hash.
+  std::vector<int> shard_ends;
+  for (int end : UniformShardEnds(num_fingerprints, num_threads)) {
+    if (!shard_ends.empty()) end = std::max(end, shard_ends.back());
+    while (end > 0 && end < num_fingerprints &&
+           fingerprints[end].hash == fingerprints[end - 1].hash) {
+      ++end;
+    }
+    if (shard_ends.empty() || end > shard_ends.back()) {
+      shard_ends.push_back(end);
+    }
+  }
+  if (shard_ends.empty()) shard_ends.push_back(0);
+
   // Find a representative of each proportional columns class. This only
   // compares columns with a close-enough fingerprint.
-  for (int i = 0; i < fingerprints.size(); ++i) {
-    const ColIndex col_a = fingerprints[i].col;
-    if (mapping[col_a] != kInvalidCol) continue;
-    for (int j = i + 1; j < fingerprints.size(); ++j) {
-      const ColIndex col_b = fingerprints[j].col;
-      if (mapping[col_b] != kInvalidCol) continue;
+  RunShardsInParallel(shard_ends, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      const ColIndex col_a = fingerprints[i].col;
+      if (mapping[col_a] != kInvalidCol) continue;
+      for (int j = i + 1; j < end; ++j) {
+        const ColIndex col_b = fingerprints[j].col;
+        if (mapping[col_b] != kInvalidCol) continue;
 
-      // Note that we use the same tolerance for the fingerprints.
-      // TODO(user): Derive precise bounds on what this tolerance should be so
-      // that no proportional columns are missed.
-      if (!AreProportionalCandidates(fingerprints[i], fingerprints[j],
-                                     tolerance)) {
-        break;
-      }
-      if (AreColumnsProportional(matrix.column(col_a), matrix.column(col_b),
-                                 tolerance)) {
-        mapping[col_b] = col_a;
+        // Note that we use the same tolerance for the fingerprints.
+        // TODO(user): Derive precise bounds on what this tolerance should be so
+        // that no proportional columns are missed.
+        if (!AreProportionalCandidates(fingerprints[i], fingerprints[j],
+                                       tolerance)) {
+          break;
+        }
+        if (AreColumnsProportional(matrix.column(col_a), matrix.column(col_b),
+                                   tolerance)) {
+          mapping[col_b] = col_a;
+        }
       }
     }
-  }
+  });
 
   // Sort the mapping so that the representative of each class is the smallest
   // column. To achieve this, the current representative is used as a pointer
@@ -14,14 +14,20 @@
 #include "ortools/lp_data/mps_reader_template.h"
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "ortools/base/file.h"
 #include "ortools/base/status_macros.h"
+#include "zlib.h"
 
 namespace operations_research::internal {
 namespace {
@@ -136,4 +142,81 @@ absl::Status MPSLineInfo::AppendLineToError(const absl::Status& status) const {
          << " Line " << line_num_ << ": \"" << line_ << "\".";
 }
 
+absl::Status ForEachLineOfGzipFile(
+    absl::string_view file_name,
+    absl::FunctionRef<absl::Status(absl::string_view line)> process_line) {
+  File* file = nullptr;
+  RETURN_IF_ERROR(file::Open(file_name, "r", &file, file::Defaults()));
+  z_stream stream = {};
+  // The extra 32 detects the gzip or zlib headers automatically.
+  if (inflateInit2(&stream, /*windowBits=*/15 + 32) != Z_OK) {
+    file->Close(file::Defaults()).IgnoreError();
+    return absl::InternalError("Cannot initialize zlib decompression.");
+  }
+
+  // Processes the complete lines of the decompressed chunks, the last partial
+  // line is kept in partial_line until the next chunk.
+  constexpr int kChunkSize = 1 << 20;
+  std::vector<char> input(kChunkSize);
+  std::vector<char> output(kChunkSize);
+  std::string partial_line;
+  bool at_stream_end = false;
+  bool output_is_full = false;
+  absl::Status status;
+  while (status.ok()) {
+    // When the output was full, zlib may still have some pending output even
+    // if all the input was consumed.
+    if (stream.avail_in == 0 && !output_is_full) {
+      const size_t num_read = file->Read(input.data(), input.size());
+      if (num_read == 0) break;
+      stream.next_in = reinterpret_cast<Bytef*>(input.data());
+      stream.avail_in = num_read;
+    }
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = output.size();
+    const int zlib_status = inflate(&stream, Z_NO_FLUSH);
+    // Z_BUF_ERROR only means that no progress was possible, more input is
+    // needed in this case.
+    if (zlib_status != Z_OK && zlib_status != Z_STREAM_END &&
+        zlib_status != Z_BUF_ERROR) {
+      status = absl::InvalidArgumentError(absl::StrCat(
+          "Error while decompressing '", file_name, "': ",
+          stream.msg == nullptr ? "" : stream.msg));
+      break;
+    }
+    absl::string_view chunk(output.data(), output.size() - stream.avail_out);
+    while (status.ok() && !chunk.empty()) {
+      const size_t end = chunk.find('\n');
+      if (end == absl::string_view::npos) {
+        partial_line.append(chunk);
+        break;
+      }
+      if (partial_line.empty()) {
+        status = process_line(chunk.substr(0, end));
+      } else {
+        partial_line.append(chunk.substr(0, end));
+        status = process_line(partial_line);
+        partial_line.clear();
+      }
+      chunk.remove_prefix(end + 1);
+    }
+    output_is_full = stream.avail_out == 0;
+    if (zlib_status == Z_STREAM_END) {
+      at_stream_end = true;
+      inflateReset(&stream);
+    } else if (zlib_status == Z_OK) {
+      at_stream_end = false;
+    }
+  }
+  inflateEnd(&stream);
+  file->Close(file::Defaults()).IgnoreError();
+  RETURN_IF_ERROR(status);
+  if (!at_stream_end) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Truncated compressed file '", file_name, "'."));
+  }
+  if (!partial_line.empty()) return process_line(partial_line);
+  return absl::OkStatus();
+}
+
 }  //  namespace operations_research::internal
@@ -282,6 +282,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -409,6 +410,14 @@ class MPSLineInfo {
   const absl::string_view line_;
 };
 
+// Decompresses the gzip (or zlib) file `file_name` on the fly, and calls
+// `process_line` on each of its lines, without the trailing '\n'. As with the
+// gzip command line tool, concatenated compressed streams are all processed.
+// Stops and returns the first error.
+absl::Status ForEachLineOfGzipFile(
+    absl::string_view file_name,
+    absl::FunctionRef<absl::Status(absl::string_view line)> process_line);
+
 }  // namespace internal
 
 // Templated `MPS` reader. The template class `DataWrapper` must provide:
@@ -503,6 +512,8 @@ class MPSReaderTemplate {
   // or `kFree`, the function will either return `kFixed` (or `kFree`
   // respectivelly) if the input data satisfies the format, or an
   // `absl::InvalidArgumentError` otherwise.
+  //
+  // Files whose name ends with ".gz" are decompressed while being parsed.
   absl::StatusOr<MPSReaderFormat> ParseFile(
       absl::string_view file_name, DataWrapper* data,
       MPSReaderFormat form = MPSReaderFormat::kAutoDetect);
@@ -643,6 +654,11 @@ class MPSReaderTemplate {
   // and INTEND that ends it.
   bool in_integer_section_;
 
+  // The name and index of the column of the last line of the COLUMNS section.
+  // The name is cleared by the markers and the section changes.
+  std::string last_column_name_;
+  IndexType last_column_;
+
   // We keep track of the number of unconstrained rows so we can display it to
   // the user because other solvers usually ignore them and we don't (they will
   // be removed in the preprocessor).
@@ -668,11 +684,18 @@ absl::StatusOr<MPSReaderFormat> MPSReaderTemplate<DataWrapper>::ParseFile(
   free_form_ = form == MPSReaderFormat::kFree;
   Reset();
   data->SetUp();
-  File* file = nullptr;
-  RETURN_IF_ERROR(file::Open(file_name, "r", &file, file::Defaults()));
-  for (const absl::string_view line :
-       FileLines(file_name, file, FileLineIterator::REMOVE_INLINE_CR)) {
-    RETURN_IF_ERROR(ProcessLine(line, data));
+  if (absl::EndsWith(file_name, ".gz")) {
+    RETURN_IF_ERROR(internal::ForEachLineOfGzipFile(
+        file_name, [this, data](absl::string_view line) {
+          return ProcessLine(line, data);
+        }));
+  } else {
+    File* file = nullptr;
+    RETURN_IF_ERROR(file::Open(file_name, "r", &file, file::Defaults()));
+    for (const absl::string_view line :
+         FileLines(file_name, file, FileLineIterator::REMOVE_INLINE_CR)) {
+      RETURN_IF_ERROR(ProcessLine(line, data));
+    }
   }
   data->CleanUp();
   DisplaySummary();
@@ -714,6 +737,7 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessLine(absl::string_view line,
 
   // TODO(b/284163180): Fix handling of sections and data in `free_form`.
   if (line_info.IsNewSection()) {
+    last_column_name_.clear();
     if (const auto it = section_name_to_id_map_.find(line_info.GetFirstWord());
         it != section_name_to_id_map_.end()) {
       section_ = it->second;
@@ -854,6 +878,7 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessColumnsSection(
       }
       in_integer_section_ = false;
     }
+    last_column_name_.clear();
     return absl::OkStatus();
   }
   const int start_index = free_form_ ? 0 : 1;
@@ -864,16 +889,23 @@ absl::Status MPSReaderTemplate<DataWrapper>::ProcessColumnsSection(
   const absl::string_view column_name = line_info.GetField(start_index + 0);
   const absl::string_view row1_name = line_info.GetField(start_index + 1);
   const absl::string_view row1_value = line_info.GetField(start_index + 2);
-  const IndexType col = data->FindOrCreateVariable(column_name);
-  is_binary_by_default_.resize(col + 1, false);
-  if (in_integer_section_) {
-    data->SetVariableTypeToInteger(col);
-    // The default bounds for integer variables are [0, 1].
-    data->SetVariableBounds(col, 0.0, 1.0);
-    is_binary_by_default_[col] = true;
-  } else {
-    data->SetVariableBounds(col, 0.0, kInfinity);
+
+  // The entries of a column are usually on consecutive lines. In this case,
+  // the column was already looked up and set up by the previous line.
+  if (column_name != last_column_name_) {
+    last_column_ = data->FindOrCreateVariable(column_name);
+    last_column_name_ = std::string(column_name);
+    is_binary_by_default_.resize(last_column_ + 1, false);
+    if (in_integer_section_) {
+      data->SetVariableTypeToInteger(last_column_);
+      // The default bounds for integer variables are [0, 1].
+      data->SetVariableBounds(last_column_, 0.0, 1.0);
+      is_binary_by_default_[last_column_] = true;
+    } else {
+      data->SetVariableBounds(last_column_, 0.0, kInfinity);
+    }
   }
+  const IndexType col = last_column_;
   RETURN_IF_ERROR(
       StoreCoefficient(line_info, col, row1_name, row1_value, data));
   if (line_info.GetFieldsSize() == start_index + 4) {
@@ -1150,6 +1182,7 @@ MPSReaderTemplate<DataWrapper>::MPSReaderTemplate()
       integer_type_names_set_(),
       line_num_(0),
       in_integer_section_(false),
+      last_column_(0),
       num_unconstrained_rows_(0) {
   section_name_to_id_map_["NAME"] = internal::MPSSectionId::kName;
   section_name_to_id_map_["OBJSENSE"] = internal::MPSSectionId::kObjsense;
@@ -1185,6 +1218,7 @@ template <class DataWrapper>
 void MPSReaderTemplate<DataWrapper>::Reset() {
   line_num_ = 0;
   in_integer_section_ = false;
+  last_column_name_.clear();
   num_unconstrained_rows_ = 0;
   objective_name_.clear();
 }
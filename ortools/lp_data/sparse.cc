@@ -487,6 +487,33 @@ void CompactSparseMatrix::PopulateFromSparseMatrixAndAddSlacks(
   starts_[num_cols_] = index;
 }
 
+void CompactSparseMatrix::PopulateNewColumnsFromSparseMatrix(
+    const SparseMatrix& input, ColIndex num_unchanged_cols, bool add_slacks) {
+  DCHECK_EQ(num_rows_, input.num_rows());
+  DCHECK_LE(num_unchanged_cols, num_cols_);
+  DCHECK_LE(num_unchanged_cols, input.num_cols());
+  const EntryIndex num_unchanged_entries = starts_[num_unchanged_cols];
+  num_cols_ = num_unchanged_cols;
+  starts_.resize(num_cols_ + 1);
+  coefficients_.resize(num_unchanged_entries);
+  rows_.resize(num_unchanged_entries);
+  for (ColIndex col(num_unchanged_cols); col < input.num_cols(); ++col) {
+    for (const SparseColumn::Entry e : input.column(col)) {
+      coefficients_.push_back(e.coefficient());
+      rows_.push_back(e.row());
+    }
+    starts_.push_back(rows_.size());
+    ++num_cols_;
+  }
+  if (!add_slacks) return;
+  for (RowIndex row(0); row < num_rows_; ++row) {
+    coefficients_.push_back(1.0);
+    rows_.push_back(row);
+    starts_.push_back(rows_.size());
+    ++num_cols_;
+  }
+}
+
 void CompactSparseMatrix::PopulateFromTranspose(
     const CompactSparseMatrix& input) {
   num_cols_ = RowToColIndex(input.num_rows());
@@ -1450,16 +1477,48 @@ void TriangularMatrix::ComputeRowsToConsiderInSortedOrder(
   // TODO(user): Investigate the best thresholds.
   const int sparsity_threshold =
       static_cast<int>(0.025 * static_cast<double>(num_rows_.value()));
-  const int num_ops_threshold =
-      static_cast<int>(0.05 * static_cast<double>(num_rows_.value()));
-  int num_ops = non_zero_rows->size();
-  if (num_ops > sparsity_threshold) {
+  if (non_zero_rows->size() > sparsity_threshold) {
     non_zero_rows->clear();
     return;
   }
 
-  stored_.Resize(num_rows_);
-  for (const RowIndex row : *non_zero_rows) stored_.Set(row);
+  // The density of the result is at least the one of the input, so when we
+  // skip the symbolic phase, we move the prediction towards it. This way, we
+  // try again once the inputs are sparse enough.
+  const double num_rows = static_cast<double>(num_rows_.value());
+  if (predicted_result_density_ > kMaxPredictedResultDensity) {
+    UpdatePredictedResultDensity(non_zero_rows->size() / num_rows);
+    non_zero_rows->clear();
+    return;
+  }
+
+  if (ExpandRowsToConsiderInSortedOrder(non_zero_rows, &stored_)) {
+    UpdatePredictedResultDensity(non_zero_rows->size() / num_rows);
+  } else {
+    UpdatePredictedResultDensity(1.0);
+  }
+}
+
+void TriangularMatrix::ComputeRowsToConsiderInSortedOrder(
+    RowIndexVector* non_zero_rows, Bitset64<RowIndex>* stored) const {
+  if (non_zero_rows->empty()) return;
+  const int sparsity_threshold =
+      static_cast<int>(0.025 * static_cast<double>(num_rows_.value()));
+  if (non_zero_rows->size() > sparsity_threshold) {
+    non_zero_rows->clear();
+    return;
+  }
+  ExpandRowsToConsiderInSortedOrder(non_zero_rows, stored);
+}
+
+bool TriangularMatrix::ExpandRowsToConsiderInSortedOrder(
+    RowIndexVector* non_zero_rows, Bitset64<RowIndex>* stored) const {
+  const int num_ops_threshold =
+      static_cast<int>(0.05 * static_cast<double>(num_rows_.value()));
+  int num_ops = non_zero_rows->size();
+
+  stored->Resize(num_rows_);
+  for (const RowIndex row : *non_zero_rows) stored->Set(row);
 
   const auto entry_rows = rows_.view();
   for (int i = 0; i < non_zero_rows->size(); ++i) {
@@ -1467,21 +1526,27 @@ void TriangularMatrix::ComputeRowsToConsiderInSortedOrder(
     for (const EntryIndex index : Column(RowToColIndex(row))) {
       ++num_ops;
       const RowIndex entry_row = entry_rows[index];
-      if (!stored_[entry_row]) {
+      if (!(*stored)[entry_row]) {
         non_zero_rows->push_back(entry_row);
-        stored_.Set(entry_row);
+        stored->Set(entry_row);
       }
     }
     if (num_ops > num_ops_threshold) break;
   }
 
   if (num_ops > num_ops_threshold) {
-    stored_.ClearAll();
+    stored->ClearAll();
     non_zero_rows->clear();
-  } else {
-    std::sort(non_zero_rows->begin(), non_zero_rows->end());
-    for (const RowIndex row : *non_zero_rows) stored_.ClearBucket(row);
+    return false;
   }
+  std::sort(non_zero_rows->begin(), non_zero_rows->end());
+  for (const RowIndex row : *non_zero_rows) stored->ClearBucket(row);
+  return true;
+}
+
+void TriangularMatrix::UpdatePredictedResultDensity(double density) const {
+  predicted_result_density_ +=
+      kPredictedResultDensityWeight * (density - predicted_result_density_);
 }
 
 // A known upper bound for the infinity norm of T^{-1} is the
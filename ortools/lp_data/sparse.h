@@ -359,6 +359,15 @@ class CompactSparseMatrix {
   // matrix to the left of it.
   void PopulateFromSparseMatrixAndAddSlacks(const SparseMatrix& input);
 
+  // Same result as PopulateFromSparseMatrixAndAddSlacks() if add_slacks is
+  // true, or as PopulateFromMatrixView() otherwise, but only copies the
+  // columns of the input after the first num_unchanged_cols ones. This assumes
+  // that these first columns are already the same in this matrix, which must
+  // have the same number of rows as the input.
+  void PopulateNewColumnsFromSparseMatrix(const SparseMatrix& input,
+                                          ColIndex num_unchanged_cols,
+                                          bool add_slacks);
+
   // Creates a CompactSparseMatrix from the transpose of the given
   // CompactSparseMatrix. Note that the entries in each columns will be ordered
   // by row indices.
@@ -748,8 +757,18 @@ class TriangularMatrix : private CompactSparseMatrix {
   // sorted by rows. It is up to the client to call the direct or reverse
   // hyper-sparse solve function depending if the matrix is upper or lower
   // triangular.
+  //
+  // This keeps a prediction of the result density from the previous calls,
+  // and directly clears non_zero_rows without computing anything when the
+  // result is likely to be too dense for a hyper-sparse solve.
   void ComputeRowsToConsiderInSortedOrder(RowIndexVector* non_zero_rows) const;
 
+  // Thread-safe version of the function above that uses the given scratch
+  // bitset instead of the internal one and never updates the density
+  // prediction, so that the same matrix can be used from many threads.
+  void ComputeRowsToConsiderInSortedOrder(RowIndexVector* non_zero_rows,
+                                          Bitset64<RowIndex>* stored) const;
+
   // This is currently only used for testing. It achieves the same result as
   // PermutedLowerSparseSolve() below, but the latter exploits the sparsity of
   // rhs and is thus faster for our use case.
@@ -857,6 +876,15 @@ class TriangularMatrix : private CompactSparseMatrix {
   // a new column to a triangular matrix.
   void CloseCurrentColumn(Fractional diagonal_value);
 
+  // Common part of the ComputeRowsToConsiderInSortedOrder() functions, once
+  // the input was deemed sparse enough. Returns false, with non_zero_rows
+  // cleared, if the computation was aborted because the result was too dense.
+  bool ExpandRowsToConsiderInSortedOrder(RowIndexVector* non_zero_rows,
+                                         Bitset64<RowIndex>* stored) const;
+
+  // Updates predicted_result_density_ with the density of the last result.
+  void UpdatePredictedResultDensity(double density) const;
+
   // Extra data for "triangular" matrices. The diagonal coefficients are
   // stored in a separate vector instead of beeing stored in each column.
   StrictITIVector<ColIndex, Fractional> diagonal_coefficients_;
@@ -874,6 +902,15 @@ class TriangularMatrix : private CompactSparseMatrix {
   mutable Bitset64<RowIndex> stored_;
   mutable std::vector<RowIndex> nodes_to_explore_;
 
+  // Exponential moving average of the result densities of
+  // ComputeRowsToConsiderInSortedOrder(), an aborted computation counting as a
+  // fully dense result. This is the prediction used by Hall and McKinnon in
+  // the reference above. It is kept across Reset() since it mostly depends on
+  // the problem structure.
+  static constexpr double kMaxPredictedResultDensity = 0.1;
+  static constexpr double kPredictedResultDensityWeight = 0.1;
+  mutable double predicted_result_density_ = 0.0;
+
   // For PermutedLowerSparseSolve().
   int64_t num_fp_operations_;
   mutable std::vector<RowIndex> lower_column_rows_;
@@ -0,0 +1,171 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/math_opt/core/solver_pool.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/hash/hash.h"
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/message_lite.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/math_opt/core/solver.h"
+#include "ortools/math_opt/model.pb.h"
+#include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/parameters.pb.h"
+#include "ortools/math_opt/result.pb.h"
+#include "ortools/math_opt/storage/model_storage.h"
+
+namespace operations_research::math_opt {
+
+namespace {
+
+// Returns the serialization of the message, with the maps in a deterministic
+// order so that equal messages have equal serializations.
+std::string DeterministicSerialization(
+    const google::protobuf::MessageLite& message) {
+  std::string result;
+  {
+    google::protobuf::io::StringOutputStream stream(&result);
+    google::protobuf::io::CodedOutputStream coded_stream(&stream);
+    coded_stream.SetSerializationDeterministic(true);
+    message.SerializeToCodedStream(&coded_stream);
+  }
+  return result;
+}
+
+}  // namespace
+
+SolverPool::SolverPool(const int max_cached_models)
+    : max_cached_models_(max_cached_models) {
+  CHECK_GE(max_cached_models, 0);
+}
+
+SolverPool::ModelKey SolverPool::Key(
+    const SolverTypeProto solver_type, const ModelProto& model,
+    const SolverInitializerProto& initializer) {
+  return absl::HashOf(static_cast<int>(solver_type),
+                      DeterministicSerialization(initializer),
+                      DeterministicSerialization(model));
+}
+
+absl::StatusOr<SolveResultProto> SolverPool::Solve(
+    const SolverTypeProto solver_type, const ModelProto& model,
+    const SolverInitializerProto& initializer,
+    const Solver::SolveArgs& solve_args, ModelKey* const key) {
+  const ModelKey model_key = Key(solver_type, model, initializer);
+  std::unique_ptr<Entry> entry = Take(model_key);
+  if (entry == nullptr) {
+    entry = std::make_unique<Entry>();
+    entry->solver_type = solver_type;
+    entry->initializer = initializer;
+    ASSIGN_OR_RETURN(entry->model, ModelStorage::FromModelProto(model));
+    ASSIGN_OR_RETURN(entry->solver,
+                     Solver::New(solver_type, model,
+                                 {.streamable = initializer}));
+  }
+  // The solver is not cached when the solve fails, as it may be in a bad
+  // state.
+  ASSIGN_OR_RETURN(SolveResultProto result, entry->solver->Solve(solve_args));
+  Put(model_key, std::move(entry));
+  if (key != nullptr) {
+    *key = model_key;
+  }
+  return result;
+}
+
+absl::StatusOr<SolveResultProto> SolverPool::SolveUpdate(
+    const ModelKey key, const ModelUpdateProto& model_update,
+    const Solver::SolveArgs& solve_args, ModelKey* const new_key) {
+  std::unique_ptr<Entry> entry = Take(key);
+  if (entry == nullptr) {
+    return absl::NotFoundError(
+        absl::StrCat("no cached model for key ", key,
+                     "; it may have been evicted or be in use"));
+  }
+  // ApplyUpdateProto() validates the update before modifying the model, so
+  // the entry can be kept when it fails.
+  if (const absl::Status status = entry->model->ApplyUpdateProto(model_update);
+      !status.ok()) {
+    Put(key, std::move(entry));
+    return status;
+  }
+  ASSIGN_OR_RETURN(const bool updated, entry->solver->Update(model_update));
+  if (!updated) {
+    ASSIGN_OR_RETURN(entry->solver,
+                     Solver::New(entry->solver_type,
+                                 entry->model->ExportModel(),
+                                 {.streamable = entry->initializer}));
+  }
+  ASSIGN_OR_RETURN(SolveResultProto result, entry->solver->Solve(solve_args));
+  const ModelKey updated_key =
+      absl::HashOf(key, DeterministicSerialization(model_update));
+  Put(updated_key, std::move(entry));
+  if (new_key != nullptr) {
+    *new_key = updated_key;
+  }
+  return result;
+}
+
+int SolverPool::num_cached_models() const {
+  const absl::MutexLock lock(&mutex_);
+  return static_cast<int>(entries_.size());
+}
+
+std::unique_ptr<SolverPool::Entry> SolverPool::Take(const ModelKey key) {
+  const absl::MutexLock lock(&mutex_);
+  const auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  std::unique_ptr<Entry> entry = std::move(it->second);
+  entries_.erase(it);
+  return entry;
+}
+
+void SolverPool::Put(const ModelKey key, std::unique_ptr<Entry> entry) {
+  // The evicted entries are destroyed after the mutex is released, since
+  // destroying a solver can be slow.
+  std::unique_ptr<Entry> evicted;
+  std::unique_ptr<Entry> replaced;
+  const absl::MutexLock lock(&mutex_);
+  if (max_cached_models_ == 0) {
+    evicted = std::move(entry);
+    return;
+  }
+  entry->last_use = ++use_counter_;
+  std::unique_ptr<Entry>& slot = entries_[key];
+  replaced = std::exchange(slot, std::move(entry));
+  if (static_cast<int>(entries_.size()) > max_cached_models_) {
+    auto oldest = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (oldest == entries_.end() ||
+          it->second->last_use < oldest->second->last_use) {
+        oldest = it;
+      }
+    }
+    evicted = std::move(oldest->second);
+    entries_.erase(oldest);
+  }
+}
+
+}  // namespace operations_research::math_opt
@@ -0,0 +1,124 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_MATH_OPT_CORE_SOLVER_POOL_H_
+#define OR_TOOLS_MATH_OPT_CORE_SOLVER_POOL_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/math_opt/core/solver.h"
+#include "ortools/math_opt/model.pb.h"
+#include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/parameters.pb.h"
+#include "ortools/math_opt/result.pb.h"
+#include "ortools/math_opt/storage/model_storage.h"
+
+namespace operations_research::math_opt {
+
+// A cache of warm solvers, for a server that answers many solve requests on
+// the same or on slowly evolving models.
+//
+// Each solver of the pool is cached with its model, under a key computed from
+// the content of the model, the solver type and the initializer. Solving the
+// same model again reuses the solver instead of building a new one, and
+// follow-up requests can send a ModelUpdateProto applied to a cached model
+// instead of a full ModelProto. When the solver does not support the update,
+// it is rebuilt from the updated model.
+//
+// The least recently used solvers are evicted when there are more than
+// `max_cached_models` of them.
+//
+// Thread-safety: all methods can be called concurrently. A solver is removed
+// from the pool while it is in use; concurrent requests for the same model
+// build their own solver, and concurrent updates of the same key fail.
+//
+// Usage:
+//   SolverPool pool(/*max_cached_models=*/8);
+//   SolverPool::ModelKey key;
+//   ASSIGN_OR_RETURN(const SolveResultProto result,
+//                    pool.Solve(SOLVER_TYPE_GSCIP, model, initializer,
+//                               solve_args, &key));
+//   ...
+//   ASSIGN_OR_RETURN(const SolveResultProto updated_result,
+//                    pool.SolveUpdate(key, model_update, solve_args, &key));
+class SolverPool {
+ public:
+  using ModelKey = uint64_t;
+
+  explicit SolverPool(int max_cached_models);
+
+  SolverPool(const SolverPool&) = delete;
+  SolverPool& operator=(const SolverPool&) = delete;
+
+  // Returns the key under which Solve() caches the solver of this model.
+  static ModelKey Key(SolverTypeProto solver_type, const ModelProto& model,
+                      const SolverInitializerProto& initializer);
+
+  // Solves the model with the cached solver of an identical model if there is
+  // one, or with a new solver otherwise. The solver is then cached, and its
+  // key is returned in `key` if not nullptr.
+  absl::StatusOr<SolveResultProto> Solve(
+      SolverTypeProto solver_type, const ModelProto& model,
+      const SolverInitializerProto& initializer,
+      const Solver::SolveArgs& solve_args, ModelKey* key = nullptr);
+
+  // Applies the update to the cached model of `key`, solves it and returns the
+  // result. The updated model is then cached under a new key, derived from
+  // `key` and the update, that is returned in `new_key` if not nullptr; `key`
+  // can't be used anymore.
+  //
+  // Returns a NotFoundError if there is no model for `key`, e.g. because it
+  // was evicted or is being solved. The caller should then send the full
+  // model to Solve().
+  absl::StatusOr<SolveResultProto> SolveUpdate(
+      ModelKey key, const ModelUpdateProto& model_update,
+      const Solver::SolveArgs& solve_args, ModelKey* new_key = nullptr);
+
+  // Returns the number of cached models, not counting the ones being solved.
+  int num_cached_models() const;
+
+ private:
+  struct Entry {
+    SolverTypeProto solver_type;
+    SolverInitializerProto initializer;
+    // The model of the solver, to rebuild it when it does not support an
+    // update.
+    std::unique_ptr<ModelStorage> model;
+    std::unique_ptr<Solver> solver;
+    // The value of use_counter_ when the entry was last used.
+    int64_t last_use = 0;
+  };
+
+  // Removes and returns the entry of key, or nullptr.
+  std::unique_ptr<Entry> Take(ModelKey key);
+
+  // Caches the entry under key, evicting the least recently used entries if
+  // needed. If there already is an entry for key, the new one replaces it.
+  void Put(ModelKey key, std::unique_ptr<Entry> entry);
+
+  const int max_cached_models_;
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<ModelKey, std::unique_ptr<Entry>> entries_
+      ABSL_GUARDED_BY(mutex_);
+  int64_t use_counter_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace operations_research::math_opt
+
+#endif  // OR_TOOLS_MATH_OPT_CORE_SOLVER_POOL_H_
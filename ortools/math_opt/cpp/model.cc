@@ -68,6 +68,54 @@ std::unique_ptr<Model> Model::Clone(
   return std::make_unique<Model>(storage_->Clone(new_name));
 }
 
+std::vector<Variable> Model::AddVariables(
+    const absl::Span<const double> lower_bounds,
+    const absl::Span<const double> upper_bounds,
+    const std::vector<bool>& is_integer,
+    const absl::Span<const std::string> names) {
+  std::vector<Variable> result;
+  result.reserve(lower_bounds.size());
+  for (const VariableId id : storage()->AddVariables(
+           lower_bounds, upper_bounds, is_integer, names)) {
+    result.push_back(Variable(storage(), id));
+  }
+  return result;
+}
+
+std::vector<LinearConstraint> Model::AddLinearConstraints(
+    const absl::Span<const double> lower_bounds,
+    const absl::Span<const double> upper_bounds,
+    const absl::Span<const std::string> names) {
+  std::vector<LinearConstraint> result;
+  result.reserve(lower_bounds.size());
+  for (const LinearConstraintId id :
+       storage()->AddLinearConstraints(lower_bounds, upper_bounds, names)) {
+    result.push_back(LinearConstraint(storage(), id));
+  }
+  return result;
+}
+
+void Model::set_coefficients(
+    const absl::Span<const LinearConstraint> constraints,
+    const absl::Span<const Variable> variables,
+    const absl::Span<const double> values) {
+  CHECK_EQ(variables.size(), constraints.size());
+  std::vector<LinearConstraintId> constraint_ids;
+  constraint_ids.reserve(constraints.size());
+  for (const LinearConstraint constraint : constraints) {
+    CheckModel(constraint.storage());
+    constraint_ids.push_back(constraint.typed_id());
+  }
+  std::vector<VariableId> variable_ids;
+  variable_ids.reserve(variables.size());
+  for (const Variable variable : variables) {
+    CheckModel(variable.storage());
+    variable_ids.push_back(variable.typed_id());
+  }
+  storage()->set_linear_constraint_coefficients(constraint_ids, variable_ids,
+                                                values);
+}
+
 LinearConstraint Model::AddLinearConstraint(
     const BoundedLinearExpression& bounded_expr, absl::string_view name) {
   CheckOptionalModel(bounded_expr.expression.storage());
@@ -82,6 +130,23 @@ LinearConstraint Model::AddLinearConstraint(
   return LinearConstraint(storage(), constraint);
 }
 
+LinearConstraint Model::AddLinearConstraint(const double lower_bound,
+                                            LinearExpressionBuilder expression,
+                                            const double upper_bound,
+                                            const absl::string_view name) {
+  CheckOptionalModel(expression.storage());
+  expression.MergeTerms();
+
+  const LinearConstraintId constraint = storage()->AddLinearConstraint(
+      lower_bound - expression.offset(), upper_bound - expression.offset(),
+      name);
+  for (const LinearTerm& term : expression.terms()) {
+    storage()->set_linear_constraint_coefficient(
+        constraint, term.variable.typed_id(), term.coefficient);
+  }
+  return LinearConstraint(storage(), constraint);
+}
+
 std::vector<Variable> Model::Variables() const {
   std::vector<Variable> result;
   result.reserve(storage()->num_variables());
@@ -187,6 +187,15 @@ class Model {
   inline Variable AddIntegerVariable(double lower_bound, double upper_bound,
                                      absl::string_view name = "");
 
+  // Adds lower_bounds.size() variables to the model in one pass, which is much
+  // faster than calling AddVariable() on each of them for large models.
+  //
+  // See ModelStorage::AddVariables() for the meaning of the arguments.
+  std::vector<Variable> AddVariables(absl::Span<const double> lower_bounds,
+                                     absl::Span<const double> upper_bounds,
+                                     const std::vector<bool>& is_integer = {},
+                                     absl::Span<const std::string> names = {});
+
   // Removes a variable from the model.
   //
   // It is an error to use any reference to this variable after this operation.
@@ -270,6 +279,14 @@ class Model {
                                               double upper_bound,
                                               absl::string_view name = "");
 
+  // Adds lower_bounds.size() linear constraints with the given bounds and
+  // names (which can be empty) to the model in one pass. Their coefficients
+  // can then be set with set_coefficients().
+  std::vector<LinearConstraint> AddLinearConstraints(
+      absl::Span<const double> lower_bounds,
+      absl::Span<const double> upper_bounds,
+      absl::Span<const std::string> names = {});
+
   // Adds a linear constraint from the given bounded linear expression.
   //
   // Usage:
@@ -288,6 +305,16 @@ class Model {
   LinearConstraint AddLinearConstraint(
       const BoundedLinearExpression& bounded_expr, absl::string_view name = "");
 
+  // Adds the linear constraint lower_bound <= expression <= upper_bound, where
+  // the offset of the expression is removed from the bounds.
+  //
+  // The terms of the builder are merged by sorting them, without building a
+  // LinearExpression.
+  LinearConstraint AddLinearConstraint(double lower_bound,
+                                       LinearExpressionBuilder expression,
+                                       double upper_bound,
+                                       absl::string_view name = "");
+
   // Removes a linear constraint from the model.
   //
   // It is an error to use any reference to this linear constraint after this
@@ -338,6 +365,13 @@ class Model {
   inline void set_coefficient(LinearConstraint constraint, Variable variable,
                               double value);
 
+  // Sets the coefficient of variables[i] in constraints[i] to values[i], for
+  // all i. This is the coordinate (COO) format of the linear constraint matrix.
+  // The three spans must have the same size.
+  void set_coefficients(absl::Span<const LinearConstraint> constraints,
+                        absl::Span<const Variable> variables,
+                        absl::Span<const double> values);
+
   // Returns 0.0 if the variable is not used in the constraint.
   inline double coefficient(LinearConstraint constraint,
                             Variable variable) const;
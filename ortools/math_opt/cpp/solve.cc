@@ -13,10 +13,17 @@
 
 #include "ortools/math_opt/cpp/solve.h"
 
+#include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/math_opt/callback.pb.h"
 #include "ortools/math_opt/core/base_solver.h"
 #include "ortools/math_opt/core/solver.h"
@@ -30,6 +37,7 @@
 #include "ortools/math_opt/cpp/solver_init_arguments.h"
 #include "ortools/math_opt/cpp/streamable_solver_init_arguments.h"
 #include "ortools/math_opt/infeasible_subsystem.pb.h"
+#include "ortools/util/solve_interrupter.h"
 
 namespace operations_research {
 namespace math_opt {
@@ -69,6 +77,81 @@ absl::StatusOr<SolveResult> Solve(const Model& model,
                              /*remove_names=*/init_args.remove_names);
 }
 
+bool IsConclusiveResult(const SolveResult& result) {
+  switch (result.termination.reason) {
+    case TerminationReason::kOptimal:
+    case TerminationReason::kInfeasible:
+    case TerminationReason::kUnbounded:
+    case TerminationReason::kInfeasibleOrUnbounded:
+      return true;
+    default:
+      return false;
+  }
+}
+
+absl::StatusOr<SolveResult> SolveConcurrently(
+    const Model& model, const absl::Span<const ConcurrentSolver> solvers,
+    const SolveInterrupter* const interrupter,
+    const std::function<bool(const SolveResult&)> is_final) {
+  if (solvers.empty()) {
+    return absl::InvalidArgumentError("no solver given to SolveConcurrently()");
+  }
+
+  // Interrupts all the solvers, when a final result is found or when the user
+  // interrupter is triggered.
+  SolveInterrupter race_interrupter;
+  const ScopedSolveInterrupterCallback user_interruption(
+      interrupter, [&]() { race_interrupter.Interrupt(); });
+
+  absl::Mutex mutex;
+  std::vector<std::optional<absl::StatusOr<SolveResult>>> results(
+      solvers.size());
+  // The indices of the solvers, in the order in which they returned.
+  std::vector<int> completion_order;
+  std::optional<int> winner;
+  {
+    ThreadPool pool("SolveConcurrently", solvers.size());
+    pool.StartWorkers();
+    for (int i = 0; i < static_cast<int>(solvers.size()); ++i) {
+      pool.Schedule([&, i]() {
+        const ConcurrentSolver& solver = solvers[i];
+        SolveInterrupter solver_interrupter;
+        const ScopedSolveInterrupterCallback race_interruption(
+            &race_interrupter, [&]() { solver_interrupter.Interrupt(); });
+        const ScopedSolveInterrupterCallback solver_interruption(
+            solver.solve_args.interrupter,
+            [&]() { solver_interrupter.Interrupt(); });
+        SolveArguments solve_args = solver.solve_args;
+        solve_args.interrupter = &solver_interrupter;
+        absl::StatusOr<SolveResult> result =
+            Solve(model, solver.solver_type, solve_args, solver.init_args);
+
+        bool won = false;
+        {
+          const absl::MutexLock lock(&mutex);
+          completion_order.push_back(i);
+          if (!winner.has_value() && result.ok() && is_final(*result)) {
+            winner = i;
+            won = true;
+          }
+          results[i] = std::move(result);
+        }
+        if (won) race_interrupter.Interrupt();
+      });
+    }
+  }
+
+  if (winner.has_value()) {
+    return *std::move(results[*winner]);
+  }
+  for (const int i : completion_order) {
+    if (results[i]->ok()) {
+      return *std::move(results[i]);
+    }
+  }
+  return results[0]->status();
+}
+
 absl::StatusOr<ComputeInfeasibleSubsystemResult> ComputeInfeasibleSubsystem(
     const Model& model, const SolverType solver_type,
     const ComputeInfeasibleSubsystemArguments& compute_args,
@@ -28,6 +28,7 @@
 #include <memory>
 
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "ortools/math_opt/cpp/compute_infeasible_subsystem_arguments.h"  // IWYU pragma: export
 #include "ortools/math_opt/cpp/compute_infeasible_subsystem_result.h"  // IWYU pragma: export
 #include "ortools/math_opt/cpp/incremental_solver.h"  // IWYU pragma: export
@@ -38,6 +39,7 @@
 #include "ortools/math_opt/cpp/solver_init_arguments.h"  // IWYU pragma: export
 #include "ortools/math_opt/cpp/update_result.h"          // IWYU pragma: export
 #include "ortools/math_opt/parameters.pb.h"              // IWYU pragma: export
+#include "ortools/util/solve_interrupter.h"
 
 namespace operations_research {
 namespace math_opt {
@@ -86,6 +88,41 @@ using SolveFunction =
         const operations_research::math_opt::SolveArguments&,
         const operations_research::math_opt::SolverInitArguments&)>;
 
+// One of the solvers run by SolveConcurrently().
+struct ConcurrentSolver {
+  SolverType solver_type;
+  SolveArguments solve_args;
+  SolverInitArguments init_args;
+};
+
+// Returns true if the termination reason of the result is kOptimal,
+// kInfeasible, kUnbounded or kInfeasibleOrUnbounded, i.e. if the solver has
+// settled the problem. This is the default `is_final` of SolveConcurrently().
+bool IsConclusiveResult(const SolveResult& result);
+
+// Solves the input model with each of the given solvers, each in its own
+// thread, and returns the first result for which `is_final` returns true. The
+// other solvers are then interrupted, and their results are discarded.
+//
+// This is useful when it is not known in advance which solver is the fastest
+// on a model, e.g. Glop, PDLP or HiGHS for an LP.
+//
+// If no solver returns a final result, for example because they all reached
+// their time limit, the first result that was returned without error is
+// returned. If all the solvers fail, the error of the first solver in
+// `solvers` is returned.
+//
+// The solvers run concurrently on the same model, as Solve() allows. The
+// interrupter of each solve_args, as well as `interrupter`, which interrupts
+// all the solvers, are honored. Callbacks are called from the solver threads;
+// a callback shared by several solvers must be thread-safe.
+//
+// The model must not be modified during the solve.
+absl::StatusOr<SolveResult> SolveConcurrently(
+    const Model& model, absl::Span<const ConcurrentSolver> solvers,
+    const SolveInterrupter* interrupter = nullptr,
+    std::function<bool(const SolveResult&)> is_final = IsConclusiveResult);
+
 // Computes an infeasible subsystem of the input model.
 //
 // A Status error will be returned if the inputs are invalid or there is an
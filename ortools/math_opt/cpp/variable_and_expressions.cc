@@ -13,7 +13,9 @@
 
 #include "ortools/math_opt/cpp/variable_and_expressions.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <ostream>
 #include <utility>
@@ -98,6 +100,24 @@ std::ostream& operator<<(std::ostream& ostr,
   return ostr;
 }
 
+void LinearExpressionBuilder::MergeTerms() {
+  std::sort(terms_.begin(), terms_.end(),
+            [](const LinearTerm& l, const LinearTerm& r) {
+              return l.variable.typed_id() < r.variable.typed_id();
+            });
+  int64_t num_merged = 0;
+  for (const LinearTerm& term : terms_) {
+    LinearTerm* const last = num_merged > 0 ? &terms_[num_merged - 1] : nullptr;
+    if (last != nullptr &&
+        last->variable.typed_id() == term.variable.typed_id()) {
+      last->coefficient += term.coefficient;
+    } else {
+      terms_[num_merged++] = term;
+    }
+  }
+  terms_.erase(terms_.begin() + num_merged, terms_.end());
+}
+
 std::ostream& operator<<(std::ostream& ostr,
                          const BoundedLinearExpression& bounded_expression) {
   const double lb = bounded_expression.lower_bound;
@@ -99,7 +99,9 @@
 #include <limits>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
@@ -210,8 +212,9 @@ inline LinearTerm operator*(Variable variable, double coefficient);
 inline LinearTerm operator/(LinearTerm term, double coefficient);
 inline LinearTerm operator/(Variable variable, double coefficient);
 
-// Forward declaration so that we may add it as a friend to LinearExpression
+// Forward declarations so that we may add them as friends to LinearExpression
 class QuadraticExpression;
+class LinearExpressionBuilder;
 
 // This class represents a sum of variables multiplied by coefficient and an
 // optional offset constant. For example: "3*x + 2*y + 5".
@@ -383,11 +386,17 @@ class LinearExpression {
   friend std::ostream& operator<<(std::ostream& ostr,
                                   const LinearExpression& expression);
   friend QuadraticExpression;
+  friend LinearExpressionBuilder;
 
   // Sets the storage_ to the input value if nullptr, else CHECKs that it is
   // equal. Also CHECKs that the input value is not nullptr.
   inline void SetOrCheckStorage(const ModelStorage* storage);
 
+  // Reserves room for the terms of `items` when each of its elements is a
+  // single term (a Variable or a LinearTerm) and its size is known.
+  template <typename Iterable>
+  inline void ReserveTermsFor(const Iterable& items);
+
   // Invariants:
   // * nullptr, if terms_ is empty
   // * equal to Variable::storage() of each key of terms_, else
@@ -495,6 +504,82 @@ inline LinearExpression operator*(LinearExpression lhs, double rhs);
 inline LinearExpression operator*(double lhs, LinearExpression rhs);
 inline LinearExpression operator/(LinearExpression lhs, double rhs);
 
+// An append-only buffer of linear terms, to build large linear expressions
+// with fewer allocations than LinearExpression.
+//
+// LinearExpression merges each new term in a hash map, and `a + b + ...`
+// chains grow and rehash that map as they go. The builder instead appends the
+// terms to a vector, and merges the terms of the same variable only once: in
+// Build(), or in Model::AddLinearConstraint(), which sorts the terms and does
+// not build any hash map.
+//
+// Example:
+//   LinearExpressionBuilder builder;
+//   builder.Reserve(vars.size());
+//   for (int i = 0; i < vars.size(); ++i) {
+//     builder += coefficients[i] * vars[i];
+//   }
+//   model.AddLinearConstraint(1.0, std::move(builder), 1.0);
+//
+// Like LinearExpression, the builder CHECKs that all its variables belong to
+// the same model.
+class LinearExpressionBuilder {
+ public:
+  LinearExpressionBuilder() = default;
+
+  // Reserves room for `num_terms` terms in total.
+  void Reserve(int64_t num_terms) { terms_.reserve(num_terms); }
+
+  inline LinearExpressionBuilder& operator+=(const LinearExpression& other);
+  inline LinearExpressionBuilder& operator+=(const LinearTerm& term);
+  inline LinearExpressionBuilder& operator+=(Variable variable);
+  inline LinearExpressionBuilder& operator+=(double value);
+  inline LinearExpressionBuilder& operator-=(const LinearExpression& other);
+  inline LinearExpressionBuilder& operator-=(const LinearTerm& term);
+  inline LinearExpressionBuilder& operator-=(Variable variable);
+  inline LinearExpressionBuilder& operator-=(double value);
+
+  // Same as LinearExpression::AddSum(), but reserves the exact number of terms
+  // when items has a size and its elements are single terms.
+  template <typename Iterable>
+  inline void AddSum(const Iterable& items);
+
+  // Same as LinearExpression::AddInnerProduct(), with the same reservation as
+  // AddSum().
+  template <typename LeftIterable, typename RightIterable>
+  inline void AddInnerProduct(const LeftIterable& left,
+                              const RightIterable& right);
+
+  // Sorts the terms by variable id and merges the terms of the same variable,
+  // summing their coefficients. Like in LinearExpression, terms whose
+  // coefficients sum to zero are kept.
+  void MergeTerms();
+
+  // Returns the terms appended so far, in which a variable may appear several
+  // times unless MergeTerms() was called.
+  const std::vector<LinearTerm>& terms() const { return terms_; }
+  double offset() const { return offset_; }
+  const ModelStorage* storage() const { return storage_; }
+
+  // Returns the expression, with one hash map insertion per term and no
+  // rehash. The builder must not be used afterwards.
+  inline LinearExpression Build() &&;
+
+ private:
+  template <typename Iterable>
+  inline void ReserveTermsFor(const Iterable& items);
+
+  // Same as LinearExpression::SetOrCheckStorage().
+  inline void SetOrCheckStorage(const ModelStorage* storage);
+
+  // Invariants:
+  // * nullptr, if terms_ is empty
+  // * equal to Variable::storage() of each variable of terms_, else
+  const ModelStorage* storage_ = nullptr;
+  std::vector<LinearTerm> terms_;
+  double offset_ = 0.0;
+};
+
 // A LinearExpression with a lower bound.
 struct LowerBoundedLinearExpression {
   // Users are not expected to use this constructor. Instead, they should build
@@ -1648,8 +1733,50 @@ LinearExpression& LinearExpression::operator/=(const double value) {
   return *this;
 }
 
+namespace internal {
+
+template <typename T, typename = void>
+struct HasSize : std::false_type {};
+
+template <typename T>
+struct HasSize<T, std::void_t<decltype(std::size(std::declval<const T&>()))>>
+    : std::true_type {};
+
+// Returns the number of terms added by adding each element of items to an
+// expression if it is known at compile time to be std::size(items), i.e. if
+// Element is a single term and items has a size. Returns 0 otherwise.
+template <typename Element, typename Iterable>
+int64_t NumSingleTerms(const Iterable& items) {
+  using T = std::decay_t<Element>;
+  constexpr bool kIsSingleTerm =
+      std::is_same_v<T, Variable> || std::is_same_v<T, LinearTerm>;
+  if constexpr (HasSize<Iterable>::value && kIsSingleTerm) {
+    return static_cast<int64_t>(std::size(items));
+  } else {
+    return 0;
+  }
+}
+
+// Returns the type of the product of the elements of left and right.
+template <typename LeftIterable, typename RightIterable>
+using InnerProductElement =
+    decltype(*std::begin(std::declval<const LeftIterable&>()) *
+             *std::begin(std::declval<const RightIterable&>()));
+
+}  // namespace internal
+
+template <typename Iterable>
+void LinearExpression::ReserveTermsFor(const Iterable& items) {
+  const int64_t num_terms =
+      internal::NumSingleTerms<decltype(*std::begin(items))>(items);
+  if (num_terms > 0) {
+    terms_.reserve(terms_.size() + num_terms);
+  }
+}
+
 template <typename Iterable>
 void LinearExpression::AddSum(const Iterable& items) {
+  ReserveTermsFor(items);
   for (const auto& item : items) {
     *this += item;
   }
@@ -1692,6 +1819,11 @@ void AddInnerProduct(const LeftIterable& left, const RightIterable& right,
 template <typename LeftIterable, typename RightIterable>
 void LinearExpression::AddInnerProduct(const LeftIterable& left,
                                        const RightIterable& right) {
+  const int64_t num_terms = internal::NumSingleTerms<
+      internal::InnerProductElement<LeftIterable, RightIterable>>(left);
+  if (num_terms > 0) {
+    terms_.reserve(terms_.size() + num_terms);
+  }
   internal::AddInnerProduct(left, right, *this);
 }
 
@@ -1715,6 +1847,120 @@ double LinearExpression::offset() const { return offset_; }
 
 const ModelStorage* LinearExpression::storage() const { return storage_; }
 
+////////////////////////////////////////////////////////////////////////////////
+// LinearExpressionBuilder
+////////////////////////////////////////////////////////////////////////////////
+
+void LinearExpressionBuilder::SetOrCheckStorage(
+    const ModelStorage* const storage) {
+  CHECK(storage != nullptr) << internal::kKeyHasNullModelStorage;
+  if (storage_ == nullptr) {
+    storage_ = storage;
+    return;
+  }
+  CHECK_EQ(storage, storage_) << internal::kObjectsFromOtherModelStorage;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const LinearExpression& other) {
+  if (!other.terms_.empty()) {
+    SetOrCheckStorage(other.storage());
+    terms_.reserve(terms_.size() + other.terms_.size());
+    for (const auto& [v, coeff] : other.terms_) {
+      terms_.emplace_back(v, coeff);
+    }
+  }
+  offset_ += other.offset_;
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const LinearTerm& term) {
+  SetOrCheckStorage(term.variable.storage());
+  terms_.push_back(term);
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const Variable variable) {
+  return *this += LinearTerm(variable, 1.0);
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator+=(
+    const double value) {
+  offset_ += value;
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const LinearExpression& other) {
+  if (!other.terms_.empty()) {
+    SetOrCheckStorage(other.storage());
+    terms_.reserve(terms_.size() + other.terms_.size());
+    for (const auto& [v, coeff] : other.terms_) {
+      terms_.emplace_back(v, -coeff);
+    }
+  }
+  offset_ -= other.offset_;
+  return *this;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const LinearTerm& term) {
+  return *this += -term;
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const Variable variable) {
+  return *this += LinearTerm(variable, -1.0);
+}
+
+LinearExpressionBuilder& LinearExpressionBuilder::operator-=(
+    const double value) {
+  offset_ -= value;
+  return *this;
+}
+
+template <typename Iterable>
+void LinearExpressionBuilder::ReserveTermsFor(const Iterable& items) {
+  const int64_t num_terms =
+      internal::NumSingleTerms<decltype(*std::begin(items))>(items);
+  if (num_terms > 0) {
+    terms_.reserve(terms_.size() + num_terms);
+  }
+}
+
+template <typename Iterable>
+void LinearExpressionBuilder::AddSum(const Iterable& items) {
+  ReserveTermsFor(items);
+  for (const auto& item : items) {
+    *this += item;
+  }
+}
+
+template <typename LeftIterable, typename RightIterable>
+void LinearExpressionBuilder::AddInnerProduct(const LeftIterable& left,
+                                              const RightIterable& right) {
+  const int64_t num_terms = internal::NumSingleTerms<
+      internal::InnerProductElement<LeftIterable, RightIterable>>(left);
+  if (num_terms > 0) {
+    terms_.reserve(terms_.size() + num_terms);
+  }
+  internal::AddInnerProduct(left, right, *this);
+}
+
+LinearExpression LinearExpressionBuilder::Build() && {
+  LinearExpression result;
+  result.storage_ = std::exchange(storage_, nullptr);
+  result.terms_.reserve(terms_.size());
+  for (const LinearTerm& term : terms_) {
+    result.terms_[term.variable] += term.coefficient;
+  }
+  result.offset_ = std::exchange(offset_, 0.0);
+  terms_.clear();
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // VariablesEquality
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,10 +24,14 @@
 
 namespace operations_research::math_opt {
 
-absl::StatusOr<std::string> ModelProtoToLp(const ModelProto& model) {
+absl::StatusOr<std::string> ModelProtoToLp(const ModelProto& model,
+                                           const int num_threads) {
   ASSIGN_OR_RETURN(const MPModelProto mp_model_proto,
                    MathOptModelToMPModelProto(model));
-  return ExportModelAsLpFormat(mp_model_proto, {.show_unused_variables = true});
+  return ExportModelAsLpFormat(mp_model_proto,
+                               {.show_unused_variables = true,
+                                .exact_doubles = true,
+                                .num_threads = num_threads});
 }
 
 }  // namespace operations_research::math_opt
@@ -23,6 +23,10 @@ namespace operations_research::math_opt {
 
 // Returns the model in "CPLEX LP" format.
 //
+// Doubles are written so that they are parsed back to the same values. The
+// constraints of large models are formatted on `num_threads` threads; the
+// output does not depend on the number of threads.
+//
 // The RemoveNames() function can be used on the model to remove names if they
 // should not be exported.
 //
@@ -35,7 +39,8 @@ namespace operations_research::math_opt {
 // http://lpsolve.sourceforge.net/5.5/CPLEX-format.htm
 // https://www.ibm.com/docs/en/icos/12.8.0.0?topic=cplex-lp-file-format-algebraic-representation
 // http://www.gurobi.com/documentation/5.1/reference-manual/node871
-absl::StatusOr<std::string> ModelProtoToLp(const ModelProto& model);
+absl::StatusOr<std::string> ModelProtoToLp(const ModelProto& model,
+                                           int num_threads = 1);
 
 }  // namespace operations_research::math_opt
 
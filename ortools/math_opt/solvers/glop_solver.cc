@@ -261,11 +261,16 @@ void GlopSolver::SetOrUpdateObjectiveCoefficients(
 
 void GlopSolver::SetOrUpdateConstraintMatrix(
     const SparseDoubleMatrixProto& linear_constraint_matrix) {
+  // The matrix is sorted by row, so we only look up the first entry of each
+  // row.
+  glop::RowIndex row_index;
   for (int j = 0; j < NumMatrixNonzeros(linear_constraint_matrix); ++j) {
     const glop::ColIndex col_index =
         variables_.at(linear_constraint_matrix.column_ids(j));
-    const glop::RowIndex row_index =
-        linear_constraints_.at(linear_constraint_matrix.row_ids(j));
+    if (j == 0 || linear_constraint_matrix.row_ids(j) !=
+                      linear_constraint_matrix.row_ids(j - 1)) {
+      row_index = linear_constraints_.at(linear_constraint_matrix.row_ids(j));
+    }
     const double coefficient = linear_constraint_matrix.coefficients(j);
     linear_program_.SetCoefficient(row_index, col_index, coefficient);
   }
@@ -267,7 +267,10 @@ SparseDoubleVectorProto FillSparseDoubleVector(
 absl::Status GScipSolver::AddVariables(
     const VariablesProto& variables,
     const absl::flat_hash_map<int64_t, double>& linear_objective_coefficients) {
-  for (int i = 0; i < NumVariables(variables); ++i) {
+  const int num_new_variables = NumVariables(variables);
+  variables_.reserve(variables_.size() + num_new_variables);
+  gscip_->ReserveVariables(num_new_variables);
+  for (int i = 0; i < num_new_variables; ++i) {
     const int64_t id = SafeId(variables, i);
     // SCIP is failing with an assert in SCIPcreateVar() when input bounds are
     // inverted. That said, it is not an issue if the bounds are created
@@ -374,23 +377,30 @@ absl::Status GScipSolver::AddQuadraticObjectiveTerms(
 absl::Status GScipSolver::AddLinearConstraints(
     const LinearConstraintsProto& linear_constraints,
     const SparseDoubleMatrixProto& linear_constraint_matrix) {
+  const int num_new_constraints = NumConstraints(linear_constraints);
+  linear_constraints_.reserve(linear_constraints_.size() +
+                              num_new_constraints);
+  gscip_->ReserveConstraints(num_new_constraints);
+  // The range and the name are reused from one constraint to the next to avoid
+  // allocating them for each constraint.
+  GScipLinearRange range;
+  std::string name;
   for (LinearConstraintIterator lin_con_it(&linear_constraints,
                                            &linear_constraint_matrix);
        !lin_con_it.IsDone(); lin_con_it.Next()) {
     const LinearConstraintView current = lin_con_it.Current();
 
-    GScipLinearRange range;
     range.lower_bound = current.lower_bound;
     range.upper_bound = current.upper_bound;
-    range.coefficients = std::vector<double>(current.coefficients.begin(),
-                                             current.coefficients.end());
-    range.variables.reserve(current.variable_ids.size());
+    range.coefficients.assign(current.coefficients.begin(),
+                              current.coefficients.end());
+    range.variables.clear();
     for (const int64_t var_id : current.variable_ids) {
       range.variables.push_back(variables_.at(var_id));
     }
-    ASSIGN_OR_RETURN(
-        SCIP_CONS* const scip_con,
-        gscip_->AddLinearConstraint(range, std::string(current.name)));
+    name.assign(current.name.data(), current.name.size());
+    ASSIGN_OR_RETURN(SCIP_CONS* const scip_con,
+                     gscip_->AddLinearConstraint(range, name));
     gtl::InsertOrDie(&linear_constraints_, current.linear_constraint_id,
                      scip_con);
   }
@@ -2093,8 +2093,12 @@ absl::Status GurobiSolver::ChangeCoefficients(
   std::vector<GurobiLinearConstraintIndex> row_index(num_coefficients);
   std::vector<GurobiVariableIndex> col_index(num_coefficients);
   for (int k = 0; k < num_coefficients; ++k) {
+    // The matrix is sorted by row, so we only look up the first entry of each
+    // row; new constraints come as contiguous blocks of entries.
     row_index[k] =
-        linear_constraints_map_.at(matrix.row_ids(k)).constraint_index;
+        k > 0 && matrix.row_ids(k) == matrix.row_ids(k - 1)
+            ? row_index[k - 1]
+            : linear_constraints_map_.at(matrix.row_ids(k)).constraint_index;
     col_index[k] = variables_map_.at(matrix.column_ids(k));
   }
   return gurobi_->ChgCoeffs(row_index, col_index, matrix.coefficients());
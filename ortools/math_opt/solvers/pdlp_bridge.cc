@@ -26,6 +26,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "ortools/base/status_macros.h"
+#include "ortools/lp_data/lp_types.h"
 #include "ortools/math_opt/core/inverted_bounds.h"
 #include "ortools/math_opt/core/math_opt_proto_utils.h"
 #include "ortools/math_opt/core/sparse_vector_view.h"
@@ -62,6 +63,41 @@ absl::StatusOr<SparseDoubleVectorProto> ExtractSolution(
   return result;
 }
 
+// StatusType should be glop's VariableStatus or ConstraintStatus.
+template <typename StatusType>
+BasisStatusProto FromGlopBasisStatus(const StatusType glop_basis_status) {
+  switch (glop_basis_status) {
+    case StatusType::BASIC:
+      return BASIS_STATUS_BASIC;
+    case StatusType::FIXED_VALUE:
+      return BASIS_STATUS_FIXED_VALUE;
+    case StatusType::AT_LOWER_BOUND:
+      return BASIS_STATUS_AT_LOWER_BOUND;
+    case StatusType::AT_UPPER_BOUND:
+      return BASIS_STATUS_AT_UPPER_BOUND;
+    case StatusType::FREE:
+      return BASIS_STATUS_FREE;
+  }
+  return BASIS_STATUS_UNSPECIFIED;
+}
+
+template <typename IndexType, typename StatusType>
+absl::StatusOr<SparseBasisStatusVector> ExtractBasisStatuses(
+    const glop::StrictITIVector<IndexType, StatusType>& statuses,
+    absl::Span<const int64_t> pdlp_index_to_id) {
+  if (statuses.size() != pdlp_index_to_id.size()) {
+    return absl::InternalError(
+        absl::StrCat("Expected basis vector with ", pdlp_index_to_id.size(),
+                     " elements, found: ", statuses.size().value()));
+  }
+  SparseBasisStatusVector result;
+  for (int i = 0; i < pdlp_index_to_id.size(); ++i) {
+    result.add_ids(pdlp_index_to_id[i]);
+    result.add_values(FromGlopBasisStatus(statuses[IndexType(i)]));
+  }
+  return result;
+}
+
 // We are implicitly assuming that all missing IDs have correspoding value 0.
 Eigen::VectorXd EncodeSolution(
     const SparseDoubleVectorProto& values,
@@ -207,6 +243,19 @@ absl::StatusOr<SparseDoubleVectorProto> PdlpBridge::ReducedCostsToProto(
                          /*scale=*/pdlp_lp_.objective_scaling_factor);
 }
 
+absl::StatusOr<BasisProto> PdlpBridge::BasisToProto(
+    const glop::VariableStatusRow& variable_statuses,
+    const glop::ConstraintStatusColumn& constraint_statuses) const {
+  BasisProto result;
+  ASSIGN_OR_RETURN(
+      *result.mutable_variable_status(),
+      ExtractBasisStatuses(variable_statuses, pdlp_index_to_var_id_));
+  ASSIGN_OR_RETURN(
+      *result.mutable_constraint_status(),
+      ExtractBasisStatuses(constraint_statuses, pdlp_index_to_lin_con_id_));
+  return result;
+}
+
 pdlp::PrimalAndDualSolution PdlpBridge::SolutionHintToWarmStart(
     const SolutionHintProto& solution_hint) const {
   // We are implicitly assuming that all missing IDs have correspoding value 0.
@@ -21,9 +21,11 @@
 #include "Eigen/Core"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
+#include "ortools/lp_data/lp_types.h"
 #include "ortools/math_opt/core/inverted_bounds.h"
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_parameters.pb.h"
+#include "ortools/math_opt/solution.pb.h"
 #include "ortools/math_opt/sparse_containers.pb.h"
 #include "ortools/pdlp/primal_dual_hybrid_gradient.h"
 #include "ortools/pdlp/quadratic_program.h"
@@ -68,6 +70,11 @@ class PdlpBridge {
       const SparseVectorFilterProto& variable_filter) const;
   pdlp::PrimalAndDualSolution SolutionHintToWarmStart(
       const SolutionHintProto& solution_hint) const;
+  // Converts the basis found by the glop crossover. The basic dual feasibility
+  // is not set.
+  absl::StatusOr<BasisProto> BasisToProto(
+      const glop::VariableStatusRow& variable_statuses,
+      const glop::ConstraintStatusColumn& constraint_statuses) const;
 
  private:
   pdlp::QuadraticProgram pdlp_lp_;
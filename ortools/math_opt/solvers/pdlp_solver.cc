@@ -296,6 +296,16 @@ absl::StatusOr<SolveResultProto> PdlpSolver::MakeSolveResult(
               convergence_information->dual_objective());
         }
       }
+      // The basis is only filled by the glop crossover, which only succeeds
+      // for optimal solutions.
+      if (!pdlp_result.variable_statuses.empty()) {
+        ASSIGN_OR_RETURN(*solution_proto->mutable_basis(),
+                         pdlp_bridge_.BasisToProto(
+                             pdlp_result.variable_statuses,
+                             pdlp_result.constraint_statuses));
+        solution_proto->mutable_basis()->set_basic_dual_feasibility(
+            SOLUTION_STATUS_FEASIBLE);
+      }
       break;
     }
     case pdlp::TERMINATION_REASON_PRIMAL_INFEASIBLE: {
@@ -0,0 +1,209 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_MATH_OPT_STORAGE_DENSE_ID_MAP_H_
+#define OR_TOOLS_MATH_OPT_STORAGE_DENSE_ID_MAP_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+
+namespace operations_research::math_opt {
+
+// A map from the ids of a storage (VariableId, LinearConstraintId, ...) to
+// their data, for ids that are inserted in increasing order and never reused.
+//
+// Most models never delete anything and have consecutive ids. While the ids
+// are dense, i.e. while most of the ids below the largest one are in the map,
+// the values are stored in a vector indexed by id, with a bitmap of the
+// deleted (or skipped) ids. Lookups are then an array access and listing the
+// ids in increasing order is a linear scan, without sorting.
+//
+// When the ids become sparse, because of deletions or of large jumps in the
+// inserted ids, the map switches to a hash map, for good, so that its memory
+// stays proportional to its size.
+template <typename Id, typename Value>
+class DenseIdMap {
+ public:
+  // Inserts a default value for id, which must be larger than all the ids
+  // inserted so far, and returns it.
+  Value& Insert(Id id);
+
+  // Removes id, which must be in the map.
+  void Erase(Id id);
+
+  bool contains(Id id) const;
+
+  // Returns the value of id, which must be in the map.
+  const Value& at(Id id) const;
+  Value& at(Id id);
+
+  int64_t size() const { return size_; }
+
+  // Reserves memory for `num_new_ids` calls to Insert() with consecutive ids.
+  void Reserve(int64_t num_new_ids);
+
+  // Returns the ids in the map, in no particular order.
+  std::vector<Id> Ids() const;
+
+  // Returns the ids in the map in increasing order. Runs in O(largest id) when
+  // the map is dense, and in O(n log(n)) otherwise.
+  std::vector<Id> SortedIds() const;
+
+  // Returns true if the values are stored in a vector indexed by id.
+  bool is_dense() const { return is_dense_; }
+
+ private:
+  // The map switches to a hash map when it has more than this number of slots,
+  // and more than kMaxSlotsPerId slots per id in the map.
+  static constexpr int64_t kMinSlotsForSparse = 1024;
+  static constexpr int64_t kMaxSlotsPerId = 4;
+
+  static bool TooSparse(int64_t num_slots, int64_t num_ids) {
+    return num_slots > kMinSlotsForSparse &&
+           num_slots > kMaxSlotsPerId * num_ids;
+  }
+
+  // Moves the values to sparse_values_.
+  void SwitchToSparse();
+
+  bool is_dense_ = true;
+  int64_t size_ = 0;
+
+  // When is_dense_, the value of id is dense_values_[id.value()] and
+  // is_present_[id.value()] is true iff id is in the map.
+  std::vector<Value> dense_values_;
+  std::vector<bool> is_present_;
+
+  // Used when !is_dense_.
+  absl::flat_hash_map<Id, Value> sparse_values_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Inline functions implementation.
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Id, typename Value>
+Value& DenseIdMap<Id, Value>::Insert(const Id id) {
+  if (is_dense_) {
+    const int64_t index = id.value();
+    DCHECK_GE(index, static_cast<int64_t>(dense_values_.size()));
+    if (!TooSparse(index + 1, size_ + 1)) {
+      dense_values_.resize(index + 1);
+      is_present_.resize(index + 1, false);
+      is_present_[index] = true;
+      ++size_;
+      return dense_values_[index];
+    }
+    SwitchToSparse();
+  }
+  ++size_;
+  return sparse_values_[id];
+}
+
+template <typename Id, typename Value>
+void DenseIdMap<Id, Value>::Erase(const Id id) {
+  CHECK(contains(id));
+  --size_;
+  if (!is_dense_) {
+    sparse_values_.erase(id);
+    return;
+  }
+  // Release the memory held by the value, e.g. its name.
+  dense_values_[id.value()] = Value();
+  is_present_[id.value()] = false;
+  if (TooSparse(dense_values_.size(), size_)) SwitchToSparse();
+}
+
+template <typename Id, typename Value>
+bool DenseIdMap<Id, Value>::contains(const Id id) const {
+  if (!is_dense_) return sparse_values_.contains(id);
+  const int64_t index = id.value();
+  return index >= 0 && index < static_cast<int64_t>(is_present_.size()) &&
+         is_present_[index];
+}
+
+template <typename Id, typename Value>
+const Value& DenseIdMap<Id, Value>::at(const Id id) const {
+  if (!is_dense_) return sparse_values_.at(id);
+  CHECK(contains(id)) << "unknown id: " << id;
+  return dense_values_[id.value()];
+}
+
+template <typename Id, typename Value>
+Value& DenseIdMap<Id, Value>::at(const Id id) {
+  if (!is_dense_) return sparse_values_.at(id);
+  CHECK(contains(id)) << "unknown id: " << id;
+  return dense_values_[id.value()];
+}
+
+template <typename Id, typename Value>
+void DenseIdMap<Id, Value>::Reserve(const int64_t num_new_ids) {
+  if (is_dense_) {
+    dense_values_.reserve(dense_values_.size() + num_new_ids);
+    is_present_.reserve(is_present_.size() + num_new_ids);
+  } else {
+    sparse_values_.reserve(size_ + num_new_ids);
+  }
+}
+
+template <typename Id, typename Value>
+std::vector<Id> DenseIdMap<Id, Value>::Ids() const {
+  if (is_dense_) return SortedIds();
+  std::vector<Id> result;
+  result.reserve(size_);
+  for (const auto& [id, _] : sparse_values_) {
+    result.push_back(id);
+  }
+  return result;
+}
+
+template <typename Id, typename Value>
+std::vector<Id> DenseIdMap<Id, Value>::SortedIds() const {
+  std::vector<Id> result;
+  result.reserve(size_);
+  if (is_dense_) {
+    for (int64_t index = 0; index < static_cast<int64_t>(is_present_.size());
+         ++index) {
+      if (is_present_[index]) result.push_back(Id(index));
+    }
+    return result;
+  }
+  for (const auto& [id, _] : sparse_values_) {
+    result.push_back(id);
+  }
+  absl::c_sort(result);
+  return result;
+}
+
+template <typename Id, typename Value>
+void DenseIdMap<Id, Value>::SwitchToSparse() {
+  sparse_values_.reserve(size_);
+  for (int64_t index = 0; index < static_cast<int64_t>(is_present_.size());
+       ++index) {
+    if (is_present_[index]) {
+      sparse_values_.try_emplace(Id(index), std::move(dense_values_[index]));
+    }
+  }
+  dense_values_ = std::vector<Value>();
+  is_present_ = std::vector<bool>();
+  is_dense_ = false;
+}
+
+}  // namespace operations_research::math_opt
+
+#endif  // OR_TOOLS_MATH_OPT_STORAGE_DENSE_ID_MAP_H_
@@ -19,7 +19,6 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -37,7 +36,7 @@ LinearConstraintId LinearConstraintStorage::Add(const double lower_bound,
                                                 const double upper_bound,
                                                 const absl::string_view name) {
   const LinearConstraintId id = next_id_++;
-  Data& lin_con_data = linear_constraints_[id];
+  Data& lin_con_data = linear_constraints_.Insert(id);
   lin_con_data.lower_bound = lower_bound;
   lin_con_data.upper_bound = upper_bound;
   lin_con_data.name = std::string(name);
@@ -46,18 +45,12 @@ LinearConstraintId LinearConstraintStorage::Add(const double lower_bound,
 
 std::vector<LinearConstraintId> LinearConstraintStorage::LinearConstraints()
     const {
-  std::vector<LinearConstraintId> result;
-  for (const auto& [lin_con, _] : linear_constraints_) {
-    result.push_back(lin_con);
-  }
-  return result;
+  return linear_constraints_.Ids();
 }
 
 std::vector<LinearConstraintId>
 LinearConstraintStorage::SortedLinearConstraints() const {
-  std::vector<LinearConstraintId> result = LinearConstraints();
-  absl::c_sort(result);
-  return result;
+  return linear_constraints_.SortedIds();
 }
 
 std::vector<LinearConstraintId> LinearConstraintStorage::ConstraintsFrom(
@@ -80,7 +73,7 @@ LinearConstraintStorage::Proto() const {
   for (const LinearConstraintId id : sorted_constraints) {
     AppendConstraint(id, &constraints);
   }
-  return {constraints, matrix_.Proto()};
+  return {constraints, matrix_.Proto(sorted_constraints)};
 }
 
 void LinearConstraintStorage::AppendConstraint(
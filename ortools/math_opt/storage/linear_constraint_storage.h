@@ -21,7 +21,6 @@
 #include <utility>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
@@ -31,6 +30,7 @@
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_update.pb.h"
 #include "ortools/math_opt/sparse_containers.pb.h"
+#include "ortools/math_opt/storage/dense_id_map.h"
 #include "ortools/math_opt/storage/model_storage_types.h"
 #include "ortools/math_opt/storage/range.h"
 #include "ortools/math_opt/storage/sparse_matrix.h"
@@ -80,6 +80,12 @@ class LinearConstraintStorage {
   LinearConstraintId Add(double lower_bound, double upper_bound,
                          absl::string_view name);
 
+  // Reserves memory for `num_new_constraints` calls to Add().
+  inline void Reserve(int64_t num_new_constraints);
+
+  // Reserves memory for `num_new_terms` new nonzeros in the matrix.
+  void ReserveTerms(int64_t num_new_terms) { matrix_.Reserve(num_new_terms); }
+
   inline double lower_bound(LinearConstraintId id) const;
   inline double upper_bound(LinearConstraintId id) const;
   inline const std::string& name(LinearConstraintId id) const;
@@ -185,7 +191,7 @@ class LinearConstraintStorage {
                                LinearConstraintId end) const;
 
   LinearConstraintId next_id_{0};
-  absl::flat_hash_map<LinearConstraintId, Data> linear_constraints_;
+  DenseIdMap<LinearConstraintId, Data> linear_constraints_;
   SparseMatrix<LinearConstraintId, VariableId> matrix_;
 };
 
@@ -210,11 +216,11 @@ template <typename DiffIter>
 void LinearConstraintStorage::set_lower_bound(
     const LinearConstraintId id, const double lower_bound,
     const iterator_range<DiffIter>& diffs) {
-  const auto it = linear_constraints_.find(id);
-  if (it->second.lower_bound == lower_bound) {
+  Data& data = linear_constraints_.at(id);
+  if (data.lower_bound == lower_bound) {
     return;
   }
-  it->second.lower_bound = lower_bound;
+  data.lower_bound = lower_bound;
   for (Diff& diff : diffs) {
     if (id < diff.checkpoint) {
       diff.lower_bounds.insert(id);
@@ -226,11 +232,11 @@ template <typename DiffIter>
 void LinearConstraintStorage::set_upper_bound(
     const LinearConstraintId id, const double upper_bound,
     const iterator_range<DiffIter>& diffs) {
-  const auto it = linear_constraints_.find(id);
-  if (it->second.upper_bound == upper_bound) {
+  Data& data = linear_constraints_.at(id);
+  if (data.upper_bound == upper_bound) {
     return;
   }
-  it->second.upper_bound = upper_bound;
+  data.upper_bound = upper_bound;
   for (Diff& diff : diffs) {
     if (id < diff.checkpoint) {
       diff.upper_bounds.insert(id);
@@ -256,7 +262,7 @@ void LinearConstraintStorage::Delete(const LinearConstraintId id,
     }
   }
   matrix_.DeleteRow(id);
-  linear_constraints_.erase(id);
+  linear_constraints_.Erase(id);
 }
 
 template <typename DiffIter>
@@ -275,6 +281,10 @@ void LinearConstraintStorage::DeleteVariable(
   matrix_.DeleteColumn(variable);
 }
 
+void LinearConstraintStorage::Reserve(const int64_t num_new_constraints) {
+  linear_constraints_.Reserve(num_new_constraints);
+}
+
 int64_t LinearConstraintStorage::size() const {
   return linear_constraints_.size();
 }
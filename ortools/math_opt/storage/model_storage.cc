@@ -135,6 +135,7 @@ void ModelStorage::UpdateQuadraticObjectiveCoefficients(
 
 void ModelStorage::UpdateLinearConstraintCoefficients(
     const SparseDoubleMatrixProto& coefficients) {
+  linear_constraints_.ReserveTerms(coefficients.row_ids_size());
   for (int i = 0; i < coefficients.row_ids_size(); ++i) {
     // This call is valid since there are no duplicated pairs.
     set_linear_constraint_coefficient(
@@ -183,8 +184,29 @@ VariableId ModelStorage::AddVariable(const double lower_bound,
   return variables_.Add(lower_bound, upper_bound, is_integer, name);
 }
 
+std::vector<VariableId> ModelStorage::AddVariables(
+    const absl::Span<const double> lower_bounds,
+    const absl::Span<const double> upper_bounds,
+    const std::vector<bool>& is_integer,
+    const absl::Span<const std::string> names) {
+  const int64_t num_variables = lower_bounds.size();
+  CHECK_EQ(upper_bounds.size(), lower_bounds.size());
+  CHECK(is_integer.empty() || is_integer.size() == lower_bounds.size());
+  CHECK(names.empty() || names.size() == lower_bounds.size());
+  variables_.Reserve(num_variables);
+  std::vector<VariableId> ids;
+  ids.reserve(num_variables);
+  for (int64_t v = 0; v < num_variables; ++v) {
+    ids.push_back(AddVariable(lower_bounds[v], upper_bounds[v],
+                              !is_integer.empty() && is_integer[v],
+                              names.empty() ? absl::string_view() : names[v]));
+  }
+  return ids;
+}
+
 void ModelStorage::AddVariables(const VariablesProto& variables) {
   const bool has_names = !variables.names().empty();
+  variables_.Reserve(variables.ids_size());
   for (int v = 0; v < variables.ids_size(); ++v) {
     // Make sure the ids of the new Variables in the model match the proto,
     // which are potentially non-consecutive (note that variables has been
@@ -233,9 +255,28 @@ LinearConstraintId ModelStorage::AddLinearConstraint(
   return linear_constraints_.Add(lower_bound, upper_bound, name);
 }
 
+std::vector<LinearConstraintId> ModelStorage::AddLinearConstraints(
+    const absl::Span<const double> lower_bounds,
+    const absl::Span<const double> upper_bounds,
+    const absl::Span<const std::string> names) {
+  const int64_t num_constraints = lower_bounds.size();
+  CHECK_EQ(upper_bounds.size(), lower_bounds.size());
+  CHECK(names.empty() || names.size() == lower_bounds.size());
+  linear_constraints_.Reserve(num_constraints);
+  std::vector<LinearConstraintId> ids;
+  ids.reserve(num_constraints);
+  for (int64_t c = 0; c < num_constraints; ++c) {
+    ids.push_back(
+        AddLinearConstraint(lower_bounds[c], upper_bounds[c],
+                            names.empty() ? absl::string_view() : names[c]));
+  }
+  return ids;
+}
+
 void ModelStorage::AddLinearConstraints(
     const LinearConstraintsProto& linear_constraints) {
   const bool has_names = !linear_constraints.names().empty();
+  linear_constraints_.Reserve(linear_constraints.ids_size());
   for (int c = 0; c < linear_constraints.ids_size(); ++c) {
     // Make sure the ids of the new linear constraints in the model match the
     // proto, which are potentially non-consecutive (note that
@@ -250,6 +291,22 @@ void ModelStorage::AddLinearConstraints(
   }
 }
 
+void ModelStorage::set_linear_constraint_coefficients(
+    const absl::Span<const LinearConstraintId> constraints,
+    const absl::Span<const VariableId> variables,
+    const absl::Span<const double> values) {
+  CHECK_EQ(variables.size(), constraints.size());
+  CHECK_EQ(values.size(), constraints.size());
+  const int64_t num_terms = constraints.size();
+  linear_constraints_.ReserveTerms(num_terms);
+  // Like DeleteVariable(), gets the trackers once instead of once per term.
+  const auto diffs = UpdateAndGetLinearConstraintDiffs();
+  for (int64_t i = 0; i < num_terms; ++i) {
+    linear_constraints_.set_term(constraints[i], variables[i], values[i],
+                                 diffs);
+  }
+}
+
 void ModelStorage::DeleteLinearConstraint(const LinearConstraintId id) {
   CHECK(linear_constraints_.contains(id));
   linear_constraints_.Delete(id, UpdateAndGetLinearConstraintDiffs());
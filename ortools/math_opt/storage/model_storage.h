@@ -28,6 +28,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "ortools/math_opt/constraints/indicator/storage.h"  // IWYU pragma: export
 #include "ortools/math_opt/constraints/quadratic/storage.h"  // IWYU pragma: export
 #include "ortools/math_opt/constraints/second_order_cone/storage.h"
@@ -202,6 +203,22 @@ class ModelStorage {
   VariableId AddVariable(double lower_bound, double upper_bound,
                          bool is_integer, absl::string_view name = "");
 
+  // Adds lower_bounds.size() variables to the model in one pass and returns
+  // their ids, which are consecutive.
+  //
+  // The i-th variable has bounds [lower_bounds[i], upper_bounds[i]], is integer
+  // iff is_integer[i] and is named names[i]. `upper_bounds` must have the same
+  // size as `lower_bounds`; `is_integer` (resp. `names`) can also be empty, in
+  // which case all the variables are continuous (resp. unnamed).
+  //
+  // Equivalent to calling AddVariable() for each variable, but much faster for
+  // large models since the storage is only grown once.
+  std::vector<VariableId> AddVariables(
+      absl::Span<const double> lower_bounds,
+      absl::Span<const double> upper_bounds,
+      const std::vector<bool>& is_integer = {},
+      absl::Span<const std::string> names = {});
+
   inline double variable_lower_bound(VariableId id) const;
   inline double variable_upper_bound(VariableId id) const;
   inline bool is_variable_integer(VariableId id) const;
@@ -264,6 +281,18 @@ class ModelStorage {
   LinearConstraintId AddLinearConstraint(double lower_bound, double upper_bound,
                                          absl::string_view name = "");
 
+  // Adds lower_bounds.size() linear constraints to the model in one pass and
+  // returns their ids, which are consecutive.
+  //
+  // The i-th constraint has bounds [lower_bounds[i], upper_bounds[i]] and is
+  // named names[i]. `upper_bounds` must have the same size as `lower_bounds`;
+  // `names` can also be empty, in which case all the constraints are unnamed.
+  // Use set_linear_constraint_coefficients() to set their coefficients.
+  std::vector<LinearConstraintId> AddLinearConstraints(
+      absl::Span<const double> lower_bounds,
+      absl::Span<const double> upper_bounds,
+      absl::Span<const std::string> names = {});
+
   inline double linear_constraint_lower_bound(LinearConstraintId id) const;
   inline double linear_constraint_upper_bound(LinearConstraintId id) const;
   inline const std::string& linear_constraint_name(LinearConstraintId id) const;
@@ -324,6 +353,17 @@ class ModelStorage {
                                                 VariableId variable,
                                                 double value);
 
+  // Sets the coefficients of the linear constraint matrix given as (constraint,
+  // variable, value) triplets, in coordinate (COO) format: the coefficient of
+  // variables[i] in constraints[i] is set to values[i]. The three spans must
+  // have the same size.
+  //
+  // Equivalent to calling set_linear_constraint_coefficient() on each triplet,
+  // in order, but the matrix is only grown once.
+  void set_linear_constraint_coefficients(
+      absl::Span<const LinearConstraintId> constraints,
+      absl::Span<const VariableId> variables, absl::Span<const double> values);
+
   // The {linear constraint, variable, coefficient} tuples with nonzero linear
   // constraint matrix coefficients.
   inline std::vector<std::tuple<LinearConstraintId, VariableId, double>>
@@ -337,6 +377,22 @@ class ModelStorage {
   inline std::vector<LinearConstraintId> linear_constraints_with_variable(
       VariableId variable) const;
 
+  // Calls `f(variable, coefficient)` for each nonzero coefficient of the linear
+  // constraint, in increasing variable id order.
+  //
+  // With SortedVariables() and SortedLinearConstraints(), this lets in-process
+  // code read the model row by row (or column by column with the function
+  // below) in the order of ExportModel(), without building a ModelProto. `f`
+  // must not modify the model.
+  template <typename Fn>
+  void ForEachLinearConstraintTerm(LinearConstraintId constraint,
+                                   Fn&& f) const;
+
+  // Calls `f(constraint, coefficient)` for each nonzero coefficient of the
+  // variable in the linear constraints, in increasing constraint id order.
+  template <typename Fn>
+  void ForEachVariableLinearConstraintTerm(VariableId variable, Fn&& f) const;
+
   //////////////////////////////////////////////////////////////////////////////
   // Objectives
   //
@@ -921,6 +977,20 @@ std::vector<LinearConstraintId> ModelStorage::linear_constraints_with_variable(
   return linear_constraints_.matrix().column(variable);
 }
 
+template <typename Fn>
+void ModelStorage::ForEachLinearConstraintTerm(
+    const LinearConstraintId constraint, Fn&& f) const {
+  linear_constraints_.matrix().ForEachSortedRowTerm(constraint,
+                                                    std::forward<Fn>(f));
+}
+
+template <typename Fn>
+void ModelStorage::ForEachVariableLinearConstraintTerm(
+    const VariableId variable, Fn&& f) const {
+  linear_constraints_.matrix().ForEachSortedColumnTerm(variable,
+                                                       std::forward<Fn>(f));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Objectives
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,6 +24,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
 #include "absl/types/span.h"
 #include "ortools/base/map_util.h"
@@ -212,6 +213,16 @@ class SparseMatrix {
   // TODO(b/233630053): expose an iterator based API to avoid making a copy.
   std::vector<std::pair<RowId, double>> ColumnTerms(ColumnId col_id) const;
 
+  // Calls `f(column_id, coefficient)` for each nonzero of the row, in
+  // increasing column order. `f` must not modify the matrix.
+  template <typename Fn>
+  void ForEachSortedRowTerm(RowId row_id, Fn&& f) const;
+
+  // Calls `f(row_id, coefficient)` for each nonzero of the column, in
+  // increasing row order. `f` must not modify the matrix.
+  template <typename Fn>
+  void ForEachSortedColumnTerm(ColumnId col_id, Fn&& f) const;
+
   // Returns (x, y, c) tuples where variables x and y have nonzero coefficient
   // c, and x <= y.
   //
@@ -222,6 +233,12 @@ class SparseMatrix {
   // Removes all terms from the matrix.
   void Clear();
 
+  // Reserves memory for `num_new_entries` new (row, column) keys, so that
+  // setting them does not rehash the matrix.
+  void Reserve(int64_t num_new_entries) {
+    values_.reserve(values_.size() + num_new_entries);
+  }
+
   // The number of (row, column) keys with nonzero value.
   int64_t nonzeros() const;
 
@@ -231,6 +248,14 @@ class SparseMatrix {
 
   SparseDoubleMatrixProto Proto() const;
 
+  // Same as Proto(), but built row by row: `sorted_rows` must be sorted and
+  // contain all the rows with nonzeros. This only sorts each row, instead of
+  // copying and sorting all the nonzeros at once.
+  SparseDoubleMatrixProto Proto(absl::Span<const RowId> sorted_rows) const;
+
+  // Returns the changes of the matrix, sorted by row then column. `new_rows`
+  // and `new_columns` must be sorted, and larger than the rows and columns of
+  // the keys of `dirty`.
   SparseDoubleMatrixProto Update(
       const absl::flat_hash_set<RowId>& deleted_rows,
       absl::Span<const RowId> new_rows,
@@ -480,6 +505,28 @@ SparseMatrix<RowId, ColumnId>::ColumnTerms(const ColumnId col_id) const {
   return result;
 }
 
+template <typename RowId, typename ColumnId>
+template <typename Fn>
+void SparseMatrix<RowId, ColumnId>::ForEachSortedRowTerm(const RowId row_id,
+                                                         Fn&& f) const {
+  std::vector<std::pair<ColumnId, double>> terms = RowTerms(row_id);
+  absl::c_sort(terms);
+  for (const auto [col, val] : terms) {
+    f(col, val);
+  }
+}
+
+template <typename RowId, typename ColumnId>
+template <typename Fn>
+void SparseMatrix<RowId, ColumnId>::ForEachSortedColumnTerm(
+    const ColumnId col_id, Fn&& f) const {
+  std::vector<std::pair<RowId, double>> terms = ColumnTerms(col_id);
+  absl::c_sort(terms);
+  for (const auto [row_id, val] : terms) {
+    f(row_id, val);
+  }
+}
+
 template <typename RowId, typename ColumnId>
 std::vector<std::tuple<RowId, ColumnId, double>>
 SparseMatrix<RowId, ColumnId>::Terms() const {
@@ -510,6 +557,9 @@ SparseDoubleMatrixProto SparseMatrix<RowId, ColumnId>::Proto() const {
   SparseDoubleMatrixProto result;
   std::vector<std::tuple<RowId, ColumnId, double>> terms = Terms();
   absl::c_sort(terms);
+  result.mutable_row_ids()->Reserve(terms.size());
+  result.mutable_column_ids()->Reserve(terms.size());
+  result.mutable_coefficients()->Reserve(terms.size());
   for (const auto [r, c, v] : terms) {
     result.add_row_ids(r.value());
     result.add_column_ids(c.value());
@@ -518,6 +568,25 @@ SparseDoubleMatrixProto SparseMatrix<RowId, ColumnId>::Proto() const {
   return result;
 }
 
+template <typename RowId, typename ColumnId>
+SparseDoubleMatrixProto SparseMatrix<RowId, ColumnId>::Proto(
+    const absl::Span<const RowId> sorted_rows) const {
+  DCHECK(absl::c_is_sorted(sorted_rows));
+  SparseDoubleMatrixProto result;
+  result.mutable_row_ids()->Reserve(nonzeros_);
+  result.mutable_column_ids()->Reserve(nonzeros_);
+  result.mutable_coefficients()->Reserve(nonzeros_);
+  for (const RowId row_id : sorted_rows) {
+    ForEachSortedRowTerm(row_id, [&](const ColumnId col, const double val) {
+      result.add_row_ids(row_id.value());
+      result.add_column_ids(col.value());
+      result.add_coefficients(val);
+    });
+  }
+  DCHECK_EQ(result.row_ids_size(), nonzeros_);
+  return result;
+}
+
 template <typename RowId, typename ColumnId>
 SparseDoubleMatrixProto SparseMatrix<RowId, ColumnId>::Update(
     const absl::flat_hash_set<RowId>& deleted_rows,
@@ -539,23 +608,31 @@ SparseDoubleMatrixProto SparseMatrix<RowId, ColumnId>::Update(
     matrix_updates.push_back({row, column, get(row, column)});
   }
 
+  // The new rows come after all the existing rows, so their entries, including
+  // the ones in new columns, are appended row by row after the sorted updates
+  // of the existing rows. This avoids copying and sorting them all at once,
+  // which matters when many rows are added between two updates.
+  const auto is_new_row = [&](const RowId row) {
+    return !new_rows.empty() && row >= new_rows.front();
+  };
   for (const ColumnId new_col : new_columns) {
     // TODO(b/233630053): use iterator API.
     for (const auto [row, coef] : ColumnTerms(new_col)) {
-      matrix_updates.push_back({row, new_col, coef});
+      if (!is_new_row(row)) {
+        matrix_updates.push_back({row, new_col, coef});
+      }
     }
   }
+  SparseDoubleMatrixProto result =
+      internal::EntriesToMatrixProto(std::move(matrix_updates));
   for (const RowId new_row : new_rows) {
-    // TODO(b/233630053) use iterator API.
-    for (const auto [col, coef] : RowTerms(new_row)) {
-      // NOTE(user): we already have the columns above the checkpoint from
-      // the loop above, but we will do at most twice as much as needed here.
-      if (new_columns.empty() || col < new_columns[0]) {
-        matrix_updates.push_back({new_row, col, coef});
-      }
-    }
+    ForEachSortedRowTerm(new_row, [&](const ColumnId col, const double coef) {
+      result.add_row_ids(new_row.value());
+      result.add_column_ids(col.value());
+      result.add_coefficients(coef);
+    });
   }
-  return internal::EntriesToMatrixProto(std::move(matrix_updates));
+  return result;
 }
 
 template <typename RowId, typename ColumnId>
@@ -17,7 +17,6 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "ortools/base/strong_int.h"
@@ -33,7 +32,7 @@ VariableId VariableStorage::Add(const double lower_bound,
                                 const double upper_bound, const bool is_integer,
                                 const absl::string_view name) {
   const VariableId id = next_variable_id_;
-  VariableData& var_data = variables_[id];
+  VariableData& var_data = variables_.Insert(id);
   var_data.lower_bound = lower_bound;
   var_data.upper_bound = upper_bound;
   var_data.is_integer = is_integer;
@@ -43,18 +42,11 @@ VariableId VariableStorage::Add(const double lower_bound,
 }
 
 std::vector<VariableId> VariableStorage::Variables() const {
-  std::vector<VariableId> result;
-  result.reserve(variables_.size());
-  for (const auto& [var, _] : variables_) {
-    result.push_back(var);
-  }
-  return result;
+  return variables_.Ids();
 }
 
 std::vector<VariableId> VariableStorage::SortedVariables() const {
-  std::vector<VariableId> result = Variables();
-  absl::c_sort(result);
-  return result;
+  return variables_.SortedIds();
 }
 
 std::vector<VariableId> VariableStorage::VariablesFrom(
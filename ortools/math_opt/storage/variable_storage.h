@@ -20,12 +20,12 @@
 #include <string>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "ortools/base/strong_int.h"
 #include "ortools/math_opt/model.pb.h"
 #include "ortools/math_opt/model_update.pb.h"
+#include "ortools/math_opt/storage/dense_id_map.h"
 #include "ortools/math_opt/storage/model_storage_types.h"
 #include "ortools/math_opt/storage/range.h"
 
@@ -72,6 +72,9 @@ class VariableStorage {
   VariableId Add(double lower_bound, double upper_bound, bool is_integer,
                  absl::string_view name);
 
+  // Reserves memory for `num_new_variables` calls to Add().
+  inline void Reserve(int64_t num_new_variables);
+
   inline double lower_bound(VariableId id) const;
   inline double upper_bound(VariableId id) const;
   inline bool is_integer(VariableId id) const;
@@ -153,7 +156,7 @@ class VariableStorage {
   void AppendVariable(VariableId variable, VariablesProto* proto) const;
 
   VariableId next_variable_id_ = VariableId(0);
-  absl::flat_hash_map<VariableId, VariableData> variables_;
+  DenseIdMap<VariableId, VariableData> variables_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -233,7 +236,11 @@ void VariableStorage::Delete(VariableId id,
     diff.upper_bounds.erase(id);
     diff.integer.erase(id);
   }
-  variables_.erase(id);
+  variables_.Erase(id);
+}
+
+void VariableStorage::Reserve(const int64_t num_new_variables) {
+  variables_.Reserve(num_new_variables);
 }
 
 int64_t VariableStorage::size() const { return variables_.size(); }
@@ -14,18 +14,20 @@
 #include "ortools/packing/arc_flow_builder.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <set>
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/types/span.h"
 #include "ortools/base/commandlineflags.h"
 #include "ortools/base/map_util.h"
-#include "ortools/base/stl_util.h"
 #include "ortools/graph/topologicalsorter.h"
 
 namespace operations_research {
@@ -57,11 +59,11 @@ class ArcFlowBuilder {
     double NormalizedSize(absl::Span<const int> bin_dimensions) const;
   };
 
-  // State of the dynamic programming algorithm.
+  // State of the dynamic programming algorithm. Its used dimensions are stored
+  // in dp_state_dimensions_.
   struct DpState {
     int cur_item_index;
     int cur_item_quantity;
-    std::vector<int> used_dimensions;
     // DP State indices of the states that can be obtained by moving
     // either "right" to (cur_item_index, cur_item_quantity++) or "up"
     // to (cur_item_index++, cur_item_quantity=0). -1 if impossible.
@@ -69,8 +71,36 @@ class ArcFlowBuilder {
     int up_child;
   };
 
+  // Hashes and compares DP states by their used dimensions, so that a set of
+  // DP state indices can be looked up with the used dimensions.
+  struct DpStateHash {
+    using is_transparent = void;
+    size_t operator()(int state) const {
+      return (*this)(builder->DpStateDimensions(state));
+    }
+    size_t operator()(absl::Span<const int> used_dimensions) const {
+      return absl::HashOf(used_dimensions);
+    }
+    const ArcFlowBuilder* builder;
+  };
+  struct DpStateEq {
+    using is_transparent = void;
+    absl::Span<const int> Dimensions(int state) const {
+      return builder->DpStateDimensions(state);
+    }
+    absl::Span<const int> Dimensions(absl::Span<const int> dims) const {
+      return dims;
+    }
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+      return Dimensions(a) == Dimensions(b);
+    }
+    const ArcFlowBuilder* builder;
+  };
+  using DpStateSet = absl::flat_hash_set<int, DpStateHash, DpStateEq>;
+
   // Add item iteratively to create all possible nodes in a forward pass.
-  void ForwardCreationPass(DpState* dp_state);
+  void ForwardCreationPass(int state_index);
   // Scan DP-nodes backward to relabels each nodes by increasing them as much
   // as possible.
   void BackwardCompressionPass(int state_index);
@@ -79,13 +109,24 @@ class ArcFlowBuilder {
 
   // Can we fit one more item in the bin?
   bool CanFitNewItem(absl::Span<const int> used_dimensions, int item) const;
-  // Create a new used_dimensions that is used_dimensions + item dimensions.
-  std::vector<int> AddItem(const std::vector<int>& used_dimensions,
-                           int item) const;
 
-  // DpState helpers.
+  // DpState helpers. The used dimensions passed to LookupOrCreateDpState()
+  // must not point into dp_state_dimensions_, which it may reallocate.
   int LookupOrCreateDpState(int item, int quantity,
-                            const std::vector<int>& used_dimensions);
+                            absl::Span<const int> used_dimensions);
+  absl::Span<const int> DpStateDimensions(int state) const {
+    return absl::MakeConstSpan(dp_state_dimensions_)
+        .subspan(static_cast<size_t>(state) * bin_dimensions_.size(),
+                 bin_dimensions_.size());
+  }
+  absl::Span<int> MutableDpStateDimensions(int state) {
+    return absl::MakeSpan(dp_state_dimensions_)
+        .subspan(static_cast<size_t>(state) * bin_dimensions_.size(),
+                 bin_dimensions_.size());
+  }
+
+  // Sorts arcs_ and removes its duplicates.
+  void SortAndRemoveDuplicateArcs();
 
   const std::vector<int> bin_dimensions_;
   std::vector<Item> items_;
@@ -94,10 +135,17 @@ class ArcFlowBuilder {
   int GetOrCreateNode(const std::vector<int>& used_dimensions);
 
   // We store all DP states in a dense vector, and remember their index
-  // in the dp_state_index_ map (we use a tri-dimensional indexing because
-  // it's faster for the hash part).
-  std::vector<DpState*> dp_states_;
-  std::vector<std::vector<VectorIntIntMap>> dp_state_index_;
+  // in the dp_state_index_ set (we use a tri-dimensional indexing because
+  // it's faster for the hash part). The used dimensions of all the states are
+  // stored contiguously in dp_state_dimensions_, bin_dimensions_.size() values
+  // per state, since there are many millions of states for large capacities
+  // and a std::vector per state would more than double the memory usage.
+  std::vector<DpState> dp_states_;
+  std::vector<int> dp_state_dimensions_;
+  std::vector<std::vector<DpStateSet>> dp_state_index_;
+  // Buffers for ForwardCreationPass().
+  std::vector<int> used_dimensions_buffer_;
+  std::vector<int> added_dimensions_buffer_;
 
   // The ArcFlowGraph will have nodes which will correspond to "some"
   // of the vector<int> representing the partial bin usages encountered during
@@ -106,7 +154,9 @@ class ArcFlowBuilder {
   absl::flat_hash_map<std::vector<int>, int> node_indices_;
   std::vector<std::vector<int>> nodes_;
 
-  std::set<ArcFlowGraph::Arc> arcs_;
+  // Sorted and without duplicates after each pass. A sorted vector uses much
+  // less memory than a std::set.
+  std::vector<ArcFlowGraph::Arc> arcs_;
 };
 
 double ArcFlowBuilder::Item::NormalizedSize(
@@ -161,16 +211,6 @@ bool ArcFlowBuilder::CanFitNewItem(absl::Span<const int> used_dimensions,
   return true;
 }
 
-std::vector<int> ArcFlowBuilder::AddItem(
-    const std::vector<int>& used_dimensions, int item) const {
-  DCHECK(CanFitNewItem(used_dimensions, item));
-  std::vector<int> result = used_dimensions;
-  for (int d = 0; d < bin_dimensions_.size(); ++d) {
-    result[d] += items_[item].dimensions[d];
-  }
-  return result;
-}
-
 int ArcFlowBuilder::GetOrCreateNode(const std::vector<int>& used_dimensions) {
   const auto& it = node_indices_.find(used_dimensions);
   if (it != node_indices_.end()) {
@@ -184,125 +224,157 @@ int ArcFlowBuilder::GetOrCreateNode(const std::vector<int>& used_dimensions) {
 
 ArcFlowGraph ArcFlowBuilder::BuildVectorBinPackingGraph() {
   // Initialize the DP states map.
+  const DpStateSet empty_set(/*bucket_count=*/0, DpStateHash{this},
+                             DpStateEq{this});
   dp_state_index_.resize(items_.size());
   for (int i = 0; i < items_.size(); ++i) {
-    dp_state_index_[i].resize(items_[i].demand + 1);
+    dp_state_index_[i].resize(items_[i].demand + 1, empty_set);
   }
 
   // Explore all possible DP states (starting from the initial 'empty' state),
   // and remember their ancestry.
-  std::vector<int> zero(bin_dimensions_.size(), 0);
-  dp_states_.push_back(new DpState({0, 0, zero, -1, -1}));
+  dp_states_.push_back({0, 0, -1, -1});
+  dp_state_dimensions_.assign(bin_dimensions_.size(), 0);
   for (int i = 0; i < dp_states_.size(); ++i) {
-    ForwardCreationPass(dp_states_[i]);
+    ForwardCreationPass(i);
   }
 
   // We can clear the dp_state_index map as it will not be used anymore.
-  // From now on, we will use the dp_states.used_dimensions to store the new
+  // From now on, we will use the dp_state_dimensions_ to store the new
   // labels in the backward pass.
   const int64_t num_dp_states = NumDpStates();
-  dp_state_index_.clear();
+  dp_state_index_ = std::vector<std::vector<DpStateSet>>();
 
   // Backwards pass: "push" the bin dimensions as far as possible.
   const int num_states = dp_states_.size();
   std::vector<std::pair<int, int>> flat_deps;
   for (int i = 0; i < dp_states_.size(); ++i) {
-    if (dp_states_[i]->up_child != -1) {
-      flat_deps.push_back(std::make_pair(dp_states_[i]->up_child, i));
+    if (dp_states_[i].up_child != -1) {
+      flat_deps.push_back(std::make_pair(dp_states_[i].up_child, i));
     }
-    if (dp_states_[i]->right_child != -1) {
-      flat_deps.push_back(std::make_pair(dp_states_[i]->right_child, i));
+    if (dp_states_[i].right_child != -1) {
+      flat_deps.push_back(std::make_pair(dp_states_[i].right_child, i));
     }
   }
   const std::vector<int> sorted_work =
       util::graph::DenseIntStableTopologicalSortOrDie(num_states, flat_deps);
+  flat_deps = std::vector<std::pair<int, int>>();
   for (const int w : sorted_work) {
     BackwardCompressionPass(w);
   }
+  SortAndRemoveDuplicateArcs();
 
   // ForwardCreationPass again, push the bin dimensions as low as possible.
-  const std::vector<int> source_node = dp_states_[0]->used_dimensions;
-  // We can now delete the states stored in dp_states_.
-  gtl::STLDeleteElements(&dp_states_);
+  const absl::Span<const int> source_dimensions = DpStateDimensions(0);
+  const std::vector<int> source_node(source_dimensions.begin(),
+                                     source_dimensions.end());
+  // We can now delete the DP states.
+  dp_states_ = std::vector<DpState>();
+  dp_state_dimensions_ = std::vector<int>();
   ForwardCompressionPass(source_node);
 
   // We need to connect all nodes that corresponds to at least one item selected
   // to the sink node.
   const int sink_node_index = nodes_.size() - 1;
   for (int node = 1; node < sink_node_index; ++node) {
-    arcs_.insert({node, sink_node_index, -1});
+    arcs_.push_back({node, sink_node_index, -1});
   }
+  SortAndRemoveDuplicateArcs();
 
   ArcFlowGraph result;
-  result.arcs.assign(arcs_.begin(), arcs_.end());
+  result.arcs = std::move(arcs_);
   result.nodes.assign(nodes_.begin(), nodes_.end());
   result.num_dp_states = num_dp_states;
   return result;
 }
 
 int ArcFlowBuilder::LookupOrCreateDpState(
-    int item, int quantity, const std::vector<int>& used_dimensions) {
-  VectorIntIntMap& map = dp_state_index_[item][quantity];
-  const int index =
-      map.insert({used_dimensions, dp_states_.size()}).first->second;
-  if (index == dp_states_.size()) {
-    dp_states_.push_back(
-        new DpState({item, quantity, used_dimensions, -1, -1}));
-  }
+    int item, int quantity, absl::Span<const int> used_dimensions) {
+  DpStateSet& set = dp_state_index_[item][quantity];
+  const auto it = set.find(used_dimensions);
+  if (it != set.end()) return *it;
+  const int index = dp_states_.size();
+  dp_states_.push_back({item, quantity, -1, -1});
+  dp_state_dimensions_.insert(dp_state_dimensions_.end(),
+                              used_dimensions.begin(), used_dimensions.end());
+  set.insert(index);
   return index;
 }
 
-void ArcFlowBuilder::ForwardCreationPass(DpState* dp_state) {
-  const int item = dp_state->cur_item_index;
-  const int quantity = dp_state->cur_item_quantity;
-  const std::vector<int>& used_dimensions = dp_state->used_dimensions;
+void ArcFlowBuilder::ForwardCreationPass(int state_index) {
+  const int item = dp_states_[state_index].cur_item_index;
+  const int quantity = dp_states_[state_index].cur_item_quantity;
+  // Copied, since creating the children may reallocate dp_state_dimensions_.
+  const absl::Span<const int> state_dimensions = DpStateDimensions(state_index);
+  used_dimensions_buffer_.assign(state_dimensions.begin(),
+                                 state_dimensions.end());
+  const std::vector<int>& used_dimensions = used_dimensions_buffer_;
 
   // Explore path up.
+  int up_child = -1;
   if (item < items_.size() - 1) {
-    dp_state->up_child = LookupOrCreateDpState(item + 1, 0, used_dimensions);
-  } else {
-    dp_state->up_child = -1;
+    up_child = LookupOrCreateDpState(item + 1, 0, used_dimensions);
   }
 
   // Explore path right.
+  int right_child = -1;
   if (quantity < items_[item].demand && CanFitNewItem(used_dimensions, item)) {
-    const std::vector<int> added = AddItem(used_dimensions, item);
-    dp_state->right_child = LookupOrCreateDpState(item, quantity + 1, added);
-  } else {
-    dp_state->right_child = -1;
+    added_dimensions_buffer_ = used_dimensions;
+    for (int d = 0; d < bin_dimensions_.size(); ++d) {
+      added_dimensions_buffer_[d] += items_[item].dimensions[d];
+    }
+    right_child =
+        LookupOrCreateDpState(item, quantity + 1, added_dimensions_buffer_);
   }
+  dp_states_[state_index].up_child = up_child;
+  dp_states_[state_index].right_child = right_child;
 }
 
 void ArcFlowBuilder::BackwardCompressionPass(int state_index) {
   // The goal of this function is to fill this.
-  std::vector<int>& result = dp_states_[state_index]->used_dimensions;
+  std::vector<int> result;
 
   // Inherit our result from the result one step up.
-  const int up_index = dp_states_[state_index]->up_child;
-  const std::vector<int>& result_up =
-      up_index == -1 ? bin_dimensions_ : dp_states_[up_index]->used_dimensions;
-  result = result_up;
+  const int up_index = dp_states_[state_index].up_child;
+  const absl::Span<const int> result_up =
+      up_index == -1 ? absl::MakeConstSpan(bin_dimensions_)
+                     : DpStateDimensions(up_index);
+  result.assign(result_up.begin(), result_up.end());
 
   // Adjust our result from the result one step right.
-  const int right_index = dp_states_[state_index]->right_child;
-  if (right_index == -1) return;  // We're done.
-  const std::vector<int>& result_right =
-      dp_states_[right_index]->used_dimensions;
-  const Item& item = items_[dp_states_[state_index]->cur_item_index];
-  for (int d = 0; d < bin_dimensions_.size(); ++d) {
-    result[d] = std::min(result[d], result_right[d] - item.dimensions[d]);
-  }
+  const int right_index = dp_states_[state_index].right_child;
+  if (right_index != -1) {
+    const absl::Span<const int> result_right = DpStateDimensions(right_index);
+    const Item& item = items_[dp_states_[state_index].cur_item_index];
+    for (int d = 0; d < bin_dimensions_.size(); ++d) {
+      result[d] = std::min(result[d], result_right[d] - item.dimensions[d]);
+    }
 
-  // Insert the arc from the node to the "right" node.
-  const int node = GetOrCreateNode(result);
-  const int right_node = GetOrCreateNode(result_right);
-  DCHECK_NE(node, right_node);
-  arcs_.insert({node, right_node, item.original_index});
-  // Also insert the 'dotted' arc from the node to the "up" node (if different).
-  if (result != result_up) {
-    const int up_node = GetOrCreateNode(result_up);
-    arcs_.insert({node, up_node, -1});
+    // Insert the arc from the node to the "right" node.
+    const int node = GetOrCreateNode(result);
+    const int right_node = GetOrCreateNode(
+        std::vector<int>(result_right.begin(), result_right.end()));
+    DCHECK_NE(node, right_node);
+    arcs_.push_back({node, right_node, item.original_index});
+    // Also insert the 'dotted' arc from the node to the "up" node (if
+    // different).
+    if (result_up != absl::MakeConstSpan(result)) {
+      const int up_node = GetOrCreateNode(
+          std::vector<int>(result_up.begin(), result_up.end()));
+      arcs_.push_back({node, up_node, -1});
+    }
   }
+  absl::c_copy(result, MutableDpStateDimensions(state_index).begin());
+}
+
+void ArcFlowBuilder::SortAndRemoveDuplicateArcs() {
+  std::sort(arcs_.begin(), arcs_.end());
+  arcs_.erase(std::unique(arcs_.begin(), arcs_.end(),
+                          [](const ArcFlowGraph::Arc& a,
+                             const ArcFlowGraph::Arc& b) {
+                            return !(a < b) && !(b < a);
+                          }),
+              arcs_.end());
 }
 
 // Reverse version of the backward pass.
@@ -313,7 +385,7 @@ void ArcFlowBuilder::ForwardCompressionPass(
     const std::vector<int>& source_node) {
   const int num_nodes = node_indices_.size();
   const int num_dims = bin_dimensions_.size();
-  std::set<ArcFlowGraph::Arc> new_arcs;
+  std::vector<ArcFlowGraph::Arc> new_arcs;
   std::vector<std::vector<int>> new_nodes;
   VectorIntIntMap new_node_indices;
   std::vector<int> node_remap(num_nodes, -1);
@@ -379,13 +451,15 @@ void ArcFlowBuilder::ForwardCompressionPass(
     if (arc.item_index == -1 &&
         node_remap[arc.source] == node_remap[arc.destination])
       continue;
-    new_arcs.insert(
+    new_arcs.push_back(
         {node_remap[arc.source], node_remap[arc.destination], arc.item_index});
   }
-  VLOG(1) << "Reduced nodes from " << num_nodes << " to " << new_nodes.size();
-  VLOG(1) << "Reduced arcs from " << arcs_.size() << " to " << new_arcs.size();
-  nodes_ = new_nodes;
-  arcs_ = new_arcs;
+  const int num_arcs = arcs_.size();
+  nodes_ = std::move(new_nodes);
+  arcs_ = std::move(new_arcs);
+  SortAndRemoveDuplicateArcs();
+  VLOG(1) << "Reduced nodes from " << num_nodes << " to " << nodes_.size();
+  VLOG(1) << "Reduced arcs from " << num_arcs << " to " << arcs_.size();
   CHECK_NE(node_remap[old_source_node], -1);
   CHECK_EQ(0, node_remap[old_source_node]);
   CHECK_NE(node_remap[old_sink_node], -1);
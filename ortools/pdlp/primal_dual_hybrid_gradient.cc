@@ -40,6 +40,7 @@
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/base/timer.h"
+#include "ortools/glop/lp_solver.h"
 #include "ortools/glop/parameters.pb.h"
 #include "ortools/glop/preprocessor.h"
 #include "ortools/linear_solver/linear_solver.pb.h"
@@ -92,9 +93,10 @@ int NumThreads(const int num_threads, const int num_shards,
 // If `num_shards` is positive, returns it. Otherwise returns a reasonable
 // number of shards to use with `ShardedQuadraticProgram` for the given
 // `num_threads`.
-int NumShards(const int num_threads, const int num_shards) {
+int NumShards(const int num_threads, const int num_shards,
+              const int num_shards_per_thread) {
   if (num_shards > 0) return num_shards;
-  return num_threads == 1 ? 1 : 4 * num_threads;
+  return num_threads == 1 ? 1 : num_shards_per_thread * num_threads;
 }
 
 std::string ConvergenceInformationString(
@@ -417,6 +419,10 @@ class PreprocessSolver {
     return original_bound_norms_;
   }
 
+  void ClearSinglePrecisionConstraintMatrices() {
+    sharded_qp_.ClearSinglePrecisionConstraintMatrices();
+  }
+
   SolverLogger& Logger() { return logger_; }
 
  private:
@@ -544,6 +550,8 @@ class Solver {
     VectorXd value;
     // `delta` is `value` - current_solution.
     VectorXd delta;
+    // The squared l2 norm of `delta`, computed in the same pass as `value`.
+    double delta_squared_norm = 0.0;
   };
 
   struct DistanceBasedRestartInfo {
@@ -585,11 +593,35 @@ class Solver {
       double dual_step_size, double extrapolation_factor,
       const NextSolutionAndDelta& next_primal) const;
 
-  double ComputeMovement(const VectorXd& delta_primal,
-                         const VectorXd& delta_dual) const;
+  // Same as `ComputeNextDualSolution()`, but given the product of the
+  // constraint matrix with the extrapolated primal solution.
+  NextSolutionAndDelta ComputeNextDualSolutionFromProduct(
+      double dual_step_size,
+      const VectorXd& extrapolated_primal_product) const;
+
+  // Returns `constraint_matrix * primal_solution`. Like the next function, it
+  // uses the single precision constraint matrix when there is one.
+  VectorXd ConstraintMatrixProduct(const VectorXd& primal_solution) const;
+
+  // Returns `constraint_matrix.transpose() * dual_solution`.
+  VectorXd ConstraintMatrixTransposeProduct(
+      const VectorXd& dual_solution) const;
+
+  // If the working QP has single precision constraint matrices and one of the
+  // iterates in `stats` meets the optimality criteria with all tolerances
+  // multiplied by `single_precision_switch_factor`, clears these matrices so
+  // that the rest of the solve uses the double precision ones.
+  void MaybeSwitchToDoublePrecisionMatrices(const IterationStats& stats);
 
-  double ComputeNonlinearity(const VectorXd& delta_primal,
-                             const VectorXd& next_dual_product) const;
+  double ComputeMovement(const NextSolutionAndDelta& next_primal_solution,
+                         const NextSolutionAndDelta& next_dual_solution) const;
+
+  // Sets `next_dual_product` to
+  // `constraint_matrix.transpose() * next_dual_solution` and returns the
+  // nonlinearity term of the adaptive step size rule, in a single pass.
+  double ComputeNextDualProductAndNonlinearity(
+      const VectorXd& next_dual_solution, const VectorXd& delta_primal,
+      VectorXd& next_dual_product) const;
 
   // Creates all the simple-to-compute statistics in stats.
   IterationStats CreateSimpleIterationStats(RestartChoice restart_used) const;
@@ -648,6 +680,9 @@ class Solver {
 
   void LogInnerIterationLimitHit() const;
 
+  // Fills `solve_log.timing_details` if `record_timing_details` is true.
+  void RecordTimingDetails(SolveLog& solve_log) const;
+
   // Takes a step based on the Malitsky and Pock linesearch algorithm.
   // (https://arxiv.org/pdf/1608.08883.pdf)
   // The current implementation is provably convergent (at an optimal rate)
@@ -692,10 +727,18 @@ class Solver {
   // computing `cumulative_time_sec` in iteration stats.
   double preprocessing_time_sec_;
   WallTimer timer_;
+  // The time in the phases of the main iterations, see `TimingDetails`.
+  WallTimer step_timer_;
+  WallTimer restart_timer_;
+  WallTimer termination_check_timer_;
   int iterations_completed_;
   int num_rejected_steps_;
   // A cache of `constraint_matrix.transpose() * current_dual_solution_`.
   VectorXd current_dual_product_;
+  // A cache of `constraint_matrix * current_primal_solution_`, only used and
+  // maintained by the Malitsky and Pock linesearch. It is reset whenever
+  // `current_primal_solution_` is changed by another step.
+  std::optional<VectorXd> current_primal_product_;
   // The primal point at which the algorithm was last restarted from, or
   // the initial primal starting point if no restart has occurred.
   VectorXd last_primal_start_point_;
@@ -717,7 +760,8 @@ PreprocessSolver::PreprocessSolver(QuadraticProgram qp,
                                    SolverLogger* logger)
     : num_threads_(
           NumThreads(params.num_threads(), params.num_shards(), qp, *logger)),
-      num_shards_(NumShards(num_threads_, params.num_shards())),
+      num_shards_(NumShards(num_threads_, params.num_shards(),
+                            params.num_shards_per_thread())),
       sharded_qp_(std::move(qp), num_threads_, num_shards_),
       logger_(*logger) {}
 
@@ -1114,6 +1158,9 @@ SolverResult PreprocessSolver::PreprocessAndSolve(
 
   ComputeAndApplyRescaling(params, starting_primal_solution,
                            starting_dual_solution);
+  if (params.use_single_precision_constraint_matrix()) {
+    sharded_qp_.CreateSinglePrecisionConstraintMatrices();
+  }
   *solve_log.mutable_preprocessed_problem_stats() = ComputeStats(sharded_qp_);
   if (params.verbosity_level() >= 1) {
     SOLVER_LOG(&logger_, "Problem stats after ", preprocessing_string);
@@ -1795,8 +1842,9 @@ Solver::NextSolutionAndDelta Solver::ComputeNextPrimalSolution(
   // We omitted the constant terms from Chambolle and Pock's (7).
   // This minimization is easy to do in closed form since it can be separated
   // into independent problems for each of the primal variables.
-  ShardedWorkingQp().PrimalSharder().ParallelForEachShard(
-      [&](const Sharder::Shard& shard) {
+  const Sharder& sharder = ShardedWorkingQp().PrimalSharder();
+  result.delta_squared_norm =
+      sharder.ParallelSumOverShards([&](const Sharder::Shard& shard) {
         if (!IsLinearProgram(qp)) {
           // TODO(user): Does changing this to auto (so it becomes an
           // Eigen deferred result), or inlining it below, change performance?
@@ -1823,6 +1871,7 @@ Solver::NextSolutionAndDelta Solver::ComputeNextPrimalSolution(
         }
         shard(result.delta) =
             shard(result.value) - shard(current_primal_solution_);
+        return shard(result.delta).squaredNorm();
       });
   return result;
 }
@@ -1843,11 +1892,16 @@ Solver::NextSolutionAndDelta Solver::ComputeNextDualSolution(
             (shard(next_primal_solution.value) +
              extrapolation_factor * shard(next_primal_solution.delta));
       });
-  // TODO(user): Refactor this multiplication so that we only do one matrix
-  // vector multiply for the primal variable. This only applies to Malitsky and
-  // Pock and not to the adaptive step size rule.
-  ShardedWorkingQp().TransposedConstraintMatrixSharder().ParallelForEachShard(
-      [&](const Sharder::Shard& shard) {
+  if (ShardedWorkingQp().HasSinglePrecisionConstraintMatrices()) {
+    return ComputeNextDualSolutionFromProduct(
+        dual_step_size, ConstraintMatrixProduct(extrapolated_primal));
+  }
+  // Note that the Malitsky and Pock rule does not use this function, see
+  // `ComputeNextDualSolutionFromProduct()`.
+  const Sharder& sharder =
+      ShardedWorkingQp().TransposedConstraintMatrixSharder();
+  result.delta_squared_norm =
+      sharder.ParallelSumOverShards([&](const Sharder::Shard& shard) {
         VectorXd temp =
             shard(current_dual_solution_) -
             dual_step_size *
@@ -1866,31 +1920,159 @@ Solver::NextSolutionAndDelta Solver::ComputeNextDualSolution(
                           dual_step_size * shard(qp.constraint_lower_bounds));
         shard(result.delta) =
             (shard(result.value) - shard(current_dual_solution_));
+        return shard(result.delta).squaredNorm();
+      });
+  return result;
+}
+
+Solver::NextSolutionAndDelta Solver::ComputeNextDualSolutionFromProduct(
+    double dual_step_size, const VectorXd& extrapolated_primal_product) const {
+  const int64_t dual_size = ShardedWorkingQp().DualSize();
+  NextSolutionAndDelta result = {
+      .value = VectorXd(dual_size),
+      .delta = VectorXd(dual_size),
+  };
+  const QuadraticProgram& qp = WorkingQp();
+  const Sharder& sharder = ShardedWorkingQp().DualSharder();
+  result.delta_squared_norm =
+      sharder.ParallelSumOverShards([&](const Sharder::Shard& shard) {
+        VectorXd temp = shard(current_dual_solution_) -
+                        dual_step_size * shard(extrapolated_primal_product);
+        // See `ComputeNextDualSolution()`.
+        shard(result.value) =
+            VectorXd::Zero(temp.size())
+                .cwiseMin(temp +
+                          dual_step_size * shard(qp.constraint_upper_bounds))
+                .cwiseMax(temp +
+                          dual_step_size * shard(qp.constraint_lower_bounds));
+        shard(result.delta) =
+            (shard(result.value) - shard(current_dual_solution_));
+        return shard(result.delta).squaredNorm();
       });
   return result;
 }
 
-double Solver::ComputeMovement(const VectorXd& delta_primal,
-                               const VectorXd& delta_dual) const {
+VectorXd Solver::ConstraintMatrixProduct(
+    const VectorXd& primal_solution) const {
+  const ShardedQuadraticProgram& sharded_qp = ShardedWorkingQp();
+  if (sharded_qp.HasSinglePrecisionConstraintMatrices()) {
+    return TransposedMatrixVectorProduct(
+        sharded_qp.SinglePrecisionTransposedConstraintMatrix(),
+        primal_solution, sharded_qp.TransposedConstraintMatrixSharder());
+  }
+  return TransposedMatrixVectorProduct(
+      sharded_qp.TransposedConstraintMatrix(), primal_solution,
+      sharded_qp.TransposedConstraintMatrixSharder());
+}
+
+VectorXd Solver::ConstraintMatrixTransposeProduct(
+    const VectorXd& dual_solution) const {
+  const ShardedQuadraticProgram& sharded_qp = ShardedWorkingQp();
+  if (sharded_qp.HasSinglePrecisionConstraintMatrices()) {
+    return TransposedMatrixVectorProduct(
+        sharded_qp.SinglePrecisionConstraintMatrix(), dual_solution,
+        sharded_qp.ConstraintMatrixSharder());
+  }
+  return TransposedMatrixVectorProduct(sharded_qp.Qp().constraint_matrix,
+                                       dual_solution,
+                                       sharded_qp.ConstraintMatrixSharder());
+}
+
+void Solver::MaybeSwitchToDoublePrecisionMatrices(
+    const IterationStats& stats) {
+  if (!ShardedWorkingQp().HasSinglePrecisionConstraintMatrices()) return;
+  TerminationCriteria::DetailedOptimalityCriteria criteria =
+      EffectiveOptimalityCriteria(params_.termination_criteria());
+  const double factor = params_.single_precision_switch_factor();
+  criteria.set_eps_optimal_primal_residual_absolute(
+      factor * criteria.eps_optimal_primal_residual_absolute());
+  criteria.set_eps_optimal_primal_residual_relative(
+      factor * criteria.eps_optimal_primal_residual_relative());
+  criteria.set_eps_optimal_dual_residual_absolute(
+      factor * criteria.eps_optimal_dual_residual_absolute());
+  criteria.set_eps_optimal_dual_residual_relative(
+      factor * criteria.eps_optimal_dual_residual_relative());
+  criteria.set_eps_optimal_objective_gap_absolute(
+      factor * criteria.eps_optimal_objective_gap_absolute());
+  criteria.set_eps_optimal_objective_gap_relative(
+      factor * criteria.eps_optimal_objective_gap_relative());
+  const bool close_to_optimal = absl::c_any_of(
+      stats.convergence_information(),
+      [&](const ConvergenceInformation& convergence_information) {
+        return OptimalityCriteriaMet(
+            criteria, convergence_information,
+            params_.termination_criteria().optimality_norm(),
+            preprocess_solver_->OriginalBoundNorms());
+      });
+  if (!close_to_optimal) return;
+  if (params_.verbosity_level() >= 2) {
+    SOLVER_LOG(&preprocess_solver_->Logger(),
+               "Switching to the double precision constraint matrix at "
+               "iteration ",
+               iterations_completed_);
+  }
+  preprocess_solver_->ClearSinglePrecisionConstraintMatrices();
+  // The cached products were computed with the single precision matrices.
+  current_dual_product_ =
+      ConstraintMatrixTransposeProduct(current_dual_solution_);
+  current_primal_product_.reset();
+}
+
+double Solver::ComputeMovement(
+    const NextSolutionAndDelta& next_primal_solution,
+    const NextSolutionAndDelta& next_dual_solution) const {
   const double primal_movement =
-      (0.5 * primal_weight_) *
-      SquaredNorm(delta_primal, ShardedWorkingQp().PrimalSharder());
+      (0.5 * primal_weight_) * next_primal_solution.delta_squared_norm;
   const double dual_movement =
-      (0.5 / primal_weight_) *
-      SquaredNorm(delta_dual, ShardedWorkingQp().DualSharder());
+      (0.5 / primal_weight_) * next_dual_solution.delta_squared_norm;
   return primal_movement + dual_movement;
 }
 
-double Solver::ComputeNonlinearity(const VectorXd& delta_primal,
-                                   const VectorXd& next_dual_product) const {
+// Sets `product` to `matrix.transpose() * vector` and returns
+// `-delta.dot(product - previous_product)`, in a single pass over the columns
+// of `matrix`. `sharder` must shard these columns.
+template <typename Scalar>
+double TransposedMatrixVectorProductAndDot(
+    const Eigen::SparseMatrix<Scalar, Eigen::ColMajor, int64_t>& matrix,
+    const VectorXd& vector, const VectorXd& delta,
+    const VectorXd& previous_product, const Sharder& sharder,
+    VectorXd& product) {
+  CHECK_EQ(vector.size(), matrix.rows());
+  product.resize(matrix.cols());
+  return sharder.ParallelSumOverShards([&](const Sharder::Shard& shard) {
+    const int64_t shard_start = sharder.ShardStart(shard.Index());
+    const int64_t shard_end = shard_start + sharder.ShardSize(shard.Index());
+    double result = 0.0;
+    for (int64_t col = shard_start; col < shard_end; ++col) {
+      double value = 0.0;
+      for (typename Eigen::SparseMatrix<Scalar, Eigen::ColMajor,
+                                        int64_t>::InnerIterator it(matrix, col);
+           it; ++it) {
+        value += static_cast<double>(it.value()) * vector[it.row()];
+      }
+      product[col] = value;
+      result -= delta[col] * (value - previous_product[col]);
+    }
+    return result;
+  });
+}
+
+double Solver::ComputeNextDualProductAndNonlinearity(
+    const VectorXd& next_dual_solution, const VectorXd& delta_primal,
+    VectorXd& next_dual_product) const {
   // Lemma 1 in Chambolle and Pock includes a term with L_f, the Lipshitz
   // constant of f. This is zero in our formulation.
-  return ShardedWorkingQp().PrimalSharder().ParallelSumOverShards(
-      [&](const Sharder::Shard& shard) {
-        return -shard(delta_primal)
-                    .dot(shard(next_dual_product) -
-                         shard(current_dual_product_));
-      });
+  const ShardedQuadraticProgram& sharded_qp = ShardedWorkingQp();
+  if (sharded_qp.HasSinglePrecisionConstraintMatrices()) {
+    return TransposedMatrixVectorProductAndDot(
+        sharded_qp.SinglePrecisionConstraintMatrix(), next_dual_solution,
+        delta_primal, current_dual_product_,
+        sharded_qp.ConstraintMatrixSharder(), next_dual_product);
+  }
+  return TransposedMatrixVectorProductAndDot(
+      sharded_qp.Qp().constraint_matrix, next_dual_solution, delta_primal,
+      current_dual_product_, sharded_qp.ConstraintMatrixSharder(),
+      next_dual_product);
 }
 
 IterationStats Solver::CreateSimpleIterationStats(
@@ -2180,10 +2362,10 @@ void Solver::ApplyRestartChoice(const RestartChoice restart_to_apply) {
                    " after ", primal_average_.NumTerms(), " iterations");
       }
       current_primal_solution_ = primal_average_.ComputeAverage();
+      current_primal_product_.reset();
       current_dual_solution_ = dual_average_.ComputeAverage();
-      current_dual_product_ = TransposedMatrixVectorProduct(
-          WorkingQp().constraint_matrix, current_dual_solution_,
-          ShardedWorkingQp().ConstraintMatrixSharder());
+      current_dual_product_ =
+          ConstraintMatrixTransposeProduct(current_dual_solution_);
       break;
   }
   primal_weight_ = ComputeNewPrimalWeight();
@@ -2258,9 +2440,11 @@ std::optional<SolverResult> Solver::MajorIterationAndTerminationCheck(
       major_iteration_cycle == 0 && iterations_completed_ > 0;
   // Just decide what to do for now. The actual restart, if any, is
   // performed after the termination check.
+  restart_timer_.Start();
   const RestartChoice restart = force_numerical_termination
                                     ? RESTART_CHOICE_NO_RESTART
                                     : ChooseRestartToApply(is_major_iteration);
+  restart_timer_.Stop();
   IterationStats stats = CreateSimpleIterationStats(restart);
   IterationStats full_work_stats =
       AddWorkStats(stats, work_from_feasibility_polishing);
@@ -2276,6 +2460,7 @@ std::optional<SolverResult> Solver::MajorIterationAndTerminationCheck(
     // Check for termination and update iteration stats with both simple and
     // solution statistics. The later are computationally harder to compute and
     // hence only computed here.
+    termination_check_timer_.Start();
     VectorXd primal_average = PrimalAverage();
     VectorXd dual_average = DualAverage();
 
@@ -2291,6 +2476,7 @@ std::optional<SolverResult> Solver::MajorIterationAndTerminationCheck(
                 current_dual_delta_.size() > 0 ? &current_dual_delta_ : nullptr,
                 last_primal_start_point_, last_dual_start_point_,
                 interrupt_solve, iteration_type, full_work_stats, stats);
+    termination_check_timer_.Stop();
     if (params_.record_iteration_stats()) {
       *solve_log.add_iteration_stats() = stats;
     }
@@ -2298,19 +2484,72 @@ std::optional<SolverResult> Solver::MajorIterationAndTerminationCheck(
     if (maybe_termination_reason.has_value()) {
       IterationStats terminating_full_stats =
           AddWorkStats(stats, work_from_feasibility_polishing);
+      RecordTimingDetails(solve_log);
       return PickSolutionAndConstructSolverResult(
           std::move(primal_average), std::move(dual_average),
           terminating_full_stats, maybe_termination_reason->reason,
           maybe_termination_reason->type, std::move(solve_log));
     }
+    if (iteration_type == IterationType::kNormal) {
+      MaybeSwitchToDoublePrecisionMatrices(stats);
+    }
   } else if (params_.record_iteration_stats()) {
     // Record simple iteration stats only.
     *solve_log.add_iteration_stats() = stats;
   }
+  restart_timer_.Start();
   ApplyRestartChoice(restart);
+  restart_timer_.Stop();
   return std::nullopt;
 }
 
+// Returns the largest shard mass divided by the average shard mass, or 1.0 if
+// `sharder` has no mass.
+double ShardImbalance(const Sharder& sharder) {
+  int64_t total_mass = 0;
+  int64_t max_mass = 0;
+  for (int shard = 0; shard < sharder.NumShards(); ++shard) {
+    total_mass += sharder.ShardMass(shard);
+    max_mass = std::max(max_mass, sharder.ShardMass(shard));
+  }
+  if (total_mass == 0) return 1.0;
+  return static_cast<double>(max_mass) * sharder.NumShards() / total_mass;
+}
+
+// Returns the size in bytes of the values, inner indices, and outer indices of
+// `matrix`.
+template <typename Scalar>
+int64_t SparseMatrixBytes(
+    const Eigen::SparseMatrix<Scalar, Eigen::ColMajor, int64_t>& matrix) {
+  return matrix.nonZeros() * (sizeof(Scalar) + sizeof(int64_t)) +
+         (matrix.outerSize() + 1) * sizeof(int64_t);
+}
+
+void Solver::RecordTimingDetails(SolveLog& solve_log) const {
+  if (!params_.record_timing_details()) return;
+  const ShardedQuadraticProgram& sharded_qp = ShardedWorkingQp();
+  TimingDetails& details = *solve_log.mutable_timing_details();
+  details.set_step_time_sec(step_timer_.Get());
+  details.set_restart_time_sec(restart_timer_.Get());
+  details.set_termination_check_time_sec(termination_check_timer_.Get());
+  details.set_constraint_matrix_shard_imbalance(
+      ShardImbalance(sharded_qp.ConstraintMatrixSharder()));
+  details.set_transposed_constraint_matrix_shard_imbalance(
+      ShardImbalance(sharded_qp.TransposedConstraintMatrixSharder()));
+  const int64_t matrix_bytes =
+      sharded_qp.HasSinglePrecisionConstraintMatrices()
+          ? SparseMatrixBytes(sharded_qp.SinglePrecisionConstraintMatrix())
+          : SparseMatrixBytes(sharded_qp.Qp().constraint_matrix);
+  details.set_constraint_matrix_bytes(matrix_bytes);
+  if (step_timer_.Get() > 0.0) {
+    const double kkt_matrix_passes =
+        CreateSimpleIterationStats(RESTART_CHOICE_UNSPECIFIED)
+            .cumulative_kkt_matrix_passes();
+    details.set_estimated_bandwidth_bytes_per_sec(
+        2.0 * kkt_matrix_passes * matrix_bytes / step_timer_.Get());
+  }
+}
+
 void Solver::ResetAverageToCurrent() {
   primal_average_.Clear();
   dual_average_.Clear();
@@ -2337,6 +2576,16 @@ InnerStepOutcome Solver::TakeMalitskyPockStep() {
   const double primal_step_size = step_size_ / primal_weight_;
   NextSolutionAndDelta next_primal_solution =
       ComputeNextPrimalSolution(primal_step_size);
+  // The extrapolated primal solution only depends on the step sizes through
+  // `new_last_two_step_sizes_ratio` below, so its product with the constraint
+  // matrix is a linear combination of these two products. This way, the
+  // linesearch needs a single matrix vector product per rejected step.
+  if (!current_primal_product_.has_value()) {
+    current_primal_product_ = ConstraintMatrixProduct(current_primal_solution_);
+  }
+  VectorXd next_primal_product =
+      ConstraintMatrixProduct(next_primal_solution.value);
+  VectorXd extrapolated_primal_product(ShardedWorkingQp().DualSize());
   // The theory by Malitsky and Pock holds for any new_step_size in the interval
   // [`step_size`, `step_size` * sqrt(1 + `ratio_last_two_step_sizes_`)].
   // `dilating_coeff` determines where in this interval the new step size lands.
@@ -2360,15 +2609,21 @@ InnerStepOutcome Solver::TakeMalitskyPockStep() {
     }
     const double new_last_two_step_sizes_ratio =
         new_primal_step_size / primal_step_size;
-    NextSolutionAndDelta next_dual_solution = ComputeNextDualSolution(
-        dual_weight * new_primal_step_size, new_last_two_step_sizes_ratio,
-        next_primal_solution);
-
-    VectorXd next_dual_product = TransposedMatrixVectorProduct(
-        WorkingQp().constraint_matrix, next_dual_solution.value,
-        ShardedWorkingQp().ConstraintMatrixSharder());
-    double delta_dual_norm =
-        Norm(next_dual_solution.delta, ShardedWorkingQp().DualSharder());
+    ShardedWorkingQp().DualSharder().ParallelForEachShard(
+        [&](const Sharder::Shard& shard) {
+          shard(extrapolated_primal_product) =
+              shard(next_primal_product) +
+              new_last_two_step_sizes_ratio *
+                  (shard(next_primal_product) -
+                   shard(*current_primal_product_));
+        });
+    NextSolutionAndDelta next_dual_solution =
+        ComputeNextDualSolutionFromProduct(dual_weight * new_primal_step_size,
+                                           extrapolated_primal_product);
+
+    VectorXd next_dual_product =
+        ConstraintMatrixTransposeProduct(next_dual_solution.value);
+    double delta_dual_norm = std::sqrt(next_dual_solution.delta_squared_norm);
     double delta_dual_prod_norm =
         Distance(current_dual_product_, next_dual_product,
                  ShardedWorkingQp().PrimalSharder());
@@ -2388,6 +2643,7 @@ InnerStepOutcome Solver::TakeMalitskyPockStep() {
       }
 
       current_primal_solution_ = std::move(next_primal_solution.value);
+      current_primal_product_ = std::move(next_primal_product);
       current_dual_solution_ = std::move(next_dual_solution.value);
       current_dual_product_ = std::move(next_dual_product);
       primal_average_.Add(current_primal_solution_,
@@ -2395,7 +2651,7 @@ InnerStepOutcome Solver::TakeMalitskyPockStep() {
       dual_average_.Add(current_dual_solution_,
                         /*weight=*/new_primal_step_size);
       const double movement =
-          ComputeMovement(next_primal_solution.delta, next_dual_solution.delta);
+          ComputeMovement(next_primal_solution, next_dual_solution);
       if (movement == 0.0) {
         LogNumericalTermination();
         ResetAverageToCurrent();
@@ -2433,7 +2689,7 @@ InnerStepOutcome Solver::TakeAdaptiveStep() {
     NextSolutionAndDelta next_dual_solution = ComputeNextDualSolution(
         dual_step_size, /*extrapolation_factor=*/1.0, next_primal_solution);
     const double movement =
-        ComputeMovement(next_primal_solution.delta, next_dual_solution.delta);
+        ComputeMovement(next_primal_solution, next_dual_solution);
     if (movement == 0.0) {
       LogNumericalTermination();
       ResetAverageToCurrent();
@@ -2444,11 +2700,10 @@ InnerStepOutcome Solver::TakeAdaptiveStep() {
       outcome = InnerStepOutcome::kForceNumericalTermination;
       break;
     }
-    VectorXd next_dual_product = TransposedMatrixVectorProduct(
-        WorkingQp().constraint_matrix, next_dual_solution.value,
-        ShardedWorkingQp().ConstraintMatrixSharder());
-    const double nonlinearity =
-        ComputeNonlinearity(next_primal_solution.delta, next_dual_product);
+    VectorXd next_dual_product;
+    const double nonlinearity = ComputeNextDualProductAndNonlinearity(
+        next_dual_solution.value, next_primal_solution.delta,
+        next_dual_product);
 
     // See equation (5) in https://arxiv.org/pdf/2106.04756.pdf.
     const double step_size_limit =
@@ -2457,6 +2712,7 @@ InnerStepOutcome Solver::TakeAdaptiveStep() {
 
     if (step_size_ <= step_size_limit) {
       current_primal_solution_ = std::move(next_primal_solution.value);
+      current_primal_product_.reset();
       current_dual_solution_ = std::move(next_dual_solution.value);
       current_dual_product_ = std::move(next_dual_product);
       current_primal_delta_ = std::move(next_primal_solution.delta);
@@ -2507,7 +2763,7 @@ InnerStepOutcome Solver::TakeConstantSizeStep() {
   NextSolutionAndDelta next_dual_solution = ComputeNextDualSolution(
       dual_step_size, /*extrapolation_factor=*/1.0, next_primal_solution);
   const double movement =
-      ComputeMovement(next_primal_solution.delta, next_dual_solution.delta);
+      ComputeMovement(next_primal_solution, next_dual_solution);
   if (movement == 0.0) {
     LogNumericalTermination();
     ResetAverageToCurrent();
@@ -2516,10 +2772,10 @@ InnerStepOutcome Solver::TakeConstantSizeStep() {
     LogNumericalTermination();
     return InnerStepOutcome::kForceNumericalTermination;
   }
-  VectorXd next_dual_product = TransposedMatrixVectorProduct(
-      WorkingQp().constraint_matrix, next_dual_solution.value,
-      ShardedWorkingQp().ConstraintMatrixSharder());
+  VectorXd next_dual_product =
+      ConstraintMatrixTransposeProduct(next_dual_solution.value);
   current_primal_solution_ = std::move(next_primal_solution.value);
+  current_primal_product_.reset();
   current_dual_solution_ = std::move(next_dual_solution.value);
   current_dual_product_ = std::move(next_dual_product);
   current_primal_delta_ = std::move(next_primal_solution.delta);
@@ -2563,6 +2819,30 @@ bool TerminationReasonIsWorkLimit(const TerminationReason reason) {
          reason == TERMINATION_REASON_INTERRUPTED_BY_USER;
 }
 
+// Returns `criteria` with infinite tolerances on the dual residual and on the
+// objective gap, i.e., the criteria of the primal feasibility problem.
+TerminationCriteria::DetailedOptimalityCriteria PrimalFeasibilityCriteria(
+    TerminationCriteria::DetailedOptimalityCriteria criteria) {
+  const double kInfinity = std::numeric_limits<double>::infinity();
+  criteria.set_eps_optimal_dual_residual_absolute(kInfinity);
+  criteria.set_eps_optimal_dual_residual_relative(kInfinity);
+  criteria.set_eps_optimal_objective_gap_absolute(kInfinity);
+  criteria.set_eps_optimal_objective_gap_relative(kInfinity);
+  return criteria;
+}
+
+// Returns `criteria` with infinite tolerances on the primal residual and on
+// the objective gap, i.e., the criteria of the dual feasibility problem.
+TerminationCriteria::DetailedOptimalityCriteria DualFeasibilityCriteria(
+    TerminationCriteria::DetailedOptimalityCriteria criteria) {
+  const double kInfinity = std::numeric_limits<double>::infinity();
+  criteria.set_eps_optimal_primal_residual_absolute(kInfinity);
+  criteria.set_eps_optimal_primal_residual_relative(kInfinity);
+  criteria.set_eps_optimal_objective_gap_absolute(kInfinity);
+  criteria.set_eps_optimal_objective_gap_relative(kInfinity);
+  return criteria;
+}
+
 std::optional<SolverResult> Solver::TryFeasibilityPolishing(
     const int iteration_limit, const std::atomic<bool>* interrupt_solve,
     SolveLog& solve_log) {
@@ -2586,66 +2866,100 @@ std::optional<SolverResult> Solver::TryFeasibilityPolishing(
     return std::nullopt;
   }
 
-  if (params_.verbosity_level() >= 2) {
-    SOLVER_LOG(&preprocess_solver_->Logger(),
-               "Starting primal feasibility polishing");
-  }
-  SolverResult primal_result = TryPrimalPolishing(
-      std::move(average_primal), iteration_limit, interrupt_solve, solve_log);
+  // A polishing phase is skipped when the average iterate already meets its
+  // criteria, e.g., when the dual tolerances are loose because only a good
+  // primal solution is needed.
+  const OptimalityNorm optimality_norm =
+      params_.termination_criteria().optimality_norm();
+  const bool average_primal_is_feasible = OptimalityCriteriaMet(
+      PrimalFeasibilityCriteria(optimality_criteria), first_convergence_info,
+      optimality_norm, preprocess_solver_->OriginalBoundNorms());
+  const bool average_dual_is_feasible = OptimalityCriteriaMet(
+      DualFeasibilityCriteria(optimality_criteria), first_convergence_info,
+      optimality_norm, preprocess_solver_->OriginalBoundNorms());
+
+  VectorXd polished_primal;
+  if (average_primal_is_feasible) {
+    if (params_.verbosity_level() >= 2) {
+      SOLVER_LOG(&preprocess_solver_->Logger(),
+                 "Skipping primal feasibility polishing because the average "
+                 "primal iterate is already feasible.");
+    }
+    polished_primal = std::move(average_primal);
+  } else {
+    if (params_.verbosity_level() >= 2) {
+      SOLVER_LOG(&preprocess_solver_->Logger(),
+                 "Starting primal feasibility polishing");
+    }
+    SolverResult primal_result = TryPrimalPolishing(
+        std::move(average_primal), iteration_limit, interrupt_solve, solve_log);
 
-  if (params_.verbosity_level() >= 2) {
-    SOLVER_LOG(
-        &preprocess_solver_->Logger(),
-        "Primal feasibility polishing termination reason: ",
-        TerminationReason_Name(primal_result.solve_log.termination_reason()));
-  }
-  if (TerminationReasonIsWorkLimit(
-          primal_result.solve_log.termination_reason())) {
-    return std::nullopt;
-  } else if (primal_result.solve_log.termination_reason() !=
-             TERMINATION_REASON_OPTIMAL) {
-    // Note: `TERMINATION_REASON_PRIMAL_INFEASIBLE` could happen normally, but
-    // we haven't ensured that the correct solution is returned in that case, so
-    // we ignore the polishing result indicating infeasibility.
-    // `TERMINATION_REASON_NUMERICAL_ERROR` can occur, but would be surprising
-    // and interesting. Other termination reasons are probably bugs.
-    SOLVER_LOG(&preprocess_solver_->Logger(),
-               "WARNING: Primal feasibility polishing terminated with error ",
-               primal_result.solve_log.termination_reason());
-    return std::nullopt;
+    if (params_.verbosity_level() >= 2) {
+      SOLVER_LOG(
+          &preprocess_solver_->Logger(),
+          "Primal feasibility polishing termination reason: ",
+          TerminationReason_Name(primal_result.solve_log.termination_reason()));
+    }
+    if (TerminationReasonIsWorkLimit(
+            primal_result.solve_log.termination_reason())) {
+      return std::nullopt;
+    } else if (primal_result.solve_log.termination_reason() !=
+               TERMINATION_REASON_OPTIMAL) {
+      // Note: `TERMINATION_REASON_PRIMAL_INFEASIBLE` could happen normally, but
+      // we haven't ensured that the correct solution is returned in that case,
+      // so we ignore the polishing result indicating infeasibility.
+      // `TERMINATION_REASON_NUMERICAL_ERROR` can occur, but would be surprising
+      // and interesting. Other termination reasons are probably bugs.
+      SOLVER_LOG(&preprocess_solver_->Logger(),
+                 "WARNING: Primal feasibility polishing terminated with error ",
+                 primal_result.solve_log.termination_reason());
+      return std::nullopt;
+    }
+    polished_primal = std::move(primal_result.primal_solution);
   }
 
-  if (params_.verbosity_level() >= 2) {
-    SOLVER_LOG(&preprocess_solver_->Logger(),
-               "Starting dual feasibility polishing");
-  }
-  SolverResult dual_result = TryDualPolishing(
-      std::move(average_dual), iteration_limit, interrupt_solve, solve_log);
+  VectorXd polished_dual;
+  if (average_dual_is_feasible) {
+    if (params_.verbosity_level() >= 2) {
+      SOLVER_LOG(&preprocess_solver_->Logger(),
+                 "Skipping dual feasibility polishing because the average "
+                 "dual iterate is already feasible.");
+    }
+    polished_dual = std::move(average_dual);
+  } else {
+    if (params_.verbosity_level() >= 2) {
+      SOLVER_LOG(&preprocess_solver_->Logger(),
+                 "Starting dual feasibility polishing");
+    }
+    SolverResult dual_result = TryDualPolishing(
+        std::move(average_dual), iteration_limit, interrupt_solve, solve_log);
 
-  if (params_.verbosity_level() >= 2) {
-    SOLVER_LOG(
-        &preprocess_solver_->Logger(),
-        "Dual feasibility polishing termination reason: ",
-        TerminationReason_Name(dual_result.solve_log.termination_reason()));
-  }
+    if (params_.verbosity_level() >= 2) {
+      SOLVER_LOG(
+          &preprocess_solver_->Logger(),
+          "Dual feasibility polishing termination reason: ",
+          TerminationReason_Name(dual_result.solve_log.termination_reason()));
+    }
 
-  if (TerminationReasonIsWorkLimit(
-          dual_result.solve_log.termination_reason())) {
-    return std::nullopt;
-  } else if (dual_result.solve_log.termination_reason() !=
-             TERMINATION_REASON_OPTIMAL) {
-    // Note: The comment in the corresponding location when checking the
-    // termination reason for primal feasibility polishing applies here
-    // too.
-    SOLVER_LOG(&preprocess_solver_->Logger(),
-               "WARNING: Dual feasibility polishing terminated with error ",
-               dual_result.solve_log.termination_reason());
-    return std::nullopt;
+    if (TerminationReasonIsWorkLimit(
+            dual_result.solve_log.termination_reason())) {
+      return std::nullopt;
+    } else if (dual_result.solve_log.termination_reason() !=
+               TERMINATION_REASON_OPTIMAL) {
+      // Note: The comment in the corresponding location when checking the
+      // termination reason for primal feasibility polishing applies here
+      // too.
+      SOLVER_LOG(&preprocess_solver_->Logger(),
+                 "WARNING: Dual feasibility polishing terminated with error ",
+                 dual_result.solve_log.termination_reason());
+      return std::nullopt;
+    }
+    polished_dual = std::move(dual_result.dual_solution);
   }
 
   IterationStats full_stats = TotalWorkSoFar(solve_log);
   preprocess_solver_->ComputeConvergenceAndInfeasibilityFromWorkingSolution(
-      params_, primal_result.primal_solution, dual_result.dual_solution,
+      params_, polished_primal, polished_dual,
       POINT_TYPE_FEASIBILITY_POLISHING_SOLUTION,
       full_stats.add_convergence_information(), nullptr);
   if (params_.verbosity_level() >= 2) {
@@ -2668,9 +2982,10 @@ std::optional<SolverResult> Solver::TryFeasibilityPolishing(
                                       preprocess_solver_->OriginalBoundNorms(),
                                       /*force_numerical_termination=*/false);
   if (earned_termination.has_value()) {
-    return ConstructSolverResult(std::move(primal_result.primal_solution),
-                                 std::move(dual_result.dual_solution),
-                                 full_stats, earned_termination->reason,
+    RecordTimingDetails(solve_log);
+    return ConstructSolverResult(std::move(polished_primal),
+                                 std::move(polished_dual), full_stats,
+                                 earned_termination->reason,
                                  POINT_TYPE_FEASIBILITY_POLISHING_SOLUTION,
                                  solve_log);
   }
@@ -2712,15 +3027,9 @@ SolverResult Solver::TryPrimalPolishing(
   SetZero(ShardedWorkingQp().PrimalSharder(), objective);
   preprocess_solver_->SwapObjectiveVector(objective);
 
-  TerminationCriteria::DetailedOptimalityCriteria criteria =
-      EffectiveOptimalityCriteria(params_.termination_criteria());
-  const double kInfinity = std::numeric_limits<double>::infinity();
-  criteria.set_eps_optimal_dual_residual_absolute(kInfinity);
-  criteria.set_eps_optimal_dual_residual_relative(kInfinity);
-  criteria.set_eps_optimal_objective_gap_absolute(kInfinity);
-  criteria.set_eps_optimal_objective_gap_relative(kInfinity);
   *primal_feasibility_params.mutable_termination_criteria()
-       ->mutable_detailed_optimality_criteria() = criteria;
+       ->mutable_detailed_optimality_criteria() = PrimalFeasibilityCriteria(
+      EffectiveOptimalityCriteria(params_.termination_criteria()));
   // TODO(user): Evaluate disabling primal weight updates for this primal
   // feasibility problem.
   VectorXd primal_feasibility_starting_dual;
@@ -2783,15 +3092,9 @@ SolverResult Solver::TryDualPolishing(VectorXd starting_dual_solution,
   preprocess_solver_->SwapVariableBounds(variable_lower_bounds,
                                          variable_upper_bounds);
 
-  TerminationCriteria::DetailedOptimalityCriteria criteria =
-      EffectiveOptimalityCriteria(params_.termination_criteria());
-  const double kInfinity = std::numeric_limits<double>::infinity();
-  criteria.set_eps_optimal_primal_residual_absolute(kInfinity);
-  criteria.set_eps_optimal_primal_residual_relative(kInfinity);
-  criteria.set_eps_optimal_objective_gap_absolute(kInfinity);
-  criteria.set_eps_optimal_objective_gap_relative(kInfinity);
   *dual_feasibility_params.mutable_termination_criteria()
-       ->mutable_detailed_optimality_criteria() = criteria;
+       ->mutable_detailed_optimality_criteria() = DualFeasibilityCriteria(
+      EffectiveOptimalityCriteria(params_.termination_criteria()));
   // TODO(user): Evaluate disabling primal weight updates for this dual
   // feasibility problem.
   VectorXd dual_feasibility_starting_primal;
@@ -2824,6 +3127,9 @@ SolverResult Solver::Solve(const IterationType iteration_type,
                            SolveLog solve_log) {
   preprocessing_time_sec_ = solve_log.preprocessing_time_sec();
   timer_.Start();
+  step_timer_.Reset();
+  restart_timer_.Reset();
+  termination_check_timer_.Reset();
   last_primal_start_point_ =
       CloneVector(current_primal_solution_, ShardedWorkingQp().PrimalSharder());
   last_dual_start_point_ =
@@ -2832,9 +3138,8 @@ SolverResult Solver::Solve(const IterationType iteration_type,
   // restart.
 
   ratio_last_two_step_sizes_ = 1;
-  current_dual_product_ = TransposedMatrixVectorProduct(
-      WorkingQp().constraint_matrix, current_dual_solution_,
-      ShardedWorkingQp().ConstraintMatrixSharder());
+  current_dual_product_ =
+      ConstraintMatrixTransposeProduct(current_dual_solution_);
 
   // This is set to true if we can't proceed any more because of numerical
   // issues. We may or may not have found the optimal solution.
@@ -2886,6 +3191,7 @@ SolverResult Solver::Solve(const IterationType iteration_type,
     // Malitsky and Pock rule, we perform a termination check and declare
     // NUMERICAL_ERROR whenever we hit 60 inner iterations.
     InnerStepOutcome outcome;
+    step_timer_.Start();
     switch (params_.linesearch_rule()) {
       case PrimalDualHybridGradientParams::MALITSKY_POCK_LINESEARCH_RULE:
         outcome = TakeMalitskyPockStep();
@@ -2900,12 +3206,79 @@ SolverResult Solver::Solve(const IterationType iteration_type,
         LOG(FATAL) << "Unrecognized linesearch rule "
                    << params_.linesearch_rule();
     }
+    step_timer_.Stop();
     if (outcome == InnerStepOutcome::kForceNumericalTermination) {
       force_numerical_termination = true;
     }
   }  // loop over iterations
 }
 
+// Runs Glop's simplex from the solution in `result` and, if it finds an optimal
+// basis, replaces the solution by the corresponding vertex solution and fills
+// the basis statuses. `qp` must be the original linear program.
+void RunGlopCrossover(const QuadraticProgram& qp,
+                      const PrimalDualHybridGradientParams& params,
+                      SolverLogger& logger, SolverResult& result) {
+  const int64_t num_variables = qp.variable_lower_bounds.size();
+  const int64_t num_constraints = qp.constraint_lower_bounds.size();
+  if (std::max(num_variables, num_constraints) >
+      std::numeric_limits<int32_t>::max()) {
+    SOLVER_LOG(&logger,
+               "Skipping crossover because the problem is too large for Glop.");
+    return;
+  }
+  glop::LinearProgram lp;
+  for (int64_t i = 0; i < num_variables; ++i) {
+    const glop::ColIndex col = lp.CreateNewVariable();
+    lp.SetVariableBounds(col, qp.variable_lower_bounds[i],
+                         qp.variable_upper_bounds[i]);
+    lp.SetObjectiveCoefficient(col, qp.objective_vector[i]);
+  }
+  for (int64_t i = 0; i < num_constraints; ++i) {
+    const glop::RowIndex row = lp.CreateNewConstraint();
+    lp.SetConstraintBounds(row, qp.constraint_lower_bounds[i],
+                           qp.constraint_upper_bounds[i]);
+  }
+  for (int64_t col = 0; col < qp.constraint_matrix.outerSize(); ++col) {
+    for (decltype(qp.constraint_matrix)::InnerIterator it(qp.constraint_matrix,
+                                                          col);
+         it; ++it) {
+      lp.SetCoefficient(glop::RowIndex(it.row()), glop::ColIndex(col),
+                        it.value());
+    }
+  }
+  lp.SetObjectiveOffset(qp.objective_offset);
+  lp.CleanUp();
+
+  glop::GlopParameters glop_params;
+  glop_params.set_use_preprocessing(false);
+  glop_params.MergeFrom(params.crossover_options().glop_parameters());
+  glop::LPSolver solver;
+  solver.SetParameters(glop_params);
+  solver.SetCrossoverStartingPoint(
+      glop::DenseRow(result.primal_solution.begin(),
+                     result.primal_solution.end()),
+      glop::DenseColumn(result.dual_solution.begin(),
+                        result.dual_solution.end()));
+  const glop::ProblemStatus status = solver.Solve(lp);
+  if (status != glop::ProblemStatus::OPTIMAL) {
+    SOLVER_LOG(&logger, "Glop crossover stopped with status ",
+               glop::GetProblemStatusString(status),
+               ", keeping the PDLP solution.");
+    return;
+  }
+  SOLVER_LOG(&logger, "Glop crossover found an optimal basis in ",
+             solver.GetNumberOfSimplexIterations(), " simplex iterations.");
+  result.primal_solution = Eigen::Map<const VectorXd>(
+      solver.variable_values().data(), num_variables);
+  result.dual_solution =
+      Eigen::Map<const VectorXd>(solver.dual_values().data(), num_constraints);
+  result.reduced_costs = Eigen::Map<const VectorXd>(
+      solver.reduced_costs().data(), num_variables);
+  result.variable_statuses = solver.variable_statuses();
+  result.constraint_statuses = solver.constraint_statuses();
+}
+
 }  // namespace
 
 SolverResult PrimalDualHybridGradient(
@@ -2959,10 +3332,24 @@ SolverResult PrimalDualHybridGradient(
         "use_feasibility_polishing is only implemented for linear programs.",
         logger);
   }
+  if (params.crossover_options().use_glop() && !IsLinearProgram(qp)) {
+    return ErrorSolverResult(
+        TERMINATION_REASON_INVALID_PARAMETER,
+        "crossover_options.use_glop is only implemented for linear programs.",
+        logger);
+  }
+  // The crossover needs the original problem, which is modified by the solver.
+  std::optional<QuadraticProgram> crossover_qp;
+  if (params.crossover_options().use_glop()) crossover_qp = qp;
   PreprocessSolver solver(std::move(qp), params, &logger);
-  return solver.PreprocessAndSolve(params, std::move(initial_solution),
-                                   interrupt_solve,
-                                   std::move(iteration_stats_callback));
+  SolverResult result = solver.PreprocessAndSolve(
+      params, std::move(initial_solution), interrupt_solve,
+      std::move(iteration_stats_callback));
+  if (crossover_qp.has_value() && result.solve_log.termination_reason() ==
+                                      TERMINATION_REASON_OPTIMAL) {
+    RunGlopCrossover(*crossover_qp, params, logger, result);
+  }
+  return result;
 }
 
 namespace internal {
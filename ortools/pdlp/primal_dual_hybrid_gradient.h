@@ -21,6 +21,7 @@
 
 #include "Eigen/Core"
 #include "ortools/lp_data/lp_data.h"
+#include "ortools/lp_data/lp_types.h"
 #include "ortools/pdlp/quadratic_program.h"
 #include "ortools/pdlp/solve_log.pb.h"
 #include "ortools/pdlp/solvers.pb.h"
@@ -68,6 +69,11 @@ struct SolverResult {
   // for details.
   Eigen::VectorXd reduced_costs;
   SolveLog solve_log;
+  // The statuses of the optimal basis found by the Glop crossover, see
+  // `crossover_options`. These are empty if the crossover did not run or did
+  // not succeed.
+  glop::VariableStatusRow variable_statuses;
+  glop::ConstraintStatusColumn constraint_statuses;
 };
 
 // Identifies the iteration type in a callback. The callback is called both for
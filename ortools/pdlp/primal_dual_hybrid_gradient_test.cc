@@ -900,6 +900,50 @@ TEST(PrimalDualHybridGradientTest, StepSizeScaling) {
             initial_step_size * kStepSizeScaling);
 }
 
+// The tolerances are tight enough that the solve has to switch to the double
+// precision matrix before terminating.
+TEST(PrimalDualHybridGradientTest, SinglePrecisionConstraintMatrix) {
+  PrimalDualHybridGradientParams params;
+  params.mutable_termination_criteria()->set_iteration_limit(3000);
+  params.mutable_termination_criteria()->set_eps_optimal_absolute(1.0e-9);
+  params.mutable_termination_criteria()->set_eps_optimal_relative(1.0e-9);
+  params.set_use_single_precision_constraint_matrix(true);
+
+  SolverResult output = PrimalDualHybridGradient(TinyLp(), params);
+  EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
+  EXPECT_THAT(output.primal_solution,
+              EigenArrayNear<double>({1, 0, 6, 2}, 1.0e-6));
+  EXPECT_THAT(output.dual_solution,
+              EigenArrayNear<double>({0.5, 4.0, 0.0}, 1.0e-6));
+}
+
+TEST(PrimalDualHybridGradientTest, RecordsTimingDetails) {
+  PrimalDualHybridGradientParams params;
+  params.mutable_termination_criteria()->set_iteration_limit(100);
+  params.set_record_timing_details(true);
+
+  SolverResult output = PrimalDualHybridGradient(TinyLp(), params);
+  ASSERT_TRUE(output.solve_log.has_timing_details());
+  const TimingDetails& details = output.solve_log.timing_details();
+  EXPECT_GE(details.step_time_sec(), 0.0);
+  EXPECT_GE(details.restart_time_sec(), 0.0);
+  EXPECT_GT(details.termination_check_time_sec(), 0.0);
+  EXPECT_LE(details.step_time_sec() + details.restart_time_sec() +
+                details.termination_check_time_sec(),
+            output.solve_log.solve_time_sec());
+  EXPECT_GE(details.constraint_matrix_shard_imbalance(), 1.0);
+  EXPECT_GE(details.transposed_constraint_matrix_shard_imbalance(), 1.0);
+  EXPECT_GT(details.constraint_matrix_bytes(), 0);
+}
+
+TEST(PrimalDualHybridGradientTest, NoTimingDetailsByDefault) {
+  PrimalDualHybridGradientParams params;
+  params.mutable_termination_criteria()->set_iteration_limit(100);
+
+  SolverResult output = PrimalDualHybridGradient(TinyLp(), params);
+  EXPECT_FALSE(output.solve_log.has_timing_details());
+}
+
 // This verifies that `kkt_matrix_pass_limit` is checked every iteration.
 TEST(PrimalDualHybridGradientTest, KktMatrixPassTermination) {
   const int kkt_matrix_pass_limit = 13;
@@ -2194,5 +2238,36 @@ TEST(ComputeStatusesTest, CoverMoreCases) {
                           VariableStatus::BASIC, VariableStatus::FIXED_VALUE));
 }
 
+TEST(CrossoverTest, GlopCrossoverReturnsOptimalBasis) {
+  PrimalDualHybridGradientParams params;
+  params.mutable_termination_criteria()->set_iteration_limit(1000);
+  params.mutable_crossover_options()->set_use_glop(true);
+  SolverResult output = PrimalDualHybridGradient(TinyLp(), params);
+  EXPECT_EQ(output.solve_log.termination_reason(), TERMINATION_REASON_OPTIMAL);
+  EXPECT_THAT(output.primal_solution,
+              EigenArrayNear<double>({1, 0, 6, 2}, 1.0e-10));
+  EXPECT_THAT(output.dual_solution,
+              EigenArrayNear<double>({0.5, 4.0, 0.0}, 1.0e-10));
+  EXPECT_THAT(output.reduced_costs,
+              EigenArrayNear<double>({0.0, 1.5, -3.5, 0.0}, 1.0e-10));
+  EXPECT_THAT(output.constraint_statuses,
+              ElementsAre(ConstraintStatus::FIXED_VALUE,
+                          ConstraintStatus::AT_LOWER_BOUND,
+                          ConstraintStatus::BASIC));
+  EXPECT_THAT(
+      output.variable_statuses,
+      ElementsAre(VariableStatus::BASIC, VariableStatus::AT_LOWER_BOUND,
+                  VariableStatus::AT_UPPER_BOUND, VariableStatus::BASIC));
+}
+
+TEST(CrossoverTest, GlopCrossoverIsRejectedForQp) {
+  PrimalDualHybridGradientParams params;
+  params.mutable_crossover_options()->set_use_glop(true);
+  SolverResult output = PrimalDualHybridGradient(TestDiagonalQp1(), params);
+  EXPECT_EQ(output.solve_log.termination_reason(),
+            TERMINATION_REASON_INVALID_PARAMETER);
+  EXPECT_THAT(output.variable_statuses, IsEmpty());
+}
+
 }  // namespace
 }  // namespace operations_research::pdlp
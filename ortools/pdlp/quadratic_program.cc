@@ -18,7 +18,7 @@
 #include <limits>
 #include <optional>
 #include <string>
-#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "Eigen/Core"
@@ -432,30 +432,69 @@ void SetEigenMatrixFromTriplets(
     std::vector<Eigen::Triplet<double, int64_t>> triplets,
     Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix) {
   using Triplet = Eigen::Triplet<double, int64_t>;
-  std::sort(triplets.begin(), triplets.end(),
-            [](const Triplet& lhs, const Triplet& rhs) {
-              return std::tie(lhs.col(), lhs.row()) <
-                     std::tie(rhs.col(), rhs.row());
-            });
+  const int64_t num_cols = matrix.cols();
+  const int64_t num_triplets = static_cast<int64_t>(triplets.size());
+  matrix.resize(matrix.rows(), num_cols);
+  matrix.resizeNonZeros(num_triplets);
+  int64_t* const column_starts = matrix.outerIndexPtr();
+  int64_t* const rows = matrix.innerIndexPtr();
+  double* const values = matrix.valuePtr();
 
-  // The triplets are allowed to contain duplicate entries (and intentionally
-  // do for the diagonals of the objective matrix). For efficiency of insert and
-  // reserve, merge the duplicates first.
-  internal::CombineRepeatedTripletsInPlace(triplets);
-
-  std::vector<int64_t> num_column_entries(matrix.cols());
+  // Counting sort of the triplets by column, directly into the compressed
+  // storage of `matrix`. During the scatter, `column_starts[col]` is the next
+  // free position of column `col`, so at the end it is the start of the next
+  // column.
+  std::fill(column_starts, column_starts + num_cols + 1, 0);
   for (const Triplet& triplet : triplets) {
-    ++num_column_entries[triplet.col()];
+    ++column_starts[triplet.col() + 1];
+  }
+  for (int64_t col = 0; col < num_cols; ++col) {
+    column_starts[col + 1] += column_starts[col];
   }
-  // NOTE: `reserve()` takes column counts because matrix is in column major
-  // order.
-  matrix.reserve(num_column_entries);
   for (const Triplet& triplet : triplets) {
-    matrix.insert(triplet.row(), triplet.col()) = triplet.value();
+    const int64_t position = column_starts[triplet.col()]++;
+    rows[position] = triplet.row();
+    values[position] = triplet.value();
   }
-  if (matrix.outerSize() > 0) {
-    matrix.makeCompressed();
+  for (int64_t col = num_cols; col > 0; --col) {
+    column_starts[col] = column_starts[col - 1];
+  }
+  column_starts[0] = 0;
+  // The triplets are no longer needed, release them before sorting the
+  // columns.
+  triplets = {};
+
+  // Sorts each column by row and merges the duplicate entries (there are some,
+  // intentionally, for the diagonals of the objective matrix). The columns are
+  // compacted in place.
+  std::vector<std::pair<int64_t, double>> column_entries;
+  int64_t num_nonzeros = 0;
+  int64_t column_start = 0;
+  for (int64_t col = 0; col < num_cols; ++col) {
+    const int64_t column_end = column_starts[col + 1];
+    column_entries.clear();
+    for (int64_t k = column_start; k < column_end; ++k) {
+      column_entries.push_back({rows[k], values[k]});
+    }
+    std::sort(column_entries.begin(), column_entries.end(),
+              [](const std::pair<int64_t, double>& lhs,
+                 const std::pair<int64_t, double>& rhs) {
+                return lhs.first < rhs.first;
+              });
+    column_starts[col] = num_nonzeros;
+    for (const auto& [row, value] : column_entries) {
+      if (num_nonzeros > column_starts[col] && rows[num_nonzeros - 1] == row) {
+        values[num_nonzeros - 1] += value;
+      } else {
+        rows[num_nonzeros] = row;
+        values[num_nonzeros] = value;
+        ++num_nonzeros;
+      }
+    }
+    column_start = column_end;
   }
+  column_starts[num_cols] = num_nonzeros;
+  matrix.resizeNonZeros(num_nonzeros);
 }
 
 namespace internal {
@@ -194,9 +194,11 @@ std::string ToString(const QuadraticProgram& qp, int64_t max_size = 1'000'000);
 // Like `matrix.setFromTriplets(triplets)`, except that `setFromTriplets`
 // results in having three copies of the nonzeros in memory at the same time,
 // because it first fills one matrix from triplets, and then transposes it into
-// another. This avoids having the third copy in memory by sorting the triplets,
-// reserving space in the matrix, and then inserting in sorted order.
-// Compresses the matrix (`SparseMatrix.makeCompressed()`) after loading it.
+// another. This avoids having the third copy in memory with a counting sort of
+// the triplets by column directly into the compressed storage of `matrix`,
+// which takes linear time up to the sorting of each column by row. The
+// triplets are released before the columns are sorted. The matrix is
+// compressed (`SparseMatrix.makeCompressed()`) on return.
 // NOTE: This intentionally passes `triplets` by value, because it modifies
 // them. To avoid the copy, pass a move reference.
 void SetEigenMatrixFromTriplets(
@@ -570,5 +570,22 @@ TEST(SetEigenMatrixFromTriplets, CorrectForTinyMatrix) {
                                                      {-1, 1}}));
 }
 
+TEST(SetEigenMatrixFromTriplets, SortsEachColumnByRow) {
+  std::vector<Eigen::Triplet<double, int64_t>> triplets = {
+      {2, 1, 3.0}, {0, 1, 1.0}, {1, 0, -1.0}, {2, 1, 1.0}, {1, 1, 2.0}};
+  Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> matrix(3, 3);
+  SetEigenMatrixFromTriplets(std::move(triplets), matrix);
+  EXPECT_TRUE(matrix.isCompressed());
+  EXPECT_EQ(matrix.nonZeros(), 4);
+  EXPECT_THAT(ToDense(matrix), EigenArrayEq<double>({{0, 1, 0},  //
+                                                     {-1, 2, 0},
+                                                     {0, 4, 0}}));
+  std::vector<int64_t> column_one_rows;
+  for (decltype(matrix)::InnerIterator it(matrix, 1); it; ++it) {
+    column_one_rows.push_back(it.row());
+  }
+  EXPECT_THAT(column_one_rows, ElementsAre(0, 1, 2));
+}
+
 }  // namespace
 }  // namespace operations_research::pdlp
@@ -26,11 +26,13 @@
 #include "Eigen/SparseCore"
 #include "absl/log/check.h"
 #include "absl/random/distributions.h"
+#include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/mathutil.h"
 #include "ortools/pdlp/quadratic_program.h"
 #include "ortools/pdlp/sharded_quadratic_program.h"
 #include "ortools/pdlp/sharder.h"
+#include "ortools/util/vector_sum.h"
 
 namespace operations_research::pdlp {
 
@@ -454,8 +456,14 @@ LagrangianPart ComputePrimalGradient(const ShardedQuadraticProgram& sharded_qp,
         if (IsLinearProgram(qp)) {
           shard(result.gradient) =
               shard(qp.objective_vector) - shard(dual_product);
-          value_parts[shard.Index()] =
-              shard(primal_solution).dot(shard(result.gradient));
+          // The value is a sum of terms of both signs that often nearly cancel
+          // out, hence the compensated summation.
+          const auto primal_shard = shard(primal_solution);
+          const auto gradient_shard = shard(result.gradient);
+          value_parts[shard.Index()] = AccurateDotProduct(
+              absl::MakeConstSpan(primal_shard.data(), primal_shard.size()),
+              absl::MakeConstSpan(gradient_shard.data(),
+                                  gradient_shard.size()));
         } else {
           // Note: using `auto` instead of `VectorXd` for the type of
           // `objective_product` causes eigen to defer the matrix product until
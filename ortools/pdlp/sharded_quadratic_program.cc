@@ -79,9 +79,11 @@ ShardedQuadraticProgram::ShardedQuadraticProgram(
     operations_research::SolverLogger* logger)
     : qp_(std::move(qp)),
       transposed_constraint_matrix_(qp_.constraint_matrix.transpose()),
+      // The thread calling `Sharder::ParallelForEachShard()` also processes
+      // shards, so it counts as one of the `num_threads`.
       thread_pool_(num_threads == 1
                        ? nullptr
-                       : std::make_unique<ThreadPool>("PDLP", num_threads)),
+                       : std::make_unique<ThreadPool>("PDLP", num_threads - 1)),
       constraint_matrix_sharder_(qp_.constraint_matrix, num_shards,
                                  thread_pool_.get()),
       transposed_constraint_matrix_sharder_(transposed_constraint_matrix_,
@@ -178,6 +180,19 @@ void ShardedQuadraticProgram::RescaleQuadraticProgram(
   ScaleMatrix(row_scaling_vec, col_scaling_vec,
               transposed_constraint_matrix_sharder_,
               transposed_constraint_matrix_);
+  ClearSinglePrecisionConstraintMatrices();
+}
+
+void ShardedQuadraticProgram::CreateSinglePrecisionConstraintMatrices() {
+  single_precision_constraint_matrix_ =
+      qp_.constraint_matrix.cast<float>().eval();
+  single_precision_transposed_constraint_matrix_ =
+      transposed_constraint_matrix_.cast<float>().eval();
+}
+
+void ShardedQuadraticProgram::ClearSinglePrecisionConstraintMatrices() {
+  single_precision_constraint_matrix_.reset();
+  single_precision_transposed_constraint_matrix_.reset();
 }
 
 void ShardedQuadraticProgram::ReplaceLargeConstraintBoundsWithInfinity(
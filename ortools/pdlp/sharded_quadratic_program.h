@@ -34,6 +34,11 @@ namespace operations_research::pdlp {
 //  - A thread pool
 //  - Various `Sharder` objects for doing sharded matrix and vector
 //    computations.
+//
+// All the shards live in the memory of a single process and are processed by
+// the threads of the pool. Since the constraint matrix is stored both by
+// columns and by rows (plus optional single precision copies), the matrices
+// use about twice the memory of the input constraint matrix.
 class ShardedQuadraticProgram {
  public:
   // Requires `num_shards` >= `num_threads` >= 1.
@@ -80,9 +85,30 @@ class ShardedQuadraticProgram {
   // `col_scaling_vec[i]`, and the j-th constraint is multiplied by
   // `row_scaling_vec[j]`. `col_scaling_vec` and `row_scaling_vec` must be
   // positive.
+  // The single precision constraint matrices, if any, are cleared.
   void RescaleQuadraticProgram(const Eigen::VectorXd& col_scaling_vec,
                                const Eigen::VectorXd& row_scaling_vec);
 
+  // Creates single precision copies of the constraint matrix and of its
+  // transpose. They use less memory bandwidth in the matrix vector products,
+  // at the cost of a relative error of about 1e-7 on each coefficient. The
+  // sharders above can be used with them.
+  void CreateSinglePrecisionConstraintMatrices();
+  void ClearSinglePrecisionConstraintMatrices();
+  bool HasSinglePrecisionConstraintMatrices() const {
+    return single_precision_constraint_matrix_.has_value();
+  }
+
+  // These require `HasSinglePrecisionConstraintMatrices()`.
+  const Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t>&
+  SinglePrecisionConstraintMatrix() const {
+    return *single_precision_constraint_matrix_;
+  }
+  const Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t>&
+  SinglePrecisionTransposedConstraintMatrix() const {
+    return *single_precision_transposed_constraint_matrix_;
+  }
+
   void SwapVariableBounds(Eigen::VectorXd& variable_lower_bounds,
                           Eigen::VectorXd& variable_upper_bounds) {
     qp_.variable_lower_bounds.swap(variable_lower_bounds);
@@ -114,6 +140,10 @@ class ShardedQuadraticProgram {
   QuadraticProgram qp_;
   Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>
       transposed_constraint_matrix_;
+  std::optional<Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t>>
+      single_precision_constraint_matrix_;
+  std::optional<Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t>>
+      single_precision_transposed_constraint_matrix_;
   std::unique_ptr<ThreadPool> thread_pool_;
   Sharder constraint_matrix_sharder_;
   Sharder transposed_constraint_matrix_sharder_;
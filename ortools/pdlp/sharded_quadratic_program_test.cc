@@ -153,6 +153,36 @@ TEST(RescaleProblem, BasicTest) {
               EigenArrayEq<double>({4, 0.25}));
 }
 
+TEST(ShardedQuadraticProgramTest, SinglePrecisionConstraintMatrices) {
+  const int num_threads = 2;
+  const int num_shards = 2;
+  ShardedQuadraticProgram sharded_qp(TestLp(), num_threads, num_shards);
+  EXPECT_FALSE(sharded_qp.HasSinglePrecisionConstraintMatrices());
+  sharded_qp.CreateSinglePrecisionConstraintMatrices();
+  ASSERT_TRUE(sharded_qp.HasSinglePrecisionConstraintMatrices());
+
+  // All the coefficients of `TestLp()` are exact in single precision.
+  const Eigen::VectorXd primal{{1, 2, -1, 0.5}};
+  EXPECT_THAT(TransposedMatrixVectorProduct(
+                  sharded_qp.SinglePrecisionTransposedConstraintMatrix(),
+                  primal, sharded_qp.TransposedConstraintMatrixSharder()),
+              EigenArrayEq(TransposedMatrixVectorProduct(
+                  sharded_qp.TransposedConstraintMatrix(), primal,
+                  sharded_qp.TransposedConstraintMatrixSharder())));
+  const Eigen::VectorXd dual{{1, -2, 0.5, 3}};
+  EXPECT_THAT(TransposedMatrixVectorProduct(
+                  sharded_qp.SinglePrecisionConstraintMatrix(), dual,
+                  sharded_qp.ConstraintMatrixSharder()),
+              EigenArrayEq(TransposedMatrixVectorProduct(
+                  sharded_qp.Qp().constraint_matrix, dual,
+                  sharded_qp.ConstraintMatrixSharder())));
+
+  // The copies would be stale after a rescaling.
+  sharded_qp.RescaleQuadraticProgram(Eigen::VectorXd::Ones(4),
+                                     Eigen::VectorXd::Ones(4));
+  EXPECT_FALSE(sharded_qp.HasSinglePrecisionConstraintMatrices());
+}
+
 TEST(ShardedQuadraticProgramTest, ReplaceLargeConstraintBoundsWithInfinity) {
   const int num_threads = 2;
   const int num_shards = 2;
@@ -14,6 +14,7 @@
 #include "ortools/pdlp/sharder.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <functional>
@@ -31,6 +32,7 @@
 
 namespace operations_research::pdlp {
 
+using ::Eigen::MatrixXd;
 using ::Eigen::VectorXd;
 
 Sharder::Sharder(const int64_t num_elements, const int num_shards,
@@ -108,29 +110,47 @@ Sharder::Sharder(const Sharder& other_sharder, const int64_t num_elements)
 
 void Sharder::ParallelForEachShard(
     const std::function<void(const Shard&)>& func) const {
-  if (thread_pool_) {
-    absl::BlockingCounter counter(NumShards());
+  const auto run_shard = [&](const int shard_num) {
+    WallTimer timer;
+    if (VLOG_IS_ON(2)) {
+      timer.Start();
+    }
+    func(Shard(shard_num, this));
+    if (VLOG_IS_ON(2)) {
+      timer.Stop();
+      VLOG(2) << "Shard " << shard_num << " with " << ShardSize(shard_num)
+              << " elements and " << ShardMass(shard_num)
+              << " mass finished with "
+              << ShardMass(shard_num) /
+                     std::max(int64_t{1},
+                              absl::ToInt64Microseconds(timer.GetDuration()))
+              << " mass/usec.";
+    }
+  };
+  if (thread_pool_ && NumShards() > 1) {
     VLOG(2) << "Starting ParallelForEachShard()";
-    for (int shard_num = 0; shard_num < NumShards(); ++shard_num) {
-      thread_pool_->Schedule([&, shard_num]() {
-        WallTimer timer;
-        if (VLOG_IS_ON(2)) {
-          timer.Start();
-        }
-        func(Shard(shard_num, this));
-        if (VLOG_IS_ON(2)) {
-          timer.Stop();
-          VLOG(2) << "Shard " << shard_num << " with " << ShardSize(shard_num)
-                  << " elements and " << ShardMass(shard_num)
-                  << " mass finished with "
-                  << ShardMass(shard_num) /
-                         std::max(int64_t{1}, absl::ToInt64Microseconds(
-                                                  timer.GetDuration()))
-                  << " mass/usec.";
-        }
+    // The shards are not assigned to threads in advance. The calling thread
+    // and the tasks of the thread pool claim the next unprocessed shard each
+    // time they finish one, so a thread that is slowed down (e.g., by other
+    // processes on the machine, or by a shard with an expensive memory access
+    // pattern) just processes fewer shards. A task that starts after all
+    // shards were claimed returns immediately.
+    std::atomic<int> next_shard = 0;
+    const auto run_shards = [&]() {
+      for (int shard_num = next_shard.fetch_add(1, std::memory_order_relaxed);
+           shard_num < NumShards();
+           shard_num = next_shard.fetch_add(1, std::memory_order_relaxed)) {
+        run_shard(shard_num);
+      }
+    };
+    absl::BlockingCounter counter(NumShards() - 1);
+    for (int i = 0; i < NumShards() - 1; ++i) {
+      thread_pool_->Schedule([&]() {
+        run_shards();
         counter.DecrementCount();
       });
     }
+    run_shards();
     counter.Wait();
     VLOG(2) << "Done ParallelForEachShard()";
   } else {
@@ -175,6 +195,42 @@ VectorXd TransposedMatrixVectorProduct(
   return answer;
 }
 
+VectorXd TransposedMatrixVectorProduct(
+    const Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t>& matrix,
+    const VectorXd& vector, const Sharder& sharder) {
+  CHECK_EQ(vector.size(), matrix.rows());
+  CHECK_EQ(matrix.cols(), sharder.NumElements());
+  VectorXd answer(matrix.cols());
+  sharder.ParallelForEachShard([&](const Sharder::Shard& shard) {
+    const int64_t shard_start = sharder.ShardStart(shard.Index());
+    const int64_t shard_end = shard_start + sharder.ShardSize(shard.Index());
+    for (int64_t col = shard_start; col < shard_end; ++col) {
+      double sum = 0.0;
+      for (Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t>::InnerIterator
+               it(matrix, col);
+           it; ++it) {
+        sum += static_cast<double>(it.value()) * vector[it.row()];
+      }
+      answer[col] = sum;
+    }
+  });
+  return answer;
+}
+
+MatrixXd TransposedMatrixBlockProduct(
+    const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix,
+    const MatrixXd& block, const Sharder& sharder) {
+  CHECK_EQ(block.rows(), matrix.rows());
+  CHECK_EQ(matrix.cols(), sharder.NumElements());
+  MatrixXd answer(matrix.cols(), block.cols());
+  sharder.ParallelForEachShard([&](const Sharder::Shard& shard) {
+    answer.middleRows(sharder.ShardStart(shard.Index()),
+                      sharder.ShardSize(shard.Index())) =
+        shard(matrix).transpose() * block;
+  });
+  return answer;
+}
+
 void SetZero(const Sharder& sharder, VectorXd& dest) {
   dest.resize(sharder.NumElements());
   sharder.ParallelForEachShard(
@@ -145,7 +145,8 @@ class Sharder {
   // operations executed by e.g. `ParallelForEachShard()`. The `thread_pool` may
   // be nullptr, which means work will be executed in the same thread. If
   // `thread_pool` is not nullptr, the underlying object is not owned and must
-  // outlive the `Sharder`.
+  // outlive the `Sharder`. Note that the calling thread also processes shards,
+  // so a pool with `n - 1` workers gives `n` threads of parallelism.
   Sharder(int64_t num_elements, int num_shards, ThreadPool* thread_pool,
           const std::function<int64_t(int64_t)>& element_mass);
 
@@ -238,6 +239,22 @@ Eigen::VectorXd TransposedMatrixVectorProduct(
     const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix,
     const Eigen::VectorXd& vector, const Sharder& sharder);
 
+// Like the previous function, but for a single precision `matrix`. The
+// products are accumulated in double precision.
+Eigen::VectorXd TransposedMatrixVectorProduct(
+    const Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t>& matrix,
+    const Eigen::VectorXd& vector, const Sharder& sharder);
+
+// Like `matrix.transpose() * block` but executed in parallel using `sharder`,
+// with the same requirements on `sharder` as
+// `TransposedMatrixVectorProduct()`. Each column of `block` is an independent
+// vector, so this computes the products of several vectors with
+// `matrix.transpose()` while reading `matrix` only once, which is faster than
+// separate products when they are bound by the memory bandwidth.
+Eigen::MatrixXd TransposedMatrixBlockProduct(
+    const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t>& matrix,
+    const Eigen::MatrixXd& block, const Sharder& sharder);
+
 ////////////////////////////////////////////////////////////////////////////////
 // The following functions use `sharder` to compute a vector operation in
 // parallel. `sharder` should have the same size as the vector(s). For best
@@ -257,6 +257,42 @@ TEST(MatrixVectorProductTest, SmallExample) {
   EXPECT_THAT(ans, ElementsAre(6.0, -0.5, 6.0, 19));
 }
 
+TEST(MatrixVectorProductTest, SmallSinglePrecisionExample) {
+  const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> mat =
+      TestSparseMatrix();
+  Sharder sharder(mat, /*num_shards=*/3, nullptr);
+  const Eigen::SparseMatrix<float, Eigen::ColMajor, int64_t> float_mat =
+      mat.cast<float>();
+  const VectorXd vec{{1, 2, 3}};
+  VectorXd ans = TransposedMatrixVectorProduct(float_mat, vec, sharder);
+  EXPECT_THAT(ans, ElementsAre(6.0, -0.5, 6.0, 19));
+}
+
+TEST(MatrixBlockProductTest, SmallExample) {
+  const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> mat =
+      TestSparseMatrix();
+  Sharder sharder(mat, /*num_shards=*/3, nullptr);
+  Eigen::MatrixXd block(3, 2);
+  block.col(0) = VectorXd{{1, 2, 3}};
+  block.col(1) = VectorXd{{-1, 0, 2}};
+  const Eigen::MatrixXd ans =
+      TransposedMatrixBlockProduct(mat, block, sharder);
+  ASSERT_EQ(ans.rows(), 4);
+  ASSERT_EQ(ans.cols(), 2);
+  EXPECT_THAT(VectorXd(ans.col(0)), ElementsAre(6.0, -0.5, 6.0, 19));
+  EXPECT_THAT(VectorXd(ans.col(1)), ElementsAre(-9.0, 0.5, 0.0, 10));
+}
+
+TEST(MatrixBlockProductTest, EmptyBlock) {
+  const Eigen::SparseMatrix<double, Eigen::ColMajor, int64_t> mat =
+      TestSparseMatrix();
+  Sharder sharder(mat, /*num_shards=*/3, nullptr);
+  const Eigen::MatrixXd ans =
+      TransposedMatrixBlockProduct(mat, Eigen::MatrixXd(3, 0), sharder);
+  EXPECT_EQ(ans.rows(), 4);
+  EXPECT_EQ(ans.cols(), 0);
+}
+
 TEST(SetZeroTest, SmallExample) {
   Sharder sharder(3, /*num_shards=*/2, nullptr);
   VectorXd vec{{1, 7}};
@@ -443,6 +479,22 @@ TEST_P(VariousSizesTest, LargeMatVec) {
   EXPECT_LE((direct - threaded).norm(), 1.0e-8);
 }
 
+TEST_P(VariousSizesTest, EachShardIsProcessedOnce) {
+  const int64_t size = GetParam();
+  const int num_threads = 4;
+  ThreadPool pool("EachShardIsProcessedOnceTest", num_threads);
+  pool.StartWorkers();
+  Sharder sharder(size, /*num_shards=*/10 * num_threads, &pool);
+  std::vector<int> num_calls(sharder.NumShards(), 0);
+  VectorXd vec = VectorXd::Zero(size);
+  sharder.ParallelForEachShard([&](const Shard& shard) {
+    ++num_calls[shard.Index()];
+    shard(vec).setOnes();
+  });
+  EXPECT_THAT(num_calls, testing::Each(1));
+  EXPECT_EQ(vec.sum(), size);
+}
+
 TEST_P(VariousSizesTest, LargeVectors) {
   const int64_t size = GetParam();
   const int num_threads = 5;
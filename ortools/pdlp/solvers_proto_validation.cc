@@ -175,6 +175,9 @@ absl::Status ValidatePrimalDualHybridGradientParams(
   if (params.num_threads() <= 0) {
     return InvalidArgumentError("num_threads must be positive");
   }
+  if (params.num_shards_per_thread() <= 0) {
+    return InvalidArgumentError("num_shards_per_thread must be positive");
+  }
   if (params.verbosity_level() < 0) {
     return InvalidArgumentError("verbosity_level must be non-negative");
   }
@@ -288,6 +291,13 @@ absl::Status ValidatePrimalDualHybridGradientParams(
         "use_feasibility_polishing requires "
         "!handle_some_primal_gradients_on_finite_bounds_as_residuals");
   }
+  if (std::isnan(params.single_precision_switch_factor())) {
+    return InvalidArgumentError("single_precision_switch_factor is NAN");
+  }
+  if (params.single_precision_switch_factor() < 1.0) {
+    return InvalidArgumentError(
+        "single_precision_switch_factor must be at least 1.0");
+  }
   if (params.use_feasibility_polishing() &&
       params.presolve_options().use_glop()) {
     return InvalidArgumentError(
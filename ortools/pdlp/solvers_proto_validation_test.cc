@@ -392,6 +392,14 @@ TEST(ValidatePrimalDualHybridGradientParams, BadNumThreads) {
   EXPECT_THAT(status.message(), HasSubstr("num_threads"));
 }
 
+TEST(ValidatePrimalDualHybridGradientParams, BadNumShardsPerThread) {
+  PrimalDualHybridGradientParams params;
+  params.set_num_shards_per_thread(0);
+  const absl::Status status = ValidatePrimalDualHybridGradientParams(params);
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(), HasSubstr("num_shards_per_thread"));
+}
+
 TEST(ValidatePrimalDualHybridGradientParams, BadVerbosityLevel) {
   PrimalDualHybridGradientParams params;
   params.set_verbosity_level(-1);
@@ -677,6 +685,25 @@ TEST(ValidatePrimalDualHybridGradientParams,
               HasSubstr("diagonal_qp_trust_region_solver_tolerance"));
 }
 
+TEST(ValidatePrimalDualHybridGradientParams, BadSinglePrecisionSwitchFactor) {
+  PrimalDualHybridGradientParams params_small;
+  params_small.set_single_precision_switch_factor(0.5);
+  const absl::Status status_small =
+      ValidatePrimalDualHybridGradientParams(params_small);
+  EXPECT_EQ(status_small.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status_small.message(),
+              HasSubstr("single_precision_switch_factor"));
+
+  PrimalDualHybridGradientParams params_nan;
+  params_nan.set_single_precision_switch_factor(
+      std::numeric_limits<double>::quiet_NaN());
+  const absl::Status status_nan =
+      ValidatePrimalDualHybridGradientParams(params_nan);
+  EXPECT_EQ(status_nan.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status_nan.message(),
+              HasSubstr("single_precision_switch_factor"));
+}
+
 TEST(ValidatePrimalDualHybridGradientParams, FeasibilityPolishingValidOptions) {
   PrimalDualHybridGradientParams params;
   params.set_use_feasibility_polishing(true);
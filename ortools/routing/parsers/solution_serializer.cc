@@ -14,16 +14,25 @@
 #include "ortools/routing/parsers/solution_serializer.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
+#include "ortools/base/file.h"
+#include "ortools/base/helpers.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/options.h"
+#include "ortools/base/status_macros.h"
 
 namespace operations_research {
 
@@ -422,4 +431,160 @@ std::string SerializeRouteToCVRPLIBString(const RoutingSolution::Route& route) {
   return current_route;
 }
 }  // namespace
+
+namespace {
+// Header of the binary route format; the last byte is the format version.
+constexpr absl::string_view kBinaryRoutesHeader("ORR\x01", 4);
+// Size above which BinaryRoutesWriter writes its buffer to the file.
+constexpr size_t kBinaryRoutesFlushThreshold = 1 << 16;
+constexpr uint8_t kBinaryRouteHasCumuls = 1;
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Appends value - previous as a zigzag varint; the difference is computed
+// modulo 2^64 so that it never overflows.
+void AppendDelta(int64_t value, int64_t previous, std::string* out) {
+  const int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(value) -
+                                             static_cast<uint64_t>(previous));
+  AppendVarint((static_cast<uint64_t>(delta) << 1) ^
+                   static_cast<uint64_t>(delta >> 63),
+               out);
+}
+
+void AppendBinaryRoute(absl::Span<const int64_t> route,
+                       absl::Span<const int64_t> cumuls, std::string* out) {
+  AppendVarint(route.size(), out);
+  out->push_back(cumuls.empty() ? 0 : kBinaryRouteHasCumuls);
+  int64_t previous = 0;
+  for (const int64_t node : route) {
+    AppendDelta(node, previous, out);
+    previous = node;
+  }
+  previous = 0;
+  for (const int64_t cumul : cumuls) {
+    AppendDelta(cumul, previous, out);
+    previous = cumul;
+  }
+}
+
+bool ReadVarint(absl::string_view* data, uint64_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 64 && !data->empty(); shift += 7) {
+    const uint8_t byte = static_cast<uint8_t>(data->front());
+    data->remove_prefix(1);
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+// Reads `size` delta-coded values, appending them to `values`.
+bool ReadDeltas(absl::string_view* data, uint64_t size,
+                std::vector<int64_t>* values) {
+  values->reserve(size);
+  uint64_t previous = 0;
+  for (uint64_t i = 0; i < size; ++i) {
+    uint64_t zigzag;
+    if (!ReadVarint(data, &zigzag)) return false;
+    previous += (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+    values->push_back(static_cast<int64_t>(previous));
+  }
+  return true;
+}
+}  // namespace
+
+BinaryRoutesWriter::BinaryRoutesWriter(File* file) : file_(file) {
+  buffer_.append(kBinaryRoutesHeader);
+}
+
+BinaryRoutesWriter::~BinaryRoutesWriter() { Flush().IgnoreError(); }
+
+absl::Status BinaryRoutesWriter::AddRoute(absl::Span<const int64_t> route,
+                                          absl::Span<const int64_t> cumuls) {
+  if (!cumuls.empty() && cumuls.size() != route.size()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Route has ", route.size(), " nodes but ", cumuls.size(),
+                     " cumuls"));
+  }
+  AppendBinaryRoute(route, cumuls, &buffer_);
+  if (buffer_.size() < kBinaryRoutesFlushThreshold) return absl::OkStatus();
+  return Flush();
+}
+
+absl::Status BinaryRoutesWriter::Flush() {
+  if (buffer_.empty()) return absl::OkStatus();
+  const absl::Status status =
+      file::WriteString(file_, buffer_, file::Defaults());
+  buffer_.clear();
+  return status;
+}
+
+std::string RoutesToBinaryString(
+    absl::Span<const std::vector<int64_t>> routes,
+    absl::Span<const std::vector<int64_t>> cumuls) {
+  CHECK(cumuls.empty() || cumuls.size() == routes.size());
+  std::string out(kBinaryRoutesHeader);
+  for (int i = 0; i < routes.size(); ++i) {
+    if (cumuls.empty() || cumuls[i].empty()) {
+      AppendBinaryRoute(routes[i], {}, &out);
+    } else {
+      CHECK_EQ(cumuls[i].size(), routes[i].size());
+      AppendBinaryRoute(routes[i], cumuls[i], &out);
+    }
+  }
+  return out;
+}
+
+absl::Status RoutesFromBinaryString(absl::string_view data,
+                                    std::vector<std::vector<int64_t>>* routes,
+                                    std::vector<std::vector<int64_t>>* cumuls) {
+  if (!absl::ConsumePrefix(&data, kBinaryRoutesHeader)) {
+    return absl::InvalidArgumentError("Missing binary routes header");
+  }
+  routes->clear();
+  if (cumuls != nullptr) cumuls->clear();
+  std::vector<int64_t> ignored_cumuls;
+  while (!data.empty()) {
+    uint64_t size;
+    // Every value takes at least one byte: this bounds the reservations below
+    // on corrupted inputs.
+    if (!ReadVarint(&data, &size) || data.empty() || size > data.size()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Truncated route #", routes->size()));
+    }
+    const uint8_t flags = static_cast<uint8_t>(data.front());
+    data.remove_prefix(1);
+    routes->emplace_back();
+    if (!ReadDeltas(&data, size, &routes->back())) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Truncated route #", routes->size() - 1));
+    }
+    std::vector<int64_t>* route_cumuls = &ignored_cumuls;
+    if (cumuls != nullptr) {
+      route_cumuls = &cumuls->emplace_back();
+    } else {
+      ignored_cumuls.clear();
+    }
+    if ((flags & kBinaryRouteHasCumuls) != 0 &&
+        !ReadDeltas(&data, size, route_cumuls)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Truncated cumuls of route #", routes->size() - 1));
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ReadRoutesFromBinaryFile(
+    absl::string_view file_name, std::vector<std::vector<int64_t>>* routes,
+    std::vector<std::vector<int64_t>>* cumuls) {
+  std::string data;
+  RETURN_IF_ERROR(file::GetContents(file_name, &data, file::Defaults()));
+  return RoutesFromBinaryString(data, routes, cumuls);
+}
 }  // namespace operations_research
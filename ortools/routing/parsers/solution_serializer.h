@@ -17,12 +17,14 @@
 #ifndef OR_TOOLS_ROUTING_PARSERS_SOLUTION_SERIALIZER_H_
 #define OR_TOOLS_ROUTING_PARSERS_SOLUTION_SERIALIZER_H_
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
@@ -243,6 +245,59 @@ class RoutingSolution {
   std::string SerializeToNEARPLIBSolutionFile() const;
 };
 
+// Compact binary encoding of routes, meant for frequent checkpointing of large
+// solutions, for which the text formats above are slow to write and to parse.
+// Routes are the per-vehicle node sequences produced by
+// RoutingModel::AssignmentToRoutes() and accepted by
+// RoutingModel::ReadAssignmentFromRoutes(); each route may also carry one
+// cumul value per node (typically for a time dimension).
+//
+// The stream starts with a 4-byte header, followed by one record per vehicle:
+// the number of nodes, a flag telling whether cumuls are present, the nodes,
+// then the cumuls. Nodes and cumuls are delta-coded with respect to the
+// previous value of the route and stored as zigzag varints, so that nearby
+// node indices and increasing times usually take one or two bytes.
+
+// Writes routes to a file one vehicle at a time, without materializing the
+// whole encoded solution in memory.
+class BinaryRoutesWriter {
+ public:
+  // Does not take ownership of the file, which must outlive the writer.
+  explicit BinaryRoutesWriter(File* file);
+  BinaryRoutesWriter(const BinaryRoutesWriter&) = delete;
+  BinaryRoutesWriter& operator=(const BinaryRoutesWriter&) = delete;
+  // Flushes remaining data; errors are lost, call Flush() to observe them.
+  ~BinaryRoutesWriter();
+
+  // Appends the route of the next vehicle. `cumuls` must either be empty or
+  // have the same size as `route`.
+  absl::Status AddRoute(absl::Span<const int64_t> route,
+                        absl::Span<const int64_t> cumuls = {});
+  // Writes all buffered routes to the file.
+  absl::Status Flush();
+
+ private:
+  File* const file_;
+  std::string buffer_;
+};
+
+// Encodes the given routes (and cumuls, if non-empty, one vector per route) in
+// the binary format described above.
+std::string RoutesToBinaryString(
+    absl::Span<const std::vector<int64_t>> routes,
+    absl::Span<const std::vector<int64_t>> cumuls = {});
+
+// Decodes routes encoded in the binary format. When `cumuls` is not null, it
+// receives one vector per route, empty for routes written without cumuls.
+absl::Status RoutesFromBinaryString(
+    absl::string_view data, std::vector<std::vector<int64_t>>* routes,
+    std::vector<std::vector<int64_t>>* cumuls = nullptr);
+
+// Same as RoutesFromBinaryString(), reading the data from the given file.
+absl::Status ReadRoutesFromBinaryFile(
+    absl::string_view file_name, std::vector<std::vector<int64_t>>* routes,
+    std::vector<std::vector<int64_t>>* cumuls = nullptr);
+
 // Formats a solution or solver statistic according to the given format.
 template <typename T>
 std::string FormatStatistic(absl::string_view name, T value,
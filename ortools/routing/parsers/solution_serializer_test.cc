@@ -15,14 +15,17 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <limits>
 #include <string>
 #include <vector>
 
 #include "absl/log/check.h"
+#include "absl/status/status.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "gtest/gtest.h"
 #include "ortools/base/gmock.h"
+#include "ortools/base/file.h"
 #include "ortools/base/helpers.h"
 #include "ortools/base/mutable_memfile.h"
 #include "ortools/base/options.h"
@@ -628,5 +631,54 @@ TEST(RoutingSolutionSerializerTest, FormatStatisticAsNearplibLongPrecision) {
   EXPECT_EQ(FormatStatistic("STAT", 591.556557, RoutingOutputFormat::kNEARPLIB),
             "STAT : 591.556557");
 }
+
+TEST(RoutingSolutionSerializerTest, BinaryRoutesRoundTrip) {
+  const std::vector<std::vector<int64_t>> routes = {
+      {3, 1, 2, 100000}, {}, {std::numeric_limits<int64_t>::max(), 0, -5}};
+  const std::vector<std::vector<int64_t>> cumuls = {{0, 10, 25, 25}, {}, {}};
+
+  std::vector<std::vector<int64_t>> read_routes;
+  std::vector<std::vector<int64_t>> read_cumuls;
+  ASSERT_OK(RoutesFromBinaryString(RoutesToBinaryString(routes, cumuls),
+                                   &read_routes, &read_cumuls));
+  EXPECT_EQ(read_routes, routes);
+  EXPECT_EQ(read_cumuls, cumuls);
+
+  ASSERT_OK(RoutesFromBinaryString(RoutesToBinaryString(routes, cumuls),
+                                   &read_routes));
+  EXPECT_EQ(read_routes, routes);
+}
+
+TEST(RoutingSolutionSerializerTest, BinaryRoutesToFile) {
+  const std::string file_name{std::tmpnam(nullptr)};
+  RegisteredMutableMemFile registered(file_name);
+
+  File* file;
+  CHECK_OK(file::Open(file_name, "w", &file, file::Defaults()));
+  {
+    BinaryRoutesWriter writer(file);
+    ASSERT_OK(writer.AddRoute({4, 5, 6}, {1, 2, 3}));
+    ASSERT_OK(writer.AddRoute({7}));
+    EXPECT_EQ(writer.AddRoute({1, 2}, {1}).code(),
+              absl::StatusCode::kInvalidArgument);
+    ASSERT_OK(writer.Flush());
+  }
+  CHECK_OK(file->Close(file::Defaults()));
+
+  std::vector<std::vector<int64_t>> routes;
+  std::vector<std::vector<int64_t>> cumuls;
+  ASSERT_OK(ReadRoutesFromBinaryFile(file_name, &routes, &cumuls));
+  EXPECT_EQ(routes, (std::vector<std::vector<int64_t>>{{4, 5, 6}, {7}}));
+  EXPECT_EQ(cumuls, (std::vector<std::vector<int64_t>>{{1, 2, 3}, {}}));
+}
+
+TEST(RoutingSolutionSerializerTest, BinaryRoutesInvalidData) {
+  std::vector<std::vector<int64_t>> routes;
+  EXPECT_FALSE(RoutesFromBinaryString("", &routes).ok());
+  EXPECT_FALSE(RoutesFromBinaryString("CVRP", &routes).ok());
+  std::string data = RoutesToBinaryString({{1, 2, 3}});
+  data.pop_back();
+  EXPECT_FALSE(RoutesFromBinaryString(data, &routes).ok());
+}
 }  // namespace
 }  // namespace operations_research
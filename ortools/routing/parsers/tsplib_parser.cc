@@ -196,14 +196,14 @@ int TspLibParser::SizeFromFile(const std::string& file_name) const {
 }
 
 void TspLibParser::ParseExplicitFullMatrix(
-    absl::Span<const std::string> words) {
+    absl::Span<const absl::string_view> words) {
   CHECK_LT(edge_row_, size_);
   if (type_ == Types::SOP && to_read_ == size_ * size_) {
     // Matrix size is present in SOP which is redundant with dimension and must
     // not be confused with the first cell of the matrix.
     return;
   }
-  for (const std::string& word : words) {
+  for (const absl::string_view word : words) {
     SetExplicitCost(edge_row_, edge_column_, atoi64(word));
     ++edge_column_;
     if (edge_column_ >= size_) {
@@ -214,11 +214,13 @@ void TspLibParser::ParseExplicitFullMatrix(
   }
 }
 
-void TspLibParser::ParseExplicitUpperRow(absl::Span<const std::string> words) {
+void TspLibParser::ParseExplicitUpperRow(
+    absl::Span<const absl::string_view> words) {
   CHECK_LT(edge_row_, size_);
-  for (const std::string& word : words) {
-    SetExplicitCost(edge_row_, edge_column_, atoi64(word));
-    SetExplicitCost(edge_column_, edge_row_, atoi64(word));
+  for (const absl::string_view word : words) {
+    const int64_t cost = atoi64(word);
+    SetExplicitCost(edge_row_, edge_column_, cost);
+    SetExplicitCost(edge_column_, edge_row_, cost);
     ++edge_column_;
     if (edge_column_ >= size_) {
       ++edge_row_;
@@ -229,11 +231,13 @@ void TspLibParser::ParseExplicitUpperRow(absl::Span<const std::string> words) {
   }
 }
 
-void TspLibParser::ParseExplicitLowerRow(absl::Span<const std::string> words) {
+void TspLibParser::ParseExplicitLowerRow(
+    absl::Span<const absl::string_view> words) {
   CHECK_LT(edge_row_, size_);
-  for (const std::string& word : words) {
-    SetExplicitCost(edge_row_, edge_column_, atoi64(word));
-    SetExplicitCost(edge_column_, edge_row_, atoi64(word));
+  for (const absl::string_view word : words) {
+    const int64_t cost = atoi64(word);
+    SetExplicitCost(edge_row_, edge_column_, cost);
+    SetExplicitCost(edge_column_, edge_row_, cost);
     ++edge_column_;
     if (edge_column_ >= edge_row_) {
       SetExplicitCost(edge_column_, edge_column_, 0);
@@ -245,11 +249,12 @@ void TspLibParser::ParseExplicitLowerRow(absl::Span<const std::string> words) {
 }
 
 void TspLibParser::ParseExplicitUpperDiagRow(
-    absl::Span<const std::string> words) {
+    absl::Span<const absl::string_view> words) {
   CHECK_LT(edge_row_, size_);
-  for (const std::string& word : words) {
-    SetExplicitCost(edge_row_, edge_column_, atoi64(word));
-    SetExplicitCost(edge_column_, edge_row_, atoi64(word));
+  for (const absl::string_view word : words) {
+    const int64_t cost = atoi64(word);
+    SetExplicitCost(edge_row_, edge_column_, cost);
+    SetExplicitCost(edge_column_, edge_row_, cost);
     ++edge_column_;
     if (edge_column_ >= size_) {
       ++edge_row_;
@@ -260,11 +265,12 @@ void TspLibParser::ParseExplicitUpperDiagRow(
 }
 
 void TspLibParser::ParseExplicitLowerDiagRow(
-    absl::Span<const std::string> words) {
+    absl::Span<const absl::string_view> words) {
   CHECK_LT(edge_row_, size_);
-  for (const std::string& word : words) {
-    SetExplicitCost(edge_row_, edge_column_, atoi64(word));
-    SetExplicitCost(edge_column_, edge_row_, atoi64(word));
+  for (const absl::string_view word : words) {
+    const int64_t cost = atoi64(word);
+    SetExplicitCost(edge_row_, edge_column_, cost);
+    SetExplicitCost(edge_column_, edge_row_, cost);
     ++edge_column_;
     if (edge_column_ > edge_row_) {
       edge_column_ = 0;
@@ -274,6 +280,33 @@ void TspLibParser::ParseExplicitLowerDiagRow(
   }
 }
 
+void TspLibParser::ParseEdgeWeights(
+    absl::Span<const absl::string_view> words) {
+  switch (edge_weight_format_) {
+    case FULL_MATRIX:
+      ParseExplicitFullMatrix(words);
+      break;
+    case UPPER_ROW:
+    case LOWER_COL:
+      ParseExplicitUpperRow(words);
+      break;
+    case LOWER_ROW:
+    case UPPER_COL:
+      ParseExplicitLowerRow(words);
+      break;
+    case UPPER_DIAG_ROW:
+    case LOWER_DIAG_COL:
+      ParseExplicitUpperDiagRow(words);
+      break;
+    case LOWER_DIAG_ROW:
+    case UPPER_DIAG_COL:
+      ParseExplicitLowerDiagRow(words);
+      break;
+    default:
+      LOG(WARNING) << "Unknown EDGE_WEIGHT_FORMAT: " << edge_weight_format_;
+  }
+}
+
 void TspLibParser::ParseNodeCoord(absl::Span<const std::string> words) {
   CHECK_LE(3, words.size()) << words[0];
   CHECK_GE(4, words.size()) << words[4];
@@ -519,6 +552,20 @@ void TspLibParser::ParseSections(absl::Span<const std::string> words) {
 }
 
 void TspLibParser::ProcessNewLine(const std::string& line) {
+  // Edge weight sections hold most of the numbers of large explicit
+  // instances; their words are parsed in place, without copying them.
+  if (section_ == EDGE_WEIGHT_SECTION && to_read_ > 0) {
+    edge_weight_words_.clear();
+    for (const absl::string_view word :
+         absl::StrSplit(line, absl::ByAnyChar(" :\t"), absl::SkipEmpty())) {
+      edge_weight_words_.push_back(word);
+    }
+    if (edge_weight_words_.empty()) return;
+    if (!kSections->contains(edge_weight_words_[0])) {
+      ParseEdgeWeights(edge_weight_words_);
+      return;
+    }
+  }
   const std::vector<std::string> words =
       absl::StrSplit(line, absl::ByAnyChar(" :\t"), absl::SkipEmpty());
   if (!words.empty()) {
@@ -570,30 +617,8 @@ void TspLibParser::ProcessNewLine(const std::string& line) {
           break;
         }
         case EDGE_WEIGHT_SECTION: {
-          switch (edge_weight_format_) {
-            case FULL_MATRIX:
-              ParseExplicitFullMatrix(words);
-              break;
-            case UPPER_ROW:
-            case LOWER_COL:
-              ParseExplicitUpperRow(words);
-              break;
-            case LOWER_ROW:
-            case UPPER_COL:
-              ParseExplicitLowerRow(words);
-              break;
-            case UPPER_DIAG_ROW:
-            case LOWER_DIAG_COL:
-              ParseExplicitUpperDiagRow(words);
-              break;
-            case LOWER_DIAG_ROW:
-            case UPPER_DIAG_COL:
-              ParseExplicitLowerDiagRow(words);
-              break;
-            default:
-              LOG(WARNING) << "Unknown EDGE_WEIGHT_FORMAT: "
-                           << edge_weight_format_;
-          }
+          // Handled at the beginning of the method.
+          LOG(DFATAL) << "Unexpected edge weight line: " << line;
           break;
         }
         case FIXED_EDGES_SECTION: {
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "ortools/base/types.h"
 #include "ortools/routing/parsers/simple_graph.h"
@@ -141,11 +142,14 @@ class TspLibParser final {
   void operator=(const TspLibParser&) = delete;
 #endif
 
-  void ParseExplicitFullMatrix(absl::Span<const std::string> words);
-  void ParseExplicitUpperRow(absl::Span<const std::string> words);
-  void ParseExplicitLowerRow(absl::Span<const std::string> words);
-  void ParseExplicitUpperDiagRow(absl::Span<const std::string> words);
-  void ParseExplicitLowerDiagRow(absl::Span<const std::string> words);
+  void ParseExplicitFullMatrix(absl::Span<const absl::string_view> words);
+  void ParseExplicitUpperRow(absl::Span<const absl::string_view> words);
+  void ParseExplicitLowerRow(absl::Span<const absl::string_view> words);
+  void ParseExplicitUpperDiagRow(absl::Span<const absl::string_view> words);
+  void ParseExplicitLowerDiagRow(absl::Span<const absl::string_view> words);
+  // Dispatches the words of a line of EDGE_WEIGHT_SECTION to the parser of the
+  // edge weight format.
+  void ParseEdgeWeights(absl::Span<const absl::string_view> words);
   void ParseNodeCoord(absl::Span<const std::string> words);
   void SetUpEdgeWeightSection();
   void FinalizeEdgeWeights();
@@ -185,6 +189,8 @@ class TspLibParser final {
   EdgeWeightFormats edge_weight_format_;
   int edge_row_;
   int edge_column_;
+  // Words of the current edge weight line, kept to reuse their memory.
+  std::vector<absl::string_view> edge_weight_words_;
   std::vector<Coordinates3<double>> coords_;
   std::string name_;
   std::string comments_;
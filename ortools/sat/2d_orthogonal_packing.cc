@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -41,6 +42,8 @@ OrthogonalPackingInfeasibilityDetector::
   std::vector<std::pair<std::string, int64_t>> stats;
   stats.push_back(
       {"OrthogonalPackingInfeasibilityDetector/called", num_calls_});
+  stats.push_back(
+      {"OrthogonalPackingInfeasibilityDetector/cache_hits", num_cache_hits_});
   stats.push_back(
       {"OrthogonalPackingInfeasibilityDetector/conflicts", num_conflicts_});
   stats.push_back({"OrthogonalPackingInfeasibilityDetector/dff0_conflicts",
@@ -829,8 +832,30 @@ OrthogonalPackingResult OrthogonalPackingInfeasibilityDetector::TestFeasibility(
   using ConflictType = OrthogonalPackingResult::ConflictType;
 
   num_calls_++;
-  OrthogonalPackingResult result =
-      TestFeasibilityImpl(sizes_x, sizes_y, bounding_box_size, options);
+  OrthogonalPackingResult result;
+  const OrthogonalPackingResult* cached_result =
+      FindInCache(sizes_x, sizes_y, bounding_box_size, options);
+  if (cached_result != nullptr) {
+    num_cache_hits_++;
+    result = *cached_result;
+    for (OrthogonalPackingResult::Item& item :
+         result.items_participating_on_conflict_) {
+      item.index = item_order_[item.index];
+    }
+  } else {
+    result = TestFeasibilityImpl(sizes_x, sizes_y, bounding_box_size, options);
+    if (cache_.size() >= kMaxCacheSize) cache_.clear();
+    OrthogonalPackingResult& to_cache = cache_[cache_key_];
+    to_cache = result;
+    position_in_order_.resize(item_order_.size());
+    for (int p = 0; p < item_order_.size(); ++p) {
+      position_in_order_[item_order_[p]] = p;
+    }
+    for (OrthogonalPackingResult::Item& item :
+         to_cache.items_participating_on_conflict_) {
+      item.index = position_in_order_[item.index];
+    }
+  }
 
   if (result.result_ == OrthogonalPackingResult::Status::INFEASIBLE) {
     num_conflicts_++;
@@ -859,6 +884,34 @@ OrthogonalPackingResult OrthogonalPackingInfeasibilityDetector::TestFeasibility(
   return result;
 }
 
+const OrthogonalPackingResult*
+OrthogonalPackingInfeasibilityDetector::FindInCache(
+    absl::Span<const IntegerValue> sizes_x,
+    absl::Span<const IntegerValue> sizes_y,
+    std::pair<IntegerValue, IntegerValue> bounding_box_size,
+    const OrthogonalPackingOptions& options) {
+  // Items with the same sizes are interchangeable, so we sort them to get the
+  // same key for all the permutations of a multiset.
+  item_order_.resize(sizes_x.size());
+  std::iota(item_order_.begin(), item_order_.end(), 0);
+  std::sort(item_order_.begin(), item_order_.end(), [&](int a, int b) {
+    return std::tie(sizes_x[a], sizes_y[a]) < std::tie(sizes_x[b], sizes_y[b]);
+  });
+  cache_key_ = {bounding_box_size.first.value(),
+                bounding_box_size.second.value(),
+                options.use_pairwise,
+                options.use_dff_f0,
+                options.use_dff_f2,
+                options.brute_force_threshold,
+                options.dff2_max_number_of_parameters_to_check};
+  for (const int i : item_order_) {
+    cache_key_.push_back(sizes_x[i].value());
+    cache_key_.push_back(sizes_y[i].value());
+  }
+  const auto it = cache_.find(cache_key_);
+  return it == cache_.end() ? nullptr : &it->second;
+}
+
 bool OrthogonalPackingResult::TryUseSlackToReduceItemSize(
     int i, Coord coord, IntegerValue lower_bound) {
   Item& item = items_participating_on_conflict_[i];
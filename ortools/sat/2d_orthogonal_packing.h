@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/random/bit_gen_ref.h"
 #include "absl/types/span.h"
@@ -139,6 +140,9 @@ class OrthogonalPackingInfeasibilityDetector {
 
   ~OrthogonalPackingInfeasibilityDetector();
 
+  // Note that the results are cached by bounding box, options and multiset of
+  // item sizes, so calling this again on the same items, even in a different
+  // order, is cheap but will not sample new DFF parameters.
   OrthogonalPackingResult TestFeasibility(
       absl::Span<const IntegerValue> sizes_x,
       absl::Span<const IntegerValue> sizes_y,
@@ -146,6 +150,14 @@ class OrthogonalPackingInfeasibilityDetector {
       const OrthogonalPackingOptions& options = OrthogonalPackingOptions());
 
  private:
+  // Returns the cached result of the items sorted by item_order_, with the
+  // item indices of the conflict relative to this order, or nullptr.
+  const OrthogonalPackingResult* FindInCache(
+      absl::Span<const IntegerValue> sizes_x,
+      absl::Span<const IntegerValue> sizes_y,
+      std::pair<IntegerValue, IntegerValue> bounding_box_size,
+      const OrthogonalPackingOptions& options);
+
   bool RelaxConflictWithBruteForce(
       OrthogonalPackingResult& result,
       std::pair<IntegerValue, IntegerValue> bounding_box_size,
@@ -188,7 +200,17 @@ class OrthogonalPackingInfeasibilityDetector {
   std::vector<std::pair<IntegerValue, IntegerValue>> scheduling_profile_;
   std::vector<std::pair<IntegerValue, IntegerValue>> new_scheduling_profile_;
 
+  // The cache of the results. The key is the bounding box size, the options,
+  // and the sizes of the items sorted by item_order_. It is cleared when it
+  // reaches kMaxCacheSize entries.
+  static constexpr int kMaxCacheSize = 10000;
+  absl::flat_hash_map<std::vector<int64_t>, OrthogonalPackingResult> cache_;
+  std::vector<int64_t> cache_key_;
+  std::vector<int> item_order_;
+  std::vector<int> position_in_order_;
+
   int64_t num_calls_ = 0;
+  int64_t num_cache_hits_ = 0;
   int64_t num_conflicts_ = 0;
   int64_t num_conflicts_two_items_ = 0;
   int64_t num_trivial_conflicts_ = 0;
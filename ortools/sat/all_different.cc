@@ -29,6 +29,7 @@
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_solver.h"
+#include "ortools/util/bitset.h"
 #include "ortools/util/sort.h"
 #include "ortools/util/strong_integers.h"
 
@@ -159,6 +160,8 @@ AllDifferentConstraint::AllDifferentConstraint(
   }
   min_all_values_ = min_value;
   num_all_values_ = max_value - min_value + 1;
+  use_value_masks_ = num_all_values_ <= 64;
+  if (use_value_masks_) successor_mask_.resize(num_variables_);
 
   successor_.resize(num_variables_);
   variable_to_value_.assign(num_variables_, -1);
@@ -199,6 +202,28 @@ inline bool AllDifferentConstraint::VariableHasPossibleValue(int x,
   return !trail_->Assignment().LiteralIsFalse(Literal(li));
 }
 
+inline void AllDifferentConstraint::ClearVisitedNodes() {
+  if (use_value_masks_) {
+    value_visited_mask_ = 0;
+  } else {
+    value_visited_.assign(num_all_values_, false);
+  }
+  variable_visited_.assign(num_variables_, false);
+}
+
+inline bool AllDifferentConstraint::ValueIsVisited(int offset_value) const {
+  if (use_value_masks_) return (value_visited_mask_ >> offset_value) & 1;
+  return value_visited_[offset_value];
+}
+
+inline void AllDifferentConstraint::MarkValueAsVisited(int offset_value) {
+  if (use_value_masks_) {
+    value_visited_mask_ |= uint64_t{1} << offset_value;
+  } else {
+    value_visited_[offset_value] = true;
+  }
+}
+
 bool AllDifferentConstraint::MakeAugmentingPath(int start) {
   // Do a BFS and use visiting_ as a queue, with num_visited pointing
   // at its begin() and num_to_visit its end().
@@ -215,9 +240,21 @@ bool AllDifferentConstraint::MakeAugmentingPath(int start) {
     // Dequeue node to visit.
     const int node = visiting_[num_visited++];
 
-    for (const int value : successor_[node]) {
-      if (value_visited_[value]) continue;
-      value_visited_[value] = true;
+    // We visit the values in increasing order in both cases.
+    uint64_t unvisited_successors =
+        use_value_masks_ ? successor_mask_[node] & ~value_visited_mask_ : 0;
+    for (int i = 0;; ++i) {
+      int value;
+      if (use_value_masks_) {
+        if (unvisited_successors == 0) break;
+        value = LeastSignificantBitPosition64(unvisited_successors);
+        unvisited_successors &= unvisited_successors - 1;
+      } else {
+        if (i == successor_[node].size()) break;
+        value = successor_[node][i];
+        if (value_visited_[value]) continue;
+      }
+      MarkValueAsVisited(value);
       if (value_to_variable_[value] == -1) {
         // value is not matched: change path from node to start, and return.
         int path_node = node;
@@ -264,6 +301,7 @@ bool AllDifferentConstraint::Propagate() {
   variable_to_value_.assign(num_variables_, -1);
   for (int x = 0; x < num_variables_; x++) {
     successor_[x].clear();
+    uint64_t mask = 0;
     const int64_t min_value = integer_trail_->LowerBound(variables_[x]).value();
     const int64_t max_value = integer_trail_->UpperBound(variables_[x]).value();
     for (int64_t value = min_value; value <= max_value; value++) {
@@ -271,8 +309,10 @@ bool AllDifferentConstraint::Propagate() {
         const int offset_value = value - min_all_values_;
         // Forward-checking should propagate x != value.
         successor_[x].push_back(offset_value);
+        if (use_value_masks_) mask |= uint64_t{1} << offset_value;
       }
     }
+    if (use_value_masks_) successor_mask_[x] = mask;
     if (successor_[x].size() == 1) {
       const int offset_value = successor_[x][0];
       if (value_to_variable_[offset_value] == -1) {
@@ -311,8 +351,7 @@ bool AllDifferentConstraint::Propagate() {
   int x = 0;
   for (; x < num_variables_; x++) {
     if (variable_to_value_[x] == -1) {
-      value_visited_.assign(num_all_values_, false);
-      variable_visited_.assign(num_variables_, false);
+      ClearVisitedNodes();
       MakeAugmentingPath(x);
     }
     if (variable_to_value_[x] == -1) break;  // No augmenting path exists.
@@ -330,7 +369,7 @@ bool AllDifferentConstraint::Propagate() {
       for (int value = variable_min_value_[y]; value <= variable_max_value_[y];
            value++) {
         const LiteralIndex li = VariableLiteralIndexOf(y, value);
-        if (li >= 0 && !value_visited_[value - min_all_values_]) {
+        if (li >= 0 && !ValueIsVisited(value - min_all_values_)) {
           DCHECK(trail_->Assignment().LiteralIsFalse(Literal(li)));
           conflict->push_back(Literal(li));
         }
@@ -399,8 +438,7 @@ bool AllDifferentConstraint::Propagate() {
         // then find another assignment for the variable matched to
         // offset_value. It will fail: explaining why is the same as
         // explaining failure as above, and it is an explanation of x != value.
-        value_visited_.assign(num_all_values_, false);
-        variable_visited_.assign(num_variables_, false);
+        ClearVisitedNodes();
         // Undo x -> old_value and old_variable -> offset_value.
         const int old_variable = value_to_variable_[offset_value];
         variable_to_value_[old_variable] = -1;
@@ -409,7 +447,7 @@ bool AllDifferentConstraint::Propagate() {
         variable_to_value_[x] = offset_value;
         value_to_variable_[offset_value] = x;
 
-        value_visited_[offset_value] = true;
+        MarkValueAsVisited(offset_value);
         MakeAugmentingPath(old_variable);
         DCHECK_EQ(variable_to_value_[old_variable], -1);  // No reassignment.
 
@@ -419,7 +457,7 @@ bool AllDifferentConstraint::Propagate() {
           for (int value = variable_min_value_[y];
                value <= variable_max_value_[y]; value++) {
             const LiteralIndex li = VariableLiteralIndexOf(y, value);
-            if (li >= 0 && !value_visited_[value - min_all_values_]) {
+            if (li >= 0 && !ValueIsVisited(value - min_all_values_)) {
               DCHECK(!VariableHasPossibleValue(y, value));
               reason->push_back(Literal(li));
             }
@@ -89,6 +89,11 @@ class AllDifferentConstraint : PropagatorInterface {
   inline LiteralIndex VariableLiteralIndexOf(int x, int64_t value);
   inline bool VariableHasPossibleValue(int x, int64_t value);
 
+  // Accessors to the values visited by MakeAugmentingPath().
+  inline void ClearVisitedNodes();
+  inline bool ValueIsVisited(int offset_value) const;
+  inline void MarkValueAsVisited(int offset_value);
+
   // This caches all literals of the fully encoded variables.
   // Values of a given variable are 0-indexed using offsets variable_min_value_,
   // the set of all values is globally offset using offset min_all_values_.
@@ -114,6 +119,15 @@ class AllDifferentConstraint : PropagatorInterface {
   std::vector<int> visiting_;
   std::vector<int> variable_visited_from_;
 
+  // When all the values fit in one word, which is the common case for
+  // timetabling models, successor_mask_[x] is the set of values in
+  // successor_[x] and we use value_visited_mask_ instead of value_visited_.
+  // This way the inner loop of MakeAugmentingPath() only iterates on the
+  // values not visited yet.
+  bool use_value_masks_ = false;
+  std::vector<uint64_t> successor_mask_;
+  uint64_t value_visited_mask_ = 0;
+
   // Internal state of ComputeSCCs().
   // Variable nodes are indexed by [0, num_variables_),
   // value nodes by [num_variables_, num_variables_ + num_all_values_),
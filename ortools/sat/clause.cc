@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <queue>
 #include <string>
 #include <utility>
@@ -81,7 +82,6 @@ ClauseManager::ClauseManager(Model* model)
 }
 
 ClauseManager::~ClauseManager() {
-  gtl::STLDeleteElements(&clauses_);
   IF_STATS_ENABLED(LOG(INFO) << stats_.StatString());
 }
 
@@ -99,6 +99,16 @@ void ClauseManager::AttachOnFalse(Literal literal, Literal blocking_literal,
   SCOPED_TIME_STAT(&stats_);
   DCHECK(is_clean_);
   DCHECK(!WatcherListContains(watchers_on_false_[literal], *clause));
+  if (clause->size() == 3) {
+    const Literal* literals = clause->begin();
+    const Literal other(LiteralIndex(
+        literals[0].Index().value() ^ literals[1].Index().value() ^
+        literals[2].Index().value() ^ literal.Index().value() ^
+        blocking_literal.Index().value()));
+    watchers_on_false_[literal].push_back(
+        Watcher::Ternary(clause, blocking_literal, other));
+    return;
+  }
   watchers_on_false_[literal].push_back(Watcher(clause, blocking_literal));
 }
 
@@ -124,6 +134,18 @@ bool ClauseManager::PropagateOnFalse(Literal false_literal, Trail* trail) {
     }
     ++num_inspected_clauses_;
 
+    // For a ternary clause, we can also test the third literal without
+    // looking at the clause memory. If it is true, we swap it with the
+    // blocking literal so that next time we can skip the clause even faster.
+    const bool is_ternary = it->IsTernary();
+    if (is_ternary) {
+      const Literal other = it->TernaryOtherLiteral();
+      if (assignment.LiteralIsTrue(other)) {
+        *new_it++ = Watcher::Ternary(it->clause, other, it->blocking_literal);
+        continue;
+      }
+    }
+
     // If the other watched literal is true, just change the blocking literal.
     // Note that we use the fact that the first two literals of the clause are
     // the ones currently watched.
@@ -132,8 +154,17 @@ bool ClauseManager::PropagateOnFalse(Literal false_literal, Trail* trail) {
         LiteralIndex(literals[0].Index().value() ^ literals[1].Index().value() ^
                      false_literal.Index().value()));
     if (assignment.LiteralIsTrue(other_watched_literal)) {
-      *new_it = *it;
-      new_it->blocking_literal = other_watched_literal;
+      if (is_ternary) {
+        // The inlined literals are the same, only their order changes.
+        const Literal third(LiteralIndex(
+            it->blocking_literal.Index().value() ^
+            it->TernaryOtherLiteral().Index().value() ^
+            other_watched_literal.Index().value()));
+        *new_it = Watcher::Ternary(it->clause, other_watched_literal, third);
+      } else {
+        *new_it = *it;
+        new_it->blocking_literal = other_watched_literal;
+      }
       ++new_it;
       ++num_inspected_clause_literals_;
       continue;
@@ -143,7 +174,7 @@ bool ClauseManager::PropagateOnFalse(Literal false_literal, Trail* trail) {
     // fashion from start. The first two literals can be ignored as they are the
     // watched ones.
     {
-      const int start = it->start_index;
+      const int start = is_ternary ? 2 : it->start_index;
       const int size = it->clause->size();
       DCHECK_GE(start, 2);
 
@@ -163,8 +194,13 @@ bool ClauseManager::PropagateOnFalse(Literal false_literal, Trail* trail) {
         literals[0] = other_watched_literal;
         literals[1] = literals[i];
         literals[i] = false_literal;
-        watchers_on_false_[literals[1]].emplace_back(
-            it->clause, other_watched_literal, i + 1);
+        if (is_ternary) {
+          watchers_on_false_[literals[1]].push_back(Watcher::Ternary(
+              it->clause, other_watched_literal, false_literal));
+        } else {
+          watchers_on_false_[literals[1]].emplace_back(
+              it->clause, other_watched_literal, i + 1);
+        }
         continue;
       }
     }
@@ -223,7 +259,7 @@ bool ClauseManager::AddClause(absl::Span<const Literal> literals) {
 
 bool ClauseManager::AddClause(absl::Span<const Literal> literals, Trail* trail,
                               int lbd) {
-  SatClause* clause = SatClause::Create(literals);
+  SatClause* clause = arena_.Create(literals);
   clauses_.push_back(clause);
   if (add_clause_callback_ != nullptr) add_clause_callback_(lbd, literals);
   return AttachAndPropagate(clause, trail);
@@ -231,7 +267,7 @@ bool ClauseManager::AddClause(absl::Span<const Literal> literals, Trail* trail,
 
 SatClause* ClauseManager::AddRemovableClause(absl::Span<const Literal> literals,
                                              Trail* trail, int lbd) {
-  SatClause* clause = SatClause::Create(literals);
+  SatClause* clause = arena_.Create(literals);
   clauses_.push_back(clause);
   if (add_clause_callback_ != nullptr) add_clause_callback_(lbd, literals);
   CHECK(AttachAndPropagate(clause, trail));
@@ -454,7 +490,7 @@ SatClause* ClauseManager::InprocessingAddClause(
     return nullptr;
   }
 
-  SatClause* clause = SatClause::Create(new_clause);
+  SatClause* clause = arena_.Create(new_clause);
   clauses_.push_back(clause);
   return clause;
 }
@@ -480,13 +516,13 @@ void ClauseManager::DeleteRemovedClauses() {
   DCHECK(is_clean_);
 
   int new_size = 0;
+  int64_t num_live_words = 0;
   const int old_size = clauses_.size();
   for (int i = 0; i < old_size; ++i) {
     if (i == to_minimize_index_) to_minimize_index_ = new_size;
     if (i == to_probe_index_) to_probe_index_ = new_size;
-    if (clauses_[i]->IsRemoved()) {
-      delete clauses_[i];
-    } else {
+    if (!clauses_[i]->IsRemoved()) {
+      num_live_words += ClauseArena::SizeInWords(clauses_[i]->size());
       clauses_[new_size++] = clauses_[i];
     }
   }
@@ -494,6 +530,62 @@ void ClauseManager::DeleteRemovedClauses() {
 
   if (to_minimize_index_ > new_size) to_minimize_index_ = new_size;
   if (to_probe_index_ > new_size) to_probe_index_ = new_size;
+
+  // The memory of the removed clauses is only reclaimed once it represents
+  // more than half of the arena, so that the cost of the relocation is
+  // amortized over the deletions.
+  const int64_t kMinWordsForCompaction = 1 << 20;
+  if (arena_.num_allocated_words() >= kMinWordsForCompaction &&
+      2 * num_live_words < arena_.num_allocated_words()) {
+    CompactClauseMemory();
+  }
+}
+
+void ClauseManager::CompactClauseMemory() {
+  SCOPED_TIME_STAT(&stats_);
+  DCHECK(is_clean_);
+
+  ClauseArena new_arena;
+  absl::flat_hash_map<SatClause*, SatClause*> relocation;
+  relocation.reserve(clauses_.size());
+  const auto relocate = [&new_arena, &relocation](SatClause* clause) {
+    auto [it, inserted] = relocation.insert({clause, nullptr});
+    if (inserted) it->second = new_arena.Create(clause->AsSpan());
+    return it->second;
+  };
+
+  // Note that the watchers are clean, so they only point to live clauses. The
+  // clauses not attached (during inprocessing for instance) are relocated in
+  // creation order afterwards.
+  for (std::vector<Watcher>& watchers : watchers_on_false_) {
+    for (Watcher& watcher : watchers) {
+      watcher.clause = relocate(watcher.clause);
+    }
+  }
+  for (SatClause*& clause : clauses_) {
+    DCHECK(!clause->IsRemoved());
+    clause = relocate(clause);
+  }
+
+  absl::flat_hash_map<SatClause*, ClauseInfo> new_clauses_info;
+  new_clauses_info.reserve(clauses_info_.size());
+  for (const auto& [clause, info] : clauses_info_) {
+    new_clauses_info[relocation.at(clause)] = info;
+  }
+  clauses_info_ = std::move(new_clauses_info);
+
+  // The reasons on the trail might still point to a removed clause, this can
+  // only happen for literals fixed at level zero that are never explained
+  // again. Their cached Span<> in the Trail must be recomputed.
+  for (int i = 0; i < trail_->Index(); ++i) {
+    const BooleanVariable var = (*trail_)[i].Variable();
+    if (trail_->AssignmentType(var) != propagator_id_) continue;
+    const auto it = relocation.find(reasons_[i]);
+    reasons_[i] = it == relocation.end() ? nullptr : it->second;
+  }
+  trail_->ClearCachedReasons(propagator_id_);
+
+  arena_ = std::move(new_arena);
 }
 
 // ----- BinaryImplicationGraph -----
@@ -2473,13 +2565,27 @@ absl::Span<const Literal> BinaryImplicationGraph::NextAtMostOne() {
   return result;
 }
 
-// ----- SatClause -----
+// ----- ClauseArena -----
 
-// static
-SatClause* SatClause::Create(absl::Span<const Literal> literals) {
+SatClause* ClauseArena::Create(absl::Span<const Literal> literals) {
+  static_assert(sizeof(Literal) == sizeof(uint32_t));
+  static_assert(sizeof(SatClause) % sizeof(uint32_t) == 0);
+  static_assert(alignof(SatClause) <= alignof(uint32_t));
   DCHECK_GE(literals.size(), 2);
-  SatClause* clause = reinterpret_cast<SatClause*>(
-      ::operator new(sizeof(SatClause) + literals.size() * sizeof(Literal)));
+
+  const int64_t num_words = SizeInWords(literals.size());
+  if (last_chunk_size_ + num_words > last_chunk_capacity_) {
+    // Huge clauses get their own chunk. Note that we lose the end of the
+    // previous chunk, but this is negligible.
+    last_chunk_capacity_ = std::max(kChunkSizeInWords, num_words);
+    last_chunk_size_ = 0;
+    chunks_.push_back(std::make_unique<uint32_t[]>(last_chunk_capacity_));
+  }
+  uint32_t* memory = chunks_.back().get() + last_chunk_size_;
+  last_chunk_size_ += num_words;
+  num_allocated_words_ += num_words;
+
+  SatClause* clause = reinterpret_cast<SatClause*>(memory);
   clause->size_ = literals.size();
   for (int i = 0; i < literals.size(); ++i) {
     clause->literals_[i] = literals[i];
@@ -2487,6 +2593,8 @@ SatClause* SatClause::Create(absl::Span<const Literal> literals) {
   return clause;
 }
 
+// ----- SatClause -----
+
 // Note that for an attached clause, removing fixed literal is okay because if
 // any of the watched literal is assigned, then the clause is necessarily true.
 bool SatClause::RemoveFixedLiteralsAndTestIfTrue(
@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -50,19 +51,13 @@ namespace sat {
 // literals. In many places, we just use vector<literal> to encode one. But in
 // the critical propagation code, we use this class to remove one memory
 // indirection.
+//
+// Clauses are created by a ClauseArena which owns their memory. There must be
+// at least 2 literals. Clause with one literal fix variable directly and are
+// never constructed. Note that in practice, we use BinaryImplicationGraph for
+// the clause of size 2, so this is used for size at least 3.
 class SatClause {
  public:
-  // Creates a sat clause. There must be at least 2 literals.
-  // Clause with one literal fix variable directly and are never constructed.
-  // Note that in practice, we use BinaryImplicationGraph for the clause of size
-  // 2, so this is used for size at least 3.
-  static SatClause* Create(absl::Span<const Literal> literals);
-
-  // Non-sized delete because this is a tail-padded class.
-  void operator delete(void* p) {
-    ::operator delete(p);  // non-sized delete
-  }
-
   // Number of literals in the clause.
   int size() const { return size_; }
 
@@ -115,8 +110,9 @@ class SatClause {
 
  private:
   // The manager needs to permute the order of literals in the clause and
-  // call Clear()/Rewrite.
+  // call Clear()/Rewrite. The arena constructs the clauses in its memory.
   friend class ClauseManager;
+  friend class ClauseArena;
 
   Literal* literals() { return &(literals_[0]); }
 
@@ -148,6 +144,47 @@ struct ClauseInfo {
   bool protected_during_next_cleanup = false;
 };
 
+// Owns the memory of the SatClause of a ClauseManager.
+//
+// Instead of allocating each clause individually on the heap, the clauses are
+// stored one after the other in large chunks of memory. This way the literals
+// of clauses created or relocated together are contiguous in memory which is a
+// lot more cache friendly during propagation. The memory of a removed clause is
+// never reused, it is only reclaimed when the whole arena is discarded, see
+// ClauseManager::CompactClauseMemory().
+class ClauseArena {
+ public:
+  ClauseArena() = default;
+  ClauseArena(ClauseArena&&) = default;
+  ClauseArena& operator=(ClauseArena&&) = default;
+
+  // This type is not copyable.
+  ClauseArena(const ClauseArena&) = delete;
+  ClauseArena& operator=(const ClauseArena&) = delete;
+
+  // Creates a new clause with the given literals. The returned pointer stays
+  // valid until this arena is destroyed or reassigned.
+  SatClause* Create(absl::Span<const Literal> literals);
+
+  // Number of memory words needed to store a clause of the given size.
+  static int64_t SizeInWords(int clause_size) {
+    return (sizeof(SatClause) + clause_size * sizeof(Literal)) /
+           sizeof(uint32_t);
+  }
+
+  // Total number of words used so far, including the ones of the clauses that
+  // were removed or shrunk since their creation.
+  int64_t num_allocated_words() const { return num_allocated_words_; }
+
+ private:
+  static constexpr int64_t kChunkSizeInWords = 1 << 16;
+
+  std::vector<std::unique_ptr<uint32_t[]>> chunks_;
+  int64_t last_chunk_size_ = 0;
+  int64_t last_chunk_capacity_ = 0;
+  int64_t num_allocated_words_ = 0;
+};
+
 class BinaryImplicationGraph;
 
 // Stores the 2-watched literals data structure.  See
@@ -207,9 +244,12 @@ class ClauseManager : public SatPropagator {
   // be unassigned and the clause must not be already attached.
   void Attach(SatClause* clause, Trail* trail);
 
-  // Reclaims the memory of the lazily removed clauses (their size was set to
-  // zero) and remove them from AllClausesInCreationOrder() this work in
-  // O(num_clauses()).
+  // Removes the lazily removed clauses (their size was set to zero) from
+  // AllClausesInCreationOrder() this work in O(num_clauses()). Their memory is
+  // reclaimed once it represents a large enough fraction of the clause memory,
+  // in which case all the live clauses are relocated and any SatClause*
+  // previously returned by this class (other than the ones returned by
+  // AllClausesInCreationOrder() afterwards) becomes invalid.
   void DeleteRemovedClauses();
   int64_t num_clauses() const { return clauses_.size(); }
   const std::vector<SatClause*>& AllClausesInCreationOrder() const {
@@ -302,6 +342,20 @@ class ClauseManager : public SatPropagator {
     Watcher(SatClause* c, Literal b, int i = 2)
         : blocking_literal(b), start_index(i), clause(c) {}
 
+    // Watcher of a clause of size 3 on one of its literal. The two other
+    // literals of the clause are stored inline: one as the blocking literal
+    // and the other in place of the start_index which is useless for such a
+    // clause. Note that the set {blocking_literal, TernaryOtherLiteral()} is
+    // always the clause minus the watched literal.
+    static Watcher Ternary(SatClause* c, Literal b, Literal other) {
+      return Watcher(c, b, -1 - other.Index().value());
+    }
+    bool IsTernary() const { return start_index < 0; }
+    Literal TernaryOtherLiteral() const {
+      DCHECK(IsTernary());
+      return Literal(LiteralIndex(-1 - start_index));
+    }
+
     // Optimization. A literal from the clause that sometimes allow to not even
     // look at the clause memory when true.
     Literal blocking_literal;
@@ -315,6 +369,9 @@ class ClauseManager : public SatPropagator {
     // Note that ideally, this should be part of a SatClause, so it can be
     // shared across watchers. However, since we have 32 bits for "free" here
     // because of the struct alignment, we store it here instead.
+    //
+    // For a ternary watcher this encodes the third literal instead, see
+    // Ternary().
     int32_t start_index;
 
     SatClause* clause;
@@ -350,6 +407,14 @@ class ClauseManager : public SatPropagator {
   // Common code between LazyDetach() and Detach().
   void InternalDetach(SatClause* clause);
 
+  // Relocates all the clauses in a fresh ClauseArena and releases the old
+  // memory. The clauses are copied in the order of the watcher lists so that
+  // the clauses inspected by the same PropagateOnFalse() are contiguous. All
+  // the SatClause* owned by this class are updated, but any pointer kept
+  // outside becomes invalid. This must only be called when is_clean_ is true
+  // and at a point where no such pointer exists, see DeleteRemovedClauses().
+  void CompactClauseMemory();
+
   util_intops::StrongVector<LiteralIndex, std::vector<Watcher>>
       watchers_on_false_;
 
@@ -372,11 +437,10 @@ class ClauseManager : public SatPropagator {
   // For DetachAllClauses()/AttachAllClauses().
   bool all_clauses_are_attached_ = true;
 
-  // All the clauses currently in memory. This vector has ownership of the
-  // pointers. We currently do not use std::unique_ptr<SatClause> because it
-  // can't be used with some STL algorithms like std::partition.
+  // All the clauses currently in memory. Their memory is owned by arena_.
   //
   // Note that the unit clauses and binary clause are not kept here.
+  ClauseArena arena_;
   std::vector<SatClause*> clauses_;
 
   int to_minimize_index_ = 0;
@@ -542,6 +542,36 @@ void LinearIncrementalEvaluator::UpdateScoreOnActivityChange(
 
     const int64_t old_a_minus_new_a =
         distances_[c] - domains_[c].Distance(new_activity);
+
+    // Fast path for the most common case of a single interval. The distance
+    // is then branch-free, and we compute all the score changes in a first
+    // loop without any indirect write so that the compiler can vectorize it.
+    // The scatter to jump_scores is done in a second loop.
+    if (rhs.NumIntervals() == 1) {
+      tmp_score_changes_.resize(data.num_linear_entries);
+      double* score_changes = tmp_score_changes_.data();
+      for (int k = 0; k < data.num_linear_entries; ++k) {
+        const int64_t impact = row_coeffs[k] * jump_deltas[row_vars[k]];
+        const int64_t old_v = old_activity + impact;
+        const int64_t new_v = new_activity + impact;
+        const int64_t old_b =
+            std::max(std::max(old_v - rhs_max, rhs_min - old_v), int64_t{0});
+        const int64_t new_b =
+            std::max(std::max(new_v - rhs_max, rhs_min - new_v), int64_t{0});
+        score_changes[k] =
+            weight * static_cast<double>(old_a_minus_new_a + new_b - old_b);
+      }
+      for (int k = 0; k < data.num_linear_entries; ++k) {
+        const int var = row_vars[k];
+        jump_scores[var] += score_changes[k];
+        if (!in_last_affected_variables_[var]) {
+          in_last_affected_variables_[var] = true;
+          last_affected_variables_.push_back(var);
+        }
+      }
+      return;
+    }
+
     for (int k = 0; k < data.num_linear_entries; ++k) {
       const int var = row_vars[k];
       const int64_t impact = row_coeffs[k] * jump_deltas[var];
@@ -945,6 +975,13 @@ void LinearIncrementalEvaluator::PrecomputeCompactView(
     }
   }
 
+  // The temporary data is not needed anymore. Since the evaluator lives as
+  // long as its worker, this matters on large models.
+  gtl::STLClearObject(&tmp_row_sizes_);
+  gtl::STLClearObject(&tmp_row_num_positive_literals_);
+  gtl::STLClearObject(&tmp_row_num_negative_literals_);
+  gtl::STLClearObject(&tmp_row_num_linear_entries_);
+
   cached_deltas_.assign(columns_.size(), 0);
   cached_scores_.assign(columns_.size(), 0);
   last_affected_variables_.ClearAndReserve(columns_.size());
@@ -1490,7 +1527,6 @@ void AddCircuitFlowConstraints(LinearIncrementalEvaluator& linear_evaluator,
 LsEvaluator::LsEvaluator(const CpModelProto& cp_model,
                          const SatParameters& params)
     : cp_model_(cp_model), params_(params) {
-  var_to_constraints_.resize(cp_model_.variables_size());
   jump_value_optimal_.resize(cp_model_.variables_size(), true);
   num_violated_constraint_per_var_ignoring_objective_.assign(
       cp_model_.variables_size(), 0);
@@ -1507,7 +1543,6 @@ LsEvaluator::LsEvaluator(
     const std::vector<bool>& ignored_constraints,
     const std::vector<ConstraintProto>& additional_constraints)
     : cp_model_(cp_model), params_(params) {
-  var_to_constraints_.resize(cp_model_.variables_size());
   jump_value_optimal_.resize(cp_model_.variables_size(), true);
   num_violated_constraint_per_var_ignoring_objective_.assign(
       cp_model_.variables_size(), 0);
@@ -1517,26 +1552,19 @@ LsEvaluator::LsEvaluator(
 }
 
 void LsEvaluator::BuildVarConstraintGraph() {
-  // Clear the var <-> constraint graph.
-  for (std::vector<int>& ct_indices : var_to_constraints_) ct_indices.clear();
-  constraint_to_vars_.resize(constraints_.size());
-
   // Build the var <-> constraint graph.
+  //
+  // Since each constraint lists its variables only once, the transpose lists
+  // the constraints of each variable only once and in increasing order.
+  constraint_to_vars_.clear();
+  constraint_to_vars_.reserve(constraints_.size());
   for (int ct_index = 0; ct_index < constraints_.size(); ++ct_index) {
-    constraint_to_vars_[ct_index] =
-        constraints_[ct_index]->UsedVariables(cp_model_);
-    for (const int var : constraint_to_vars_[ct_index]) {
-      var_to_constraints_[var].push_back(ct_index);
-    }
-  }
-
-  // Remove duplicates.
-  for (std::vector<int>& constraints : var_to_constraints_) {
-    gtl::STLSortAndRemoveDuplicates(&constraints);
-  }
-  for (std::vector<int>& vars : constraint_to_vars_) {
+    std::vector<int> vars = constraints_[ct_index]->UsedVariables(cp_model_);
     gtl::STLSortAndRemoveDuplicates(&vars);
+    constraint_to_vars_.Add(vars);
   }
+  var_to_constraints_.ResetFromTranspose(constraint_to_vars_,
+                                         cp_model_.variables_size());
 
   // Scan the model to decide if a variable is linked to a convex evaluation.
   jump_value_optimal_.resize(cp_model_.variables_size());
@@ -221,6 +221,7 @@ class LinearIncrementalEvaluator {
   std::vector<int> tmp_row_num_positive_literals_;
   std::vector<int> tmp_row_num_negative_literals_;
   std::vector<int> tmp_row_num_linear_entries_;
+  std::vector<double> tmp_score_changes_;
 
   // Constraint indexed data (dynamic).
   std::vector<bool> is_violated_;
@@ -409,7 +410,7 @@ class LsEvaluator {
     if (c < NumLinearConstraints()) {
       return linear_evaluator_.ConstraintToVars(c);
     }
-    return absl::MakeConstSpan(constraint_to_vars_[c - NumLinearConstraints()]);
+    return constraint_to_vars_[c - NumLinearConstraints()];
   }
 
   // Note that the constraint indexing is different here than in the other
@@ -440,8 +441,8 @@ class LsEvaluator {
   CpModelProto expanded_constraints_;
   LinearIncrementalEvaluator linear_evaluator_;
   std::vector<std::unique_ptr<CompiledConstraint>> constraints_;
-  std::vector<std::vector<int>> var_to_constraints_;
-  std::vector<std::vector<int>> constraint_to_vars_;
+  CompactVectorVector<int, int> var_to_constraints_;
+  CompactVectorVector<int, int> constraint_to_vars_;
   std::vector<bool> jump_value_optimal_;
 
   UnsafeDenseSet<int> violated_constraints_;
@@ -14,6 +14,7 @@
 #include "ortools/sat/cp_model_checker.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -30,6 +31,9 @@
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/port/proto_utils.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_utils.h"
@@ -1675,6 +1679,56 @@ class ConstraintChecker {
   const std::vector<int64_t> variable_values_;
 };
 
+// Returns the index of the first constraint of the model that is not
+// satisfied by the given values, or -1 if they are all satisfied. Large models
+// are checked by chunks of constraints on up to num_workers threads.
+int FindFirstInfeasibleConstraint(const CpModelProto& model,
+                                  absl::Span<const int64_t> variable_values,
+                                  int num_workers) {
+  const int num_constraints = model.constraints_size();
+#if !defined(__PORTABLE_PLATFORM__)
+  constexpr int kMinConstraintsPerWorker = 10'000;
+  num_workers =
+      std::min(num_workers, num_constraints / kMinConstraintsPerWorker);
+  if (num_workers > 1) {
+    std::atomic<int> first_infeasible = num_constraints;
+    const int chunk_size = (num_constraints + num_workers - 1) / num_workers;
+    {
+      ThreadPool pool("SolutionChecker", num_workers);
+      pool.StartWorkers();
+      for (int begin = 0; begin < num_constraints; begin += chunk_size) {
+        const int end = std::min(begin + chunk_size, num_constraints);
+        pool.Schedule([&model, variable_values, &first_infeasible, begin,
+                       end]() {
+          ConstraintChecker checker(variable_values);
+          for (int c = begin; c < end; ++c) {
+            // We can stop as soon as an earlier constraint is infeasible.
+            if (c >= first_infeasible.load(std::memory_order_relaxed)) return;
+            if (checker.ConstraintIsFeasible(model, model.constraints(c))) {
+              continue;
+            }
+            int current = first_infeasible.load();
+            while (c < current &&
+                   !first_infeasible.compare_exchange_weak(current, c)) {
+            }
+            return;
+          }
+        });
+      }
+      // The pool destructor waits for all the tasks to be done.
+    }
+    const int first = first_infeasible.load();
+    return first < num_constraints ? first : -1;
+  }
+#endif  // __PORTABLE_PLATFORM__
+
+  ConstraintChecker checker(variable_values);
+  for (int c = 0; c < num_constraints; ++c) {
+    if (!checker.ConstraintIsFeasible(model, model.constraints(c))) return c;
+  }
+  return -1;
+}
+
 }  // namespace
 
 bool ConstraintIsFeasible(const CpModelProto& model,
@@ -1687,7 +1741,8 @@ bool ConstraintIsFeasible(const CpModelProto& model,
 bool SolutionIsFeasible(const CpModelProto& model,
                         absl::Span<const int64_t> variable_values,
                         const CpModelProto* mapping_proto,
-                        const std::vector<int>* postsolve_mapping) {
+                        const std::vector<int>* postsolve_mapping,
+                        int num_workers) {
   if (variable_values.size() != model.variables_size()) {
     VLOG(1) << "Wrong number of variables (" << variable_values.size()
             << ") in the solution vector. It should be "
@@ -1706,12 +1761,9 @@ bool SolutionIsFeasible(const CpModelProto& model,
   }
 
   CHECK_EQ(variable_values.size(), model.variables_size());
-  ConstraintChecker checker(variable_values);
-
-  for (int c = 0; c < model.constraints_size(); ++c) {
-    const ConstraintProto& ct = model.constraints(c);
-    if (checker.ConstraintIsFeasible(model, ct)) continue;
-
+  const int c =
+      FindFirstInfeasibleConstraint(model, variable_values, num_workers);
+  if (c >= 0) {
     // Display a message to help debugging.
     VLOG(1) << "Failing constraint #" << c << " : "
             << ProtobufShortDebugString(model.constraints(c));
@@ -1741,6 +1793,7 @@ bool SolutionIsFeasible(const CpModelProto& model,
   // probably check that the response objective matches with the one we can
   // compute here. This might better be done in another function though.
   if (model.has_objective()) {
+    const ConstraintChecker checker(variable_values);
     int64_t inner_objective = 0;
     const int num_variables = model.objective().coeffs_size();
     for (int i = 0; i < num_variables; ++i) {
@@ -60,12 +60,15 @@ bool PossibleIntegerOverflow(const CpModelProto& model,
 // given model. The values vector should be in one to one correspondence with
 // the model.variables() list of variables.
 //
-// The last two arguments are optional and help debugging a failing constraint
-// due to presolve.
+// The mapping_proto and postsolve_mapping arguments are optional and help
+// debugging a failing constraint due to presolve. If num_workers > 1, the
+// constraints of large models are checked in parallel. The result, and the
+// failing constraint reported, are the same as with a sequential check.
 bool SolutionIsFeasible(const CpModelProto& model,
                         absl::Span<const int64_t> variable_values,
                         const CpModelProto* mapping_proto = nullptr,
-                        const std::vector<int>* postsolve_mapping = nullptr);
+                        const std::vector<int>* postsolve_mapping = nullptr,
+                        int num_workers = 1);
 
 // Checks a single constraint for feasibility.
 // This has some overhead, and should only be used for debugging.
@@ -0,0 +1,203 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/cp_model_columnar.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+#include "ortools/sat/cp_model.pb.h"
+
+namespace operations_research {
+namespace sat {
+
+namespace {
+
+constexpr absl::string_view kMagic = "CPSATCOL";
+constexpr uint32_t kByteOrderMark = 0x01020304;
+
+template <typename T>
+void AppendRaw(const T* values, int64_t num_values, std::string* output) {
+  if (num_values == 0) return;
+  output->append(reinterpret_cast<const char*>(values),
+                 num_values * sizeof(T));
+}
+
+template <typename T>
+void AppendValue(T value, std::string* output) {
+  AppendRaw(&value, 1, output);
+}
+
+// Reads from a string_view, advancing it. All the functions return false if
+// there is not enough data.
+class Reader {
+ public:
+  explicit Reader(absl::string_view data) : data_(data) {}
+
+  template <typename T>
+  bool HasValues(uint64_t num_values) const {
+    return num_values <= data_.size() / sizeof(T);
+  }
+
+  template <typename T>
+  bool ReadRaw(uint64_t num_values, T* values) {
+    if (!HasValues<T>(num_values)) return false;
+    const size_t num_bytes = num_values * sizeof(T);
+    if (num_bytes > 0) std::memcpy(values, data_.data(), num_bytes);
+    data_.remove_prefix(num_bytes);
+    return true;
+  }
+
+  template <typename T>
+  bool ReadValue(T* value) {
+    return ReadRaw(1, value);
+  }
+
+  bool ReadBytes(uint64_t num_bytes, absl::string_view* bytes) {
+    if (num_bytes > data_.size()) return false;
+    *bytes = data_.substr(0, num_bytes);
+    data_.remove_prefix(num_bytes);
+    return true;
+  }
+
+  bool empty() const { return data_.empty(); }
+
+ private:
+  absl::string_view data_;
+};
+
+}  // namespace
+
+std::string CpModelToColumnarString(const CpModelProto& model_proto) {
+  // The proto part is the model without the linear arrays.
+  CpModelProto rest = model_proto;
+  std::vector<uint64_t> sizes;
+  int64_t num_terms = 0;
+  for (ConstraintProto& ct : *rest.mutable_constraints()) {
+    if (ct.constraint_case() != ConstraintProto::kLinear) continue;
+    ct.mutable_linear()->clear_vars();
+    ct.mutable_linear()->clear_coeffs();
+  }
+  for (const ConstraintProto& ct : model_proto.constraints()) {
+    if (ct.constraint_case() != ConstraintProto::kLinear) continue;
+    sizes.push_back(ct.linear().vars().size());
+    num_terms += ct.linear().vars().size();
+  }
+  const std::string serialized_rest = rest.SerializeAsString();
+
+  std::string output;
+  output.reserve(kMagic.size() + sizeof(uint32_t) + serialized_rest.size() +
+                 (sizes.size() + 2) * sizeof(uint64_t) +
+                 num_terms * (sizeof(int32_t) + sizeof(int64_t)));
+  output.append(kMagic.data(), kMagic.size());
+  AppendValue(kByteOrderMark, &output);
+  AppendValue<uint64_t>(serialized_rest.size(), &output);
+  output.append(serialized_rest);
+  AppendValue<uint64_t>(sizes.size(), &output);
+  AppendRaw(sizes.data(), sizes.size(), &output);
+  for (const ConstraintProto& ct : model_proto.constraints()) {
+    if (ct.constraint_case() != ConstraintProto::kLinear) continue;
+    AppendRaw(ct.linear().vars().data(), ct.linear().vars().size(), &output);
+  }
+  for (const ConstraintProto& ct : model_proto.constraints()) {
+    if (ct.constraint_case() != ConstraintProto::kLinear) continue;
+    if (ct.linear().coeffs().size() != ct.linear().vars().size()) {
+      // This is an invalid model, we pad or truncate the coeffs so that the
+      // format stays consistent.
+      for (int i = 0; i < ct.linear().vars().size(); ++i) {
+        AppendValue<int64_t>(
+            i < ct.linear().coeffs().size() ? ct.linear().coeffs(i) : 0,
+            &output);
+      }
+      continue;
+    }
+    AppendRaw(ct.linear().coeffs().data(), ct.linear().coeffs().size(),
+              &output);
+  }
+  return output;
+}
+
+bool IsColumnarCpModel(absl::string_view data) {
+  return absl::StartsWith(data, kMagic);
+}
+
+absl::Status ColumnarStringToCpModel(absl::string_view data,
+                                     CpModelProto* model_proto) {
+  if (!IsColumnarCpModel(data)) {
+    return absl::InvalidArgumentError("Not a columnar CpModelProto.");
+  }
+  Reader reader(data.substr(kMagic.size()));
+  const absl::Status corrupted =
+      absl::InvalidArgumentError("Corrupted columnar CpModelProto.");
+
+  uint32_t byte_order_mark;
+  if (!reader.ReadValue(&byte_order_mark)) return corrupted;
+  if (byte_order_mark != kByteOrderMark) {
+    return absl::InvalidArgumentError(
+        "Columnar CpModelProto written with a different byte order.");
+  }
+
+  uint64_t proto_size;
+  absl::string_view serialized_rest;
+  if (!reader.ReadValue(&proto_size)) return corrupted;
+  if (!reader.ReadBytes(proto_size, &serialized_rest)) return corrupted;
+  model_proto->Clear();
+  if (!model_proto->ParseFromString(serialized_rest)) return corrupted;
+
+  uint64_t num_linears;
+  if (!reader.ReadValue(&num_linears)) return corrupted;
+  if (num_linears > static_cast<uint64_t>(model_proto->constraints().size())) {
+    return corrupted;
+  }
+  if (!reader.HasValues<uint64_t>(num_linears)) return corrupted;
+  std::vector<uint64_t> sizes(num_linears);
+  if (!reader.ReadRaw(num_linears, sizes.data())) return corrupted;
+
+  // We fill the vars and then the coeffs of all the linear constraints, in
+  // the same order as they were written.
+  for (const bool is_coeff : {false, true}) {
+    uint64_t index = 0;
+    for (ConstraintProto& ct : *model_proto->mutable_constraints()) {
+      if (ct.constraint_case() != ConstraintProto::kLinear) continue;
+      if (index >= num_linears) return corrupted;
+      const uint64_t size = sizes[index++];
+      if (size > std::numeric_limits<int>::max()) return corrupted;
+
+      // We check the size before resizing to not allocate a lot of memory
+      // on corrupted data.
+      if (is_coeff) {
+        if (!reader.HasValues<int64_t>(size)) return corrupted;
+        auto* coeffs = ct.mutable_linear()->mutable_coeffs();
+        coeffs->Resize(static_cast<int>(size), 0);
+        if (!reader.ReadRaw(size, coeffs->mutable_data())) return corrupted;
+      } else {
+        if (!reader.HasValues<int32_t>(size)) return corrupted;
+        auto* vars = ct.mutable_linear()->mutable_vars();
+        vars->Resize(static_cast<int>(size), 0);
+        if (!reader.ReadRaw(size, vars->mutable_data())) return corrupted;
+      }
+    }
+    if (index != num_linears) return corrupted;
+  }
+  if (!reader.empty()) return corrupted;
+  return absl::OkStatus();
+}
+
+}  // namespace sat
+}  // namespace operations_research
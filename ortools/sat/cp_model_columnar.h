@@ -0,0 +1,58 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_SAT_CP_MODEL_COLUMNAR_H_
+#define OR_TOOLS_SAT_CP_MODEL_COLUMNAR_H_
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "ortools/sat/cp_model.pb.h"
+
+namespace operations_research {
+namespace sat {
+
+// A binary serialization of a CpModelProto that is a lot faster to load than
+// the protobuf format for models with many large linear constraints.
+//
+// On such models, most of the loading time is spent decoding the vars and
+// coeffs of the linear constraints which are stored as varints. In this
+// format, these arrays are extracted from the proto and stored contiguously
+// with a fixed width (int32 for the vars, int64 for the coeffs), so that they
+// can be copied in bulk. The rest of the model is stored as a regular binary
+// proto.
+//
+// The layout is:
+//   - the magic string "CPSATCOL" and a uint32 byte order mark.
+//   - the uint64 size of the serialized proto, and the proto itself.
+//   - the uint64 number of linear constraints and their uint64 sizes.
+//   - all the vars of these constraints, then all their coeffs.
+// Note that the linear constraints appear in the same order as in the model,
+// and that a file is only readable on a machine with the same byte order.
+
+// Returns the columnar serialization of the given model.
+std::string CpModelToColumnarString(const CpModelProto& model_proto);
+
+// Parses a string produced by CpModelToColumnarString(). Returns an error if
+// the data is corrupted or was written with a different byte order.
+absl::Status ColumnarStringToCpModel(absl::string_view data,
+                                     CpModelProto* model_proto);
+
+// Returns true if the given data looks like a columnar serialization.
+bool IsColumnarCpModel(absl::string_view data);
+
+}  // namespace sat
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_SAT_CP_MODEL_COLUMNAR_H_
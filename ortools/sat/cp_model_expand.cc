@@ -1091,6 +1091,30 @@ void ExpandAutomaton(ConstraintProto* ct, PresolveContext* context) {
   std::vector<absl::flat_hash_set<int64_t>> reachable_labels;
   PropagateAutomaton(proto, *context, &reachable_states, &reachable_labels);
 
+  // Large automata are propagated directly by the AutomatonPropagator, so we
+  // just restrict the domains to the reachable labels.
+  const int64_t min_size =
+      context->params().min_automaton_size_for_propagator();
+  if (min_size > 0 && ct->enforcement_literal().empty() &&
+      int64_t{proto.vars_size()} * proto.transition_label_size() >= min_size) {
+    bool removed_values = false;
+    for (int time = 0; time < proto.vars_size(); ++time) {
+      if (!context->IntersectDomainWith(
+              proto.vars(time),
+              Domain::FromValues({reachable_labels[time].begin(),
+                                  reachable_labels[time].end()}),
+              &removed_values)) {
+        VLOG(1) << "Infeasible automaton.";
+        return;
+      }
+    }
+    if (removed_values) {
+      context->UpdateRuleStats("automaton: reduced variable domains");
+    }
+    context->UpdateRuleStats("automaton: kept for the automaton propagator");
+    return;
+  }
+
   // We will model at each time step the current automaton state using Boolean
   // variables. We will have n+1 time step. At time zero, we start in the
   // initial state, and at time n we should be in one of the final states. We
@@ -1973,6 +1997,21 @@ void ExpandPositiveTable(ConstraintProto* ct, PresolveContext* context) {
     }
   }
 
+  // Large tables are propagated directly by the CompactTablePropagator, so we
+  // just write back the filtered tuples.
+  const int min_num_tuples =
+      context->params().min_num_tuples_for_compact_table();
+  if (min_num_tuples > 0 && tuples.size() >= min_num_tuples &&
+      ct->enforcement_literal().empty()) {
+    context->UpdateRuleStats("table: kept for the compact table propagator");
+    TableConstraintProto* mutable_table = ct->mutable_table();
+    mutable_table->clear_values();
+    for (const std::vector<int64_t>& tuple : tuples) {
+      mutable_table->mutable_values()->Add(tuple.begin(), tuple.end());
+    }
+    return;
+  }
+
   // Tables with two variables do not need tuple literals.
   //
   // TODO(user): If there is an unique variable with cost, it is better to
@@ -0,0 +1,175 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/sat/cp_model_incremental.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_checker.h"
+#include "ortools/sat/cp_model_solver.h"
+#include "ortools/sat/cp_model_utils.h"
+#include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/util/sorted_interval_list.h"
+
+namespace operations_research {
+namespace sat {
+
+IncrementalCpSolver::IncrementalCpSolver(CpModelProto model_proto)
+    : model_(std::move(model_proto)),
+      num_constraints_at_last_solve_(model_.constraints_size()) {}
+
+bool IncrementalCpSolver::TightenVariableDomain(int var, const Domain& domain) {
+  CHECK_GE(var, 0);
+  CHECK_LT(var, model_.variables_size());
+  IntegerVariableProto* var_proto = model_.mutable_variables(var);
+  const Domain new_domain =
+      ReadDomainFromProto(*var_proto).IntersectionWith(domain);
+  if (new_domain.IsEmpty()) {
+    // We do not write an empty domain in the model as it would be invalid.
+    is_infeasible_ = true;
+    return false;
+  }
+  FillDomainInProto(new_domain, var_proto);
+  tightened_variables_.push_back(var);
+  return true;
+}
+
+ConstraintProto* IncrementalCpSolver::AddConstraint() {
+  return model_.add_constraints();
+}
+
+void IncrementalCpSolver::SetObjective(const CpObjectiveProto& objective) {
+  model_.clear_floating_point_objective();
+  *model_.mutable_objective() = objective;
+}
+
+bool IncrementalCpSolver::LastSolutionIsStillFeasible() const {
+  for (const int var : tightened_variables_) {
+    if (!DomainInProtoContains(model_.variables(var), last_solution_[var])) {
+      return false;
+    }
+  }
+  if (num_constraints_at_last_solve_ == model_.constraints_size()) return true;
+
+  // Note that the new constraints can refer to old interval constraints by
+  // index, so it is easier to check the full model.
+  return SolutionIsFeasible(model_, last_solution_);
+}
+
+CpSolverResponse IncrementalCpSolver::Solve() {
+  if (is_infeasible_) {
+    CpSolverResponse response;
+    response.set_status(CpSolverStatus::INFEASIBLE);
+    return response;
+  }
+
+  // Note that this replaces any hint given in the initial model.
+  SatParameters params = params_;
+  if (!last_solution_.empty()) {
+    if (LastSolutionIsStillFeasible()) {
+      ++num_feasible_warm_starts_;
+    } else {
+      params.set_repair_hint(true);
+    }
+    PartialVariableAssignment* hint = model_.mutable_solution_hint();
+    hint->Clear();
+    for (int var = 0; var < last_solution_.size(); ++var) {
+      hint->add_vars(var);
+      hint->add_values(last_solution_[var]);
+    }
+  }
+
+  CpSolverResponse response = SolveWithParameters(model_, params);
+
+  // We only forget about the modifications once we have a new solution, so
+  // that the next solve still knows whether last_solution_ is feasible.
+  if (response.status() == CpSolverStatus::OPTIMAL ||
+      response.status() == CpSolverStatus::FEASIBLE) {
+    last_solution_.assign(response.solution().begin(),
+                          response.solution().end());
+    tightened_variables_.clear();
+    num_constraints_at_last_solve_ = model_.constraints_size();
+  }
+  return response;
+}
+
+CachingCpSolver::CachingCpSolver(int max_num_models)
+    : max_num_models_(max_num_models) {
+  CHECK_GE(max_num_models, 0);
+}
+
+int64_t CachingCpSolver::num_cache_hits() const {
+  absl::MutexLock mutex_lock(&mutex_);
+  return num_cache_hits_;
+}
+
+std::vector<int64_t> CachingCpSolver::GetCachedSolution(uint64_t fingerprint) {
+  absl::MutexLock mutex_lock(&mutex_);
+  const auto it = solutions_.find(fingerprint);
+  if (it == solutions_.end()) return {};
+  ++num_cache_hits_;
+  return it->second;
+}
+
+void CachingCpSolver::CacheSolution(uint64_t fingerprint,
+                                    std::vector<int64_t> solution) {
+  absl::MutexLock mutex_lock(&mutex_);
+  const auto [it, inserted] = solutions_.insert({fingerprint, {}});
+  it->second = std::move(solution);
+  if (!inserted) return;
+  fingerprints_.push_back(fingerprint);
+  while (fingerprints_.size() > max_num_models_) {
+    solutions_.erase(fingerprints_.front());
+    fingerprints_.pop_front();
+  }
+}
+
+CpSolverResponse CachingCpSolver::Solve(const CpModelProto& model_proto,
+                                        const SatParameters& params) {
+  // We never override a hint given by the user.
+  if (max_num_models_ == 0 || model_proto.has_solution_hint()) {
+    return SolveWithParameters(model_proto, params);
+  }
+
+  const uint64_t fingerprint = FingerprintModel(model_proto);
+  std::vector<int64_t> solution = GetCachedSolution(fingerprint);
+  CpSolverResponse response;
+  if (solution.size() == model_proto.variables_size()) {
+    CpModelProto hinted_model = model_proto;
+    PartialVariableAssignment* hint = hinted_model.mutable_solution_hint();
+    for (int var = 0; var < solution.size(); ++var) {
+      hint->add_vars(var);
+      hint->add_values(solution[var]);
+    }
+    response = SolveWithParameters(hinted_model, params);
+  } else {
+    response = SolveWithParameters(model_proto, params);
+  }
+
+  // Note that if another request on the same model finished in between, we
+  // might replace a better solution, this is fine as this is just a hint.
+  if (response.status() == CpSolverStatus::OPTIMAL ||
+      response.status() == CpSolverStatus::FEASIBLE) {
+    CacheSolution(fingerprint, std::vector<int64_t>(response.solution().begin(),
+                                                    response.solution().end()));
+  }
+  return response;
+}
+
+}  // namespace sat
+}  // namespace operations_research
@@ -0,0 +1,151 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OR_TOOLS_SAT_CP_MODEL_INCREMENTAL_H_
+#define OR_TOOLS_SAT_CP_MODEL_INCREMENTAL_H_
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/util/sorted_interval_list.h"
+
+namespace operations_research {
+namespace sat {
+
+// Helper to solve a sequence of closely related models, like in a
+// re-optimization loop where only a few bounds, constraints or objective
+// coefficients change between two solves.
+//
+// Each Solve() is a full CP-SAT solve, but the best solution of the previous
+// solve is used as a hint for the next one. We also track what changed since
+// the last solve: if the previous solution is still feasible (for instance if
+// only the objective changed), the solver starts with a feasible solution
+// right away, otherwise we ask the solver to repair the hint.
+//
+// Note that we do not try to reuse the presolved model or the learned clauses:
+// the presolve removes solutions that are dominated for the current objective
+// and constraints, so most of its reductions are not valid anymore once the
+// model changes.
+//
+// This class is not thread-safe.
+class IncrementalCpSolver {
+ public:
+  explicit IncrementalCpSolver(CpModelProto model_proto);
+
+  // This type is neither copyable nor movable.
+  IncrementalCpSolver(const IncrementalCpSolver&) = delete;
+  IncrementalCpSolver& operator=(const IncrementalCpSolver&) = delete;
+
+  // The parameters used by all the future Solve().
+  void SetParameters(const SatParameters& params) { params_ = params; }
+
+  // The current model, with all the modifications applied.
+  const CpModelProto& model() const { return model_; }
+
+  // Intersects the domain of the given variable with the given domain.
+  // Returns false if the result is empty, in which case the model is
+  // infeasible and the next Solve() will return INFEASIBLE.
+  bool TightenVariableDomain(int var, const Domain& domain);
+
+  // Adds a new constraint to the model and returns it so that the caller can
+  // fill it. The pointer is only valid until the next modification.
+  ConstraintProto* AddConstraint();
+
+  // Replaces the objective of the model.
+  void SetObjective(const CpObjectiveProto& objective);
+
+  // Solves the current model. If a solution is found, it will be used as a
+  // hint for the next call.
+  CpSolverResponse Solve();
+
+  // Returns the number of Solve() that started from a solution that was still
+  // feasible for the modified model.
+  int64_t num_feasible_warm_starts() const { return num_feasible_warm_starts_; }
+
+ private:
+  // Returns true if last_solution_ satisfies all the modifications done since
+  // the last solve. The rest of the model is known to be satisfied.
+  bool LastSolutionIsStillFeasible() const;
+
+  CpModelProto model_;
+  SatParameters params_;
+
+  // The best solution found by the last Solve(), or empty if there is none.
+  std::vector<int64_t> last_solution_;
+
+  // The modifications since the last solve. Note that the constraints
+  // [num_constraints_at_last_solve_, model_.constraints_size()) are new.
+  std::vector<int> tightened_variables_;
+  int num_constraints_at_last_solve_ = 0;
+  bool is_infeasible_ = false;
+
+  int64_t num_feasible_warm_starts_ = 0;
+};
+
+// Thread-safe helper for a long-lived process that serves many solve requests,
+// typically from the CpSolver service, where the same model is often sent
+// again, for instance when a user re-runs an interactive solve.
+//
+// We remember the best solution found for the last max_num_models() distinct
+// models, keyed by FingerprintModel(), and use it as a hint the next time the
+// same model is solved without a hint. Each Solve() uses its own Model, so
+// concurrent requests with different parameters (numbers of workers, time
+// limits, ...) do not interfere with each other.
+//
+// Unlike IncrementalCpSolver, there is no notion of modifications here: the
+// fingerprint covers the full model including its objective.
+class CachingCpSolver {
+ public:
+  explicit CachingCpSolver(int max_num_models);
+
+  // This type is neither copyable nor movable.
+  CachingCpSolver(const CachingCpSolver&) = delete;
+  CachingCpSolver& operator=(const CachingCpSolver&) = delete;
+
+  int max_num_models() const { return max_num_models_; }
+
+  // Solves the given model with the given parameters, this can be called
+  // concurrently from many threads.
+  CpSolverResponse Solve(const CpModelProto& model_proto,
+                         const SatParameters& params);
+
+  // Returns the number of Solve() that used a cached solution as a hint.
+  int64_t num_cache_hits() const;
+
+ private:
+  // Returns the cached solution for the given fingerprint, or an empty vector.
+  std::vector<int64_t> GetCachedSolution(uint64_t fingerprint);
+  void CacheSolution(uint64_t fingerprint, std::vector<int64_t> solution);
+
+  const int max_num_models_;
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<uint64_t, std::vector<int64_t>> solutions_
+      ABSL_GUARDED_BY(mutex_);
+
+  // The fingerprints in solutions_ by insertion order, the oldest one is
+  // evicted first.
+  std::deque<uint64_t> fingerprints_ ABSL_GUARDED_BY(mutex_);
+  int64_t num_cache_hits_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace sat
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_SAT_CP_MODEL_INCREMENTAL_H_
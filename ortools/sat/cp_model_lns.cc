@@ -1007,6 +1007,15 @@ std::vector<std::vector<int>> NeighborhoodGeneratorHelper::GetRoutingPaths(
 Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
     const CpSolverResponse& base_solution,
     const absl::flat_hash_set<int>& variables_to_fix) const {
+  std::vector<bool> is_fixed(model_proto_.variables_size(), false);
+  for (const int var : variables_to_fix) is_fixed[var] = true;
+  return FixMarkedVariables(base_solution, is_fixed,
+                            /*is_reduced=*/!variables_to_fix.empty());
+}
+
+Neighborhood NeighborhoodGeneratorHelper::FixMarkedVariables(
+    const CpSolverResponse& base_solution, const std::vector<bool>& is_fixed,
+    bool is_reduced) const {
   Neighborhood neighborhood;
 
   // TODO(user): Maybe relax all variables in the objective when the number
@@ -1034,7 +1043,7 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
       const Domain domain = ReadDomainFromProto(current_var);
       const int64_t base_value = base_solution.solution(i);
 
-      if (variables_to_fix.contains(i) && i != unique_objective_variable) {
+      if (is_fixed[i] && i != unique_objective_variable) {
         if (domain.Contains(base_value)) {
           new_var->add_domain(base_value);
           new_var->add_domain(base_value);
@@ -1104,7 +1113,7 @@ Neighborhood NeighborhoodGeneratorHelper::FixGivenVariables(
   AddSolutionHinting(base_solution, &neighborhood.delta);
 
   neighborhood.is_generated = true;
-  neighborhood.is_reduced = !variables_to_fix.empty();
+  neighborhood.is_reduced = is_reduced;
   neighborhood.is_simple = true;
 
   // TODO(user): force better objective? Note that this is already done when the
@@ -1135,26 +1144,34 @@ void NeighborhoodGeneratorHelper::AddSolutionHinting(
 Neighborhood NeighborhoodGeneratorHelper::RelaxGivenVariables(
     const CpSolverResponse& initial_solution,
     const std::vector<int>& relaxed_variables) const {
-  std::vector<bool> relaxed_variables_set(model_proto_.variables_size(), false);
-  for (const int var : relaxed_variables) relaxed_variables_set[var] = true;
-  absl::flat_hash_set<int> fixed_variables;
+  // Note that we do not build a set of the fixed variables since it can
+  // contain almost all the variables of a large model.
+  std::vector<bool> is_fixed(model_proto_.variables_size(), false);
+  bool is_reduced = false;
   {
     absl::ReaderMutexLock graph_lock(&graph_mutex_);
+    for (const int i : active_variables_) is_fixed[i] = true;
+    for (const int var : relaxed_variables) is_fixed[var] = false;
     for (const int i : active_variables_) {
-      if (!relaxed_variables_set[i]) {
-        fixed_variables.insert(i);
+      if (is_fixed[i]) {
+        is_reduced = true;
+        break;
       }
     }
   }
-  return FixGivenVariables(initial_solution, fixed_variables);
+  return FixMarkedVariables(initial_solution, is_fixed, is_reduced);
 }
 
 Neighborhood NeighborhoodGeneratorHelper::FixAllVariables(
     const CpSolverResponse& initial_solution) const {
-  const std::vector<int>& all_variables = ActiveVariables();
-  const absl::flat_hash_set<int> fixed_variables(all_variables.begin(),
-                                                 all_variables.end());
-  return FixGivenVariables(initial_solution, fixed_variables);
+  std::vector<bool> is_fixed(model_proto_.variables_size(), false);
+  bool is_reduced = false;
+  {
+    absl::ReaderMutexLock graph_lock(&graph_mutex_);
+    for (const int i : active_variables_) is_fixed[i] = true;
+    is_reduced = !active_variables_.empty();
+  }
+  return FixMarkedVariables(initial_solution, is_fixed, is_reduced);
 }
 
 CpModelProto NeighborhoodGeneratorHelper::UpdatedModelProtoCopy() const {
@@ -273,6 +273,12 @@ class NeighborhoodGeneratorHelper : public SubSolver {
   // domains of the variables are updated.
   void RecomputeHelperData();
 
+  // Same as FixGivenVariables() but with the variables to fix given by
+  // is_fixed[var]. is_reduced is the value of Neighborhood::is_reduced.
+  Neighborhood FixMarkedVariables(const CpSolverResponse& base_solution,
+                                  const std::vector<bool>& is_fixed,
+                                  bool is_reduced) const;
+
   // Indicates if a variable is fixed in the model.
   bool IsConstant(int var) const ABSL_SHARED_LOCKS_REQUIRED(domain_mutex_);
 
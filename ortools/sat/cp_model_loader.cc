@@ -56,6 +56,7 @@
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/symmetry.h"
+#include "ortools/sat/table.h"
 #include "ortools/sat/timetable.h"
 #include "ortools/sat/util.h"
 #include "ortools/util/logging.h"
@@ -808,6 +809,9 @@ void ExtractElementEncoding(const CpModelProto& model_proto, Model* m) {
     }
   }
 
+  // The implied values are not used after this point.
+  implied_bounds->ClearImpliedValues();
+
   if (num_element_encoded > 0) {
     SOLVER_LOG(logger,
                "[Encoding] num_element_encoding: ", num_element_encoded);
@@ -1514,6 +1518,32 @@ void LoadAllDiffConstraint(const ConstraintProto& ct, Model* m) {
   m->Add(AllDifferentOnBounds(expressions));
 }
 
+void LoadTableConstraint(const ConstraintProto& ct, Model* m) {
+  auto* mapping = m->GetOrCreate<CpModelMapping>();
+  const std::vector<IntegerVariable> vars =
+      mapping->Integers(ct.table().vars());
+  if (vars.empty()) return;
+
+  CompactTablePropagator* constraint =
+      new CompactTablePropagator(vars, ct.table().values(), m);
+  constraint->RegisterWith(m->GetOrCreate<GenericLiteralWatcher>());
+  m->TakeOwnership(constraint);
+}
+
+void LoadAutomatonConstraint(const ConstraintProto& ct, Model* m) {
+  auto* mapping = m->GetOrCreate<CpModelMapping>();
+  const AutomatonConstraintProto& automaton = ct.automaton();
+  const std::vector<IntegerVariable> vars = mapping->Integers(automaton.vars());
+  if (vars.empty()) return;
+
+  AutomatonPropagator* constraint = new AutomatonPropagator(
+      vars, automaton.starting_state(), automaton.final_states(),
+      automaton.transition_tail(), automaton.transition_label(),
+      automaton.transition_head(), m);
+  constraint->RegisterWith(m->GetOrCreate<GenericLiteralWatcher>());
+  m->TakeOwnership(constraint);
+}
+
 void LoadIntProdConstraint(const ConstraintProto& ct, Model* m) {
   auto* mapping = m->GetOrCreate<CpModelMapping>();
   const AffineExpression prod = mapping->Affine(ct.int_prod().target());
@@ -1695,6 +1725,16 @@ bool LoadConstraint(const ConstraintProto& ct, Model* m) {
     case ConstraintProto::ConstraintProto::kAllDiff:
       LoadAllDiffConstraint(ct, m);
       return true;
+    case ConstraintProto::ConstraintProto::kTable:
+      // Only the large positive tables are not expanded.
+      if (ct.table().negated() || HasEnforcementLiteral(ct)) return false;
+      LoadTableConstraint(ct, m);
+      return true;
+    case ConstraintProto::ConstraintProto::kAutomaton:
+      // Only the large automata are not expanded.
+      if (HasEnforcementLiteral(ct)) return false;
+      LoadAutomatonConstraint(ct, m);
+      return true;
     case ConstraintProto::ConstraintProto::kIntProd:
       LoadIntProdConstraint(ct, m);
       return true;
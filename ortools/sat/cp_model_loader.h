@@ -96,6 +96,8 @@ void LoadExactlyOneConstraint(const ConstraintProto& ct, Model* m);
 void LoadBoolXorConstraint(const ConstraintProto& ct, Model* m);
 void LoadLinearConstraint(const ConstraintProto& ct, Model* m);
 void LoadAllDiffConstraint(const ConstraintProto& ct, Model* m);
+void LoadTableConstraint(const ConstraintProto& ct, Model* m);
+void LoadAutomatonConstraint(const ConstraintProto& ct, Model* m);
 void LoadIntProdConstraint(const ConstraintProto& ct, Model* m);
 void LoadIntDivConstraint(const ConstraintProto& ct, Model* m);
 void LoadIntMinConstraint(const ConstraintProto& ct, Model* m);
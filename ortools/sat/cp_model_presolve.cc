@@ -48,6 +48,9 @@
 #include "ortools/base/protobuf_util.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/base/timer.h"
 #include "ortools/graph/strongly_connected_components.h"
 #include "ortools/graph/topologicalsorter.h"
@@ -8795,7 +8798,9 @@ void CpModelPresolver::DetectDuplicateConstraints() {
   // TODO(user): We might want to do that earlier so that our count of variable
   // usage is not biased by duplicate constraints.
   const std::vector<std::pair<int, int>> duplicates =
-      FindDuplicateConstraints(*context_->working_model);
+      FindDuplicateConstraints(*context_->working_model,
+                               /*ignore_enforcement=*/false,
+                               context_->params().presolve_num_threads());
   timer.AddCounter("duplicates", duplicates.size());
   for (const auto& [dup, rep] : duplicates) {
     // Note that it is important to look at the type of the representative in
@@ -8882,7 +8887,9 @@ void CpModelPresolver::DetectDuplicateConstraintsWithDifferentEnforcements(
   // cte and expr + Y = other_cte, we can see that X is in affine relation with
   // Y.
   const std::vector<std::pair<int, int>> duplicates_without_enforcement =
-      FindDuplicateConstraints(*context_->working_model, true);
+      FindDuplicateConstraints(*context_->working_model,
+                               /*ignore_enforcement=*/true,
+                               context_->params().presolve_num_threads());
   timer.AddCounter("without_enforcements",
                    duplicates_without_enforcement.size());
   for (const auto& [dup, rep] : duplicates_without_enforcement) {
@@ -11043,7 +11050,7 @@ void CpModelPresolver::MaybeTransferLinear1ToAnotherVariable(int var) {
         var_domain.IntersectionWith(ReadDomainFromProto(ct->linear()));
     auto [new_var, new_domain] = transfer_f(implied);
     const Domain current = context_->DomainOf(new_var);
-    new_domain = new_domain.IntersectionWith(current);
+    new_domain.IntersectInPlace(current);
     if (new_domain.IsEmpty()) {
       if (!MarkConstraintAsFalse(ct)) return;
     } else if (new_domain == current) {
@@ -13180,17 +13187,30 @@ struct ConstraintHashForDuplicateDetection {
   bool ignore_enforcement;
   ConstraintProto objective_constraint;
 
-  ConstraintHashForDuplicateDetection(const CpModelProto* working_model,
-                                      bool ignore_enforcement)
+  // If not null, precomputed_hashes[c] must be equal to Hash(c) and will be
+  // used instead of recomputing it.
+  const std::vector<size_t>* precomputed_hashes;
+
+  ConstraintHashForDuplicateDetection(
+      const CpModelProto* working_model, bool ignore_enforcement,
+      const std::vector<size_t>* precomputed_hashes = nullptr)
       : working_model(working_model),
         ignore_enforcement(ignore_enforcement),
         objective_constraint(
-            CopyObjectiveForDuplicateDetection(working_model->objective())) {}
+            CopyObjectiveForDuplicateDetection(working_model->objective())),
+        precomputed_hashes(precomputed_hashes) {}
+
+  std::size_t operator()(int ct_idx) const {
+    if (precomputed_hashes != nullptr && ct_idx != kObjectiveConstraint) {
+      return (*precomputed_hashes)[ct_idx];
+    }
+    return Hash(ct_idx);
+  }
 
   // We hash our mostly frequently used constraint directly without extra memory
   // allocation. We revert to a generic code using proto serialization for the
   // others.
-  std::size_t operator()(int ct_idx) const {
+  std::size_t Hash(int ct_idx) const {
     const ConstraintProto& ct = ct_idx == kObjectiveConstraint
                                     ? objective_constraint
                                     : working_model->constraints(ct_idx);
@@ -13308,16 +13328,47 @@ struct ConstraintEqForDuplicateDetection {
 }  // namespace
 
 std::vector<std::pair<int, int>> FindDuplicateConstraints(
-    const CpModelProto& model_proto, bool ignore_enforcement) {
+    const CpModelProto& model_proto, bool ignore_enforcement,
+    int num_threads) {
   std::vector<std::pair<int, int>> result;
+  const int num_constraints = model_proto.constraints().size();
+
+  // Hashing the constraints is the most costly part on large models, and it is
+  // independent for each constraint, so we can do it in parallel. The map
+  // insertion below stays sequential so that the result is deterministic.
+  std::vector<size_t> precomputed_hashes;
+#if !defined(__PORTABLE_PLATFORM__)
+  constexpr int kMinConstraintsPerThread = 10'000;
+  num_threads =
+      std::min(num_threads, num_constraints / kMinConstraintsPerThread);
+  if (num_threads > 1) {
+    const ConstraintHashForDuplicateDetection hasher(&model_proto,
+                                                     ignore_enforcement);
+    precomputed_hashes.resize(num_constraints);
+    const int chunk_size = (num_constraints + num_threads - 1) / num_threads;
+    ThreadPool pool(num_threads);
+    pool.StartWorkers();
+    for (int begin = 0; begin < num_constraints; begin += chunk_size) {
+      const int end = std::min(begin + chunk_size, num_constraints);
+      pool.Schedule([&hasher, &precomputed_hashes, begin, end]() {
+        for (int c = begin; c < end; ++c) {
+          precomputed_hashes[c] = hasher.Hash(c);
+        }
+      });
+    }
+    // The pool destructor waits for all the tasks to be done.
+  }
+#endif  // __PORTABLE_PLATFORM__
 
   // We use a map hash that uses the underlying constraint to compute the hash
   // and the equality for the indices.
   absl::flat_hash_map<int, int, ConstraintHashForDuplicateDetection,
                       ConstraintEqForDuplicateDetection>
       equiv_constraints(
-          model_proto.constraints_size(),
-          ConstraintHashForDuplicateDetection{&model_proto, ignore_enforcement},
+          num_constraints,
+          ConstraintHashForDuplicateDetection{
+              &model_proto, ignore_enforcement,
+              precomputed_hashes.empty() ? nullptr : &precomputed_hashes},
           ConstraintEqForDuplicateDetection{&model_proto, ignore_enforcement});
 
   // Create a special representative for the linear objective.
@@ -13325,7 +13376,6 @@ std::vector<std::pair<int, int>> FindDuplicateConstraints(
     equiv_constraints[kObjectiveConstraint] = kObjectiveConstraint;
   }
 
-  const int num_constraints = model_proto.constraints().size();
   for (int c = 0; c < num_constraints; ++c) {
     const auto type = model_proto.constraints(c).constraint_case();
     if (type == ConstraintProto::CONSTRAINT_NOT_SET) continue;
@@ -500,10 +500,14 @@ CpSolverStatus PresolveCpModel(PresolveContext* context,
 // - enforced constraint duplicate of non-enforced one.
 // - Two enforced constraints with singleton enforcement (vpphard).
 //
+// If num_threads > 1, the constraints of large models are hashed in parallel.
+// The result does not depend on the number of threads.
+//
 // Visible here for testing. This is meant to be called at the end of the
 // presolve where constraints have been canonicalized.
 std::vector<std::pair<int, int>> FindDuplicateConstraints(
-    const CpModelProto& model_proto, bool ignore_enforcement = false);
+    const CpModelProto& model_proto, bool ignore_enforcement = false,
+    int num_threads = 1);
 
 }  // namespace sat
 }  // namespace operations_research
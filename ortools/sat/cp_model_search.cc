@@ -158,6 +158,7 @@ void AddDualSchedulingHeuristics(SatParameters& new_params) {
   new_params.set_use_overload_checker_in_cumulative(true);
   new_params.set_use_strong_propagation_in_disjunctive(true);
   new_params.set_use_timetable_edge_finding_in_cumulative(true);
+  new_params.set_use_edge_finding_in_cumulative(true);
   new_params.set_max_pairs_pairwise_reasoning_in_no_overlap_2d(5000);
   new_params.set_use_timetabling_in_no_overlap_2d(true);
   new_params.set_use_energetic_reasoning_in_no_overlap_2d(true);
@@ -918,6 +919,20 @@ std::vector<SatParameters> GetFullWorkerParameters(
   if (result.size() > num_to_keep) {
     result.resize(std::max(0, num_to_keep));
   }
+
+  // Let each probing worker start on a different part of the model.
+  int num_probing_workers = 0;
+  for (const SatParameters& params : result) {
+    if (params.use_probing_search()) ++num_probing_workers;
+  }
+  if (num_probing_workers > 1) {
+    int index = 0;
+    for (SatParameters& params : result) {
+      if (!params.use_probing_search()) continue;
+      params.set_probing_worker_index(index++);
+      params.set_num_probing_workers(num_probing_workers);
+    }
+  }
   return result;
 }
 
@@ -700,6 +700,14 @@ void LogFinalStatistics(SharedClasses* shared) {
     shared->clauses->LogStatistics(shared->logger);
   }
 
+  if (shared->cuts) {
+    shared->cuts->LogStatistics(shared->logger);
+  }
+
+  if (shared->pseudo_costs) {
+    shared->pseudo_costs->LogStatistics(shared->logger);
+  }
+
   // Extra logging if needed. Note that these are mainly activated on
   // --vmodule *some_file*=1 and are here for development.
   shared->stats->Log(shared->logger);
@@ -735,9 +743,11 @@ void LaunchSubsolvers(const SatParameters& params, SharedClasses* shared,
           batch_size);
     }
     DeterministicLoop(subsolvers, params.num_workers(), batch_size,
-                      params.max_num_deterministic_batches());
+                      params.max_num_deterministic_batches(),
+                      params.numa_aware_worker_placement());
   } else {
-    NonDeterministicLoop(subsolvers, params.num_workers());
+    NonDeterministicLoop(subsolvers, params.num_workers(),
+                         params.numa_aware_worker_placement());
   }
 
   // We need to delete the subsolvers in order to fill the stat tables. Note
@@ -789,6 +799,11 @@ class FullProblemSolver : public SubSolver {
       local_model_.Register<SharedBoundsManager>(shared->bounds.get());
     }
 
+    if (shared->lb_tree_search_bounds != nullptr) {
+      local_model_.Register<SharedLbTreeSearchBounds>(
+          shared->lb_tree_search_bounds.get());
+    }
+
     if (shared->clauses != nullptr) {
       local_model_.Register<SharedClausesManager>(shared->clauses.get());
     }
@@ -817,6 +832,7 @@ class FullProblemSolver : public SubSolver {
     shared_->stat_tables.AddLpStat(name(), &local_model_);
     shared_->stat_tables.AddSearchStat(name(), &local_model_);
     shared_->stat_tables.AddClausesStat(name(), &local_model_);
+    shared_->stat_tables.AddPropagatorStat(&local_model_);
   }
 
   bool IsDone() override {
@@ -876,6 +892,19 @@ class FullProblemSolver : public SubSolver {
           RegisterClausesExport(id, shared_->clauses.get(), &local_model_);
         }
 
+        if (shared_->cuts != nullptr) {
+          const int id = shared_->cuts->RegisterNewId();
+          shared_->cuts->SetWorkerNameForId(id, local_model_.Name());
+          RegisterCutsSharing(id, shared_->cuts.get(), &local_model_);
+        }
+
+        if (shared_->pseudo_costs != nullptr) {
+          const int id = shared_->pseudo_costs->RegisterNewId();
+          shared_->pseudo_costs->SetWorkerNameForId(id, local_model_.Name());
+          RegisterPseudoCostsSharing(id, shared_->pseudo_costs.get(),
+                                     &local_model_);
+        }
+
         auto* logger = local_model_.GetOrCreate<SolverLogger>();
         SOLVER_LOG(logger, "");
         SOLVER_LOG(logger, absl::StrFormat(
@@ -1082,6 +1111,14 @@ class LnsSolver : public SubSolver {
     return generator_->ReadyToGenerate();
   }
 
+  bool UseSelectionScore() const override {
+    return lns_parameters_.use_lns_bandit_scheduling();
+  }
+
+  double GetSelectionScore(int64_t total_num_tasks) const override {
+    return generator_->GetUCBScore(total_num_tasks);
+  }
+
   std::function<void()> GenerateTask(int64_t task_id) override {
     return [task_id, this]() {
       if (shared_->SearchIsDone()) return;
@@ -1137,6 +1174,15 @@ class LnsSolver : public SubSolver {
       SatParameters local_params(lns_parameters_);
       local_params.set_max_deterministic_time(data.deterministic_limit);
 
+      // When only a few variables are relaxed, the fragment is small once
+      // copied and we do not want to spend more time in the presolve than in
+      // the actual solve, so we only do one presolve iteration.
+      //
+      // TODO(user): Tune the threshold.
+      if (neighborhood.is_simple && neighborhood.num_relaxed_variables <= 100) {
+        local_params.set_max_presolve_iterations(1);
+      }
+
       // TODO(user): Tune these.
       // TODO(user): This could be a good candidate for bandits.
       const int64_t stall = generator_->num_consecutive_non_improving_calls();
@@ -1902,10 +1948,12 @@ bool VarIsFixed(const CpModelProto& model_proto, int i) {
              model_proto.variables(i).domain(1);
 }
 
-void TestSolutionHintForFeasibility(const CpModelProto& model_proto,
+// Returns true if the hint is complete and in the variable domains, but
+// infeasible.
+bool TestSolutionHintForFeasibility(const CpModelProto& model_proto,
                                     SolverLogger* logger,
                                     SharedResponseManager* manager = nullptr) {
-  if (!model_proto.has_solution_hint()) return;
+  if (!model_proto.has_solution_hint()) return false;
 
   int num_active_variables = 0;
   int num_hinted_variables = 0;
@@ -1925,7 +1973,7 @@ void TestSolutionHintForFeasibility(const CpModelProto& model_proto,
     SOLVER_LOG(
         logger, "The solution hint is incomplete: ", num_hinted_variables,
         " out of ", num_active_variables, " non fixed variables hinted.");
-    return;
+    return false;
   }
 
   std::vector<int64_t> solution(model_proto.variables_size(), 0);
@@ -1946,7 +1994,7 @@ void TestSolutionHintForFeasibility(const CpModelProto& model_proto,
       SOLVER_LOG(logger,
                  "The solution hint is complete but it contains values outside "
                  "of the domain of the variables.");
-      return;
+      return false;
     }
     solution[var] = hinted_value;
   }
@@ -1965,6 +2013,97 @@ void TestSolutionHintForFeasibility(const CpModelProto& model_proto,
     SOLVER_LOG(logger,
                "The solution hint is complete, but it is infeasible! we "
                "will try to repair it.");
+    return true;
+  }
+  return false;
+}
+
+// Tries to repair a complete but infeasible hint before the presolve by
+// solving the model where all the variables that do not appear in a violated
+// constraint are fixed to their hinted value. If this works, we replace the
+// hint of `working_model`, which has the same variables as `model_proto`, so
+// that the repaired solution is loaded right after the presolve.
+void RepairSolutionHintBeforePresolve(const CpModelProto& model_proto,
+                                      const SatParameters& params,
+                                      TimeLimit* time_limit,
+                                      SolverLogger* logger,
+                                      CpModelProto* working_model) {
+  const int num_vars = model_proto.variables_size();
+  std::vector<int64_t> solution(num_vars, 0);
+  for (int var = 0; var < num_vars; ++var) {
+    if (VarIsFixed(model_proto, var)) {
+      solution[var] = model_proto.variables(var).domain(0);
+    }
+  }
+  for (int i = 0; i < model_proto.solution_hint().vars_size(); ++i) {
+    const int ref = model_proto.solution_hint().vars(i);
+    const int64_t value = model_proto.solution_hint().values(i);
+    solution[PositiveRef(ref)] = RefIsPositive(ref) ? value : -value;
+  }
+
+  // Free all the variables of the violated constraints, including the ones
+  // of the intervals they use.
+  std::vector<bool> is_free(num_vars, false);
+  int num_violated_constraints = 0;
+  for (const ConstraintProto& ct : model_proto.constraints()) {
+    if (ConstraintIsFeasible(model_proto, ct, solution)) continue;
+    ++num_violated_constraints;
+    for (const int var : UsedVariables(ct)) is_free[var] = true;
+    for (const int interval : UsedIntervals(ct)) {
+      for (const int var : UsedVariables(model_proto.constraints(interval))) {
+        is_free[var] = true;
+      }
+    }
+  }
+  if (num_violated_constraints == 0) return;
+
+  CpModelProto neighborhood = model_proto;
+  neighborhood.clear_objective();
+  neighborhood.clear_floating_point_objective();
+  neighborhood.clear_solution_hint();
+  int num_free_vars = 0;
+  for (int var = 0; var < num_vars; ++var) {
+    neighborhood.mutable_solution_hint()->add_vars(var);
+    neighborhood.mutable_solution_hint()->add_values(solution[var]);
+    if (is_free[var]) {
+      ++num_free_vars;
+    } else {
+      FillDomainInProto(Domain(solution[var]),
+                        neighborhood.mutable_variables(var));
+    }
+  }
+
+  SatParameters local_params = params;
+  local_params.set_hint_repair_deterministic_time(0.0);
+  local_params.set_max_deterministic_time(
+      std::min(params.max_deterministic_time(),
+               params.hint_repair_deterministic_time()));
+  local_params.set_max_time_in_seconds(time_limit->GetTimeLeft());
+  local_params.set_num_workers(1);
+  local_params.set_stop_after_first_solution(true);
+  local_params.set_enumerate_all_solutions(false);
+  local_params.set_fix_variables_to_their_hinted_value(false);
+  local_params.set_log_search_progress(false);
+  local_params.set_catch_sigint_signal(false);
+  Model local_model("hint_repair");
+  local_model.Add(NewSatParameters(local_params));
+  const CpSolverResponse response = SolveCpModel(neighborhood, &local_model);
+  time_limit->AdvanceDeterministicTime(response.deterministic_time());
+
+  const bool repaired = (response.status() == CpSolverStatus::OPTIMAL ||
+                         response.status() == CpSolverStatus::FEASIBLE) &&
+                        SolutionIsFeasible(model_proto, response.solution());
+  SOLVER_LOG(logger, "[Hint] ", repaired ? "Repaired" : "Could not repair",
+             " the hint with ", num_free_vars, "/", num_vars,
+             " free variables from ", num_violated_constraints,
+             " violated constraints. dtime: ", response.deterministic_time());
+  if (!repaired) return;
+
+  PartialVariableAssignment* hint = working_model->mutable_solution_hint();
+  hint->Clear();
+  for (int var = 0; var < num_vars; ++var) {
+    hint->add_vars(var);
+    hint->add_values(response.solution(var));
   }
 }
 
@@ -2056,6 +2195,7 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
   SolverLogger* logger = model->GetOrCreate<SolverLogger>();
   logger->EnableLogging(params.log_search_progress());
   logger->SetLogToStdOut(params.log_to_stdout());
+  logger->SetAsynchronousOutput(params.log_asynchronously());
   std::string log_string;
   if (params.log_to_response()) {
     logger->AddInfoLoggingCallback([&log_string](absl::string_view message) {
@@ -2090,6 +2230,9 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
                                *response,
                                model_proto.has_objective() ||
                                    model_proto.has_floating_point_objective()));
+        // Processes the pending logs, and logs synchronously from now on as
+        // log_string is about to be destroyed.
+        logger->SetAsynchronousOutput(false);
         if (!log_string.empty()) {
           response->set_solve_log(log_string);
         }
@@ -2241,7 +2384,14 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
   // are do duplicate variables in the solution hint, so we can just check the
   // size.
   if (!context->ModelIsUnsat()) {
-    TestSolutionHintForFeasibility(model_proto, logger);
+    const bool hint_is_infeasible =
+        TestSolutionHintForFeasibility(model_proto, logger);
+    if (hint_is_infeasible && params.hint_repair_deterministic_time() > 0.0 &&
+        !absl::GetFlag(FLAGS_cp_model_ignore_hints)) {
+      RepairSolutionHintBeforePresolve(model_proto, params,
+                                       model->GetOrCreate<TimeLimit>(), logger,
+                                       context->working_model);
+    }
   }
 
   // If the objective was a floating point one, do some postprocessing on the
@@ -2411,9 +2561,12 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
       // We pass presolve data for more informative message in case the solution
       // is not feasible.
       CHECK(SolutionIsFeasible(model_proto, response->solution(), mapping_proto,
-                               &postsolve_mapping));
+                               &postsolve_mapping, params.num_workers()));
     } else {
-      CHECK(SolutionIsFeasible(model_proto, response->solution()));
+      CHECK(SolutionIsFeasible(model_proto, response->solution(),
+                               /*mapping_proto=*/nullptr,
+                               /*postsolve_mapping=*/nullptr,
+                               params.num_workers()));
     }
   };
   if (DEBUG_MODE ||
@@ -2542,7 +2695,8 @@ CpSolverResponse SolveCpModel(const CpModelProto& model_proto, Model* model) {
   }
 
   if (params.symmetry_level() > 1) {
-    DetectAndAddSymmetryToProto(params, new_cp_model_proto, logger);
+    DetectAndAddSymmetryToProto(params, new_cp_model_proto,
+                                model->GetOrCreate<TimeLimit>(), logger);
   }
 
   LoadDebugSolution(*new_cp_model_proto, model);
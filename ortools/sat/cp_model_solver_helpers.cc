@@ -32,6 +32,7 @@
 #include "ortools/base/options.h"
 #endif  // __PORTABLE_PLATFORM__
 #include "absl/cleanup/cleanup.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
@@ -69,6 +70,7 @@
 #include "ortools/sat/optimization.h"
 #include "ortools/sat/precedences.h"
 #include "ortools/sat/probing.h"
+#include "ortools/sat/pseudo_costs.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
@@ -811,7 +813,9 @@ void RegisterObjectiveBoundsImport(
 void RegisterClausesExport(int id, SharedClausesManager* shared_clauses_manager,
                            Model* model) {
   auto* mapping = model->GetOrCreate<CpModelMapping>();
-  const auto& share_binary_clause = [mapping, id, shared_clauses_manager](
+  auto* binary_clause_buffer =
+      shared_clauses_manager->GetBinaryClauseBuffer(id);
+  const auto& share_binary_clause = [mapping, binary_clause_buffer](
                                         Literal l1, Literal l2) {
     const int var1 =
         mapping->GetProtoVariableFromBooleanVariable(l1.Variable());
@@ -821,7 +825,7 @@ void RegisterClausesExport(int id, SharedClausesManager* shared_clauses_manager,
     if (var2 == -1) return;
     const int lit1 = l1.IsPositive() ? var1 : NegatedRef(var1);
     const int lit2 = l2.IsPositive() ? var2 : NegatedRef(var2);
-    shared_clauses_manager->AddBinaryClause(id, lit1, lit2);
+    binary_clause_buffer->Add(lit1, lit2);
   };
   model->GetOrCreate<BinaryImplicationGraph>()->SetAdditionCallback(
       share_binary_clause);
@@ -913,6 +917,111 @@ int RegisterClausesLevelZeroImport(int id,
   return id;
 }
 
+void RegisterCutsSharing(int id, SharedCutPool* shared_cut_pool,
+                         Model* model) {
+  CHECK(shared_cut_pool != nullptr);
+  const auto& lps =
+      *model->GetOrCreate<LinearProgrammingConstraintCollection>();
+  if (lps.empty()) return;
+
+  auto* mapping = model->GetOrCreate<CpModelMapping>();
+  auto* dispatcher = model->GetOrCreate<LinearProgrammingDispatcher>();
+  const double min_efficacy =
+      model->GetOrCreate<SatParameters>()->share_linear_cuts_min_efficacy();
+  constexpr absl::string_view kSharedCutName = "Shared";
+
+  // Export the efficacious cuts that only use variables of the model proto.
+  const auto export_cut = [shared_cut_pool, id, mapping, min_efficacy,
+                           kSharedCutName,
+                           terms = std::vector<std::pair<int, int64_t>>(),
+                           vars = std::vector<int>(),
+                           coeffs = std::vector<int64_t>()](
+                              const LinearConstraint& cut,
+                              absl::string_view type_name,
+                              double efficacy) mutable {
+    if (efficacy < min_efficacy || type_name == kSharedCutName) return;
+    terms.clear();
+    for (int i = 0; i < cut.num_terms; ++i) {
+      const int var = mapping->GetProtoVariableFromIntegerVariable(cut.vars[i]);
+      if (var == -1) return;
+      terms.push_back({var, cut.coeffs[i].value()});
+    }
+    std::sort(terms.begin(), terms.end());
+    vars.clear();
+    coeffs.clear();
+    for (const auto [var, coeff] : terms) {
+      vars.push_back(var);
+      coeffs.push_back(coeff);
+    }
+    shared_cut_pool->AddCut(id, vars, coeffs, cut.lb.value(), cut.ub.value());
+  };
+
+  // The cuts imported from the pool are dispatched to the LP containing all
+  // their variables, and this LP only adds them if they are violated by its
+  // current solution. Note that all the LPs of a worker share the same id.
+  struct ImportedCuts {
+    absl::flat_hash_map<const LinearProgrammingConstraint*,
+                        std::vector<LinearConstraint>>
+        lp_to_cuts;
+    std::vector<SharedCutPool::Cut> new_cuts;
+  };
+  auto imported_cuts = std::make_shared<ImportedCuts>();
+  for (LinearProgrammingConstraint* lp : lps) {
+    lp->SetNewCutCallback(export_cut);
+
+    CutGenerator generator;
+    generator.only_run_at_level_zero = true;
+    generator.generate_cuts = [shared_cut_pool, id, mapping, dispatcher, lp,
+                               kSharedCutName, imported_cuts](
+                                  LinearConstraintManager* manager) {
+      imported_cuts->new_cuts.clear();
+      shared_cut_pool->GetUnseenCuts(id, &imported_cuts->new_cuts);
+      for (const SharedCutPool::Cut& shared_cut : imported_cuts->new_cuts) {
+        const int num_terms = shared_cut.vars.size();
+        LinearConstraint cut;
+        cut.resize(num_terms);
+        cut.lb = IntegerValue(shared_cut.lb);
+        cut.ub = IntegerValue(shared_cut.ub);
+        const LinearProgrammingConstraint* cut_lp = nullptr;
+        int i = 0;
+        for (; i < num_terms; ++i) {
+          const int ref = shared_cut.vars[i];
+          if (!mapping->IsInteger(ref)) break;
+          const IntegerVariable var = mapping->Integer(ref);
+          const auto it = dispatcher->find(var);
+          if (it == dispatcher->end()) break;
+          if (cut_lp != nullptr && it->second != cut_lp) break;
+          cut_lp = it->second;
+          cut.vars[i] = var;
+          cut.coeffs[i] = IntegerValue(shared_cut.coeffs[i]);
+        }
+        if (i < num_terms || cut_lp == nullptr) continue;
+        imported_cuts->lp_to_cuts[cut_lp].push_back(std::move(cut));
+      }
+
+      const auto it = imported_cuts->lp_to_cuts.find(lp);
+      if (it == imported_cuts->lp_to_cuts.end()) return true;
+      for (LinearConstraint& cut : it->second) {
+        manager->AddCut(std::move(cut), std::string(kSharedCutName));
+      }
+      it->second.clear();
+      return true;
+    };
+    lp->AddCutGenerator(std::move(generator));
+  }
+}
+
+void RegisterPseudoCostsSharing(int id, SharedPseudoCosts* shared_pseudo_costs,
+                                Model* model) {
+  auto* pseudo_costs = model->GetOrCreate<PseudoCosts>();
+  pseudo_costs->EnableSharing(id, shared_pseudo_costs);
+  model->GetOrCreate<LevelZeroCallbackHelper>()->callbacks.push_back(
+      [pseudo_costs]() {
+        pseudo_costs->SynchronizeWithSharedPseudoCosts();
+        return true;
+      });
+}
+
 void LoadBaseModel(const CpModelProto& model_proto, Model* model) {
   auto* shared_response_manager = model->GetOrCreate<SharedResponseManager>();
   CHECK(shared_response_manager != nullptr);
@@ -1807,6 +1916,18 @@ SharedClasses::SharedClasses(const CpModelProto* proto, Model* global_model)
     clauses = std::make_unique<SharedClausesManager>(always_synchronize,
                                                      absl::Seconds(1));
   }
+  if (params.share_linear_cuts() && params.num_workers() > 1) {
+    cuts = std::make_unique<SharedCutPool>(/*max_num_cuts=*/100'000);
+  }
+  if (params.share_pseudo_costs() && params.num_workers() > 1 &&
+      model_proto.has_objective()) {
+    pseudo_costs =
+        std::make_unique<SharedPseudoCosts>(model_proto.variables_size());
+  }
+  if (params.share_lb_tree_search_bounds() && params.num_workers() > 1 &&
+      model_proto.has_objective()) {
+    lb_tree_search_bounds = std::make_unique<SharedLbTreeSearchBounds>();
+  }
 }
 
 bool SharedClasses::SearchIsDone() {
@@ -63,6 +63,9 @@ struct SharedClasses {
   std::unique_ptr<SharedLPSolutionRepository> lp_solutions;
   std::unique_ptr<SharedIncompleteSolutionManager> incomplete_solutions;
   std::unique_ptr<SharedClausesManager> clauses;
+  std::unique_ptr<SharedCutPool> cuts;
+  std::unique_ptr<SharedPseudoCosts> pseudo_costs;
+  std::unique_ptr<SharedLbTreeSearchBounds> lb_tree_search_bounds;
 
   // For displaying summary at the end.
   SharedStatTables stat_tables;
@@ -121,6 +124,18 @@ int RegisterClausesLevelZeroImport(int id,
                                    SharedClausesManager* shared_clauses_manager,
                                    Model* model);
 
+// Registers the export of the good LP cuts to the shared_cut_pool and a cut
+// generator in each LP that imports the cuts found by the other workers. This
+// must be called after the model is loaded and should not be registered to a
+// LNS search.
+void RegisterCutsSharing(int id, SharedCutPool* shared_cut_pool, Model* model);
+
+// Registers the export and import of the pseudo costs of this worker at level
+// zero. This must be called after the model is loaded and should not be
+// registered to a LNS search.
+void RegisterPseudoCostsSharing(int id, SharedPseudoCosts* shared_pseudo_costs,
+                                Model* model);
+
 void PostsolveResponseWrapper(const SatParameters& params,
                               int num_variable_in_original_model,
                               const CpModelProto& mapping_proto,
@@ -644,7 +644,8 @@ std::unique_ptr<Graph> GenerateGraphForSymmetryDetection(
 void FindCpModelSymmetries(
     const SatParameters& params, const CpModelProto& problem,
     std::vector<std::unique_ptr<SparsePermutation>>* generators,
-    double deterministic_limit, SolverLogger* logger) {
+    double deterministic_limit, TimeLimit* global_time_limit,
+    SolverLogger* logger) {
   CHECK(generators != nullptr);
   generators->clear();
 
@@ -677,9 +678,11 @@ void FindCpModelSymmetries(
   }
 
   GraphSymmetryFinder symmetry_finder(*graph, /*is_undirected=*/false);
+  symmetry_finder.SetNumThreads(std::max(1, params.num_workers()));
   std::vector<int> factorized_automorphism_group_size;
   std::unique_ptr<TimeLimit> time_limit =
       TimeLimit::FromDeterministicTime(deterministic_limit);
+  time_limit->MergeWithGlobalTimeLimit(global_time_limit);
   const absl::Status status = symmetry_finder.FindSymmetries(
       &equivalence_classes, generators, &factorized_automorphism_group_size,
       time_limit.get());
@@ -740,13 +743,16 @@ void FindCpModelSymmetries(
 }
 
 void DetectAndAddSymmetryToProto(const SatParameters& params,
-                                 CpModelProto* proto, SolverLogger* logger) {
+                                 CpModelProto* proto,
+                                 TimeLimit* global_time_limit,
+                                 SolverLogger* logger) {
   SymmetryProto* symmetry = proto->mutable_symmetry();
   symmetry->Clear();
 
   std::vector<std::unique_ptr<SparsePermutation>> generators;
   FindCpModelSymmetries(params, *proto, &generators,
-                        /*deterministic_limit=*/1.0, logger);
+                        params.symmetry_detection_deterministic_time_limit(),
+                        global_time_limit, logger);
   if (generators.empty()) {
     proto->clear_symmetry();
     return;
@@ -933,7 +939,8 @@ bool DetectAndExploitSymmetriesInPresolve(PresolveContext* context) {
 
   std::vector<std::unique_ptr<SparsePermutation>> generators;
   FindCpModelSymmetries(params, proto, &generators,
-                        /*deterministic_limit=*/1.0, context->logger());
+                        params.symmetry_detection_deterministic_time_limit(),
+                        context->time_limit(), context->logger());
 
   // Remove temporary affine relation.
   context->working_model->mutable_constraints()->DeleteSubrange(
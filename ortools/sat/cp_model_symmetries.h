@@ -23,6 +23,7 @@
 #include "ortools/sat/presolve_context.h"
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/util/logging.h"
+#include "ortools/util/time_limit.h"
 
 namespace operations_research {
 namespace sat {
@@ -42,14 +43,21 @@ namespace sat {
 // TODO(user): As long as we only exploit symmetry involving only Boolean
 // variables we can make this code more efficient by not detecting symmetries
 // involing integer variable.
+//
+// The detection stops after deterministic_limit or when the given
+// global_time_limit is reached, if not null, in which case we only return the
+// generators found so far.
 void FindCpModelSymmetries(
     const SatParameters& params, const CpModelProto& problem,
     std::vector<std::unique_ptr<SparsePermutation>>* generators,
-    double deterministic_limit, SolverLogger* logger);
+    double deterministic_limit, TimeLimit* global_time_limit,
+    SolverLogger* logger);
 
 // Detects symmetries and fill the symmetry field.
 void DetectAndAddSymmetryToProto(const SatParameters& params,
-                                 CpModelProto* proto, SolverLogger* logger);
+                                 CpModelProto* proto,
+                                 TimeLimit* global_time_limit,
+                                 SolverLogger* logger);
 
 // Basic implementation of some symmetry breaking during presolve.
 //
@@ -266,6 +266,13 @@ std::function<void(Model*)> Cumulative(
       }
     }
 
+    // Propagator responsible for applying the Edge finding filtering rule. It
+    // increases the minimum of the start variables and decreases the maximum
+    // of the end variables.
+    if (parameters.use_edge_finding_in_cumulative()) {
+      AddCumulativeEdgeFinding(capacity, helper, demands_helper, model);
+    }
+
     // Propagator responsible for applying the Timetable Edge finding filtering
     // rule. It increases the minimum of the start variables and decreases the
     // maximum of the end variables,
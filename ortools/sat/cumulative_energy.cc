@@ -63,6 +63,16 @@ void AddCumulativeOverloadCheckerDff(AffineExpression capacity,
   model->TakeOwnership(constraint_dff);
 }
 
+void AddCumulativeEdgeFinding(AffineExpression capacity,
+                              SchedulingConstraintHelper* helper,
+                              SchedulingDemandHelper* demands, Model* model) {
+  auto* watcher = model->GetOrCreate<GenericLiteralWatcher>();
+  CumulativeEdgeFinding* constraint =
+      new CumulativeEdgeFinding(capacity, helper, demands, model);
+  constraint->RegisterWith(watcher);
+  model->TakeOwnership(constraint);
+}
+
 CumulativeEnergyConstraint::CumulativeEnergyConstraint(
     AffineExpression capacity, SchedulingConstraintHelper* helper,
     SchedulingDemandHelper* demands, Model* model)
@@ -237,6 +247,158 @@ bool CumulativeEnergyConstraint::Propagate() {
   return true;
 }
 
+CumulativeEdgeFinding::CumulativeEdgeFinding(
+    AffineExpression capacity, SchedulingConstraintHelper* helper,
+    SchedulingDemandHelper* demands, Model* model)
+    : capacity_(capacity),
+      integer_trail_(model->GetOrCreate<IntegerTrail>()),
+      helper_(helper),
+      demands_(demands) {
+  task_to_event_.resize(helper_->NumTasks());
+}
+
+void CumulativeEdgeFinding::RegisterWith(GenericLiteralWatcher* watcher) {
+  const int id = watcher->Register(this);
+  watcher->WatchUpperBound(capacity_, id);
+  helper_->WatchAllTasks(id, watcher);
+  for (const AffineExpression& demand : demands_->Demands()) {
+    watcher->WatchLowerBound(demand, id);
+  }
+  watcher->SetPropagatorPriority(id, 3);
+  watcher->NotifyThatPropagatorMayNotReachFixedPointInOnePass(id);
+}
+
+bool CumulativeEdgeFinding::Propagate() {
+  const IntegerValue capacity_max = integer_trail_->UpperBound(capacity_);
+  if (capacity_max <= 0) return true;
+
+  if (!helper_->SynchronizeAndSetTimeDirection(true)) return false;
+  demands_->CacheAllEnergyValues();
+  if (!PropagateInCurrentDirection(capacity_max)) return false;
+
+  if (!helper_->SynchronizeAndSetTimeDirection(false)) return false;
+  demands_->CacheAllEnergyValues();
+  return PropagateInCurrentDirection(capacity_max);
+}
+
+void CumulativeEdgeFinding::AddThetaReason(int first_event,
+                                           IntegerValue window_start,
+                                           IntegerValue window_end) {
+  for (int event = first_event; event < event_task_time_.size(); ++event) {
+    if (!event_is_in_theta_[event]) continue;
+    const int task = event_task_time_[event].task_index;
+    helper_->AddPresenceReason(task);
+    demands_->AddEnergyMinReason(task);
+    helper_->AddStartMinReason(task, window_start);
+    helper_->AddEndMaxReason(task, window_end);
+  }
+  if (capacity_.var != kNoIntegerVariable) {
+    helper_->MutableIntegerReason()->push_back(
+        integer_trail_->UpperBoundAsLiteral(capacity_.var));
+  }
+}
+
+bool CumulativeEdgeFinding::PropagateInCurrentDirection(
+    IntegerValue capacity_max) {
+  // Only the present tasks with some energy are considered. They all start in
+  // theta.
+  event_task_time_.clear();
+  int num_events = 0;
+  for (const TaskTime task_time : helper_->TaskByIncreasingStartMin()) {
+    const int task = task_time.task_index;
+    if (!helper_->IsPresent(task) || demands_->EnergyMin(task) == 0) {
+      task_to_event_[task] = -1;
+      continue;
+    }
+    event_task_time_.push_back(task_time);
+    task_to_event_[task] = num_events;
+    num_events++;
+  }
+  if (num_events <= 1) return true;
+
+  theta_tree_.Reset(num_events);
+  event_is_in_theta_.assign(num_events, true);
+  for (int event = 0; event < num_events; ++event) {
+    const IntegerValue energy_min =
+        demands_->EnergyMin(event_task_time_[event].task_index);
+    theta_tree_.DelayedAddOrUpdateEvent(
+        event, event_task_time_[event].time * capacity_max, energy_min,
+        energy_min);
+  }
+  theta_tree_.RecomputeTreeForDelayedOperations();
+
+  // Main loop: theta contains the tasks with an end max not larger than the
+  // current one, lambda the ones that were removed from theta and did not
+  // trigger a detection yet.
+  for (const auto [current_task, current_end] :
+       helper_->TaskByDecreasingEndMax()) {
+    const int current_event = task_to_event_[current_task];
+    if (current_event == -1) continue;
+
+    const IntegerValue target_envelope = current_end * capacity_max;
+    if (theta_tree_.GetEnvelope() > target_envelope) {
+      const int critical_event =
+          theta_tree_.GetMaxEventWithEnvelopeGreaterThan(target_envelope);
+      helper_->ClearReason();
+      AddThetaReason(critical_event, event_task_time_[critical_event].time,
+                     current_end);
+      return helper_->ReportConflict();
+    }
+
+    while (theta_tree_.GetOptionalEnvelope() > target_envelope) {
+      // The energy of the tasks of theta in [window_start, current_end] plus
+      // the one of the gray task exceeds the capacity, so the gray task must
+      // end after current_end.
+      int critical_event;
+      int gray_event;
+      IntegerValue unused_available_energy;
+      theta_tree_.GetEventsWithOptionalEnvelopeGreaterThan(
+          target_envelope, &critical_event, &gray_event,
+          &unused_available_energy);
+      DCHECK(!event_is_in_theta_[gray_event]);
+      const int gray_task = event_task_time_[gray_event].task_index;
+      const IntegerValue window_start = event_task_time_[critical_event].time;
+
+      // The tasks of theta after the critical event must then leave enough
+      // space for the gray task from its start to current_end.
+      IntegerValue omega_start = kMaxIntegerValue;
+      IntegerValue omega_energy(0);
+      for (int event = critical_event; event < num_events; ++event) {
+        if (!event_is_in_theta_[event]) continue;
+        omega_start = std::min(omega_start, event_task_time_[event].time);
+        omega_energy +=
+            demands_->EnergyMin(event_task_time_[event].task_index);
+      }
+      const IntegerValue demand_min = demands_->DemandMin(gray_task);
+      if (omega_start < current_end && demand_min > 0) {
+        const IntegerValue rest =
+            omega_energy -
+            (capacity_max - demand_min) * (current_end - omega_start);
+        const IntegerValue new_start =
+            rest > 0 ? omega_start + CeilRatio(rest, demand_min)
+                     : kMinIntegerValue;
+        if (new_start > helper_->StartMin(gray_task)) {
+          helper_->ClearReason();
+          AddThetaReason(critical_event, omega_start, current_end);
+          helper_->AddPresenceReason(gray_task);
+          helper_->AddStartMinReason(gray_task, window_start);
+          demands_->AddEnergyMinReason(gray_task);
+          demands_->AddDemandMinReason(gray_task);
+          if (!helper_->IncreaseStartMin(gray_task, new_start)) return false;
+        }
+      }
+      theta_tree_.RemoveEvent(gray_event);
+    }
+
+    // Move the current task from theta to lambda.
+    event_is_in_theta_[current_event] = false;
+    theta_tree_.AddOrUpdateOptionalEvent(
+        current_event, event_task_time_[current_event].time * capacity_max,
+        demands_->EnergyMin(current_task));
+  }
+  return true;
+}
+
 CumulativeIsAfterSubsetConstraint::CumulativeIsAfterSubsetConstraint(
     IntegerVariable var, AffineExpression capacity,
     const std::vector<int>& subtasks, absl::Span<const IntegerValue> offsets,
@@ -88,6 +88,51 @@ class CumulativeEnergyConstraint : public PropagatorInterface {
 //
 // TODO(user): I am not sure this is the best way, but it does at least push
 // the level zero bound on the large cumulative instances.
+// Edge-finding for the cumulative constraint in O(n log n), plus the size of
+// the explanations, using a ThetaLambdaTree. See Petr Vilim, "Edge Finding
+// Filtering Algorithm for Discrete Cumulative Resources in O(kn log n)".
+//
+// The detection is the one of the paper. For the adjustment, we only use the
+// set of tasks that realized the detection instead of the best subset. This is
+// weaker, but it avoids the k extra trees needed to find the best update.
+void AddCumulativeEdgeFinding(AffineExpression capacity,
+                              SchedulingConstraintHelper* helper,
+                              SchedulingDemandHelper* demands, Model* model);
+
+class CumulativeEdgeFinding : public PropagatorInterface {
+ public:
+  CumulativeEdgeFinding(AffineExpression capacity,
+                        SchedulingConstraintHelper* helper,
+                        SchedulingDemandHelper* demands, Model* model);
+
+  bool Propagate() final;
+  void RegisterWith(GenericLiteralWatcher* watcher);
+
+ private:
+  // Pushes the start min of the tasks in the current time direction.
+  bool PropagateInCurrentDirection(IntegerValue capacity_max);
+
+  // Adds to the reason the tasks of theta whose event is >= first_event.
+  void AddThetaReason(int first_event, IntegerValue window_start,
+                      IntegerValue window_end);
+
+  const AffineExpression capacity_;
+  IntegerTrail* integer_trail_;
+  SchedulingConstraintHelper* helper_;
+  SchedulingDemandHelper* demands_;
+
+  ThetaLambdaTree<IntegerValue> theta_tree_;
+
+  // Task characteristics, -1 if the task is not considered.
+  std::vector<int> task_to_event_;
+
+  // Event characteristics, by nondecreasing start time. An event is in theta
+  // while its task end max is not larger than the current one, and is then
+  // moved to lambda.
+  std::vector<TaskTime> event_task_time_;
+  std::vector<bool> event_is_in_theta_;
+};
+
 class CumulativeIsAfterSubsetConstraint : public PropagatorInterface {
  public:
   CumulativeIsAfterSubsetConstraint(IntegerVariable var,
@@ -139,8 +139,16 @@ bool CutData::AppendOneTerm(IntegerVariable var, IntegerValue coeff,
   const bool complement = coeff < 0;
 
   // See formula below, the constant term is either coeff * lb or coeff * ub.
-  rhs -= absl::int128(coeff.value()) *
-         absl::int128(complement ? ub.value() : lb.value());
+  //
+  // The product almost always fits on 64 bits, so we only pay for the 128 bits
+  // multiplication when it does not.
+  const IntegerValue bound = complement ? ub : lb;
+  IntegerValue shift = 0;
+  if (AddProductTo(coeff, bound, &shift)) {
+    rhs -= absl::int128(shift.value());
+  } else {
+    rhs -= absl::int128(coeff.value()) * absl::int128(bound.value());
+  }
 
   // Deal with fixed variable, no need to shift back in this case, we can
   // just remove the term.
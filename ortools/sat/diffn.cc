@@ -930,10 +930,13 @@ bool RectanglePairwisePropagator::FindRestrictionsAndPropagateConflict(
     std::vector<PairwiseRestriction>* restrictions) {
   const int max_pairs =
       params_->max_pairs_pairwise_reasoning_in_no_overlap_2d();
-  if (items.size() * (items.size() - 1) / 2 > max_pairs) {
+  if (items.size() * (items.size() - 1) / 2 <= max_pairs) {
+    AppendPairwiseRestrictions(items, restrictions);
+  } else if (!AppendPairwiseRestrictionsWithSweep(items, max_pairs,
+                                                  restrictions)) {
+    // Too many boxes can overlap, we skip this reasoning.
     return true;
   }
-  AppendPairwiseRestrictions(items, restrictions);
   for (const PairwiseRestriction& restriction : *restrictions) {
     if (restriction.type ==
         PairwiseRestriction::PairwiseRestrictionType::CONFLICT) {
@@ -949,10 +952,13 @@ bool RectanglePairwisePropagator::FindRestrictionsAndPropagateConflict(
     std::vector<PairwiseRestriction>* restrictions) {
   const int max_pairs =
       params_->max_pairs_pairwise_reasoning_in_no_overlap_2d();
-  if (items1.size() * items2.size() > max_pairs) {
+  if (items1.size() * items2.size() <= max_pairs) {
+    AppendPairwiseRestrictions(items1, items2, restrictions);
+  } else if (!AppendPairwiseRestrictionsWithSweep(items1, items2, max_pairs,
+                                                  restrictions)) {
+    // Too many boxes can overlap, we skip this reasoning.
     return true;
   }
-  AppendPairwiseRestrictions(items1, items2, restrictions);
   for (const PairwiseRestriction& restriction : *restrictions) {
     if (restriction.type ==
         PairwiseRestriction::PairwiseRestrictionType::CONFLICT) {
@@ -616,8 +616,94 @@ void AppendPairwiseRestriction(const ItemForPairwiseRestriction& item1,
       break;
   }
 }
+
+// Two items must overlap on one dimension iff each one has its end min after
+// the start max of the other. This can only happen if their intervals between
+// the start max and the end min (in any order) strictly intersect.
+IndexedInterval MustOverlapInterval(
+    int index, const ItemForPairwiseRestriction::Interval& interval) {
+  return {.index = index,
+          .start = std::min(interval.start_max, interval.end_min),
+          .end = std::max(interval.start_max, interval.end_min)};
+}
+
+// Appends all the pairs (i, j) with i < j of the indices of the given intervals
+// that strictly intersect. If split is positive, we only consider the pairs
+// with i < split <= j. Returns false if there is more than max_pairs pairs.
+bool AppendIntersectingPairs(std::vector<IndexedInterval>* intervals,
+                             int split, int64_t max_pairs,
+                             std::vector<std::pair<int, int>>* pairs) {
+  std::sort(intervals->begin(), intervals->end(),
+            IndexedInterval::ComparatorByStart());
+  std::vector<IndexedInterval> active;
+  for (const IndexedInterval& interval : *intervals) {
+    int new_size = 0;
+    for (int i = 0; i < active.size(); ++i) {
+      const IndexedInterval other = active[i];
+      if (other.end <= interval.start) continue;
+      active[new_size++] = other;
+      if (interval.end <= other.start) continue;
+      const int first = std::min(other.index, interval.index);
+      const int second = std::max(other.index, interval.index);
+      if (split > 0 && (first >= split || second < split)) continue;
+      pairs->push_back({first, second});
+      if (pairs->size() > max_pairs) return false;
+    }
+    active.resize(new_size);
+    active.push_back(interval);
+  }
+  return true;
+}
+
+// The items of other_items are indexed after the ones of items. If split is
+// positive, only the pairs with one item in each span are considered.
+bool AppendSweepPairwiseRestrictions(
+    absl::Span<const ItemForPairwiseRestriction> items,
+    absl::Span<const ItemForPairwiseRestriction> other_items, int split,
+    int64_t max_pairs, std::vector<PairwiseRestriction>* result) {
+  const auto get_item = [&](int i) -> const ItemForPairwiseRestriction& {
+    return i < items.size() ? items[i] : other_items[i - items.size()];
+  };
+  const int num_items = items.size() + other_items.size();
+
+  std::vector<std::pair<int, int>> pairs;
+  std::vector<IndexedInterval> intervals(num_items);
+  for (const bool use_x : {true, false}) {
+    for (int i = 0; i < num_items; ++i) {
+      const ItemForPairwiseRestriction& item = get_item(i);
+      intervals[i] = MustOverlapInterval(i, use_x ? item.x : item.y);
+    }
+    if (!AppendIntersectingPairs(&intervals, split, max_pairs, &pairs)) {
+      return false;
+    }
+  }
+
+  // Sorting also gives the same order as AppendPairwiseRestrictions().
+  gtl::STLSortAndRemoveDuplicates(&pairs);
+  for (const auto [first, second] : pairs) {
+    AppendPairwiseRestriction(get_item(first), get_item(second), result);
+  }
+  return true;
+}
+
 }  // namespace
 
+bool AppendPairwiseRestrictionsWithSweep(
+    absl::Span<const ItemForPairwiseRestriction> items, int64_t max_pairs,
+    std::vector<PairwiseRestriction>* result) {
+  return AppendSweepPairwiseRestrictions(items, {}, /*split=*/0, max_pairs,
+                                         result);
+}
+
+bool AppendPairwiseRestrictionsWithSweep(
+    absl::Span<const ItemForPairwiseRestriction> items,
+    absl::Span<const ItemForPairwiseRestriction> other_items, int64_t max_pairs,
+    std::vector<PairwiseRestriction>* result) {
+  if (items.empty() || other_items.empty()) return true;
+  return AppendSweepPairwiseRestrictions(
+      items, other_items, /*split=*/items.size(), max_pairs, result);
+}
+
 void AppendPairwiseRestrictions(
     absl::Span<const ItemForPairwiseRestriction> items,
     std::vector<PairwiseRestriction>* result) {
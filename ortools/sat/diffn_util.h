@@ -263,6 +263,21 @@ void AppendPairwiseRestrictions(
     absl::Span<const ItemForPairwiseRestriction> other_items,
     std::vector<PairwiseRestriction>* result);
 
+// Same as AppendPairwiseRestrictions() but only looks at the pairs of items
+// that must overlap on at least one dimension, since the other pairs cannot
+// lead to a restriction. These pairs are found with a sweep line, so this is a
+// lot faster than looking at all pairs when most items are far apart.
+//
+// Returns false, and leaves `result` unchanged, if there is more than
+// max_pairs candidate pairs.
+bool AppendPairwiseRestrictionsWithSweep(
+    absl::Span<const ItemForPairwiseRestriction> items, int64_t max_pairs,
+    std::vector<PairwiseRestriction>* result);
+bool AppendPairwiseRestrictionsWithSweep(
+    absl::Span<const ItemForPairwiseRestriction> items,
+    absl::Span<const ItemForPairwiseRestriction> other_items, int64_t max_pairs,
+    std::vector<PairwiseRestriction>* result);
+
 // This class is used by the no_overlap_2d constraint to maintain the envelope
 // of a set of rectangles. This envelope is not the convex hull, but the exact
 // polyline (aligned with the x and y axis) that contains all the rectangles
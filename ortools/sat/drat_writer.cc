@@ -13,6 +13,7 @@
 
 #include "ortools/sat/drat_writer.h"
 
+#include <cstdint>
 #include <string>
 #if !defined(__PORTABLE_PLATFORM__)
 #include "ortools/base/file.h"
@@ -20,7 +21,6 @@
 #include "ortools/base/options.h"
 #endif  // !__PORTABLE_PLATFORM__
 #include "absl/log/check.h"
-#include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "ortools/sat/sat_base.h"
 
@@ -37,25 +37,69 @@ DratWriter::~DratWriter() {
 }
 
 void DratWriter::AddClause(absl::Span<const Literal> clause) {
+  if (in_binary_format_) buffer_.push_back('a');
   WriteClause(clause);
 }
 
 void DratWriter::DeleteClause(absl::Span<const Literal> clause) {
-  buffer_ += "d ";
+  if (in_binary_format_) {
+    buffer_.push_back('d');
+  } else {
+    buffer_ += "d ";
+  }
   WriteClause(clause);
 }
 
 void DratWriter::WriteClause(absl::Span<const Literal> clause) {
-  for (const Literal literal : clause) {
-    absl::StrAppendFormat(&buffer_, "%d ", literal.SignedValue());
+  if (in_binary_format_) {
+    for (const Literal literal : clause) {
+      WriteBinaryLiteral(literal.SignedValue());
+    }
+    buffer_.push_back(0);
+  } else {
+    for (const Literal literal : clause) {
+      WriteTextLiteral(literal.SignedValue());
+    }
+    buffer_ += "0\n";
+  }
+  MaybeFlushBuffer();
+}
+
+void DratWriter::WriteTextLiteral(int signed_value) {
+  // This is a lot faster than absl::StrAppendFormat().
+  char digits[16];
+  int num_digits = 0;
+  uint32_t value = signed_value < 0 ? -static_cast<uint32_t>(signed_value)
+                                    : static_cast<uint32_t>(signed_value);
+  do {
+    digits[num_digits++] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+  if (signed_value < 0) buffer_.push_back('-');
+  while (num_digits > 0) buffer_.push_back(digits[--num_digits]);
+  buffer_.push_back(' ');
+}
+
+// In the binary DRAT format, a literal with signed value l is mapped to
+// 2 * |l| + (l < 0) and written with a variable length encoding of 7 bits per
+// byte, the high bit being set on all bytes but the last one.
+void DratWriter::WriteBinaryLiteral(int signed_value) {
+  uint32_t value = signed_value < 0
+                       ? 2 * -static_cast<uint32_t>(signed_value) + 1
+                       : 2 * static_cast<uint32_t>(signed_value);
+  while (value > 127) {
+    buffer_.push_back(static_cast<char>((value & 127) | 128));
+    value >>= 7;
   }
-  buffer_ += "0\n";
-  if (buffer_.size() > 10000) {
+  buffer_.push_back(static_cast<char>(value));
+}
+
+void DratWriter::MaybeFlushBuffer() {
+  if (buffer_.size() < kBufferSize) return;
 #if !defined(__PORTABLE_PLATFORM__)
-    CHECK_OK(file::WriteString(output_, buffer_, file::Defaults()));
+  CHECK_OK(file::WriteString(output_, buffer_, file::Defaults()));
 #endif  // !__PORTABLE_PLATFORM__
-    buffer_.clear();
-  }
+  buffer_.clear();
 }
 
 }  // namespace sat
@@ -33,6 +33,9 @@ namespace sat {
 //
 // Note that DRAT proofs are often huge (can be GB), and take about as much time
 // to check as it takes for the solver to find the proof in the first place!
+// The binary format is about 2x to 3x smaller than the text one and is faster
+// to write and to parse, so it should be preferred for large proofs. For even
+// smaller proofs, the given File can point to a compressed file.
 class DratWriter {
  public:
   DratWriter(bool in_binary_format, File* output)
@@ -51,7 +54,16 @@ class DratWriter {
  private:
   void WriteClause(absl::Span<const Literal> clause);
 
-  // TODO(user): Support binary format as proof in text format can be large.
+  // Appends the given signed literal value in text or in binary format.
+  void WriteTextLiteral(int signed_value);
+  void WriteBinaryLiteral(int signed_value);
+
+  // Writes the buffer to the output once it is larger than kBufferSize.
+  void MaybeFlushBuffer();
+
+  // We only write to the output by large chunks as each call is costly.
+  static constexpr int kBufferSize = 1 << 20;
+
   bool in_binary_format_;
   File* output_;
 
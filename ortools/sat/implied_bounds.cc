@@ -20,6 +20,7 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -31,6 +32,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
+#include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/sat/clause.h"
@@ -150,20 +152,14 @@ bool ImpliedBounds::Add(Literal literal, IntegerLiteral integer_literal) {
   // var_to_bounds_. Note that we might add more than one entry with the same
   // literal_view, and we will later need to lazily clean the vector up.
   if (integer_encoder_->GetLiteralView(literal) != kNoIntegerVariable) {
-    if (var_to_bounds_.size() <= var) {
-      var_to_bounds_.resize(var.value() + 1);
-      has_implied_bounds_.Resize(var + 1);
-    }
+    if (has_implied_bounds_.size() <= var) has_implied_bounds_.Resize(var + 1);
     ++num_enqueued_in_var_to_bounds_;
     has_implied_bounds_.Set(var);
     var_to_bounds_[var].push_back({integer_encoder_->GetLiteralView(literal),
                                    integer_literal.bound, true});
   } else if (integer_encoder_->GetLiteralView(literal.Negated()) !=
              kNoIntegerVariable) {
-    if (var_to_bounds_.size() <= var) {
-      var_to_bounds_.resize(var.value() + 1);
-      has_implied_bounds_.Resize(var + 1);
-    }
+    if (has_implied_bounds_.size() <= var) has_implied_bounds_.Resize(var + 1);
     ++num_enqueued_in_var_to_bounds_;
     has_implied_bounds_.Set(var);
     var_to_bounds_[var].push_back(
@@ -175,14 +171,15 @@ bool ImpliedBounds::Add(Literal literal, IntegerLiteral integer_literal) {
 
 const std::vector<ImpliedBoundEntry>& ImpliedBounds::GetImpliedBounds(
     IntegerVariable var) {
-  if (var >= var_to_bounds_.size()) return empty_implied_bounds_;
+  const auto it = var_to_bounds_.find(var);
+  if (it == var_to_bounds_.end()) return empty_implied_bounds_;
 
   // Lazily remove obsolete entries from the vector.
   //
   // TODO(user): Check no duplicate and remove old entry if the enforcement
   // is tighter.
   int new_size = 0;
-  std::vector<ImpliedBoundEntry>& ref = var_to_bounds_[var];
+  std::vector<ImpliedBoundEntry>& ref = it->second;
   const IntegerValue root_lb = integer_trail_->LevelZeroLowerBound(var);
   for (const ImpliedBoundEntry& entry : ref) {
     if (entry.lower_bound <= root_lb) continue;
@@ -200,7 +197,54 @@ void ImpliedBounds::AddLiteralImpliesVarEqValue(Literal literal,
     var = NegationOf(var);
     value = -value;
   }
-  literal_to_var_to_value_[literal.Index()][var] = value;
+  if (!store_implied_values_) return;
+  implied_values_.push_back({literal.Index(), var, value});
+  implied_values_are_grouped_ = false;
+}
+
+absl::Span<const std::pair<IntegerVariable, IntegerValue>>
+ImpliedBounds::GetImpliedValues(Literal literal) {
+  if (!implied_values_are_grouped_) {
+    implied_values_are_grouped_ = true;
+
+    // A later value for the same (literal, var) replaces the previous one.
+    std::stable_sort(implied_values_.begin(), implied_values_.end(),
+                     [](const ImpliedValue& a, const ImpliedValue& b) {
+                       return std::tie(a.literal, a.var) <
+                              std::tie(b.literal, b.var);
+                     });
+    int new_size = 0;
+    for (const ImpliedValue& entry : implied_values_) {
+      if (new_size > 0) {
+        ImpliedValue& last = implied_values_[new_size - 1];
+        if (last.literal == entry.literal && last.var == entry.var) {
+          last = entry;
+          continue;
+        }
+      }
+      implied_values_[new_size++] = entry;
+    }
+    implied_values_.resize(new_size);
+
+    std::vector<LiteralIndex> keys;
+    std::vector<std::pair<IntegerVariable, IntegerValue>> values;
+    keys.reserve(new_size);
+    values.reserve(new_size);
+    for (const ImpliedValue& entry : implied_values_) {
+      keys.push_back(entry.literal);
+      values.push_back({entry.var, entry.value});
+    }
+    literal_to_implied_values_.ResetFromFlatMapping(keys, values);
+  }
+  if (literal.Index().value() >= literal_to_implied_values_.size()) return {};
+  return literal_to_implied_values_[literal.Index()];
+}
+
+void ImpliedBounds::ClearImpliedValues() {
+  store_implied_values_ = false;
+  implied_values_are_grouped_ = true;
+  gtl::STLClearObject(&implied_values_);
+  literal_to_implied_values_ = {};
 }
 
 bool ImpliedBounds::ProcessIntegerTrail(Literal first_decision) {
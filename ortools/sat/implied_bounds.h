@@ -36,6 +36,7 @@
 #include "ortools/sat/sat_parameters.pb.h"
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/synchronization.h"
+#include "ortools/sat/util.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/strong_integers.h"
 
@@ -125,13 +126,16 @@ class ImpliedBounds {
     return has_implied_bounds_.PositionsSetAtLeastOnce();
   }
 
-  // Returns all the implied values stored for a given literal.
-  const absl::flat_hash_map<IntegerVariable, IntegerValue>& GetImpliedValues(
-      Literal literal) const {
-    const auto it = literal_to_var_to_value_.find(literal.Index());
-    return it != literal_to_var_to_value_.end() ? it->second
-                                                : empty_var_to_value_;
-  }
+  // Returns all the implied values stored for a given literal, as (var, value)
+  // pairs with a positive var. The span is only valid until the next call that
+  // adds an implied value.
+  absl::Span<const std::pair<IntegerVariable, IntegerValue>> GetImpliedValues(
+      Literal literal);
+
+  // The implied values are only needed while loading the model to detect the
+  // element encodings. This frees them, and any value added after this call is
+  // ignored.
+  void ClearImpliedValues();
 
   // Adds to the integer trail all the new level-zero deduction made here.
   // This can only be called at decision level zero. Returns false iff the model
@@ -164,16 +168,27 @@ class ImpliedBounds {
   // TODO(user): Use inlined vectors. Even better, we actually only process
   // all variables at once, so no need to organize it by IntegerVariable even
   // if that might be more friendly cache-wise.
+  //
+  // Only few variables usually have implied bounds with a view, so we do not
+  // use a vector indexed by all the variables here.
   std::vector<ImpliedBoundEntry> empty_implied_bounds_;
-  util_intops::StrongVector<IntegerVariable, std::vector<ImpliedBoundEntry>>
+  absl::flat_hash_map<IntegerVariable, std::vector<ImpliedBoundEntry>>
       var_to_bounds_;
   SparseBitset<IntegerVariable> has_implied_bounds_;
 
-  // Stores implied values per variable.
-  absl::flat_hash_map<LiteralIndex,
-                      absl::flat_hash_map<IntegerVariable, IntegerValue>>
-      literal_to_var_to_value_;
-  const absl::flat_hash_map<IntegerVariable, IntegerValue> empty_var_to_value_;
+  // Stores the literal => var == value as a flat list, which is regrouped by
+  // literal in literal_to_implied_values_ on the next GetImpliedValues() call.
+  // This is a lot more compact than one hash map per literal.
+  struct ImpliedValue {
+    LiteralIndex literal;
+    IntegerVariable var;
+    IntegerValue value;
+  };
+  bool store_implied_values_ = true;
+  bool implied_values_are_grouped_ = true;
+  std::vector<ImpliedValue> implied_values_;
+  CompactVectorVector<LiteralIndex, std::pair<IntegerVariable, IntegerValue>>
+      literal_to_implied_values_;
 
   // Stats.
   int64_t num_deductions_ = 0;
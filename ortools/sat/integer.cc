@@ -13,13 +13,19 @@
 
 #include "ortools/sat/integer.h"
 
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif  // __GNUC__
+
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <deque>
 #include <functional>
 #include <limits>
 #include <ostream>
 #include <string>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -31,6 +37,8 @@
 #include "absl/log/check.h"
 #include "absl/meta/type_traits.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
@@ -795,6 +803,7 @@ void IntegerTrail::Untrail(const Trail& trail, int literal_trail_index) {
   // Resize lazy reason.
   lazy_reasons_.resize(lazy_reason_decision_levels_[level]);
   lazy_reason_decision_levels_.resize(level);
+  ReleaseLazyReasonCache(level);
 
   // Clear reason.
   const int old_size = reason_decision_levels_[level];
@@ -1748,16 +1757,58 @@ bool IntegerTrail::EnqueueAssociatedIntegerLiteral(IntegerLiteral i_lit,
 }
 
 void IntegerTrail::ComputeLazyReasonIfNeeded(int reason_index) const {
-  if (reason_index < 0) {
-    lazy_reasons_[-reason_index - 1].Explain(&lazy_reason_literals_,
-                                             &lazy_reason_trail_indices_);
+  if (reason_index >= 0) return;
+  const int lazy_index = -reason_index - 1;
+  const LazyReasonEntry& entry = lazy_reasons_[lazy_index];
+  if (entry.cache_index < 0) {
+    lazy_reason_literals_.clear();
+    lazy_reason_trail_indices_.clear();
+    entry.Explain(&lazy_reason_literals_, &lazy_reason_trail_indices_);
+    entry.cache_index = lazy_reason_cache_.size();
+    lazy_reason_cache_.push_back(
+        {lazy_index, static_cast<int>(lazy_reason_cache_literals_.size()),
+         static_cast<int>(lazy_reason_literals_.size()),
+         static_cast<int>(lazy_reason_cache_dependencies_.size()),
+         static_cast<int>(lazy_reason_trail_indices_.size())});
+    lazy_reason_cache_literals_.insert(lazy_reason_cache_literals_.end(),
+                                       lazy_reason_literals_.begin(),
+                                       lazy_reason_literals_.end());
+    lazy_reason_cache_dependencies_.insert(
+        lazy_reason_cache_dependencies_.end(),
+        lazy_reason_trail_indices_.begin(), lazy_reason_trail_indices_.end());
+  }
+  const CachedLazyReason& cached = lazy_reason_cache_[entry.cache_index];
+  current_lazy_literals_ = absl::MakeConstSpan(
+      lazy_reason_cache_literals_.data() + cached.literals_start,
+      cached.num_literals);
+  current_lazy_dependencies_ = absl::MakeConstSpan(
+      lazy_reason_cache_dependencies_.data() + cached.dependencies_start,
+      cached.num_dependencies);
+}
+
+void IntegerTrail::ReleaseLazyReasonCache(int level) {
+  if (level == 0) {
+    for (const LazyReasonEntry& entry : lazy_reasons_) entry.cache_index = -1;
+    lazy_reason_cache_.clear();
+    lazy_reason_cache_literals_.clear();
+    lazy_reason_cache_dependencies_.clear();
+    return;
+  }
+
+  // We stop at the first explanation that is still needed. The ones before it
+  // whose reason is gone will be released on a later backtrack.
+  const int num_lazy_reasons = lazy_reasons_.size();
+  while (!lazy_reason_cache_.empty() &&
+         lazy_reason_cache_.back().lazy_index >= num_lazy_reasons) {
+    const CachedLazyReason& cached = lazy_reason_cache_.back();
+    lazy_reason_cache_literals_.resize(cached.literals_start);
+    lazy_reason_cache_dependencies_.resize(cached.dependencies_start);
+    lazy_reason_cache_.pop_back();
   }
 }
 
 absl::Span<const int> IntegerTrail::Dependencies(int reason_index) const {
-  if (reason_index < 0) {
-    return absl::Span<const int>(lazy_reason_trail_indices_);
-  }
+  if (reason_index < 0) return current_lazy_dependencies_;
 
   const int cached_size = cached_sizes_[reason_index];
   if (cached_size == 0) return {};
@@ -1794,7 +1845,7 @@ absl::Span<const int> IntegerTrail::Dependencies(int reason_index) const {
 void IntegerTrail::AppendLiteralsReason(int reason_index,
                                         std::vector<Literal>* output) const {
   if (reason_index < 0) {
-    for (const Literal l : lazy_reason_literals_) {
+    for (const Literal l : current_lazy_literals_) {
       if (!added_variables_[l.Variable()]) {
         added_variables_.Set(l.Variable());
         output->push_back(l);
@@ -2088,7 +2139,9 @@ GenericLiteralWatcher::GenericLiteralWatcher(Model* model)
     : SatPropagator("GenericLiteralWatcher"),
       time_limit_(model->GetOrCreate<TimeLimit>()),
       integer_trail_(model->GetOrCreate<IntegerTrail>()),
-      rev_int_repository_(model->GetOrCreate<RevIntRepository>()) {
+      rev_int_repository_(model->GetOrCreate<RevIntRepository>()),
+      collect_statistics_(model->GetOrCreate<SatParameters>()
+                              ->collect_propagator_statistics()) {
   // TODO(user): This propagator currently needs to be last because it is the
   // only one enforcing that a fix-point is reached on the integer variables.
   // Figure out a better interaction between the sat propagation loop and
@@ -2227,12 +2280,41 @@ bool GenericLiteralWatcher::Propagate(Trail* trail) {
       const int64_t old_integer_timestamp = integer_trail_->num_enqueues();
       const int64_t old_boolean_timestamp = trail->Index();
 
+      double old_deterministic_time = 0.0;
+      int64_t start_time_nanos = -1;
+      if (collect_statistics_) {
+        old_deterministic_time = time_limit_->GetElapsedDeterministicTime();
+        if (id_to_stats_[id].num_calls % PropagatorStats::kTimingPeriod == 0) {
+          start_time_nanos = absl::GetCurrentTimeNanos();
+        }
+      }
+
       // TODO(user): Maybe just provide one function Propagate(watch_indices) ?
       ++num_propagate_calls;
       const bool result =
           id_to_watch_indices_[id].empty()
               ? watchers_[id]->Propagate()
               : watchers_[id]->IncrementalPropagate(id_to_watch_indices_[id]);
+
+      if (collect_statistics_) {
+        PropagatorStats& stats = id_to_stats_[id];
+        const int64_t num_integer_pushes =
+            integer_trail_->num_enqueues() - old_integer_timestamp;
+        ++stats.num_calls;
+        stats.num_literal_pushes += trail->Index() - old_boolean_timestamp;
+        stats.num_integer_pushes += num_integer_pushes;
+        if (start_time_nanos >= 0) {
+          ++stats.num_timed_calls;
+          stats.timed_seconds +=
+              1e-9 * static_cast<double>(absl::GetCurrentTimeNanos() -
+                                         start_time_nanos);
+        }
+
+        // Same formula as the one used in the cleanup above.
+        stats.deterministic_time +=
+            time_limit_->GetElapsedDeterministicTime() -
+            old_deterministic_time + 1e-8 + 1e-7 * num_integer_pushes;
+      }
       if (!result) {
         id_to_watch_indices_[id].clear();
         in_queue_[id] = false;
@@ -2342,6 +2424,7 @@ int GenericLiteralWatcher::Register(PropagatorInterface* propagator) {
   id_to_watch_indices_.push_back(std::vector<int>());
   id_to_priority_.push_back(1);
   id_to_idempotence_.push_back(true);
+  if (collect_statistics_) id_to_stats_.push_back(PropagatorStats());
 
   // Call this propagator at least once the next time Propagate() is called.
   //
@@ -2355,6 +2438,19 @@ int GenericLiteralWatcher::Register(PropagatorInterface* propagator) {
   return id;
 }
 
+std::string GenericLiteralWatcher::PropagatorName(int id) const {
+  const PropagatorInterface& propagator = *watchers_[id];
+  std::string name = typeid(propagator).name();
+#if defined(__GNUC__)
+  int status = 0;
+  char* demangled =
+      abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+  if (status == 0 && demangled != nullptr) name = demangled;
+  free(demangled);
+#endif  // __GNUC__
+  return absl::StrReplaceAll(name, {{"operations_research::sat::", ""}});
+}
+
 void GenericLiteralWatcher::SetPropagatorPriority(int id, int priority) {
   id_to_priority_[id] = priority;
   if (priority >= queue_by_priority_.size()) {
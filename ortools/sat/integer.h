@@ -1310,6 +1310,9 @@ class IntegerTrail final : public SatPropagator {
     int id;
     int trail_index_at_propagation_time;
 
+    // Index in lazy_reason_cache_ or -1 if this reason was not explained yet.
+    mutable int cache_index = -1;
+
     void Explain(std::vector<Literal>* literals,
                  std::vector<int>* dependencies) const {
       explainer->Explain(id, propagation_slack, var_to_explain,
@@ -1320,6 +1323,24 @@ class IntegerTrail final : public SatPropagator {
   std::vector<int> lazy_reason_decision_levels_;
   std::vector<LazyReasonEntry> lazy_reasons_;
 
+  // The same lazy reason is often needed by many conflicts before we backtrack
+  // over it, so we keep its explanation until then. The explanations are
+  // appended to the two buffers in the order in which they are computed, and
+  // released in bulk from the back on Untrail(). Note that an explanation stays
+  // valid as long as its entry is on the trail since it only refers to
+  // earlier trail entries.
+  struct CachedLazyReason {
+    int lazy_index;
+    int literals_start;
+    int num_literals;
+    int dependencies_start;
+    int num_dependencies;
+  };
+  void ReleaseLazyReasonCache(int level);
+  mutable std::vector<CachedLazyReason> lazy_reason_cache_;
+  mutable std::vector<Literal> lazy_reason_cache_literals_;
+  mutable std::vector<int> lazy_reason_cache_dependencies_;
+
   // Start of each decision levels in integer_trail_.
   // TODO(user): use more general reversible mechanism?
   std::vector<int> integer_search_levels_;
@@ -1341,6 +1362,11 @@ class IntegerTrail final : public SatPropagator {
   mutable std::vector<Literal> lazy_reason_literals_;
   mutable std::vector<int> lazy_reason_trail_indices_;
 
+  // The explanation of the last lazy reason given to
+  // ComputeLazyReasonIfNeeded(). This points into the cache buffers above.
+  mutable absl::Span<const Literal> current_lazy_literals_;
+  mutable absl::Span<const int> current_lazy_dependencies_;
+
   // Temporary data used by MergeReasonInto().
   mutable bool has_dependency_ = false;
   mutable std::vector<int> tmp_queue_;
@@ -1601,6 +1627,41 @@ class GenericLiteralWatcher final : public SatPropagator {
   // Add the given propagator to its queue.
   void CallOnNextPropagate(int id);
 
+  // Profiling data about one propagator. This is only collected if the
+  // parameter collect_propagator_statistics is true.
+  struct PropagatorStats {
+    int64_t num_calls = 0;
+    int64_t num_literal_pushes = 0;
+    int64_t num_integer_pushes = 0;
+
+    // To keep the overhead low, we only measure the wall time of one call out
+    // of kTimingPeriod.
+    static constexpr int kTimingPeriod = 16;
+    int64_t num_timed_calls = 0;
+    double timed_seconds = 0.0;
+
+    // The deterministic time advanced during the calls plus the part of the
+    // one charged by Propagate() that corresponds to this propagator.
+    double deterministic_time = 0.0;
+
+    // Extrapolates the timed calls to all calls.
+    double EstimatedSeconds() const {
+      if (num_timed_calls == 0) return 0.0;
+      return timed_seconds * static_cast<double>(num_calls) /
+             static_cast<double>(num_timed_calls);
+    }
+  };
+
+  // Returns the profiling data of each propagator, indexed by id. This is
+  // empty if it is not collected.
+  const std::vector<PropagatorStats>& PropagatorStatistics() const {
+    return id_to_stats_;
+  }
+
+  // Returns the name of the class of the given propagator, without the
+  // namespaces. This is meant for logs.
+  std::string PropagatorName(int id) const;
+
  private:
   // Updates queue_ and in_queue_ with the propagator ids that need to be
   // called.
@@ -1650,6 +1711,10 @@ class GenericLiteralWatcher final : public SatPropagator {
   // The id of the propagator we just called.
   int current_id_;
 
+  // Only filled if collect_statistics_ is true.
+  const bool collect_statistics_;
+  std::vector<PropagatorStats> id_to_stats_;
+
   std::vector<std::function<void(const std::vector<IntegerVariable>&)>>
       level_zero_modified_variable_callback_;
 
@@ -1645,6 +1645,21 @@ ContinuousProber::ContinuousProber(const CpModelProto& model_proto,
     }
   }
 
+  // In parallel, each probing worker starts on its own slice of the variables.
+  // It will still probe all of them eventually, but the first pass of each
+  // worker is mostly disjoint, and what it learns is exported to the others.
+  const int num_workers = parameters_.num_probing_workers();
+  const int worker_index = parameters_.probing_worker_index();
+  if (num_workers > 1 && worker_index > 0 && worker_index < num_workers) {
+    const auto rotate = [num_workers, worker_index](auto& vars) {
+      const int64_t offset =
+          static_cast<int64_t>(vars.size()) * worker_index / num_workers;
+      std::rotate(vars.begin(), vars.begin() + offset, vars.end());
+    };
+    rotate(bool_vars_);
+    rotate(int_vars_);
+  }
+
   VLOG(2) << "Start continuous probing with " << bool_vars_.size()
           << " Boolean variables,  " << int_vars_.size()
           << " integer variables, deterministic time limit = "
@@ -396,6 +396,10 @@ class SchedulingConstraintHelper : public PropagatorInterface {
   // Note that we do not mean strictly-increasing/strictly-decreasing, there
   // will be duplicate time values in these vectors.
   //
+  // These vectors are shared by all the propagators using this helper and are
+  // only sorted again if one of their value changed since the last call.
+  // Since they are then almost sorted, this is usually linear.
+  //
   // TODO(user): we could merge the first loop of IncrementalSort() with the
   // loop that fill TaskTime.time at each call.
   absl::Span<const TaskTime> TaskByIncreasingStartMin();
@@ -586,6 +590,8 @@ class SchedulingConstraintHelper : public PropagatorInterface {
   std::vector<TaskTime> task_by_increasing_start_min_;
   std::vector<TaskTime> task_by_decreasing_end_max_;
 
+  bool recompute_by_start_min_ = true;
+  bool recompute_by_end_max_ = true;
   bool recompute_by_start_max_ = true;
   bool recompute_by_end_min_ = true;
   std::vector<TaskTime> task_by_increasing_negated_start_max_;
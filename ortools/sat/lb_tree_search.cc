@@ -18,6 +18,7 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -41,6 +42,7 @@
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
+#include "ortools/sat/work_assignment.h"
 #include "ortools/util/strong_integers.h"
 #include "ortools/util/time_limit.h"
 
@@ -53,6 +55,7 @@ LbTreeSearch::LbTreeSearch(Model* model)
       random_(model->GetOrCreate<ModelRandomGenerator>()),
       sat_solver_(model->GetOrCreate<SatSolver>()),
       integer_encoder_(model->GetOrCreate<IntegerEncoder>()),
+      mapping_(model->GetOrCreate<CpModelMapping>()),
       trail_(model->GetOrCreate<Trail>()),
       assignment_(trail_->Assignment()),
       integer_trail_(model->GetOrCreate<IntegerTrail>()),
@@ -81,6 +84,9 @@ LbTreeSearch::LbTreeSearch(Model* model)
     }
   }
 
+  // This is only registered if the root bounds are shared between workers.
+  shared_root_bounds_ = model->Mutable<SharedLbTreeSearchBounds>();
+
   // We use the normal SAT search but we will bump the variable activity
   // slightly differently. In addition to the conflicts, we also bump it each
   // time the objective lower bound increase in a sub-node.
@@ -155,11 +161,49 @@ void LbTreeSearch::EnableLpAndLoadBestBasis() {
   }
 
   lp_constraint_->LoadBasisState(nodes_[last_node_with_basis].basis);
+  MarkBasisAsUsed(nodes_[last_node_with_basis]);
 }
 
 void LbTreeSearch::SaveLpBasisInto(Node& node) {
+  if (node.basis.IsEmpty()) ++num_saved_basis_;
   node.basis_timestamp = lp_constraint_->num_lp_changes();
   node.basis = lp_constraint_->GetBasisState();
+  MarkBasisAsUsed(node);
+
+  // We only clean up once we have twice the number of basis we want so that
+  // the cost of the scan over all nodes is amortized.
+  const int max_num_basis =
+      parameters_.max_num_saved_lp_basis_in_lb_tree_search();
+  if (max_num_basis > 0 && num_saved_basis_ > 2 * max_num_basis) {
+    RemoveLeastRecentlyUsedBasis();
+  }
+}
+
+void LbTreeSearch::MarkBasisAsUsed(Node& node) {
+  node.basis_last_use = ++num_basis_uses_;
+}
+
+void LbTreeSearch::RemoveLeastRecentlyUsedBasis() {
+  std::vector<int64_t> last_uses;
+  for (const Node& node : nodes_) {
+    if (!node.basis.IsEmpty()) last_uses.push_back(node.basis_last_use);
+  }
+  num_saved_basis_ = last_uses.size();
+  const int max_num_basis =
+      parameters_.max_num_saved_lp_basis_in_lb_tree_search();
+  if (num_saved_basis_ <= max_num_basis) return;
+
+  // Note that the uses are all distinct.
+  std::nth_element(last_uses.begin(),
+                   last_uses.begin() + (num_saved_basis_ - max_num_basis),
+                   last_uses.end());
+  const int64_t threshold = last_uses[num_saved_basis_ - max_num_basis];
+  for (Node& node : nodes_) {
+    if (!node.basis.IsEmpty() && node.basis_last_use < threshold) {
+      node.basis = glop::BasisState();
+    }
+  }
+  num_saved_basis_ = max_num_basis;
 }
 
 void LbTreeSearch::UpdateParentObjective(int level) {
@@ -283,6 +327,31 @@ bool LbTreeSearch::FullRestart() {
   return sat_solver_->RestoreSolverToAssumptionLevel();
 }
 
+void LbTreeSearch::SyncRootBoundsWithOtherWorkers() {
+  DCHECK_EQ(sat_solver_->CurrentDecisionLevel(), 0);
+  if (shared_root_bounds_ == nullptr || current_branch_.empty()) return;
+
+  // The root bounds are only valid for the other workers if the root is not
+  // under some assumptions.
+  if (sat_solver_->AssumptionLevel() != 0) return;
+  Node& root = nodes_[current_branch_[0]];
+  if (root.is_deleted || root.IsLeaf()) return;
+  const std::optional<ProtoLiteral> decision =
+      ProtoLiteral::Encode(root.Decision(), mapping_, integer_encoder_);
+  if (!decision.has_value()) return;
+
+  IntegerValue true_lb = root.true_objective;
+  if (shared_root_bounds_->Synchronize(*decision, &true_lb)) {
+    ++num_root_bounds_imported_;
+    root.UpdateTrueObjective(true_lb);
+  }
+  IntegerValue false_lb = root.false_objective;
+  if (shared_root_bounds_->Synchronize(decision->Negated(), &false_lb)) {
+    ++num_root_bounds_imported_;
+    root.UpdateFalseObjective(false_lb);
+  }
+}
+
 void LbTreeSearch::MarkAsDeletedNodeAndUnreachableSubtree(Node& node) {
   --num_nodes_in_tree_;
   DCHECK(!node.is_deleted);
@@ -327,6 +396,7 @@ std::string LbTreeSearch::SmallProgressString() const {
       "nodes=", num_nodes_in_tree_, "/", nodes_.size(),
       " rc=", num_rc_detected_, " decisions=", num_decisions_taken_,
       " @root=", num_back_to_root_node_, " restarts=", num_full_restarts_,
+      " shared=", num_root_bounds_imported_,
       " lp_iters=[", FormatCounter(num_lp_iters_at_level_zero_), ", ",
       FormatCounter(num_lp_iters_save_basis_), ", ",
       FormatCounter(num_lp_iters_first_branch_), ", ",
@@ -376,6 +446,10 @@ bool LbTreeSearch::LevelZeroLogic() {
     }
   }
 
+  // The other workers might have closed a branch of our root node, or might
+  // benefit from what we proved for it.
+  SyncRootBoundsWithOtherWorkers();
+
   // If the search has not just been restarted (in which case nodes_ would be
   // empty), and if we are at level zero (either naturally, or if the
   // backtrack level was set to zero in the above code), let's run a different
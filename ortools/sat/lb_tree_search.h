@@ -26,6 +26,7 @@
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/sat/cp_model_mapping.h"
 #include "ortools/sat/integer.h"
 #include "ortools/sat/integer_search.h"
 #include "ortools/sat/linear_programming_constraint.h"
@@ -37,6 +38,7 @@
 #include "ortools/sat/sat_solver.h"
 #include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
+#include "ortools/sat/work_assignment.h"
 #include "ortools/util/strong_integers.h"
 #include "ortools/util/time_limit.h"
 
@@ -120,6 +122,10 @@ class LbTreeSearch {
     // Experimental. Store the optimal basis at each node.
     int64_t basis_timestamp;
     glop::BasisState basis;
+
+    // The last time this basis was saved or loaded, used to only keep the
+    // most recently used basis in memory.
+    int64_t basis_last_use = 0;
   };
 
   // Regroup some logic done when we are back at level zero in Search().
@@ -149,9 +155,15 @@ class LbTreeSearch {
   // Returns false on conflict.
   bool FullRestart();
 
+  // Exchanges the objective bounds of the two branches of the root node with
+  // the other LbTreeSearch workers. Must be called at level zero.
+  void SyncRootBoundsWithOtherWorkers();
+
   // Loads any known basis that is the closest to the current branch.
   void EnableLpAndLoadBestBasis();
   void SaveLpBasisInto(Node& node);
+  void MarkBasisAsUsed(Node& node);
+  void RemoveLeastRecentlyUsedBasis();
   bool NodeHasUpToDateBasis(const Node& node) const;
   bool NodeHasBasis(const Node& node) const;
 
@@ -189,6 +201,7 @@ class LbTreeSearch {
   ModelRandomGenerator* random_;
   SatSolver* sat_solver_;
   IntegerEncoder* integer_encoder_;
+  CpModelMapping* mapping_;
   Trail* trail_;
   const VariablesAssignment& assignment_;
   IntegerTrail* integer_trail_;
@@ -204,6 +217,14 @@ class LbTreeSearch {
   // objective_var_ as objective.
   LinearProgrammingConstraint* lp_constraint_ = nullptr;
 
+  // This can stay null if the root bounds are not shared between workers.
+  SharedLbTreeSearchBounds* shared_root_bounds_ = nullptr;
+
+  // Number of nodes with a saved basis. This can over-estimate it after the
+  // tree was cleared, it is recomputed by RemoveLeastRecentlyUsedBasis().
+  int num_saved_basis_ = 0;
+  int64_t num_basis_uses_ = 0;
+
   // We temporarily cache the shared_response_ objective lb here.
   IntegerValue current_objective_lb_;
 
@@ -236,6 +257,9 @@ class LbTreeSearch {
 
   // Count the number of time we are back to decision level zero.
   int64_t num_back_to_root_node_ = 0;
+
+  // Count the number of root branch bounds imported from other workers.
+  int64_t num_root_bounds_imported_ = 0;
 };
 
 }  // namespace sat
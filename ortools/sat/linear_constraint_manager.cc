@@ -279,6 +279,10 @@ bool LinearConstraintManager::AddCut(LinearConstraint ct, std::string type_name,
   num_cuts_++;
   num_deletable_constraints_++;
   type_to_num_cuts_[type_name]++;
+  if (new_cut_callback_ != nullptr) {
+    new_cut_callback_(constraint_infos_[ct_index].constraint, type_name,
+                      violation / l2_norm);
+  }
   return true;
 }
 
@@ -16,7 +16,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/btree_map.h"
@@ -118,6 +120,15 @@ class LinearConstraintManager {
   bool AddCut(LinearConstraint ct, std::string type_name,
               std::string extra_info = "");
 
+  // If set, this is called on each new cut added by AddCut() with its type
+  // name and its efficacy (violation / l2 norm) in the current LP solution.
+  // Note that the cut is passed after our canonicalization.
+  void SetNewCutCallback(
+      std::function<void(const LinearConstraint&, absl::string_view, double)>
+          callback) {
+    new_cut_callback_ = std::move(callback);
+  }
+
   // These must be level zero bounds.
   bool UpdateConstraintLb(glop::RowIndex index_in_lp, IntegerValue new_lb);
   bool UpdateConstraintUb(glop::RowIndex index_in_lp, IntegerValue new_ub);
@@ -250,6 +261,8 @@ class LinearConstraintManager {
   int64_t num_cuts_ = 0;
   int64_t num_add_cut_calls_ = 0;
   absl::btree_map<std::string, int> type_to_num_cuts_;
+  std::function<void(const LinearConstraint&, absl::string_view, double)>
+      new_cut_callback_;
 
   bool objective_is_defined_ = false;
   bool objective_norm_computed_ = false;
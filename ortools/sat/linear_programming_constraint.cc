@@ -208,6 +208,7 @@ void ScatteredIntegerVector::ConvertToCutData(
   result->rhs = rhs;
   if (is_sparse_) {
     std::sort(non_zeros_.begin(), non_zeros_.end());
+    result->terms.reserve(non_zeros_.size());
     for (const glop::ColIndex col : non_zeros_) {
       const IntegerValue coeff = dense_vector_[col];
       if (coeff == 0) continue;
@@ -584,6 +585,8 @@ void LinearProgrammingConstraint::SetLevel(int level) {
 
 void LinearProgrammingConstraint::AddCutGenerator(CutGenerator generator) {
   cut_generators_.push_back(std::move(generator));
+  cut_generator_num_failures_.push_back(0);
+  cut_generator_num_skips_.push_back(0);
 }
 
 bool LinearProgrammingConstraint::IncrementalPropagate(
@@ -1312,10 +1315,10 @@ void LinearProgrammingConstraint::AddCGCuts() {
 
       // TODO(user): We use a lower value here otherwise we might run into
       // overflow while computing the cut. This should be fixable.
-      tmp_integer_multipliers_ = ScaleLpMultiplier(
-          /*take_objective_into_account=*/false,
-          /*ignore_trivial_constraints=*/old_gomory, tmp_lp_multipliers_,
-          &scaling);
+      ScaleLpMultiplier(/*take_objective_into_account=*/false,
+                        /*ignore_trivial_constraints=*/old_gomory,
+                        tmp_lp_multipliers_, &scaling,
+                        &tmp_integer_multipliers_);
       if (scaling != 0) {
         AddCutFromConstraints("CG", tmp_integer_multipliers_);
       }
@@ -1819,11 +1822,25 @@ bool LinearProgrammingConstraint::Propagate() {
 
       // Try to add cuts.
       if (level == 0 || !parameters_.only_add_cuts_at_level_zero()) {
-        for (const CutGenerator& generator : cut_generators_) {
+        const bool skip_unproductive =
+            parameters_.skip_unproductive_cut_generators();
+        for (int i = 0; i < cut_generators_.size(); ++i) {
+          const CutGenerator& generator = cut_generators_[i];
           if (level > 0 && generator.only_run_at_level_zero) continue;
+          if (skip_unproductive && cut_generator_num_skips_[i] > 0) {
+            --cut_generator_num_skips_[i];
+            continue;
+          }
+          const int64_t old_num_cuts = constraint_manager_.num_cuts();
           if (!generator.generate_cuts(&constraint_manager_)) {
             return false;
           }
+          if (constraint_manager_.num_cuts() > old_num_cuts) {
+            cut_generator_num_failures_[i] = 0;
+          } else {
+            const int num_failures = ++cut_generator_num_failures_[i];
+            cut_generator_num_skips_[i] = (1 << std::min(num_failures, 6)) - 1;
+          }
         }
       }
 
@@ -1904,12 +1921,14 @@ bool LinearProgrammingConstraint::ScalingCanOverflow(
   return bound >= overflow_cap;
 }
 
-std::vector<std::pair<RowIndex, IntegerValue>>
-LinearProgrammingConstraint::ScaleLpMultiplier(
+void LinearProgrammingConstraint::ScaleLpMultiplier(
     bool take_objective_into_account, bool ignore_trivial_constraints,
     const std::vector<std::pair<RowIndex, double>>& lp_multipliers,
-    IntegerValue* scaling, int64_t overflow_cap) const {
+    IntegerValue* scaling,
+    std::vector<std::pair<RowIndex, IntegerValue>>* integer_multipliers,
+    int64_t overflow_cap) const {
   *scaling = 0;
+  integer_multipliers->clear();
 
   // First unscale the values with the LP scaling and remove bad cases.
   tmp_cp_multipliers_.clear();
@@ -1938,10 +1957,9 @@ LinearProgrammingConstraint::ScaleLpMultiplier(
         {row, scaler_.UnscaleDualValue(row, lp_multi)});
   }
 
-  std::vector<std::pair<RowIndex, IntegerValue>> integer_multipliers;
   if (tmp_cp_multipliers_.empty()) {
     // Empty linear combinaison.
-    return integer_multipliers;
+    return;
   }
 
   // TODO(user): we currently do not support scaling down, so we just abort
@@ -1949,7 +1967,7 @@ LinearProgrammingConstraint::ScaleLpMultiplier(
   if (ScalingCanOverflow(/*power=*/0, take_objective_into_account,
                          tmp_cp_multipliers_, overflow_cap)) {
     ++num_scaling_issues_;
-    return integer_multipliers;
+    return;
   }
 
   // Note that we don't try to scale by more than 63 since in practice the
@@ -1977,16 +1995,15 @@ LinearProgrammingConstraint::ScaleLpMultiplier(
     const IntegerValue coeff(std::round(double_coeff * scaling_as_double));
     if (coeff != 0) {
       gcd = std::gcd(gcd, std::abs(coeff.value()));
-      integer_multipliers.push_back({row, coeff});
+      integer_multipliers->push_back({row, coeff});
     }
   }
   if (gcd > 1) {
     *scaling /= gcd;
-    for (auto& entry : integer_multipliers) {
+    for (auto& entry : *integer_multipliers) {
       entry.second /= gcd;
     }
   }
-  return integer_multipliers;
 }
 
 template <bool check_overflow>
@@ -2269,9 +2286,9 @@ bool LinearProgrammingConstraint::PropagateExactLpReason() {
   }
 
   IntegerValue scaling = 0;
-  tmp_integer_multipliers_ = ScaleLpMultiplier(
-      take_objective_into_account,
-      /*ignore_trivial_constraints=*/true, tmp_lp_multipliers_, &scaling);
+  ScaleLpMultiplier(take_objective_into_account,
+                    /*ignore_trivial_constraints=*/true, tmp_lp_multipliers_,
+                    &scaling, &tmp_integer_multipliers_);
   if (scaling == 0) {
     VLOG(1) << simplex_.GetProblemStatus();
     VLOG(1) << "Issue while computing the exact LP reason. Aborting.";
@@ -2331,9 +2348,9 @@ bool LinearProgrammingConstraint::PropagateExactDualRay() {
     if (std::abs(value) < kZeroTolerance) continue;
     tmp_lp_multipliers_.push_back({row, value});
   }
-  tmp_integer_multipliers_ = ScaleLpMultiplier(
-      /*take_objective_into_account=*/false,
-      /*ignore_trivial_constraints=*/true, tmp_lp_multipliers_, &scaling);
+  ScaleLpMultiplier(/*take_objective_into_account=*/false,
+                    /*ignore_trivial_constraints=*/true, tmp_lp_multipliers_,
+                    &scaling, &tmp_integer_multipliers_);
   if (scaling == 0) {
     VLOG(1) << "Isse while computing the exact dual ray reason. Aborting.";
     return true;
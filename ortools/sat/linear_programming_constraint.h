@@ -158,6 +158,13 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   // Register a new cut generator with this constraint.
   void AddCutGenerator(CutGenerator generator);
 
+  // See LinearConstraintManager::SetNewCutCallback().
+  void SetNewCutCallback(
+      std::function<void(const LinearConstraint&, absl::string_view, double)>
+          callback) {
+    constraint_manager_.SetNewCutCallback(std::move(callback));
+  }
+
   // Returns the LP value and reduced cost of a variable in the current
   // solution. These functions should only be called when HasSolution() is true.
   //
@@ -327,10 +334,14 @@ class LinearProgrammingConstraint : public PropagatorInterface,
   //
   // Note that this will loose some precision, but our subsequent computation
   // will still be exact as it will work for any set of multiplier.
-  std::vector<std::pair<glop::RowIndex, IntegerValue>> ScaleLpMultiplier(
+  //
+  // The result is written in *integer_multipliers, which is cleared first, so
+  // that callers can reuse the same buffer. It is empty if *scaling is zero.
+  void ScaleLpMultiplier(
       bool take_objective_into_account, bool ignore_trivial_constraints,
       const std::vector<std::pair<glop::RowIndex, double>>& lp_multipliers,
       IntegerValue* scaling,
+      std::vector<std::pair<glop::RowIndex, IntegerValue>>* integer_multipliers,
       int64_t overflow_cap = std::numeric_limits<int64_t>::max()) const;
 
   // Can we have an overflow if we scale each coefficients with
@@ -574,6 +585,12 @@ class LinearProgrammingConstraint : public PropagatorInterface,
 
   std::vector<CutGenerator> cut_generators_;
 
+  // For skip_unproductive_cut_generators, indexed as cut_generators_: the
+  // number of consecutive calls without new cuts, and the number of calls
+  // still to skip.
+  std::vector<int> cut_generator_num_failures_;
+  std::vector<int> cut_generator_num_skips_;
+
   // Store some statistics for HeuristicLPReducedCostAverage().
   bool compute_reduced_cost_averages_ = false;
   int num_calls_since_reduced_cost_averages_reset_ = 0;
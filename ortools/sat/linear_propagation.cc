@@ -584,11 +584,10 @@ bool LinearPropagator::AddConstraint(
     }
   }
 
-  // Make sure max_variations_ is of correct size.
+  // Make sure buffer_of_ones_ is of correct size.
   // Note that we also have a hard limit of 1 << 29 on the size.
   CHECK_LT(vars.size(), 1 << 29);
-  if (vars.size() > max_variations_.size()) {
-    max_variations_.resize(vars.size(), 0);
+  if (vars.size() > buffer_of_ones_.size()) {
     buffer_of_ones_.resize(vars.size(), IntegerValue(1));
   }
 
@@ -775,14 +774,17 @@ std::pair<IntegerValue, int> LinearPropagator::AnalyzeConstraint(int id) {
     return {0, 0};
   }
 
-  // Compute the slack and max_variations_ of each variables.
+  // Compute the slack and the maximum variation of the variables.
   // We also filter out fixed variables in a reversible way.
+  //
+  // Note that most of the time nothing can be pushed, so we do not store the
+  // variation of each term here as this is memory bound on large constraints.
+  // We recompute them below in the rare case where we need them.
   IntegerValue implied_lb(0);
   const auto vars = GetVariables(info);
   IntegerValue max_variation(0);
   bool first_change = true;
   num_terms_for_dtime_update_ += info.rev_size;
-  IntegerValue* max_variations = max_variations_.data();
   const IntegerValue* lower_bounds = integer_trail_->LowerBoundsData();
   if (info.all_coeffs_are_one) {
     // TODO(user): Avoid duplication?
@@ -803,7 +805,6 @@ std::pair<IntegerValue, int> LinearPropagator::AnalyzeConstraint(int id) {
         info.rev_rhs -= lb;
       } else {
         implied_lb += lb;
-        max_variations[i] = diff;
         max_variation = std::max(max_variation, diff);
         ++i;
       }
@@ -829,8 +830,7 @@ std::pair<IntegerValue, int> LinearPropagator::AnalyzeConstraint(int id) {
         info.rev_rhs -= coeff * lb;
       } else {
         implied_lb += coeff * lb;
-        max_variations[i] = diff * coeff;
-        max_variation = std::max(max_variation, max_variations[i]);
+        max_variation = std::max(max_variation, diff * coeff);
         ++i;
       }
     }
@@ -845,14 +845,29 @@ std::pair<IntegerValue, int> LinearPropagator::AnalyzeConstraint(int id) {
   // except if the constraint is enforced and the slack is non-negative.
   if (slack < 0 || max_variation <= slack) return {slack, 0};
   if (enf_status == EnforcementStatus::IS_ENFORCED) {
-    // Swap the variable(s) that will be pushed at the beginning.
+    // Swap the variable(s) that will be pushed at the beginning. The bounds
+    // of these variables were just read, so they should be in the cache.
     int num_to_push = 0;
-    const auto coeffs = GetCoeffs(info);
-    for (int i = 0; i < info.rev_size; ++i) {
-      if (max_variations[i] <= slack) continue;
-      std::swap(vars[i], vars[num_to_push]);
-      std::swap(coeffs[i], coeffs[num_to_push]);
-      ++num_to_push;
+    if (info.all_coeffs_are_one) {
+      for (int i = 0; i < info.rev_size; ++i) {
+        const IntegerVariable var = vars[i];
+        const IntegerValue diff = -lower_bounds[NegationOf(var).value()] -
+                                  lower_bounds[var.value()];
+        if (diff <= slack) continue;
+        std::swap(vars[i], vars[num_to_push]);
+        ++num_to_push;
+      }
+    } else {
+      const auto coeffs = GetCoeffs(info);
+      for (int i = 0; i < info.rev_size; ++i) {
+        const IntegerVariable var = vars[i];
+        const IntegerValue diff = -lower_bounds[NegationOf(var).value()] -
+                                  lower_bounds[var.value()];
+        if (diff * coeffs[i] <= slack) continue;
+        std::swap(vars[i], vars[num_to_push]);
+        std::swap(coeffs[i], coeffs[num_to_push]);
+        ++num_to_push;
+      }
     }
     return {slack, num_to_push};
   }
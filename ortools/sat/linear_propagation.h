@@ -408,9 +408,6 @@ class LinearPropagator : public PropagatorInterface,
   std::vector<IntegerValue> coeffs_buffer_;
   std::vector<IntegerValue> buffer_of_ones_;
 
-  // Filled by PropagateOneConstraint().
-  std::vector<IntegerValue> max_variations_;
-
   // For reasons computation. Parallel vectors.
   std::vector<IntegerLiteral> integer_reason_;
   std::vector<IntegerValue> reason_coeffs_;
@@ -94,9 +94,9 @@ bool HittingSetOptimizer::ImportFromOtherWorkers() {
 }
 
 // Slightly different algo than FindCores() which aim to extract more cores, but
-// not necessarily non-overlaping ones.
+// not necessarily non-overlaping ones, unless disjoint_cores is true.
 SatSolver::Status HittingSetOptimizer::FindMultipleCoresForMaxHs(
-    std::vector<Literal> assumptions,
+    std::vector<Literal> assumptions, bool disjoint_cores,
     std::vector<std::vector<Literal>>* cores) {
   cores->clear();
   const double saved_dlimit = time_limit_->GetDeterministicLimit();
@@ -123,16 +123,28 @@ SatSolver::Status HittingSetOptimizer::FindMultipleCoresForMaxHs(
     cores->push_back(core);
     if (!parameters_.find_multiple_cores()) break;
 
-    // Pick a random literal from the core and remove it from the set of
-    // assumptions.
-    CHECK(!core.empty());
-    const Literal random_literal =
-        core[absl::Uniform<int>(*random_, 0, core.size())];
-    for (int i = 0; i < assumptions.size(); ++i) {
-      if (assumptions[i] == random_literal) {
-        std::swap(assumptions[i], assumptions.back());
-        assumptions.pop_back();
-        break;
+    if (disjoint_cores) {
+      // Remove the whole core from the set of assumptions, so that the next
+      // cores are disjoint from it. Each of them then increases the lower
+      // bound of the hitting set problem on its own.
+      const absl::flat_hash_set<Literal> core_set(core.begin(), core.end());
+      assumptions.erase(std::remove_if(assumptions.begin(), assumptions.end(),
+                                       [&core_set](const Literal literal) {
+                                         return core_set.contains(literal);
+                                       }),
+                        assumptions.end());
+    } else {
+      // Pick a random literal from the core and remove it from the set of
+      // assumptions.
+      CHECK(!core.empty());
+      const Literal random_literal =
+          core[absl::Uniform<int>(*random_, 0, core.size())];
+      for (int i = 0; i < assumptions.size(); ++i) {
+        if (assumptions[i] == random_literal) {
+          std::swap(assumptions[i], assumptions.back());
+          assumptions.pop_back();
+          break;
+        }
       }
     }
 
@@ -559,6 +571,12 @@ SatSolver::Status HittingSetOptimizer::Optimize() {
   // algorithm progress.
   IntegerValue stratified_threshold = kMaxIntegerValue;
 
+  // The first cores found with a new set of assumptions, i.e. at a new
+  // stratification level, are disjoint. These cores are cheap to find and give
+  // a good initial hitting set problem, which avoids many expensive MIP solves
+  // that each only add a few overlapping cores.
+  bool new_stratification_level = true;
+
   // Start the algorithm.
   SatSolver::Status result;
   for (int iter = 0;; ++iter) {
@@ -567,12 +585,17 @@ SatSolver::Status HittingSetOptimizer::Optimize() {
     //
     // TODO(user): deal with time limit.
 
-    // Get the best external bound and constraint the objective of the MPModel.
+    // Get the best bound and constraint the objective of the MPModel. Since
+    // cores are only added, the objective of the last hitting set, which is
+    // enqueued on the objective variable, is also a valid bound: with it, the
+    // MIP solver can stop as soon as it finds a solution reaching it.
+    IntegerValue best_lower_bound = integer_trail_->LevelZeroLowerBound(
+        objective_definition_.objective_var);
     if (shared_response_ != nullptr) {
-      const IntegerValue best_lower_bound =
-          shared_response_->GetInnerObjectiveLowerBound();
-      obj_constraint_->set_lower_bound(ToDouble(best_lower_bound));
+      best_lower_bound = std::max(
+          best_lower_bound, shared_response_->GetInnerObjectiveLowerBound());
     }
+    obj_constraint_->set_lower_bound(ToDouble(best_lower_bound));
 
     if (!ImportFromOtherWorkers()) return SatSolver::INFEASIBLE;
     TightenMpModel();
@@ -626,6 +649,7 @@ SatSolver::Status HittingSetOptimizer::Optimize() {
     if (assumptions.empty() && next_stratified_threshold > 0) {
       CHECK_LT(next_stratified_threshold, stratified_threshold);
       stratified_threshold = next_stratified_threshold;
+      new_stratification_level = true;
       --iter;  // "false" iteration, the lower bound does not increase.
       continue;
     }
@@ -633,7 +657,9 @@ SatSolver::Status HittingSetOptimizer::Optimize() {
     // TODO(user): Use the real weights and exploit the extra cores.
     // TODO(user): If we extract more than the objective variables, we could
     // use the solution values from the MPModel as hints to the SAT model.
-    result = FindMultipleCoresForMaxHs(assumptions, &temp_cores_);
+    result = FindMultipleCoresForMaxHs(
+        assumptions, /*disjoint_cores=*/new_stratification_level, &temp_cores_);
+    new_stratification_level = false;
     if (result == SatSolver::FEASIBLE) {
       if (!ProcessSolution()) return SatSolver::INFEASIBLE;
       if (parameters_.stop_after_first_solution()) {
@@ -644,6 +670,7 @@ SatSolver::Status HittingSetOptimizer::Optimize() {
         // bound. Otherwise we have an optimal solution.
         stratified_threshold = next_stratified_threshold;
         if (stratified_threshold == 0) break;
+        new_stratification_level = true;
         --iter;  // "false" iteration, the lower bound does not increase.
         continue;
       }
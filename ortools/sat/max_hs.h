@@ -68,9 +68,12 @@ class HittingSetOptimizer {
  private:
   const int kUnextracted = -1;
 
+  // Finds cores with the given assumptions. If disjoint_cores is true, the
+  // literals of each core are removed from the assumptions before looking for
+  // the next one, otherwise only one of them is.
   SatSolver::Status FindMultipleCoresForMaxHs(
-      std::vector<Literal> assumptions,
-      std::vector<std::vector<Literal>>* core);
+      std::vector<Literal> assumptions, bool disjoint_cores,
+      std::vector<std::vector<Literal>>* cores);
 
   // Extract the objective variables, which is the smallest possible useful set.
   void ExtractObjectiveVariables();
@@ -105,6 +105,8 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_IN_RANGE(num_search_workers, 0, kMaxReasonableParallelism);
   TEST_IN_RANGE(shared_tree_num_workers, 0, kMaxReasonableParallelism);
   TEST_IN_RANGE(interleave_batch_size, 0, kMaxReasonableParallelism);
+  TEST_IN_RANGE(num_probing_workers, 1, kMaxReasonableParallelism);
+  TEST_IN_RANGE(probing_worker_index, 0, kMaxReasonableParallelism);
   TEST_IN_RANGE(shared_tree_open_leaves_per_worker, 1,
                 kMaxReasonableParallelism);
 
@@ -133,6 +135,7 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_POSITIVE(shared_tree_max_nodes_per_worker);
   TEST_POSITIVE(shared_tree_open_leaves_per_worker);
   TEST_POSITIVE(mip_var_scaling);
+  TEST_POSITIVE(presolve_num_threads);
 
   // Test LP tolerances.
   TEST_IS_FINITE(lp_primal_tolerance);
@@ -146,7 +149,13 @@ std::string ValidateParameters(const SatParameters& params) {
   TEST_NON_NEGATIVE(new_constraints_batch_size);
   TEST_NON_NEGATIVE(probing_deterministic_time_limit);
   TEST_NON_NEGATIVE(presolve_probing_deterministic_time_limit);
+  TEST_NON_NEGATIVE(symmetry_detection_deterministic_time_limit);
+  TEST_NON_NEGATIVE(hint_repair_deterministic_time);
   TEST_NON_NEGATIVE(linearization_level);
+  TEST_NON_NEGATIVE(min_num_tuples_for_compact_table);
+  TEST_NON_NEGATIVE(min_automaton_size_for_propagator);
+  TEST_NON_NEGATIVE(share_linear_cuts_min_efficacy);
+  TEST_NON_NEGATIVE(max_num_saved_lp_basis_in_lb_tree_search);
 
   if (params.enumerate_all_solutions() &&
       (params.num_search_workers() > 1 || params.num_workers() > 1)) {
@@ -281,8 +281,22 @@ void PrecedenceRelations::Build() {
 
   int work = 0;
   const int kWorkLimit = 1e6;
+  std::vector<std::pair<IntegerVariable, IntegerValue>> tail_before;
   for (const IntegerVariable tail_var : topological_order_) {
     if (++work > kWorkLimit) break;
+    if (graph_.OutgoingArcs(tail_var.value()).empty()) continue;
+
+    // Since we follow a topological order, the relations before tail_var are
+    // final, so we fetch their offsets once instead of doing one hash lookup
+    // per outgoing arc. Note that even in the corner case where the loop below
+    // improves one of them, the old offset still gives a valid relation.
+    tail_before.clear();
+    for (const IntegerVariable before_var : before[tail_var]) {
+      tail_before.push_back(
+          {before_var,
+           -root_relations_.at(GetKey(before_var, NegationOf(tail_var)))});
+    }
+
     for (const int arc : graph_.OutgoingArcs(tail_var.value())) {
       DCHECK_EQ(tail_var.value(), graph_.Tail(arc));
       const IntegerVariable head_var = IntegerVariable(graph_.Head(arc));
@@ -293,11 +307,9 @@ void PrecedenceRelations::Build() {
         before[head_var].push_back(tail_var);
       }
 
-      for (const IntegerVariable before_var : before[tail_var]) {
+      for (const auto [before_var, before_offset] : tail_before) {
         if (++work > kWorkLimit) break;
-        const IntegerValue offset =
-            -root_relations_.at(GetKey(before_var, NegationOf(tail_var))) +
-            arc_offset;
+        const IntegerValue offset = before_offset + arc_offset;
         if (AddInternal(before_var, head_var, offset)) {
           before[head_var].push_back(before_var);
         }
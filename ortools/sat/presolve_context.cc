@@ -499,13 +499,13 @@ ABSL_MUST_USE_RESULT bool PresolveContext::IntersectDomainWith(
     if (domains[var].IsIncludedIn(domain)) {
       return true;
     }
-    domains[var] = domains[var].IntersectionWith(domain);
+    domains[var].IntersectInPlace(domain);
   } else {
     const Domain temp = domain.Negation();
     if (domains[var].IsIncludedIn(temp)) {
       return true;
     }
-    domains[var] = domains[var].IntersectionWith(temp);
+    domains[var].IntersectInPlace(temp);
   }
 
   if (domain_modified != nullptr) {
@@ -1808,7 +1808,7 @@ bool PresolveContext::CanonicalizeObjective(bool simplify_domain) {
 
   // This is the new domain.
   // Note that the domain never include the offset.
-  objective_domain_ = objective_domain_.IntersectionWith(implied_domain);
+  objective_domain_.IntersectInPlace(implied_domain);
 
   // Depending on the use case, we cannot do that.
   if (simplify_domain) {
@@ -61,7 +61,8 @@ PseudoCosts::PseudoCosts(Model* model)
       integer_trail_(model->GetOrCreate<IntegerTrail>()),
       encoder_(model->GetOrCreate<IntegerEncoder>()),
       lp_values_(model->GetOrCreate<ModelLpValues>()),
-      lps_(model->GetOrCreate<LinearProgrammingConstraintCollection>()) {
+      lps_(model->GetOrCreate<LinearProgrammingConstraintCollection>()),
+      mapping_(model->GetOrCreate<CpModelMapping>()) {
   const int num_vars = integer_trail_->NumIntegerVariables().value();
   pseudo_costs_.resize(num_vars);
   is_relevant_.resize(num_vars, false);
@@ -162,6 +163,8 @@ void PseudoCosts::UpdateBoolPseudoCosts(absl::Span<const Literal> reason,
       lit_pseudo_costs_.resize(lit.Index() + 1);
     }
     lit_pseudo_costs_[lit].AddData(relative_increase);
+    RecordForSharing(SharedPseudoCosts::LITERAL, SharedKey(lit),
+                     relative_increase);
   }
 }
 
@@ -212,6 +215,8 @@ void PseudoCosts::AfterTakingDecision(bool conflict) {
         average_unit_objective_increase_.resize(var + 1);
       }
       average_unit_objective_increase_[var].AddData(obj_increase / lp_increase);
+      RecordForSharing(SharedPseudoCosts::LP_INCREASE, SharedKey(var),
+                       obj_increase / lp_increase);
     }
   }
 
@@ -227,27 +232,121 @@ void PseudoCosts::AfterTakingDecision(bool conflict) {
   for (const auto [var, lb_change, lp_increase] : bound_changes_) {
     if (lb_change == IntegerValue(0)) continue;
 
-    if (var >= pseudo_costs_.size()) {
-      // Create space for new variable and its negation.
-      const int new_size = std::max(var, NegationOf(var)).value() + 1;
-      is_relevant_.resize(new_size, false);
-      scores_.resize(new_size, 0.0);
-      pseudo_costs_.resize(new_size, IncrementalAverage(0.0));
+    ResizePseudoCostsIfNeeded(var);
+    const double unit_improvement =
+        ToDouble(obj_bound_improvement) / ToDouble(lb_change);
+    pseudo_costs_[var].AddData(unit_improvement);
+    RecordForSharing(SharedPseudoCosts::BOUND_CHANGE, SharedKey(var),
+                     unit_improvement);
+    UpdateScore(PositiveVariable(var));
+  }
+}
+
+void PseudoCosts::ResizePseudoCostsIfNeeded(IntegerVariable var) {
+  if (var < pseudo_costs_.size() && NegationOf(var) < pseudo_costs_.size()) {
+    return;
+  }
+
+  // Create space for new variable and its negation.
+  const int new_size = std::max(var, NegationOf(var)).value() + 1;
+  is_relevant_.resize(new_size, false);
+  scores_.resize(new_size, 0.0);
+  pseudo_costs_.resize(new_size, IncrementalAverage(0.0));
+}
+
+void PseudoCosts::UpdateScore(IntegerVariable positive_var) {
+  const IntegerVariable negative_var = NegationOf(positive_var);
+  const int64_t count = pseudo_costs_[positive_var].NumRecords() +
+                        pseudo_costs_[negative_var].NumRecords();
+  if (count >= parameters_.pseudo_cost_reliability_threshold()) {
+    scores_[positive_var] =
+        CombineScores(GetCost(positive_var), GetCost(negative_var));
+    if (!is_relevant_[positive_var]) {
+      is_relevant_[positive_var] = true;
+      relevant_variables_.push_back(positive_var);
     }
+  }
+}
+
+int PseudoCosts::SharedKey(IntegerVariable var) const {
+  int proto_var = mapping_->GetProtoVariableFromIntegerVariable(var);
+  if (proto_var >= 0) return 2 * proto_var;
+  proto_var = mapping_->GetProtoVariableFromIntegerVariable(NegationOf(var));
+  if (proto_var >= 0) return 2 * proto_var + 1;
+  return -1;
+}
+
+int PseudoCosts::SharedKey(Literal lit) const {
+  const int proto_var =
+      mapping_->GetProtoVariableFromBooleanVariable(lit.Variable());
+  if (proto_var < 0) return -1;
+  return lit == mapping_->Literal(proto_var) ? 2 * proto_var
+                                             : 2 * proto_var + 1;
+}
+
+void PseudoCosts::EnableSharing(int id,
+                                SharedPseudoCosts* shared_pseudo_costs) {
+  CHECK(shared_pseudo_costs != nullptr);
+  shared_id_ = id;
+  shared_pseudo_costs_ = shared_pseudo_costs;
+}
+
+void PseudoCosts::SynchronizeWithSharedPseudoCosts() {
+  if (shared_pseudo_costs_ == nullptr) return;
+  for (int t = 0; t < SharedPseudoCosts::NUM_TYPES; ++t) {
+    const auto type = static_cast<SharedPseudoCosts::Type>(t);
+
+    // Export our new records, merged by key.
+    std::vector<SharedPseudoCosts::Record>& records = records_to_export_[t];
+    std::sort(records.begin(), records.end(),
+              [](const SharedPseudoCosts::Record& a,
+                 const SharedPseudoCosts::Record& b) { return a.key < b.key; });
+    int new_size = 0;
+    for (const SharedPseudoCosts::Record& record : records) {
+      if (new_size > 0 && records[new_size - 1].key == record.key) {
+        records[new_size - 1].sum += record.sum;
+        records[new_size - 1].num_records += record.num_records;
+      } else {
+        records[new_size++] = record;
+      }
+    }
+    records.resize(new_size);
+    shared_pseudo_costs_->AddRecords(shared_id_, type, records);
+    records.clear();
+
+    // Import the records of the other workers. Note that since we just
+    // exported ours, the shared totals already contain all our records.
+    tmp_records_.clear();
+    shared_pseudo_costs_->GetUpdatedRecords(shared_id_, type, &tmp_records_);
+    for (const auto& [key, sum, num_records] : tmp_records_) {
+      if (num_records == 0) continue;
+      const double average = sum / static_cast<double>(num_records);
+      const int proto_var = key / 2;
+      const bool negated = key % 2 == 1;
+      if (type == SharedPseudoCosts::LITERAL) {
+        if (!mapping_->IsBoolean(proto_var)) continue;
+        const Literal lit = negated ? mapping_->Literal(proto_var).Negated()
+                                    : mapping_->Literal(proto_var);
+        if (lit.Index() >= lit_pseudo_costs_.size()) {
+          lit_pseudo_costs_.resize(lit.Index() + 1);
+        }
+        lit_pseudo_costs_[lit].SetAverage(average, num_records);
+        continue;
+      }
 
-    pseudo_costs_[var].AddData(ToDouble(obj_bound_improvement) /
-                               ToDouble(lb_change));
-
-    const IntegerVariable positive_var = PositiveVariable(var);
-    const IntegerVariable negative_var = NegationOf(positive_var);
-    const int64_t count = pseudo_costs_[positive_var].NumRecords() +
-                          pseudo_costs_[negative_var].NumRecords();
-    if (count >= parameters_.pseudo_cost_reliability_threshold()) {
-      scores_[positive_var] =
-          CombineScores(GetCost(positive_var), GetCost(negative_var));
-      if (!is_relevant_[positive_var]) {
-        is_relevant_[positive_var] = true;
-        relevant_variables_.push_back(positive_var);
+      if (!mapping_->IsInteger(proto_var)) continue;
+      const IntegerVariable var = negated
+                                      ? NegationOf(mapping_->Integer(proto_var))
+                                      : mapping_->Integer(proto_var);
+      if (type == SharedPseudoCosts::LP_INCREASE) {
+        if (var >= average_unit_objective_increase_.size()) {
+          average_unit_objective_increase_.resize(var + 1);
+        }
+        average_unit_objective_increase_[var].SetAverage(average, num_records);
+      } else {
+        ResizePseudoCostsIfNeeded(var);
+        pseudo_costs_[var].SetAverage(average, num_records);
+        UpdateScore(PositiveVariable(var));
       }
     }
   }
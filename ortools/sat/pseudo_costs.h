@@ -14,6 +14,7 @@
 #ifndef OR_TOOLS_SAT_PSEUDO_COSTS_H_
 #define OR_TOOLS_SAT_PSEUDO_COSTS_H_
 
+#include <array>
 #include <limits>
 #include <string>
 #include <vector>
@@ -21,11 +22,13 @@
 #include "absl/log/check.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/strong_vector.h"
+#include "ortools/sat/cp_model_mapping.h"
 #include "ortools/sat/integer.h"
 #include "ortools/sat/linear_programming_constraint.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_parameters.pb.h"
+#include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
 #include "ortools/util/strong_integers.h"
 
@@ -103,6 +106,15 @@ class PseudoCosts {
   std::vector<VariableBoundChange> GetBoundChanges(
       Literal decision, absl::Span<const double> lp_values);
 
+  // Shares the pseudo costs of the variables of the model proto with the other
+  // workers. This must be called after the model is loaded. The records are
+  // only exchanged by SynchronizeWithSharedPseudoCosts().
+  void EnableSharing(int id, SharedPseudoCosts* shared_pseudo_costs);
+
+  // Exports the records added since the last call, and imports the ones of
+  // the other workers. We currently call this at level zero.
+  void SynchronizeWithSharedPseudoCosts();
+
  private:
   // Returns the current objective info.
   struct ObjectiveInfo {
@@ -115,12 +127,30 @@ class PseudoCosts {
   };
   ObjectiveInfo GetCurrentObjectiveInfo();
 
+  // Makes sure var and its negation have an entry in pseudo_costs_.
+  void ResizePseudoCostsIfNeeded(IntegerVariable var);
+
+  // Updates the score of the given variable from its pseudo costs.
+  void UpdateScore(IntegerVariable positive_var);
+
+  // Returns the key of the given variable or literal in SharedPseudoCosts, or
+  // -1 if it is not a variable of the model proto.
+  int SharedKey(IntegerVariable var) const;
+  int SharedKey(Literal lit) const;
+
+  // Records a data point to export on the next synchronization.
+  void RecordForSharing(SharedPseudoCosts::Type type, int key, double value) {
+    if (shared_pseudo_costs_ == nullptr || key < 0) return;
+    records_to_export_[type].push_back({key, value, 1});
+  }
+
   // Model object.
   const SatParameters& parameters_;
   IntegerTrail* integer_trail_;
   IntegerEncoder* encoder_;
   ModelLpValues* lp_values_;
   LinearProgrammingConstraintCollection* lps_;
+  const CpModelMapping* mapping_;
   IntegerVariable objective_var_ = kNoIntegerVariable;
 
   // Saved info by BeforeTakingDecision().
@@ -139,6 +169,15 @@ class PseudoCosts {
 
   // This version is based on objective increase explanation.
   util_intops::StrongVector<LiteralIndex, IncrementalAverage> lit_pseudo_costs_;
+
+  // Sharing with the other workers, this is only used if EnableSharing() was
+  // called.
+  int shared_id_ = -1;
+  SharedPseudoCosts* shared_pseudo_costs_ = nullptr;
+  std::array<std::vector<SharedPseudoCosts::Record>,
+             SharedPseudoCosts::NUM_TYPES>
+      records_to_export_;
+  std::vector<SharedPseudoCosts::Record> tmp_records_;
 };
 
 }  // namespace sat
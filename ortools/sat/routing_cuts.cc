@@ -579,8 +579,10 @@ void SymmetrizeArcs(std::vector<ArcWithLpValue>* arcs) {
 // the asymmetric case.
 void SeparateSubtourInequalities(
     int num_nodes, const std::vector<int>& tails, const std::vector<int>& heads,
-    const std::vector<Literal>& literals, absl::Span<const int64_t> demands,
-    int64_t capacity, LinearConstraintManager* manager, Model* model) {
+    const std::vector<Literal>& literals,
+    const std::vector<double>& literal_lp_values,
+    absl::Span<const int64_t> demands, int64_t capacity,
+    LinearConstraintManager* manager, Model* model) {
   if (num_nodes <= 2) return;
 
   // We will collect only the arcs with a positive lp_values to speed up some
@@ -588,21 +590,9 @@ void SeparateSubtourInequalities(
   std::vector<ArcWithLpValue> relevant_arcs;
 
   // Sort the arcs by non-increasing lp_values.
-  const auto& lp_values = manager->LpValues();
-  std::vector<double> literal_lp_values(literals.size());
   std::vector<std::pair<double, int>> arc_by_decreasing_lp_values;
-  auto* encoder = model->GetOrCreate<IntegerEncoder>();
   for (int i = 0; i < literals.size(); ++i) {
-    double lp_value;
-    const IntegerVariable direct_view = encoder->GetLiteralView(literals[i]);
-    if (direct_view != kNoIntegerVariable) {
-      lp_value = lp_values[direct_view];
-    } else {
-      lp_value =
-          1.0 - lp_values[encoder->GetLiteralView(literals[i].Negated())];
-    }
-    literal_lp_values[i] = lp_value;
-
+    const double lp_value = literal_lp_values[i];
     if (lp_value < 1e-6) continue;
     relevant_arcs.push_back({tails[i], heads[i], lp_value});
     arc_by_decreasing_lp_values.push_back({lp_value, i});
@@ -730,6 +720,31 @@ std::vector<IntegerVariable> GetAssociatedVariables(
   return result;
 }
 
+// Fills literal_lp_values with the lp values of the given literals, and returns
+// false if it already contained exactly these values.
+bool UpdateLiteralLpValues(absl::Span<const Literal> literals,
+                           LinearConstraintManager* manager, Model* model,
+                           std::vector<double>* literal_lp_values) {
+  const auto& lp_values = manager->LpValues();
+  auto* encoder = model->GetOrCreate<IntegerEncoder>();
+  bool changed = literal_lp_values->size() != literals.size();
+  literal_lp_values->resize(literals.size());
+  for (int i = 0; i < literals.size(); ++i) {
+    double lp_value;
+    const IntegerVariable direct_view = encoder->GetLiteralView(literals[i]);
+    if (direct_view != kNoIntegerVariable) {
+      lp_value = lp_values[direct_view];
+    } else {
+      lp_value =
+          1.0 - lp_values[encoder->GetLiteralView(literals[i].Negated())];
+    }
+    if ((*literal_lp_values)[i] == lp_value) continue;
+    (*literal_lp_values)[i] = lp_value;
+    changed = true;
+  }
+  return changed;
+}
+
 // This is especially useful to remove fixed self loop.
 void FilterFalseArcsAtLevelZero(std::vector<int>& tails,
                                 std::vector<int>& heads,
@@ -764,10 +779,19 @@ CutGenerator CreateStronglyConnectedGraphCutGenerator(
     std::vector<Literal> literals, Model* model) {
   CutGenerator result;
   result.vars = GetAssociatedVariables(literals, model);
+  // The separation only depends on the lp values of the arcs, so there is
+  // nothing new to find when they did not change since the last call. This
+  // happens when the lp is re-solved after cuts from other generators that did
+  // not move this part of the solution.
+  std::vector<double> literal_lp_values;
   result.generate_cuts = [=](LinearConstraintManager* manager) mutable {
     FilterFalseArcsAtLevelZero(tails, heads, literals, model);
+    if (!UpdateLiteralLpValues(literals, manager, model, &literal_lp_values)) {
+      return true;
+    }
     SeparateSubtourInequalities(num_nodes, tails, heads, literals,
-                                /*demands=*/{}, /*capacity=*/0, manager, model);
+                                literal_lp_values, /*demands=*/{},
+                                /*capacity=*/0, manager, model);
     return true;
   };
   return result;
@@ -780,10 +804,16 @@ CutGenerator CreateCVRPCutGenerator(int num_nodes, std::vector<int> tails,
                                     int64_t capacity, Model* model) {
   CutGenerator result;
   result.vars = GetAssociatedVariables(literals, model);
+  // Same as in CreateStronglyConnectedGraphCutGenerator().
+  std::vector<double> literal_lp_values;
   result.generate_cuts = [=](LinearConstraintManager* manager) mutable {
     FilterFalseArcsAtLevelZero(tails, heads, literals, model);
-    SeparateSubtourInequalities(num_nodes, tails, heads, literals, demands,
-                                capacity, manager, model);
+    if (!UpdateLiteralLpValues(literals, manager, model, &literal_lp_values)) {
+      return true;
+    }
+    SeparateSubtourInequalities(num_nodes, tails, heads, literals,
+                                literal_lp_values, demands, capacity, manager,
+                                model);
     return true;
   };
   return result;
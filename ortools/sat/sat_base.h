@@ -411,6 +411,20 @@ class Trail {
     old_type_[var] = propagator_id;
   }
 
+  // Forgets the cached reasons of all the literals propagated by the given
+  // propagator, they will be asked again to the propagator when needed. This
+  // must be called when a propagator invalidates the memory backing the
+  // Span<> it returned.
+  void ClearCachedReasons(int propagator_id) {
+    for (int i = 0; i < Index(); ++i) {
+      const BooleanVariable var = trail_[i].Variable();
+      if (info_[var].type == AssignmentType::kCachedReason &&
+          old_type_[var] == propagator_id) {
+        info_[var].type = propagator_id;
+      }
+    }
+  }
+
   // Reverts the trail and underlying assignment to the given target trail
   // index. Note that we do not touch the assignment info.
   void Untrail(int target_trail_index) {
@@ -450,11 +450,30 @@ void SatDecisionPolicy::Untrail(int target_trail_index) {
 
     // Trail index of the next variable that will need a priority queue update.
     int to_update = pq_need_update_for_var_at_trail_index_.Top();
-    while (to_update >= target_trail_index) {
-      DCHECK_LT(to_update, trail_.Index());
-      PqInsertOrUpdate(trail_[to_update].Variable());
-      pq_need_update_for_var_at_trail_index_.ClearTop();
-      to_update = pq_need_update_for_var_at_trail_index_.Top();
+
+    // On long backjumps, it is faster to update all the variables without
+    // maintaining the queue and to rebuild it in linear time than to pay a
+    // logarithmic update for each of them.
+    const int max_num_updates = trail_.Index() - target_trail_index;
+    if (8 * max_num_updates > var_ordering_.Size()) {
+      bool rebuild_needed = false;
+      while (to_update >= target_trail_index) {
+        DCHECK_LT(to_update, trail_.Index());
+        const BooleanVariable var = trail_[to_update].Variable();
+        var_ordering_.AddOrChangePriorityWithoutUpdate(
+            {var, tie_breakers_[var], activities_[var]});
+        rebuild_needed = true;
+        pq_need_update_for_var_at_trail_index_.ClearTop();
+        to_update = pq_need_update_for_var_at_trail_index_.Top();
+      }
+      if (rebuild_needed) var_ordering_.Rebuild();
+    } else {
+      while (to_update >= target_trail_index) {
+        DCHECK_LT(to_update, trail_.Index());
+        PqInsertOrUpdate(trail_[to_update].Variable());
+        pq_need_update_for_var_at_trail_index_.ClearTop();
+        to_update = pq_need_update_for_var_at_trail_index_.Top();
+      }
     }
   }
 
@@ -124,13 +124,20 @@ bool Inprocessing::PresolveLoop(SatPresolveOptions options) {
     // TODO(user): Combine the two? this way we don't create a full literal <->
     // clause graph twice. It might make sense to reach the BCE fix point which
     // is unique before each variable elimination.
+    //
+    // These two can be slow on large problems, so we make sure they do not
+    // exceed the time left for this presolve.
     if (!params_.fill_tightened_domains_in_response()) {
-      blocked_clause_simplifier_->DoOneRound(log_round_info);
+      blocked_clause_simplifier_->DoOneRound(
+          log_round_info,
+          stop_dtime - time_limit_->GetElapsedDeterministicTime());
     }
 
     // TODO(user): this break some binary graph invariant. Fix!
     RETURN_IF_FALSE(RemoveFixedAndEquivalentVariables(log_round_info));
-    RETURN_IF_FALSE(bounded_variable_elimination_->DoOneRound(log_round_info));
+    RETURN_IF_FALSE(bounded_variable_elimination_->DoOneRound(
+        log_round_info,
+        stop_dtime - time_limit_->GetElapsedDeterministicTime()));
     RETURN_IF_FALSE(LevelZeroPropagate());
 
     // Probing.
@@ -265,8 +272,10 @@ bool Inprocessing::InprocessingRound() {
   // TODO(user): try to enable these? The problem is that we can only remove
   // variables not used the non-pure SAT part of a model.
   if (/*DISABLES_CODE*/ (false)) {
-    blocked_clause_simplifier_->DoOneRound(log_round_info);
-    RETURN_IF_FALSE(bounded_variable_elimination_->DoOneRound(log_round_info));
+    blocked_clause_simplifier_->DoOneRound(log_round_info,
+                                           /*deterministic_limit=*/1.0);
+    RETURN_IF_FALSE(bounded_variable_elimination_->DoOneRound(
+        log_round_info, /*deterministic_limit=*/1.0));
   }
   RETURN_IF_FALSE(LevelZeroPropagate());
 
@@ -965,7 +974,8 @@ bool StampingSimplifier::ProcessClauses() {
   return true;
 }
 
-void BlockedClauseSimplifier::DoOneRound(bool log_info) {
+void BlockedClauseSimplifier::DoOneRound(bool log_info,
+                                         double deterministic_limit) {
   WallTimer wall_timer;
   wall_timer.Start();
 
@@ -975,6 +985,9 @@ void BlockedClauseSimplifier::DoOneRound(bool log_info) {
 
   InitializeForNewRound();
 
+  // Our dtime is 1e-8 per inspected literal.
+  const double max_num_inspected_literals =
+      std::min(1e9, 1e8 * deterministic_limit);
   while (!time_limit_->LimitReached() && !queue_.empty()) {
     const Literal l = queue_.front();
     in_queue_[l] = false;
@@ -982,7 +995,9 @@ void BlockedClauseSimplifier::DoOneRound(bool log_info) {
 
     // Avoid doing too much work here on large problem.
     // Note that we still what to empty the queue.
-    if (num_inspected_literals_ <= 1e9) ProcessLiteral(l);
+    if (num_inspected_literals_ <= max_num_inspected_literals) {
+      ProcessLiteral(l);
+    }
   }
 
   // Release some memory.
@@ -1153,7 +1168,8 @@ bool BlockedClauseSimplifier::ClauseIsBlocked(
   return is_blocked;
 }
 
-bool BoundedVariableElimination::DoOneRound(bool log_info) {
+bool BoundedVariableElimination::DoOneRound(bool log_info,
+                                            double deterministic_limit) {
   WallTimer wall_timer;
   wall_timer.Start();
 
@@ -1205,10 +1221,11 @@ bool BoundedVariableElimination::DoOneRound(bool log_info) {
   DCHECK(
       std::all_of(marked_.begin(), marked_.end(), [](bool b) { return !b; }));
 
-  // TODO(user): add a local dtime limit for the corner case where this take too
-  // much time. We can adapt the limit depending on how much we want to spend on
-  // inprocessing.
-  while (!time_limit_->LimitReached() && !queue_.IsEmpty()) {
+  // Note that the time limit is only updated at the end, so we also check our
+  // own dtime (1e-8 per inspected literal) against the given limit.
+  while (!time_limit_->LimitReached() && !queue_.IsEmpty() &&
+         1e-8 * static_cast<double>(num_inspected_literals_) <=
+             deterministic_limit) {
     const BooleanVariable top = queue_.Top().var;
     queue_.Pop();
 
@@ -280,7 +280,9 @@ class BlockedClauseSimplifier {
         postsolve_(model->GetOrCreate<PostsolveClauses>()),
         time_limit_(model->GetOrCreate<TimeLimit>()) {}
 
-  void DoOneRound(bool log_info);
+  // Stops looking for new blocked clauses once the given deterministic time
+  // is spent. This is on top of the global time limit.
+  void DoOneRound(bool log_info, double deterministic_limit);
 
  private:
   void InitializeForNewRound();
@@ -325,7 +327,9 @@ class BoundedVariableElimination {
         trail_(model->GetOrCreate<Trail>()),
         time_limit_(model->GetOrCreate<TimeLimit>()) {}
 
-  bool DoOneRound(bool log_info);
+  // Stops eliminating variables once the given deterministic time is spent.
+  // This is on top of the global time limit which is only updated at the end.
+  bool DoOneRound(bool log_info, double deterministic_limit);
 
  private:
   int NumClausesContaining(Literal l);
@@ -25,6 +25,7 @@
 #include "absl/strings/string_view.h"
 #include "google/protobuf/arena.h"
 #include "google/protobuf/text_format.h"
+#include "ortools/base/file.h"
 #include "ortools/base/helpers.h"
 #include "ortools/base/logging.h"
 #include "ortools/base/options.h"
@@ -32,6 +33,7 @@
 #include "ortools/sat/boolean_problem.h"
 #include "ortools/sat/boolean_problem.pb.h"
 #include "ortools/sat/cp_model.pb.h"
+#include "ortools/sat/cp_model_columnar.h"
 #include "ortools/sat/cp_model_solver.h"
 #include "ortools/sat/cp_model_utils.h"
 #include "ortools/sat/model.h"
@@ -45,7 +47,8 @@ ABSL_FLAG(
     std::string, input, "",
     "Required: input file of the problem to solve. Many format are supported:"
     ".cnf (sat, max-sat, weighted max-sat), .opb (pseudo-boolean sat/optim) "
-    "and by default the CpModelProto proto (binary or text).");
+    "and by default the CpModelProto proto (binary or text). Files ending "
+    "with .columnar are read with ColumnarStringToCpModel().");
 
 ABSL_FLAG(
     std::string, hint_file, "",
@@ -69,6 +72,12 @@ ABSL_FLAG(bool, wcnf_use_strong_slack, true,
           "enforce the fact that when it is true, the clause must be false.");
 ABSL_FLAG(bool, fingerprint_intermediate_solutions, false,
           "Attach the fingerprint of intermediate solutions to the output.");
+ABSL_FLAG(std::string, benchmark_report, "",
+          "If non-empty, append one CSV line with the name of the input, the "
+          "status, the wall, user and deterministic times, the number of "
+          "branches and conflicts, and the objective and bound of the solve to "
+          "this file, after a header line if the file does not exist. Running "
+          "the same instances with two versions gives comparable reports.");
 
 namespace operations_research {
 namespace sat {
@@ -112,6 +121,10 @@ bool LoadProblem(const std::string& filename, absl::string_view hint_file,
     if (!reader.Load(filename, cp_model)) {
       LOG(FATAL) << "Cannot load file '" << filename << "'.";
     }
+  } else if (absl::EndsWith(filename, ".columnar")) {
+    std::string data;
+    CHECK_OK(file::GetContents(filename, &data, file::Defaults()));
+    CHECK_OK(ColumnarStringToCpModel(data, cp_model));
   } else {
     CHECK_OK(ReadFileToProto(filename, cp_model));
   }
@@ -166,6 +179,26 @@ bool LoadProblem(const std::string& filename, absl::string_view hint_file,
   return true;
 }
 
+// Appends the statistics of the solve to the --benchmark_report file.
+void AppendToBenchmarkReport(absl::string_view report_file,
+                             absl::string_view input,
+                             const CpSolverResponse& response) {
+  const bool write_header = !File::Exists(report_file);
+  File* file = file::OpenOrDie(report_file, "a", file::Defaults());
+  if (write_header) {
+    file->WriteString(
+        "input,status,wall_time,user_time,deterministic_time,num_branches,"
+        "num_conflicts,objective,best_objective_bound\n");
+  }
+  file->WriteString(absl::StrFormat(
+      "%s,%s,%.6f,%.6f,%.6f,%d,%d,%.17g,%.17g\n", file::Basename(input),
+      CpSolverStatus_Name(response.status()), response.wall_time(),
+      response.user_time(), response.deterministic_time(),
+      response.num_branches(), response.num_conflicts(),
+      response.objective_value(), response.best_objective_bound()));
+  CHECK_OK(file->Close(file::Defaults()));
+}
+
 int Run() {
   SatParameters parameters;
   if (absl::GetFlag(FLAGS_input).empty()) {
@@ -214,6 +247,11 @@ int Run() {
     }
   }
 
+  if (!absl::GetFlag(FLAGS_benchmark_report).empty()) {
+    AppendToBenchmarkReport(absl::GetFlag(FLAGS_benchmark_report),
+                            absl::GetFlag(FLAGS_input), response);
+  }
+
   // The SAT competition requires a particular exit code and since we don't
   // really use it for any other purpose, we comply.
   if (response.status() == CpSolverStatus::OPTIMAL) return 10;
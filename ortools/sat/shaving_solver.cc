@@ -13,7 +13,9 @@
 
 #include "ortools/sat/shaving_solver.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <string>
@@ -38,6 +40,7 @@
 #include "ortools/sat/subsolver.h"
 #include "ortools/sat/synchronization.h"
 #include "ortools/sat/util.h"
+#include "ortools/util/saturated_arithmetic.h"
 #include "ortools/util/sorted_interval_list.h"
 #include "ortools/util/time_limit.h"
 
@@ -266,6 +269,31 @@ VariablesShavingSolver::VariablesShavingSolver(
   for (const IntegerVariableProto& var_proto : model_proto_.variables()) {
     var_domains_.push_back(ReadDomainFromProto(var_proto));
   }
+
+  // We shave the objective variables first, by decreasing impact on the
+  // objective, i.e. coefficient times domain width, as tightening them is
+  // more likely to improve the objective bounds. The other variables follow
+  // in their model order.
+  std::vector<std::pair<int64_t, int>> objective_impacts;
+  std::vector<bool> is_in_objective(var_domains_.size(), false);
+  for (int i = 0; i < model_proto_.objective().vars_size(); ++i) {
+    const int var = PositiveRef(model_proto_.objective().vars(i));
+    if (is_in_objective[var]) continue;
+    is_in_objective[var] = true;
+    const Domain& domain = var_domains_[var];
+    const int64_t impact =
+        CapProd(std::abs(model_proto_.objective().coeffs(i)),
+                CapSub(domain.Max(), domain.Min()));
+    objective_impacts.push_back({-impact, var});
+  }
+  std::sort(objective_impacts.begin(), objective_impacts.end());
+  shaving_order_.reserve(var_domains_.size());
+  for (const auto& [unused, var] : objective_impacts) {
+    shaving_order_.push_back(var);
+  }
+  for (int var = 0; var < var_domains_.size(); ++var) {
+    if (!is_in_objective[var]) shaving_order_.push_back(var);
+  }
 }
 
 VariablesShavingSolver::~VariablesShavingSolver() {
@@ -392,12 +420,12 @@ bool VariablesShavingSolver::ConstraintIsInactive(int c) const
 }
 
 bool VariablesShavingSolver::FindNextVar(State* state)
-    ABSL_SHARED_LOCKS_REQUIRED(mutex_) {
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
   const int num_vars = var_domains_.size();
   const int max_index = 2 * num_vars;
   for (int i = 0; i < 2 * num_vars; ++i) {
     if (++current_index_ == max_index) current_index_ = 0;
-    const int var = current_index_ / 2;
+    const int var = shaving_order_[current_index_ / 2];
     if (VarIsFixed(var)) continue;
     // Let's not shave the single var objective. There are enough workers
     // looking at it.
@@ -508,10 +536,16 @@ bool VariablesShavingSolver::ResetModel(int64_t task_id, State* state,
   {
     absl::MutexLock lock(&mutex_);
     if (!FindNextVar(state)) return false;
-    CopyModelConnectedToVar(state, local_sat_model, shaving_proto);
     ++num_vars_tried_;
   }
 
+  // Extracting the connected component of the variable scans the whole model,
+  // so we only hold a reader lock to not serialize the concurrent tasks.
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    CopyModelConnectedToVar(state, local_sat_model, shaving_proto);
+  }
+
   auto* time_limit = local_sat_model->GetOrCreate<TimeLimit>();
   shared_->time_limit->UpdateLocalLimit(time_limit);
   time_limit->RegisterSecondaryExternalBooleanAsLimit(&stop_current_chunk_);
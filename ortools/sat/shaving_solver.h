@@ -108,7 +108,7 @@ class VariablesShavingSolver : public SubSolver {
 
   bool ConstraintIsInactive(int c) const ABSL_SHARED_LOCKS_REQUIRED(mutex_);
 
-  bool FindNextVar(State* state) ABSL_SHARED_LOCKS_REQUIRED(mutex_);
+  bool FindNextVar(State* state) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   void CopyModelConnectedToVar(State* state, Model* local_sat_model,
                                CpModelProto* shaving_proto)
@@ -128,8 +128,12 @@ class VariablesShavingSolver : public SubSolver {
 
   const CpModelProto& model_proto_;
 
+  // The order in which the variables are shaved. This is fixed at
+  // construction.
+  std::vector<int> shaving_order_;
+
   absl::Mutex mutex_;
-  int current_index_ = -1;
+  int current_index_ ABSL_GUARDED_BY(mutex_) = -1;
   std::vector<Domain> var_domains_ ABSL_GUARDED_BY(mutex_);
 
   // Stats.
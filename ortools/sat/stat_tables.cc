@@ -27,6 +27,7 @@
 #include "ortools/lp_data/lp_types.h"
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_lns.h"
+#include "ortools/sat/integer.h"
 #include "ortools/sat/linear_programming_constraint.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_solver.h"
@@ -227,6 +228,27 @@ void SharedStatTables::AddLpStat(absl::string_view name, Model* model) {
                                             FormatCounter(num_add_cut_calls))});
 }
 
+void SharedStatTables::AddPropagatorStat(Model* model) {
+  const GenericLiteralWatcher* watcher = model->Get<GenericLiteralWatcher>();
+  if (watcher == nullptr) return;
+  const std::vector<GenericLiteralWatcher::PropagatorStats>& all_stats =
+      watcher->PropagatorStatistics();
+  if (all_stats.empty()) return;
+
+  absl::MutexLock mutex_lock(&mutex_);
+  for (int id = 0; id < all_stats.size(); ++id) {
+    const GenericLiteralWatcher::PropagatorStats& stats = all_stats[id];
+    PropagatorProfile& profile =
+        propagator_profiles_[watcher->PropagatorName(id)];
+    ++profile.num_instances;
+    profile.num_calls += stats.num_calls;
+    profile.num_literal_pushes += stats.num_literal_pushes;
+    profile.num_integer_pushes += stats.num_integer_pushes;
+    profile.estimated_seconds += stats.EstimatedSeconds();
+    profile.deterministic_time += stats.deterministic_time;
+  }
+}
+
 void SharedStatTables::AddLnsStat(absl::string_view name,
                                   const NeighborhoodGenerator& generator) {
   absl::MutexLock mutex_lock(&mutex_);
@@ -314,6 +336,28 @@ void SharedStatTables::Display(SolverLogger* logger) {
     if (table.size() > 1) SOLVER_LOG(logger, FormatTable(table));
   }
 
+  if (!propagator_profiles_.empty()) {
+    std::vector<std::pair<std::string, PropagatorProfile>> sorted(
+        propagator_profiles_.begin(), propagator_profiles_.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const auto& a, const auto& b) {
+                       return a.second.deterministic_time >
+                              b.second.deterministic_time;
+                     });
+    std::vector<std::vector<std::string>> table;
+    table.push_back({"Propagators", "Instances", "Calls", "LitPushes",
+                     "IntPushes", "Time(est)", "DTime"});
+    for (const auto& [name, profile] : sorted) {
+      table.push_back({FormatName(name), FormatCounter(profile.num_instances),
+                       FormatCounter(profile.num_calls),
+                       FormatCounter(profile.num_literal_pushes),
+                       FormatCounter(profile.num_integer_pushes),
+                       absl::StrFormat("%.2fs", profile.estimated_seconds),
+                       absl::StrFormat("%.2f", profile.deterministic_time)});
+    }
+    SOLVER_LOG(logger, FormatTable(table));
+  }
+
   if (lns_table_.size() > 1) SOLVER_LOG(logger, FormatTable(lns_table_));
   if (ls_table_.size() > 1) SOLVER_LOG(logger, FormatTable(ls_table_));
 }
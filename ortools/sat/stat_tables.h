@@ -14,10 +14,12 @@
 #ifndef OR_TOOLS_SAT_STAT_TABLES_H_
 #define OR_TOOLS_SAT_STAT_TABLES_H_
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/btree_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "ortools/sat/cp_model_lns.h"
@@ -42,6 +44,10 @@ class SharedStatTables {
 
   void AddLpStat(absl::string_view name, Model* model);
 
+  // Sums the profile of the propagators of the given model, per class. This
+  // does nothing if the parameter collect_propagator_statistics is false.
+  void AddPropagatorStat(Model* model);
+
   void AddLnsStat(absl::string_view name,
                   const NeighborhoodGenerator& generator);
 
@@ -73,6 +79,18 @@ class SharedStatTables {
   // This one is dynamic, so we generate it in Display().
   std::vector<std::pair<std::string, absl::btree_map<std::string, int>>>
       lp_cut_table_ ABSL_GUARDED_BY(mutex_);
+
+  // This one is also generated in Display(), sorted by deterministic time.
+  struct PropagatorProfile {
+    int64_t num_instances = 0;
+    int64_t num_calls = 0;
+    int64_t num_literal_pushes = 0;
+    int64_t num_integer_pushes = 0;
+    double estimated_seconds = 0.0;
+    double deterministic_time = 0.0;
+  };
+  absl::btree_map<std::string, PropagatorProfile> propagator_profiles_
+      ABSL_GUARDED_BY(mutex_);
 };
 
 }  // namespace operations_research::sat
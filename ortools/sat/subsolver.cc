@@ -14,6 +14,7 @@
 #include "ortools/sat/subsolver.h"
 
 #include <cstdint>
+#include <fstream>
 #include <functional>
 #include <memory>
 #include <string>
@@ -22,6 +23,9 @@
 
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "absl/synchronization/mutex.h"
@@ -43,18 +47,47 @@ namespace {
 // only SubSolvers for which TaskIsAvailable() is true are considered. Return -1
 // if no SubSolver can generate a new task.
 //
-// For now we use a really basic logic: call the least frequently called.
+// For now we use a really basic logic: call the least frequently called. The
+// subsolvers with UseSelectionScore() are considered as a single one that was
+// called as often as the average of its members, and we select the member with
+// the best score (ties are broken by the number of calls).
 int NextSubsolverToSchedule(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
                             absl::Span<const int64_t> num_generated_tasks) {
+  int num_scored = 0;
+  int64_t num_scored_tasks = 0;
+  for (int i = 0; i < subsolvers.size(); ++i) {
+    if (subsolvers[i] == nullptr) continue;
+    if (subsolvers[i]->UseSelectionScore()) {
+      ++num_scored;
+      num_scored_tasks += num_generated_tasks[i];
+    }
+  }
+
   int best = -1;
+  int best_scored = -1;
+  double best_score = 0.0;
   for (int i = 0; i < subsolvers.size(); ++i) {
     if (subsolvers[i] == nullptr) continue;
-    if (subsolvers[i]->TaskIsAvailable()) {
-      if (best == -1 || num_generated_tasks[i] < num_generated_tasks[best]) {
-        best = i;
+    if (!subsolvers[i]->TaskIsAvailable()) continue;
+    if (subsolvers[i]->UseSelectionScore()) {
+      const double score = subsolvers[i]->GetSelectionScore(num_scored_tasks);
+      if (best_scored == -1 || score > best_score ||
+          (score == best_score &&
+           num_generated_tasks[i] < num_generated_tasks[best_scored])) {
+        best_scored = i;
+        best_score = score;
       }
+      continue;
+    }
+    if (best == -1 || num_generated_tasks[i] < num_generated_tasks[best]) {
+      best = i;
     }
   }
+  if (best_scored != -1 &&
+      (best == -1 ||
+       num_scored_tasks < num_generated_tasks[best] * num_scored)) {
+    best = best_scored;
+  }
   if (best != -1) VLOG(1) << "Scheduling " << subsolvers[best]->name();
   return best;
 }
@@ -106,19 +139,68 @@ void SequentialLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers) {
 // On portable platform, we don't support multi-threading for now.
 
 void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                          int num_threads) {
+                          int num_threads, bool numa_aware_worker_placement) {
   SequentialLoop(subsolvers);
 }
 
 void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                       int num_threads, int batch_size, int max_num_batches) {
+                       int num_threads, int batch_size, int max_num_batches,
+                       bool numa_aware_worker_placement) {
   SequentialLoop(subsolvers);
 }
 
 #else  // __PORTABLE_PLATFORM__
 
+namespace {
+
+// Returns the list of cpus of each NUMA node of the machine, or an empty
+// vector if there is only one node or if this information is not available.
+//
+// This reads /sys/devices/system/node/node<i>/cpulist which is a list of
+// comma-separated ranges like "0-15,32-47".
+std::vector<std::vector<int>> NumaNodeCpuSets() {
+  std::vector<std::vector<int>> result;
+#if defined(__linux__)
+  for (int node = 0;; ++node) {
+    std::ifstream input(absl::StrCat("/sys/devices/system/node/node", node,
+                                     "/cpulist"));
+    std::string cpu_list;
+    if (!input || !std::getline(input, cpu_list)) break;
+    std::vector<int> cpus;
+    for (const absl::string_view range :
+         absl::StrSplit(cpu_list, ',', absl::SkipWhitespace())) {
+      const std::vector<absl::string_view> bounds = absl::StrSplit(range, '-');
+      int first, last;
+      if (!absl::SimpleAtoi(bounds[0], &first)) return {};
+      if (bounds.size() == 1) {
+        last = first;
+      } else if (bounds.size() != 2 || !absl::SimpleAtoi(bounds[1], &last)) {
+        return {};
+      }
+      for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    if (!cpus.empty()) result.push_back(std::move(cpus));
+  }
+#endif  // __linux__
+  if (result.size() <= 1) result.clear();
+  return result;
+}
+
+void MaybeSetNumaAwarePlacement(bool numa_aware_worker_placement,
+                                ThreadPool* pool) {
+  if (!numa_aware_worker_placement) return;
+  std::vector<std::vector<int>> cpu_sets = NumaNodeCpuSets();
+  if (cpu_sets.empty()) return;
+  VLOG(1) << "Placing the worker threads on " << cpu_sets.size()
+          << " NUMA nodes.";
+  pool->SetWorkerCpuSets(std::move(cpu_sets));
+}
+
+}  // namespace
+
 void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                       int num_threads, int batch_size, int max_num_batches) {
+                       int num_threads, int batch_size, int max_num_batches,
+                       bool numa_aware_worker_placement) {
   CHECK_GT(num_threads, 0);
   CHECK_GT(batch_size, 0);
   if (batch_size == 1) {
@@ -133,6 +215,7 @@ void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
   std::vector<double> timing;
   to_run.reserve(batch_size);
   ThreadPool pool("DeterministicLoop", num_threads);
+  MaybeSetNumaAwarePlacement(numa_aware_worker_placement, &pool);
   pool.StartWorkers();
   for (int batch_index = 0;; ++batch_index) {
     VLOG(2) << "Starting deterministic batch of size " << batch_size;
@@ -185,7 +268,8 @@ void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
 }
 
 void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                          const int num_threads) {
+                          const int num_threads,
+                          bool numa_aware_worker_placement) {
   CHECK_GT(num_threads, 0);
   if (num_threads == 1) {
     return SequentialLoop(subsolvers);
@@ -204,6 +288,7 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
   };
 
   ThreadPool pool("NonDeterministicLoop", num_threads);
+  MaybeSetNumaAwarePlacement(numa_aware_worker_placement, &pool);
   pool.StartWorkers();
 
   // The lambda below are using little space, but there is no reason
@@ -88,6 +88,20 @@ class SubSolver {
   // This is only called by the main thread.
   virtual std::function<void()> GenerateTask(int64_t task_id) = 0;
 
+  // If this returns true, this SubSolver is part of a group of subsolvers that
+  // share their scheduling slots. The group as a whole gets as many tasks as
+  // its members would get with the default selection logic, but each task is
+  // generated by the available member with the highest GetSelectionScore().
+  //
+  // This is only called by the main thread.
+  virtual bool UseSelectionScore() const { return false; }
+
+  // The score used above, higher is better. total_num_tasks is the number of
+  // tasks generated so far by all the members of the group.
+  virtual double GetSelectionScore(int64_t /*total_num_tasks*/) const {
+    return 0.0;
+  }
+
   // Returns the total deterministic time spend by the completed tasks before
   // the last Synchronize() call.
   double deterministic_time() const { return deterministic_time_; }
@@ -162,8 +176,12 @@ class SynchronizationPoint : public SubSolver {
 // Note that it is okay to incorporate "special" subsolver that never produce
 // any tasks. This can be used to synchronize classes used by many subsolvers
 // just once for instance.
+//
+// If numa_aware_worker_placement is true and the machine has more than one
+// NUMA node, each thread is restricted to the cpus of one node.
 void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
-                          int num_threads);
+                          int num_threads,
+                          bool numa_aware_worker_placement = false);
 
 // Similar to NonDeterministicLoop() except this should result in a
 // deterministic solver provided that all SubSolver respect the Synchronize()
@@ -179,7 +197,8 @@ void NonDeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
 // If max_num_batches is > 0, stop after that many batches.
 void DeterministicLoop(std::vector<std::unique_ptr<SubSolver>>& subsolvers,
                        int num_threads, int batch_size,
-                       int max_num_batches = 0);
+                       int max_num_batches = 0,
+                       bool numa_aware_worker_placement = false);
 
 // Same as above, but specialized implementation for the case num_threads=1.
 // This avoids using a Threadpool altogether. It should have the same behavior
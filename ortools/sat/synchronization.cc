@@ -84,7 +84,7 @@ void SharedLPSolutionRepository::NewLPSolution(
   absl::MutexLock mutex_lock(&mutex_);
   solution.rank = -num_synchronization_;
   ++num_added_;
-  new_solutions_.push_back(solution);
+  AddInternal(solution);
 }
 
 void SharedIncompleteSolutionManager::AddSolution(
@@ -833,7 +833,8 @@ SharedBoundsManager::SharedBoundsManager(const CpModelProto& model_proto)
       synchronized_lower_bounds_(num_variables_,
                                  std::numeric_limits<int64_t>::min()),
       synchronized_upper_bounds_(num_variables_,
-                                 std::numeric_limits<int64_t>::max()) {
+                                 std::numeric_limits<int64_t>::max()),
+      last_change_position_(num_variables_, -1) {
   changed_variables_since_last_synchronize_.ClearAndResize(num_variables_);
   for (int i = 0; i < num_variables_; ++i) {
     lower_bounds_[i] = model_proto.variables(i).domain(0);
@@ -959,16 +960,31 @@ void SharedBoundsManager::Synchronize() {
        changed_variables_since_last_synchronize_.PositionsSetAtLeastOnce()) {
     synchronized_lower_bounds_[var] = lower_bounds_[var];
     synchronized_upper_bounds_[var] = upper_bounds_[var];
-    for (int j = 0; j < id_to_changed_variables_.size(); ++j) {
-      id_to_changed_variables_[j].Set(var);
-    }
+    last_change_position_[var] =
+        synchronized_changes_offset_ + synchronized_changes_.size();
+    synchronized_changes_.push_back(var);
   }
   changed_variables_since_last_synchronize_.ClearAll();
+
+  // Discard the part of the log seen by all ids once it is large enough.
+  int64_t min_position =
+      synchronized_changes_offset_ + synchronized_changes_.size();
+  for (const int64_t position : id_to_next_change_position_) {
+    min_position = std::min(min_position, position);
+  }
+  const int64_t num_seen = min_position - synchronized_changes_offset_;
+  if (2 * num_seen >= synchronized_changes_.size()) {
+    synchronized_changes_.erase(synchronized_changes_.begin(),
+                                synchronized_changes_.begin() + num_seen);
+    synchronized_changes_offset_ = min_position;
+  }
 }
 
 int SharedBoundsManager::RegisterNewId() {
   absl::MutexLock mutex_lock(&mutex_);
   const int id = id_to_changed_variables_.size();
+  id_to_next_change_position_.push_back(synchronized_changes_offset_ +
+                                        synchronized_changes_.size());
   id_to_changed_variables_.resize(id + 1);
   id_to_changed_variables_[id].ClearAndResize(num_variables_);
   for (int var = 0; var < num_variables_; ++var) {
@@ -991,15 +1007,44 @@ void SharedBoundsManager::GetChangedBounds(
   new_upper_bounds->clear();
 
   absl::MutexLock mutex_lock(&mutex_);
-  for (const int var : id_to_changed_variables_[id].PositionsSetAtLeastOnce()) {
-    variables->push_back(var);
-  }
-  id_to_changed_variables_[id].ClearAll();
+  const int64_t begin = id_to_next_change_position_[id];
+  const int64_t end =
+      synchronized_changes_offset_ + synchronized_changes_.size();
+  id_to_next_change_position_[id] = end;
+  const auto change = [this](int64_t position) {
+    return synchronized_changes_[position - synchronized_changes_offset_];
+  };
 
   // We need to report the bounds in a deterministic order as it is difficult to
   // guarantee that nothing depend on the order in which the new bounds are
   // processed.
-  absl::c_sort(*variables);
+  SparseBitset<int>& initial_changes = id_to_changed_variables_[id];
+  if (!initial_changes.PositionsSetAtLeastOnce().empty()) {
+    // This only happens on the first call after RegisterNewId().
+    for (int64_t p = begin; p < end; ++p) initial_changes.Set(change(p));
+    for (const int var : initial_changes.PositionsSetAtLeastOnce()) {
+      variables->push_back(var);
+    }
+    initial_changes.ClearAll();
+    absl::c_sort(*variables);
+  } else if (4 * (end - begin) >= num_variables_) {
+    // When a large fraction of the variables changed, a single linear scan over
+    // the positions is faster than sorting, and the result is already sorted.
+    for (int var = 0; var < num_variables_; ++var) {
+      if (last_change_position_[var] >= begin) variables->push_back(var);
+    }
+  } else {
+    // A variable might appear more than once in the log, we only keep its
+    // last occurrence.
+    for (int64_t p = begin; p < end; ++p) {
+      const int var = change(p);
+      if (last_change_position_[var] == p) variables->push_back(var);
+    }
+    absl::c_sort(*variables);
+  }
+
+  new_lower_bounds->reserve(variables->size());
+  new_upper_bounds->reserve(variables->size());
   for (const int var : *variables) {
     new_lower_bounds->push_back(synchronized_lower_bounds_[var]);
     new_upper_bounds->push_back(synchronized_upper_bounds_[var]);
@@ -1189,6 +1234,7 @@ int SharedClausesManager::RegisterNewId() {
   id_to_last_finished_batch_.resize(id + 1, 0);
   id_to_clauses_exported_.resize(id + 1, 0);
   id_to_clause_stream_.emplace_back();
+  id_to_binary_clause_buffer_.emplace_back();
   return id;
 }
 
@@ -1198,24 +1244,28 @@ void SharedClausesManager::SetWorkerNameForId(int id,
   id_to_worker_name_[id] = worker_name;
 }
 
-void SharedClausesManager::AddBinaryClause(int id, int lit1, int lit2) {
-  if (lit2 < lit1) std::swap(lit1, lit2);
-  const auto p = std::make_pair(lit1, lit2);
-
-  absl::MutexLock mutex_lock(&mutex_);
-  const auto [unused_it, inserted] = added_binary_clauses_set_.insert(p);
-  if (inserted) {
-    added_binary_clauses_.push_back(p);
-    if (always_synchronize_) ++last_visible_binary_clause_;
-    id_to_clauses_exported_[id]++;
-
-    // Small optim. If the worker is already up to date with clauses to import,
-    // we can mark this new clause as already seen.
-    if (id_to_last_processed_binary_clause_[id] ==
-        added_binary_clauses_.size() - 1) {
-      id_to_last_processed_binary_clause_[id]++;
+void SharedClausesManager::CollectBufferedBinaryClauses() {
+  const int num_workers = id_to_binary_clause_buffer_.size();
+  for (int id = 0; id < num_workers; ++id) {
+    tmp_binary_clauses_.clear();
+    id_to_binary_clause_buffer_[id].AppendAndClear(&tmp_binary_clauses_);
+    for (const std::pair<int, int>& p : tmp_binary_clauses_) {
+      const auto [unused_it, inserted] = added_binary_clauses_set_.insert(p);
+      if (!inserted) continue;
+      added_binary_clauses_.push_back(p);
+      id_to_clauses_exported_[id]++;
+
+      // Small optim. If the worker is already up to date with clauses to
+      // import, we can mark this new clause as already seen.
+      if (id_to_last_processed_binary_clause_[id] ==
+          added_binary_clauses_.size() - 1) {
+        id_to_last_processed_binary_clause_[id]++;
+      }
     }
   }
+  if (always_synchronize_) {
+    last_visible_binary_clause_ = added_binary_clauses_.size();
+  }
 }
 
 std::vector<absl::Span<const int>> SharedClausesManager::GetUnseenClauses(
@@ -1236,6 +1286,7 @@ void SharedClausesManager::GetUnseenBinaryClauses(
     int id, std::vector<std::pair<int, int>>* new_clauses) {
   new_clauses->clear();
   absl::MutexLock mutex_lock(&mutex_);
+  if (always_synchronize_) CollectBufferedBinaryClauses();
   const int last_binary_clause_seen = id_to_last_processed_binary_clause_[id];
   if (last_binary_clause_seen >= last_visible_binary_clause_) return;
 
@@ -1264,6 +1315,7 @@ void SharedClausesManager::LogStatistics(SolverLogger* logger) {
 
 void SharedClausesManager::Synchronize() {
   absl::MutexLock mutex_lock(&mutex_);
+  CollectBufferedBinaryClauses();
   last_visible_binary_clause_ = added_binary_clauses_.size();
   const int num_workers = id_to_clause_stream_.size();
   if (num_workers <= 1) return;
@@ -1355,6 +1407,147 @@ void SharedClausesManager::Synchronize() {
   // TODO(user): We could cleanup binary clauses that have been consumed.
 }
 
+int SharedCutPool::RegisterNewId() {
+  absl::MutexLock mutex_lock(&mutex_);
+  const int id = id_to_next_cut_.size();
+  id_to_next_cut_.push_back(0);
+  id_to_num_exported_.push_back(0);
+  id_to_num_imported_.push_back(0);
+  id_to_worker_name_.push_back("");
+  return id;
+}
+
+void SharedCutPool::SetWorkerNameForId(int id, absl::string_view worker_name) {
+  absl::MutexLock mutex_lock(&mutex_);
+  id_to_worker_name_[id] = std::string(worker_name);
+}
+
+bool SharedCutPool::AddCut(int id, absl::Span<const int> vars,
+                           absl::Span<const int64_t> coeffs, int64_t lb,
+                           int64_t ub) {
+  DCHECK_EQ(vars.size(), coeffs.size());
+  DCHECK(std::is_sorted(vars.begin(), vars.end()));
+  const size_t hash = absl::HashOf(vars, coeffs);
+
+  absl::MutexLock mutex_lock(&mutex_);
+  if (cuts_.size() >= max_num_cuts_) return false;
+  const auto [it, inserted] = hash_to_cut_.insert({hash, cuts_.size()});
+  if (!inserted) {
+    const Cut& old_cut = cuts_[it->second];
+    if (absl::MakeConstSpan(old_cut.vars) == vars &&
+        absl::MakeConstSpan(old_cut.coeffs) == coeffs) {
+      if (lb <= old_cut.lb && ub >= old_cut.ub) return false;
+      lb = std::max(lb, old_cut.lb);
+      ub = std::min(ub, old_cut.ub);
+    }
+
+    // If this is a hash collision, we just keep the new cut in the map.
+    it->second = cuts_.size();
+  }
+  cuts_.push_back({std::vector<int>(vars.begin(), vars.end()),
+                   std::vector<int64_t>(coeffs.begin(), coeffs.end()), lb,
+                   ub});
+  cut_to_id_.push_back(id);
+  id_to_num_exported_[id]++;
+  return true;
+}
+
+void SharedCutPool::GetUnseenCuts(int id, std::vector<Cut>* cuts) {
+  absl::MutexLock mutex_lock(&mutex_);
+  const int num_cuts = cuts_.size();
+  for (int i = id_to_next_cut_[id]; i < num_cuts; ++i) {
+    if (cut_to_id_[i] == id) continue;
+    cuts->push_back(cuts_[i]);
+    id_to_num_imported_[id]++;
+  }
+  id_to_next_cut_[id] = num_cuts;
+}
+
+void SharedCutPool::LogStatistics(SolverLogger* logger) {
+  absl::MutexLock mutex_lock(&mutex_);
+  std::vector<std::vector<std::string>> table;
+  table.push_back({"Cuts shared", "Exported", "Imported"});
+  for (int id = 0; id < id_to_next_cut_.size(); ++id) {
+    if (id_to_num_exported_[id] == 0 && id_to_num_imported_[id] == 0) {
+      continue;
+    }
+    table.push_back({FormatName(id_to_worker_name_[id]),
+                     FormatCounter(id_to_num_exported_[id]),
+                     FormatCounter(id_to_num_imported_[id])});
+  }
+  if (table.size() > 1) SOLVER_LOG(logger, FormatTable(table));
+}
+
+SharedPseudoCosts::SharedPseudoCosts(int num_proto_variables)
+    : num_keys_(2 * num_proto_variables),
+      sums_(NUM_TYPES),
+      num_records_(NUM_TYPES),
+      updates_(NUM_TYPES) {}
+
+int SharedPseudoCosts::RegisterNewId() {
+  absl::MutexLock mutex_lock(&mutex_);
+  const int id = id_to_next_update_.size();
+  id_to_next_update_.push_back(std::vector<int>(NUM_TYPES, 0));
+  id_to_num_exported_.push_back(0);
+  id_to_num_imported_.push_back(0);
+  id_to_worker_name_.push_back("");
+  return id;
+}
+
+void SharedPseudoCosts::SetWorkerNameForId(int id,
+                                           absl::string_view worker_name) {
+  absl::MutexLock mutex_lock(&mutex_);
+  id_to_worker_name_[id] = std::string(worker_name);
+}
+
+void SharedPseudoCosts::AddRecords(int id, Type type,
+                                   absl::Span<const Record> records) {
+  if (records.empty()) return;
+  absl::MutexLock mutex_lock(&mutex_);
+
+  // We only allocate the statistics of a type on its first use.
+  if (sums_[type].empty()) {
+    sums_[type].assign(num_keys_, 0.0);
+    num_records_[type].assign(num_keys_, 0);
+  }
+  for (const Record& record : records) {
+    DCHECK_GE(record.key, 0);
+    DCHECK_LT(record.key, num_keys_);
+    sums_[type][record.key] += record.sum;
+    num_records_[type][record.key] += record.num_records;
+    updates_[type].push_back({record.key, id});
+  }
+  id_to_num_exported_[id] += records.size();
+}
+
+void SharedPseudoCosts::GetUpdatedRecords(int id, Type type,
+                                          std::vector<Record>* records) {
+  absl::MutexLock mutex_lock(&mutex_);
+  const int num_updates = updates_[type].size();
+  for (int i = id_to_next_update_[id][type]; i < num_updates; ++i) {
+    const auto [key, update_id] = updates_[type][i];
+    if (update_id == id) continue;
+    records->push_back({key, sums_[type][key], num_records_[type][key]});
+    id_to_num_imported_[id]++;
+  }
+  id_to_next_update_[id][type] = num_updates;
+}
+
+void SharedPseudoCosts::LogStatistics(SolverLogger* logger) {
+  absl::MutexLock mutex_lock(&mutex_);
+  std::vector<std::vector<std::string>> table;
+  table.push_back({"Pseudo-costs shared", "Exported", "Imported"});
+  for (int id = 0; id < id_to_next_update_.size(); ++id) {
+    if (id_to_num_exported_[id] == 0 && id_to_num_imported_[id] == 0) {
+      continue;
+    }
+    table.push_back({FormatName(id_to_worker_name_[id]),
+                     FormatCounter(id_to_num_exported_[id]),
+                     FormatCounter(id_to_num_imported_[id])});
+  }
+  if (table.size() > 1) SOLVER_LOG(logger, FormatTable(table));
+}
+
 void SharedStatistics::AddStats(
     absl::Span<const std::pair<std::string, int64_t>> stats) {
   absl::MutexLock mutex_lock(&mutex_);
@@ -20,11 +20,14 @@
 #include <cstdint>
 #include <deque>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "absl/base/casts.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
@@ -45,6 +48,7 @@
 #include "ortools/sat/util.h"
 #include "ortools/util/bitset.h"
 #include "ortools/util/logging.h"
+#include "ortools/util/packed_int64_vector.h"
 #include "ortools/util/sorted_interval_list.h"
 
 namespace operations_research {
@@ -52,6 +56,14 @@ namespace sat {
 
 // Thread-safe. Keeps a set of n unique best solution found so far.
 //
+// The solutions are stored in a compact form, so that large pools of solutions
+// of large models fit in memory: the best solution is bit-packed (see
+// PackedInt64Vector, a Boolean variable uses one bit), and the other ones only
+// store their packed differences to it. As the solutions of a pool are usually
+// close to each other, most of their blocks of 64 variables then use no bit.
+// The solutions are unpacked by GetSolution() and GetRandomBiasedSolution(),
+// which thus work in O(num_variables).
+//
 // TODO(user): Maybe add some criteria to only keep solution with an objective
 // really close to the best solution.
 template <typename ValueType>
@@ -122,7 +134,8 @@ class SharedSolutionRepository {
   // independent on the order of the calls to AddSolution() provided that the
   // set of added solutions is the same.
   //
-  // Works in O(num_solutions_to_keep_).
+  // Works in O(num_solutions_to_keep_), plus O(num_solutions_to_keep_ *
+  // num_variables) when the best solution changes and the pool is re-encoded.
   void Synchronize();
 
   std::vector<std::string> TableLineStats() const {
@@ -132,6 +145,38 @@ class SharedSolutionRepository {
   }
 
  protected:
+  // A Solution whose values are encoded against reference_.
+  struct PackedSolution {
+    int64_t rank = 0;
+    PackedInt64Vector codes;
+    std::string info;
+    mutable int num_selected = 0;
+  };
+
+  // Encodes `value` against `reference`: their difference for integer values,
+  // the xor of their bits for floating point ones. The code of a value equal
+  // to its reference is zero in both cases.
+  static int64_t Encode(ValueType value, ValueType reference);
+  static ValueType Decode(int64_t code, ValueType reference);
+
+  // Returns the value of `var_index` in the solution encoded by `codes`
+  // against `reference`. The reference values are zero past its end.
+  static ValueType ValueInSolution(const PackedInt64Vector& reference,
+                                   const PackedInt64Vector& codes,
+                                   int var_index);
+
+  // Unpacks a stored solution.
+  Solution Unpack(const PackedSolution& packed) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Adds `solution` to new_solutions_.
+  void AddInternal(const Solution& solution)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Makes solutions_[0] the new reference solution, and re-encodes all the
+  // solutions against it.
+  void UpdateReference() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   const std::string name_;
   const int num_solutions_to_keep_;
 
@@ -143,8 +188,12 @@ class SharedSolutionRepository {
   // Our two solutions pools, the current one and the new one that will be
   // merged into the current one on each Synchronize() calls.
   mutable std::vector<int> tmp_indices_ ABSL_GUARDED_BY(mutex_);
-  std::vector<Solution> solutions_ ABSL_GUARDED_BY(mutex_);
-  std::vector<Solution> new_solutions_ ABSL_GUARDED_BY(mutex_);
+  std::vector<PackedSolution> solutions_ ABSL_GUARDED_BY(mutex_);
+  std::vector<PackedSolution> new_solutions_ ABSL_GUARDED_BY(mutex_);
+
+  // The values of the reference solution, which is solutions_[0] after each
+  // Synchronize(). All the solutions above are encoded against it.
+  PackedInt64Vector reference_ ABSL_GUARDED_BY(mutex_);
 };
 
 class SharedLPSolutionRepository : public SharedSolutionRepository<double> {
@@ -515,7 +564,8 @@ class SharedBoundsManager {
   int RegisterNewId();
 
   // When called, returns the set of bounds improvements since
-  // the last time this method was called with the same id.
+  // the last time this method was called with the same id. The variables are
+  // returned in increasing order.
   void GetChangedBounds(int id, std::vector<int>* variables,
                         std::vector<int64_t>* new_lower_bounds,
                         std::vector<int64_t>* new_upper_bounds);
@@ -559,6 +609,19 @@ class SharedBoundsManager {
   // These are only updated on Synchronize().
   std::vector<int64_t> synchronized_lower_bounds_ ABSL_GUARDED_BY(mutex_);
   std::vector<int64_t> synchronized_upper_bounds_ ABSL_GUARDED_BY(mutex_);
+
+  // Log of the variables whose synchronized bounds changed, each Synchronize()
+  // appends each changed variable once. This way Synchronize() is independent
+  // of the number of ids, and each id just remembers the position of the
+  // first change it hasn't seen yet. The position p of the log is stored in
+  // synchronized_changes_[p - synchronized_changes_offset_], and the prefix
+  // already seen by all ids is discarded from time to time.
+  std::vector<int> synchronized_changes_ ABSL_GUARDED_BY(mutex_);
+  int64_t synchronized_changes_offset_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::vector<int64_t> last_change_position_ ABSL_GUARDED_BY(mutex_);
+  std::vector<int64_t> id_to_next_change_position_ ABSL_GUARDED_BY(mutex_);
+
+  // The variables whose bounds were already tightened when an id registered.
   std::deque<SparseBitset<int>> id_to_changed_variables_
       ABSL_GUARDED_BY(mutex_);
   absl::btree_map<std::string, int> bounds_exported_ ABSL_GUARDED_BY(mutex_);
@@ -677,6 +740,40 @@ class UniqueClauseStream {
       clauses_by_size_ ABSL_GUARDED_BY(mutex_);
 };
 
+// Buffers the binary clauses exported by one worker until they are collected
+// by the SharedClausesManager. Each worker has its own buffer so that learning
+// a binary clause never contends on the lock shared by all the workers: the
+// lock of this class is only taken by its worker, and briefly when the
+// manager moves the clauses to the shared list.
+//
+// It is thread-safe.
+class BinaryClauseBuffer {
+ public:
+  BinaryClauseBuffer() = default;
+
+  // This type is neither copyable nor movable.
+  BinaryClauseBuffer(const BinaryClauseBuffer&) = delete;
+  BinaryClauseBuffer& operator=(const BinaryClauseBuffer&) = delete;
+
+  void Add(int lit1, int lit2) ABSL_LOCKS_EXCLUDED(mutex_) {
+    if (lit2 < lit1) std::swap(lit1, lit2);
+    absl::MutexLock mutex_lock(&mutex_);
+    clauses_.push_back({lit1, lit2});
+  }
+
+  // Appends all the buffered clauses to output and clears the buffer.
+  void AppendAndClear(std::vector<std::pair<int, int>>* output)
+      ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock mutex_lock(&mutex_);
+    output->insert(output->end(), clauses_.begin(), clauses_.end());
+    clauses_.clear();
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<std::pair<int, int>> clauses_ ABSL_GUARDED_BY(mutex_);
+};
+
 // This class holds clauses found and shared by workers.
 // It is exact for binary clauses, but approximate for longer ones.
 //
@@ -688,7 +785,14 @@ class SharedClausesManager {
  public:
   explicit SharedClausesManager(bool always_synchronize,
                                 absl::Duration share_frequency);
-  void AddBinaryClause(int id, int lit1, int lit2);
+
+  // Exports a binary clause. The clause is buffered in the worker own
+  // BinaryClauseBuffer and only becomes visible to the other workers once it
+  // is collected, on the next import if always_synchronize is true and on the
+  // next Synchronize() otherwise.
+  void AddBinaryClause(int id, int lit1, int lit2) {
+    GetBinaryClauseBuffer(id)->Add(lit1, lit2);
+  }
 
   // Returns new glue clauses.
   // The spans are guaranteed to remain valid until the next call to
@@ -713,6 +817,13 @@ class SharedClausesManager {
     return &id_to_clause_stream_[id];
   }
 
+  // Same as GetClauseStream() for binary clauses. A worker that adds a lot of
+  // clauses should keep this pointer rather than calling AddBinaryClause().
+  BinaryClauseBuffer* GetBinaryClauseBuffer(int id) {
+    absl::ReaderMutexLock mutex_lock(&mutex_);
+    return &id_to_binary_clause_buffer_[id];
+  }
+
   // Search statistics.
   void LogStatistics(SolverLogger* logger);
 
@@ -722,6 +833,10 @@ class SharedClausesManager {
 
  private:
   static constexpr int kMinBatches = 10;
+
+  // Moves the clauses buffered by each worker to added_binary_clauses_.
+  void CollectBufferedBinaryClauses() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   absl::Mutex mutex_;
 
   // Binary clauses:
@@ -732,6 +847,9 @@ class SharedClausesManager {
       ABSL_GUARDED_BY(mutex_);
   std::vector<int> id_to_last_processed_binary_clause_ ABSL_GUARDED_BY(mutex_);
   int last_visible_binary_clause_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::deque<BinaryClauseBuffer> id_to_binary_clause_buffer_
+      ABSL_GUARDED_BY(mutex_);
+  std::vector<std::pair<int, int>> tmp_binary_clauses_ ABSL_GUARDED_BY(mutex_);
 
   // Longer clauses:
   UniqueClauseStream all_clauses_ ABSL_GUARDED_BY(mutex_);
@@ -751,6 +869,135 @@ class SharedClausesManager {
   absl::flat_hash_map<int, std::string> id_to_worker_name_;
 };
 
+// This class holds globally valid linear cuts found by the LP of some workers
+// so that the other workers do not need to derive them again.
+//
+// Note that the cuts are expressed in term of the variables of the
+// cp_model.proto, so only the cuts that do not use any variable created during
+// the loading of the model can be shared.
+//
+// It is thread-safe.
+class SharedCutPool {
+ public:
+  struct Cut {
+    // The variables are sorted and all distinct.
+    std::vector<int> vars;
+    std::vector<int64_t> coeffs;
+    int64_t lb;
+    int64_t ub;
+  };
+
+  // Once the pool contains max_num_cuts cuts, new ones are ignored.
+  explicit SharedCutPool(int max_num_cuts) : max_num_cuts_(max_num_cuts) {}
+
+  // This type is neither copyable nor movable.
+  SharedCutPool(const SharedCutPool&) = delete;
+  SharedCutPool& operator=(const SharedCutPool&) = delete;
+
+  // Ids are used to identify which worker is exporting/importing cuts.
+  int RegisterNewId();
+  void SetWorkerNameForId(int id, absl::string_view worker_name);
+
+  // Exports a cut lb <= sum coeffs[i] * vars[i] <= ub, the variables must be
+  // sorted. Returns false if the cut was ignored because a cut with the same
+  // terms and bounds at least as tight is already present, or because the pool
+  // is full. If the cut only tightens the bounds of a known one, it is shared
+  // again.
+  bool AddCut(int id, absl::Span<const int> vars,
+              absl::Span<const int64_t> coeffs, int64_t lb, int64_t ub);
+
+  // Appends to cuts all the cuts exported by the other workers since the last
+  // call with the same id.
+  void GetUnseenCuts(int id, std::vector<Cut>* cuts);
+
+  void LogStatistics(SolverLogger* logger);
+
+ private:
+  const int max_num_cuts_;
+
+  absl::Mutex mutex_;
+  std::vector<Cut> cuts_ ABSL_GUARDED_BY(mutex_);
+  std::vector<int> cut_to_id_ ABSL_GUARDED_BY(mutex_);
+
+  // Hash of the terms of a cut -> index of the last such cut in cuts_.
+  absl::flat_hash_map<size_t, int> hash_to_cut_ ABSL_GUARDED_BY(mutex_);
+
+  std::vector<int> id_to_next_cut_ ABSL_GUARDED_BY(mutex_);
+
+  // Stats.
+  std::vector<int64_t> id_to_num_exported_ ABSL_GUARDED_BY(mutex_);
+  std::vector<int64_t> id_to_num_imported_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::string> id_to_worker_name_ ABSL_GUARDED_BY(mutex_);
+};
+
+// This class holds the pseudo-costs learned by the workers, so that the other
+// workers solving the same model can make good branching decisions earlier.
+//
+// Note that the pseudo-costs are expressed in term of the variables of the
+// cp_model.proto: the key 2 * var (resp. 2 * var + 1) is used for the positive
+// (resp. negative) direction of the variable var. Only the statistics of the
+// variables of the model proto can thus be shared.
+//
+// It is thread-safe.
+class SharedPseudoCosts {
+ public:
+  // The different statistics learned by the PseudoCosts class.
+  enum Type {
+    BOUND_CHANGE = 0,
+    LP_INCREASE = 1,
+    LITERAL = 2,
+    NUM_TYPES = 3,
+  };
+
+  // The sum and number of all the records of a key.
+  struct Record {
+    int key;
+    double sum = 0.0;
+    int64_t num_records = 0;
+  };
+
+  explicit SharedPseudoCosts(int num_proto_variables);
+
+  // This type is neither copyable nor movable.
+  SharedPseudoCosts(const SharedPseudoCosts&) = delete;
+  SharedPseudoCosts& operator=(const SharedPseudoCosts&) = delete;
+
+  // Ids are used to identify which worker is exporting/importing records.
+  int RegisterNewId();
+  void SetWorkerNameForId(int id, absl::string_view worker_name);
+
+  // Adds the given records to the shared statistics of the given type. Each key
+  // must appear at most once.
+  void AddRecords(int id, Type type, absl::Span<const Record> records);
+
+  // Appends to records the current total of all the keys of the given type
+  // that were updated by the other workers since the last call with the same
+  // id. A key can appear more than once.
+  void GetUpdatedRecords(int id, Type type, std::vector<Record>* records);
+
+  void LogStatistics(SolverLogger* logger);
+
+ private:
+  const int num_keys_;
+
+  absl::Mutex mutex_;
+  // Indexed by type, then by key.
+  std::vector<std::vector<double>> sums_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::vector<int64_t>> num_records_ ABSL_GUARDED_BY(mutex_);
+
+  // Indexed by type. The keys updated by each call to AddRecords(), with the
+  // id of the worker that updated them.
+  std::vector<std::vector<std::pair<int, int>>> updates_
+      ABSL_GUARDED_BY(mutex_);
+  // Indexed by id, then by type. The index of the next update to return.
+  std::vector<std::vector<int>> id_to_next_update_ ABSL_GUARDED_BY(mutex_);
+
+  // Stats.
+  std::vector<int64_t> id_to_num_exported_ ABSL_GUARDED_BY(mutex_);
+  std::vector<int64_t> id_to_num_imported_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::string> id_to_worker_name_ ABSL_GUARDED_BY(mutex_);
+};
+
 // Simple class to add statistics by name and print them at the end.
 class SharedStatistics {
  public:
@@ -778,7 +1025,7 @@ typename SharedSolutionRepository<ValueType>::Solution
 SharedSolutionRepository<ValueType>::GetSolution(int i) const {
   absl::MutexLock mutex_lock(&mutex_);
   ++num_queried_;
-  return solutions_[i];
+  return Unpack(solutions_[i]);
 }
 
 template <typename ValueType>
@@ -792,7 +1039,8 @@ template <typename ValueType>
 ValueType SharedSolutionRepository<ValueType>::GetVariableValueInSolution(
     int var_index, int solution_index) const {
   absl::MutexLock mutex_lock(&mutex_);
-  return solutions_[solution_index].variable_values[var_index];
+  return ValueInSolution(reference_, solutions_[solution_index].codes,
+                         var_index);
 }
 
 // TODO(user): Experiments on the best distribution.
@@ -830,7 +1078,7 @@ SharedSolutionRepository<ValueType>::GetRandomBiasedSolution(
     index = tmp_indices_[absl::Uniform<int>(random, 0, tmp_indices_.size())];
   }
   solutions_[index].num_selected++;
-  return solutions_[index];
+  return Unpack(solutions_[index]);
 }
 
 template <typename ValueType>
@@ -838,7 +1086,7 @@ void SharedSolutionRepository<ValueType>::Add(const Solution& solution) {
   if (num_solutions_to_keep_ <= 0) return;
   absl::MutexLock mutex_lock(&mutex_);
   ++num_added_;
-  new_solutions_.push_back(solution);
+  AddInternal(solution);
 }
 
 template <typename ValueType>
@@ -846,18 +1094,37 @@ void SharedSolutionRepository<ValueType>::Synchronize() {
   absl::MutexLock mutex_lock(&mutex_);
   if (new_solutions_.empty()) return;
 
-  solutions_.insert(solutions_.end(), new_solutions_.begin(),
-                    new_solutions_.end());
+  solutions_.insert(solutions_.end(),
+                    std::make_move_iterator(new_solutions_.begin()),
+                    std::make_move_iterator(new_solutions_.end()));
   new_solutions_.clear();
 
+  // All the solutions are encoded against the same reference, so equal
+  // solutions have equal codes, and the first different value of two solutions
+  // is at their first different code.
+  const PackedInt64Vector& reference = reference_;
+  const auto is_better = [&reference](const PackedSolution& a,
+                                      const PackedSolution& b) {
+    if (a.rank != b.rank) return a.rank < b.rank;
+    const int i = a.codes.FirstDifference(b.codes);
+    if (i == a.codes.size() || i == b.codes.size()) {
+      return a.codes.size() < b.codes.size();
+    }
+    return ValueInSolution(reference, a.codes, i) <
+           ValueInSolution(reference, b.codes, i);
+  };
+
   // We use a stable sort to keep the num_selected count for the already
   // existing solutions.
   //
   // TODO(user): Introduce a notion of orthogonality to diversify the pool?
-  gtl::STLStableSortAndRemoveDuplicates(&solutions_);
+  gtl::STLStableSortAndRemoveDuplicates(&solutions_, is_better);
   if (solutions_.size() > num_solutions_to_keep_) {
     solutions_.resize(num_solutions_to_keep_);
   }
+  if (!solutions_.empty() && !solutions_[0].codes.IsZero()) {
+    UpdateReference();
+  }
 
   if (!solutions_.empty()) {
     VLOG(2) << "Solution pool update:" << " num_solutions=" << solutions_.size()
@@ -868,6 +1135,90 @@ void SharedSolutionRepository<ValueType>::Synchronize() {
   num_synchronization_++;
 }
 
+template <typename ValueType>
+int64_t SharedSolutionRepository<ValueType>::Encode(ValueType value,
+                                                    ValueType reference) {
+  if constexpr (std::is_integral_v<ValueType>) {
+    // The unsigned difference cannot overflow.
+    return static_cast<int64_t>(static_cast<uint64_t>(value) -
+                                static_cast<uint64_t>(reference));
+  } else {
+    return absl::bit_cast<int64_t>(value) ^ absl::bit_cast<int64_t>(reference);
+  }
+}
+
+template <typename ValueType>
+ValueType SharedSolutionRepository<ValueType>::Decode(int64_t code,
+                                                      ValueType reference) {
+  if constexpr (std::is_integral_v<ValueType>) {
+    return static_cast<ValueType>(static_cast<uint64_t>(reference) +
+                                  static_cast<uint64_t>(code));
+  } else {
+    return absl::bit_cast<ValueType>(code ^ absl::bit_cast<int64_t>(reference));
+  }
+}
+
+template <typename ValueType>
+ValueType SharedSolutionRepository<ValueType>::ValueInSolution(
+    const PackedInt64Vector& reference, const PackedInt64Vector& codes,
+    int var_index) {
+  const ValueType reference_value =
+      var_index < reference.size() ? Decode(reference[var_index], ValueType{0})
+                                   : ValueType{0};
+  return Decode(codes[var_index], reference_value);
+}
+
+template <typename ValueType>
+typename SharedSolutionRepository<ValueType>::Solution
+SharedSolutionRepository<ValueType>::Unpack(
+    const PackedSolution& packed) const {
+  Solution solution;
+  solution.rank = packed.rank;
+  solution.variable_values.resize(packed.codes.size());
+  for (int i = 0; i < packed.codes.size(); ++i) {
+    solution.variable_values[i] = ValueInSolution(reference_, packed.codes, i);
+  }
+  solution.info = packed.info;
+  solution.num_selected = packed.num_selected;
+  return solution;
+}
+
+template <typename ValueType>
+void SharedSolutionRepository<ValueType>::AddInternal(
+    const Solution& solution) {
+  const std::vector<ValueType>& values = solution.variable_values;
+  const PackedInt64Vector& reference = reference_;
+  PackedSolution packed;
+  packed.rank = solution.rank;
+  packed.codes = PackedInt64Vector(values.size(), [&values, &reference](int i) {
+    return Encode(values[i], i < reference.size()
+                                 ? Decode(reference[i], ValueType{0})
+                                 : ValueType{0});
+  });
+  packed.info = solution.info;
+  packed.num_selected = solution.num_selected;
+  new_solutions_.push_back(std::move(packed));
+}
+
+template <typename ValueType>
+void SharedSolutionRepository<ValueType>::UpdateReference() {
+  // Only one solution is unpacked at a time besides the new reference, to keep
+  // the memory usage low.
+  const std::vector<ValueType> new_reference =
+      Unpack(solutions_[0]).variable_values;
+  for (PackedSolution& packed : solutions_) {
+    const std::vector<ValueType> values = Unpack(packed).variable_values;
+    packed.codes =
+        PackedInt64Vector(values.size(), [&values, &new_reference](int i) {
+          return Encode(values[i], i < new_reference.size() ? new_reference[i]
+                                                            : ValueType{0});
+        });
+  }
+  reference_ = PackedInt64Vector(new_reference.size(), [&new_reference](int i) {
+    return Encode(new_reference[i], ValueType{0});
+  });
+}
+
 }  // namespace sat
 }  // namespace operations_research
 
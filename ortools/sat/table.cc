@@ -13,16 +13,22 @@
 
 #include "ortools/sat/table.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "ortools/sat/integer.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
 #include "ortools/sat/sat_solver.h"
 #include "ortools/util/strong_integers.h"
+#include "ortools/util/time_limit.h"
 
 namespace operations_research {
 namespace sat {
@@ -74,5 +80,386 @@ std::function<void(Model*)> LiteralTableConstraint(
   };
 }
 
+CompactTablePropagator::CompactTablePropagator(
+    absl::Span<const IntegerVariable> vars,
+    absl::Span<const int64_t> flat_tuples, Model* model)
+    : num_columns_(vars.size()),
+      assignment_(model->GetOrCreate<Trail>()->Assignment()),
+      integer_trail_(model->GetOrCreate<IntegerTrail>()),
+      time_limit_(model->GetOrCreate<TimeLimit>()) {
+  CHECK_GT(num_columns_, 0);
+  CHECK_EQ(flat_tuples.size() % num_columns_, 0);
+  const int num_tuples = flat_tuples.size() / num_columns_;
+  num_words_ = (num_tuples + 63) / 64;
+
+  // Collect the possible values of each column with their literal.
+  auto* encoder = model->GetOrCreate<IntegerEncoder>();
+  std::vector<absl::flat_hash_map<int64_t, int>> value_to_index(num_columns_);
+  column_starts_.push_back(0);
+  for (int c = 0; c < num_columns_; ++c) {
+    const IntegerVariable var = vars[c];
+    if (integer_trail_->IsFixed(var)) {
+      // FullyEncodeVariable() does not like fixed variables.
+      value_to_index[c][integer_trail_->FixedValue(var).value()] =
+          value_literals_.size();
+      value_literals_.push_back(encoder->GetTrueLiteral());
+    } else {
+      if (!encoder->VariableIsFullyEncoded(var)) {
+        encoder->FullyEncodeVariable(var);
+      }
+      for (const ValueLiteralPair& entry : encoder->FullDomainEncoding(var)) {
+        value_to_index[c][entry.value.value()] = value_literals_.size();
+        value_literals_.push_back(entry.literal);
+      }
+    }
+    column_starts_.push_back(value_literals_.size());
+  }
+
+  // Only the tuples whose values are all still possible are valid.
+  const int num_values = value_literals_.size();
+  supports_.assign(static_cast<size_t>(num_values) * num_words_, 0);
+  words_.assign(num_words_, 0);
+  std::vector<int> tuple_value_indices(num_columns_);
+  for (int t = 0; t < num_tuples; ++t) {
+    bool is_valid = true;
+    for (int c = 0; c < num_columns_; ++c) {
+      const auto it = value_to_index[c].find(flat_tuples[t * num_columns_ + c]);
+      if (it == value_to_index[c].end()) {
+        is_valid = false;
+        break;
+      }
+      tuple_value_indices[c] = it->second;
+    }
+    if (!is_valid) continue;
+
+    const uint64_t bit = uint64_t{1} << (t % 64);
+    words_[t / 64] |= bit;
+    for (const int value_index : tuple_value_indices) {
+      Supports(value_index)[t / 64] |= bit;
+    }
+  }
+  for (int w = 0; w < num_words_; ++w) {
+    if (words_[w] != 0) non_zero_words_.push_back(w);
+  }
+  rev_num_non_zero_words_ = non_zero_words_.size();
+  time_limit_->AdvanceDeterministicTime(
+      1e-9 * static_cast<double>(supports_.size() + flat_tuples.size()));
+
+  residues_.assign(num_values, 0);
+  column_is_touched_.assign(num_columns_, false);
+  mask_.assign(num_words_, 0);
+}
+
+void CompactTablePropagator::RegisterWith(GenericLiteralWatcher* watcher) {
+  const int id = watcher->Register(this);
+  for (int c = 0; c < num_columns_; ++c) {
+    for (int i = column_starts_[c]; i < column_starts_[c + 1]; ++i) {
+      watcher->WatchLiteral(value_literals_[i].Negated(), id, c);
+    }
+  }
+  watcher->RegisterReversibleClass(id, this);
+  watcher->RegisterReversibleInt(id, &rev_num_non_zero_words_);
+}
+
+void CompactTablePropagator::SetLevel(int level) {
+  if (level == level_ends_.size()) return;
+  if (level > level_ends_.size()) {
+    while (level > level_ends_.size()) {
+      level_ends_.push_back(saved_words_.size());
+    }
+    return;
+  }
+
+  // Backtrack. Note that the word positions in non_zero_words_ do not need to
+  // be restored, only their number, which is a reversible int.
+  for (int i = saved_words_.size() - 1; i >= level_ends_[level]; --i) {
+    words_[saved_words_[i].first] = saved_words_[i].second;
+  }
+  saved_words_.resize(level_ends_[level]);
+  level_ends_.resize(level);
+}
+
+void CompactTablePropagator::SetWord(int position, uint64_t new_word) {
+  const int w = non_zero_words_[position];
+  if (!level_ends_.empty()) saved_words_.push_back({w, words_[w]});
+  words_[w] = new_word;
+  if (new_word == 0) {
+    --rev_num_non_zero_words_;
+    std::swap(non_zero_words_[position],
+              non_zero_words_[rev_num_non_zero_words_]);
+  }
+}
+
+void CompactTablePropagator::FillReason(int excluded_column) {
+  reason_.clear();
+  for (int c = 0; c < num_columns_; ++c) {
+    if (c == excluded_column) continue;
+    for (int i = column_starts_[c]; i < column_starts_[c + 1]; ++i) {
+      if (assignment_.LiteralIsFalse(value_literals_[i])) {
+        reason_.push_back(value_literals_[i]);
+      }
+    }
+  }
+}
+
+bool CompactTablePropagator::UpdateTableFromColumn(int column) {
+  const int num_non_zero_words = rev_num_non_zero_words_;
+  for (int p = 0; p < num_non_zero_words; ++p) {
+    mask_[non_zero_words_[p]] = 0;
+  }
+  for (int i = column_starts_[column]; i < column_starts_[column + 1]; ++i) {
+    if (assignment_.LiteralIsFalse(value_literals_[i])) continue;
+    const uint64_t* supports = Supports(i);
+    for (int p = 0; p < num_non_zero_words; ++p) {
+      const int w = non_zero_words_[p];
+      mask_[w] |= supports[w];
+    }
+    num_word_operations_ += num_non_zero_words;
+  }
+
+  // We iterate backward so that SetWord() only moves already processed words.
+  for (int p = num_non_zero_words - 1; p >= 0; --p) {
+    const int w = non_zero_words_[p];
+    const uint64_t new_word = words_[w] & mask_[w];
+    if (new_word != words_[w]) SetWord(p, new_word);
+  }
+  num_word_operations_ += 2 * num_non_zero_words;
+
+  if (rev_num_non_zero_words_ == 0) {
+    FillReason(/*excluded_column=*/-1);
+    return integer_trail_->ReportConflict(reason_, {});
+  }
+  return true;
+}
+
+bool CompactTablePropagator::HasSupport(int value_index) {
+  const uint64_t* supports = Supports(value_index);
+  const int residue = residues_[value_index];
+  if ((words_[residue] & supports[residue]) != 0) return true;
+  for (int p = 0; p < rev_num_non_zero_words_; ++p) {
+    const int w = non_zero_words_[p];
+    if ((words_[w] & supports[w]) != 0) {
+      num_word_operations_ += p;
+      residues_[value_index] = w;
+      return true;
+    }
+  }
+  num_word_operations_ += rev_num_non_zero_words_;
+  return false;
+}
+
+bool CompactTablePropagator::FilterDomains() {
+  for (int c = 0; c < num_columns_; ++c) {
+    bool reason_is_filled = false;
+    for (int i = column_starts_[c]; i < column_starts_[c + 1]; ++i) {
+      const Literal literal = value_literals_[i];
+      if (assignment_.LiteralIsFalse(literal)) continue;
+      if (HasSupport(i)) continue;
+
+      // All the tuples using this value were removed because of the false
+      // literals of the other columns.
+      if (!reason_is_filled) {
+        FillReason(c);
+        reason_is_filled = true;
+      }
+      if (assignment_.LiteralIsTrue(literal)) {
+        reason_.push_back(literal.Negated());
+        return integer_trail_->ReportConflict(reason_, {});
+      }
+      integer_trail_->EnqueueLiteral(literal.Negated(), reason_, {});
+    }
+  }
+  return true;
+}
+
+bool CompactTablePropagator::Propagate() {
+  bool ok = true;
+  for (int c = 0; ok && c < num_columns_; ++c) {
+    ok = UpdateTableFromColumn(c);
+  }
+  if (ok) ok = FilterDomains();
+  time_limit_->AdvanceDeterministicTime(
+      1e-9 * static_cast<double>(num_word_operations_));
+  num_word_operations_ = 0;
+  return ok;
+}
+
+bool CompactTablePropagator::IncrementalPropagate(
+    const std::vector<int>& watch_indices) {
+  for (const int c : watch_indices) column_is_touched_[c] = true;
+  bool ok = true;
+  for (int c = 0; c < num_columns_; ++c) {
+    if (!column_is_touched_[c]) continue;
+    column_is_touched_[c] = false;
+    if (ok) ok = UpdateTableFromColumn(c);
+  }
+  if (ok) ok = FilterDomains();
+  time_limit_->AdvanceDeterministicTime(
+      1e-9 * static_cast<double>(num_word_operations_));
+  num_word_operations_ = 0;
+  return ok;
+}
+
+AutomatonPropagator::AutomatonPropagator(
+    absl::Span<const IntegerVariable> vars, int64_t starting_state,
+    absl::Span<const int64_t> final_states,
+    absl::Span<const int64_t> transition_tails,
+    absl::Span<const int64_t> transition_labels,
+    absl::Span<const int64_t> transition_heads, Model* model)
+    : num_steps_(vars.size()),
+      assignment_(model->GetOrCreate<Trail>()->Assignment()),
+      integer_trail_(model->GetOrCreate<IntegerTrail>()),
+      time_limit_(model->GetOrCreate<TimeLimit>()) {
+  CHECK_GT(num_steps_, 0);
+  CHECK_EQ(transition_tails.size(), transition_labels.size());
+  CHECK_EQ(transition_tails.size(), transition_heads.size());
+
+  // Map the states and the labels to dense indices.
+  absl::flat_hash_map<int64_t, int> state_to_index;
+  absl::flat_hash_map<int64_t, int> label_to_index;
+  const auto state_index = [&state_to_index](int64_t state) {
+    const int index = state_to_index.size();
+    return state_to_index.insert({state, index}).first->second;
+  };
+  starting_state_ = state_index(starting_state);
+  for (int i = 0; i < transition_tails.size(); ++i) {
+    const int label = label_to_index.size();
+    transitions_.push_back(
+        {state_index(transition_tails[i]),
+         label_to_index.insert({transition_labels[i], label}).first->second,
+         state_index(transition_heads[i])});
+  }
+  num_states_ = state_to_index.size();
+  num_labels_ = label_to_index.size();
+  is_final_.assign(num_states_, false);
+  for (const int64_t state : final_states) {
+    const auto it = state_to_index.find(state);
+    if (it != state_to_index.end()) is_final_[it->second] = true;
+  }
+
+  // Collect the possible values of each variable with their literal.
+  auto* encoder = model->GetOrCreate<IntegerEncoder>();
+  label_to_value_index_.assign(static_cast<size_t>(num_steps_) * num_labels_,
+                               -1);
+  step_starts_.push_back(0);
+  for (int s = 0; s < num_steps_; ++s) {
+    const IntegerVariable var = vars[s];
+    const auto add_value = [&](IntegerValue value, Literal literal) {
+      const auto it = label_to_index.find(value.value());
+      if (it != label_to_index.end()) {
+        label_to_value_index_[static_cast<size_t>(s) * num_labels_ +
+                              it->second] = value_literals_.size();
+      }
+      value_literals_.push_back(literal);
+    };
+    if (integer_trail_->IsFixed(var)) {
+      // FullyEncodeVariable() does not like fixed variables.
+      add_value(integer_trail_->FixedValue(var), encoder->GetTrueLiteral());
+    } else {
+      if (!encoder->VariableIsFullyEncoded(var)) {
+        encoder->FullyEncodeVariable(var);
+      }
+      for (const ValueLiteralPair& entry : encoder->FullDomainEncoding(var)) {
+        add_value(entry.value, entry.literal);
+      }
+    }
+    step_starts_.push_back(value_literals_.size());
+  }
+  time_limit_->AdvanceDeterministicTime(
+      1e-9 * static_cast<double>(label_to_value_index_.size() +
+                                 transitions_.size()));
+
+  const size_t num_nodes = static_cast<size_t>(num_steps_ + 1) * num_states_;
+  is_reachable_.assign(num_nodes, false);
+  is_co_reachable_.assign(num_nodes, false);
+  is_supported_.assign(value_literals_.size(), false);
+}
+
+void AutomatonPropagator::RegisterWith(GenericLiteralWatcher* watcher) {
+  const int id = watcher->Register(this);
+  for (const Literal literal : value_literals_) {
+    watcher->WatchLiteral(literal.Negated(), id);
+  }
+}
+
+void AutomatonPropagator::FillReason(int excluded_step) {
+  reason_.clear();
+  for (int s = 0; s < num_steps_; ++s) {
+    if (s == excluded_step) continue;
+    for (int i = step_starts_[s]; i < step_starts_[s + 1]; ++i) {
+      if (assignment_.LiteralIsFalse(value_literals_[i])) {
+        reason_.push_back(value_literals_[i]);
+      }
+    }
+  }
+}
+
+bool AutomatonPropagator::Propagate() {
+  time_limit_->AdvanceDeterministicTime(
+      2e-9 * static_cast<double>(num_steps_) * transitions_.size());
+
+  // Forward pass: the states reachable from the starting state.
+  std::fill(is_reachable_.begin(), is_reachable_.end(), false);
+  is_reachable_[starting_state_] = true;
+  for (int s = 0; s < num_steps_; ++s) {
+    const size_t offset = static_cast<size_t>(s) * num_states_;
+    for (const Transition& transition : transitions_) {
+      if (!is_reachable_[offset + transition.tail]) continue;
+      if (!IsPossible(s, transition)) continue;
+      is_reachable_[offset + num_states_ + transition.head] = true;
+    }
+  }
+
+  // Backward pass: the states from which a final state is reachable. The
+  // labels of the transitions between such states are supported.
+  std::fill(is_co_reachable_.begin(), is_co_reachable_.end(), false);
+  std::fill(is_supported_.begin(), is_supported_.end(), false);
+  bool is_feasible = false;
+  const size_t last_offset = static_cast<size_t>(num_steps_) * num_states_;
+  for (int state = 0; state < num_states_; ++state) {
+    if (is_final_[state] && is_reachable_[last_offset + state]) {
+      is_co_reachable_[last_offset + state] = true;
+      is_feasible = true;
+    }
+  }
+  if (!is_feasible) {
+    FillReason(/*excluded_step=*/-1);
+    return integer_trail_->ReportConflict(reason_, {});
+  }
+  for (int s = num_steps_ - 1; s >= 0; --s) {
+    const size_t offset = static_cast<size_t>(s) * num_states_;
+    for (const Transition& transition : transitions_) {
+      if (!is_reachable_[offset + transition.tail]) continue;
+      if (!is_co_reachable_[offset + num_states_ + transition.head]) continue;
+      if (!IsPossible(s, transition)) continue;
+      is_co_reachable_[offset + transition.tail] = true;
+      is_supported_[ValueIndex(s, transition.label)] = true;
+    }
+  }
+
+  // Remove the values without support.
+  for (int s = 0; s < num_steps_; ++s) {
+    bool reason_is_filled = false;
+    for (int i = step_starts_[s]; i < step_starts_[s + 1]; ++i) {
+      const Literal literal = value_literals_[i];
+      if (assignment_.LiteralIsFalse(literal)) continue;
+      if (is_supported_[i]) continue;
+
+      // All the paths using this value were removed because of the false
+      // literals of the other variables.
+      if (!reason_is_filled) {
+        FillReason(s);
+        reason_is_filled = true;
+      }
+      if (assignment_.LiteralIsTrue(literal)) {
+        reason_.push_back(literal.Negated());
+        return integer_trail_->ReportConflict(reason_, {});
+      }
+      integer_trail_->EnqueueLiteral(literal.Negated(), reason_, {});
+    }
+  }
+  return true;
+}
+
 }  // namespace sat
 }  // namespace operations_research
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <utility>
 #include <vector>
 
 #include "absl/types/span.h"
@@ -23,6 +24,8 @@
 #include "ortools/sat/integer.h"
 #include "ortools/sat/model.h"
 #include "ortools/sat/sat_base.h"
+#include "ortools/util/rev.h"
+#include "ortools/util/time_limit.h"
 
 namespace operations_research {
 namespace sat {
@@ -35,6 +38,170 @@ std::function<void(Model*)> LiteralTableConstraint(
     const std::vector<std::vector<Literal>>& literal_tuples,
     const std::vector<Literal>& line_literals);
 
+// Propagator for a positive table constraint based on the "compact table"
+// algorithm. We maintain the set of tuples that are still valid as a
+// reversible sparse bitset, and a value of a variable is removed as soon as
+// all its supporting tuples are invalid. The set of tuples is updated from the
+// (variable == value) literals that become false.
+//
+// The reason for removing a value, or for a conflict, is simply the set of all
+// the (variable == value) literals of the other variables that are false.
+//
+// The tuples are given as a flat list of values, vars.size() per tuple. All
+// the variables will be fully encoded.
+class CompactTablePropagator : PropagatorInterface, ReversibleInterface {
+ public:
+  CompactTablePropagator(absl::Span<const IntegerVariable> vars,
+                         absl::Span<const int64_t> flat_tuples, Model* model);
+
+  // This type is neither copyable nor movable.
+  CompactTablePropagator(const CompactTablePropagator&) = delete;
+  CompactTablePropagator& operator=(const CompactTablePropagator&) = delete;
+
+  void SetLevel(int level) final;
+  bool Propagate() final;
+  bool IncrementalPropagate(const std::vector<int>& watch_indices) final;
+  void RegisterWith(GenericLiteralWatcher* watcher);
+
+ private:
+  // Removes from the valid tuples all the ones that use a value of the given
+  // column that is no longer possible. Returns false on conflict.
+  bool UpdateTableFromColumn(int column);
+
+  // Removes the values without support. Returns false on conflict.
+  bool FilterDomains();
+
+  // Returns true if at least one valid tuple uses the given value.
+  bool HasSupport(int value_index);
+
+  // Sets the word of the valid tuples bitset and updates the sparse list of
+  // non-zero words. The word must be non_zero_words_[position].
+  void SetWord(int position, uint64_t new_word);
+
+  // Fills the reason, as the false value literals of all the columns except
+  // the given one (-1 to include all the columns).
+  void FillReason(int excluded_column);
+
+  uint64_t* Supports(int value_index) {
+    return &supports_[static_cast<size_t>(value_index) * num_words_];
+  }
+
+  const int num_columns_;
+  int num_words_ = 0;
+  const VariablesAssignment& assignment_;
+  IntegerTrail* integer_trail_;
+  TimeLimit* time_limit_;
+
+  // The values of column c are in [column_starts_[c], column_starts_[c + 1]).
+  // For each value, we store its literal, the bitset of the tuples that use it
+  // and the last word where we found a valid tuple in this bitset.
+  std::vector<int> column_starts_;
+  std::vector<Literal> value_literals_;
+  std::vector<uint64_t> supports_;
+  std::vector<int> residues_;
+
+  // The bitset of valid tuples. Only the words in
+  // non_zero_words_[0, rev_num_non_zero_words_) can be non-zero.
+  std::vector<uint64_t> words_;
+  std::vector<int> non_zero_words_;
+  int rev_num_non_zero_words_ = 0;
+
+  // Backtrack support for words_, level_ends_[level] is an index in
+  // saved_words_ of the first word modified after that level.
+  std::vector<int> level_ends_;
+  std::vector<std::pair<int, uint64_t>> saved_words_;
+
+  // Number of words read or written since the last deterministic time update.
+  int64_t num_word_operations_ = 0;
+
+  // Temporary data.
+  std::vector<bool> column_is_touched_;
+  std::vector<uint64_t> mask_;
+  std::vector<Literal> reason_;
+};
+
+// Propagator for an automaton constraint that is not expanded. The automaton
+// is unrolled as a layered graph with one layer of states per step, and at
+// each propagation we compute the states reachable from the starting state
+// with a forward pass and the ones from which a final state is reachable with a
+// backward pass. A value of a variable is removed when no transition between
+// two such states uses it as a label.
+//
+// Each propagation is in O(num_vars * num_transitions), but unlike the
+// expansion, this does not create any new Boolean or constraint, which matters
+// on models with many automata over long sequences.
+//
+// Like for the CompactTablePropagator, the reason for removing a value, or
+// for a conflict, is the set of all the false (variable == value) literals of
+// the other variables, and all the variables will be fully encoded.
+class AutomatonPropagator : PropagatorInterface {
+ public:
+  AutomatonPropagator(absl::Span<const IntegerVariable> vars,
+                      int64_t starting_state,
+                      absl::Span<const int64_t> final_states,
+                      absl::Span<const int64_t> transition_tails,
+                      absl::Span<const int64_t> transition_labels,
+                      absl::Span<const int64_t> transition_heads, Model* model);
+
+  // This type is neither copyable nor movable.
+  AutomatonPropagator(const AutomatonPropagator&) = delete;
+  AutomatonPropagator& operator=(const AutomatonPropagator&) = delete;
+
+  bool Propagate() final;
+  void RegisterWith(GenericLiteralWatcher* watcher);
+
+ private:
+  struct Transition {
+    int tail;
+    int label;
+    int head;
+  };
+
+  // Returns the index of the literal of the given label at the given step, or
+  // -1 if the label is not a possible value of the variable.
+  int ValueIndex(int step, int label) const {
+    return label_to_value_index_[static_cast<size_t>(step) * num_labels_ +
+                                 label];
+  }
+
+  // Returns true if the transition can be taken at the given step.
+  bool IsPossible(int step, const Transition& transition) const {
+    const int value_index = ValueIndex(step, transition.label);
+    return value_index >= 0 &&
+           !assignment_.LiteralIsFalse(value_literals_[value_index]);
+  }
+
+  // Fills the reason, as the false value literals of all the variables except
+  // the one at the given step (-1 to include all the variables).
+  void FillReason(int excluded_step);
+
+  const int num_steps_;
+  int num_states_ = 0;
+  int num_labels_ = 0;
+  int starting_state_ = -1;
+  const VariablesAssignment& assignment_;
+  IntegerTrail* integer_trail_;
+  TimeLimit* time_limit_;
+
+  // The transitions, with the states and labels mapped to [0, num_states_) and
+  // [0, num_labels_).
+  std::vector<Transition> transitions_;
+  std::vector<bool> is_final_;
+
+  // The values of the variable at step s are in
+  // [step_starts_[s], step_starts_[s + 1]).
+  std::vector<int> step_starts_;
+  std::vector<Literal> value_literals_;
+  std::vector<int> label_to_value_index_;
+
+  // Temporary data, indexed by step * num_states_ + state for the states and
+  // by value index for is_supported_.
+  std::vector<bool> is_reachable_;
+  std::vector<bool> is_co_reachable_;
+  std::vector<bool> is_supported_;
+  std::vector<Literal> reason_;
+};
+
 }  // namespace sat
 }  // namespace operations_research
 
@@ -535,6 +535,12 @@ class IncrementalAverage {
 
   void AddData(double new_record);
 
+  // Replaces all the records by num_records ones with the given average.
+  void SetAverage(double average, int64_t num_records) {
+    average_ = average;
+    num_records_ = num_records;
+  }
+
  private:
   double average_ = 0.0;
   int64_t num_records_ = 0;
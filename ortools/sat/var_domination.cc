@@ -35,6 +35,9 @@
 #include "ortools/base/logging.h"
 #include "ortools/base/stl_util.h"
 #include "ortools/base/strong_vector.h"
+#if !defined(__PORTABLE_PLATFORM__)
+#include "ortools/base/threadpool.h"
+#endif  // __PORTABLE_PLATFORM__
 #include "ortools/sat/cp_model.pb.h"
 #include "ortools/sat/cp_model_utils.h"
 #include "ortools/sat/integer.h"
@@ -212,6 +215,43 @@ void VarDomination::Initialize(absl::Span<IntegerVariableWithRank> span) {
   }
 }
 
+bool VarDomination::AppendFilteredCandidates(
+    IntegerVariable var, absl::Span<const IntegerVariable> to_scan,
+    int max_size, std::vector<IntegerVariable>* candidates) const {
+  const uint64_t var_sig = block_down_signatures_[var];
+  const uint64_t not_var_sig = block_down_signatures_[NegationOf(var)];
+
+  // Two modes, either we scan the full list, or a small subset of it.
+  // Not that low variable indices should appear first, so it is better not
+  // to randomize.
+  bool cropped = false;
+  int new_size = 0;
+  if (to_scan.size() <= 1'000) {
+    for (const IntegerVariable x : to_scan) {
+      if (var_sig & ~block_down_signatures_[x]) continue;  // !included.
+      if (block_down_signatures_[NegationOf(x)] & ~not_var_sig) continue;
+      if (PositiveVariable(x) == PositiveVariable(var)) continue;
+      if (can_freely_decrease_[NegationOf(x)]) continue;
+      ++new_size;
+      candidates->push_back(x);
+      if (new_size >= max_size) cropped = true;
+    }
+  } else {
+    cropped = true;
+    for (int i = 0; i < 200; ++i) {
+      const IntegerVariable x = to_scan[i];
+      if (var_sig & ~block_down_signatures_[x]) continue;  // !included.
+      if (block_down_signatures_[NegationOf(x)] & ~not_var_sig) continue;
+      if (PositiveVariable(x) == PositiveVariable(var)) continue;
+      if (can_freely_decrease_[NegationOf(x)]) continue;
+      ++new_size;
+      candidates->push_back(x);
+      if (new_size >= max_size) break;
+    }
+  }
+  return cropped;
+}
+
 // TODO(user): Use more heuristics to not miss as much dominance relation when
 // we crop initial lists.
 bool VarDomination::EndFirstPhase() {
@@ -230,55 +270,78 @@ bool VarDomination::EndFirstPhase() {
       num_vars_with_negation_, false);
 
   // Fill the initial domination candidates.
-  int non_cropped_size = 0;
+  //
+  // The list of each variable only depends on the first phase data, so on
+  // large problems, we compute them by chunks of consecutive variables in
+  // parallel. Each chunk uses its own buffer, and they are concatenated in
+  // order so that the result does not depend on the number of threads.
   std::vector<IntegerVariable> partition_data;
   const std::vector<absl::Span<const IntegerVariable>> elements_by_part =
       partition_->GetParts(&partition_data);
-  for (IntegerVariable var(0); var < num_vars_with_negation_; ++var) {
-    if (can_freely_decrease_[var]) continue;
-
-    const int part = partition_->PartOf(var.value());
-    const int start = buffer_.size();
-    const uint64_t var_sig = block_down_signatures_[var];
-    const uint64_t not_var_sig = block_down_signatures_[NegationOf(var)];
-    absl::Span<const IntegerVariable> to_scan =
-        has_initial_candidates_[var] ? InitialDominatingCandidates(var)
-                                     : elements_by_part[part];
-
-    // Two modes, either we scan the full list, or a small subset of it.
-    // Not that low variable indices should appear first, so it is better not
-    // to randomize.
-    int new_size = 0;
-    if (to_scan.size() <= 1'000) {
-      for (const IntegerVariable x : to_scan) {
-        if (var_sig & ~block_down_signatures_[x]) continue;  // !included.
-        if (block_down_signatures_[NegationOf(x)] & ~not_var_sig) continue;
-        if (PositiveVariable(x) == PositiveVariable(var)) continue;
-        if (can_freely_decrease_[NegationOf(x)]) continue;
-        ++new_size;
-        buffer_.push_back(x);
-        if (new_size >= kMaxInitialSize) {
-          is_cropped[var] = true;
-          cropped_vars.push_back(var);
-        }
+  int num_chunks = 1;
+#if !defined(__PORTABLE_PLATFORM__)
+  constexpr int kMinVariablesPerThread = 100'000;
+  num_chunks = std::max(
+      1, std::min(num_threads_,
+                  num_vars_with_negation_ / kMinVariablesPerThread));
+#endif  // __PORTABLE_PLATFORM__
+  const int chunk_size =
+      (num_vars_with_negation_ + num_chunks - 1) / num_chunks;
+  std::vector<std::vector<IntegerVariable>> chunk_buffers(num_chunks);
+  std::vector<std::vector<IntegerVariable>> chunk_cropped_vars(num_chunks);
+  const auto fill_chunk = [&](int chunk) {
+    const IntegerVariable end(
+        std::min(num_vars_with_negation_, (chunk + 1) * chunk_size));
+    std::vector<IntegerVariable>& chunk_buffer = chunk_buffers[chunk];
+    for (IntegerVariable var(chunk * chunk_size); var < end; ++var) {
+      if (can_freely_decrease_[var]) continue;
+      const int start = chunk_buffer.size();
+      absl::Span<const IntegerVariable> to_scan =
+          has_initial_candidates_[var]
+              ? InitialDominatingCandidates(var)
+              : elements_by_part[partition_->PartOf(var.value())];
+      if (AppendFilteredCandidates(var, to_scan, kMaxInitialSize,
+                                   &chunk_buffer)) {
+        chunk_cropped_vars[chunk].push_back(var);
       }
-    } else {
+      dominating_vars_[var] = {start,
+                               static_cast<int>(chunk_buffer.size()) - start};
+    }
+  };
+  if (num_chunks == 1) {
+    fill_chunk(0);
+  } else {
+#if !defined(__PORTABLE_PLATFORM__)
+    ThreadPool pool(num_chunks);
+    pool.StartWorkers();
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+      pool.Schedule([&fill_chunk, chunk]() { fill_chunk(chunk); });
+    }
+    // The pool destructor waits for all the tasks to be done.
+#endif  // __PORTABLE_PLATFORM__
+  }
+
+  // Concatenate the chunks.
+  for (int chunk = 0; chunk < num_chunks; ++chunk) {
+    const int offset = buffer_.size();
+    const IntegerVariable end(
+        std::min(num_vars_with_negation_, (chunk + 1) * chunk_size));
+    if (offset > 0) {
+      for (IntegerVariable var(chunk * chunk_size); var < end; ++var) {
+        dominating_vars_[var].start += offset;
+      }
+    }
+    buffer_.insert(buffer_.end(), chunk_buffers[chunk].begin(),
+                   chunk_buffers[chunk].end());
+    gtl::STLClearObject(&chunk_buffers[chunk]);
+    for (const IntegerVariable var : chunk_cropped_vars[chunk]) {
       is_cropped[var] = true;
       cropped_vars.push_back(var);
-      for (int i = 0; i < 200; ++i) {
-        const IntegerVariable x = to_scan[i];
-        if (var_sig & ~block_down_signatures_[x]) continue;  // !included.
-        if (block_down_signatures_[NegationOf(x)] & ~not_var_sig) continue;
-        if (PositiveVariable(x) == PositiveVariable(var)) continue;
-        if (can_freely_decrease_[NegationOf(x)]) continue;
-        ++new_size;
-        buffer_.push_back(x);
-        if (new_size >= kMaxInitialSize) break;
-      }
     }
-
-    if (!is_cropped[var]) non_cropped_size += new_size;
-    dominating_vars_[var] = {start, new_size};
+  }
+  int non_cropped_size = 0;
+  for (IntegerVariable var(0); var < num_vars_with_negation_; ++var) {
+    if (!is_cropped[var]) non_cropped_size += dominating_vars_[var].size;
   }
 
   // Heuristic: To try not to remove domination relations corresponding to short
@@ -1111,6 +1174,7 @@ void ScanModelForDominanceDetection(PresolveContext& context,
   const CpModelProto& cp_model = *context.working_model;
   const int num_vars = cp_model.variables().size();
   var_domination->Reset(num_vars);
+  var_domination->set_num_threads(context.params().presolve_num_threads());
 
   for (int var = 0; var < num_vars; ++var) {
     // Ignore variables that have been substituted already or are unused.
@@ -69,6 +69,10 @@ class VarDomination {
   // At the beginning, we assume that there is no constraint.
   void Reset(int num_variables);
 
+  // The number of threads used by EndFirstPhase() to compute the initial
+  // candidate lists of large problems. The result does not depend on it.
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
   // These functions are used to encode all of our constraints.
   // The algorithm work in two passes, so one should do:
   // - 1/ Convert all problem constraints to one or more calls
@@ -157,6 +161,15 @@ class VarDomination {
   void ProcessTempRanks();
   void Initialize(absl::Span<IntegerVariableWithRank> span);
 
+  // Appends to candidates the variables of to_scan that pass the signature
+  // filter as dominating candidates of var, and returns true if the list was
+  // cropped to max_size or if to_scan was only partially scanned. This is
+  // thread-safe, as it only reads the first phase data.
+  bool AppendFilteredCandidates(IntegerVariable var,
+                                absl::Span<const IntegerVariable> to_scan,
+                                int max_size,
+                                std::vector<IntegerVariable>* candidates) const;
+
   // Second phase function to filter the current candidate lists.
   void FilterUsingTempRanks();
 
@@ -167,6 +180,7 @@ class VarDomination {
   // EndSecondPhase(). This is used for debug checks and to control what happen
   // on the constraint processing functions.
   int phase_ = 0;
+  int num_threads_ = 1;
 
   // The variables will be sorted by non-decreasking rank. The rank is also the
   // start of the first variable in tmp_ranks_ with this rank.
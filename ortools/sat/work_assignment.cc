@@ -234,6 +234,21 @@ int SharedTreeManager::NumNodes() const {
 
 bool SharedTreeManager::SyncTree(ProtoTrail& path) {
   absl::MutexLock mutex_lock(&mu_);
+  return SyncTreeLockHeld(path, /*assign_leaf=*/true);
+}
+
+bool SharedTreeManager::SyncAndMaybeReplaceTree(ProtoTrail& path,
+                                                bool replace) {
+  absl::MutexLock mutex_lock(&mu_);
+  // There is no need to sync `path` back if we replace it anyway. Note that
+  // this also keeps the phase of `path` that ReplaceTreeLockHeld() uses.
+  if (!SyncTreeLockHeld(path, /*assign_leaf=*/!replace)) replace = true;
+  if (!replace) return false;
+  ReplaceTreeLockHeld(path);
+  return true;
+}
+
+bool SharedTreeManager::SyncTreeLockHeld(ProtoTrail& path, bool assign_leaf) {
   std::vector<std::pair<Node*, int>> nodes = GetAssignedNodes(path);
   if (!IsValid(path)) {
     path.Clear();
@@ -271,7 +286,7 @@ bool SharedTreeManager::SyncTree(ProtoTrail& path) {
     return false;
   }
   // Sync lower bounds and implications from the shared tree to `path`.
-  AssignLeaf(path, nodes.back().first);
+  if (assign_leaf) AssignLeaf(path, nodes.back().first);
   return true;
 }
 
@@ -343,6 +358,10 @@ void SharedTreeManager::ProposeSplit(ProtoTrail& path, ProtoLiteral decision) {
 
 void SharedTreeManager::ReplaceTree(ProtoTrail& path) {
   absl::MutexLock mutex_lock(&mu_);
+  ReplaceTreeLockHeld(path);
+}
+
+void SharedTreeManager::ReplaceTreeLockHeld(ProtoTrail& path) {
   std::vector<std::pair<Node*, int>> nodes = GetAssignedNodes(path);
   if (nodes.back().first->children[0] == nullptr &&
       !nodes.back().first->closed && nodes.size() > 1) {
@@ -571,6 +590,19 @@ std::string SharedTreeManager::ShortStatus() const {
                       " n=", nodes_.size(), ")");
 }
 
+bool SharedLbTreeSearchBounds::Synchronize(ProtoLiteral literal,
+                                           IntegerValue* lb) {
+  absl::MutexLock l(&mu_);
+  IntegerValue& shared_lb =
+      bounds_.insert({literal, kMinIntegerValue}).first->second;
+  if (shared_lb > *lb) {
+    *lb = shared_lb;
+    return true;
+  }
+  shared_lb = *lb;
+  return false;
+}
+
 SharedTreeWorker::SharedTreeWorker(Model* model)
     : parameters_(model->GetOrCreate<SatParameters>()),
       shared_response_(model->GetOrCreate<SharedResponseManager>()),
@@ -787,24 +819,27 @@ bool SharedTreeWorker::ShouldReplaceSubtree() {
 }
 
 bool SharedTreeWorker::SyncWithSharedTree() {
-  manager_->SyncTree(assigned_tree_);
-  if (ShouldReplaceSubtree()) {
+  // We decide whether to replace our subtree before syncing so that the
+  // manager can do both in one go. The manager also replaces it if the sync
+  // closes it, which is what ShouldReplaceSubtree() would return after.
+  const int prev_depth = assigned_tree_.MaxLevel();
+  const bool replace = ShouldReplaceSubtree();
+  if (replace && parameters_->shared_tree_worker_enable_trail_sharing()) {
+    std::vector<ProtoLiteral> phase_out;
+    for (Literal lit : decision_policy_->GetBestPartialAssignment()) {
+      auto encoded = ProtoLiteral::Encode(lit, mapping_, encoder_);
+      if (!encoded.has_value()) continue;
+      phase_out.push_back(*encoded);
+    }
+    assigned_tree_.SetPhase(phase_out);
+  }
+  if (manager_->SyncAndMaybeReplaceTree(assigned_tree_, replace)) {
     ++num_trees_;
-    VLOG(2) << parameters_->name() << " acquiring tree #" << num_trees_
+    VLOG(2) << parameters_->name() << " acquired tree #" << num_trees_
             << " after " << num_restarts_ - tree_assignment_restart_
-            << " restarts prev depth: " << assigned_tree_.MaxLevel()
+            << " restarts prev depth: " << prev_depth
             << " target: " << assigned_tree_lbds_.WindowAverage()
             << " lbd: " << restart_policy_->LbdAverageSinceReset();
-    if (parameters_->shared_tree_worker_enable_trail_sharing()) {
-      std::vector<ProtoLiteral> phase_out;
-      for (Literal lit : decision_policy_->GetBestPartialAssignment()) {
-        auto encoded = ProtoLiteral::Encode(lit, mapping_, encoder_);
-        if (!encoded.has_value()) continue;
-        phase_out.push_back(*encoded);
-      }
-      assigned_tree_.SetPhase(phase_out);
-    }
-    manager_->ReplaceTree(assigned_tree_);
     tree_assignment_restart_ = num_restarts_;
     assigned_tree_lbds_.Add(restart_policy_->LbdAverageSinceReset());
     restart_policy_->Reset();
@@ -187,7 +187,15 @@ class SharedTreeManager {
   bool SyncTree(ProtoTrail& path) ABSL_LOCKS_EXCLUDED(mu_);
 
   // Assigns a path prefix that the worker should explore.
-  void ReplaceTree(ProtoTrail& path);
+  void ReplaceTree(ProtoTrail& path) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Same as SyncTree() followed by ReplaceTree() if `replace` is true or if the
+  // assigned subtree was closed, but with a single lock acquisition. This is
+  // what workers call at each restart, so it matters with many workers.
+  // Returns true if ReplaceTree() was called, note that `path` can still be
+  // empty if no leaves were available.
+  bool SyncAndMaybeReplaceTree(ProtoTrail& path, bool replace)
+      ABSL_LOCKS_EXCLUDED(mu_);
 
   // Asserts that the subtree in path up to `level` contains no improving
   // solutions. Clears path.
@@ -239,6 +247,12 @@ class SharedTreeManager {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void AssignLeaf(ProtoTrail& path, Node* leaf)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Updates the shared tree from `path`. If `assign_leaf` is true, this also
+  // syncs the bounds and implications of the shared tree back to `path`.
+  bool SyncTreeLockHeld(ProtoTrail& path, bool assign_leaf)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ReplaceTreeLockHeld(ProtoTrail& path)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void RestartLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   std::string ShortStatus() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
@@ -274,6 +288,31 @@ class SharedTreeManager {
   int num_closed_nodes_ ABSL_GUARDED_BY(mu_) = 0;
 };
 
+// Thread-safe store of the objective lower bounds proven by the LbTreeSearch
+// workers in the branches of their root node. Since each worker owns its own
+// model, they cannot explore one shared tree, but a bound of the form
+// "literal => objective >= lb" is valid for all of them: a worker whose root
+// node branches on the same literal can then skip the LP solves needed to
+// prove it again, or directly see that the branch is worse than the current
+// objective lower bound.
+class SharedLbTreeSearchBounds {
+ public:
+  SharedLbTreeSearchBounds() = default;
+  SharedLbTreeSearchBounds(const SharedLbTreeSearchBounds&) = delete;
+  SharedLbTreeSearchBounds& operator=(const SharedLbTreeSearchBounds&) =
+      delete;
+
+  // Records that the objective is at least `*lb` when `literal` is true, and
+  // sets `*lb` to the best bound known for this literal. Returns true if that
+  // bound came from another call, i.e. if `*lb` was increased.
+  bool Synchronize(ProtoLiteral literal, IntegerValue* lb)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+ private:
+  absl::Mutex mu_;
+  absl::flat_hash_map<ProtoLiteral, IntegerValue> bounds_ ABSL_GUARDED_BY(mu_);
+};
+
 class SharedTreeWorker {
  public:
   explicit SharedTreeWorker(Model* model);
@@ -32,7 +32,9 @@ void ZeroHalfCutHelper::Reset(int size) {
   rows_.clear();
   shifted_lp_values_.clear();
   bound_parity_.clear();
-  col_to_rows_.clear();
+
+  // We keep the memory of the columns from one call to the next.
+  for (std::vector<int>& rows : col_to_rows_) rows.clear();
   col_to_rows_.resize(size);
   tmp_marked_.resize(size);
 }
@@ -214,9 +216,32 @@ void ZeroHalfCutHelper::EliminateVarUsingRow(int eliminated_col,
   rows_[eliminated_row].slack += shifted_lp_values_[eliminated_col];
 }
 
+bool ZeroHalfCutHelper::UpdateLastMatrix() {
+  bool changed = rows_ != last_rows_ ||
+                 shifted_lp_values_.size() != last_shifted_lp_values_.size();
+  if (!changed) {
+    // Only the columns present in the matrix matter.
+    for (const CombinationOfRows& row : rows_) {
+      for (const int col : row.cols) {
+        if (shifted_lp_values_[col] != last_shifted_lp_values_[col]) {
+          changed = true;
+          break;
+        }
+      }
+      if (changed) break;
+    }
+  }
+  if (changed) {
+    last_rows_ = rows_;
+    last_shifted_lp_values_ = shifted_lp_values_;
+  }
+  return changed;
+}
+
 std::vector<std::vector<std::pair<glop::RowIndex, IntegerValue>>>
 ZeroHalfCutHelper::InterestingCandidates(ModelRandomGenerator* random) {
   std::vector<std::vector<std::pair<glop::RowIndex, IntegerValue>>> result;
+  if (!UpdateLastMatrix()) return result;
 
   // Remove singleton column from the picture.
   const int num_cols = col_to_rows_.size();
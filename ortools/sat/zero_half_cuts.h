@@ -52,6 +52,10 @@ class ZeroHalfCutHelper {
   void AddOneConstraint(glop::RowIndex, absl::Span<const glop::ColIndex> cols,
                         absl::Span<const IntegerValue> coeffs, IntegerValue lb,
                         IntegerValue ub);
+
+  // Consecutive LP solutions often only differ outside of the tight rows, so
+  // InterestingCandidates() returns nothing when the binary matrix did not
+  // change since its last call, as there would be nothing new to find.
   std::vector<std::vector<std::pair<glop::RowIndex, IntegerValue>>>
   InterestingCandidates(ModelRandomGenerator* random);
 
@@ -75,6 +79,11 @@ class ZeroHalfCutHelper {
 
     // How tight this constraints is under the current LP solution.
     double slack;
+
+    bool operator==(const CombinationOfRows& o) const {
+      return multipliers == o.multipliers && cols == o.cols &&
+             rhs_parity == o.rhs_parity && slack == o.slack;
+    }
   };
   void AddBinaryRow(const CombinationOfRows& binary_row);
   const CombinationOfRows& MatrixRow(int row) const { return rows_[row]; }
@@ -122,6 +131,16 @@ class ZeroHalfCutHelper {
 
   // Temporary vector used by SymmetricDifference().
   std::vector<bool> tmp_marked_;
+
+  // Returns false if the binary matrix and the shifted lp values of its
+  // columns are the same as in the last InterestingCandidates() call, in which
+  // case there is no new candidate to find. Otherwise remembers them.
+  bool UpdateLastMatrix();
+
+  // The binary matrix of the last InterestingCandidates() call, before any
+  // elimination, and the shifted lp values it was built with.
+  std::vector<CombinationOfRows> last_rows_;
+  std::vector<double> last_shifted_lp_values_;
 };
 
 }  // namespace sat
@@ -0,0 +1,180 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ortools/scheduling/batch_parser.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "absl/random/distributions.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "ortools/base/file.h"
+#include "ortools/base/hash.h"
+#include "ortools/base/logging.h"
+#include "ortools/base/path.h"
+#include "ortools/base/status_macros.h"
+#include "ortools/base/threadpool.h"
+#include "ortools/scheduling/jobshop_scheduling.pb.h"
+#include "ortools/scheduling/jobshop_scheduling_parser.h"
+#include "ortools/scheduling/rcpsp.pb.h"
+#include "ortools/scheduling/rcpsp_parser.h"
+
+// Defined in ./jobshop_scheduling_parser.cc.
+ABSL_DECLARE_FLAG(int64_t, jssp_scaling_up_factor);
+
+namespace operations_research {
+namespace scheduling {
+namespace {
+
+// Must be incremented when a parser changes the problems it returns, to
+// invalidate the caches.
+constexpr uint64_t kCacheVersion = 1;
+
+// Returns the path of the cached problem of the file `filename`, whose content
+// is `content`. `parser_seed` identifies the parser and its options.
+std::string CachePath(absl::string_view cache_directory,
+                      absl::string_view filename, absl::string_view content,
+                      absl::string_view kind, uint64_t parser_seed) {
+  // The extension selects the format of the file, and thus its problem.
+  const absl::string_view extension = file::Extension(filename);
+  const uint64_t seed =
+      fasthash64(extension.data(), extension.size(),
+                 util_hash::Hash(kCacheVersion, parser_seed));
+  return file::JoinPath(
+      cache_directory,
+      absl::StrFormat("%016x.%s.pb", fasthash64(content.data(), content.size(),
+                                                seed),
+                      kind));
+}
+
+// Writes `problem` to `path` through a temporary file, so that concurrent
+// readers never see a partially written file.
+template <typename Problem>
+absl::Status WriteCachedProblem(const std::string& path,
+                                const Problem& problem) {
+  absl::BitGen random;
+  const std::string temporary_path =
+      absl::StrFormat("%s.%016x.tmp", path, absl::Uniform<uint64_t>(random));
+  RETURN_IF_ERROR(
+      file::SetBinaryProto(temporary_path, problem, file::Defaults()));
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    file::Delete(temporary_path, file::Defaults()).IgnoreError();
+    return absl::InternalError(absl::StrCat(
+        "Could not rename '", temporary_path, "' to '", path, "'"));
+  }
+  return absl::OkStatus();
+}
+
+// Parses one file with `parse_file`, which returns false on errors, or loads
+// its problem from the cache.
+template <typename Problem>
+absl::Status ParseOrLoadFile(
+    const std::string& filename, const BatchParserOptions& options,
+    absl::string_view kind, uint64_t parser_seed,
+    const std::function<bool(const std::string&, Problem*)>& parse_file,
+    Problem* problem) {
+  std::string cache_path;
+  if (!options.cache_directory.empty()) {
+    ASSIGN_OR_RETURN(const std::string content,
+                     file::GetContents(filename, file::Defaults()));
+    cache_path = CachePath(options.cache_directory, filename, content, kind,
+                           parser_seed);
+    if (file::GetBinaryProto(cache_path, problem, file::Defaults()).ok()) {
+      // Files with the same content can have different names.
+      problem->set_name(std::string(file::Stem(filename)));
+      return absl::OkStatus();
+    }
+    problem->Clear();
+  }
+  if (!parse_file(filename, problem)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Could not parse '", filename, "'"));
+  }
+  if (!cache_path.empty()) {
+    // The cache is an optimization: failing to fill it is not an error.
+    const absl::Status status = WriteCachedProblem(cache_path, *problem);
+    LOG_IF(WARNING, !status.ok()) << status;
+  }
+  return absl::OkStatus();
+}
+
+template <typename Problem>
+absl::StatusOr<std::vector<Problem>> ParseFiles(
+    absl::Span<const std::string> filenames, const BatchParserOptions& options,
+    absl::string_view kind, uint64_t parser_seed,
+    const std::function<bool(const std::string&, Problem*)>& parse_file) {
+  std::vector<Problem> problems(filenames.size());
+  std::vector<absl::Status> statuses(filenames.size());
+  const auto parse = [&](int index) {
+    statuses[index] =
+        ParseOrLoadFile(filenames[index], options, kind, parser_seed,
+                        parse_file, &problems[index]);
+  };
+  if (options.num_threads <= 1 || filenames.size() <= 1) {
+    for (int i = 0; i < filenames.size(); ++i) parse(i);
+  } else {
+    // The destructor of the pool waits for all the files to be parsed.
+    ThreadPool pool("ParseFiles", options.num_threads);
+    pool.StartWorkers();
+    for (int i = 0; i < filenames.size(); ++i) {
+      pool.Schedule([&parse, i]() { parse(i); });
+    }
+  }
+  for (const absl::Status& status : statuses) {
+    RETURN_IF_ERROR(status);
+  }
+  return problems;
+}
+
+}  // namespace
+
+absl::StatusOr<std::vector<jssp::JsspInputProblem>> ParseJsspFiles(
+    absl::Span<const std::string> filenames,
+    const BatchParserOptions& options) {
+  return ParseFiles<jssp::JsspInputProblem>(
+      filenames, options, "jssp",
+      /*parser_seed=*/absl::GetFlag(FLAGS_jssp_scaling_up_factor),
+      [](const std::string& filename, jssp::JsspInputProblem* problem) {
+        jssp::JsspParser parser;
+        if (!parser.ParseFile(filename)) return false;
+        *problem = parser.problem();
+        return true;
+      });
+}
+
+absl::StatusOr<std::vector<rcpsp::RcpspProblem>> ParseRcpspFiles(
+    absl::Span<const std::string> filenames,
+    const BatchParserOptions& options) {
+  return ParseFiles<rcpsp::RcpspProblem>(
+      filenames, options, "rcpsp", /*parser_seed=*/0,
+      [](const std::string& filename, rcpsp::RcpspProblem* problem) {
+        rcpsp::RcpspParser parser;
+        if (!parser.ParseFile(filename)) return false;
+        *problem = parser.problem();
+        return true;
+      });
+}
+
+}  // namespace scheduling
+}  // namespace operations_research
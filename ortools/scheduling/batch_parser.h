@@ -0,0 +1,64 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Loads many scheduling instances at once: the files are parsed in parallel,
+// and the parsed problems can be cached on disk, so that the next loads of the
+// same files only read a binary proto.
+//
+// Usage:
+//   BatchParserOptions options;
+//   options.num_threads = 8;
+//   options.cache_directory = "/tmp/jssp_cache";
+//   ASSIGN_OR_RETURN(const std::vector<jssp::JsspInputProblem> problems,
+//                    ParseJsspFiles(filenames, options));
+
+#ifndef OR_TOOLS_SCHEDULING_BATCH_PARSER_H_
+#define OR_TOOLS_SCHEDULING_BATCH_PARSER_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "ortools/scheduling/jobshop_scheduling.pb.h"
+#include "ortools/scheduling/rcpsp.pb.h"
+
+namespace operations_research {
+namespace scheduling {
+
+struct BatchParserOptions {
+  // The number of files parsed at the same time.
+  int num_threads = 1;
+
+  // If not empty, an existing directory where each parsed problem is stored as
+  // a binary proto, named after the fingerprint of the content of its file.
+  // The next loads of a file with the same content (and the same extension,
+  // which selects the format) read this proto instead of parsing the file. The
+  // directory can be shared by several processes.
+  std::string cache_directory;
+};
+
+// Parses the given files as JsspParser::ParseFile() does, and returns their
+// problems in the same order. Returns the error of the first file that cannot
+// be read or parsed, if any.
+absl::StatusOr<std::vector<jssp::JsspInputProblem>> ParseJsspFiles(
+    absl::Span<const std::string> filenames, const BatchParserOptions& options);
+
+// Same as ParseJsspFiles(), with RcpspParser::ParseFile().
+absl::StatusOr<std::vector<rcpsp::RcpspProblem>> ParseRcpspFiles(
+    absl::Span<const std::string> filenames, const BatchParserOptions& options);
+
+}  // namespace scheduling
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_SCHEDULING_BATCH_PARSER_H_
@@ -42,8 +42,13 @@ static const uint32_t kAllBits32 = 0xFFFFFFFFU;
 inline uint64_t OneBit64(int pos) { return uint64_t{1} << pos; }
 inline uint32_t OneBit32(int pos) { return 1U << pos; }
 
-// Returns the number of bits set in n.
+// Returns the number of bits set in n. Uses the hardware population count
+// instruction when the target has one, and a portable bit trick otherwise.
 inline uint64_t BitCount64(uint64_t n) {
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__POPCNT__) || defined(__aarch64__))
+  return __builtin_popcountll(n);
+#else
   const uint64_t m1 = uint64_t{0x5555555555555555};
   const uint64_t m2 = uint64_t{0x3333333333333333};
   const uint64_t m4 = uint64_t{0x0F0F0F0F0F0F0F0F};
@@ -53,14 +58,20 @@ inline uint64_t BitCount64(uint64_t n) {
   n = (n + (n >> 4)) & m4;
   n = (n * h01) >> 56;
   return n;
+#endif
 }
 inline uint32_t BitCount32(uint32_t n) {
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__POPCNT__) || defined(__aarch64__))
+  return __builtin_popcount(n);
+#else
   n -= (n >> 1) & 0x55555555UL;
   n = (n & 0x33333333) + ((n >> 2) & 0x33333333UL);
   n = (n + (n >> 4)) & 0x0F0F0F0FUL;
   n = n + (n >> 8);
   n = n + (n >> 16);
   return n & 0x0000003FUL;
+#endif
 }
 
 // Returns a word with only the least significant bit of n set.
@@ -613,6 +624,59 @@ class Bitset64 {
     }
   }
 
+  // Sets "this" to be the difference of "this" and "other", i.e. clears the
+  // bits of "this" that are set in "other". The bitsets do not have to be the
+  // same size. If other is smaller, all the higher order bits are assumed to
+  // be 0.
+  void Difference(const Bitset64<IndexType>& other) {
+    const int min_size = std::min(data_.size(), other.data_.size());
+    uint64_t* const data = data_.data();
+    const uint64_t* const other_data = other.data_.data();
+    for (int i = 0; i < min_size; ++i) {
+      data[i] &= ~other_data[i];
+    }
+  }
+
+  // Returns the number of bits set.
+  //
+  // This and the bulk operations above are plain loops over the words, which
+  // the compiler vectorizes when the target allows it.
+  int64_t NumberOfSetBits() const {
+    int64_t count = 0;
+    for (const uint64_t word : data_) {
+      count += BitCount64(word);
+    }
+    return count;
+  }
+
+  // Returns the number of bits set in both "this" and "other", without
+  // computing their intersection. The bitsets do not have to be the same size.
+  int64_t IntersectionSize(const Bitset64<IndexType>& other) const {
+    const int min_size = std::min(data_.size(), other.data_.size());
+    const uint64_t* const data = data_.data();
+    const uint64_t* const other_data = other.data_.data();
+    int64_t count = 0;
+    for (int i = 0; i < min_size; ++i) {
+      count += BitCount64(data[i] & other_data[i]);
+    }
+    return count;
+  }
+
+  // Returns the first position at or after "start" whose bit is set, or
+  // size() if there is none.
+  IndexType FindNextSetBit(IndexType start) const {
+    const int64_t start_value = Value(start);
+    const int64_t num_buckets = data_.size();
+    int64_t bucket = BitOffset64(start_value);
+    if (bucket >= num_buckets) return size_;
+    uint64_t word = data_[bucket] & IntervalUp64(BitPos64(start_value));
+    while (word == 0) {
+      if (++bucket == num_buckets) return size_;
+      word = data_[bucket];
+    }
+    return IndexType(BitShift64(bucket) | LeastSignificantBitPosition64(word));
+  }
+
   // Class to iterate over the bit positions at 1 of a Bitset64.
   //
   // IMPORTANT: Because the iterator "caches" the current uint64_t bucket, this
@@ -13,15 +13,18 @@
 
 #include "ortools/util/file_util.h"
 
+#include <fstream>  // NOLINT
 #include <string>
 #include <utility>
 
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "google/protobuf/io/tokenizer.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
 #include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 #include "google/protobuf/json/json.h"
 #include "google/protobuf/message.h"
@@ -50,11 +53,59 @@ absl::StatusOr<std::string> ReadFileToString(absl::string_view filename) {
   return contents;
 }
 
+namespace {
+
+// Parses a binary proto directly from the file, without reading its content
+// into a string first. This avoids holding both the serialized and the parsed
+// proto in memory, which matters for huge models. Returns false and leaves the
+// proto empty if the file cannot be parsed as such.
+bool ParseBinaryProtoFromFile(absl::string_view filename,
+                              google::protobuf::Message* proto,
+                              bool allow_partial) {
+  std::ifstream input(std::string(filename), std::ios::binary);
+  if (!input) return false;
+  google::protobuf::io::IstreamInputStream stream(&input);
+  if (!proto->ParsePartialFromZeroCopyStream(&stream) ||
+      (!allow_partial && !proto->IsInitialized())) {
+    proto->Clear();
+    return false;
+  }
+
+  // Same protection against the wrong proto type as in StringToProto().
+  constexpr double kMaxBinaryProtoParseShrinkFactor = 2;
+  proto->DiscardUnknownFields();
+  if (proto->ByteSizeLong() <
+      stream.ByteCount() / kMaxBinaryProtoParseShrinkFactor) {
+    proto->Clear();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
 absl::Status ReadFileToProto(absl::string_view filename,
                              google::protobuf::Message* proto,
                              bool allow_partial) {
+  // Binary protos written by WriteProtoToFile() end with ".bin". We still
+  // fall back to the generic code below if the parsing fails.
+  if (absl::EndsWith(filename, ".bin") &&
+      ParseBinaryProtoFromFile(filename, proto, allow_partial)) {
+    VLOG(1) << "ReadFileToProto(): input is a binary proto";
+    return absl::OkStatus();
+  }
+
   std::string data;
   RETURN_IF_ERROR(file::GetContents(filename, &data, file::Defaults()));
+  // We decompress here rather than in StringToProto() so that the compressed
+  // content is released before parsing.
+  {
+    std::string uncompressed;
+    if (GunzipString(data, &uncompressed)) {
+      VLOG(1) << "ReadFileToProto(): input is gzipped";
+      data.swap(uncompressed);
+    }
+  }
   return util::StatusBuilder(StringToProto(data, proto, allow_partial))
          << " in file '" << filename << "'";
 }
@@ -36,6 +36,9 @@ absl::StatusOr<std::string> ReadFileToString(absl::string_view filename);
 // error, parsing errors, or type error: maybe it was a valid JSON, text proto,
 // or binary proto, but not of the right proto message (this is not an exact
 // science, but the heuristics used should work well in practice).
+//
+// Files ending with ".bin" are first parsed directly as a binary proto, without
+// loading their content in memory, which is a lot leaner for huge protos.
 absl::Status ReadFileToProto(
     absl::string_view filename, google::protobuf::Message* proto,
     // If true, unset required fields don't cause errors. This
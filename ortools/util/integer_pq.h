@@ -120,6 +120,26 @@ class IntegerPriorityQueue {
     SetAndDecreasePriority(position_[element.Index()], element);
   }
 
+  // Same as Add() or ChangePriority(), but without updating the queue. This is
+  // faster when a lot of elements change at once, but Rebuild() must be called
+  // before any other function is used.
+  void AddOrChangePriorityWithoutUpdate(Element element) {
+    const int index = element.Index();
+    if (Contains(index)) {
+      heap_[position_[index]] = element;
+    } else {
+      Set(++size_, element);
+    }
+  }
+
+  // Restores the queue invariant in O(Size()) after some calls to
+  // AddOrChangePriorityWithoutUpdate().
+  void Rebuild() {
+    for (int i = size_ >> 1; i >= 1; --i) {
+      SetAndDecreasePriority(i, heap_[i]);
+    }
+  }
+
   // Returns the element with given index.
   Element GetElement(int index) const { return heap_[position_[index]]; }
 
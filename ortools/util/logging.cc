@@ -17,24 +17,101 @@
 #include <functional>
 #include <iostream>
 #include <ostream>
+#include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 
 namespace operations_research {
 
 SolverLogger::SolverLogger() { timer_.Start(); }
 
+SolverLogger::~SolverLogger() { SetAsynchronousOutput(false); }
+
+void SolverLogger::SetAsynchronousOutput(bool enable) {
+  if (enable == (output_thread_ != nullptr)) return;
+  if (enable) {
+    output_thread_ =
+        std::make_unique<std::thread>(&SolverLogger::RunOutputThread, this);
+    return;
+  }
+  {
+    absl::MutexLock lock(&mutex_);
+    stop_output_thread_ = true;
+  }
+  output_thread_->join();
+  output_thread_.reset();
+  absl::MutexLock lock(&mutex_);
+  stop_output_thread_ = false;
+}
+
+void SolverLogger::FlushAsynchronousOutput() {
+  if (output_thread_ == nullptr) return;
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(this, &SolverLogger::IsIdle));
+}
+
+bool SolverLogger::HasMessagesOrIsStopping() const {
+  return !pending_messages_.empty() || stop_output_thread_;
+}
+
+bool SolverLogger::IsIdle() const {
+  return pending_messages_.empty() && !output_in_progress_;
+}
+
+void SolverLogger::RunOutputThread() {
+  std::vector<std::string> messages;
+  for (;;) {
+    {
+      absl::MutexLock lock(&mutex_);
+      output_in_progress_ = false;
+      mutex_.Await(
+          absl::Condition(this, &SolverLogger::HasMessagesOrIsStopping));
+      if (pending_messages_.empty()) return;
+      messages.clear();
+      messages.swap(pending_messages_);
+      output_in_progress_ = true;
+    }
+    if (log_to_stdout_) {
+      for (const std::string& message : messages) {
+        std::cout << message << '\n';
+      }
+      std::cout.flush();
+    }
+    for (const std::string& message : messages) {
+      for (const auto& callback : info_callbacks_) {
+        callback(message);
+      }
+    }
+  }
+}
+
 void SolverLogger::AddInfoLoggingCallback(
     std::function<void(const std::string& message)> callback) {
+  FlushAsynchronousOutput();
   info_callbacks_.push_back(std::move(callback));
 }
 
-void SolverLogger::ClearInfoLoggingCallbacks() { info_callbacks_.clear(); }
+void SolverLogger::ClearInfoLoggingCallbacks() {
+  FlushAsynchronousOutput();
+  info_callbacks_.clear();
+}
 
 void SolverLogger::LogInfo(const char* source_filename, int source_line,
                            const std::string& message) {
+  if (output_thread_ != nullptr) {
+    absl::MutexLock lock(&mutex_);
+    pending_messages_.push_back(message);
+    return;
+  }
+  OutputMessage(message);
+}
+
+void SolverLogger::OutputMessage(const std::string& message) {
   if (log_to_stdout_) {
     std::cout << message << std::endl;
   }
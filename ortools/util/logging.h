@@ -16,9 +16,13 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "ortools/base/timer.h"
 
 namespace operations_research {
@@ -39,6 +43,9 @@ class SolverLogger {
  public:
   SolverLogger();
 
+  // Writes the pending messages of the asynchronous output, if any.
+  ~SolverLogger();
+
   // Enables all logging.
   //
   // Note that this is used by the logging macro, but it actually do not
@@ -53,10 +60,23 @@ class SolverLogger {
 
   // Add a callback listening to all information messages.
   //
-  // They will be run synchronously when LogInfo() is called.
+  // They will be run synchronously when LogInfo() is called, unless the
+  // asynchronous output is enabled, in which case they are run by the output
+  // thread.
   void AddInfoLoggingCallback(
       std::function<void(const std::string& message)> callback);
 
+  // When enabled, LogInfo() only queues the message, and a background thread
+  // writes the queued messages to stdout, with a single flush per batch, and
+  // runs the callbacks on them, in order. This keeps the solver threads from
+  // blocking on a slow stdout. Disabling it, or destroying the logger, first
+  // processes all the pending messages.
+  void SetAsynchronousOutput(bool enable);
+
+  // Waits until all the messages queued by the asynchronous output have been
+  // processed. Does nothing if the asynchronous output is disabled.
+  void FlushAsynchronousOutput();
+
   // Removes all callbacks registered via AddInfoLoggingCallback().
   void ClearInfoLoggingCallbacks();
 
@@ -92,6 +112,12 @@ class SolverLogger {
   };
   bool RateIsOk(const ThrottlingData& data);
 
+  // Writes the message to stdout if needed and runs the callbacks.
+  void OutputMessage(const std::string& message);
+  void RunOutputThread();
+  bool HasMessagesOrIsStopping() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  bool IsIdle() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   bool is_enabled_ = false;
   bool log_to_stdout_ = false;
   std::vector<std::function<void(const std::string& message)>> info_callbacks_;
@@ -104,6 +130,14 @@ class SolverLogger {
 
   WallTimer timer_;
   std::vector<ThrottlingData> id_to_throttling_data_;
+
+  // The asynchronous output, used iff output_thread_ is not nullptr.
+  std::unique_ptr<std::thread> output_thread_;
+  absl::Mutex mutex_;
+  std::vector<std::string> pending_messages_ ABSL_GUARDED_BY(mutex_);
+  // True while the output thread processes a batch of messages.
+  bool output_in_progress_ ABSL_GUARDED_BY(mutex_) = false;
+  bool stop_output_thread_ ABSL_GUARDED_BY(mutex_) = false;
 };
 
 #define SOLVER_LOG(logger, ...)     \
@@ -0,0 +1,178 @@
+// Copyright 2010-2024 Google LLC
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// An immutable vector of int64_t that is stored on few bits per element when
+// the elements close in the vector have close values.
+//
+// The elements are split in blocks of 64. Each block stores its minimum, and
+// the differences of its elements to this minimum on the smallest number of
+// bits that fits all of them. A block of equal elements thus uses no bit at
+// all, and a block of Boolean values uses one bit per element. A block of
+// arbitrary values uses 64 bits per element, so the vector is never much
+// larger than a std::vector<int64_t>.
+
+#ifndef OR_TOOLS_UTIL_PACKED_INT64_VECTOR_H_
+#define OR_TOOLS_UTIL_PACKED_INT64_VECTOR_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/numeric/bits.h"
+#include "absl/types/span.h"
+
+namespace operations_research {
+
+class PackedInt64Vector {
+ public:
+  PackedInt64Vector() : block_start_(1, 0) {}
+
+  explicit PackedInt64Vector(absl::Span<const int64_t> values)
+      : PackedInt64Vector(values.size(),
+                          [values](int i) { return values[i]; }) {}
+
+  // Packs the elements value(0), ..., value(size - 1). This avoids
+  // materializing the elements when they are computed on the fly, e.g. as the
+  // difference of two vectors. `value` is called twice per element.
+  template <typename ValueFunction>
+  PackedInt64Vector(int size, const ValueFunction& value);
+
+  int size() const { return size_; }
+
+  int64_t operator[](int i) const {
+    DCHECK_GE(i, 0);
+    DCHECK_LT(i, size_);
+    const int block = i / kBlockSize;
+    const int64_t start = block_start_[block];
+    const int num_bits = static_cast<int>(block_start_[block + 1] - start);
+    if (num_bits == 0) return block_min_[block];
+    const int bit = (i % kBlockSize) * num_bits;
+    const int64_t word = start + bit / 64;
+    const int shift = bit % 64;
+    uint64_t offset = words_[word] >> shift;
+    if (shift + num_bits > 64) offset |= words_[word + 1] << (64 - shift);
+    if (num_bits < 64) offset &= (uint64_t{1} << num_bits) - 1;
+    return static_cast<int64_t>(static_cast<uint64_t>(block_min_[block]) +
+                                offset);
+  }
+
+  // Returns true if all the elements are zero, without unpacking them.
+  bool IsZero() const {
+    return words_.empty() &&
+           std::all_of(block_min_.begin(), block_min_.end(),
+                       [](int64_t min) { return min == 0; });
+  }
+
+  // Returns the first index where this vector and `other` differ, or the size
+  // of the shortest of the two if it is a prefix of the other. Blocks with the
+  // same encoding are skipped without being unpacked.
+  int FirstDifference(const PackedInt64Vector& other) const {
+    const int size = std::min(size_, other.size_);
+    const int num_blocks = (size + kBlockSize - 1) / kBlockSize;
+    for (int block = 0; block < num_blocks; ++block) {
+      if (SameBlock(other, block)) continue;
+      const int end = std::min(size, (block + 1) * kBlockSize);
+      for (int i = block * kBlockSize; i < end; ++i) {
+        if ((*this)[i] != other[i]) return i;
+      }
+    }
+    return size;
+  }
+
+  bool operator==(const PackedInt64Vector& other) const {
+    return size_ == other.size_ && block_min_ == other.block_min_ &&
+           block_start_ == other.block_start_ && words_ == other.words_;
+  }
+
+  // Returns the memory used by the vector, in bytes.
+  int64_t MemoryUsage() const {
+    return sizeof(*this) + block_min_.capacity() * sizeof(int64_t) +
+           block_start_.capacity() * sizeof(int64_t) +
+           words_.capacity() * sizeof(uint64_t);
+  }
+
+ private:
+  static constexpr int kBlockSize = 64;
+
+  // Returns true if `block` is encoded the same way in both vectors. The
+  // elements of the last block of the shortest vector may still be equal when
+  // this returns false.
+  bool SameBlock(const PackedInt64Vector& other, int block) const {
+    const int64_t start = block_start_[block];
+    const int64_t other_start = other.block_start_[block];
+    const int64_t num_bits = block_start_[block + 1] - start;
+    return block_min_[block] == other.block_min_[block] &&
+           num_bits == other.block_start_[block + 1] - other_start &&
+           std::equal(words_.begin() + start,
+                      words_.begin() + start + num_bits,
+                      other.words_.begin() + other_start) &&
+           std::min(size_, (block + 1) * kBlockSize) ==
+               std::min(other.size_, (block + 1) * kBlockSize);
+  }
+
+  int size_ = 0;
+
+  // The minimum of each block.
+  std::vector<int64_t> block_min_;
+
+  // The words of block b are words_[block_start_[b], block_start_[b + 1]). A
+  // block whose elements use k bits uses exactly k words, so k is also the
+  // number of words of the block.
+  std::vector<int64_t> block_start_;
+  std::vector<uint64_t> words_;
+};
+
+template <typename ValueFunction>
+PackedInt64Vector::PackedInt64Vector(int size, const ValueFunction& value)
+    : size_(size) {
+  CHECK_GE(size, 0);
+  const int num_blocks = (size + kBlockSize - 1) / kBlockSize;
+  block_min_.reserve(num_blocks);
+  block_start_.reserve(num_blocks + 1);
+  block_start_.push_back(0);
+  for (int block = 0; block < num_blocks; ++block) {
+    const int begin = block * kBlockSize;
+    const int end = std::min(size, begin + kBlockSize);
+    int64_t min = value(begin);
+    int64_t max = min;
+    for (int i = begin + 1; i < end; ++i) {
+      const int64_t v = value(i);
+      min = std::min(min, v);
+      max = std::max(max, v);
+    }
+    // The unsigned difference does not overflow, even for [kint64min,
+    // kint64max].
+    const int num_bits = absl::bit_width(static_cast<uint64_t>(max) -
+                                         static_cast<uint64_t>(min));
+    block_min_.push_back(min);
+    block_start_.push_back(block_start_.back() + num_bits);
+    if (num_bits == 0) continue;
+
+    const int64_t start = words_.size();
+    words_.resize(start + num_bits, 0);
+    for (int i = begin; i < end; ++i) {
+      const uint64_t offset =
+          static_cast<uint64_t>(value(i)) - static_cast<uint64_t>(min);
+      const int bit = (i - begin) * num_bits;
+      const int64_t word = start + bit / 64;
+      const int shift = bit % 64;
+      words_[word] |= offset << shift;
+      if (shift + num_bits > 64) words_[word + 1] |= offset >> (64 - shift);
+    }
+  }
+}
+
+}  // namespace operations_research
+
+#endif  // OR_TOOLS_UTIL_PACKED_INT64_VECTOR_H_
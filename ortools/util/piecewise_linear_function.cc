@@ -273,8 +273,7 @@ const int PiecewiseLinearFunction::kNotFound = -1;
 
 PiecewiseLinearFunction::PiecewiseLinearFunction(
     std::vector<PiecewiseSegment> segments)
-    : is_modified_(true),
-      is_convex_(false),
+    : is_convex_(false),
       is_non_decreasing_(false),
       is_non_increasing_(false) {
   // Sort the segments in ascending order of start.
@@ -290,6 +289,7 @@ PiecewiseLinearFunction::PiecewiseLinearFunction(
   for (const auto& segment : segments) {
     InsertSegment(segment);
   }
+  UpdateStatus();
 }
 
 PiecewiseLinearFunction* PiecewiseLinearFunction::CreatePiecewiseLinearFunction(
@@ -407,39 +407,42 @@ PiecewiseLinearFunction::CreateEarlyTardyFunctionWithSlack(
 }
 
 bool PiecewiseLinearFunction::InDomain(int64_t x) const {
-  int index = FindSegmentIndex(segments_, x);
+  const int index = FindSegmentIndexFrom(x, kNotFound);
   if (index == kNotFound) {
     return false;
   }
-  if (segments_[index].end_x() < x) {
+  if (segment_end_x_[index] < x) {
     return false;
   }
   return true;
 }
 
-bool PiecewiseLinearFunction::IsConvex() const {
-  const_cast<PiecewiseLinearFunction*>(this)->UpdateStatus();
-  return is_convex_;
-}
+bool PiecewiseLinearFunction::IsConvex() const { return is_convex_; }
 
 bool PiecewiseLinearFunction::IsNonDecreasing() const {
-  const_cast<PiecewiseLinearFunction*>(this)->UpdateStatus();
   return is_non_decreasing_;
 }
 
 bool PiecewiseLinearFunction::IsNonIncreasing() const {
-  const_cast<PiecewiseLinearFunction*>(this)->UpdateStatus();
   return is_non_increasing_;
 }
 
 int64_t PiecewiseLinearFunction::Value(int64_t x) const {
-  if (!InDomain(x)) {
-    // TODO(user): Allow the user to specify the
-    // undefined value and use kint64max as the default.
-    return kint64max;
+  return ValueInSegment(x, FindSegmentIndexFrom(x, kNotFound));
+}
+
+void PiecewiseLinearFunction::Values(absl::Span<const int64_t> points,
+                                     absl::Span<int64_t> values) const {
+  CHECK_EQ(points.size(), values.size());
+  int segment = kNotFound;
+  int64_t previous_point = kint64max;
+  for (int i = 0; i < points.size(); ++i) {
+    const int64_t x = points[i];
+    segment =
+        FindSegmentIndexFrom(x, x >= previous_point ? segment : kNotFound);
+    values[i] = ValueInSegment(x, segment);
+    previous_point = x;
   }
-  const int index = FindSegmentIndex(segments_, x);
-  return segments_[index].Value(x);
 }
 
 int64_t PiecewiseLinearFunction::GetMaximum(int64_t range_start,
@@ -621,17 +624,17 @@ PiecewiseLinearFunction::GetSmallestRangeInValueRange(int64_t range_start,
 }
 
 void PiecewiseLinearFunction::AddConstantToX(int64_t constant) {
-  is_modified_ = true;
   for (int i = 0; i < segments_.size(); ++i) {
     segments_[i].AddConstantToX(constant);
   }
+  UpdateStatus();
 }
 
 void PiecewiseLinearFunction::AddConstantToY(int64_t constant) {
-  is_modified_ = true;
   for (int i = 0; i < segments_.size(); ++i) {
     segments_[i].AddConstantToY(constant);
   }
+  UpdateStatus();
 }
 
 void PiecewiseLinearFunction::Add(const PiecewiseLinearFunction& other) {
@@ -686,7 +689,6 @@ std::string PiecewiseLinearFunction::DebugString() const {
 }
 
 void PiecewiseLinearFunction::InsertSegment(const PiecewiseSegment& segment) {
-  is_modified_ = true;
   // No intersection.
   if (segments_.empty() || segments_.back().end_x() < segment.start_x()) {
     segments_.push_back(segment);
@@ -707,7 +709,6 @@ void PiecewiseLinearFunction::InsertSegment(const PiecewiseSegment& segment) {
 void PiecewiseLinearFunction::Operation(
     const PiecewiseLinearFunction& other,
     const std::function<int64_t(int64_t, int64_t)>& operation) {
-  is_modified_ = true;
   std::vector<PiecewiseSegment> own_segments;
   const std::vector<PiecewiseSegment>& other_segments = other.segments();
   own_segments.swap(segments_);
@@ -749,13 +750,14 @@ void PiecewiseLinearFunction::Operation(
       InsertSegment(PiecewiseSegment(point_x, point_y, slope, other_point_x));
     }
   }
+  UpdateStatus();
 }
 
 bool PiecewiseLinearFunction::FindSegmentIndicesFromRange(
     int64_t range_start, int64_t range_end, int* start_segment,
     int* end_segment) const {
-  *start_segment = FindSegmentIndex(segments_, range_start);
-  *end_segment = FindSegmentIndex(segments_, range_end);
+  *start_segment = FindSegmentIndexFrom(range_start, kNotFound);
+  *end_segment = FindSegmentIndexFrom(range_end, kNotFound);
   if (*start_segment == *end_segment) {
     if (*start_segment < 0) {
       // Given range before function's domain start.
@@ -769,6 +771,47 @@ bool PiecewiseLinearFunction::FindSegmentIndicesFromRange(
   return true;
 }
 
+int PiecewiseLinearFunction::FindSegmentIndexFrom(int64_t x,
+                                                  int first_segment) const {
+  const int64_t* const starts = segment_start_x_.data();
+  if (first_segment == kNotFound) {
+    if (segment_start_x_.empty() || starts[0] > x) return kNotFound;
+    first_segment = 0;
+  }
+  DCHECK_LE(starts[first_segment], x);
+  // Invariant: the index is in [base - starts, base - starts + length). The
+  // loop has no data-dependent branch, only a conditional move.
+  const int64_t* base = starts + first_segment;
+  int length = segment_start_x_.size() - first_segment;
+  while (length > 1) {
+    const int half = length / 2;
+    base = base[half] <= x ? base + half : base;
+    length -= half;
+  }
+  return base - starts;
+}
+
+int64_t PiecewiseLinearFunction::ValueInSegment(int64_t x, int segment) const {
+  if (segment == kNotFound || segment_end_x_[segment] < x) {
+    // TODO(user): Allow the user to specify the
+    // undefined value and use kint64max as the default.
+    return kint64max;
+  }
+  return segments_[segment].Value(x);
+}
+
+void PiecewiseLinearFunction::UpdateStatus() {
+  segment_start_x_.resize(segments_.size());
+  segment_end_x_.resize(segments_.size());
+  for (int i = 0; i < segments_.size(); ++i) {
+    segment_start_x_[i] = segments_[i].start_x();
+    segment_end_x_[i] = segments_[i].end_x();
+  }
+  is_convex_ = IsConvexInternal();
+  is_non_decreasing_ = IsNonDecreasingInternal();
+  is_non_increasing_ = IsNonIncreasingInternal();
+}
+
 bool PiecewiseLinearFunction::IsConvexInternal() const {
   for (int i = 1; i < segments_.size(); ++i) {
     if (!FormConvexPair(segments_[i - 1], segments_[i])) {
@@ -15,7 +15,10 @@
 // by inserting segments.
 //
 // This class maintains a minimal internal representation and checks for
-// overflow.
+// overflow. The start and end of the segments are also stored in flat arrays,
+// and the convexity and monotonicity flags are computed after each
+// modification, so that the const methods only read the function and can be
+// called from several threads.
 
 #ifndef OR_TOOLS_UTIL_PIECEWISE_LINEAR_FUNCTION_H_
 #define OR_TOOLS_UTIL_PIECEWISE_LINEAR_FUNCTION_H_
@@ -26,6 +29,8 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/span.h"
+
 namespace operations_research {
 // This structure stores one straight line. It contains the start point, the
 // end point and the slope.
@@ -184,6 +189,11 @@ class PiecewiseLinearFunction {
   bool IsNonIncreasing() const;
   // Returns the value of the piecewise linear function for x.
   int64_t Value(int64_t x) const;
+  // Sets values[i] to Value(points[i]) for all i. When the points are sorted,
+  // the search of the segment of each point starts from the segment of the
+  // previous point.
+  void Values(absl::Span<const int64_t> points,
+              absl::Span<int64_t> values) const;
   // Returns the maximum value of all the segments in the function.
   int64_t GetMaximum() const;
   // Returns the minimum value of all the segments in the function.
@@ -248,14 +258,15 @@ class PiecewiseLinearFunction {
   // range is outside the domain of the function.
   bool FindSegmentIndicesFromRange(int64_t range_start, int64_t range_end,
                                    int* start_segment, int* end_segment) const;
-  void UpdateStatus() {
-    if (is_modified_) {
-      is_convex_ = IsConvexInternal();
-      is_non_decreasing_ = IsNonDecreasingInternal();
-      is_non_increasing_ = IsNonIncreasingInternal();
-      is_modified_ = false;
-    }
-  }
+  // Same as FindSegmentIndex() in the .cc, on segments_, for an x greater than
+  // or equal to the start of the segment `first_segment`, if not kNotFound.
+  // The search is branchless.
+  int FindSegmentIndexFrom(int64_t x, int first_segment) const;
+  // Returns the value of the function for x, given the result of
+  // FindSegmentIndex() for x.
+  int64_t ValueInSegment(int64_t x, int segment) const;
+  // Must be called after each modification of segments_.
+  void UpdateStatus();
   bool IsConvexInternal() const;
   bool IsNonDecreasingInternal() const;
   bool IsNonIncreasingInternal() const;
@@ -263,7 +274,10 @@ class PiecewiseLinearFunction {
   // The vector of segments in the function, sorted in ascending order of start
   // points.
   std::vector<PiecewiseSegment> segments_;
-  bool is_modified_;
+  // segment_start_x_[i] and segment_end_x_[i] are the start and end of
+  // segments_[i], contiguous in memory for the searches.
+  std::vector<int64_t> segment_start_x_;
+  std::vector<int64_t> segment_end_x_;
   bool is_convex_;
   bool is_non_decreasing_;
   bool is_non_increasing_;
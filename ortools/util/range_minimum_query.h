@@ -29,16 +29,30 @@
 // answer all queries in O(1): given a pair (i, j) find the maximum k such that
 // i + 2^k < j and note that
 // std::min(min(arr, i, i+2^k), min(arr, j-2^k, j)) = min(arr, i, j).
+//
+// For large arrays, the O(n*log(n)) memory of this cache is prohibitive, and
+// BlockRangeMinimumQuery only keeps O(n) values: the array is split in blocks
+// of 64 consecutive elements, and the cache above is only built on the minima
+// of the blocks. Within each block, the minimum of every prefix and every
+// suffix is stored, so that a query spanning several blocks is answered in
+// O(1) from the suffix of its first block, the prefix of its last block and the
+// cache of the blocks in between. A query within a single block scans it, which
+// only touches one or two cache lines for small types.
 
 #ifndef OR_TOOLS_UTIL_RANGE_MINIMUM_QUERY_H_
 #define OR_TOOLS_UTIL_RANGE_MINIMUM_QUERY_H_
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <numeric>
 #include <utility>
 #include <vector>
 
+#include "absl/log/check.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "ortools/base/threadpool.h"
 #include "ortools/util/bitset.h"
 
 namespace operations_research {
@@ -94,6 +108,82 @@ class RangeMinimumIndexQuery {
   const RangeMinimumQuery<int, IndexComparator> rmq_;
 };
 
+// BlockRangeMinimumQuery has the same interface as RangeMinimumQuery, with
+// O(n) memory instead of O(n*log(n)), at the cost of a scan of up to 64
+// elements for the queries within a block. The construction can use several
+// threads.
+template <typename T, typename Compare = std::less<T>>
+class BlockRangeMinimumQuery {
+ public:
+  explicit BlockRangeMinimumQuery(std::vector<T> array, int num_threads = 1);
+  BlockRangeMinimumQuery(std::vector<T> array, Compare cmp,
+                         int num_threads = 1);
+
+  // This type is neither copyable nor movable.
+  BlockRangeMinimumQuery(const BlockRangeMinimumQuery&) = delete;
+  BlockRangeMinimumQuery& operator=(const BlockRangeMinimumQuery&) = delete;
+
+  // Returns the minimum (w.r.t. Compare) arr[x], where x is contained in
+  // [from, to).
+  T GetMinimumFromRange(int from, int to) const;
+
+  const std::vector<T>& array() const;
+
+ private:
+  static constexpr int kLogBlockSize = 6;
+  static constexpr int kBlockSize = 1 << kLogBlockSize;
+
+  // Calls f(begin, end) on a partition of [0, size) in up to num_threads
+  // intervals of at least kBlockSize elements, on the threads of `pool` and
+  // the calling thread.
+  template <typename F>
+  static void ParallelFor(int size, int num_threads, ThreadPool* pool,
+                          const F& f);
+
+  std::vector<T> array_;
+  // prefix_min_[i] = min(arr, b, i + 1) and suffix_min_[i] = min(arr, i, e),
+  // where [b, e) is the block of i.
+  std::vector<T> prefix_min_;
+  std::vector<T> suffix_min_;
+  // block_cache_[k][i] = min(arr, i*kBlockSize, (i+2^k)*kBlockSize), i.e. the
+  // minimum of the blocks i to i+2^k-1.
+  std::vector<std::vector<T>> block_cache_;
+  Compare cmp_;
+};
+
+// BlockRangeMinimumIndexQuery is to BlockRangeMinimumQuery what
+// RangeMinimumIndexQuery is to RangeMinimumQuery.
+template <typename T, typename Compare = std::less<T>>
+class BlockRangeMinimumIndexQuery {
+ public:
+  explicit BlockRangeMinimumIndexQuery(std::vector<T> array,
+                                       int num_threads = 1);
+  BlockRangeMinimumIndexQuery(std::vector<T> array, Compare cmp,
+                              int num_threads = 1);
+
+  // This type is neither copyable nor movable.
+  BlockRangeMinimumIndexQuery(const BlockRangeMinimumIndexQuery&) = delete;
+  BlockRangeMinimumIndexQuery& operator=(const BlockRangeMinimumIndexQuery&) =
+      delete;
+
+  // Returns an index idx from [from, to) such that arr[idx] is the minimum
+  // value of arr over the interval [from, to).
+  int GetMinimumIndexFromRange(int from, int to) const;
+
+  // Returns the original array.
+  const std::vector<T>& array() const;
+
+ private:
+  // Returns a vector with values 0, 1, ... n - 1 for a given n.
+  static std::vector<int> CreateIndexVector(int n);
+  struct IndexComparator {
+    bool operator()(int lhs_idx, int rhs_idx) const;
+    const std::vector<T> array;
+    Compare cmp;
+  } cmp_;
+  const BlockRangeMinimumQuery<int, IndexComparator> rmq_;
+};
+
 // RangeMinimumQuery implementation
 template <typename T, typename Compare>
 inline RangeMinimumQuery<T, Compare>::RangeMinimumQuery(std::vector<T> array)
@@ -174,5 +264,167 @@ template <typename T, typename Compare>
 inline const std::vector<T>& RangeMinimumIndexQuery<T, Compare>::array() const {
   return cmp_.array;
 }
+
+// BlockRangeMinimumQuery implementation
+template <typename T, typename Compare>
+inline BlockRangeMinimumQuery<T, Compare>::BlockRangeMinimumQuery(
+    std::vector<T> array, int num_threads)
+    : BlockRangeMinimumQuery(std::move(array), Compare(), num_threads) {}
+
+// The blocks are independent: each thread computes the prefix and suffix minima
+// of a range of blocks, and their minima. Then each row of block_cache_ is
+// computed from the previous one, like the rows of RangeMinimumQuery::cache_.
+template <typename T, typename Compare>
+BlockRangeMinimumQuery<T, Compare>::BlockRangeMinimumQuery(
+    std::vector<T> array, Compare cmp, int num_threads)
+    : array_(std::move(array)),
+      prefix_min_(array_.size()),
+      suffix_min_(array_.size()),
+      cmp_(std::move(cmp)) {
+  const int array_size = array_.size();
+  const int num_blocks = (array_size + kBlockSize - 1) / kBlockSize;
+  std::unique_ptr<ThreadPool> pool;
+  if (num_threads > 1) {
+    pool = std::make_unique<ThreadPool>("BlockRangeMinimumQuery",
+                                        num_threads - 1);
+    pool->StartWorkers();
+  }
+
+  block_cache_.resize(
+      num_blocks == 0 ? 0 : MostSignificantBitPosition32(num_blocks) + 1);
+  if (num_blocks == 0) return;
+  block_cache_[0].resize(num_blocks);
+  ParallelFor(num_blocks, num_threads, pool.get(),
+              [this, array_size](int begin, int end) {
+                for (int block = begin; block < end; ++block) {
+                  const int block_begin = block * kBlockSize;
+                  const int block_end =
+                      std::min(block_begin + kBlockSize, array_size);
+                  prefix_min_[block_begin] = array_[block_begin];
+                  for (int i = block_begin + 1; i < block_end; ++i) {
+                    prefix_min_[i] =
+                        std::min(prefix_min_[i - 1], array_[i], cmp_);
+                  }
+                  suffix_min_[block_end - 1] = array_[block_end - 1];
+                  for (int i = block_end - 2; i >= block_begin; --i) {
+                    suffix_min_[i] =
+                        std::min(array_[i], suffix_min_[i + 1], cmp_);
+                  }
+                  block_cache_[0][block] = suffix_min_[block_begin];
+                }
+              });
+  for (int row_idx = 1; row_idx < block_cache_.size(); ++row_idx) {
+    const int row_length = num_blocks - (1 << row_idx) + 1;
+    const int window = 1 << (row_idx - 1);
+    const std::vector<T>& previous_row = block_cache_[row_idx - 1];
+    std::vector<T>& row = block_cache_[row_idx];
+    row.resize(row_length);
+    ParallelFor(row_length, num_threads, pool.get(),
+                [this, &previous_row, &row, window](int begin, int end) {
+                  for (int col_idx = begin; col_idx < end; ++col_idx) {
+                    row[col_idx] =
+                        std::min(previous_row[col_idx],
+                                 previous_row[col_idx + window], cmp_);
+                  }
+                });
+  }
+}
+
+template <typename T, typename Compare>
+template <typename F>
+void BlockRangeMinimumQuery<T, Compare>::ParallelFor(int size, int num_threads,
+                                                     ThreadPool* pool,
+                                                     const F& f) {
+  const int num_chunks =
+      pool == nullptr ? 1 : std::min(num_threads, size / kBlockSize + 1);
+  if (num_chunks <= 1) {
+    f(0, size);
+    return;
+  }
+  absl::BlockingCounter counter(num_chunks - 1);
+  for (int chunk = 1; chunk < num_chunks; ++chunk) {
+    pool->Schedule([&, chunk]() {
+      f(static_cast<int64_t>(size) * chunk / num_chunks,
+        static_cast<int64_t>(size) * (chunk + 1) / num_chunks);
+      counter.DecrementCount();
+    });
+  }
+  f(0, size / num_chunks);
+  counter.Wait();
+}
+
+template <typename T, typename Compare>
+inline T BlockRangeMinimumQuery<T, Compare>::GetMinimumFromRange(
+    int from, int to) const {
+  DCHECK_LE(0, from);
+  DCHECK_LT(from, to);
+  DCHECK_LE(to, array().size());
+  const int first_block = from >> kLogBlockSize;
+  const int last_block = (to - 1) >> kLogBlockSize;
+  if (first_block == last_block) {
+    T result = array_[from];
+    for (int i = from + 1; i < to; ++i) {
+      result = std::min(result, array_[i], cmp_);
+    }
+    return result;
+  }
+  // The minima are taken from left to right, so that the leftmost minimum is
+  // returned in case of ties, as in RangeMinimumQuery.
+  T result = suffix_min_[from];
+  if (first_block + 1 < last_block) {
+    const int log_diff =
+        MostSignificantBitPosition32(last_block - first_block - 1);
+    const std::vector<T>& row = block_cache_[log_diff];
+    result = std::min(result,
+                      std::min(row[first_block + 1],
+                               row[last_block - (1 << log_diff)], cmp_),
+                      cmp_);
+  }
+  return std::min(result, prefix_min_[to - 1], cmp_);
+}
+
+template <typename T, typename Compare>
+inline const std::vector<T>& BlockRangeMinimumQuery<T, Compare>::array() const {
+  return array_;
+}
+
+// BlockRangeMinimumIndexQuery implementation
+template <typename T, typename Compare>
+inline BlockRangeMinimumIndexQuery<T, Compare>::BlockRangeMinimumIndexQuery(
+    std::vector<T> array, int num_threads)
+    : BlockRangeMinimumIndexQuery(std::move(array), Compare(), num_threads) {}
+
+template <typename T, typename Compare>
+BlockRangeMinimumIndexQuery<T, Compare>::BlockRangeMinimumIndexQuery(
+    std::vector<T> array, Compare cmp, int num_threads)
+    : cmp_({std::move(array), std::move(cmp)}),
+      rmq_(CreateIndexVector(cmp_.array.size()), cmp_, num_threads) {}
+
+template <typename T, typename Compare>
+inline int BlockRangeMinimumIndexQuery<T, Compare>::GetMinimumIndexFromRange(
+    int from, int to) const {
+  return rmq_.GetMinimumFromRange(from, to);
+}
+
+template <typename T, typename Compare>
+inline bool
+BlockRangeMinimumIndexQuery<T, Compare>::IndexComparator::operator()(
+    int lhs_idx, int rhs_idx) const {
+  return cmp(array[lhs_idx], array[rhs_idx]);
+}
+
+template <typename T, typename Compare>
+std::vector<int> BlockRangeMinimumIndexQuery<T, Compare>::CreateIndexVector(
+    int n) {
+  std::vector<int> result(n, 0);
+  std::iota(result.begin(), result.end(), 0);
+  return result;
+}
+
+template <typename T, typename Compare>
+inline const std::vector<T>& BlockRangeMinimumIndexQuery<T, Compare>::array()
+    const {
+  return cmp_.array;
+}
 }  // namespace operations_research
 #endif  // OR_TOOLS_UTIL_RANGE_MINIMUM_QUERY_H_
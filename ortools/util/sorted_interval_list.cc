@@ -375,10 +375,12 @@ void Domain::NegateInPlace() {
   DCHECK(IntervalsAreSortedAndNonAdjacent(intervals_));
 }
 
-Domain Domain::IntersectionWith(const Domain& domain) const {
-  Domain result;
-  const auto& a = intervals_;
-  const auto& b = domain.intervals_;
+namespace {
+
+// Appends the intersection of the sorted intervals a and b to result.
+template <typename Intervals, typename Result>
+void AppendIntersection(const Intervals& a, const Intervals& b,
+                        Result* result) {
   for (int i = 0, j = 0; i < a.size() && j < b.size();) {
     if (a[i].start <= b[j].start) {
       if (a[i].end < b[j].start) {
@@ -388,10 +390,10 @@ Domain Domain::IntersectionWith(const Domain& domain) const {
         // Non-empty intersection: push back the intersection of these two, and
         // advance past the first interval to finish.
         if (a[i].end <= b[j].end) {
-          result.intervals_.push_back({b[j].start, a[i].end});
+          result->push_back({b[j].start, a[i].end});
           ++i;
         } else {  // a[i].end > b[j].end.
-          result.intervals_.push_back({b[j].start, b[j].end});
+          result->push_back({b[j].start, b[j].end});
           ++j;
         }
       }
@@ -401,19 +403,44 @@ Domain Domain::IntersectionWith(const Domain& domain) const {
         ++j;
       } else {  // b[j].end >= a[i].start
         if (b[j].end <= a[i].end) {
-          result.intervals_.push_back({a[i].start, b[j].end});
+          result->push_back({a[i].start, b[j].end});
           ++j;
         } else {  // a[i].end > b[j].end.
-          result.intervals_.push_back({a[i].start, a[i].end});
+          result->push_back({a[i].start, a[i].end});
           ++i;
         }
       }
     }
   }
+}
+
+}  // namespace
+
+Domain Domain::IntersectionWith(const Domain& domain) const {
+  Domain result;
+  AppendIntersection(intervals_, domain.intervals_, &result.intervals_);
   DCHECK(IntervalsAreSortedAndNonAdjacent(result.intervals_));
   return result;
 }
 
+void Domain::IntersectInPlace(const Domain& domain) {
+  if (intervals_.size() == 1 && domain.intervals_.size() == 1) {
+    // Fast path for the most common case, without any copy.
+    ClosedInterval& interval = intervals_[0];
+    interval.start = std::max(interval.start, domain.intervals_[0].start);
+    interval.end = std::min(interval.end, domain.intervals_[0].end);
+    if (interval.start > interval.end) intervals_.clear();
+    return;
+  }
+  // The intersection can have more intervals than this domain, so it is
+  // computed in a buffer that is reused across calls.
+  thread_local std::vector<ClosedInterval> buffer;
+  buffer.clear();
+  AppendIntersection(intervals_, domain.intervals_, &buffer);
+  intervals_.assign(buffer.begin(), buffer.end());
+  DCHECK(IntervalsAreSortedAndNonAdjacent(intervals_));
+}
+
 Domain Domain::UnionWith(const Domain& domain) const {
   Domain result;
   const auto& a = intervals_;
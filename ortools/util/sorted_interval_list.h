@@ -328,6 +328,13 @@ class Domain {
    */
   Domain IntersectionWith(const Domain& domain) const;
 
+  /**
+   * Same as *this = IntersectionWith(domain), but reuses the memory of this
+   * domain, so that it does not allocate when the result has no more intervals
+   * than this domain can hold.
+   */
+  void IntersectInPlace(const Domain& domain);
+
   /**
    * Returns the union of D and domain.
    */
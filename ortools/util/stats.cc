@@ -25,6 +25,7 @@
 #include "ortools/base/types.h"
 #include "ortools/port/sysinfo.h"
 #include "ortools/port/utf8.h"
+#include "ortools/util/stats.pb.h"
 
 namespace operations_research {
 
@@ -51,6 +52,11 @@ Stat::Stat(absl::string_view name, StatsGroup* group) : name_(name) {
 
 std::string Stat::StatString() const { return name_ + ": " + ValueAsString(); }
 
+void Stat::ExportToProto(StatsGroupProto::Stat* proto) const {
+  proto->set_name(name_);
+  proto->set_value(ValueAsString());
+}
+
 StatsGroup::~StatsGroup() { gtl::STLDeleteValues(&time_distributions_); }
 
 void StatsGroup::Register(Stat* stat) { stats_.push_back(stat); }
@@ -117,6 +123,15 @@ std::string StatsGroup::StatString() const {
   return result;
 }
 
+void StatsGroup::ExportToProto(StatsGroupProto* proto) const {
+  proto->Clear();
+  proto->set_name(name_);
+  for (const Stat* stat : stats_) {
+    if (!stat->WorthPrinting()) continue;
+    stat->ExportToProto(proto->add_stats());
+  }
+}
+
 TimeDistribution* StatsGroup::LookupOrCreateTimeDistribution(std::string name) {
   TimeDistribution*& ref = time_distributions_[name];
   if (ref == nullptr) {
@@ -171,6 +186,42 @@ void DistributionStat::AddToDistribution(double value) {
   sum_squares_from_average_ += delta * (value - average_);
 }
 
+void DistributionStat::Merge(const DistributionStat& other) {
+  if (other.num_ == 0) return;
+  if (num_ == 0) {
+    sum_ = other.sum_;
+    average_ = other.average_;
+    sum_squares_from_average_ = other.sum_squares_from_average_;
+    min_ = other.min_;
+    max_ = other.max_;
+    num_ = other.num_;
+    return;
+  }
+  // This is the pairwise update of Chan et al., the parallel version of the
+  // Welford algorithm used by AddToDistribution().
+  const double delta = other.average_ - average_;
+  const double num = static_cast<double>(num_);
+  const double other_num = static_cast<double>(other.num_);
+  const double total_num = num + other_num;
+  sum_squares_from_average_ += other.sum_squares_from_average_ +
+                               delta * delta * num * other_num / total_num;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  sum_ += other.sum_;
+  num_ += other.num_;
+  average_ = sum_ / num_;
+}
+
+void DistributionStat::ExportToProto(StatsGroupProto::Stat* proto) const {
+  Stat::ExportToProto(proto);
+  proto->set_num(num_);
+  proto->set_sum(sum_);
+  proto->set_min(min_);
+  proto->set_max(max_);
+  proto->set_average(Average());
+  proto->set_std_deviation(StdDeviation());
+}
+
 double DistributionStat::Average() const { return average_; }
 
 double DistributionStat::StdDeviation() const {
@@ -207,6 +258,16 @@ void TimeDistribution::AddTimeInCycles(double cycles) {
   AddToDistribution(cycles);
 }
 
+void TimeDistribution::ExportToProto(StatsGroupProto::Stat* proto) const {
+  DistributionStat::ExportToProto(proto);
+  proto->set_sum(CyclesToSeconds(sum_));
+  proto->set_min(CyclesToSeconds(min_));
+  proto->set_max(CyclesToSeconds(max_));
+  proto->set_average(CyclesToSeconds(Average()));
+  proto->set_std_deviation(CyclesToSeconds(StdDeviation()));
+  proto->set_is_time(true);
+}
+
 std::string TimeDistribution::ValueAsString() const {
   return absl::StrFormat(
       "%8u [%8s, %8s] %8s %8s %8s\n", num_, PrintCyclesAsTime(min_),
@@ -64,6 +64,10 @@
 // The idea is that by default the instrumentation is off. You can also use the
 // macro IF_STATS_ENABLED() that does nothing if OR_STATS is not defined or just
 // translates to its argument otherwise.
+//
+// The stats can also be exported as a StatsGroupProto with ExportToProto(),
+// e.g. to collect them from production solves, and the distributions filled by
+// different threads can be combined with DistributionStat::Merge().
 
 #ifndef OR_TOOLS_UTIL_STATS_H_
 #define OR_TOOLS_UTIL_STATS_H_
@@ -76,6 +80,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "ortools/base/timer.h"
+#include "ortools/util/stats.pb.h"
 
 namespace operations_research {
 
@@ -120,6 +125,9 @@ class Stat {
   // Reset this statistic to the same state as if it was newly created.
   virtual void Reset() = 0;
 
+  // Fills the name and value of the proto. Subclasses can fill more fields.
+  virtual void ExportToProto(StatsGroupProto::Stat* proto) const;
+
  private:
   const std::string name_;
 };
@@ -161,6 +169,10 @@ class StatsGroup {
   // Calls Reset() on all the statistics registered with this group.
   void Reset();
 
+  // Fills the proto with the stats that are WorthPrinting(), in registration
+  // order.
+  void ExportToProto(StatsGroupProto* proto) const;
+
  private:
   std::string name_;
   PrintOrder print_order_ = SORT_BY_PRIORITY_THEN_VALUE;
@@ -199,6 +211,12 @@ class DistributionStat : public Stat {
   // even more precise but a bit slower too.
   double StdDeviation() const;
 
+  // Adds all the values of the other distribution to this one, e.g. to
+  // combine the distributions accumulated by different threads.
+  void Merge(const DistributionStat& other);
+
+  void ExportToProto(StatsGroupProto::Stat* proto) const override;
+
  protected:
   // Adds a value to this sequence and updates the stats.
   void AddToDistribution(double value);
@@ -243,6 +261,9 @@ class TimeDistribution : public DistributionStat {
   // Adds a time in CPU cycles to this distribution.
   void AddTimeInCycles(double cycles);
 
+  // Exports the statistics in seconds.
+  void ExportToProto(StatsGroupProto::Stat* proto) const override;
+
   // Starts the timer in preparation of a StopTimerAndAddElapsedTime().
   inline void StartTimer() { timer_.Restart(); }
 
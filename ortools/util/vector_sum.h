@@ -18,10 +18,17 @@
 // Precision: Better or comparable precision to std::accumulate<> on the same
 //            value type. That said, the precision is inferior to precise sum
 //            algorithm such as ::AccurateSum.
+//
+// The Accurate*() functions of the second half of this file have the precision
+// of ::AccurateSum, and run 2 to 3 times faster by keeping 16 independent
+// compensated sums that the compiler can vectorize.
 
 #ifndef OR_TOOLS_UTIL_VECTOR_SUM_H_
 #define OR_TOOLS_UTIL_VECTOR_SUM_H_
 
+#include <cstddef>
+
+#include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "ortools/util/vector_sum_internal.h"
 
@@ -38,6 +45,29 @@ inline float VectorSum(absl::Span<const float> values) {
   return internal::VectorSum<4, 4, /*assume_aligned_at_start=*/false>(values);
 }
 
+// Computes the sum of `values` with a compensated summation.
+inline double AccurateVectorSum(absl::Span<const double> values) {
+  return internal::CompensatedSum<16, double>(
+      values.size(), [data = values.data()](size_t i) { return data[i]; });
+}
+
+// Computes the sum of the squares of `values` with a compensated summation.
+inline double AccurateSquaredNorm(absl::Span<const double> values) {
+  return internal::CompensatedSum<16, double>(
+      values.size(),
+      [data = values.data()](size_t i) { return data[i] * data[i]; });
+}
+
+// Computes the dot product of `a` and `b`, which must have the same size, with
+// a compensated summation. Note that the products themselves are rounded.
+inline double AccurateDotProduct(absl::Span<const double> a,
+                                 absl::Span<const double> b) {
+  DCHECK_EQ(a.size(), b.size());
+  return internal::CompensatedSum<16, double>(
+      a.size(),
+      [a = a.data(), b = b.data()](size_t i) { return a[i] * b[i]; });
+}
+
 }  // namespace operations_research
 
 #endif  // OR_TOOLS_UTIL_VECTOR_SUM_H_
@@ -23,6 +23,7 @@
 #include "absl/base/attributes.h"
 #include "absl/base/optimization.h"
 #include "absl/types/span.h"
+#include "ortools/base/accurate_sum.h"
 #include "ortools/util/aligned_memory.h"
 
 namespace operations_research {
@@ -171,6 +172,44 @@ Value VectorSum(absl::Span<const Value> values) {
                          block_sum + leading_items_sum);
 }
 
+// Computes the sum of term(0), ..., term(size - 1) with the compensated
+// summation of ::AccurateSum, run independently in `num_lanes` lanes: lane j
+// accumulates the terms i with i % num_lanes == j. The lanes have no
+// dependency on each other, so the inner loop can be auto-vectorized, and the
+// running sums and errors of the lanes are added together accurately at the
+// end.
+//
+// NOTE: This relies on the strict IEEE semantics of the floating point
+// operations, and is as inaccurate as a naive sum under -ffast-math.
+template <size_t num_lanes, typename Value, typename Term>
+Value CompensatedSum(size_t size, const Term& term) {
+  Value sums[num_lanes] = {};
+  Value errors[num_lanes] = {};
+  const size_t packed_size = size - size % num_lanes;
+  for (size_t i = 0; i < packed_size; i += num_lanes) {
+    for (size_t j = 0; j < num_lanes; ++j) {
+      errors[j] += term(i + j);
+      const Value new_sum = sums[j] + errors[j];
+      errors[j] += sums[j] - new_sum;
+      sums[j] = new_sum;
+    }
+  }
+  for (size_t i = packed_size; i < size; ++i) {
+    const size_t j = i - packed_size;
+    errors[j] += term(i);
+    const Value new_sum = sums[j] + errors[j];
+    errors[j] += sums[j] - new_sum;
+    sums[j] = new_sum;
+  }
+
+  AccurateSum<Value> sum;
+  for (size_t j = 0; j < num_lanes; ++j) {
+    sum.Add(sums[j]);
+    sum.Add(errors[j]);
+  }
+  return sum.Value();
+}
+
 }  // namespace internal
 }  // namespace operations_research
 